@@ -2,6 +2,8 @@
 
 #include <ATen/core/Generator.h>
 
+#include <atomic>
+
 namespace at {
 
 struct CAFFE2_API CUDAGenerator : public Generator {
@@ -21,8 +23,12 @@ struct CAFFE2_API CUDAGenerator : public Generator {
 
 private:
   CUDAGenerator* clone_impl() const override;
-  uint64_t seed_ = default_rng_seed_val;
-  uint64_t philox_offset_per_thread_ = 0;
+  // The offset is reserved with an atomic fetch-add, so concurrent kernel
+  // launches carve out disjoint philox subsequences without taking mutex_;
+  // see Note [Philox offset reservation is lock free]. seed_ is atomic only
+  // so racing reads are well defined - seeding still requires the lock.
+  std::atomic<uint64_t> seed_{default_rng_seed_val};
+  std::atomic<uint64_t> philox_offset_per_thread_{0};
 };
 
 namespace cuda {
@@ -1,8 +1,15 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/Functions.h>
 
+#include <c10/core/impl/VirtualGuardImpl.h>
+
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 using namespace std;
 namespace at {
@@ -157,6 +164,22 @@ void deleter(DLManagedTensor* arg) {
   delete static_cast<ATenDLMTensor*>(arg->manager_ctx);
 }
 
+static void fillDLTensor(const Tensor& src, DLTensor& dl_tensor) {
+  dl_tensor.data = src.data_ptr();
+  int64_t device_id = 0;
+  if (src.is_cuda()) {
+    device_id = src.get_device();
+  }
+  dl_tensor.ctx = getDLContext(src, device_id);
+  dl_tensor.ndim = src.dim();
+  dl_tensor.dtype = getDLDataType(src);
+  // The wrapper's Tensor handle keeps src's TensorImpl (and thus these
+  // arrays) alive for as long as the consumer holds the wrapper.
+  dl_tensor.shape = const_cast<int64_t*>(src.sizes().data());
+  dl_tensor.strides = const_cast<int64_t*>(src.strides().data());
+  dl_tensor.byte_offset = 0;
+}
+
 // This function returns a shared_ptr to memory managed DLpack tensor
 // constructed out of ATen tensor
 DLManagedTensor* toDLPack(const Tensor& src) {
@@ -164,22 +187,181 @@ DLManagedTensor* toDLPack(const Tensor& src) {
   atDLMTensor->handle = src;
   atDLMTensor->tensor.manager_ctx = atDLMTensor;
   atDLMTensor->tensor.deleter = &deleter;
-  atDLMTensor->tensor.dl_tensor.data = src.data_ptr();
-  int64_t device_id = 0;
-  if (src.is_cuda()) {
-    device_id = src.get_device();
-  }
-  atDLMTensor->tensor.dl_tensor.ctx = getDLContext(src, device_id);
-  atDLMTensor->tensor.dl_tensor.ndim = src.dim();
-  atDLMTensor->tensor.dl_tensor.dtype = getDLDataType(src);
-  atDLMTensor->tensor.dl_tensor.shape =
-      const_cast<int64_t*>(src.sizes().data());
-  atDLMTensor->tensor.dl_tensor.strides =
-      const_cast<int64_t*>(src.strides().data());
-  atDLMTensor->tensor.dl_tensor.byte_offset = 0;
+  fillDLTensor(src, atDLMTensor->tensor.dl_tensor);
   return &(atDLMTensor->tensor);
 }
 
+namespace {
+
+// A wrapper that cycles through the exchange pool instead of being
+// heap-allocated per export (see toDLPackCached in DLConvertor.h).
+struct ExchangeEntry {
+  Tensor handle;
+  DLManagedTensor managed;
+  // Cached entries stay filled (handle included) after the consumer's
+  // deleter runs so the next export of the same storage is free; pool
+  // entries are cleared and returned to the free list.
+  bool cached = false;
+  bool in_use = false;
+  const void* key = nullptr;
+};
+
+void exchangeDeleter(DLManagedTensor* arg);
+
+struct DLPackExchange {
+  std::mutex mutex;
+  // Owns every wrapper ever handed out; entries are recycled through
+  // free_pool / cache and never deallocated individually.
+  std::vector<std::unique_ptr<ExchangeEntry>> entries;
+  std::vector<ExchangeEntry*> free_pool;
+  std::unordered_map<const void*, ExchangeEntry*> cache;
+
+  static size_t maxCacheSize() {
+    static const size_t size = []() -> size_t {
+      const char* env = std::getenv("ATEN_DLPACK_CACHE_SIZE");
+      if (env) {
+        long parsed = std::atol(env);
+        return parsed < 0 ? 0 : static_cast<size_t>(parsed);
+      }
+      return 64;
+    }();
+    return size;
+  }
+
+  // Caller must hold mutex.
+  ExchangeEntry* acquire() {
+    if (!free_pool.empty()) {
+      ExchangeEntry* entry = free_pool.back();
+      free_pool.pop_back();
+      return entry;
+    }
+    entries.emplace_back(new ExchangeEntry());
+    ExchangeEntry* entry = entries.back().get();
+    entry->managed.manager_ctx = entry;
+    entry->managed.deleter = &exchangeDeleter;
+    return entry;
+  }
+
+  // Caller must hold mutex. Removes one idle entry from the cache to make
+  // room; returns false if every cached wrapper is checked out.
+  bool evictOne() {
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+      ExchangeEntry* entry = it->second;
+      if (!entry->in_use) {
+        entry->cached = false;
+        entry->handle.reset();
+        free_pool.push_back(entry);
+        cache.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+DLPackExchange& dlPackExchange() {
+  // Leaked so cached Tensor handles are not destroyed during static
+  // teardown, after the allocators they point into may be gone.
+  static DLPackExchange* exchange = new DLPackExchange();
+  return *exchange;
+}
+
+void exchangeDeleter(DLManagedTensor* arg) {
+  auto* entry = static_cast<ExchangeEntry*>(arg->manager_ctx);
+  auto& exchange = dlPackExchange();
+  std::lock_guard<std::mutex> lock(exchange.mutex);
+  entry->in_use = false;
+  if (!entry->cached) {
+    entry->handle.reset();
+    exchange.free_pool.push_back(entry);
+  }
+}
+
+// True when a cached wrapper still describes src exactly. Same TensorImpl
+// implies identical metadata unless the tensor was resized in place, so
+// the data/shape/stride pointers are checked as well.
+bool wrapperMatches(const ExchangeEntry& entry, const Tensor& src) {
+  const DLTensor& dl_tensor = entry.managed.dl_tensor;
+  return entry.handle.unsafeGetTensorImpl() == src.unsafeGetTensorImpl() &&
+      dl_tensor.data == src.data_ptr() &&
+      dl_tensor.shape == src.sizes().data() &&
+      dl_tensor.strides == src.strides().data();
+}
+
+} // namespace
+
+DLManagedTensor* toDLPackCached(const Tensor& src) {
+  auto& exchange = dlPackExchange();
+  std::lock_guard<std::mutex> lock(exchange.mutex);
+  const void* key =
+      src.has_storage() ? src.storage().unsafeGetStorageImpl() : nullptr;
+  if (key) {
+    auto it = exchange.cache.find(key);
+    if (it != exchange.cache.end()) {
+      ExchangeEntry* entry = it->second;
+      if (!entry->in_use) {
+        if (!wrapperMatches(*entry, src)) {
+          entry->handle = src;
+          fillDLTensor(src, entry->managed.dl_tensor);
+        }
+        entry->in_use = true;
+        return &entry->managed;
+      }
+      // The consumer still owns the cached wrapper for this storage; fall
+      // through to a pool wrapper for this export.
+      key = nullptr;
+    }
+  }
+  ExchangeEntry* entry = exchange.acquire();
+  entry->handle = src;
+  fillDLTensor(src, entry->managed.dl_tensor);
+  entry->in_use = true;
+  if (key &&
+      (exchange.cache.size() < DLPackExchange::maxCacheSize() ||
+       exchange.evictOne())) {
+    entry->cached = true;
+    entry->key = key;
+    exchange.cache.emplace(key, entry);
+  }
+  return &entry->managed;
+}
+
+void clearDLPackCache() {
+  auto& exchange = dlPackExchange();
+  std::lock_guard<std::mutex> lock(exchange.mutex);
+  for (auto& item : exchange.cache) {
+    ExchangeEntry* entry = item.second;
+    entry->cached = false;
+    if (!entry->in_use) {
+      entry->handle.reset();
+      exchange.free_pool.push_back(entry);
+    }
+  }
+  exchange.cache.clear();
+}
+
+DLPackHandoff DLPackHandoff::record(const Tensor& src) {
+  DLPackHandoff handoff(src.device());
+  if (src.device().type() != DeviceType::CPU) {
+    c10::impl::VirtualGuardImpl impl(src.device().type());
+    handoff.event_.emplace(src.device().type());
+    handoff.event_->record(impl.getStream(src.device()));
+  }
+  return handoff;
+}
+
+void DLPackHandoff::blockCurrentStream() {
+  if (!event_) {
+    return;
+  }
+  c10::impl::VirtualGuardImpl impl(device_.type());
+  event_->block(impl.getStream(device_));
+}
+
+bool DLPackHandoff::query() const {
+  return !event_ || event_->query();
+}
+
 Tensor fromDLPack(const DLManagedTensor* src) {
   Device device = getATenDevice(src->dl_tensor.ctx);
   ScalarType stype = toScalarType(src->dl_tensor.dtype);
@@ -3,6 +3,8 @@
 #include <ATen/Tensor.h>
 #include <ATen/ATen.h>
 #include <ATen/dlpack.h>
+#include <c10/core/Event.h>
+#include <c10/util/Optional.h>
 
 // this convertor will:
 // 1) take a Tensor object and wrap it in the DLPack tensor
@@ -16,4 +18,44 @@ CAFFE2_API Tensor fromDLPack(const DLManagedTensor* src);
 CAFFE2_API DLDataType getDLDataType(const Tensor& t);
 CAFFE2_API DLContext getDLContext(const Tensor& tensor, const int64_t& device_id);
 
+// toDLPack heap-allocates a fresh wrapper per export. For code that
+// exchanges the same tensors at high rate, toDLPackCached serves wrappers
+// from a free pool (no allocation on the hot path) and additionally keeps
+// the filled-in wrapper of each exported storage primed, so re-exporting
+// an unchanged tensor is a hash lookup. The returned wrapper follows the
+// usual DLPack contract: the consumer calls its deleter exactly once,
+// which returns the wrapper to the pool. The cache keeps up to
+// ATEN_DLPACK_CACHE_SIZE (default 64) exported storages (and their
+// wrappers' Tensor handles) alive; clearDLPackCache() drops them all.
+CAFFE2_API DLManagedTensor* toDLPackCached(const Tensor& src);
+CAFFE2_API void clearDLPackCache();
+
+// Explicit stream handoff for exported CUDA tensors. toDLPack does not
+// synchronize, so a consumer reading the buffer on another stream may race
+// with the producer's pending kernels. The producer records a handoff
+// after queuing its writes; the consumer blocks its stream on it before
+// reading. Neither side blocks the host. No-op for CPU tensors.
+//
+//   auto handoff = DLPackHandoff::record(tensor);
+//   // ... hand (dlpack, handoff) to the consumer ...
+//   handoff.blockCurrentStream();  // consumer, with its stream current
+struct CAFFE2_API DLPackHandoff {
+  // Records the work currently queued on the exporting thread's stream for
+  // src's device.
+  static DLPackHandoff record(const Tensor& src);
+
+  // Blocks the calling thread's current stream for the recorded device
+  // until the recorded work has completed.
+  void blockCurrentStream();
+
+  // True once the recorded work has completed.
+  bool query() const;
+
+ private:
+  explicit DLPackHandoff(Device device) : device_(device) {}
+
+  Device device_;
+  c10::optional<c10::Event> event_;
+};
+
 } //namespace at
@@ -20,6 +20,46 @@
     return __VA_ARGS__();                                               \
   }
 
+// Note [Dtype allowlist pruning]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Stripped production builds can compile the AT_DISPATCH_* macros for a
+// subset of dtypes: configuring with ATEN_DTYPE_ALLOWLIST="Float;Long"
+// defines AT_DTYPE_ALLOWLIST_PRUNE plus one AT_DTYPE_ENABLED_<Name> flag
+// per listed type, and every case arm below whose flag is missing vanishes
+// from the switch (and from the binary). Excluded dtypes fall through to
+// the default arm and raise the usual "not implemented for" error.
+//
+// Only the dtypes spelled literally in this header participate: the
+// SCALARTYPE arguments of the _AND/_AND2/_AND3 variants, the quantized
+// dispatch and kernels instantiated outside AT_DISPATCH are not pruned.
+// AT_DTYPE_IS_ENABLED maps a possibly-undefined AT_DTYPE_ENABLED_<Name>
+// flag to 1 or 0 with the usual probe trick, so the selector below can
+// paste it onto AT_PRIVATE_CASE_ARM_.
+#if defined(AT_DTYPE_ALLOWLIST_PRUNE)
+
+#define AT_DTYPE_PROBE_1 0, 1
+#define AT_DTYPE_SECOND(a, b, ...) b
+#define AT_DTYPE_EXPAND_SECOND(...) AT_DTYPE_SECOND(__VA_ARGS__, 0)
+#define AT_DTYPE_IS_ENABLED(name) AT_DTYPE_IS_ENABLED_IMPL(AT_DTYPE_ENABLED_##name)
+#define AT_DTYPE_IS_ENABLED_IMPL(value) AT_DTYPE_IS_ENABLED_IMPL2(value)
+#define AT_DTYPE_IS_ENABLED_IMPL2(value) AT_DTYPE_EXPAND_SECOND(AT_DTYPE_PROBE_##value)
+
+#define AT_PRIVATE_CASE_ARM_1(name, type, ...) \
+  AT_PRIVATE_CASE_TYPE(at::ScalarType::name, type, __VA_ARGS__)
+#define AT_PRIVATE_CASE_ARM_0(name, type, ...)
+#define AT_PRIVATE_CASE_CONCAT(a, b) AT_PRIVATE_CASE_CONCAT_IMPL(a, b)
+#define AT_PRIVATE_CASE_CONCAT_IMPL(a, b) a##b
+
+#define AT_PRIVATE_CASE_TYPE_NAMED(name, type, ...) \
+  AT_PRIVATE_CASE_CONCAT(AT_PRIVATE_CASE_ARM_, AT_DTYPE_IS_ENABLED(name))(name, type, __VA_ARGS__)
+
+#else
+
+#define AT_PRIVATE_CASE_TYPE_NAMED(name, type, ...) \
+  AT_PRIVATE_CASE_TYPE(at::ScalarType::name, type, __VA_ARGS__)
+
+#endif
+
 namespace detail {
 
 inline at::ScalarType scalar_type(at::ScalarType s) {
@@ -102,8 +142,8 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */  \
     at::ScalarType _st = ::detail::scalar_type(the_type);                    \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                  \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -115,9 +155,9 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */  \
     at::ScalarType _st = ::detail::scalar_type(the_type);                    \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Half, at::Half, __VA_ARGS__)      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Half, at::Half, __VA_ARGS__)                \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -129,8 +169,8 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */                               \
     at::ScalarType _st = ::detail::scalar_type(the_type);                                                 \
     switch (_st) {                                                                                        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                   \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                             \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                               \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE,                                                                    \
           decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE>::t), __VA_ARGS__)                           \
       default:                                                                                            \
@@ -144,10 +184,10 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */                                      \
     at::ScalarType _st = ::detail::scalar_type(the_type);                                                        \
     switch (_st) {                                                                                               \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                     \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                       \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexDouble, std::complex<double>, __VA_ARGS__)                               \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexFloat, std::complex<float>, __VA_ARGS__)                                 \
       default:                                                                                                   \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");                                           \
     }                                                                                                            \
@@ -159,10 +199,10 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */                                      \
     at::ScalarType _st = ::detail::scalar_type(the_type);                                                        \
     switch (_st) {                                                                                               \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                     \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                       \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexDouble, std::complex<double>, __VA_ARGS__)                               \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexFloat, std::complex<float>, __VA_ARGS__)                                 \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE>::t), __VA_ARGS__)     \
       default:                                                                                                   \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");                                           \
@@ -175,11 +215,11 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */  \
     at::ScalarType _st = ::detail::scalar_type(the_type);                    \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -191,13 +231,13 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op  */ \
     at::ScalarType _st = ::detail::scalar_type(the_type);                    \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -209,8 +249,8 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */                                      \
     at::ScalarType _st = ::detail::scalar_type(the_type);                                                        \
     switch (_st) {                                                                                               \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexFloat, std::complex<float>, __VA_ARGS__)                                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexDouble, std::complex<double>, __VA_ARGS__)                               \
       default:                                                                                                   \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");                                           \
     }                                                                                                            \
@@ -237,15 +277,15 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op*/                                       \
     at::ScalarType _st = ::detail::scalar_type(the_type);                                                        \
     switch (_st) {                                                                                               \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexFloat, std::complex<float>, __VA_ARGS__)                                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexDouble, std::complex<double>, __VA_ARGS__)                               \
       default:                                                                                                   \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");                                           \
     }                                                                                                            \
@@ -254,13 +294,13 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND(SCALARTYPE, TYPE, NAME, ...)                                                 \
   [&] {                                                                                                        \
     switch (TYPE) {                                                                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                         \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                         \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                        \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                                                   \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                                                   \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                                                  \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE>::t), __VA_ARGS__)   \
       default:                                                                                                 \
         AT_ERROR(#NAME, " not implemented for '", toString(TYPE), "'");                                        \
@@ -270,15 +310,15 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(SCALARTYPE, TYPE, NAME, ...)                                     \
   [&] {                                                                                                        \
     switch (TYPE) {                                                                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                         \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                         \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                     \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                   \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                                                   \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                                                   \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                                                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexFloat, std::complex<float>, __VA_ARGS__)                               \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexDouble, std::complex<double>, __VA_ARGS__)                             \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE>::t), __VA_ARGS__)   \
       default:                                                                                                 \
         AT_ERROR(#NAME, " not implemented for '", toString(TYPE), "'");                                        \
@@ -288,8 +328,8 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_COMPLEX_TYPES_AND(SCALARTYPE, TYPE, NAME, ...)                                               \
   [&] {                                                                                                          \
     switch (TYPE) {                                                                                              \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexFloat, std::complex<float>, __VA_ARGS__)                                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexDouble, std::complex<double>, __VA_ARGS__)                               \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE>::t), __VA_ARGS__)     \
       default:                                                                                                   \
         AT_ERROR(#NAME, " not implemented for '", toString(TYPE), "'");                                          \
@@ -299,13 +339,13 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND2(SCALARTYPE1, SCALARTYPE2, TYPE, NAME, ...)                                    \
   [&] {                                                                                                          \
     switch (TYPE) {                                                                                              \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                          \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                                                    \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE1, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE1>::t), __VA_ARGS__)   \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE2, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE2>::t), __VA_ARGS__)   \
       default:                                                                                                   \
@@ -316,15 +356,15 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(SCALARTYPE1, SCALARTYPE2, TYPE, NAME, ...)                        \
   [&] {                                                                                                          \
     switch (TYPE) {                                                                                              \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexFloat, std::complex<float>, __VA_ARGS__)                                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexDouble, std::complex<double>, __VA_ARGS__)                               \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE1, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE1>::t), __VA_ARGS__)   \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE2, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE2>::t), __VA_ARGS__)   \
       default:                                                                                                   \
@@ -335,13 +375,13 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND3(SCALARTYPE1, SCALARTYPE2, SCALARTYPE3, TYPE, NAME, ...)                       \
   [&] {                                                                                                          \
     switch (TYPE) {                                                                                              \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                          \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                                                    \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE1, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE1>::t), __VA_ARGS__)   \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE2, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE2>::t), __VA_ARGS__)   \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE3, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE3>::t), __VA_ARGS__)   \
@@ -353,15 +393,15 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(SCALARTYPE1, SCALARTYPE2, SCALARTYPE3, TYPE, NAME, ...)           \
   [&] {                                                                                                          \
     switch (TYPE) {                                                                                              \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                            \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                          \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                                                      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                                                     \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                                                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexFloat, std::complex<float>, __VA_ARGS__)                                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(ComplexDouble, std::complex<double>, __VA_ARGS__)                               \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE1, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE1>::t), __VA_ARGS__)   \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE2, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE2>::t), __VA_ARGS__)   \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE3, decltype(c10::impl::ScalarTypeToCPPType<SCALARTYPE3>::t), __VA_ARGS__)   \
@@ -381,14 +421,14 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */  \
     at::ScalarType _st = ::detail::scalar_type(the_type);                    \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Half, at::Half, __VA_ARGS__)      \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                \
+      AT_PRIVATE_CASE_TYPE_NAMED(Half, at::Half, __VA_ARGS__)                \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -401,18 +441,18 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     /* don't use TYPE again in case it is an expensive or side-effect op */  \
     at::ScalarType _st = ::detail::scalar_type(the_type);                    \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Half, at::Half, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)    \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Byte, uint8_t, __VA_ARGS__)                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(Char, int8_t, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Double, double, __VA_ARGS__)                \
+      AT_PRIVATE_CASE_TYPE_NAMED(Float, float, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Int, int32_t, __VA_ARGS__)                  \
+      AT_PRIVATE_CASE_TYPE_NAMED(Long, int64_t, __VA_ARGS__)                 \
+      AT_PRIVATE_CASE_TYPE_NAMED(Short, int16_t, __VA_ARGS__)                \
+      AT_PRIVATE_CASE_TYPE_NAMED(Half, at::Half, __VA_ARGS__)                \
+      AT_PRIVATE_CASE_TYPE_NAMED(                                            \
+          ComplexFloat, std::complex<float>, __VA_ARGS__)                    \
+      AT_PRIVATE_CASE_TYPE_NAMED(                                            \
+          ComplexDouble, std::complex<double>, __VA_ARGS__)                  \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -2,11 +2,13 @@
 
 namespace at {
 
-std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b) {
+namespace {
+template <typename Container>
+Container infer_size_impl(IntArrayRef a, IntArrayRef b) {
   size_t dimsA = a.size();
   size_t dimsB = b.size();
   size_t ndim = dimsA > dimsB ? dimsA : dimsB;
-  std::vector<int64_t> expandedSizes(ndim);
+  Container expandedSizes(ndim);
 
   // Use ptrdiff_t to ensure signed comparison.
   for (ptrdiff_t i = (ptrdiff_t)ndim - 1; i >= 0; --i) {
@@ -29,7 +31,8 @@ std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b) {
   return expandedSizes;
 }
 
-std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
+template <typename Container>
+std::tuple<Container, Container> inferExpandGeometryImpl(
     IntArrayRef tensor_sizes,
     IntArrayRef tensor_strides,
     IntArrayRef sizes) {
@@ -37,12 +40,15 @@ std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
   int64_t tensor_dim = tensor_sizes.size();
 
   if (tensor_dim == 0) {
-    std::vector<int64_t> expandedStrides(ndim, 0);
-    return std::tuple<std::vector<int64_t>, std::vector<int64_t>>(
-        sizes.vec(), expandedStrides);
+    return std::tuple<Container, Container>(
+        Container(sizes.begin(), sizes.end()), Container(ndim, 0));
   }
-  std::vector<int64_t> expandedSizes(ndim);
-  std::vector<int64_t> expandedStrides(ndim);
+  // Build the result in place.  Note: SmallVector has an unconstrained
+  // Container&& constructor that would swallow a lone int64_t size, so use
+  // the (size, value) form here.
+  std::tuple<Container, Container> result{Container(ndim, 0), Container(ndim, 0)};
+  auto& expandedSizes = std::get<0>(result);
+  auto& expandedStrides = std::get<1>(result);
 
   // create a new geometry for the tensors
   for (int64_t i = ndim - 1; i >= 0; --i) {
@@ -80,8 +86,31 @@ std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
     expandedSizes[i] = size;
     expandedStrides[i] = stride;
   }
-  return std::tuple<std::vector<int64_t>, std::vector<int64_t>>(
-      expandedSizes, expandedStrides);
+  return result;
+}
+} // namespace
+
+std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b) {
+  return infer_size_impl<std::vector<int64_t>>(a, b);
+}
+
+DimVector infer_size_dimvector(IntArrayRef a, IntArrayRef b) {
+  return infer_size_impl<DimVector>(a, b);
+}
+
+std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
+    IntArrayRef tensor_sizes,
+    IntArrayRef tensor_strides,
+    IntArrayRef sizes) {
+  return inferExpandGeometryImpl<std::vector<int64_t>>(
+      tensor_sizes, tensor_strides, sizes);
+}
+
+std::tuple<DimVector, DimVector> inferExpandGeometry_dimvector(
+    IntArrayRef tensor_sizes,
+    IntArrayRef tensor_strides,
+    IntArrayRef sizes) {
+  return inferExpandGeometryImpl<DimVector>(tensor_sizes, tensor_strides, sizes);
 }
 
 } // namespace at
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ATen/Tensor.h>
+#include <ATen/core/DimVector.h>
 #include <c10/util/Exception.h>
 
 #include <functional>
@@ -16,6 +17,16 @@ inferExpandGeometry(
     IntArrayRef tensor_strides,
     IntArrayRef sizes);
 
+// Variants of the above that return stack-allocated DimVectors instead of
+// heap-allocated std::vectors.  Shape math is on the hot path of nearly every
+// operator, so prefer these when the result is only used to construct another
+// tensor (anything taking IntArrayRef accepts a DimVector directly).
+CAFFE2_API DimVector infer_size_dimvector(IntArrayRef a, IntArrayRef b);
+CAFFE2_API std::tuple<DimVector, DimVector> inferExpandGeometry_dimvector(
+    IntArrayRef tensor_sizes,
+    IntArrayRef tensor_strides,
+    IntArrayRef sizes);
+
 // avoid copy-construction of Tensor by using a reference_wrapper.
 inline void check_defined(std::initializer_list<std::reference_wrapper<const Tensor>> tensors, const char *api_name) {
   for (auto& t : tensors) {
@@ -59,7 +70,7 @@ inline std::tuple<Tensor, Tensor> expand_outplace(const Tensor &to_expand1, cons
     return std::make_tuple(to_expand1, to_expand2);
   }
 
-  auto expanded_size = infer_size(to_expand1.sizes(), to_expand2.sizes());
+  auto expanded_size = infer_size_dimvector(to_expand1.sizes(), to_expand2.sizes());
   return std::make_tuple(
       to_expand1.expand(expanded_size, /*implicit=*/true), // see [expand implicit]
       to_expand2.expand(expanded_size, /*implicit=*/true));
@@ -77,8 +88,8 @@ inline std::tuple<Tensor, Tensor, Tensor> expand_outplace(const Tensor &to_expan
     return std::make_tuple(to_expand1, to_expand2, to_expand3);
   }
 
-  auto expanded_size12 = infer_size(to_expand1.sizes(), to_expand2.sizes());
-  auto expanded_size = infer_size(expanded_size12, to_expand3.sizes());
+  auto expanded_size12 = infer_size_dimvector(to_expand1.sizes(), to_expand2.sizes());
+  auto expanded_size = infer_size_dimvector(expanded_size12, to_expand3.sizes());
   return std::make_tuple(
       to_expand1.expand(expanded_size, /*implicit=*/true), // see [expand implicit]
       to_expand2.expand(expanded_size, /*implicit=*/true),
@@ -109,15 +120,15 @@ inline std::tuple<Tensor> expand_size(const Tensor &to_expand, IntArrayRef sizes
 inline std::vector<Tensor> expand_outplace(TensorList to_expand) {
   // expands a list of Tensors; ignores undefined (null) tensors
   bool first = true;
-  std::vector<int64_t> sizes;
+  DimVector sizes;
   for (size_t i = 0; i < to_expand.size(); ++i) {
     if (!to_expand[i].defined()) {
       continue;
     } else if (first) {
-      sizes = to_expand[i].sizes().vec();
+      sizes.assign(to_expand[i].sizes().begin(), to_expand[i].sizes().end());
       first = false;
     } else {
-      sizes = infer_size(sizes, to_expand[i].sizes());
+      sizes = infer_size_dimvector(sizes, to_expand[i].sizes());
     }
   }
 
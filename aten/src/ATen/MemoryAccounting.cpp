@@ -0,0 +1,123 @@
+#include <ATen/MemoryAccounting.h>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace at {
+
+void MemoryAccountingInfo::charge(int64_t nbytes) {
+  int64_t current =
+      current_bytes_.fetch_add(nbytes, std::memory_order_relaxed) + nbytes;
+  if (limit_bytes_ >= 0 && current > limit_bytes_) {
+    current_bytes_.fetch_sub(nbytes, std::memory_order_relaxed);
+    TORCH_CHECK(
+        false,
+        "request memory limit exceeded: tried to allocate ",
+        nbytes,
+        " bytes with ",
+        current - nbytes,
+        " bytes already live against a limit of ",
+        limit_bytes_,
+        " bytes");
+  }
+  int64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+  while (current > peak &&
+         !peak_bytes_.compare_exchange_weak(
+             peak, current, std::memory_order_relaxed)) {
+  }
+}
+
+void MemoryAccountingInfo::uncharge(int64_t nbytes) noexcept {
+  current_bytes_.fetch_sub(nbytes, std::memory_order_relaxed);
+}
+
+std::shared_ptr<MemoryAccountingInfo> currentMemoryAccountingInfo() {
+  return std::dynamic_pointer_cast<MemoryAccountingInfo>(
+      getThreadLocalDebugInfo());
+}
+
+namespace {
+
+// See Note [Request-scoped memory accounting]. The side table maps every
+// live accounted pointer to its size and owning scope; holding the scope
+// by shared_ptr means a request's allocations can still be credited back
+// after the request itself has finished.
+class AccountingHook final : public c10::CPUMemoryAccountingHook {
+ public:
+  void beforeAlloc(size_t nbytes) override {
+    if (nbytes == 0) {
+      return;
+    }
+    if (auto scope = currentMemoryAccountingInfo()) {
+      // Reserves the bytes; throws if the scope's cap would be exceeded.
+      scope->charge(static_cast<int64_t>(nbytes));
+    }
+  }
+
+  void allocFailed(size_t nbytes) override {
+    if (nbytes == 0) {
+      return;
+    }
+    if (auto scope = currentMemoryAccountingInfo()) {
+      scope->uncharge(static_cast<int64_t>(nbytes));
+    }
+  }
+
+  void allocated(void* ptr, size_t nbytes) override {
+    if (ptr == nullptr || nbytes == 0) {
+      return;
+    }
+    auto scope = currentMemoryAccountingInfo();
+    if (!scope) {
+      return;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    entries_[ptr] = Entry{nbytes, std::move(scope)};
+  }
+
+  void freed(void* ptr) override {
+    if (ptr == nullptr) {
+      return;
+    }
+    Entry entry;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      auto it = entries_.find(ptr);
+      if (it == entries_.end()) {
+        // Allocated outside any scope (or before the hook was installed).
+        return;
+      }
+      entry = std::move(it->second);
+      entries_.erase(it);
+    }
+    entry.scope->uncharge(static_cast<int64_t>(entry.nbytes));
+  }
+
+ private:
+  struct Entry {
+    size_t nbytes = 0;
+    std::shared_ptr<MemoryAccountingInfo> scope;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<void*, Entry> entries_;
+};
+
+std::shared_ptr<ThreadLocalDebugInfoBase> installHookAndPass(
+    std::shared_ptr<MemoryAccountingInfo> info) {
+  static std::once_flag once;
+  std::call_once(
+      once, [] { c10::SetCPUMemoryAccountingHook(new AccountingHook()); });
+  return info;
+}
+
+} // namespace
+
+MemoryAccountingScope::MemoryAccountingScope(
+    std::shared_ptr<MemoryAccountingInfo> info)
+    : guard_(installHookAndPass(std::move(info))) {}
+
+} // namespace at
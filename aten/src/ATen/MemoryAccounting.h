@@ -0,0 +1,79 @@
+#pragma once
+
+#include <ATen/ThreadLocalDebugInfo.h>
+#include <c10/macros/Export.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace at {
+
+// Note [Request-scoped memory accounting]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Multi-tenant serving wants to know how much memory each in-flight request
+// is holding, and to fail an over-budget request instead of letting it OOM
+// the whole worker. A MemoryAccountingScope installs a MemoryAccountingInfo
+// as the thread-local debug info for the duration of a request; since debug
+// info already rides along into at::launch tasks and across the autograd
+// engine's device threads, allocations made on behalf of the request are
+// attributed to it no matter which thread performs them.
+//
+// The attribution itself happens in the default CPU allocator through the
+// CPUMemoryAccountingHook (see c10/core/CPUAllocator.h), which this file
+// installs - process-wide and permanently - the first time a scope is
+// created. Every allocation is charged to the scope active on the
+// allocating thread (if any) and credited back to that same scope when the
+// pointer is freed, even if the free happens outside the scope or on
+// another thread. current_bytes() is therefore live: it reflects what the
+// request currently holds, not what it has cumulatively allocated.
+//
+// When a scope is constructed with a limit, an allocation that would push
+// current_bytes() past it throws c10::Error from inside the allocator. The
+// exception propagates out of the op the request was running, failing only
+// that request. The reservation is made atomically, so concurrent threads
+// of one request cannot jointly overshoot the cap.
+class CAFFE2_API MemoryAccountingInfo : public ThreadLocalDebugInfoBase {
+ public:
+  // limit_bytes < 0 means "account only, no cap".
+  explicit MemoryAccountingInfo(int64_t limit_bytes = -1)
+      : limit_bytes_(limit_bytes) {}
+
+  // Bytes currently held by allocations charged to this scope.
+  int64_t current_bytes() const noexcept {
+    return current_bytes_.load(std::memory_order_relaxed);
+  }
+  // High-water mark of current_bytes().
+  int64_t peak_bytes() const noexcept {
+    return peak_bytes_.load(std::memory_order_relaxed);
+  }
+  int64_t limit_bytes() const noexcept {
+    return limit_bytes_;
+  }
+
+  // Used by the allocator hook; throws if the cap would be exceeded.
+  void charge(int64_t nbytes);
+  void uncharge(int64_t nbytes) noexcept;
+
+ private:
+  std::atomic<int64_t> current_bytes_{0};
+  std::atomic<int64_t> peak_bytes_{0};
+  int64_t limit_bytes_;
+};
+
+// Marks the current thread (and everything it forks through at::launch or
+// the autograd engine) as working on behalf of `info` until destruction.
+// See Note [Request-scoped memory accounting].
+class CAFFE2_API MemoryAccountingScope {
+ public:
+  explicit MemoryAccountingScope(std::shared_ptr<MemoryAccountingInfo> info);
+  ~MemoryAccountingScope() = default;
+
+ private:
+  DebugInfoGuard guard_;
+};
+
+// The MemoryAccountingInfo active on this thread, or nullptr.
+CAFFE2_API std::shared_ptr<MemoryAccountingInfo> currentMemoryAccountingInfo();
+
+} // namespace at
@@ -16,6 +16,27 @@ inline int64_t divup(int64_t x, int64_t y) {
   return (x + y - 1) / y;
 }
 
+/*
+calc_grain_size
+
+Computes a grain size for parallel_for / parallel_reduce from per-iteration
+cost hints instead of a hand-tuned constant such as internal::GRAIN_SIZE,
+which is too small for cheap loop bodies on tiny tensors and too large for
+expensive ones.
+
+bytes_per_iter: bytes read plus written by one iteration of the loop body
+
+flops_per_iter: floating point operations performed by one iteration
+
+Chunks are sized so that each task's estimated running time is a comfortable
+multiple of the per-task scheduling overhead (measured on the native backend,
+estimated otherwise), so cheap bodies get large chunks and expensive bodies
+still spread across all cores.
+*/
+CAFFE2_API int64_t calc_grain_size(
+    int64_t bytes_per_iter,
+    int64_t flops_per_iter);
+
 // Called during new thread initialization
 CAFFE2_API void init_num_threads();
 
@@ -4,6 +4,7 @@
 #include <ATen/PTThreadPool.h>
 #include <ATen/Version.h>
 
+#include <algorithm>
 #include <sstream>
 #include <thread>
 
@@ -88,9 +89,40 @@ std::string get_parallel_info() {
   ss << "Experimental: single thread pool" << std::endl;
   #endif
 
+  #if AT_PARALLEL_NATIVE && !defined(C10_MOBILE)
+  if (at::unified_thread_pool()) {
+    ss << "Unified inter-op/intra-op thread pool" << std::endl;
+  }
+  #endif
+
   return ss.str();
 }
 
+int64_t calc_grain_size(int64_t bytes_per_iter, int64_t flops_per_iter) {
+  // Conservative per-core throughput estimates. Only their ratio to the task
+  // overhead matters, not absolute accuracy; they are chosen so that a plain
+  // float copy/sum body lands near internal::GRAIN_SIZE.
+  constexpr double kBytesPerNs = 16.0; // ~16 GB/s streaming per core
+  constexpr double kFlopsPerNs = 16.0; // vectorized FP throughput per core
+  // Target chunks that run for a healthy multiple of the per-task dispatch
+  // overhead, keeping scheduling cost a small fraction of the runtime.
+  constexpr int64_t kOverheadMultiple = 8;
+  double ns_per_iter =
+      bytes_per_iter / kBytesPerNs + flops_per_iter / kFlopsPerNs;
+  if (ns_per_iter <= 0.0) {
+    return internal::GRAIN_SIZE;
+  }
+  int64_t overhead_ns;
+#if AT_PARALLEL_NATIVE && !defined(C10_MOBILE)
+  overhead_ns = internal::measured_task_overhead_ns();
+#else
+  // No measurement hook for this backend; assume a couple of microseconds.
+  overhead_ns = 2000;
+#endif
+  auto grain_size = (int64_t)(kOverheadMultiple * overhead_ns / ns_per_iter);
+  return std::max<int64_t>(grain_size, 1);
+}
+
 int intraop_default_num_threads() {
 #ifdef C10_MOBILE
   // Intraop thread pool size should be determined by mobile cpuinfo.
@@ -10,6 +10,18 @@
 #endif // C10_MOBILE
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef C10_MOBILE
+#include <c10/util/numa.h>
+#include <c10/util/thread_name.h>
+#include <cstdlib>
+#endif
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -75,14 +87,206 @@ TaskThreadPoolBase& _get_intraop_pool() {
   return *pool;
 }
 
+bool _work_stealing_env_default() {
+  const char* value = std::getenv("AT_INTRAOP_WORK_STEALING");
+  return value && std::atoi(value) != 0;
+}
+
+bool _unified_pool_env_default() {
+  const char* value = std::getenv("AT_UNIFIED_THREAD_POOL");
+  return value && std::atoi(value) != 0;
+}
+
+// Whether at::launch() submits inter-op tasks to the intra-op pool;
+// NOT_SET -> 0/1 (set by the user) -> CONSUMED
+// (CONSUMED - the first inter-op task has been launched)
+std::atomic<int> unified_pool_mode{NOT_SET};
+
+// Snapshots the unified pool decision when the first inter-op task is
+// launched and marks the setting consumed, so that a later
+// set_unified_thread_pool call fails instead of silently splitting the
+// pools again.
+bool _use_unified_pool() {
+  static bool unified = []() {
+    int value = unified_pool_mode.exchange(CONSUMED);
+    if (value == NOT_SET) {
+      return _unified_pool_env_default();
+    }
+    return value == 1;
+  }();
+  return unified;
+}
+
+// Whether _run_with_pool submits chunks to the work-stealing scheduler
+// below instead of the shared FIFO pool.
+// Can be flipped at any time; it is checked on every parallel region entry.
+std::atomic<bool> intraop_work_stealing_{_work_stealing_env_default()};
+
+// Note [Work-stealing intra-op scheduler]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The default intra-op pool is a single FIFO queue shared by all workers.
+// When several application threads issue parallel_for concurrently (e.g. a
+// large GEMM next to many small elementwise ops), chunks of short tasks
+// queue behind chunks of long ones and tail latency suffers.  This
+// scheduler gives every worker its own deque: the owner pops from the
+// front, idle workers steal from the back of a victim's deque, preferring
+// victims pinned to the same NUMA node so stolen chunks keep operating on
+// local memory.  It is opt-in via at::set_intraop_work_stealing() (or the
+// AT_INTRAOP_WORK_STEALING environment variable) and only affects the
+// native backend; the TBB backend has its own scheduler.
+class WorkStealingScheduler {
+ public:
+  explicit WorkStealingScheduler(int num_workers)
+      : workers_(std::max(num_workers, 1)) {
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      workers_[i] = std::unique_ptr<Worker>(new Worker());
+    }
+    threads_.reserve(workers_.size());
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      threads_.emplace_back([this, i]() { worker_loop(i); });
+    }
+  }
+
+  ~WorkStealingScheduler() {
+    {
+      std::unique_lock<std::mutex> lock(wakeup_mutex_);
+      stopped_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void run(std::function<void()> task) {
+    // Round-robin across the per-worker deques; stealing evens out any
+    // imbalance caused by workers that are busy with earlier submissions.
+    size_t worker_id = next_worker_++ % workers_.size();
+    {
+      std::lock_guard<std::mutex> lock(workers_[worker_id]->mutex);
+      workers_[worker_id]->tasks.push_back(std::move(task));
+    }
+    wakeup_.notify_one();
+  }
+
+  int size() const {
+    return threads_.size();
+  }
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+    // NUMA node the worker thread observed at startup; -1 if unknown.
+    std::atomic<int> numa_node{-1};
+  };
+
+  bool try_pop(size_t worker_id, std::function<void()>& task) {
+    auto& worker = *workers_[worker_id];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+      return false;
+    }
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    return true;
+  }
+
+  bool try_steal(size_t worker_id, std::function<void()>& task) {
+    auto& victim = *workers_[worker_id];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.tasks.empty()) {
+      return false;
+    }
+    task = std::move(victim.tasks.back());
+    victim.tasks.pop_back();
+    return true;
+  }
+
+  bool steal_work(size_t thief_id, std::function<void()>& task) {
+    int thief_node = workers_[thief_id]->numa_node.load();
+    // First pass over same-node victims, second pass over the rest.
+    for (int pass = 0; pass < 2; ++pass) {
+      for (size_t i = 1; i < workers_.size(); ++i) {
+        size_t victim_id = (thief_id + i) % workers_.size();
+        int victim_node = workers_[victim_id]->numa_node.load();
+        bool same_node = thief_node >= 0 && victim_node == thief_node;
+        if ((pass == 0) != same_node) {
+          continue;
+        }
+        if (try_steal(victim_id, task)) {
+          return true;
+        }
+      }
+      if (thief_node < 0) {
+        // No NUMA information, a single pass already covered everyone.
+        break;
+      }
+    }
+    return false;
+  }
+
+  void worker_loop(size_t worker_id) {
+    c10::setThreadName("pt_intraop_ws");
+    init_num_threads();
+    if (c10::IsNUMAEnabled()) {
+      workers_[worker_id]->numa_node = c10::GetCurrentNUMANode();
+    }
+    std::function<void()> task;
+    while (true) {
+      if (try_pop(worker_id, task) || steal_work(worker_id, task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(wakeup_mutex_);
+      if (stopped_) {
+        return;
+      }
+      wakeup_.wait_for(lock, std::chrono::milliseconds(1));
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::mutex wakeup_mutex_;
+  std::condition_variable wakeup_;
+  std::atomic<size_t> next_worker_{0};
+  bool stopped_ = false;
+};
+
+WorkStealingScheduler& _get_work_stealing_scheduler() {
+  static WorkStealingScheduler scheduler(
+      []() {
+        int nthreads = num_intraop_threads.exchange(CONSUMED);
+        if (nthreads == CONSUMED) {
+          // The FIFO pool was initialized first; match its size.
+          return (int)_get_intraop_pool().size();
+        }
+        return _num_pool_threads(nthreads);
+      }());
+  return scheduler;
+}
+
 #endif // C10_MOBILE
 
 // Run lambda function `fn` over `task_id` in [0, `range`) with threadpool.
 // `fn` will be called with params: (thread_pool_task_id, task_id).
 void _run_with_pool(const std::function<void(int, size_t)>& fn, size_t range) {
 #ifndef C10_MOBILE
+  if (intraop_work_stealing_.load(std::memory_order_relaxed)) {
+    auto& scheduler = _get_work_stealing_scheduler();
+    for (size_t i = 1; i < range; ++i) {
+      scheduler.run([fn, i]() { fn((int)i, i); });
+    }
+    fn(0, 0);
+    return;
+  }
   for (size_t i = 1; i < range; ++i) {
-    _get_intraop_pool().run([fn, i]() { fn((int)i, i); });
+    // Low priority so that inter-op tasks sharing the pool in unified mode
+    // schedule ahead of queued chunks; without priority traffic in the pool
+    // this is plain FIFO as before.
+    _get_intraop_pool().runLowPriority([fn, i]() { fn((int)i, i); });
   }
   // Run the first task on the current thread directly.
   fn(0, 0);
@@ -158,6 +362,56 @@ void _parallel_run(
   }
 }
 
+bool use_unified_thread_pool() {
+#ifndef C10_MOBILE
+  return _use_unified_pool();
+#else
+  return false;
+#endif // C10_MOBILE
+}
+
+void intraop_launch_prioritized(std::function<void()> func) {
+#ifndef C10_MOBILE
+  if (get_num_threads() > 1) {
+    // Regular-priority submission; intra-op chunks go through
+    // runLowPriority, so inter-op tasks jump ahead of queued chunks.
+    _get_intraop_pool().run(func);
+  } else {
+    func();
+  }
+#else
+  func();
+#endif // C10_MOBILE
+}
+
+int64_t measured_task_overhead_ns() {
+  constexpr int64_t kDefaultOverheadNs = 1500;
+#ifndef C10_MOBILE
+  static int64_t overhead_ns = []() {
+    if (in_parallel_region() || get_num_threads() <= 1) {
+      return kDefaultOverheadNs;
+    }
+    // One untimed round through the pool to bring the workers up, then time
+    // rounds of one-element tasks; _parallel_run includes the future waits,
+    // so the measurement covers the full submit-to-completion cost.
+    constexpr int kReps = 10;
+    const int64_t num_tasks = get_num_threads();
+    auto noop = [](int64_t, int64_t, size_t) {};
+    _parallel_run(0, num_tasks, 1, noop);
+    auto start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < kReps; ++rep) {
+      _parallel_run(0, num_tasks, 1, noop);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    return std::max<int64_t>(elapsed / (kReps * num_tasks), 100);
+  }();
+  return overhead_ns;
+#else
+  return kDefaultOverheadNs;
+#endif // C10_MOBILE
+}
+
 } // namespace internal
 
 void init_num_threads() {
@@ -218,6 +472,49 @@ int get_num_threads() {
 #endif // C10_MOBILE
 }
 
+void set_intraop_work_stealing(bool enable) {
+#ifndef C10_MOBILE
+  intraop_work_stealing_.store(enable, std::memory_order_relaxed);
+#else
+  TORCH_CHECK(!enable,
+      "work-stealing intra-op scheduler is not supported for mobile.");
+#endif // C10_MOBILE
+}
+
+bool get_intraop_work_stealing() {
+#ifndef C10_MOBILE
+  return intraop_work_stealing_.load(std::memory_order_relaxed);
+#else
+  return false;
+#endif // C10_MOBILE
+}
+
+void set_unified_thread_pool(bool unified) {
+#ifndef C10_MOBILE
+  int no_value = NOT_SET;
+  TORCH_CHECK(
+      unified_pool_mode.compare_exchange_strong(no_value, unified ? 1 : 0),
+      "Error: cannot set unified thread pool mode after inter-op work "
+      "has started or set_unified_thread_pool called");
+#else
+  TORCH_CHECK(!unified, "unified thread pool is not supported for mobile.");
+#endif // C10_MOBILE
+}
+
+bool unified_thread_pool() {
+#ifndef C10_MOBILE
+  int value = unified_pool_mode.load();
+  if (value == NOT_SET) {
+    return _unified_pool_env_default();
+  } else if (value == CONSUMED) {
+    return _use_unified_pool();
+  }
+  return value == 1;
+#else
+  return false;
+#endif // C10_MOBILE
+}
+
 int get_thread_num() {
   return thread_num_;
 }
@@ -237,7 +534,7 @@ bool in_parallel_region() {
 void intraop_launch(std::function<void()> func) {
 #ifndef C10_MOBILE
   if (!in_parallel_region() && get_num_threads() > 1) {
-    _get_intraop_pool().run(func);
+    _get_intraop_pool().runLowPriority(func);
   } else {
     // execute inline if we're in parallel region
     func();
@@ -254,7 +551,7 @@ std::shared_ptr<c10::ivalue::Future> intraop_launch_future(
 #ifndef C10_MOBILE
   auto future = std::make_shared<c10::ivalue::Future>(c10::NoneType::get());
   if (!in_parallel_region() && get_num_threads() > 1) {
-    _get_intraop_pool().run(
+    _get_intraop_pool().runLowPriority(
       [func, future]() {
         func();
         future->markCompleted();
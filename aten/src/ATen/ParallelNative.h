@@ -1,5 +1,7 @@
 #pragma once
 
+#include <c10/util/cpu_topology.h>
+
 #include <algorithm>
 #include <cstddef>
 #include <exception>
@@ -16,6 +18,16 @@ inline std::tuple<size_t, size_t> calc_num_tasks_and_chunk_size(
   }
   // Choose number of tasks based on grain size and number of threads.
   size_t chunk_size = divup((end - begin), get_num_threads());
+  // On heterogeneous (big.LITTLE) CPUs one equal-size chunk per thread
+  // makes the whole region wait for the slowest core. Shrink the chunks by
+  // the little cores' throughput ratio so the shared queue hands fast cores
+  // proportionally more chunks and the straggler tail stays short. Not
+  // needed when the workers are pinned to the big cores.
+  if (c10::IsHeterogeneousCpu() && !c10::GetRestrictToBigCores()) {
+    chunk_size = std::max(
+        (size_t)1,
+        (size_t)(chunk_size * c10::GetLittleCoreThroughputRatio()));
+  }
   // Make sure each task is at least grain_size size.
   chunk_size = std::max((size_t)grain_size, chunk_size);
   size_t num_tasks = divup((end - begin), chunk_size);
@@ -28,8 +40,41 @@ CAFFE2_API void _parallel_run(
   const int64_t grain_size,
   const std::function<void(int64_t, int64_t, size_t)>& f);
 
+// Returns whether inter-op tasks should go to the intra-op pool, freezing
+// the unified pool setting on first call. Used by at::launch().
+CAFFE2_API bool use_unified_thread_pool();
+
+// Submits an inter-op task to the intra-op pool, scheduled ahead of queued
+// intra-op chunks. Used by at::launch() in unified thread pool mode.
+CAFFE2_API void intraop_launch_prioritized(std::function<void()> func);
+
+// Per-task dispatch overhead of the intra-op pool in nanoseconds, measured
+// once on first use by timing rounds of empty tasks. Used by
+// at::calc_grain_size() to pick chunk sizes.
+CAFFE2_API int64_t measured_task_overhead_ns();
+
 } // namespace internal
 
+// Routes parallel_for chunks through a work-stealing deque-per-thread
+// scheduler instead of the shared FIFO pool.  Can be toggled at runtime;
+// also settable via the AT_INTRAOP_WORK_STEALING environment variable.
+// See Note [Work-stealing intra-op scheduler] in ParallelNative.cpp.
+CAFFE2_API void set_intraop_work_stealing(bool enable);
+
+// Returns whether the work-stealing intra-op scheduler is enabled
+CAFFE2_API bool get_intraop_work_stealing();
+
+// Makes at::launch() submit inter-op tasks to the intra-op pool instead of
+// a separate inter-op pool.  Inter-op tasks are scheduled ahead of queued
+// intra-op chunks, and total concurrency is bounded by set_num_threads()
+// rather than by the sum of the two pool sizes.  Must be called before the
+// first inter-op task is launched; also settable via the
+// AT_UNIFIED_THREAD_POOL environment variable.
+CAFFE2_API void set_unified_thread_pool(bool unified);
+
+// Returns whether inter-op tasks share the intra-op thread pool
+CAFFE2_API bool unified_thread_pool();
+
 template <class F>
 inline void parallel_for(
     const int64_t begin,
@@ -80,6 +80,14 @@ void launch(std::function<void()> func) {
 #if AT_EXPERIMENTAL_SINGLE_THREAD_POOL
   intraop_launch(fn);
 #else
+#if AT_PARALLEL_NATIVE
+  if (internal::use_unified_thread_pool()) {
+    // Share the intra-op pool: inter-op tasks schedule ahead of queued
+    // intra-op chunks and total concurrency is capped by set_num_threads().
+    internal::intraop_launch_prioritized(std::move(fn));
+    return;
+  }
+#endif
   get_pool().run(fn);
 #endif
 }
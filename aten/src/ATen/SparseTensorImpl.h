@@ -29,6 +29,15 @@ struct CAFFE2_API SparseTensorImpl : public TensorImpl {
   // because many algorithms proceed by merging two sorted lists (of indices).
   bool coalesced_ = false;
 
+  // Auxiliary partition table bucketing the nnz by blocks of the second
+  // sparse dimension, so sparse-dense ops can keep a block of the dense
+  // operand cache-resident while visiting its nonzeros. Built lazily by
+  // the ops that use it and dropped whenever indices change. See
+  // Note [Dense-row block partition] in SparseTensorMath.cpp.
+  Tensor col_block_perm_;
+  Tensor col_block_offsets_;
+  int64_t col_block_size_ = 0;
+
 public:
   // Public for now...
   explicit SparseTensorImpl(at::TensorTypeSet, const caffe2::TypeMeta&);
@@ -164,6 +173,24 @@ public:
   void set_coalesced(bool coalesced) {
     TORCH_CHECK(allow_tensor_metadata_change(), "set_coalesced ", err_msg_tensor_metadata_change_not_allowed);
     coalesced_ = coalesced;
+    clear_col_block_partition();
+  }
+
+  // See Note [Dense-row block partition] in SparseTensorMath.cpp.
+  bool has_col_block_partition(int64_t block_size) const {
+    return col_block_size_ == block_size && col_block_perm_.defined();
+  }
+  Tensor col_block_perm() const { return col_block_perm_; }
+  Tensor col_block_offsets() const { return col_block_offsets_; }
+  void set_col_block_partition(Tensor perm, Tensor offsets, int64_t block_size) {
+    col_block_perm_ = std::move(perm);
+    col_block_offsets_ = std::move(offsets);
+    col_block_size_ = block_size;
+  }
+  void clear_col_block_partition() {
+    col_block_perm_ = Tensor();
+    col_block_offsets_ = Tensor();
+    col_block_size_ = 0;
   }
 
   // NOTE: this function is only used internally and not exposed to Python frontend
@@ -172,6 +199,7 @@ public:
     AT_ASSERT(new_nnz <= nnz());
     indices_ = indices_.narrow(1, 0, new_nnz);
     values_ = values_.narrow(0, 0, new_nnz);
+    clear_col_block_partition();
   }
 
   // Takes indices and values and directly puts them into the sparse tensor, no copy.
@@ -240,6 +268,10 @@ private:
     dest_sparse_impl->indices_ = src_sparse_impl->indices();
     dest_sparse_impl->values_ = src_sparse_impl->values();
     dest_sparse_impl->coalesced_ = src_sparse_impl->coalesced();
+    // The partition table only depends on the (shared) indices.
+    dest_sparse_impl->col_block_perm_ = src_sparse_impl->col_block_perm_;
+    dest_sparse_impl->col_block_offsets_ = src_sparse_impl->col_block_offsets_;
+    dest_sparse_impl->col_block_size_ = src_sparse_impl->col_block_size_;
   }
 };
 
@@ -0,0 +1,478 @@
+// Microbenchmarks for the native CPU operator suite.
+//
+// Drives operators directly through the at:: API, so what is measured is the
+// kernel plus exactly the dispatch and TensorIterator overhead a C++ caller
+// pays - no Python, no autograd. Each benchmark is registered with
+// AT_BENCHMARK and timed with an adaptive iteration count; on Linux the
+// timed region is additionally wrapped in perf_event_open(2) hardware
+// counters (cycles, instructions, LLC misses, stalled backend cycles), which
+// is how sub-microsecond framework overhead regressions show up. Counters
+// degrade gracefully to "n/a" where perf_event_open is unavailable (e.g.
+// restrictive perf_event_paranoid settings).
+//
+// Usage:
+//   op_benchmark [--filter=<regex>] [--min-time-ms=<n>] [--threads=<n>]
+//                [--list]
+//
+// The small (8 element) variants exist to expose per-call overhead; the 64k
+// variants mostly measure the kernels themselves.
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <regex>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// -------------------------------------------------------------------------
+// Hardware counters
+// -------------------------------------------------------------------------
+
+#if defined(__linux__)
+// One counter opened through perf_event_open(2). Reads are scaled by
+// time_enabled/time_running so the numbers stay meaningful when the kernel
+// multiplexes the PMU.
+class PerfCounter {
+ public:
+  PerfCounter(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = type;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1; // count the intra-op worker threads too
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    fd_ = static_cast<int>(
+        syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+
+  PerfCounter(const PerfCounter&) = delete;
+  PerfCounter& operator=(const PerfCounter&) = delete;
+
+  ~PerfCounter() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  bool valid() const {
+    return fd_ >= 0;
+  }
+
+  void start() {
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+
+  uint64_t stop() {
+    if (fd_ < 0) {
+      return 0;
+    }
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    uint64_t data[3] = {0, 0, 0}; // value, time_enabled, time_running
+    if (read(fd_, data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+      return 0;
+    }
+    return static_cast<uint64_t>(
+        static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+        static_cast<double>(data[2]));
+  }
+
+ private:
+  int fd_ = -1;
+};
+#else
+class PerfCounter {
+ public:
+  PerfCounter(uint32_t, uint64_t) {}
+  bool valid() const {
+    return false;
+  }
+  void start() {}
+  uint64_t stop() {
+    return 0;
+  }
+};
+#endif
+
+struct CounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;
+  uint64_t stalled_backend = 0;
+  bool valid = false;
+};
+
+class CounterSet {
+ public:
+#if defined(__linux__)
+  CounterSet()
+      : cycles_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+        instructions_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+        llc_misses_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+        stalled_backend_(
+            PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_STALLED_CYCLES_BACKEND) {}
+#else
+  CounterSet() : cycles_(0, 0), instructions_(0, 0), llc_misses_(0, 0),
+                 stalled_backend_(0, 0) {}
+#endif
+
+  void start() {
+    cycles_.start();
+    instructions_.start();
+    llc_misses_.start();
+    stalled_backend_.start();
+  }
+
+  CounterValues stop() {
+    CounterValues v;
+    v.cycles = cycles_.stop();
+    v.instructions = instructions_.stop();
+    v.llc_misses = llc_misses_.stop();
+    v.stalled_backend = stalled_backend_.stop();
+    v.valid = cycles_.valid();
+    return v;
+  }
+
+ private:
+  PerfCounter cycles_;
+  PerfCounter instructions_;
+  PerfCounter llc_misses_;
+  PerfCounter stalled_backend_;
+};
+
+// -------------------------------------------------------------------------
+// Registration and runner
+// -------------------------------------------------------------------------
+
+// A benchmark is a setup function that builds its tensors once and returns
+// the closure to be timed, so allocation never lands inside the timed loop.
+using BenchmarkSetup = std::function<std::function<void()>()>;
+
+struct Benchmark {
+  const char* name;
+  BenchmarkSetup setup;
+};
+
+std::vector<Benchmark>& registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct RegisterBenchmark {
+  RegisterBenchmark(const char* name, BenchmarkSetup setup) {
+    registry().push_back({name, std::move(setup)});
+  }
+};
+
+#define AT_BENCHMARK(name)                                   \
+  static std::function<void()> name##_setup();               \
+  static RegisterBenchmark name##_reg(#name, &name##_setup); \
+  static std::function<void()> name##_setup()
+
+struct Result {
+  int64_t iters = 0;
+  double ns_per_iter = 0;
+  CounterValues counters;
+};
+
+Result runBenchmark(const std::function<void()>& op, double min_time_ms) {
+  using clock = std::chrono::steady_clock;
+  // Warm up caches, the dispatcher and any lazily initialized kernel state.
+  for (int i = 0; i < 3; i++) {
+    op();
+  }
+  CounterSet counters;
+  int64_t iters = 1;
+  for (;;) {
+    counters.start();
+    const auto t0 = clock::now();
+    for (int64_t i = 0; i < iters; i++) {
+      op();
+    }
+    const auto t1 = clock::now();
+    CounterValues values = counters.stop();
+    const double elapsed_ms =
+        std::chrono::duration<double, std::milli>(t1 - t0).count();
+    if (elapsed_ms >= min_time_ms || iters >= (int64_t(1) << 40)) {
+      Result result;
+      result.iters = iters;
+      result.ns_per_iter = elapsed_ms * 1e6 / static_cast<double>(iters);
+      result.counters = values;
+      return result;
+    }
+    // Grow towards the time budget the way google/benchmark does: estimate,
+    // pad by 40%, and never grow by more than 10x at once.
+    double multiplier = min_time_ms * 1.4 / std::max(elapsed_ms, 1e-3);
+    multiplier = std::min(multiplier, 10.0);
+    iters = std::max(iters + 1, static_cast<int64_t>(iters * multiplier));
+  }
+}
+
+double perIter(uint64_t total, int64_t iters) {
+  return static_cast<double>(total) / static_cast<double>(iters);
+}
+
+// -------------------------------------------------------------------------
+// Benchmarks, grouped by the native/cpu/*Kernel.cpp file they exercise
+// -------------------------------------------------------------------------
+
+constexpr int64_t kSmall = 8;
+constexpr int64_t kLarge = 64 * 1024;
+
+// BinaryOpsKernel.cpp
+AT_BENCHMARK(binary_add_8) {
+  auto a = at::randn({kSmall});
+  auto b = at::randn({kSmall});
+  auto out = at::empty({kSmall});
+  return [=]() { at::add_out(out, a, b); };
+}
+
+AT_BENCHMARK(binary_add_64k) {
+  auto a = at::randn({kLarge});
+  auto b = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::add_out(out, a, b); };
+}
+
+AT_BENCHMARK(binary_mul_64k) {
+  auto a = at::randn({kLarge});
+  auto b = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::mul_out(out, a, b); };
+}
+
+AT_BENCHMARK(binary_div_64k) {
+  auto a = at::randn({kLarge});
+  auto b = at::randn({kLarge}).abs_().add_(1);
+  auto out = at::empty({kLarge});
+  return [=]() { at::div_out(out, a, b); };
+}
+
+// UnaryOpsKernel.cpp
+AT_BENCHMARK(unary_sigmoid_8) {
+  auto a = at::randn({kSmall});
+  auto out = at::empty({kSmall});
+  return [=]() { at::sigmoid_out(out, a); };
+}
+
+AT_BENCHMARK(unary_sigmoid_64k) {
+  auto a = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::sigmoid_out(out, a); };
+}
+
+AT_BENCHMARK(unary_exp_64k) {
+  auto a = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::exp_out(out, a); };
+}
+
+AT_BENCHMARK(unary_sqrt_64k) {
+  auto a = at::randn({kLarge}).abs_();
+  auto out = at::empty({kLarge});
+  return [=]() { at::sqrt_out(out, a); };
+}
+
+AT_BENCHMARK(unary_neg_64k) {
+  auto a = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::neg_out(out, a); };
+}
+
+// Activation.cpp
+AT_BENCHMARK(activation_relu_64k) {
+  auto a = at::randn({kLarge});
+  return [=]() { at::relu_(a); };
+}
+
+AT_BENCHMARK(activation_threshold_64k) {
+  auto a = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::threshold_out(out, a, 0.5, 0.0); };
+}
+
+// ReduceOpsKernel.cpp
+AT_BENCHMARK(reduce_sum_all_64k) {
+  auto a = at::randn({kLarge});
+  return [=]() { at::sum(a); };
+}
+
+AT_BENCHMARK(reduce_sum_dim_256x256) {
+  auto a = at::randn({256, 256});
+  auto out = at::empty({256});
+  return [=]() { at::sum_out(out, a, {1}); };
+}
+
+// FillKernel.cpp
+AT_BENCHMARK(fill_64k) {
+  auto a = at::empty({kLarge});
+  return [=]() { a.fill_(1.0); };
+}
+
+// CopyKernel.cpp
+AT_BENCHMARK(copy_contig_64k) {
+  auto a = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { out.copy_(a); };
+}
+
+AT_BENCHMARK(copy_transposed_256x256) {
+  auto a = at::randn({256, 256}).t();
+  auto out = at::empty({256, 256});
+  return [=]() { out.copy_(a); };
+}
+
+// LerpKernel.cpp
+AT_BENCHMARK(lerp_64k) {
+  auto a = at::randn({kLarge});
+  auto b = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::lerp_out(out, a, b, 0.5); };
+}
+
+// PowKernel.cpp
+AT_BENCHMARK(pow_tensor_scalar_64k) {
+  auto a = at::randn({kLarge}).abs_().add_(1);
+  auto out = at::empty({kLarge});
+  return [=]() { at::pow_out(out, a, 2.5); };
+}
+
+// PointwiseOpsKernel.cpp
+AT_BENCHMARK(pointwise_addcmul_64k) {
+  auto a = at::randn({kLarge});
+  auto b = at::randn({kLarge});
+  auto c = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::addcmul_out(out, a, b, c, 1.0); };
+}
+
+// SoftMaxKernel.cpp
+AT_BENCHMARK(softmax_dim1_256x256) {
+  auto a = at::randn({256, 256});
+  return [=]() { at::softmax(a, 1); };
+}
+
+// SortingKernel.cpp
+AT_BENCHMARK(sort_64k) {
+  auto a = at::randn({kLarge});
+  return [=]() { at::sort(a); };
+}
+
+// TensorCompareKernel.cpp
+AT_BENCHMARK(clamp_64k) {
+  auto a = at::randn({kLarge});
+  auto out = at::empty({kLarge});
+  return [=]() { at::clamp_out(out, a, -0.5, 0.5); };
+}
+
+// IndexKernel.cpp
+AT_BENCHMARK(index_select_64k) {
+  auto a = at::randn({kLarge});
+  auto index = at::randint(0, kLarge, {kLarge}, at::kLong);
+  auto out = at::empty({kLarge});
+  return [=]() { at::index_select_out(out, a, 0, index); };
+}
+
+// -------------------------------------------------------------------------
+
+void printHeader() {
+  std::printf(
+      "%-28s %12s %14s %12s %12s %12s %12s\n",
+      "benchmark",
+      "iters",
+      "ns/iter",
+      "cycles",
+      "instrs",
+      "LLC-miss",
+      "stall-be");
+}
+
+void printResult(const char* name, const Result& result) {
+  std::printf(
+      "%-28s %12lld %14.1f",
+      name,
+      static_cast<long long>(result.iters),
+      result.ns_per_iter);
+  if (result.counters.valid) {
+    std::printf(
+        " %12.1f %12.1f %12.2f %12.1f\n",
+        perIter(result.counters.cycles, result.iters),
+        perIter(result.counters.instructions, result.iters),
+        perIter(result.counters.llc_misses, result.iters),
+        perIter(result.counters.stalled_backend, result.iters));
+  } else {
+    std::printf(
+        " %12s %12s %12s %12s\n", "n/a", "n/a", "n/a", "n/a");
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string filter = ".*";
+  double min_time_ms = 100.0;
+  bool list_only = false;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg.compare(0, 9, "--filter=") == 0) {
+      filter = arg.substr(9);
+    } else if (arg.compare(0, 14, "--min-time-ms=") == 0) {
+      min_time_ms = std::atof(arg.c_str() + 14);
+    } else if (arg.compare(0, 10, "--threads=") == 0) {
+      at::set_num_threads(std::atoi(arg.c_str() + 10));
+    } else if (arg == "--list") {
+      list_only = true;
+    } else {
+      std::fprintf(stderr, "unknown argument: %s\n", arg.c_str());
+      return 1;
+    }
+  }
+
+  const std::regex filter_re(filter);
+  if (list_only) {
+    for (const auto& benchmark : registry()) {
+      if (std::regex_search(benchmark.name, filter_re)) {
+        std::printf("%s\n", benchmark.name);
+      }
+    }
+    return 0;
+  }
+
+  at::manual_seed(4242);
+  std::printf(
+      "intra-op threads: %d, min time per benchmark: %.0f ms\n",
+      at::get_num_threads(),
+      min_time_ms);
+  printHeader();
+  for (const auto& benchmark : registry()) {
+    if (!std::regex_search(benchmark.name, filter_re)) {
+      continue;
+    }
+    auto op = benchmark.setup();
+    printResult(benchmark.name, runBenchmark(op, min_time_ms));
+  }
+  return 0;
+}
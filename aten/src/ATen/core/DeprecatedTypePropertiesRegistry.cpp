@@ -1,6 +1,7 @@
 #include <ATen/core/DeprecatedTypePropertiesRegistry.h>
 
 #include <ATen/core/DeprecatedTypeProperties.h>
+#include <c10/macros/Macros.h>
 
 namespace at {
 
@@ -8,19 +9,34 @@ void DeprecatedTypePropertiesDeleter::operator()(DeprecatedTypeProperties * ptr)
   delete ptr;
 }
 
-DeprecatedTypePropertiesRegistry::DeprecatedTypePropertiesRegistry() {
-  for (int b = 0; b < static_cast<int>(Backend::NumOptions); ++b) {
-    for (int s = 0; s < static_cast<int>(ScalarType::NumOptions); ++s) {
-      registry[b][s] = c10::guts::make_unique<DeprecatedTypeProperties>(
-              static_cast<Backend>(b),
-              static_cast<ScalarType>(s));
+DeprecatedTypePropertiesRegistry::~DeprecatedTypePropertiesRegistry() {
+  for (auto& backend_row : registry) {
+    for (auto& cell : backend_row) {
+      delete cell.load(std::memory_order_relaxed);
     }
   }
 }
 
 DeprecatedTypeProperties& DeprecatedTypePropertiesRegistry::getDeprecatedTypeProperties(
     Backend p, ScalarType s) const {
-  return *registry[static_cast<int>(p)][static_cast<int>(s)];
+  auto& cell = registry[static_cast<int>(p)][static_cast<int>(s)];
+  DeprecatedTypeProperties* ptr = cell.load(std::memory_order_acquire);
+  if (C10_LIKELY(ptr != nullptr)) {
+    return *ptr;
+  }
+  return materialize(p, s);
+}
+
+DeprecatedTypeProperties& DeprecatedTypePropertiesRegistry::materialize(
+    Backend p, ScalarType s) const {
+  std::lock_guard<std::mutex> lock(materialize_mutex);
+  auto& cell = registry[static_cast<int>(p)][static_cast<int>(s)];
+  DeprecatedTypeProperties* ptr = cell.load(std::memory_order_relaxed);
+  if (ptr == nullptr) {
+    ptr = new DeprecatedTypeProperties(p, s);
+    cell.store(ptr, std::memory_order_release);
+  }
+  return *ptr;
 }
 
 // TODO: This could be bad juju if someone calls globalContext() in the
@@ -6,6 +6,9 @@
 #include <c10/core/Backend.h>
 #include <c10/core/ScalarType.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace at {
 
 class DeprecatedTypeProperties;
@@ -16,14 +19,20 @@ struct CAFFE2_API DeprecatedTypePropertiesDeleter {
 
 class CAFFE2_API DeprecatedTypePropertiesRegistry {
  public:
-  DeprecatedTypePropertiesRegistry();
+  ~DeprecatedTypePropertiesRegistry();
 
   DeprecatedTypeProperties& getDeprecatedTypeProperties(Backend p, ScalarType s) const;
 
 private:
-  std::unique_ptr<DeprecatedTypeProperties> registry
+  DeprecatedTypeProperties& materialize(Backend p, ScalarType s) const;
+
+  // Cells are materialized on first use instead of eagerly for the whole
+  // Backend x ScalarType cross product, and a hit is a single acquire load;
+  // this registry sits on the hot path of every legacy-dispatched call.
+  mutable std::atomic<DeprecatedTypeProperties*> registry
     [static_cast<int>(Backend::NumOptions)]
-    [static_cast<int>(ScalarType::NumOptions)];
+    [static_cast<int>(ScalarType::NumOptions)] = {};
+  mutable std::mutex materialize_mutex;
 };
 
 CAFFE2_API DeprecatedTypePropertiesRegistry& globalDeprecatedTypePropertiesRegistry();
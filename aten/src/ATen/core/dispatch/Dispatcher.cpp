@@ -28,6 +28,14 @@ private:
 
 OpRegistrationListener::~OpRegistrationListener() {}
 
+namespace impl {
+std::atomic<uint64_t>& UnboxedDispatchCache::globalGeneration() {
+  // Starts at 1 so that default-constructed cache entries are always stale.
+  static std::atomic<uint64_t> generation{1};
+  return generation;
+}
+}
+
 Dispatcher::Dispatcher()
 : operators_()
 , operatorLookupTable_()
@@ -122,6 +130,7 @@ RegistrationHandleRAII Dispatcher::registerBackendFallbackKernel(TensorTypeId di
     auto inserted = backendFallbackKernels.emplace(dispatchKey, std::move(kernel));
     TORCH_CHECK(inserted.second, "Tried to register a backend fallback kernel for ", dispatchKey, " but there was already one registered.");
   });
+  impl::UnboxedDispatchCache::invalidateAll();
 
   return RegistrationHandleRAII([this, dispatchKey] {
     deregisterBackendFallbackKernel_(dispatchKey);
@@ -133,6 +142,7 @@ void Dispatcher::deregisterBackendFallbackKernel_(TensorTypeId dispatchKey) {
     size_t numRemoved = backendFallbackKernels.erase(dispatchKey);
     TORCH_INTERNAL_ASSERT(1 == numRemoved, "Tried to deregister a backend fallback kernel for ", dispatchKey, " but there was none registered.");
   });
+  impl::UnboxedDispatchCache::invalidateAll();
 }
 
 RegistrationHandleRAII Dispatcher::registerKernel(const OperatorHandle& op, TensorTypeId dispatch_key, KernelFunction kernel) {
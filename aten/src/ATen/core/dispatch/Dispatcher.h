@@ -2,6 +2,7 @@
 
 #include <ATen/core/dispatch/OperatorEntry.h>
 #include <ATen/core/dispatch/RegistrationHandleRAII.h>
+#include <ATen/core/dispatch/UnboxedDispatchCache.h>
 #include <c10/util/Exception.h>
 #include <mutex>
 #include <list>
@@ -104,6 +105,18 @@ public:
   template<class Return, class... Args>
   Return callUnboxedOnly(const OperatorHandle& op, Args... args) const;
 
+  /**
+   * Like callUnboxed, but consults a caller-provided one-entry kernel cache
+   * before walking the dispatch table. `cache` must be thread-local to the
+   * caller; the generated wrappers keep one per call site. Falls back to the
+   * uncached path (and refills the cache) on a miss.
+   */
+  template<class Return, class... Args>
+  Return callUnboxedCached(const OperatorHandle& op, impl::UnboxedDispatchCache& cache, Args... args) const;
+
+  template<class Return, class... Args>
+  Return callUnboxedOnlyCached(const OperatorHandle& op, impl::UnboxedDispatchCache& cache, Args... args) const;
+
   void callBoxed(const OperatorHandle& op, Stack* stack) const;
 
   /**
@@ -128,6 +141,10 @@ private:
   Return doCallUnboxed(const DispatchTable& dispatchTable, const LeftRight<ska::flat_hash_map<TensorTypeId, KernelFunction>>& backendFallbackKernels_, Args... args) const;
   template<class Return, class... Args>
   Return doCallUnboxedOnly(const DispatchTable& dispatchTable, const LeftRight<ska::flat_hash_map<TensorTypeId, KernelFunction>>& backendFallbackKernels_, Args... args) const;
+  template<class Return, class... Args>
+  Return doCallUnboxedCached(const DispatchTable& dispatchTable, const LeftRight<ska::flat_hash_map<TensorTypeId, KernelFunction>>& backendFallbackKernels_, TensorTypeId dispatchKey, impl::UnboxedDispatchCache& cache, Args... args) const;
+  template<class Return, class... Args>
+  Return doCallUnboxedOnlyCached(const DispatchTable& dispatchTable, const LeftRight<ska::flat_hash_map<TensorTypeId, KernelFunction>>& backendFallbackKernels_, TensorTypeId dispatchKey, impl::UnboxedDispatchCache& cache, Args... args) const;
 
   std::list<OperatorDef> operators_;
   LeftRight<ska::flat_hash_map<OperatorName, OperatorHandle>> operatorLookupTable_;
@@ -212,6 +229,76 @@ inline Return Dispatcher::doCallUnboxedOnly(const DispatchTable& dispatchTable,
   });
 }
 
+template<class Return, class... Args>
+inline Return Dispatcher::callUnboxedCached(const OperatorHandle& op, impl::UnboxedDispatchCache& cache, Args... args) const {
+  detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
+
+  auto typeSet = detail::multi_dispatch_tensor_type_set(args...);
+  if (C10_LIKELY(!typeSet.empty())) {
+    TensorTypeId dispatchKey = impl::dispatchTypeId(typeSet);
+    if (C10_LIKELY(cache.key == dispatchKey &&
+                   cache.generation == impl::UnboxedDispatchCache::globalGeneration().load(std::memory_order_acquire))) {
+      return cache.kernel.template callUnboxed<Return, Args...>(std::forward<Args>(args)...);
+    }
+    // note: this doesn't need the mutex because write operations on the list keep iterators intact.
+    return op.operatorIterator_->op.readDispatchTable([&] (const DispatchTable& dispatchTable) -> Return {
+      return doCallUnboxedCached<Return, Args...>(dispatchTable, backendFallbackKernels_, dispatchKey, cache, std::forward<Args>(args)...);
+    });
+  }
+  // No tensor arguments, i.e. a catchall-only call; not worth caching.
+  return callUnboxed<Return, Args...>(op, std::forward<Args>(args)...);
+}
+
+template<class Return, class... Args>
+inline Return Dispatcher::doCallUnboxedCached(const DispatchTable& dispatchTable, const LeftRight<ska::flat_hash_map<TensorTypeId, KernelFunction>>& backendFallbackKernels_, TensorTypeId dispatchKey, impl::UnboxedDispatchCache& cache, Args... args) const {
+  detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
+  return backendFallbackKernels_.read([&] (const ska::flat_hash_map<TensorTypeId, KernelFunction>& backendFallbackKernels) -> Return {
+    // Load the generation before the lookup so that a registration racing
+    // with this fill can only make the entry stale, never wrongly fresh.
+    uint64_t generation = impl::UnboxedDispatchCache::globalGeneration().load(std::memory_order_acquire);
+    const KernelFunction& kernel = dispatch_(dispatchTable, backendFallbackKernels, dispatchKey);
+    cache.key = dispatchKey;
+    cache.kernel = kernel;
+    cache.generation = generation;
+    return kernel.template callUnboxed<Return, Args...>(std::forward<Args>(args)...);
+  });
+}
+
+template<class Return, class... Args>
+inline Return Dispatcher::callUnboxedOnlyCached(const OperatorHandle& op, impl::UnboxedDispatchCache& cache, Args... args) const {
+  detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
+
+  auto typeSet = detail::multi_dispatch_tensor_type_set(args...);
+  if (C10_LIKELY(!typeSet.empty())) {
+    TensorTypeId dispatchKey = impl::dispatchTypeId(typeSet);
+    if (C10_LIKELY(cache.key == dispatchKey &&
+                   cache.generation == impl::UnboxedDispatchCache::globalGeneration().load(std::memory_order_acquire))) {
+      return cache.kernel.template callUnboxedOnly<Return, Args...>(std::forward<Args>(args)...);
+    }
+    // note: this doesn't need the mutex because write operations on the list keep iterators intact.
+    return op.operatorIterator_->op.readDispatchTable([&] (const DispatchTable& dispatchTable) -> Return {
+      return doCallUnboxedOnlyCached<Return, Args...>(dispatchTable, backendFallbackKernels_, dispatchKey, cache, std::forward<Args>(args)...);
+    });
+  }
+  // No tensor arguments, i.e. a catchall-only call; not worth caching.
+  return callUnboxedOnly<Return, Args...>(op, std::forward<Args>(args)...);
+}
+
+template<class Return, class... Args>
+inline Return Dispatcher::doCallUnboxedOnlyCached(const DispatchTable& dispatchTable, const LeftRight<ska::flat_hash_map<TensorTypeId, KernelFunction>>& backendFallbackKernels_, TensorTypeId dispatchKey, impl::UnboxedDispatchCache& cache, Args... args) const {
+  detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
+  return backendFallbackKernels_.read([&] (const ska::flat_hash_map<TensorTypeId, KernelFunction>& backendFallbackKernels) -> Return {
+    // Load the generation before the lookup so that a registration racing
+    // with this fill can only make the entry stale, never wrongly fresh.
+    uint64_t generation = impl::UnboxedDispatchCache::globalGeneration().load(std::memory_order_acquire);
+    const KernelFunction& kernel = dispatch_(dispatchTable, backendFallbackKernels, dispatchKey);
+    cache.key = dispatchKey;
+    cache.kernel = kernel;
+    cache.generation = generation;
+    return kernel.template callUnboxedOnly<Return, Args...>(std::forward<Args>(args)...);
+  });
+}
+
 inline void Dispatcher::callBoxed(const OperatorHandle& op, Stack* stack) const {
   // note: this doesn't need the mutex because write operations on the list keep iterators intact.
   return op.operatorIterator_->op.readDispatchTable([&] (const DispatchTable& dispatchTable) {
@@ -1,4 +1,5 @@
 #include <ATen/core/dispatch/OperatorEntry.h>
+#include <ATen/core/dispatch/UnboxedDispatchCache.h>
 
 namespace c10 {
 namespace impl {
@@ -109,6 +110,7 @@ void OperatorEntry::updateDispatchTable_(TensorTypeId dispatch_key) {
       dispatchTable.setKernel(dispatch_key, k->second.front());
     });
   }
+  UnboxedDispatchCache::invalidateAll();
 }
 
 void OperatorEntry::updateCatchallDispatchTable_() {
@@ -123,6 +125,7 @@ void OperatorEntry::updateCatchallDispatchTable_() {
       dispatchTable.setCatchallKernel(catchAllKernels_.front());
     });
   }
+  UnboxedDispatchCache::invalidateAll();
 }
 
 }
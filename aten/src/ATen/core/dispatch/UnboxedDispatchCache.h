@@ -0,0 +1,45 @@
+#pragma once
+
+#include <ATen/core/boxing/KernelFunction.h>
+#include <c10/core/TensorTypeId.h>
+#include <atomic>
+#include <cstdint>
+
+namespace c10 {
+namespace impl {
+
+// One-entry kernel cache for the unboxed dispatch fast path.
+//
+// Resolving a kernel means reading the per-operator LeftRight dispatch table,
+// reading the backend fallback table and doing a hash lookup on the dispatch
+// key. For call sites that see the same backend over and over (the common
+// case in eager mode), all of that work re-derives the same KernelFunction
+// every time. The generated wrappers in TensorMethods.h/Functions.h keep one
+// of these per call site (as a function-local thread_local) and the
+// Dispatcher uses it to skip the table walk when the dispatch key computed
+// from the arguments matches the cached one.
+//
+// The cached kernel is a copy, not a pointer into the dispatch table, so it
+// stays callable even if the table rehashes. Staleness is handled with a
+// global generation counter: every kernel (de)registration anywhere in the
+// dispatcher bumps it, and an entry is only used while the generation it was
+// filled under is still current. Instances must be thread-local; nothing
+// here synchronizes access to the entry itself.
+struct CAFFE2_API UnboxedDispatchCache final {
+  // The current global registration generation. Starts at 1 so that a
+  // default-constructed entry (generation 0) never matches.
+  static std::atomic<uint64_t>& globalGeneration();
+
+  // Called by the dispatcher whenever a dispatch table or the backend
+  // fallback table changes. Invalidates all cached entries.
+  static void invalidateAll() {
+    globalGeneration().fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  uint64_t generation = 0;
+  TensorTypeId key = TensorTypeId::UndefinedTensorId;
+  KernelFunction kernel;
+};
+
+} // namespace impl
+} // namespace c10
@@ -85,6 +85,7 @@ namespace c10 {
   _(prim, ConstantChunk)             \
   _(prim, MMTreeReduce)              \
   _(prim, MMBatchSide)               \
+  _(prim, MMBatchIndependent)        \
   _(prim, min)                       \
   _(prim, max)                       \
   _(prim, abs)                       \
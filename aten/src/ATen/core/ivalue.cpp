@@ -3,16 +3,103 @@
 #include <ATen/core/Formatting.h>
 #include <c10/util/StringUtil.h>
 #include <cmath>
+#include <mutex>
+#include <unordered_map>
 #include <ATen/core/Dict.h>
 
 namespace c10 {
 namespace ivalue {
 
+namespace {
+
+// Scripted graphs construct the same constant strings over and over (dict
+// keys, format arguments, enum-like tags). ConstantString is immutable, so
+// equal strings can share one instance: short strings are looked up in a
+// bounded intern table and only allocated on the first sighting. The table
+// holds owning references and is never pruned; it is capped so a workload
+// with many distinct dynamic strings degrades to plain allocation instead
+// of growing without bound.
+constexpr size_t kMaxInternedStringLength = 64;
+constexpr size_t kMaxInternedStrings = 8192;
+
+struct InternedStrings {
+  std::mutex mutex;
+  std::unordered_map<std::string, c10::intrusive_ptr<ConstantString>> table;
+};
+
+InternedStrings& internedStrings() {
+  static InternedStrings* strings = new InternedStrings();
+  return *strings;
+}
+
+} // namespace
+
 CAFFE2_API c10::intrusive_ptr<ConstantString> ConstantString::create(
     std::string str_) {
+  if (str_.size() <= kMaxInternedStringLength) {
+    auto& interned = internedStrings();
+    std::lock_guard<std::mutex> lock(interned.mutex);
+    auto it = interned.table.find(str_);
+    if (it != interned.table.end()) {
+      return it->second;
+    }
+    if (interned.table.size() < kMaxInternedStrings) {
+      auto result = c10::make_intrusive<ConstantString>(std::move(str_));
+      interned.table.emplace(result->string(), result);
+      return result;
+    }
+  }
   return c10::make_intrusive<ConstantString>(std::move(str_));
 }
 
+// Note [Tuple allocation recycling]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Control-flow-heavy scripted models build and tear down small tuples on
+// nearly every interpreter instruction, so the Tuple object itself is
+// allocated from a bounded thread-local freelist instead of the heap.
+// Tuple cannot be subclassed (its constructor is private), so every block
+// handed out here has exactly sizeof(Tuple) bytes. Blocks may be freed on a
+// different thread than they were allocated on; that only moves them to the
+// other thread's freelist, which is harmless. The element vector inside the
+// tuple still allocates; inlining it into the object is not possible while
+// elements() hands out a std::vector<IValue>& across the JIT.
+
+namespace {
+
+constexpr size_t kTupleFreeListMaxSize = 256;
+
+struct TupleFreeList {
+  std::vector<void*> blocks;
+  ~TupleFreeList() {
+    for (void* block : blocks) {
+      ::operator delete(block);
+    }
+  }
+};
+
+thread_local TupleFreeList tuple_free_list;
+
+} // namespace
+
+void* Tuple::operator new(size_t size) {
+  auto& free_list = tuple_free_list.blocks;
+  if (size == sizeof(Tuple) && !free_list.empty()) {
+    void* block = free_list.back();
+    free_list.pop_back();
+    return block;
+  }
+  return ::operator new(size);
+}
+
+void Tuple::operator delete(void* ptr) {
+  auto& free_list = tuple_free_list.blocks;
+  if (free_list.size() < kTupleFreeListMaxSize) {
+    free_list.push_back(ptr);
+    return;
+  }
+  ::operator delete(ptr);
+}
+
 TupleTypePtr Tuple::type() const {
   if (!type_) {
     type_ = TupleType::create(
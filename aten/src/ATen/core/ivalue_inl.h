@@ -174,6 +174,12 @@ struct CAFFE2_API Tuple : c10::intrusive_ptr_target {
   }
   std::shared_ptr<TupleType> type() const;
 
+  // Recycles Tuple blocks through a thread-local freelist; the interpreter
+  // creates and destroys tuples at high frequency. See
+  // Note [Tuple allocation recycling] in ivalue.cpp.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
  private:
   Tuple(std::vector<IValue> elements, std::shared_ptr<TupleType> type = nullptr)
     : elements_(std::move(elements)), type_(std::move(type)) {}
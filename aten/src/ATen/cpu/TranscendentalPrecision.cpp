@@ -0,0 +1,35 @@
+#include <ATen/cpu/TranscendentalPrecision.h>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace at { namespace cpu {
+
+namespace {
+
+TranscendentalPrecision default_precision() {
+  static const TranscendentalPrecision def = []() {
+    const char* env = std::getenv("ATEN_FAST_TRANSCENDENTALS");
+    if (env &&
+        (std::strcmp(env, "1") == 0 || std::strcmp(env, "true") == 0 ||
+         std::strcmp(env, "TRUE") == 0)) {
+      return TranscendentalPrecision::Fast;
+    }
+    return TranscendentalPrecision::Accurate;
+  }();
+  return def;
+}
+
+thread_local TranscendentalPrecision precision = default_precision();
+
+}  // namespace
+
+TranscendentalPrecision get_transcendental_precision() {
+  return precision;
+}
+
+void set_transcendental_precision(TranscendentalPrecision p) {
+  precision = p;
+}
+
+}}  // namespace at::cpu
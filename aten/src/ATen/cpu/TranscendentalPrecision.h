@@ -0,0 +1,45 @@
+#pragma once
+
+/// Per-thread precision mode for vectorized transcendental functions
+///
+/// The Vec256 implementations of exp/log/tanh/erf (and everything built on
+/// them, e.g. sigmoid, softmax and GELU) default to ~1-ulp accurate
+/// implementations. Inference workloads that tolerate relaxed precision can
+/// switch the calling thread to faster polynomial approximations accurate
+/// to a few ulp (see vec256/fast_math.h for the exact guarantees per
+/// function). The mode is thread-local so a serving thread can run relaxed
+/// while other threads are unaffected; the process-wide default can be set
+/// with ATEN_FAST_TRANSCENDENTALS=1.
+
+namespace at { namespace cpu {
+
+enum class TranscendentalPrecision {
+  /// ~1-ulp implementations (Sleef u10 / libm); the default.
+  Accurate,
+  /// Polynomial approximations with a few ulp of error, no proper NaN
+  /// propagation in exp, and saturating behavior at the float range limits.
+  Fast,
+};
+
+TranscendentalPrecision get_transcendental_precision();
+void set_transcendental_precision(TranscendentalPrecision precision);
+
+/// RAII guard that sets the calling thread's precision mode and restores
+/// the previous mode on destruction.
+struct TranscendentalPrecisionGuard {
+  explicit TranscendentalPrecisionGuard(TranscendentalPrecision precision)
+      : prev_(get_transcendental_precision()) {
+    set_transcendental_precision(precision);
+  }
+  ~TranscendentalPrecisionGuard() {
+    set_transcendental_precision(prev_);
+  }
+  TranscendentalPrecisionGuard(const TranscendentalPrecisionGuard&) = delete;
+  TranscendentalPrecisionGuard& operator=(const TranscendentalPrecisionGuard&) =
+      delete;
+
+ private:
+  TranscendentalPrecision prev_;
+};
+
+}}  // namespace at::cpu
@@ -0,0 +1,234 @@
+#pragma once
+
+// Relaxed-precision transcendental kernels used by Vec256 when the calling
+// thread is in TranscendentalPrecision::Fast mode (see
+// ATen/cpu/TranscendentalPrecision.h).
+//
+// The float implementations are classic Cephes-style approximations:
+//   exp:  range reduction by log2(e) plus a degree-5 polynomial; ~2 ulp.
+//         Inputs are clamped to [-87.34, 88.38], so overflow saturates to
+//         ~FLT_MAX instead of inf and NaN is not propagated faithfully.
+//   log:  exponent extraction plus a degree-8 polynomial on the mantissa;
+//         ~2 ulp. log(0) = -inf and log(x < 0) = NaN as usual.
+//   tanh: odd polynomial below 0.625, 1 - 2/(exp(2x)+1) above; ~3 ulp.
+//   erf:  Abramowitz & Stegun 7.1.26; absolute error <= ~6e-7 (the
+//         relative error grows near zero, which is fine for the GELU /
+//         normal-CDF uses this mode targets).
+//
+// Sleef already ships u35 (~3.5 ulp) variants of log and tanh, so the AVX
+// paths use those directly and only exp and erf need the hand-written AVX2
+// kernels below. There are no relaxed double-precision kernels: for double
+// the AVX paths fall back to the u35 Sleef variants where they exist and
+// the accurate implementations otherwise.
+
+#include <ATen/cpu/TranscendentalPrecision.h>
+#include <ATen/cpu/vec256/intrinsics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+inline bool fast_transcendentals_enabled() {
+  return cpu::get_transcendental_precision() ==
+      cpu::TranscendentalPrecision::Fast;
+}
+
+namespace fast_math {
+
+inline float exp(float x) {
+  x = std::min(x, 88.3762626647949f);
+  x = std::max(x, -87.3365478515625f);
+  // exp(x) = 2^n * exp(r) with r = x - n * ln(2), |r| <= ln(2) / 2. ln(2)
+  // is split in two for an exactly representable high part.
+  float fx = std::floor(x * 1.44269504088896341f + 0.5f);
+  x -= fx * 0.693359375f;
+  x -= fx * -2.12194440e-4f;
+  float y = 1.9875691500e-4f;
+  y = y * x + 1.3981999507e-3f;
+  y = y * x + 8.3334519073e-3f;
+  y = y * x + 4.1665795894e-2f;
+  y = y * x + 1.6666665459e-1f;
+  y = y * x + 5.0000001201e-1f;
+  y = y * x * x + x + 1.0f;
+  // 2^n built directly in the exponent field; the clamp above keeps
+  // n + 127 in range.
+  int32_t n = (static_cast<int32_t>(fx) + 127) << 23;
+  float pow2n;
+  std::memcpy(&pow2n, &n, sizeof(n));
+  return y * pow2n;
+}
+
+inline float log(float x) {
+  if (!(x > 0.0f)) {
+    // Covers zero, negatives and NaN.
+    if (x == 0.0f) {
+      return -std::numeric_limits<float>::infinity();
+    }
+    return std::numeric_limits<float>::quiet_NaN();
+  }
+  if (std::isinf(x)) {
+    return x;
+  }
+  float extra = 0.0f;
+  if (x < 1.17549435e-38f) {
+    // Normalize subnormals so the exponent extraction below is valid.
+    x *= 8388608.0f; // 2^23
+    extra = -23.0f;
+  }
+  int32_t ix;
+  std::memcpy(&ix, &x, sizeof(ix));
+  float e = static_cast<float>(((ix >> 23) & 0xff) - 126) + extra;
+  // Mantissa in [0.5, 1), shifted to [sqrt(1/2), sqrt(2)) around 1.
+  ix = (ix & 0x007fffff) | 0x3f000000;
+  float m;
+  std::memcpy(&m, &ix, sizeof(m));
+  if (m < 0.707106781186547524f) {
+    e -= 1.0f;
+    m = m + m - 1.0f;
+  } else {
+    m = m - 1.0f;
+  }
+  float z = m * m;
+  float y = 7.0376836292e-2f;
+  y = y * m + -1.1514610310e-1f;
+  y = y * m + 1.1676998740e-1f;
+  y = y * m + -1.2420140846e-1f;
+  y = y * m + 1.4249322787e-1f;
+  y = y * m + -1.6668057665e-1f;
+  y = y * m + 2.0000714765e-1f;
+  y = y * m + -2.4999993993e-1f;
+  y = y * m + 3.3333331174e-1f;
+  y = y * m * z;
+  y += e * -2.12194440e-4f;
+  y -= 0.5f * z;
+  return m + y + e * 0.693359375f;
+}
+
+inline float tanh(float x) {
+  float ax = std::fabs(x);
+  if (ax < 0.625f) {
+    float z = x * x;
+    float r = -5.70498872745e-3f;
+    r = r * z + 2.06390887954e-2f;
+    r = r * z + -5.37397155531e-2f;
+    r = r * z + 1.33314422036e-1f;
+    r = r * z + -3.33332819422e-1f;
+    return x + x * z * r;
+  }
+  float r = 1.0f - 2.0f / (fast_math::exp(ax + ax) + 1.0f);
+  return std::copysign(r, x);
+}
+
+inline float erf(float x) {
+  float ax = std::fabs(x);
+  float t = 1.0f / (1.0f + 0.3275911f * ax);
+  float y = 1.061405429f;
+  y = y * t + -1.453152027f;
+  y = y * t + 1.421413741f;
+  y = y * t + -0.284496736f;
+  y = y * t + 0.254829592f;
+  y = y * t;
+  float r = 1.0f - y * fast_math::exp(-ax * ax);
+  return std::copysign(r, x);
+}
+
+// Scalar dispatch used by the generic Vec256 fallback: only float has
+// relaxed kernels, every other type resolves to the accurate call so the
+// branch in vec256_base.h compiles for all element types.
+template <typename T>
+struct dispatch {
+  static constexpr bool available() {
+    return false;
+  }
+  static T exp(T x) {
+    return std::exp(x);
+  }
+  static T log(T x) {
+    return std::log(x);
+  }
+  static T tanh(T x) {
+    return std::tanh(x);
+  }
+  static T erf(T x) {
+    return std::erf(x);
+  }
+};
+
+template <>
+struct dispatch<float> {
+  static constexpr bool available() {
+    return true;
+  }
+  static float exp(float x) {
+    return fast_math::exp(x);
+  }
+  static float log(float x) {
+    return fast_math::log(x);
+  }
+  static float tanh(float x) {
+    return fast_math::tanh(x);
+  }
+  static float erf(float x) {
+    return fast_math::erf(x);
+  }
+};
+
+#if defined(__AVX2__) && !defined(_MSC_VER)
+
+// AVX2 versions of the float kernels above (AVX2 implies FMA in this
+// build, see the fmadd specializations in vec256_float.h).
+
+inline __m256 exp_ps(__m256 x) {
+  x = _mm256_min_ps(x, _mm256_set1_ps(88.3762626647949f));
+  x = _mm256_max_ps(x, _mm256_set1_ps(-87.3365478515625f));
+  __m256 fx = _mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f));
+  fx = _mm256_round_ps(fx, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+  x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+  __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507e-3f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073e-3f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894e-2f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201e-1f));
+  __m256 x2 = _mm256_mul_ps(x, x);
+  y = _mm256_fmadd_ps(y, x2, _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+  __m256i n = _mm256_cvtps_epi32(fx);
+  n = _mm256_add_epi32(n, _mm256_set1_epi32(127));
+  n = _mm256_slli_epi32(n, 23);
+  return _mm256_mul_ps(y, _mm256_castsi256_ps(n));
+}
+
+inline __m256 erf_ps(__m256 x) {
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  __m256 sign = _mm256_and_ps(x, sign_mask);
+  __m256 ax = _mm256_andnot_ps(sign_mask, x);
+  __m256 t = _mm256_div_ps(
+      _mm256_set1_ps(1.0f),
+      _mm256_fmadd_ps(_mm256_set1_ps(0.3275911f), ax, _mm256_set1_ps(1.0f)));
+  __m256 y = _mm256_set1_ps(1.061405429f);
+  y = _mm256_fmadd_ps(y, t, _mm256_set1_ps(-1.453152027f));
+  y = _mm256_fmadd_ps(y, t, _mm256_set1_ps(1.421413741f));
+  y = _mm256_fmadd_ps(y, t, _mm256_set1_ps(-0.284496736f));
+  y = _mm256_fmadd_ps(y, t, _mm256_set1_ps(0.254829592f));
+  y = _mm256_mul_ps(y, t);
+  // exp(-|x|^2)
+  __m256 e = exp_ps(_mm256_xor_ps(_mm256_mul_ps(ax, ax), sign_mask));
+  __m256 r = _mm256_fnmadd_ps(y, e, _mm256_set1_ps(1.0f));
+  return _mm256_or_ps(r, sign);
+}
+
+#endif
+
+} // namespace fast_math
+
+} // namespace
+} // namespace vec256
+} // namespace at
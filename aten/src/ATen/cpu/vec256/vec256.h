@@ -5,6 +5,7 @@
 #include <ATen/cpu/vec256/vec256_base.h>
 #include <ATen/cpu/vec256/vec256_float.h>
 #include <ATen/cpu/vec256/vec256_double.h>
+#include <ATen/cpu/vec256/vec256_bfloat16.h>
 #include <ATen/cpu/vec256/vec256_int.h>
 #include <ATen/cpu/vec256/vec256_qint.h>
 #include <ATen/cpu/vec256/vec256_complex_float.h>
@@ -46,6 +47,13 @@ std::ostream& operator<<(std::ostream& stream, const Vec256<T>& vec) {
 }
 
 
+// The AVX512 capability copies of the kernels also take these paths:
+// -mavx512f implies __AVX2__, so they get the 256-bit intrinsic
+// specializations below, and the compiler is free to use 512-bit
+// instructions (and the doubled register file) when vectorizing around
+// them. A dedicated 512-bit Vec512 would double the lane width on top of
+// that and can be layered in per-type later without touching the dispatch
+// machinery.
 #if defined(__AVX__) && !defined(_MSC_VER)
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ CAST (AVX) ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -7,6 +7,7 @@
 #include <bitset>
 
 #include <ATen/Utils.h>
+#include <ATen/cpu/vec256/fast_math.h>
 #include <ATen/native/Copy.h>
 #include <ATen/native/Math.h>
 #include <ATen/NumericUtils.h>
@@ -151,11 +152,15 @@ public:
     std::memcpy(vec.values, ptr, 32);
     return vec;
   }
+  // Partial load: reads only count elements, so it is safe at the end of a
+  // buffer. Lanes past count are zero. The AVX specializations implement this
+  // with masked loads; kernel loops rely on the same contract there.
   static Vec256<T> loadu(const void* ptr, int64_t count) {
     Vec256 vec;
     std::memcpy(vec.values, ptr, count * sizeof(T));
     return vec;
   }
+  // Partial store: writes only the low count elements.
   void store(void* ptr, int count = size()) const {
     std::memcpy(ptr, values, count * sizeof(T));
   }
@@ -276,6 +281,9 @@ public:
     return ret;
   }
   Vec256<T> erf() const {
+    if (fast_math::dispatch<T>::available() && fast_transcendentals_enabled()) {
+      return map(fast_math::dispatch<T>::erf);
+    }
     return map(std::erf);
   }
   Vec256<T> erfc() const {
@@ -285,6 +293,9 @@ public:
     return map(calc_erfinv);
   }
   Vec256<T> exp() const {
+    if (fast_math::dispatch<T>::available() && fast_transcendentals_enabled()) {
+      return map(fast_math::dispatch<T>::exp);
+    }
     return map(std::exp);
   }
   Vec256<T> expm1() const {
@@ -294,6 +305,9 @@ public:
     return *this - this->trunc();
   }
   Vec256<T> log() const {
+    if (fast_math::dispatch<T>::available() && fast_transcendentals_enabled()) {
+      return map(fast_math::dispatch<T>::log);
+    }
     return map(std::log);
   }
   Vec256<T> log10() const {
@@ -349,6 +363,9 @@ public:
     return map(std::tan);
   }
   Vec256<T> tanh() const {
+    if (fast_math::dispatch<T>::available() && fast_transcendentals_enabled()) {
+      return map(fast_math::dispatch<T>::tanh);
+    }
     return map(std::tanh);
   }
   Vec256<T> trunc() const {
@@ -57,24 +57,27 @@ public:
     }
     return b;
   }
+  // Mask with the low count lanes enabled, for masked partial loads/stores.
+  static __m256i partial_lane_mask(int64_t count) {
+    alignas(32) static const int64_t mask_source[2 * size()] = {
+        -1, -1, -1, -1, 0, 0, 0, 0};
+    return _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(mask_source + size() - count));
+  }
   static Vec256<double> loadu(const void* ptr, int64_t count = size()) {
     if (count == size())
       return _mm256_loadu_pd(reinterpret_cast<const double*>(ptr));
-
-    __at_align32__ double tmp_values[size()];
-    std::memcpy(
-        tmp_values,
-        reinterpret_cast<const double*>(ptr),
-        count * sizeof(double));
-    return _mm256_load_pd(tmp_values);
+    // Masked load so that partial vectors come straight from memory instead
+    // of through a scalar copy; lanes past count read as zero.
+    return _mm256_maskload_pd(
+        reinterpret_cast<const double*>(ptr), partial_lane_mask(count));
   }
   void store(void* ptr, int count = size()) const {
     if (count == size()) {
       _mm256_storeu_pd(reinterpret_cast<double*>(ptr), values);
     } else if (count > 0) {
-      double tmp_values[size()];
-      _mm256_storeu_pd(reinterpret_cast<double*>(tmp_values), values);
-      std::memcpy(ptr, tmp_values, count * sizeof(double));
+      _mm256_maskstore_pd(
+          reinterpret_cast<double*>(ptr), partial_lane_mask(count), values);
     }
   }
   const double& operator[](int idx) const  = delete;
@@ -131,6 +134,9 @@ public:
     return Vec256<double>(Sleef_expm1d4_u10(values));
   }
   Vec256<double> log() const {
+    if (fast_transcendentals_enabled()) {
+      return Vec256<double>(Sleef_logd4_u35(values));
+    }
     return Vec256<double>(Sleef_logd4_u10(values));
   }
   Vec256<double> log2() const {
@@ -171,6 +177,12 @@ public:
     return Vec256<double>(Sleef_tand4_u10(values));
   }
   Vec256<double> tanh() const {
+    // Fast mode only relaxes log and tanh for double; Sleef has no relaxed
+    // double exp or erf and the relative error of the float polynomial
+    // kernels would be far too large for double.
+    if (fast_transcendentals_enabled()) {
+      return Vec256<double>(Sleef_tanhd4_u35(values));
+    }
     return Vec256<double>(Sleef_tanhd4_u10(values));
   }
   Vec256<double> trunc() const {
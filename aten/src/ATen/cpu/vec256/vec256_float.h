@@ -68,21 +68,27 @@ public:
     }
     return b;
   }
+  // Mask with the low count lanes enabled, for masked partial loads/stores.
+  static __m256i partial_lane_mask(int64_t count) {
+    alignas(32) static const int32_t mask_source[2 * size()] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+    return _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(mask_source + size() - count));
+  }
   static Vec256<float> loadu(const void* ptr, int64_t count = size()) {
     if (count == size())
       return _mm256_loadu_ps(reinterpret_cast<const float*>(ptr));
-    __at_align32__ float tmp_values[size()];
-    std::memcpy(
-        tmp_values, reinterpret_cast<const float*>(ptr), count * sizeof(float));
-    return _mm256_loadu_ps(tmp_values);
+    // Masked load so that partial vectors come straight from memory instead
+    // of through a scalar copy; lanes past count read as zero.
+    return _mm256_maskload_ps(
+        reinterpret_cast<const float*>(ptr), partial_lane_mask(count));
   }
   void store(void* ptr, int64_t count = size()) const {
     if (count == size()) {
       _mm256_storeu_ps(reinterpret_cast<float*>(ptr), values);
     } else if (count > 0) {
-      float tmp_values[size()];
-      _mm256_storeu_ps(reinterpret_cast<float*>(tmp_values), values);
-      std::memcpy(ptr, tmp_values, count * sizeof(float));
+      _mm256_maskstore_ps(
+          reinterpret_cast<float*>(ptr), partial_lane_mask(count), values);
     }
   }
   const float& operator[](int idx) const  = delete;
@@ -124,6 +130,11 @@ public:
     return Vec256<float>(Sleef_atan2f8_u10(values, b));
   }
   Vec256<float> erf() const {
+#ifdef __AVX2__
+    if (fast_transcendentals_enabled()) {
+      return Vec256<float>(fast_math::erf_ps(values));
+    }
+#endif
     return Vec256<float>(Sleef_erff8_u10(values));
   }
   Vec256<float> erfc() const {
@@ -133,12 +144,22 @@ public:
     return map(calc_erfinv);
   }
   Vec256<float> exp() const {
+    // Sleef has no relaxed expf, so fast mode uses the hand-written AVX2
+    // kernel (see fast_math.h).
+#ifdef __AVX2__
+    if (fast_transcendentals_enabled()) {
+      return Vec256<float>(fast_math::exp_ps(values));
+    }
+#endif
     return Vec256<float>(Sleef_expf8_u10(values));
   }
   Vec256<float> expm1() const {
     return Vec256<float>(Sleef_expm1f8_u10(values));
   }
   Vec256<float> log() const {
+    if (fast_transcendentals_enabled()) {
+      return Vec256<float>(Sleef_logf8_u35(values));
+    }
     return Vec256<float>(Sleef_logf8_u10(values));
   }
   Vec256<float> log2() const {
@@ -179,6 +200,9 @@ public:
     return Vec256<float>(Sleef_tanf8_u10(values));
   }
   Vec256<float> tanh() const {
+    if (fast_transcendentals_enabled()) {
+      return Vec256<float>(Sleef_tanhf8_u35(values));
+    }
     return Vec256<float>(Sleef_tanhf8_u10(values));
   }
   Vec256<float> trunc() const {
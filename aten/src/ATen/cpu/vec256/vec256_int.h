@@ -72,21 +72,28 @@ struct Vec256<int64_t> : public Vec256i {
     }
     return b;
   }
+  // Mask with the low count lanes enabled, for masked partial loads/stores.
+  static __m256i partial_lane_mask(int64_t count) {
+    alignas(32) static const int64_t mask_source[2 * size()] = {
+        -1, -1, -1, -1, 0, 0, 0, 0};
+    return _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(mask_source + size() - count));
+  }
   static Vec256<int64_t> loadu(const void* ptr) {
     return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
   }
   static Vec256<int64_t> loadu(const void* ptr, int64_t count) {
-    __at_align32__ int64_t tmp_values[size()];
-    std::memcpy(tmp_values, ptr, count * sizeof(int64_t));
-    return loadu(tmp_values);
+    // Masked load so that partial vectors come straight from memory instead
+    // of through a scalar copy; lanes past count read as zero.
+    return _mm256_maskload_epi64(
+        reinterpret_cast<const long long*>(ptr), partial_lane_mask(count));
   }
   void store(void* ptr, int count = size()) const {
     if (count == size()) {
       _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), values);
     } else if (count > 0) {
-      __at_align32__ int64_t tmp_values[size()];
-      _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp_values), values);
-      std::memcpy(ptr, tmp_values, count * sizeof(int64_t));
+      _mm256_maskstore_epi64(
+          reinterpret_cast<long long*>(ptr), partial_lane_mask(count), values);
     }
   }
   const int64_t& operator[](int idx) const  = delete;
@@ -179,21 +186,28 @@ struct Vec256<int32_t> : public Vec256i {
     }
     return b;
   }
+  // Mask with the low count lanes enabled, for masked partial loads/stores.
+  static __m256i partial_lane_mask(int32_t count) {
+    alignas(32) static const int32_t mask_source[2 * size()] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+    return _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(mask_source + size() - count));
+  }
   static Vec256<int32_t> loadu(const void* ptr) {
     return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
   }
   static Vec256<int32_t> loadu(const void* ptr, int32_t count) {
-    __at_align32__ int32_t tmp_values[size()];
-    std::memcpy(tmp_values, ptr, count * sizeof(int32_t));
-    return loadu(tmp_values);
+    // Masked load so that partial vectors come straight from memory instead
+    // of through a scalar copy; lanes past count read as zero.
+    return _mm256_maskload_epi32(
+        reinterpret_cast<const int*>(ptr), partial_lane_mask(count));
   }
   void store(void* ptr, int count = size()) const {
     if (count == size()) {
       _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), values);
     } else if (count > 0) {
-      __at_align32__ int32_t tmp_values[size()];
-      _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp_values), values);
-      std::memcpy(ptr, tmp_values, count * sizeof(int32_t));
+      _mm256_maskstore_epi32(
+          reinterpret_cast<int*>(ptr), partial_lane_mask(count), values);
     }
   }
   void dump() const {
@@ -388,7 +402,9 @@ struct Vec256<int16_t> : public Vec256i {
     return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
   }
   static Vec256<int16_t> loadu(const void* ptr, int16_t count) {
-    __at_align32__ int16_t tmp_values[size()];
+    // There is no 16-bit masked load; zero-fill a temporary instead so that
+    // lanes past count read as zero, like the masked loads above.
+    __at_align32__ int16_t tmp_values[size()] = {0};
     std::memcpy(tmp_values, ptr, count * sizeof(int16_t));
     return loadu(tmp_values);
   }
@@ -183,6 +183,15 @@ struct Vec256<c10::qint8> {
         return Vec256<c10::qint8>(ptr);
     }
 
+    static Vec256<c10::qint8> loadu(const void* ptr, int64_t count) {
+        // There is no 8/32-bit masked load covering every width here;
+        // zero-fill a temporary so lanes past count read as zero, matching
+        // the partial load contract in vec256_base.h.
+        __at_align32__ value_type tmp_values[size()] = {0};
+        memcpy(tmp_values, ptr, count * sizeof(value_type));
+        return Vec256<c10::qint8>(tmp_values);
+    }
+
  private:
     __m256i cvtepi8_epi32(__m128i epi8_vals) const {
 #ifdef __AVX2__
@@ -354,6 +363,15 @@ struct Vec256<c10::quint8> {
         return Vec256<c10::quint8>(ptr);
     }
 
+    static Vec256<c10::quint8> loadu(const void* ptr, int64_t count) {
+        // There is no 8/32-bit masked load covering every width here;
+        // zero-fill a temporary so lanes past count read as zero, matching
+        // the partial load contract in vec256_base.h.
+        __at_align32__ value_type tmp_values[size()] = {0};
+        memcpy(tmp_values, ptr, count * sizeof(value_type));
+        return Vec256<c10::quint8>(tmp_values);
+    }
+
  private:
     __m256i cvtepu8_epi32(__m128i epu8_vals) const {
 #ifdef __AVX2__
@@ -520,6 +538,15 @@ struct Vec256<c10::qint32> {
         return Vec256<c10::qint32>(ptr);
     }
 
+    static Vec256<c10::qint32> loadu(const void* ptr, int64_t count) {
+        // There is no 8/32-bit masked load covering every width here;
+        // zero-fill a temporary so lanes past count read as zero, matching
+        // the partial load contract in vec256_base.h.
+        __at_align32__ value_type tmp_values[size()] = {0};
+        memcpy(tmp_values, ptr, count * sizeof(value_type));
+        return Vec256<c10::qint32>(tmp_values);
+    }
+
     float_vec_return_type dequantize(
         Vec256<float> scale,
         Vec256<float> zero_point,
@@ -692,6 +719,12 @@ struct Vec256<c10::qint8> : public Vec256QuantizedConverter<
     return Vec256<c10::qint8>(ptr);
   }
 
+  static Vec256<c10::qint8> loadu(const void* ptr, int64_t count) {
+    value_type tmp_values[size()] = {0};
+    memcpy(tmp_values, ptr, count * sizeof(value_type));
+    return Vec256<c10::qint8>(tmp_values);
+  }
+
   static Vec256<c10::qint8> quantize(
       const float_vec_return_type& rhs,
       float scale,
@@ -762,6 +795,12 @@ struct Vec256<c10::quint8> : public Vec256QuantizedConverter<
     return Vec256<c10::quint8>(ptr);
   }
 
+  static Vec256<c10::quint8> loadu(const void* ptr, int64_t count) {
+    value_type tmp_values[size()] = {0};
+    memcpy(tmp_values, ptr, count * sizeof(value_type));
+    return Vec256<c10::quint8>(tmp_values);
+  }
+
   static Vec256<c10::quint8> quantize(
       const float_vec_return_type& rhs,
       float scale,
@@ -833,6 +872,12 @@ struct Vec256<c10::qint32> : public Vec256QuantizedConverter<
     return Vec256<c10::qint32>(ptr);
   }
 
+  static Vec256<c10::qint32> loadu(const void* ptr, int64_t count) {
+    value_type tmp_values[size()] = {0};
+    memcpy(tmp_values, ptr, count * sizeof(value_type));
+    return Vec256<c10::qint32>(tmp_values);
+  }
+
   static Vec256<c10::qint32> quantize(
       const float_vec_return_type& rhs,
       float scale,
@@ -0,0 +1,26 @@
+#include <ATen/cuda/AsyncCopy.h>
+
+#include <ATen/cuda/CUDAContext.h>
+
+namespace at { namespace cuda {
+
+HostCopyFuture copy_to_host_async(const Tensor& src) {
+  HostCopyFuture future;
+  if (!src.is_cuda()) {
+    // already on the host; the event was never recorded so the future is
+    // born completed
+    future.buffer_ = src;
+    return future;
+  }
+
+  future.buffer_ = at::empty(
+      src.sizes(), src.options().device(at::kCPU).pinned_memory(true));
+  // a non-blocking copy into pinned memory stays asynchronous on the
+  // current stream (see copy_kernel_cuda in native/cuda/Copy.cu)
+  future.buffer_.copy_(src, /*non_blocking=*/true);
+  future.event_.record(getCurrentCUDAStream(src.get_device()));
+  future.source_ = src;
+  return future;
+}
+
+}} // namespace at::cuda
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/ATenCUDAGeneral.h>
+#include <ATen/cuda/CUDAEvent.h>
+
+namespace at { namespace cuda {
+
+/*
+* A future-style handle for a device-to-host copy that was enqueued without
+* synchronizing the stream. copy_to_host_async() stages the result into a
+* pinned host buffer and records an event behind the copy; the caller keeps
+* issuing work (e.g. the next batch's compute) and claims the host tensor
+* with wait() only when it is actually needed.
+*
+* The handle keeps the source tensor alive until the copy is known to have
+* completed, so the caching allocator cannot hand its memory to another
+* stream while the transfer is in flight.
+*/
+struct TORCH_CUDA_API HostCopyFuture {
+  HostCopyFuture() = default;
+
+  HostCopyFuture(const HostCopyFuture&) = delete;
+  HostCopyFuture& operator=(const HostCopyFuture&) = delete;
+  HostCopyFuture(HostCopyFuture&&) = default;
+  HostCopyFuture& operator=(HostCopyFuture&&) = default;
+
+  // Returns true if the copy has completed and wait() will not block.
+  bool query() const {
+    return event_.query();
+  }
+
+  // Blocks until the copy has completed, then returns the host tensor.
+  Tensor wait() {
+    event_.synchronize();
+    source_ = Tensor();
+    return buffer_;
+  }
+
+ private:
+  Tensor buffer_;
+  Tensor source_;
+  CUDAEvent event_;
+
+  friend TORCH_CUDA_API HostCopyFuture copy_to_host_async(const Tensor& src);
+};
+
+// Enqueues an asynchronous copy of `src` into a freshly allocated pinned
+// host tensor on the current stream. A CPU `src` yields an already-completed
+// future holding `src` itself.
+TORCH_CUDA_API HostCopyFuture copy_to_host_async(const Tensor& src);
+
+}} // namespace at::cuda
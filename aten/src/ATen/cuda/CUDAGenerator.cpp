@@ -138,12 +138,18 @@ uint64_t CUDAGenerator::philox_offset_per_thread() {
  * value > the number of curand() calls won't harm but anything less would mean
  * that you would be reusing random values from previous calls.
  * 
- * See Note [Acquire lock when using random generators]
+ * Note [Philox offset reservation is lock free]
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Unlike the other generator methods, this one may be called without
+ * holding mutex_: the offset is reserved with a single atomic fetch-add,
+ * so concurrent launches (e.g. dropout on several threads sharing the
+ * default generator) each get a disjoint philox subsequence and never
+ * contend on the generator lock. Seeding the generator concurrently with
+ * kernel launches still requires external synchronization, as before.
  */
 std::pair<uint64_t, uint64_t> CUDAGenerator::philox_engine_inputs(uint64_t increment) {
-  uint64_t offset = this->philox_offset_per_thread_;
-  this->philox_offset_per_thread_ += increment;
-  return std::make_pair(this->seed_, offset);
+  uint64_t offset = philox_offset_per_thread_.fetch_add(increment, std::memory_order_relaxed);
+  return std::make_pair(seed_.load(std::memory_order_relaxed), offset);
 }
 
 /*
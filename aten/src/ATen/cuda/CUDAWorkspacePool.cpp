@@ -0,0 +1,101 @@
+#include <ATen/cuda/CUDAWorkspacePool.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Exceptions.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace at { namespace cuda {
+namespace {
+
+// See Note [Per-stream workspace pool] in CUDAWorkspacePool.h.
+
+struct WorkspaceKey {
+  int device;
+  cudaStream_t stream;
+
+  bool operator==(const WorkspaceKey& other) const {
+    return device == other.device && stream == other.stream;
+  }
+};
+
+struct WorkspaceKeyHash {
+  size_t operator()(const WorkspaceKey& key) const {
+    return std::hash<uintptr_t>()(
+        reinterpret_cast<uintptr_t>(key.stream) ^
+        static_cast<uintptr_t>(key.device));
+  }
+};
+
+struct Workspace {
+  void* data = nullptr;
+  size_t size = 0;
+};
+
+// Round the first request up so tiny workspaces do not cause a reallocation
+// cascade as sizes creep upward during warm-up.
+constexpr size_t kMinWorkspaceBytes = 1024 * 1024;
+
+struct WorkspacePool {
+  std::unordered_map<WorkspaceKey, Workspace, WorkspaceKeyHash> workspaces;
+
+  ~WorkspacePool() {
+    release();
+  }
+
+  void release() {
+    for (auto& entry : workspaces) {
+      if (entry.second.data) {
+        c10::cuda::CUDACachingAllocator::raw_delete(entry.second.data);
+      }
+    }
+    workspaces.clear();
+  }
+};
+
+// Thread-local (like the cuBLAS/cuDNN handle windows), so no lock is taken
+// per call and concurrent training threads never trade workspaces back and
+// forth. Workspaces return to the caching allocator on thread exit.
+thread_local WorkspacePool pool;
+
+} // namespace
+
+void* getStreamWorkspace(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+  int device;
+  AT_CUDA_CHECK(cudaGetDevice(&device));
+  WorkspaceKey key{device, c10::cuda::getCurrentCUDAStream(device).stream()};
+  Workspace& workspace = pool.workspaces[key];
+  if (size <= workspace.size) {
+    return workspace.data;
+  }
+  // Grow geometrically so a slowly increasing size sequence costs
+  // O(log max_size) reallocations instead of one per call.
+  size_t new_size = std::max(workspace.size * 2, kMinWorkspaceBytes);
+  while (new_size < size) {
+    new_size *= 2;
+  }
+  if (workspace.data) {
+    // Freed before allocating so the caching allocator can carve the
+    // replacement out of the same arena under memory pressure.
+    c10::cuda::CUDACachingAllocator::raw_delete(workspace.data);
+    workspace.data = nullptr;
+    workspace.size = 0;
+  }
+  workspace.data = c10::cuda::CUDACachingAllocator::raw_alloc(new_size);
+  workspace.size = new_size;
+  return workspace.data;
+}
+
+void emptyStreamWorkspaces() {
+  pool.release();
+}
+
+}} // namespace at::cuda
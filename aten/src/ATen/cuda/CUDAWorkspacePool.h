@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ATen/cuda/ATenCUDAGeneral.h>
+
+#include <cstddef>
+
+namespace at { namespace cuda {
+
+// Note [Per-stream workspace pool]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// cuDNN convolutions (and other scratch-hungry library calls) need a device
+// workspace whose size varies call to call. Allocating it per call through
+// the caching allocator means every conv pays an allocator round trip, and
+// under memory pressure those round trips can trigger cache flushes and
+// cudaMalloc/cudaFree, which shows up as tail-latency jitter.
+//
+// getStreamWorkspace instead hands out a persistent workspace keyed by
+// (current device, current stream) and owned by the calling thread -- the
+// same granularity as the thread-local cuDNN/cuBLAS handles, so one
+// workspace ends up bound to each (stream, handle) pair in steady state.
+// The workspace is only reallocated when a request outgrows it, and then it
+// grows geometrically, so after warm-up repeated calls never touch the
+// allocator at all.
+//
+// The returned pointer stays valid until the next getStreamWorkspace call
+// with a larger size on the same (device, stream) from the same thread, so
+// callers must finish enqueueing work that uses it before asking again.
+// Work already enqueued on the stream is always safe: the backing memory
+// comes from the caching allocator, whose freed blocks are only ever reused
+// by allocations on the same stream, i.e. in stream order.
+//
+// Returns a device pointer to at least `size` bytes, or nullptr when
+// `size` is zero.
+TORCH_CUDA_API void* getStreamWorkspace(size_t size);
+
+// Releases the calling thread's pooled workspaces back to the caching
+// allocator (they are otherwise held until thread exit).
+TORCH_CUDA_API void emptyStreamWorkspaces();
+
+}} // namespace at::cuda
@@ -0,0 +1,164 @@
+#include <ATen/cuda/MetricObserver.h>
+
+#include <ATen/core/op_registration/op_registration.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/CUDAEvent.h>
+#include <ATen/cuda/Exceptions.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAGuard.h>
+
+#include <cuda_runtime_api.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace at {
+namespace cuda {
+namespace {
+
+struct SinkRegistry {
+  std::mutex mutex;
+  std::unordered_map<int64_t, MetricSink> sinks;
+  int64_t next_handle = 0;
+};
+
+SinkRegistry& sinkRegistry() {
+  static SinkRegistry registry;
+  return registry;
+}
+
+// Everything the host callback needs to deliver one observation. Contexts
+// are not deleted inside the callback: releasing a tensor re-enters the
+// CUDA runtime (the pinned host allocator records events on free), which
+// callbacks are forbidden to do. Instead the callback parks the context on
+// a retired list that the next enqueue drains from an ordinary thread.
+struct ObserveContext {
+  std::string tag;
+  Tensor host_value;
+};
+
+std::mutex retired_mutex;
+std::vector<ObserveContext*> retired;
+
+void drainRetired() {
+  std::vector<ObserveContext*> drained;
+  {
+    std::lock_guard<std::mutex> lock(retired_mutex);
+    drained.swap(retired);
+  }
+  for (ObserveContext* ctx : drained) {
+    delete ctx;
+  }
+}
+
+void deliver(ObserveContext* ctx) {
+  // Snapshot the sinks so one of them can unregister itself (or another)
+  // without deadlocking on the registry mutex.
+  std::vector<MetricSink> sinks;
+  {
+    std::lock_guard<std::mutex> lock(sinkRegistry().mutex);
+    sinks.reserve(sinkRegistry().sinks.size());
+    for (const auto& entry : sinkRegistry().sinks) {
+      sinks.push_back(entry.second);
+    }
+  }
+  for (const auto& sink : sinks) {
+    sink(ctx->tag, ctx->host_value);
+  }
+  std::lock_guard<std::mutex> lock(retired_mutex);
+  retired.push_back(ctx);
+}
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+void CUDART_CB observerCallback(void* ctx) {
+  deliver(static_cast<ObserveContext*>(ctx));
+}
+#else
+void CUDART_CB
+observerCallback(cudaStream_t, cudaError_t, void* ctx) {
+  deliver(static_cast<ObserveContext*>(ctx));
+}
+#endif
+
+} // namespace
+
+int64_t registerMetricSink(MetricSink sink) {
+  auto& registry = sinkRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  int64_t handle = registry.next_handle++;
+  registry.sinks.emplace(handle, std::move(sink));
+  return handle;
+}
+
+void unregisterMetricSink(int64_t handle) {
+  drainRetired();
+  auto& registry = sinkRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.sinks.erase(handle);
+}
+
+void observeMetricAsync(const Tensor& metric, std::string tag) {
+  drainRetired();
+  std::unique_ptr<ObserveContext> ctx(new ObserveContext());
+  ctx->tag = std::move(tag);
+
+  if (!metric.is_cuda()) {
+    // Already on the host: reading it stalls nothing, deliver inline.
+    ctx->host_value = metric;
+    deliver(ctx.release());
+    return;
+  }
+
+  Tensor src = metric.contiguous();
+  c10::cuda::CUDAGuard device_guard(src.device());
+  ctx->host_value = at::empty(
+      src.sizes(), src.options().device(at::kCPU).pinned_memory(true));
+
+  // The side stream waits for the producing stream to reach this point, so
+  // the copy sees the finished value without the producer ever waiting.
+  CUDAStream side =
+      getStreamFromPool(/*isHighPriority=*/false, src.get_device());
+  CUDAEvent produced;
+  produced.record(getCurrentCUDAStream(src.get_device()));
+  produced.block(side);
+
+  // The caller may release `src` as soon as we return; record the side
+  // stream's use so the caching allocator keeps the block alive until the
+  // copy has read it.
+  c10::cuda::CUDACachingAllocator::recordStream(src.data_ptr(), side);
+
+  AT_CUDA_CHECK(cudaMemcpyAsync(
+      ctx->host_value.data_ptr(),
+      src.data_ptr(),
+      src.numel() * src.dtype().itemsize(),
+      cudaMemcpyDeviceToHost,
+      side.stream()));
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  AT_CUDA_CHECK(
+      cudaLaunchHostFunc(side.stream(), observerCallback, ctx.release()));
+#else
+  AT_CUDA_CHECK(cudaStreamAddCallback(
+      side.stream(), observerCallback, ctx.release(), 0));
+#endif
+}
+
+namespace {
+
+void observe_metric_async_op(Tensor self, std::string tag) {
+  observeMetricAsync(self, std::move(tag));
+}
+
+static auto registry = c10::RegisterOperators().op(
+    c10::RegisterOperators::options()
+        .schema("cuda::observe_metric_async(Tensor self, str tag) -> ()")
+        .catchAllKernel<
+            decltype(observe_metric_async_op),
+            &observe_metric_async_op>());
+
+} // namespace
+
+} // namespace cuda
+} // namespace at
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/ATenCUDAGeneral.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace at { namespace cuda {
+
+/*
+* Push-style counterpart to copy_to_host_async() (AsyncCopy.h) for training
+* metrics: instead of handing the caller a future to poll, the value is
+* delivered to registered sinks from a host callback once the device has
+* produced it. Nothing on the compute stream waits, so extracting a loss or
+* a gradient norm mid-step no longer costs a synchronization.
+*
+* observeMetricAsync() enqueues a device-to-host copy of a (small) tensor
+* on a side stream that waits on the current stream, then queues a host
+* callback behind the copy. When the callback fires, every registered sink
+* is invoked with the tag and a pinned CPU tensor holding the value. A CPU
+* input is delivered to the sinks inline, since reading it stalls nothing.
+*
+* Sinks run on a CUDA driver thread and therefore must not call into the
+* CUDA API (no device tensor ops, no .cuda(), no stream queries); keeping
+* the CPU tensor or copying numbers out of it is fine. Exceptions thrown
+* by sinks terminate the process, as there is no enqueuing frame to
+* propagate them to.
+*
+* The op is also registered as "cuda::observe_metric_async(Tensor self,
+* str tag) -> ()" so scripted models can emit metrics directly.
+*/
+
+using MetricSink =
+    std::function<void(const std::string& tag, const Tensor& value)>;
+
+// Registers a sink and returns a handle for unregisterMetricSink().
+TORCH_CUDA_API int64_t registerMetricSink(MetricSink sink);
+
+// Removes a previously registered sink. Callbacks already in flight may
+// still invoke it; unregistering does not wait for them.
+TORCH_CUDA_API void unregisterMetricSink(int64_t handle);
+
+// Enqueues asynchronous delivery of `metric` to the registered sinks.
+TORCH_CUDA_API void observeMetricAsync(const Tensor& metric, std::string tag);
+
+}} // namespace at::cuda
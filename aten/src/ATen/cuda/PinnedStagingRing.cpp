@@ -0,0 +1,165 @@
+#include <ATen/cuda/PinnedStagingRing.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Exceptions.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAStream.h>
+#include <c10/util/Exception.h>
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace at { namespace cuda {
+namespace {
+
+// See Note [Pinned staging ring] in PinnedStagingRing.h.
+
+// 64KB slots comfortably hold the scalar and parameter-delta transfers
+// this path is for; anything larger gets respectable bandwidth from the
+// ordinary copy path anyway.
+constexpr size_t kSlotBytes = 64 * 1024;
+constexpr size_t kNumSlots = 16;
+
+struct StagingRing {
+  char* arena = nullptr;
+  cudaEvent_t events[kNumSlots];
+  size_t next_slot = 0;
+  bool initialized = false;
+  bool broken = false;
+  std::mutex mutex;
+
+  // Never torn down: the ring must outlive every stream that may still
+  // drain a staged transfer, and the driver reclaims pinned memory and
+  // events at process exit regardless.
+  bool ensure_initialized() {
+    if (initialized) {
+      return true;
+    }
+    if (broken) {
+      return false;
+    }
+    if (cudaHostAlloc(
+            reinterpret_cast<void**>(&arena),
+            kSlotBytes * kNumSlots,
+            cudaHostAllocDefault) != cudaSuccess) {
+      // Pinned memory can legitimately be exhausted; remember the failure
+      // so every later call falls back without retrying the allocation.
+      cudaGetLastError();
+      broken = true;
+      return false;
+    }
+    for (size_t i = 0; i < kNumSlots; ++i) {
+      AT_CUDA_CHECK(cudaEventCreateWithFlags(&events[i], cudaEventDisableTiming));
+    }
+    initialized = true;
+    return true;
+  }
+};
+
+StagingRing& stagingRing() {
+  static StagingRing ring;
+  return ring;
+}
+
+struct StagingRegion {
+  void* host;
+  void* device;
+  size_t nbytes;
+  int device_index;
+  cudaEvent_t event;
+};
+
+struct StagingRegionRegistry {
+  std::mutex mutex;
+  std::unordered_map<int64_t, StagingRegion> regions;
+  int64_t next_handle = 1;
+};
+
+StagingRegionRegistry& stagingRegions() {
+  static StagingRegionRegistry registry;
+  return registry;
+}
+
+} // namespace
+
+bool stagedCopyH2D(
+    void* dst,
+    const void* src,
+    size_t nbytes,
+    cudaStream_t stream) {
+  if (nbytes == 0 || nbytes > kSlotBytes) {
+    return false;
+  }
+  StagingRing& ring = stagingRing();
+  std::lock_guard<std::mutex> lock(ring.mutex);
+  if (!ring.ensure_initialized()) {
+    return false;
+  }
+  size_t slot = ring.next_slot;
+  ring.next_slot = (ring.next_slot + 1) % kNumSlots;
+  // With kNumSlots transfers in flight ahead of us the oldest has almost
+  // always drained; this degenerates to a queue-depth limiter otherwise.
+  AT_CUDA_CHECK(cudaEventSynchronize(ring.events[slot]));
+  char* staged = ring.arena + slot * kSlotBytes;
+  std::memcpy(staged, src, nbytes);
+  AT_CUDA_CHECK(
+      cudaMemcpyAsync(dst, staged, nbytes, cudaMemcpyHostToDevice, stream));
+  AT_CUDA_CHECK(cudaEventRecord(ring.events[slot], stream));
+  return true;
+}
+
+int64_t registerStagingRegion(void* host, size_t nbytes) {
+  TORCH_CHECK(host != nullptr, "registerStagingRegion: host pointer is null");
+  TORCH_CHECK(nbytes > 0, "registerStagingRegion: region is empty");
+  StagingRegion region;
+  region.host = host;
+  region.nbytes = nbytes;
+  AT_CUDA_CHECK(cudaGetDevice(&region.device_index));
+  AT_CUDA_CHECK(cudaHostRegister(host, nbytes, cudaHostRegisterDefault));
+  region.device = c10::cuda::CUDACachingAllocator::raw_alloc(nbytes);
+  AT_CUDA_CHECK(cudaEventCreateWithFlags(&region.event, cudaEventDisableTiming));
+
+  StagingRegionRegistry& registry = stagingRegions();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  int64_t handle = registry.next_handle++;
+  registry.regions.emplace(handle, region);
+  return handle;
+}
+
+void* pushStagingRegion(int64_t handle) {
+  StagingRegionRegistry& registry = stagingRegions();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.regions.find(handle);
+  TORCH_CHECK(
+      it != registry.regions.end(),
+      "pushStagingRegion: unknown staging region handle ", handle);
+  StagingRegion& region = it->second;
+  cudaStream_t stream =
+      c10::cuda::getCurrentCUDAStream(region.device_index).stream();
+  AT_CUDA_CHECK(cudaMemcpyAsync(
+      region.device,
+      region.host,
+      region.nbytes,
+      cudaMemcpyHostToDevice,
+      stream));
+  AT_CUDA_CHECK(cudaEventRecord(region.event, stream));
+  return region.device;
+}
+
+void unregisterStagingRegion(int64_t handle) {
+  StagingRegionRegistry& registry = stagingRegions();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.regions.find(handle);
+  TORCH_CHECK(
+      it != registry.regions.end(),
+      "unregisterStagingRegion: unknown staging region handle ", handle);
+  StagingRegion region = it->second;
+  registry.regions.erase(it);
+  AT_CUDA_CHECK(cudaEventSynchronize(region.event));
+  AT_CUDA_CHECK(cudaEventDestroy(region.event));
+  AT_CUDA_CHECK(cudaHostUnregister(region.host));
+  c10::cuda::CUDACachingAllocator::raw_delete(region.device);
+}
+
+}} // namespace at::cuda
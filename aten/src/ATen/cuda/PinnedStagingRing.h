@@ -0,0 +1,60 @@
+#pragma once
+
+#include <ATen/cuda/ATenCUDAGeneral.h>
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace at { namespace cuda {
+
+// Note [Pinned staging ring]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Small, frequent host-to-device copies (parameter deltas, scalars) pay a
+// fixed overhead per transfer: for pageable sources the driver bounces the
+// bytes through its own staging area and synchronizes the host, and a
+// blocking copy_() additionally pays a full stream synchronize just so the
+// caller may reuse the source buffer.
+//
+// stagedCopyH2D amortizes all of that with a persistent ring of pinned
+// slots. The source bytes are memcpy'd into the next free slot, a single
+// cudaMemcpyAsync is issued from the slot, and an event is recorded so the
+// slot is not reused before the transfer drains. Because the bytes are
+// captured before returning, the caller may overwrite the source
+// immediately -- no host synchronization is needed for either blocking or
+// non-blocking copy semantics. Device-side ordering is unchanged: the
+// transfer is enqueued on the given stream like any other copy.
+//
+// Returns false (and performs no copy) when the transfer is too large for
+// a slot, when nbytes is zero, or when pinned memory could not be
+// allocated; the caller falls back to the ordinary copy path.
+TORCH_CUDA_API bool stagedCopyH2D(
+    void* dst,
+    const void* src,
+    size_t nbytes,
+    cudaStream_t stream);
+
+// Callers that push the same host buffer repeatedly (e.g. a parameter
+// delta refreshed every few milliseconds) can instead register the region
+// once. Registration pins the host memory in place and preallocates a
+// device counterpart on the current device, so each subsequent push is a
+// single doorbell: one async copy on the current stream with no
+// allocation, pinning, or host synchronization on the hot path.
+//
+// Returns an opaque handle. Throws if the region cannot be pinned or the
+// device counterpart cannot be allocated.
+TORCH_CUDA_API int64_t registerStagingRegion(void* host, size_t nbytes);
+
+// Asynchronously copies the registered host region to its device
+// counterpart on the current stream and returns the device pointer. The
+// pointer is stable across pushes; device-side consumers on the same
+// stream observe the new bytes in stream order. The host region must not
+// be modified until the next push (the copy reads it in place).
+TORCH_CUDA_API void* pushStagingRegion(int64_t handle);
+
+// Waits for the region's last push to drain, unpins the host memory, and
+// frees the device counterpart.
+TORCH_CUDA_API void unregisterStagingRegion(int64_t handle);
+
+}} // namespace at::cuda
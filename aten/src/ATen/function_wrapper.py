@@ -148,8 +148,9 @@ inline ${return_type} Tensor::${api_name}(${method_formals}) const {
     ${static_dispatch_method_body}
 #else
     static c10::OperatorHandle op = c10::Dispatcher::singleton().findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return c10::Dispatcher::singleton().callUnboxedOnly<${formals_types_with_return}>(
-        op${method_actuals_with_comma_prefix});
+    static thread_local c10::impl::UnboxedDispatchCache dispatch_cache;
+    return c10::Dispatcher::singleton().callUnboxedOnlyCached<${formals_types_with_return}>(
+        op, dispatch_cache${method_actuals_with_comma_prefix});
 #endif
 }
 """)
@@ -159,8 +160,9 @@ inline ${return_type} Tensor::${api_name}(${method_formals}) const {
     ${static_dispatch_method_body}
 #else
     static c10::OperatorHandle op = c10::Dispatcher::singleton().findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return c10::Dispatcher::singleton().callUnboxed<${formals_types_with_return}>(
-        op${method_actuals_with_comma_prefix});
+    static thread_local c10::impl::UnboxedDispatchCache dispatch_cache;
+    return c10::Dispatcher::singleton().callUnboxedCached<${formals_types_with_return}>(
+        op, dispatch_cache${method_actuals_with_comma_prefix});
 #endif
 }
 """)
@@ -180,8 +182,9 @@ static inline ${return_type} ${api_name}(${formals}) {
 #else
     static c10::OperatorHandle op = c10::Dispatcher::singleton()
         .findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return c10::Dispatcher::singleton().callUnboxedOnly<${formals_types_with_return}>(
-        op${native_actuals_with_comma_prefix});
+    static thread_local c10::impl::UnboxedDispatchCache dispatch_cache;
+    return c10::Dispatcher::singleton().callUnboxedOnlyCached<${formals_types_with_return}>(
+        op, dispatch_cache${native_actuals_with_comma_prefix});
 #endif
 }
 """)
@@ -192,8 +195,9 @@ static inline ${return_type} ${api_name}(${formals}) {
 #else
     static c10::OperatorHandle op = c10::Dispatcher::singleton()
         .findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return c10::Dispatcher::singleton().callUnboxed<${formals_types_with_return}>(
-        op${native_actuals_with_comma_prefix});
+    static thread_local c10::impl::UnboxedDispatchCache dispatch_cache;
+    return c10::Dispatcher::singleton().callUnboxedCached<${formals_types_with_return}>(
+        op, dispatch_cache${native_actuals_with_comma_prefix});
 #endif
 }
 """)
@@ -237,8 +241,9 @@ static inline ${return_type} ${api_name}(${formals}) {
     globalLegacyTypeDispatch().initForTensorTypeSet(${inferred_type_set});
     static c10::OperatorHandle op = c10::Dispatcher::singleton()
         .findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return c10::Dispatcher::singleton().callUnboxedOnly<${formals_types_with_return}>(
-        op${native_actuals_with_comma_prefix});
+    static thread_local c10::impl::UnboxedDispatchCache dispatch_cache;
+    return c10::Dispatcher::singleton().callUnboxedOnlyCached<${formals_types_with_return}>(
+        op, dispatch_cache${native_actuals_with_comma_prefix});
 #endif
 }
 """)
@@ -250,8 +255,9 @@ static inline ${return_type} ${api_name}(${formals}) {
     globalLegacyTypeDispatch().initForTensorTypeSet(${inferred_type_set});
     static c10::OperatorHandle op = c10::Dispatcher::singleton()
         .findSchema({"aten::${operator_name}", "${overload_name}"}).value();
-    return c10::Dispatcher::singleton().callUnboxed<${formals_types_with_return}>(
-        op${native_actuals_with_comma_prefix});
+    static thread_local c10::impl::UnboxedDispatchCache dispatch_cache;
+    return c10::Dispatcher::singleton().callUnboxedCached<${formals_types_with_return}>(
+        op, dispatch_cache${native_actuals_with_comma_prefix});
 #endif
 }
 """)
@@ -366,7 +366,23 @@ Tensor gelu_backward_cpu(const Tensor& grad, const Tensor& self) {
   return dX;
 }
 
+Tensor fast_gelu_cpu(const Tensor& self) {
+  Tensor Y = at::native::empty_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto it = TensorIterator::unary_op(Y, self);
+  FastGeluKernel(kCPU, it);
+  return Y;
+}
+
+Tensor fast_gelu_backward_cpu(const Tensor& grad, const Tensor& self) {
+  Tensor dX = at::native::empty_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto it = TensorIterator::binary_op(dX, grad, self);
+  FastGeluBackwardKernel(kCPU, it);
+  return dX;
+}
+
 DEFINE_DISPATCH(GeluKernel);
 DEFINE_DISPATCH(GeluBackwardKernel);
+DEFINE_DISPATCH(FastGeluKernel);
+DEFINE_DISPATCH(FastGeluBackwardKernel);
 
 }}  // namespace at::native
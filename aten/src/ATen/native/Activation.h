@@ -19,6 +19,8 @@ using hardshrink_backward_cpu_fn = void (*)(TensorIterator&, Scalar);
 DECLARE_DISPATCH(threshold_fn, threshold_stub);
 DECLARE_DISPATCH(activation_fn, GeluKernel);
 DECLARE_DISPATCH(activation_backward_fn, GeluBackwardKernel);
+DECLARE_DISPATCH(activation_fn, FastGeluKernel);
+DECLARE_DISPATCH(activation_backward_fn, FastGeluBackwardKernel);
 DECLARE_DISPATCH(hardshrink_cpu_fn, hardshrink_cpu_stub);
 DECLARE_DISPATCH(hardshrink_backward_cpu_fn, hardshrink_backward_cpu_stub);
 
@@ -0,0 +1,94 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace at {
+namespace native {
+
+// Scaled dot-product attention (softmax(Q K^T * scale) V) computed without
+// ever materializing the full (num_queries, num_keys) score matrix. Keys and
+// values are consumed in blocks of `key_block_size`, and the softmax is
+// streamed: per-row running max, normalizer and an unnormalized output
+// accumulator are carried across blocks, with already-accumulated terms
+// rescaled whenever a block raises the row max. This is algebraically the
+// same softmax computed by native/SoftMax.cpp, just evaluated a block of
+// columns at a time, so peak memory for the scores drops from
+// O(num_queries * num_keys) to O(num_queries * key_block_size) per batch.
+// Built from bmm/max/exp, so it runs on every backend and is differentiable
+// through the ops it is composed of.
+Tensor fused_attention(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    double scale,
+    int64_t key_block_size) {
+  TORCH_CHECK(
+      query.dim() == 3 && key.dim() == 3 && value.dim() == 3,
+      "fused_attention: expected 3-D (batch, seq, feature) tensors, but got ",
+      query.dim(), "-D query, ", key.dim(), "-D key and ", value.dim(),
+      "-D value");
+  TORCH_CHECK(
+      query.size(0) == key.size(0) && query.size(0) == value.size(0),
+      "fused_attention: query, key and value must have the same batch size, "
+      "but got ", query.size(0), ", ", key.size(0), " and ", value.size(0));
+  TORCH_CHECK(
+      query.size(2) == key.size(2),
+      "fused_attention: query feature size ", query.size(2),
+      " does not match key feature size ", key.size(2));
+  TORCH_CHECK(
+      key.size(1) == value.size(1),
+      "fused_attention: key length ", key.size(1),
+      " does not match value length ", value.size(1));
+  TORCH_CHECK(
+      key_block_size > 0,
+      "fused_attention: key_block_size must be positive, but got ",
+      key_block_size);
+
+  const int64_t batch = query.size(0);
+  const int64_t num_queries = query.size(1);
+  const int64_t num_keys = key.size(1);
+
+  // Half inputs accumulate in float: the streamed rescaling compounds
+  // rounding error across blocks otherwise.
+  const auto work_type =
+      query.scalar_type() == kHalf ? kFloat : query.scalar_type();
+  const Tensor q = query.to(work_type);
+  const Tensor k = key.to(work_type);
+  const Tensor v = value.to(work_type);
+
+  const auto options = q.options();
+  Tensor row_max = at::full(
+      {batch, num_queries, 1},
+      -std::numeric_limits<double>::infinity(),
+      options);
+  Tensor row_sum = at::zeros({batch, num_queries, 1}, options);
+  Tensor output = at::zeros({batch, num_queries, value.size(2)}, options);
+
+  for (int64_t start = 0; start < num_keys; start += key_block_size) {
+    const int64_t length = std::min(key_block_size, num_keys - start);
+    const Tensor key_block = k.narrow(1, start, length);
+    const Tensor value_block = v.narrow(1, start, length);
+
+    // (batch, num_queries, length) - the only score tile ever materialized.
+    Tensor scores = at::bmm(q, key_block.transpose(1, 2)).mul_(scale);
+    const Tensor new_max = at::max(
+        row_max, std::get<0>(scores.max(/*dim=*/2, /*keepdim=*/true)));
+    const Tensor probs = scores.sub_(new_max).exp_();
+    // Terms accumulated under the old max shrink by exp(old - new).
+    // The accumulator updates stay out-of-place: `correction` requires
+    // grad whenever the inputs do, and mul_'s backward saves its
+    // pre-mutation self, which the next in-place update of the
+    // accumulator would invalidate.
+    const Tensor correction = (row_max - new_max).exp_();
+    output = output * correction + at::bmm(probs, value_block);
+    row_sum = row_sum * correction + probs.sum(/*dim=*/2, /*keepdim=*/true);
+    row_max = new_max;
+  }
+
+  return (output / row_sum).to(query.scalar_type());
+}
+
+} // namespace native
+} // namespace at
@@ -47,6 +47,12 @@ extern "C" void cpotrf_(char *uplo, int *n, std::complex<float> *a, int *lda, in
 extern "C" void dpotrf_(char *uplo, int *n, double *a, int *lda, int *info);
 extern "C" void spotrf_(char *uplo, int *n, float *a, int *lda, int *info);
 
+// posv
+extern "C" void zposv_(char *uplo, int *n, int *nrhs, std::complex<double> *a, int *lda, std::complex<double> *b, int *ldb, int *info);
+extern "C" void cposv_(char *uplo, int *n, int *nrhs, std::complex<float> *a, int *lda, std::complex<float> *b, int *ldb, int *info);
+extern "C" void dposv_(char *uplo, int *n, int *nrhs, double *a, int *lda, double *b, int *ldb, int *info);
+extern "C" void sposv_(char *uplo, int *n, int *nrhs, float *a, int *lda, float *b, int *ldb, int *info);
+
 // trtrs
 extern "C" void ztrtrs_(char *uplo, char *trans, char *diag, int *n, int *nrhs, std::complex<double> *a, int *lda, std::complex<double> *b, int *ldb, int *info);
 extern "C" void ctrtrs_(char *uplo, char *trans, char *diag, int *n, int *nrhs, std::complex<float> *a, int *lda, std::complex<float> *b, int *ldb, int *info);
@@ -107,6 +113,9 @@ void lapackCholeskySolve(char uplo, int n, int nrhs, scalar_t *a, int lda, scala
 template<class scalar_t>
 void lapackCholesky(char uplo, int n, scalar_t *a, int lda, int *info);
 
+template<class scalar_t>
+void lapackSpdSolve(char uplo, int n, int nrhs, scalar_t *a, int lda, scalar_t *b, int ldb, int *info);
+
 template<class scalar_t>
 void lapackTriangularSolve(char uplo, char trans, char diag, int n, int nrhs, scalar_t *a, int lda, scalar_t *b, int ldb, int *info);
 
@@ -207,6 +216,22 @@ template<> void lapackCholesky<float>(char uplo, int n, float *a, int lda, int *
   spotrf_(&uplo, &n, a, &lda, info);
 }
 
+template<> void lapackSpdSolve<std::complex<double>>(char uplo, int n, int nrhs, std::complex<double> *a, int lda, std::complex<double> *b, int ldb, int *info) {
+  zposv_(&uplo, &n, &nrhs, a, &lda, b, &ldb, info);
+}
+
+template<> void lapackSpdSolve<std::complex<float>>(char uplo, int n, int nrhs, std::complex<float> *a, int lda, std::complex<float> *b, int ldb, int *info) {
+  cposv_(&uplo, &n, &nrhs, a, &lda, b, &ldb, info);
+}
+
+template<> void lapackSpdSolve<double>(char uplo, int n, int nrhs, double *a, int lda, double *b, int ldb, int *info) {
+  dposv_(&uplo, &n, &nrhs, a, &lda, b, &ldb, info);
+}
+
+template<> void lapackSpdSolve<float>(char uplo, int n, int nrhs, float *a, int lda, float *b, int ldb, int *info) {
+  sposv_(&uplo, &n, &nrhs, a, &lda, b, &ldb, info);
+}
+
 template<> void lapackTriangularSolve<std::complex<double>>(char uplo, char trans, char diag, int n, int nrhs, std::complex<double> *a, int lda, std::complex<double> *b, int ldb, int *info) {
   ztrtrs_(&uplo, &trans, &diag, &n, &nrhs, a, &lda, b, &ldb, info);
 }
@@ -461,16 +486,19 @@ static void apply_cholesky_solve(Tensor& b, Tensor& A, bool upper, std::vector<i
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackCholeskySolve<scalar_t>(uplo, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  // Each batch entry is an independent LAPACK call; parallelize over the
+  // batch so multi-system workloads use all cores. Entries write disjoint
+  // matrices and info slots, and LAPACK runs single-threaded inside the
+  // parallel region.
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      int info;
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      lapackCholeskySolve<scalar_t>(uplo, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -507,6 +535,64 @@ Tensor& cholesky_solve_out(Tensor& result, const Tensor& self, const Tensor& A,
   return result;
 }
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ spd_solve ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+template<typename scalar_t>
+static void apply_spd_solve(Tensor& b, Tensor& A, bool upper, std::vector<int64_t>& infos) {
+#ifndef USE_LAPACK
+  AT_ERROR("spd_solve: LAPACK library not found in compilation");
+#else
+  char uplo = upper ? 'U' : 'L';
+
+  auto A_data = A.data_ptr<scalar_t>();
+  auto b_data = b.data_ptr<scalar_t>();
+  auto A_mat_stride = matrixStride(A);
+  auto b_mat_stride = matrixStride(b);
+  auto batch_size = batchCount(A);
+  auto n = A.size(-2);
+  auto nrhs = b.size(-1);
+
+  // See the note on batch parallelism in apply_cholesky_solve.
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      int info;
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      lapackSpdSolve<scalar_t>(uplo, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
+      infos[i] = info;
+    }
+  });
+#endif
+}
+
+// Solves A x = b for symmetric positive-definite A in a single LAPACK call
+// (?posv) per batch entry. The Cholesky factorization and the triangular
+// solves run back to back on the same thread, so the factor is still in
+// cache when the solve consumes it. Numerically equivalent to
+// b.cholesky_solve(A.cholesky(upper), upper), without materializing the
+// factor as a separate tensor or making a second pass over it.
+Tensor spd_solve_cpu(const Tensor& self, const Tensor& input2, bool upper) {
+  TORCH_CHECK(self.dim() >= 2,
+           "b should have at least 2 dimensions, but has ", self.dim(), " dimensions instead");
+  TORCH_CHECK(input2.dim() >= 2,
+           "A should have at least 2 dimensions, but has ", input2.dim(), " dimensions instead");
+  squareCheckInputs(input2);
+  Tensor self_broadcasted, A_broadcasted;
+  std::tie(self_broadcasted, A_broadcasted) = _linalg_broadcast_batch_dims(self, input2, "spd_solve");
+  auto self_working_copy = cloneBatchedColumnMajor(self_broadcasted);
+  auto A_working_copy = cloneBatchedColumnMajor(A_broadcasted);
+  std::vector<int64_t> infos(batchCount(self_working_copy), 0);
+  AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(self.scalar_type(), "spd_solve_cpu", [&]{
+    apply_spd_solve<scalar_t>(self_working_copy, A_working_copy, upper, infos);
+  });
+  if (self_broadcasted.dim() > 2) {
+    batchCheckErrors(infos, "spd_solve_cpu");
+  } else {
+    singleCheckErrors(infos[0], "spd_solve_cpu");
+  }
+  return self_working_copy;
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ cholesky ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 template<typename scalar_t>
@@ -521,15 +607,15 @@ static void apply_cholesky(Tensor& self, bool upper, std::vector<int64_t>& infos
   auto batch_size = batchCount(self);
   auto n = self.size(-2);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    lapackCholesky<scalar_t>(uplo, n, self_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  // See the note on batch parallelism in apply_cholesky_solve.
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      int info;
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      lapackCholesky<scalar_t>(uplo, n, self_working_ptr, n, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -646,12 +732,15 @@ static void apply_triangular_solve(Tensor& b, Tensor& A, bool upper, bool transp
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackTriangularSolve<scalar_t>(uplo, trans, diag, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
-  }
+  // See the note on batch parallelism in apply_cholesky_solve.
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      int info;
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      lapackTriangularSolve<scalar_t>(uplo, trans, diag, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
+    }
+  });
 #endif
 }
 
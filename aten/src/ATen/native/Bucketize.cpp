@@ -0,0 +1,199 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace at { namespace native {
+
+namespace {
+
+// Note [Branch-free sorted search]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// searchsorted/bucketize run one binary search per input element, so the
+// search loop dominates. A conventional binary search branches on the
+// comparison result, and for random inputs that branch is unpredictable:
+// the pipeline flushes on roughly half the iterations. The loop below
+// instead updates (lo, count) with ternaries, which compile to conditional
+// moves, so the only branch left is the well-predicted loop exit. The outer
+// loop over input elements is data-parallel and is split with parallel_for.
+//
+// With right == false this is std::lower_bound (first index whose boundary
+// is >= value); with right == true it is std::upper_bound (first index
+// whose boundary is > value). Only operator< is used, so NaN values sort
+// to the end for floating point types, matching std:: behavior.
+template <typename scalar_t, bool right>
+inline int64_t sorted_search(
+    const scalar_t* data,
+    int64_t size,
+    scalar_t value) {
+  int64_t lo = 0;
+  int64_t count = size;
+  while (count > 0) {
+    int64_t half = count >> 1;
+    int64_t mid = lo + half;
+    bool pred = right ? !(value < data[mid]) : (data[mid] < value);
+    lo = pred ? mid + 1 : lo;
+    count = pred ? count - half - 1 : half;
+  }
+  return lo;
+}
+
+// Both tensors have been made contiguous by the caller. The boundary
+// tensor is either 1-D (one row shared by every input element) or has the
+// same leading dimensions as the input (one row per innermost slice).
+template <typename scalar_t, typename output_t>
+void searchsorted_cpu_contiguous(
+    Tensor& result,
+    const Tensor& input,
+    const Tensor& sequence,
+    bool right) {
+  int64_t numel_in = input.numel();
+  int64_t seq_size = sequence.size(-1);
+  int64_t num_rows = sequence.numel() / seq_size;
+  int64_t row_stride = numel_in / num_rows;
+  const scalar_t* in_data = input.data_ptr<scalar_t>();
+  const scalar_t* seq_data = sequence.data_ptr<scalar_t>();
+  output_t* out_data = result.data_ptr<output_t>();
+  // Each search costs O(log seq_size), so shrink the grain accordingly.
+  int64_t grain = std::max(at::internal::GRAIN_SIZE / 64, (int64_t)1);
+  at::parallel_for(0, numel_in, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const scalar_t* row = seq_data + (i / row_stride) * seq_size;
+      int64_t pos = right
+          ? sorted_search<scalar_t, true>(row, seq_size, in_data[i])
+          : sorted_search<scalar_t, false>(row, seq_size, in_data[i]);
+      out_data[i] = static_cast<output_t>(pos);
+    }
+  });
+}
+
+void searchsorted_pre_check(
+    const Tensor& boundaries,
+    const Tensor& input,
+    bool out_int32) {
+  TORCH_CHECK(
+      boundaries.device() == input.device(),
+      "searchsorted(): boundaries and input value tensors should have same device type, but we got ",
+      "boundaries tensor device type ", boundaries.device(),
+      " and input value tensor device type ", input.device());
+  TORCH_CHECK(
+      boundaries.dim() != 0,
+      "searchsorted(): boundaries tensor should have positive dimension");
+  TORCH_CHECK(
+      boundaries.dim() == 1 ||
+          (input.dim() == boundaries.dim() &&
+           input.sizes().slice(0, input.dim() - 1) ==
+               boundaries.sizes().slice(0, boundaries.dim() - 1)),
+      "searchsorted(): boundaries tensor should be 1 dimension or have the same leading dimensions as the input ",
+      "value tensor, but we got boundaries tensor with shape ", boundaries.sizes(),
+      " and input value tensor with shape ", input.sizes());
+  TORCH_CHECK(
+      boundaries.scalar_type() == input.scalar_type(),
+      "searchsorted(): boundaries and input value tensors should have the same dtype, but we got ",
+      "boundaries tensor dtype ", boundaries.scalar_type(),
+      " and input value tensor dtype ", input.scalar_type());
+  TORCH_CHECK(
+      !out_int32 ||
+          boundaries.size(-1) < std::numeric_limits<int>::max(),
+      "searchsorted(): the size of the innermost boundaries dimension should be less than ",
+      std::numeric_limits<int>::max(), " with out_int32=True, but we got ",
+      boundaries.size(-1));
+}
+
+} // namespace
+
+Tensor& searchsorted_out_cpu(
+    Tensor& result,
+    const Tensor& sorted_sequence,
+    const Tensor& self,
+    bool out_int32,
+    bool right) {
+  searchsorted_pre_check(sorted_sequence, self, out_int32);
+  ScalarType out_type = out_int32 ? ScalarType::Int : ScalarType::Long;
+  TORCH_CHECK(
+      result.scalar_type() == out_type,
+      "searchsorted(): output tensor should have dtype ", out_type,
+      " with out_int32=", out_int32 ? "True" : "False",
+      ", but we got output tensor dtype ", result.scalar_type());
+  result.resize_(self.sizes());
+  if (self.numel() == 0) {
+    return result;
+  }
+  if (sorted_sequence.numel() == 0) {
+    // No boundaries: every insertion position is 0. This also keeps the
+    // row arithmetic below away from an empty innermost dimension.
+    result.zero_();
+    return result;
+  }
+  auto input = self.contiguous();
+  auto sequence = sorted_sequence.contiguous();
+  AT_DISPATCH_ALL_TYPES(input.scalar_type(), "searchsorted_out_cpu", [&] {
+    if (out_int32) {
+      searchsorted_cpu_contiguous<scalar_t, int>(result, input, sequence, right);
+    } else {
+      searchsorted_cpu_contiguous<scalar_t, int64_t>(result, input, sequence, right);
+    }
+  });
+  return result;
+}
+
+Tensor searchsorted_cpu(
+    const Tensor& sorted_sequence,
+    const Tensor& self,
+    bool out_int32,
+    bool right) {
+  auto options = self.options().dtype(out_int32 ? kInt : kLong);
+  Tensor result = at::empty({0}, options, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  searchsorted_out_cpu(result, sorted_sequence, self, out_int32, right);
+  return result;
+}
+
+Tensor searchsorted_cpu(
+    const Tensor& sorted_sequence,
+    Scalar self,
+    bool out_int32,
+    bool right) {
+  // Converting through the sequence's options keeps the dtype check happy
+  // for e.g. a python int searched in a float boundary tensor.
+  Tensor value = at::scalar_tensor(self, sorted_sequence.options());
+  return searchsorted_cpu(sorted_sequence, value, out_int32, right);
+}
+
+Tensor& bucketize_out_cpu(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& boundaries,
+    bool out_int32,
+    bool right) {
+  TORCH_CHECK(
+      boundaries.dim() == 1,
+      "bucketize(): boundaries tensor must be 1 dimension, but got dim(",
+      boundaries.dim(), ")");
+  searchsorted_out_cpu(result, boundaries, self, out_int32, right);
+  return result;
+}
+
+Tensor bucketize_cpu(
+    const Tensor& self,
+    const Tensor& boundaries,
+    bool out_int32,
+    bool right) {
+  auto options = self.options().dtype(out_int32 ? kInt : kLong);
+  Tensor result = at::empty({0}, options, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  bucketize_out_cpu(result, self, boundaries, out_int32, right);
+  return result;
+}
+
+Tensor bucketize_cpu(
+    Scalar self,
+    const Tensor& boundaries,
+    bool out_int32,
+    bool right) {
+  return bucketize_cpu(
+      at::scalar_tensor(self, boundaries.options()), boundaries, out_int32, right);
+}
+
+}} // namespace at::native
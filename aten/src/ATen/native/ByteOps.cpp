@@ -0,0 +1,40 @@
+// Byte-tensor utilities for tokenizer-adjacent preprocessing.
+//
+// byte_translate maps every element of a uint8 tensor through a 256-entry
+// lookup table, i.e. the tensor analogue of bytes.translate:
+// out[i] = table[self[i]]. Byte-to-id remapping with index_select needs an
+// int64 index copy of the input first; this reads the bytes directly, and
+// the CPU kernel performs the lookup with in-register shuffles where AVX2
+// is available (see cpu/ByteOpsKernel.cpp).
+
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/native/ByteOps.h>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(byte_translate_stub);
+
+Tensor byte_translate_cpu(const Tensor& self, const Tensor& table) {
+  TORCH_CHECK(
+      self.scalar_type() == kByte,
+      "byte_translate: expected a uint8 tensor, got ",
+      self.scalar_type());
+  TORCH_CHECK(
+      table.scalar_type() == kByte,
+      "byte_translate: expected a uint8 table, got ",
+      table.scalar_type());
+  TORCH_CHECK(
+      table.numel() == 256,
+      "byte_translate: table must have 256 entries, got ",
+      table.numel());
+  auto input = self.contiguous();
+  auto lut = table.contiguous();
+  auto result = at::empty_like(input);
+  byte_translate_stub(kCPU, result, input, lut);
+  return result;
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+using byte_translate_fn = void (*)(Tensor&, const Tensor&, const Tensor&);
+DECLARE_DISPATCH(byte_translate_fn, byte_translate_stub);
+
+} // namespace native
+} // namespace at
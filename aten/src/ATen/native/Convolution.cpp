@@ -1,6 +1,9 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/core/grad_mode.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
+#include <ATen/native/cpu/DepthwiseSeparableConvKernel.h>
+#include <ATen/native/cpu/DirectConv2dKernel.h>
 #include <ATen/native/utils/ParamUtils.h>
 
 #include <ATen/Config.h>
@@ -13,6 +16,8 @@ static const int MIOPEN_DIM_MAX = 4;
 namespace at { namespace native {
 
 DEFINE_DISPATCH(convolution_depthwise3x3_winograd_stub);
+DEFINE_DISPATCH(conv_depthwise_separable3x3_stub);
+DEFINE_DISPATCH(direct_conv2d_stub);
 
 struct ConvParams {
   std::vector<int64_t> stride;
@@ -34,6 +39,7 @@ struct ConvParams {
   bool is_stride_nonpos() const;
   void view1d_as_2d();
   bool use_cpu_depthwise3x3_winograd(const at::Tensor& input, const at::Tensor& weight) const;
+  bool use_cpu_direct_conv2d(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn(const at::Tensor& input) const;
   bool use_cudnn_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_miopen(const at::Tensor& input) const;
@@ -146,6 +152,30 @@ auto ConvParams::use_cpu_depthwise3x3_winograd(
 #endif
 }
 
+// Small feature maps with many channels (late CNN stages): here im2col
+// materializes a patch matrix larger than the data itself, so the direct
+// register-tiled kernel wins. Inference only - the direct kernel has no
+// backward.
+auto ConvParams::use_cpu_direct_conv2d(
+    const at::Tensor& input, const at::Tensor& weight) const -> bool {
+  constexpr int64_t kMaxSpatialSize = 14;
+  constexpr int64_t kMinChannels = 32;
+  return (input.ndimension() == 4) &&
+         (weight.ndimension() == 4) &&
+         (input.device().type() == c10::DeviceType::CPU) &&
+         (input.scalar_type() == at::kFloat) &&
+         (weight.device().type() == c10::DeviceType::CPU) &&
+         (weight.scalar_type() == at::kFloat) &&
+         !transposed &&
+         !is_dilated() &&
+         (groups == 1) &&
+         (input.size(2) <= kMaxSpatialSize) &&
+         (input.size(3) <= kMaxSpatialSize) &&
+         (input.size(1) >= kMinChannels) &&
+         (weight.size(0) >= kMinChannels) &&
+         !at::GradMode::is_enabled();
+}
+
 auto ConvParams::use_cudnn(const at::Tensor& input) const -> bool {
   if (!detail::getCUDAHooks().compiledWithCuDNN()) {
     return false;
@@ -492,6 +522,15 @@ at::Tensor conv3d(
                          false, {{0, 0, 0}}, groups);
 }
 
+at::Tensor _conv_depthwise_separable3x3(
+    const Tensor& input, const Tensor& depthwise_weight, const Tensor& depthwise_bias,
+    const Tensor& pointwise_weight, const Tensor& pointwise_bias,
+    IntArrayRef stride, IntArrayRef padding) {
+  return conv_depthwise_separable3x3_stub(
+      input.device().type(), input, depthwise_weight, depthwise_bias,
+      pointwise_weight, pointwise_bias, stride, padding);
+}
+
 at::Tensor conv_transpose1d(
     const Tensor& input, const Tensor& weight, const Tensor& bias,
     IntArrayRef stride, IntArrayRef padding, IntArrayRef output_padding, int64_t groups, IntArrayRef dilation) {
@@ -648,6 +687,9 @@ at::Tensor _convolution(
     if (params.use_cpu_depthwise3x3_winograd(input, weight)) {
       output = convolution_depthwise3x3_winograd_stub(
         input.device().type(), input, weight, bias, params.stride, params.padding, params.groups);
+    } else if (params.use_cpu_direct_conv2d(input, weight)) {
+      output = direct_conv2d_stub(
+        input.device().type(), input, weight, bias, params.stride, params.padding);
     } else if (params.groups == 1) {
       output = at::_convolution_nogroup(
           input.contiguous(), weight, bias, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
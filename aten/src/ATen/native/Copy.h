@@ -13,5 +13,11 @@ using copy_fn = void (*)(TensorIterator&, bool non_blocking);
 
 DECLARE_DISPATCH(copy_fn, copy_stub);
 
+// Out-of-place transpose: self is contiguous, src is a transposed matrix of
+// the same dtype (see copy_transpose_valid in Copy.cpp).
+using transpose_copy_fn = void (*)(Tensor& self, const Tensor& src);
+
+DECLARE_DISPATCH(transpose_copy_fn, transpose_copy_same_type_stub);
+
 } // namespace native
 } // namespace at
@@ -117,6 +117,85 @@ static void max_pool2d_with_indices_out_frame(
   });
 }
 
+// Channels-last variant: the channel dimension is innermost, so the max is
+// tracked for a contiguous run of nInputPlane values at once and the inner
+// loops vectorize over channels. Indices keep the same meaning as in the
+// contiguous kernel (offset into the h*w plane of the channel).
+template <typename scalar_t>
+static void max_pool2d_with_indices_out_frame_channels_last(
+          scalar_t *input_data,
+          scalar_t *output_data,
+          int64_t *indices_data,
+          int64_t nbatch,
+          int64_t nInputPlane,
+          int64_t inputWidth,
+          int64_t inputHeight,
+          int64_t outputWidth,
+          int64_t outputHeight,
+          int kW,
+          int kH,
+          int dW,
+          int dH,
+          int padW,
+          int padH,
+          int dilationW,
+          int dilationH)
+{
+  at::parallel_for(0, nbatch * outputHeight, 0, [&](int64_t start, int64_t end) {
+    for (auto it = start; it < end; it++)
+    {
+      int64_t p = it / outputHeight;
+      int64_t i = it % outputHeight;
+      const scalar_t *ip = input_data + p*inputHeight*inputWidth*nInputPlane;
+
+      int64_t j;
+      for(j = 0; j < outputWidth; j++)
+      {
+        int64_t hstart = i * dH - padH;
+        int64_t wstart = j * dW - padW;
+        int64_t hend = std::min(hstart + (kH - 1) * dilationH + 1, inputHeight);
+        int64_t wend = std::min(wstart + (kW - 1) * dilationW + 1, inputWidth);
+        while(hstart < 0)
+          hstart += dilationH;
+        while(wstart < 0)
+          wstart += dilationW;
+
+        /* local pointers */
+        scalar_t *op = output_data +
+            ((p*outputHeight + i)*outputWidth + j)*nInputPlane;
+        int64_t *indp = indices_data +
+            ((p*outputHeight + i)*outputWidth + j)*nInputPlane;
+
+        int64_t k;
+        for(k = 0; k < nInputPlane; k++)
+        {
+          op[k] = -std::numeric_limits<scalar_t>::infinity();
+          indp[k] = hstart*inputWidth + wstart;
+        }
+
+        /* compute local max per channel: */
+        for(int64_t y = hstart; y < hend; y += dilationH)
+        {
+          for(int64_t x = wstart; x < wend; x += dilationW)
+          {
+            int64_t tcntr = y*inputWidth + x;
+            const scalar_t *vp = ip + tcntr*nInputPlane;
+            for(k = 0; k < nInputPlane; k++)
+            {
+              scalar_t val = vp[k];
+              if ((val > op[k]) || std::isnan(val))
+              {
+                op[k] = val;
+                indp[k] = tcntr;
+              }
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
 void max_pool2d_with_indices_out_cpu_template(
           Tensor& output,
           Tensor& indices,
@@ -170,6 +249,40 @@ void max_pool2d_with_indices_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  // Fast path for channels last memory format: pool without reordering to
+  // contiguous and keep output and indices in channels last as well, so
+  // downstream ops see the same layout.
+  if (input_.ndimension() == 4 &&
+      input_.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+        at::MemoryFormat::ChannelsLast);
+    /* indices will contain the locations for each output point */
+    indices.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+        at::MemoryFormat::ChannelsLast);
+
+    AT_DISPATCH_FLOATING_TYPES(input_.scalar_type(),
+      "max_pool2d_with_indices_cpu",
+      [&] {
+        scalar_t *input_data = input_.data_ptr<scalar_t>();
+        scalar_t *output_data = output.data_ptr<scalar_t>();
+        int64_t *indices_data = indices.data_ptr<int64_t>();
+
+        max_pool2d_with_indices_out_frame_channels_last(
+          input_data,
+          output_data,
+          indices_data,
+          nbatch,
+          nInputPlane,
+          inputWidth, inputHeight,
+          outputWidth, outputHeight,
+          kW, kH, dW, dH,
+          padW, padH,
+          dilationW, dilationH);
+      }
+    );
+    return;
+  }
+
   /* get contiguous input */
   Tensor input = input_.contiguous();
 
@@ -298,7 +411,7 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
           Tensor& gradInput,
           const Tensor& gradOutput_,
           const Tensor& input,
-          const Tensor& indices,
+          const Tensor& indices_,
           IntArrayRef kernel_size,
           IntArrayRef stride,
           IntArrayRef padding,
@@ -332,8 +445,10 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
   TORCH_CHECK((input.ndimension() == 3 || input.ndimension() == 4),
     "non-empty 3D or 4D (batch mode) tensor expected for input");
 
-  /* get contiguous gradOutput */
+  /* get contiguous gradOutput and indices (the forward channels last path
+     produces channels last indices) */
   const Tensor gradOutput = gradOutput_.contiguous();
+  const Tensor indices = indices_.contiguous();
 
   /* resize */
   gradInput.resize_as_(input);
@@ -3,7 +3,9 @@
 #include <c10/core/Backend.h>
 #include <c10/core/ScalarType.h>
 #include <c10/util/Exception.h>
+#include <cstdint>
 #include <type_traits>
+#include <utility>
 
 // Implements instruction set specific function dispatch.
 //
@@ -35,7 +37,7 @@
 // TODO: CPU instruction set selection should be folded into whatever
 // the main dispatch mechanism is.
 
-// ignore warnings about DispatchStub::DEFAULT, AVX, AVX2 defined elsewhere
+// ignore warnings about DispatchStub::DEFAULT, AVX, AVX2, AVX512 defined elsewhere
 #if defined(__clang__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wundefined-var-template"
@@ -47,6 +49,7 @@ enum class CPUCapability {
   DEFAULT = 0,
   AVX = 1,
   AVX2 = 2,
+  AVX512 = 3,
   NUM_OPTIONS
 };
 
@@ -84,6 +87,12 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
   FnPtr choose_cpu_impl() {
     auto capability = static_cast<int>(get_cpu_capability());
     (void)capability;
+#ifdef HAVE_AVX512_CPU_DEFINITION
+    if (capability >= static_cast<int>(CPUCapability::AVX512)) {
+      AT_ASSERTM(AVX512, "DispatchStub: missing AVX512 kernel");
+      return AVX512;
+    }
+#endif
 #ifdef HAVE_AVX2_CPU_DEFINITION
     if (capability >= static_cast<int>(CPUCapability::AVX2)) {
       AT_ASSERTM(AVX2, "DispatchStub: missing AVX2 kernel");
@@ -118,6 +127,87 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
 #ifdef HAVE_AVX2_CPU_DEFINITION
   static FnPtr AVX2;
 #endif
+#ifdef HAVE_AVX512_CPU_DEFINITION
+  static FnPtr AVX512;
+#endif
+};
+
+// Note [Shape-class memo]
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// Capability selection above is cached after the first call, but within a
+// capability the kernels themselves still re-derive blocking and unrolling
+// decisions (loop bounds, tile counts, grain sizes) from shapes on every
+// call. In fixed-shape serving the same handful of shape classes recur
+// millions of times, so that setup is pure overhead.
+//
+// ShapeClassKey collects the fields a kernel's derived parameters depend on
+// (sizes, strides packed as needed, contiguity bits), and ShapeClassMemo
+// maps each key to a scratch slot holding the derived parameters. Keys are
+// compared exactly -- never by hash -- so a hit always returns parameters
+// derived from identical inputs. The memo is meant to be thread_local in
+// the kernel's translation unit: lookups take no lock, and the handful of
+// shape classes per serving thread fit in a few slots.
+//
+// Example (in native/cpu/MyKernel.cpp):
+//   struct MyKernelParams { int64_t grain; int64_t tiles; };
+//   static thread_local ShapeClassMemo<MyKernelParams> memo;
+//   ...
+//   ShapeClassKey key;
+//   key.add(n); key.add(c); key.add(self.is_contiguous());
+//   const MyKernelParams& p = memo.lookup(key, [&] { return derive(n, c); });
+
+struct ShapeClassKey {
+  static constexpr size_t kMaxFields = 8;
+
+  void add(uint64_t field) {
+    AT_ASSERTM(len < kMaxFields, "ShapeClassKey: too many fields; pack several small fields per add()");
+    fields[len++] = field;
+  }
+
+  bool operator==(const ShapeClassKey& other) const {
+    if (len != other.len) {
+      return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+      if (fields[i] != other.fields[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  uint64_t fields[kMaxFields] = {0};
+  size_t len = 0;
+};
+
+template <typename Params, size_t kSlots = 8>
+struct ShapeClassMemo {
+  // Returns the cached parameters for `key`, calling `factory` to derive
+  // them on the first encounter (and again if the key was evicted).
+  template <typename Factory>
+  const Params& lookup(const ShapeClassKey& key, Factory&& factory) {
+    for (size_t i = 0; i < used; i++) {
+      if (entries[i].key == key) {
+        return entries[i].params;
+      }
+    }
+    // Round-robin eviction once full; with more live shape classes than
+    // slots the memo degrades to recomputing, never to wrong parameters.
+    size_t slot = used < kSlots ? used++ : next_evict++ % kSlots;
+    entries[slot].key = key;
+    entries[slot].params = factory();
+    return entries[slot].params;
+  }
+
+ private:
+  struct Entry {
+    ShapeClassKey key;
+    Params params;
+  };
+  Entry entries[kSlots];
+  size_t used = 0;
+  size_t next_evict = 0;
 };
 
 namespace {
@@ -167,10 +257,17 @@ struct RegisterHIPDispatch {
 #define REGISTER_AVX2_DISPATCH(name, fn)
 #endif
 
+#ifdef HAVE_AVX512_CPU_DEFINITION
+#define REGISTER_AVX512_DISPATCH(name, fn) REGISTER_ARCH_DISPATCH(name, AVX512, fn)
+#else
+#define REGISTER_AVX512_DISPATCH(name, fn)
+#endif
+
 #define REGISTER_NO_CPU_DISPATCH(name, fn_type)                                \
   REGISTER_ARCH_DISPATCH(name, DEFAULT, static_cast<fn_type>(nullptr))         \
   REGISTER_AVX_DISPATCH(name, static_cast<fn_type>(nullptr))                   \
-  REGISTER_AVX2_DISPATCH(name, static_cast<fn_type>(nullptr))
+  REGISTER_AVX2_DISPATCH(name, static_cast<fn_type>(nullptr))                  \
+  REGISTER_AVX512_DISPATCH(name, static_cast<fn_type>(nullptr))
 
 #define REGISTER_CUDA_DISPATCH(name, fn) \
   static RegisterCUDADispatch<decltype(fn), struct name> name ## __register(name, fn);
@@ -3,14 +3,34 @@
 #include <ATen/TensorUtils.h>
 #include <ATen/NativeFunctions.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 
 namespace at { namespace native {
 
+namespace {
+
+// When set, embedding_sparse_backward sums duplicate-index rows at creation
+// time and emits an already-coalesced gradient. Power-law id traffic repeats
+// the same hot ids many times per batch, so deduplicating here shrinks the
+// gradient the optimizer (and any c10d exchange) sees by the average
+// repetition factor, at the cost of one hash pass over the indices.
+bool coalesced_embedding_grad_enabled() {
+  static bool enabled = []() {
+    const char* value = std::getenv("PYTORCH_COALESCED_EMBEDDING_GRAD");
+    return value && std::atoi(value) != 0;
+  }();
+  return enabled;
+}
+
+} // namespace
+
 Tensor embedding(const Tensor & weight, const Tensor & indices,
                  int64_t padding_idx, bool scale_grad_by_freq, bool sparse) {
   auto indices_arg = TensorArg(indices, "indices", 1);
@@ -72,6 +92,49 @@ Tensor embedding_sparse_backward(
                                          weight_size);
   }
 
+  // The accumulation pass below runs on the host, so the deduplicated mode
+  // only applies to CPU gradients; CUDA keeps the raw (indices, values) form.
+  if (coalesced_embedding_grad_enabled() && !grad.is_cuda() &&
+      !indices.is_cuda()) {
+    auto indices_contig = indices.reshape(-1).contiguous();
+    const int64_t* indices_data = indices_contig.data_ptr<int64_t>();
+    const int64_t numel = indices_contig.numel();
+
+    // Rank each id among the sorted unique ids so the emitted gradient is
+    // sorted and deduplicated, i.e. genuinely coalesced.
+    std::unordered_map<int64_t, int64_t> rank_of_id;
+    rank_of_id.reserve(numel);
+    std::vector<int64_t> unique_ids;
+    unique_ids.reserve(numel);
+    for (int64_t i = 0; i < numel; i++) {
+      if (rank_of_id.emplace(indices_data[i], 0).second) {
+        unique_ids.push_back(indices_data[i]);
+      }
+    }
+    std::sort(unique_ids.begin(), unique_ids.end());
+    const int64_t num_unique = static_cast<int64_t>(unique_ids.size());
+    for (int64_t rank = 0; rank < num_unique; rank++) {
+      rank_of_id[unique_ids[rank]] = rank;
+    }
+
+    auto out_indices = at::empty({1, num_unique}, indices_.options());
+    std::copy(
+        unique_ids.begin(), unique_ids.end(), out_indices.data_ptr<int64_t>());
+    auto rows = at::empty({numel}, indices_.options());
+    int64_t* rows_data = rows.data_ptr<int64_t>();
+    for (int64_t i = 0; i < numel; i++) {
+      rows_data[i] = rank_of_id[indices_data[i]];
+    }
+
+    auto out_values = at::zeros({num_unique, num_features}, dense_options);
+    out_values.index_add_(0, rows, grad.reshape({-1, num_features}));
+
+    auto result =
+        at::_sparse_coo_tensor_unsafe(out_indices, out_values, weight_size);
+    result._coalesced_(true);
+    return result;
+  }
+
   auto index = indices.reshape({1, -1});
   auto values = grad.reshape({-1, num_features});
   return at::_sparse_coo_tensor_unsafe(index, values, weight_size);
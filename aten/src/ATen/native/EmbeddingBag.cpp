@@ -5,6 +5,7 @@
 
 #include <TH/THBlasUtils.h>
 
+#include <ATen/cpu/vec256/vec256.h>
 #include <caffe2/perfkernels/embedding_lookup_idx.h>
 
 #include <cstring>
@@ -44,6 +45,25 @@ bool isFastPathIndexSelectScale(const Tensor& src, const Tensor& scale, Tensor&
 // This function combines index_select (using select_indices as the index) and
 // index_add (using add_indices as the index), without creating an intermediary
 // tensor to hold the selected embeddings
+// The row gathers below are random-access over tables far larger than
+// cache, so they are latency bound unless upcoming rows are prefetched
+// while the current one is accumulated.  Eight rows ahead is enough to
+// cover DRAM latency at typical embedding widths.
+constexpr int64_t kEmbeddingPrefetchDistance = 8;
+
+static inline void prefetch_embedding_row(const void* row, size_t row_bytes) {
+#if defined(__GNUC__) || defined(__clang__)
+  constexpr size_t kCacheLine = 64;
+  auto* base = static_cast<const char*>(row);
+  for (size_t off = 0; off < row_bytes; off += kCacheLine) {
+    __builtin_prefetch(base + off, /*rw=*/0, /*locality=*/1);
+  }
+#else
+  (void)row;
+  (void)row_bytes;
+#endif
+}
+
 template<typename T>
 void index_select_add(const Tensor &select_indices,
                              const Tensor &add_indices,
@@ -62,10 +82,27 @@ void index_select_add(const Tensor &select_indices,
   auto output_stride0 = output.stride(0);
   auto output_stride1 = output.stride(1);
 
+  using Vec = vec256::Vec256<T>;
   for (int64_t i = 0; i < numel; i++) {
-    THBlas_axpy<T>(ddim, 1,
-            src_data + src_stride0 * select_indices_data[i], src_stride1,
-            output_data + output_stride0 * add_indices_data[i], output_stride1);
+    if (i + kEmbeddingPrefetchDistance < numel) {
+      prefetch_embedding_row(
+          src_data + src_stride0 * select_indices_data[i + kEmbeddingPrefetchDistance],
+          ddim * src_stride1 * sizeof(T));
+    }
+    auto* src_base = src_data + src_stride0 * select_indices_data[i];
+    auto* output_base = output_data + output_stride0 * add_indices_data[i];
+    if (src_stride1 == 1 && output_stride1 == 1) {
+      int64_t j = 0;
+      for (; j + Vec::size() <= ddim; j += Vec::size()) {
+        auto sum = Vec::loadu(output_base + j) + Vec::loadu(src_base + j);
+        sum.store(output_base + j);
+      }
+      for (; j < ddim; j++) {
+        output_base[j] += src_base[j];
+      }
+    } else {
+      THBlas_axpy<T>(ddim, 1, src_base, src_stride1, output_base, output_stride1);
+    }
   }
 }
 
@@ -103,6 +140,11 @@ void index_select_add<float>(const Tensor &select_indices,
     auto output_stride1 = output.stride(1);
     auto numel = add_indices.numel();
     for (int64_t i = 0; i < numel; i++) {
+      if (i + kEmbeddingPrefetchDistance < numel) {
+        prefetch_embedding_row(
+            src_data + src_stride0 * select_indices_data[i + kEmbeddingPrefetchDistance],
+            ddim * src_stride1 * sizeof(float));
+      }
       THBlas_axpy<float>(ddim, 1,
               src_data + src_stride0 * select_indices_data[i], src_stride1,
               output_data + output_stride0 * add_indices_data[i], output_stride1);
@@ -136,12 +178,32 @@ static void index_select_scale_add(const Tensor &select_indices,
   auto* scale_data = scale.data_ptr<T>();
   auto scale_stride = scale.stride(0);
 
+  using Vec = vec256::Vec256<T>;
   for (int64_t i = 0; i < numel; i++) {
+    if (i + kEmbeddingPrefetchDistance < numel) {
+      prefetch_embedding_row(
+          src_data + src_stride0 * select_indices_data[i + kEmbeddingPrefetchDistance],
+          ddim * src_stride1 * sizeof(T));
+    }
     auto* src_base = src_data + src_stride0 * select_indices_data[i];
     auto* output_base = output_data + output_stride0 * add_indices_data[i];
     auto scale = scale_data[i * scale_stride];
-    for (int64_t j = 0; j < ddim; j++) {
-      output_base[j * output_stride1] += src_base[j * src_stride1] * scale;
+    if (src_stride1 == 1 && output_stride1 == 1) {
+      // Fused gather + per-sample-weight multiply + accumulate in one pass
+      auto scale_vec = Vec(scale);
+      int64_t j = 0;
+      for (; j + Vec::size() <= ddim; j += Vec::size()) {
+        auto sum = vec256::fmadd(
+            Vec::loadu(src_base + j), scale_vec, Vec::loadu(output_base + j));
+        sum.store(output_base + j);
+      }
+      for (; j < ddim; j++) {
+        output_base[j] += src_base[j] * scale;
+      }
+    } else {
+      for (int64_t j = 0; j < ddim; j++) {
+        output_base[j * output_stride1] += src_base[j * src_stride1] * scale;
+      }
     }
   }
 }
@@ -185,6 +247,11 @@ void index_select_scale_add<float>(const Tensor &select_indices,
 
 
     for (int64_t i = 0; i < numel; i++) {
+      if (i + kEmbeddingPrefetchDistance < numel) {
+        prefetch_embedding_row(
+            src_data + src_stride0 * select_indices_data[i + kEmbeddingPrefetchDistance],
+            ddim * src_stride1 * sizeof(float));
+      }
       auto* src_base = src_data + src_stride0 * select_indices_data[i];
       auto* output_base = output_data + output_stride0 * add_indices_data[i];
       auto scale = scale_data[i * scale_stride];
@@ -0,0 +1,75 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+void check_grouped_index_select_args(TensorList tensors, TensorList indices) {
+  TORCH_CHECK(
+      tensors.size() == indices.size(),
+      "grouped_index_select: expected as many index tensors as inputs, got ",
+      tensors.size(),
+      " inputs and ",
+      indices.size(),
+      " index tensors");
+  for (size_t i = 0; i < indices.size(); ++i) {
+    TORCH_CHECK(
+        indices[i].scalar_type() == kLong,
+        "grouped_index_select: expected indices of scalar type Long, but got ",
+        indices[i].scalar_type(),
+        " for group ",
+        i);
+    TORCH_CHECK(
+        indices[i].dim() == 1,
+        "grouped_index_select: expected 1-D indices, but got ",
+        indices[i].dim(),
+        "-D indices for group ",
+        i);
+  }
+}
+
+} // namespace
+
+// Grouped lookup along dim 0: equivalent to index_select(tensors[i], 0,
+// indices[i]) for every pair. On CPU the per-call overhead is negligible,
+// so this is just the loop; the batched kernel lives in the CUDA backend.
+std::vector<Tensor> grouped_index_select_cpu(
+    TensorList tensors,
+    TensorList indices) {
+  check_grouped_index_select_args(tensors, indices);
+  std::vector<Tensor> results;
+  results.reserve(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    results.push_back(at::index_select(tensors[i], 0, indices[i]));
+  }
+  return results;
+}
+
+std::vector<Tensor> grouped_index_select_backward_cpu(
+    TensorList grads,
+    TensorList indices,
+    IntArrayRef num_rows) {
+  check_grouped_index_select_args(grads, indices);
+  TORCH_CHECK(
+      grads.size() == num_rows.size(),
+      "grouped_index_select backward: expected as many row counts as grads, got ",
+      grads.size(),
+      " grads and ",
+      num_rows.size(),
+      " row counts");
+  std::vector<Tensor> grad_tensors;
+  grad_tensors.reserve(grads.size());
+  for (size_t i = 0; i < grads.size(); ++i) {
+    std::vector<int64_t> sizes = grads[i].sizes().vec();
+    sizes[0] = num_rows[i];
+    grad_tensors.push_back(
+        at::zeros(sizes, grads[i].options())
+            .index_add_(0, indices[i], grads[i]));
+  }
+  return grad_tensors;
+}
+
+} // namespace native
+} // namespace at
@@ -52,8 +52,10 @@
 #include <ATen/native/IndexingUtils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/ExpandUtils.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/core/EnableNamedTensor.h>
 
@@ -231,11 +233,74 @@ static TensorIterator make_index_iterator(const AdvancedIndex& info) {
   return iter;
 }
 
+// A single all-of-self boolean mask on a contiguous CPU tensor selects a
+// compacted copy of the masked elements. The generic path materializes the
+// index tensors via nonzero() and runs the strided gather; this does it in
+// one parallel pass over the flat data instead (per-chunk counts, a serial
+// prefix sum over the chunks, then a compaction pass).
+static bool can_use_masked_compaction(const Tensor& self, TensorList indices) {
+  return indices.size() == 1 && indices[0].defined() &&
+      indices[0].scalar_type() == kBool && indices[0].sizes().equals(self.sizes()) &&
+      self.device().is_cpu() && indices[0].device().is_cpu() &&
+      self.is_contiguous() && indices[0].is_contiguous() &&
+      self.layout() == kStrided;
+}
+
+static Tensor masked_compaction(const Tensor& self, const Tensor& mask) {
+  int64_t numel = self.numel();
+  const bool* mask_data = mask.data_ptr<bool>();
+
+  int64_t num_chunks = std::min(
+      (int64_t)at::get_num_threads(),
+      std::max((int64_t)1, numel / at::internal::GRAIN_SIZE));
+  int64_t chunk_size = divup(numel, std::max(num_chunks, (int64_t)1));
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      int64_t lo = chunk * chunk_size;
+      int64_t hi = std::min(numel, lo + chunk_size);
+      int64_t count = 0;
+      for (int64_t i = lo; i < hi; i++) {
+        count += mask_data[i];
+      }
+      chunk_offsets[chunk + 1] = count;
+    }
+  });
+  for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+    chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+  }
+
+  auto result = at::empty({chunk_offsets[num_chunks]}, self.options());
+  AT_DISPATCH_ALL_TYPES_AND2(at::ScalarType::Half, at::ScalarType::Bool,
+      self.scalar_type(), "index_masked_compaction", [&] {
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    scalar_t* result_data = result.data_ptr<scalar_t>();
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        int64_t lo = chunk * chunk_size;
+        int64_t hi = std::min(numel, lo + chunk_size);
+        scalar_t* out = result_data + chunk_offsets[chunk];
+        for (int64_t i = lo; i < hi; i++) {
+          if (mask_data[i]) {
+            *out++ = self_data[i];
+          }
+        }
+      }
+    });
+  });
+  return result;
+}
+
 Tensor index(const Tensor & self, TensorList indices) {
   if (indices.size() > (size_t)self.dim()) {
     AT_INDEX_ERROR("too many indices for tensor of dimension ", self.dim(), " (got ", indices.size(), ")");
   }
 
+  if (can_use_masked_compaction(self, indices)) {
+    return masked_compaction(self, indices[0]);
+  }
+
   auto info = make_info(self, indices);
   auto iter = make_index_iterator(info);
   index_stub(iter.device_type(), iter, info.indexed_sizes, info.indexed_strides);
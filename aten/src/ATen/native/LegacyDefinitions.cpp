@@ -3,9 +3,36 @@
 #include <ATen/LegacyTHFunctionsCPU.h>
 #include <ATen/NamedTensorUtils.h>
 #include <ATen/core/EnableNamedTensor.h>
+#include <ATen/native/cpu/MaskedOpsKernel.h>
 
 namespace at { namespace native {
 
+DEFINE_DISPATCH(masked_fill_fast_stub);
+DEFINE_DISPATCH(masked_select_fast_stub);
+
+namespace {
+
+// The vectorized masked kernels only handle the simple dense case: a bool
+// mask of exactly self's shape with both tensors contiguous. Everything
+// else (broadcasting masks, byte masks, strided tensors) stays on the
+// legacy TH path.
+bool use_masked_fast_path(const Tensor& self, const Tensor& mask) {
+  return mask.scalar_type() == ScalarType::Bool && self.is_contiguous() &&
+      mask.is_contiguous() && mask.sizes().equals(self.sizes());
+}
+
+bool is_masked_fill_fast_dtype(ScalarType t) {
+  return t == ScalarType::Float || t == ScalarType::Double;
+}
+
+bool is_masked_select_fast_dtype(ScalarType t) {
+  return at::isIntegralType(t, /*includeBool=*/true) ||
+      t == ScalarType::Float || t == ScalarType::Double ||
+      t == ScalarType::Half;
+}
+
+} // namespace
+
 // Methods
 
 Tensor & masked_fill__cpu(Tensor& self, const Tensor & mask, Scalar value) {
@@ -18,6 +45,9 @@ Tensor & masked_fill__cpu(Tensor& self, const Tensor & mask, Scalar value) {
     AT_WARN("masked_fill_ received a mask with dtype torch.uint8, this behavior is now deprecated," \
             "please use a mask with dtype torch.bool instead.");
     legacy::cpu::_th_masked_fill_(self, mask, value);
+  } else if (use_masked_fast_path(self, mask) &&
+             is_masked_fill_fast_dtype(self.scalar_type())) {
+    masked_fill_fast_stub(kCPU, self, mask, value);
   } else {
     legacy::cpu::_th_masked_fill_bool_(self, mask, value);
   }
@@ -40,6 +70,9 @@ Tensor & masked_fill__cpu(Tensor& self, const Tensor & mask, const Tensor & valu
     AT_WARN("masked_fill_ received a mask with dtype torch.uint8, this behavior is now deprecated," \
             "please use a mask with dtype torch.bool instead.");
     legacy::cpu::_th_masked_fill_(self, mask, value.item());
+  } else if (use_masked_fast_path(self, mask) &&
+             is_masked_fill_fast_dtype(self.scalar_type())) {
+    masked_fill_fast_stub(kCPU, self, mask, value.item());
   } else {
     legacy::cpu::_th_masked_fill_bool_(self, mask, value.item());
   }
@@ -69,6 +102,11 @@ Tensor masked_select_cpu(const Tensor & self, const Tensor & mask) {
     AT_WARN("masked_select received a mask with dtype torch.uint8, this behavior is now deprecated," \
             "please use a mask with dtype torch.bool instead.");
     return legacy::cpu::_th_masked_select(self, mask);
+  } else if (use_masked_fast_path(self, mask) &&
+             is_masked_select_fast_dtype(self.scalar_type())) {
+    Tensor result = at::empty({0}, self.options());
+    masked_select_fast_stub(kCPU, result, self, mask);
+    return result;
   } else {
     return legacy::cpu::_th_masked_select_bool(self, mask);
   }
@@ -79,6 +117,12 @@ Tensor & masked_select_out_cpu(Tensor & result, const Tensor & self, const Tenso
   namedinference::compute_broadcast_outnames(self, mask);
 #endif
   if (mask.dtype() == at::ScalarType::Bool) {
+    if (use_masked_fast_path(self, mask) &&
+        is_masked_select_fast_dtype(self.scalar_type()) &&
+        result.scalar_type() == self.scalar_type() && result.is_contiguous()) {
+      masked_select_fast_stub(kCPU, result, self, mask);
+      return result;
+    }
     return legacy::cpu::_th_masked_select_bool_out(result, self, mask);
   } else {
     return legacy::cpu::_th_masked_select_out(result, self, mask);
@@ -27,6 +27,30 @@ Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
   return output;
 }
 
+// linear with the activation applied as an epilogue on the GEMM output.
+// The activation runs in place (where an in-place variant exists), so the
+// fused form skips the functional activation's extra allocation and output
+// write, and the JIT can collapse linear+activation into one op (see
+// FuseLinearActivation). Kept composite so autograd works through the
+// underlying ops unchanged.
+Tensor _fused_linear(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    std::string activation) {
+  auto output = at::linear(input, weight, bias);
+  if (activation == "relu") {
+    output.relu_();
+  } else if (activation == "sigmoid") {
+    output.sigmoid_();
+  } else if (activation == "gelu") {
+    output = at::gelu(output);
+  } else if (activation != "none") {
+    AT_ERROR("_fused_linear: unsupported activation '", activation, "'");
+  }
+  return output;
+}
+
 // sumproduct_pair computes `(left*right).sum(sumdims)` by means of permutation and
 // batch matrix multiplication
 // its main purpose is to provide a pairwise reduction for einsum
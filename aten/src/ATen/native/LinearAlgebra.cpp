@@ -3,6 +3,7 @@
 #include <ATen/Dispatch.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/LinearAlgebraUtils.h>
+#include <ATen/native/cpu/BatchGemmKernel.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/Parallel.h>
 #include <ATen/LegacyTHFunctionsCPU.h>
@@ -246,7 +247,23 @@ static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor&
             || (t.stride(1) == 1 && t.stride(2) >= t.size(1));
   };
 
-  if (contraction_size * res_rows * res_cols < 400) {
+  // Large batches of small matrices (e.g. per-head attention on CPU) are
+  // dominated by per-call dispatch overhead in the blas paths below; the
+  // direct register-blocked batched kernel keeps them in a single
+  // parallel_for over the batch.
+  auto use_batched_small_gemm = [&]() {
+    return is_bmm_out && bs >= 32 &&
+        res_rows <= 64 && res_cols <= 64 && contraction_size <= 64 &&
+        batch1.scalar_type() == kFloat && batch2.scalar_type() == kFloat &&
+        batch1.stride(2) == 1 && batch2.stride(2) == 1 &&
+        batch1.stride(1) >= batch1.size(2) &&
+        batch2.stride(1) >= batch2.size(2) &&
+        self_or_result.is_contiguous();
+  };
+
+  if (use_batched_small_gemm()) {
+    batched_small_gemm_stub(kCPU, self_or_result, batch1, batch2);
+  } else if (contraction_size * res_rows * res_cols < 400) {
     if (is_bmm_out) {
       AT_DISPATCH_ALL_TYPES(batch1.scalar_type(), "bmm", [&] {
           baddbmm_cpu_kernel<scalar_t, true>(self_or_result, batch1, batch2, beta, alpha);
@@ -294,6 +311,53 @@ Tensor& baddbmm__cpu(Tensor& self, const Tensor& batch1, const Tensor& batch2, S
   return bmm_out_or_baddbmm_(self, batch1, batch2, beta, alpha, false);
 }
 
+// sum_b batch1[b] @ batch2[b] folded into one wide gemm: concatenating the
+// lhs matrices along columns and the rhs matrices along rows turns the batch
+// reduction into a single (n, bs*m) x (bs*m, p) multiply, which then runs
+// through the native bmm machinery above instead of one legacy-dispatched
+// gemm per batch.
+Tensor& addbmm__cpu(Tensor& self, const Tensor& batch1, const Tensor& batch2, Scalar beta, Scalar alpha) {
+  TORCH_CHECK(batch1.dim() == 3 && batch2.dim() == 3,
+      "addbmm: expected 3D tensors, got ", batch1.dim(), "D and ", batch2.dim(), "D");
+  TORCH_CHECK(batch1.size(0) == batch2.size(0),
+      "addbmm: equal number of batches expected, got ", batch1.size(0), " and ", batch2.size(0));
+  TORCH_CHECK(batch1.size(2) == batch2.size(1),
+      "addbmm: incompatible matrix sizes (", batch1.size(1), "x", batch1.size(2),
+      " and ", batch2.size(1), "x", batch2.size(2), ")");
+  const int64_t bs = batch1.size(0);
+  const int64_t n = batch1.size(1);
+  const int64_t m = batch1.size(2);
+  const int64_t p = batch2.size(2);
+  TORCH_CHECK(self.dim() == 2 && self.size(0) == n && self.size(1) == p,
+      "addbmm: expected self size ", n, "x", p, ", got ", self.sizes());
+
+  const auto beta_val = beta.to<double>();
+  if (beta_val == 0.0) {
+    self.zero_();
+  } else if (beta_val != 1.0) {
+    self.mul_(beta);
+  }
+  if (bs == 0 || m == 0) {
+    return self;
+  }
+  Tensor lhs = batch1.transpose(0, 1).reshape({1, n, bs * m});
+  Tensor rhs = batch2.reshape({1, bs * m, p});
+  return self.add_(at::bmm(lhs, rhs).squeeze(0), alpha);
+}
+
+Tensor& addbmm_out_cpu(Tensor& result, const Tensor& self_, const Tensor& batch1, const Tensor& batch2, Scalar beta, Scalar alpha) {
+  Tensor self;
+  std::tie(self) = expand_size(self_, {batch1.size(1), batch2.size(2)}, "addbmm");
+  result.resize_(self.sizes());
+  result.copy_(self);
+  return at::native::addbmm__cpu(result, batch1, batch2, beta, alpha);
+}
+
+Tensor addbmm_cpu(const Tensor& self, const Tensor& batch1, const Tensor& batch2, Scalar beta, Scalar alpha) {
+  Tensor result = at::empty({0}, self.options());
+  return at::native::addbmm_out_cpu(result, self, batch1, batch2, beta, alpha);
+}
+
 Tensor bmm_cpu(const Tensor& self, const Tensor& mat2) {
   Tensor result = at::empty({0}, self.options());
   return at::native::bmm_out_cpu(result, self, mat2);
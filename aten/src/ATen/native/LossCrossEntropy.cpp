@@ -0,0 +1,136 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/TensorUtils.h>
+#include <ATen/native/cpu/CrossEntropyLossKernel.h>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(cross_entropy_loss_forward_kernel);
+DEFINE_DISPATCH(cross_entropy_loss_backward_kernel);
+
+namespace {
+
+// The fused kernel streams the logits once per pass instead of materializing
+// the log-probabilities; it covers the common case of a dense 2-d float or
+// double input on CPU. Everything else composes log_softmax and nll_loss.
+bool use_fused_cross_entropy(
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight) {
+  if (self.dim() != 2 || target.dim() != 1) {
+    return false;
+  }
+  if (!self.device().is_cpu() || !target.device().is_cpu()) {
+    return false;
+  }
+  if (self.layout() != kStrided || target.layout() != kStrided) {
+    return false;
+  }
+  if (self.scalar_type() != kFloat && self.scalar_type() != kDouble) {
+    return false;
+  }
+  if (target.scalar_type() != kLong) {
+    return false;
+  }
+  if (weight.defined() &&
+      (!weight.device().is_cpu() || weight.layout() != kStrided ||
+       weight.scalar_type() != self.scalar_type())) {
+    return false;
+  }
+  return true;
+}
+
+void check_cross_entropy_inputs(
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight) {
+  TORCH_CHECK(self.dim() == 2, "input tensor should be 2D");
+  TORCH_CHECK(
+      target.dim() == 1,
+      "1D target tensor expected, multi-target not supported");
+  TORCH_CHECK(
+      self.size(0) == target.size(0),
+      "size mismatch (got input: ",
+      self.sizes(),
+      ", target: ",
+      target.sizes(),
+      ")")
+  TORCH_CHECK(
+      !weight.defined() || weight.numel() == self.size(-1),
+      "weight tensor should be defined either for all ",
+      self.size(-1),
+      " classes or no classes"
+      " but got weight tensor of shape: ",
+      weight.sizes());
+}
+
+} // namespace
+
+Tensor cross_entropy_loss(
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  if (use_fused_cross_entropy(self, target, weight)) {
+    return std::get<0>(at::cross_entropy_loss_forward(
+        self, target, weight, reduction, ignore_index));
+  }
+  return at::nll_loss(
+      at::log_softmax(self, self.dim() == 1 ? 0 : 1),
+      target,
+      weight,
+      reduction,
+      ignore_index);
+}
+
+std::tuple<Tensor, Tensor> cross_entropy_loss_forward_cpu(
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  check_cross_entropy_inputs(self, target, weight);
+
+  auto output = at::empty({0}, self.options());
+  auto total_weight = at::empty({}, self.options());
+  cross_entropy_loss_forward_kernel(
+      kCPU, output, total_weight, self, target, weight, reduction, ignore_index);
+  return std::make_tuple(output, total_weight);
+}
+
+Tensor cross_entropy_loss_backward_cpu(
+    const Tensor& grad_output,
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index,
+    const Tensor& total_weight) {
+  check_cross_entropy_inputs(self, target, weight);
+  TORCH_CHECK(
+      total_weight.numel() == 1,
+      "expected total_weight to be a single element tensor, got: ",
+      total_weight.sizes(),
+      " (",
+      total_weight.numel(),
+      " elements)");
+
+  auto grad_input = at::zeros_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  TORCH_CHECK(grad_input.is_contiguous(), "grad_input must be contiguous");
+  cross_entropy_loss_backward_kernel(
+      kCPU,
+      grad_input,
+      grad_output,
+      self,
+      target,
+      weight,
+      reduction,
+      ignore_index,
+      total_weight);
+  return grad_input;
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,178 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace at { namespace native {
+
+namespace {
+
+// Note [Bit-packed bool masks]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Bool tensors store one byte per element, so pipelines that keep large
+// masks resident (attention masks, padding masks) pay 8x the memory the
+// information content needs. These converters provide an opt-in packed
+// representation: _pack_bool flattens a bool tensor into a 1-D uint8 tensor
+// with eight elements per byte, LSB first, and _unpack_bool restores the
+// flat bool tensor (the caller reshapes, since the packed form does not
+// carry sizes).
+//
+// No new logical kernels are needed on the packed form: uint8 __and__,
+// __or__, __xor__ and bitwise_not are exactly word-wise logical ops on 8
+// mask elements at a time (and are Vec256-vectorized), so masks compose in
+// packed form directly. _packed_bool_sum counts set bits with popcount and
+// takes the original element count so bits past the end -- which
+// bitwise_not sets to one -- are never counted.
+//
+// Packing uses one 64-bit multiply per 8 elements: with the 8 bool bytes
+// loaded as a little-endian word x (each byte 0 or 1), multiplying by
+// 0x0102040810204080 accumulates byte i into bit i of the top byte (the
+// per-byte partial sums never carry, since each byte holds at most one
+// set bit per contributing element). Big-endian builds take the scalar
+// fallback.
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+constexpr bool kLittleEndian = true;
+#else
+constexpr bool kLittleEndian = false;
+#endif
+
+inline uint8_t pack8(const bool* src) {
+  if (kLittleEndian) {
+    uint64_t word;
+    std::memcpy(&word, src, sizeof(word));
+    return static_cast<uint8_t>((word * 0x0102040810204080ULL) >> 56);
+  }
+  uint8_t byte = 0;
+  for (int64_t bit = 0; bit < 8; bit++) {
+    byte |= static_cast<uint8_t>(src[bit]) << bit;
+  }
+  return byte;
+}
+
+inline void unpack8(uint8_t byte, bool* dst) {
+  for (int64_t bit = 0; bit < 8; bit++) {
+    dst[bit] = (byte >> bit) & 1;
+  }
+}
+
+inline int64_t popcount64(uint64_t word) {
+#if defined(_MSC_VER)
+  int64_t count = 0;
+  while (word) {
+    word &= word - 1;
+    count++;
+  }
+  return count;
+#else
+  return __builtin_popcountll(word);
+#endif
+}
+
+} // namespace
+
+Tensor _pack_bool_cpu(const Tensor& self) {
+  TORCH_CHECK(
+      self.scalar_type() == ScalarType::Bool,
+      "_pack_bool expects a bool tensor, got ", self.scalar_type());
+  auto input = self.contiguous();
+  int64_t numel = input.numel();
+  int64_t packed_size = (numel + 7) / 8;
+  Tensor packed = at::empty({packed_size}, self.options().dtype(kByte));
+  if (numel == 0) {
+    return packed;
+  }
+  const bool* src = input.data_ptr<bool>();
+  uint8_t* dst = packed.data_ptr<uint8_t>();
+  int64_t full_bytes = numel / 8;
+  at::parallel_for(
+      0, full_bytes, at::internal::GRAIN_SIZE / 8, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          dst[i] = pack8(src + i * 8);
+        }
+      });
+  if (full_bytes < packed_size) {
+    // Tail bits beyond numel stay zero; see the Note for why that matters
+    // to _packed_bool_sum.
+    uint8_t byte = 0;
+    for (int64_t bit = 0; bit < numel - full_bytes * 8; bit++) {
+      byte |= static_cast<uint8_t>(src[full_bytes * 8 + bit]) << bit;
+    }
+    dst[full_bytes] = byte;
+  }
+  return packed;
+}
+
+Tensor _unpack_bool_cpu(const Tensor& self, int64_t numel) {
+  TORCH_CHECK(
+      self.scalar_type() == ScalarType::Byte,
+      "_unpack_bool expects a packed uint8 tensor, got ", self.scalar_type());
+  TORCH_CHECK(numel >= 0, "_unpack_bool: numel must be non-negative, got ", numel);
+  TORCH_CHECK(
+      self.numel() >= (numel + 7) / 8,
+      "_unpack_bool: packed tensor with ", self.numel(),
+      " bytes is too small for ", numel, " elements");
+  auto input = self.contiguous();
+  Tensor result = at::empty({numel}, self.options().dtype(kBool));
+  if (numel == 0) {
+    return result;
+  }
+  const uint8_t* src = input.data_ptr<uint8_t>();
+  bool* dst = result.data_ptr<bool>();
+  int64_t full_bytes = numel / 8;
+  at::parallel_for(
+      0, full_bytes, at::internal::GRAIN_SIZE / 8, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          unpack8(src[i], dst + i * 8);
+        }
+      });
+  for (int64_t bit = 0; bit < numel - full_bytes * 8; bit++) {
+    dst[full_bytes * 8 + bit] = (src[full_bytes] >> bit) & 1;
+  }
+  return result;
+}
+
+Tensor _packed_bool_sum_cpu(const Tensor& self, int64_t numel) {
+  TORCH_CHECK(
+      self.scalar_type() == ScalarType::Byte,
+      "_packed_bool_sum expects a packed uint8 tensor, got ", self.scalar_type());
+  TORCH_CHECK(
+      numel >= 0 && self.numel() >= (numel + 7) / 8,
+      "_packed_bool_sum: packed tensor with ", self.numel(),
+      " bytes is too small for ", numel, " elements");
+  auto input = self.contiguous();
+  const uint8_t* src = input.data_ptr<uint8_t>();
+  int64_t packed_size = (numel + 7) / 8;
+  // The last byte is handled on its own when numel is not a multiple of 8,
+  // so bits past numel -- which bitwise_not on the packed form sets -- are
+  // never counted.
+  int64_t body_bytes = numel % 8 == 0 ? packed_size : packed_size - 1;
+  int64_t full_words = body_bytes / 8;
+  int64_t count = at::parallel_reduce(
+      0,
+      full_words,
+      at::internal::GRAIN_SIZE / 8,
+      int64_t(0),
+      [&](int64_t begin, int64_t end, int64_t acc) {
+        for (int64_t i = begin; i < end; i++) {
+          uint64_t word;
+          std::memcpy(&word, src + i * 8, sizeof(word));
+          acc += popcount64(word);
+        }
+        return acc;
+      },
+      std::plus<int64_t>());
+  for (int64_t i = full_words * 8; i < body_bytes; i++) {
+    count += popcount64(src[i]);
+  }
+  if (numel % 8 != 0 && packed_size > 0) {
+    uint8_t last = src[packed_size - 1] &
+        static_cast<uint8_t>((1 << (numel % 8)) - 1);
+    count += popcount64(last);
+  }
+  return at::scalar_tensor(count, self.options().dtype(kLong));
+}
+
+}} // namespace at::native
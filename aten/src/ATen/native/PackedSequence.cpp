@@ -1,5 +1,8 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+
+#include <cstring>
 
 namespace at { namespace native {
 
@@ -181,4 +184,145 @@ std::tuple<Tensor, Tensor> _pad_packed_sequence(const Tensor& data, const Tensor
   return std::make_tuple(output, lengths_t);
 }
 
+namespace {
+
+void check_pad_sequence_args(TensorList sequences) {
+  TORCH_CHECK(sequences.size() > 0, "pad_sequence: received an empty list of sequences");
+  TORCH_CHECK(sequences[0].dim() >= 1,
+           "pad_sequence: expected sequences of at least 1 dimension, but sequence 0 has ",
+           sequences[0].dim());
+  auto trailing_dims = sequences[0].sizes().slice(1);
+  for (size_t i = 1; i < sequences.size(); ++i) {
+    TORCH_CHECK(sequences[i].dim() == sequences[0].dim() &&
+             sequences[i].sizes().slice(1) == trailing_dims,
+             "pad_sequence: expected trailing dimensions of sequence ", i,
+             " to match those of sequence 0");
+    TORCH_CHECK(sequences[i].scalar_type() == sequences[0].scalar_type(),
+             "pad_sequence: expected all sequences to have scalar type ",
+             sequences[0].scalar_type(), ", but sequence ", i, " has ",
+             sequences[i].scalar_type());
+  }
+}
+
+} // namespace
+
+// Pads a list of `L x *` sequences into one `B x T x *` (batch_first) or
+// `T x B x *` tensor in a single pass: the output is filled with the
+// padding value once, then every sequence is copied in with raw memcpys,
+// parallelized over the batch. This replaces a Python loop of
+// narrow+copy_ calls that dispatches once per sequence.
+Tensor pad_sequence_cpu(TensorList sequences, bool batch_first, double padding_value) {
+  check_pad_sequence_args(sequences);
+  const int64_t batch_size = sequences.size();
+  std::vector<Tensor> contig;
+  contig.reserve(batch_size);
+  int64_t max_len = 0;
+  for (const auto& sequence : sequences) {
+    max_len = std::max(max_len, sequence.size(0));
+    contig.push_back(sequence.contiguous());
+  }
+
+  auto trailing_dims = sequences[0].sizes().slice(1);
+  int64_t inner = 1;
+  for (const auto dim : trailing_dims) {
+    inner *= dim;
+  }
+  std::vector<int64_t> output_size; // == [B, T, *] or [T, B, *]
+  output_size.reserve(sequences[0].dim() + 1);
+  output_size.push_back(batch_first ? batch_size : max_len);
+  output_size.push_back(batch_first ? max_len : batch_size);
+  output_size.insert(output_size.end(), trailing_dims.begin(), trailing_dims.end());
+  Tensor output = at::full(output_size, padding_value, sequences[0].options());
+  if (output.numel() == 0 || inner == 0) {
+    return output;
+  }
+
+  const size_t elem_size = output.element_size();
+  char* output_data = static_cast<char*>(output.data_ptr());
+  at::parallel_for(0, batch_size, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const char* src = static_cast<const char*>(contig[i].data_ptr());
+      const int64_t length = contig[i].size(0);
+      if (batch_first) {
+        // all of sequence i's rows are contiguous in the output
+        std::memcpy(
+            output_data + i * max_len * inner * elem_size,
+            src,
+            length * inner * elem_size);
+      } else {
+        for (int64_t t = 0; t < length; ++t) {
+          std::memcpy(
+              output_data + (t * batch_size + i) * inner * elem_size,
+              src + t * inner * elem_size,
+              inner * elem_size);
+        }
+      }
+    }
+  });
+  return output;
+}
+
+// Inverse of pad_sequence: slices a padded batch back into per-sequence
+// tensors, again with one memcpy per contiguous region instead of a
+// Python loop of narrows. `lengths` must be a 1D CPU int64 tensor, like
+// everywhere else in this file.
+std::vector<Tensor> unpad_sequence_cpu(const Tensor& padded, const Tensor& lengths, bool batch_first) {
+  auto lengths_t = lengths.contiguous();
+  checkLongTensor(lengths_t);
+  TORCH_CHECK(padded.dim() >= 2,
+           "unpad_sequence: expected padded input of at least 2 dimensions, but got ",
+           padded.dim());
+  const int64_t batch_size = batch_first ? padded.size(0) : padded.size(1);
+  const int64_t max_len = batch_first ? padded.size(1) : padded.size(0);
+  TORCH_CHECK(lengths_t.size(0) == batch_size,
+           "unpad_sequence: expected `len(lengths)` to be equal to batch_size, but got ",
+           lengths_t.size(0), " (batch_size=", batch_size, ")");
+
+  auto input = padded.contiguous();
+  auto trailing_dims = padded.sizes().slice(2);
+  int64_t inner = 1;
+  for (const auto dim : trailing_dims) {
+    inner *= dim;
+  }
+  const int64_t* lengths_data = lengths_t.data_ptr<int64_t>();
+  std::vector<Tensor> sequences;
+  sequences.reserve(batch_size);
+  for (int64_t i = 0; i < batch_size; ++i) {
+    TORCH_CHECK(lengths_data[i] >= 0 && lengths_data[i] <= max_len,
+             "unpad_sequence: length ", lengths_data[i], " of sequence ", i,
+             " is out of range for a padded length of ", max_len);
+    std::vector<int64_t> sequence_size; // == [lengths[i], *]
+    sequence_size.reserve(padded.dim() - 1);
+    sequence_size.push_back(lengths_data[i]);
+    sequence_size.insert(sequence_size.end(), trailing_dims.begin(), trailing_dims.end());
+    sequences.push_back(at::empty(sequence_size, padded.options()));
+  }
+  if (input.numel() == 0 || inner == 0) {
+    return sequences;
+  }
+
+  const size_t elem_size = input.element_size();
+  const char* input_data = static_cast<const char*>(input.data_ptr());
+  at::parallel_for(0, batch_size, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      char* dst = static_cast<char*>(sequences[i].data_ptr());
+      const int64_t length = lengths_data[i];
+      if (batch_first) {
+        std::memcpy(
+            dst,
+            input_data + i * max_len * inner * elem_size,
+            length * inner * elem_size);
+      } else {
+        for (int64_t t = 0; t < length; ++t) {
+          std::memcpy(
+              dst + t * inner * elem_size,
+              input_data + (t * batch_size + i) * inner * elem_size,
+              inner * elem_size);
+        }
+      }
+    }
+  });
+  return sequences;
+}
+
 }} // namespace at::native
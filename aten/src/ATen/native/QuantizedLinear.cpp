@@ -12,6 +12,7 @@
 #include "ATen/Parallel.h"
 #include "ATen/WrapDimUtilsMulti.h"
 #include "ATen/cpp_custom_type_hack.h"
+#include "ATen/native/WeightLayoutCache.h"
 
 #ifdef USE_FBGEMM
 #include "fbgemm/Fbgemm.h"
@@ -265,19 +266,25 @@ Tensor fbgemm_pack_quantized_matrix(const Tensor& weight) {
   // same numerics across different machines. Therefore, we do not provide a
   // fallback path and rather fail loudly if we cannot run FBGEMM.
   TORCH_CHECK(fbgemm::fbgemmSupportedCPU(), "Your CPU doesn't support FBGEMM.");
-  const int64_t K = weight.size(1);
-  const int64_t N = weight.size(0);
-  const Tensor weight_contig = weight.contiguous();
-  const int8_t* weight_ptr = weight_contig.data_ptr<int8_t>();
-  auto ptr = guts::make_unique<fbgemm::PackBMatrix<int8_t>>(
-      /*trans=*/fbgemm::matrix_op_t::Transpose,
-      /*nRow=*/K,
-      /*nCol=*/N,
-      /*smat=*/weight_ptr,
-      /*ld=*/K,
-      /*pmat=*/nullptr, // PackBMatrix manages ownership of pmat
-      /*groups=*/1);
-  return cpp_custom_type_hack::create(std::move(ptr), weight.options());
+  // Packing the same weight on every call is pure waste; serve a cached
+  // packed copy until the weight is mutated in place. See
+  // Note [Weight layout cache].
+  return cached_weight_layout(
+      weight, "fbgemm-int8-packed", [](const Tensor& weight) {
+        const int64_t K = weight.size(1);
+        const int64_t N = weight.size(0);
+        const Tensor weight_contig = weight.contiguous();
+        const int8_t* weight_ptr = weight_contig.data_ptr<int8_t>();
+        auto ptr = guts::make_unique<fbgemm::PackBMatrix<int8_t>>(
+            /*trans=*/fbgemm::matrix_op_t::Transpose,
+            /*nRow=*/K,
+            /*nCol=*/N,
+            /*smat=*/weight_ptr,
+            /*ld=*/K,
+            /*pmat=*/nullptr, // PackBMatrix manages ownership of pmat
+            /*groups=*/1);
+        return cpp_custom_type_hack::create(std::move(ptr), weight.options());
+      });
 }
 
 Tensor fbgemm_pack_quantized_matrix(
@@ -343,23 +350,26 @@ Tensor fbgemm_pack_gemm_matrix_fp16(const Tensor& weight) {
   // same numerics across different machines. Therefore, we do not provide a
   // fallback path and rather fail loudly if we cannot run FBGEMM.
   TORCH_CHECK(fbgemm::fbgemmSupportedCPU(), "Your CPU doesn't support FBGEMM.");
-
-  const int64_t K = weight.size(1);
-  const int64_t N = weight.size(0);
-  Tensor weight_contig = weight.contiguous();
-  float* weight_contig_ptr = weight_contig.data_ptr<float>();
-  HandleWeightsSaturation(K * N, weight_contig_ptr);
-
-  // TODO(mingzhe09088):
-  // Consider using a functor here in PackedGemmMatrixFP16
-  // Comments from (XQ): Not entirely sure this make_unique is safe. make_unique
-  // is created with regular "new", and freed through TypeMetaData::deleteFn in
-  // this function. This is perfectly fine if the tensors are created and freed
-  // within this translation unit. It might be very problematic if that tensor
-  // flows across dll boundaries.
-  auto ptr = guts::make_unique<fbgemm::PackedGemmMatrixFP16>(
-      fbgemm::matrix_op_t::Transpose, K, N, 1, weight_contig_ptr);
-  return cpp_custom_type_hack::create(std::move(ptr), weight.options());
+  // See Note [Weight layout cache].
+  return cached_weight_layout(
+      weight, "fbgemm-fp16-packed", [](const Tensor& weight) {
+        const int64_t K = weight.size(1);
+        const int64_t N = weight.size(0);
+        Tensor weight_contig = weight.contiguous();
+        float* weight_contig_ptr = weight_contig.data_ptr<float>();
+        HandleWeightsSaturation(K * N, weight_contig_ptr);
+
+        // TODO(mingzhe09088):
+        // Consider using a functor here in PackedGemmMatrixFP16
+        // Comments from (XQ): Not entirely sure this make_unique is safe.
+        // make_unique is created with regular "new", and freed through
+        // TypeMetaData::deleteFn in this function. This is perfectly fine if
+        // the tensors are created and freed within this translation unit. It
+        // might be very problematic if that tensor flows across dll boundaries.
+        auto ptr = guts::make_unique<fbgemm::PackedGemmMatrixFP16>(
+            fbgemm::matrix_op_t::Transpose, K, N, 1, weight_contig_ptr);
+        return cpp_custom_type_hack::create(std::move(ptr), weight.options());
+      });
 }
 
 Tensor fbgemm_linear_fp16_weight_fp32_activation(
@@ -2,6 +2,7 @@
 
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/core/grad_mode.h>
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 
@@ -9,6 +10,9 @@
 
 namespace at { namespace native {
 
+DEFINE_DISPATCH(fused_lstm_cell_stub);
+DEFINE_DISPATCH(fused_gru_cell_stub);
+
 namespace {
 
 // Check if pytorch is compiled with MIOpen.
@@ -171,11 +175,19 @@ struct QuantizedCellParamsDynamic {
     TORCH_CHECK(false, "matmul is not supported with quantized cell params");
   }
 
+  // linear_hh runs once per timestep, so the schema lookup for
+  // quantized::linear_dynamic is resolved once and cached instead of being
+  // repeated on every call.
+  static const c10::OperatorHandle& linear_dynamic_op() {
+    static const c10::OperatorHandle op =
+        c10::Dispatcher::singleton()
+            .findSchema({"quantized::linear_dynamic", ""})
+            .value();
+    return op;
+  }
   Tensor linear_ih(const Tensor& input_ih) const {
-    const auto kFuncName = "quantized::linear_dynamic";
-    const auto kOvrldName = "";
     const std::vector<c10::IValue> output_ih_list =
-        callOp(kFuncName, kOvrldName, input_ih, w_ih);
+        callOp(linear_dynamic_op(), input_ih, w_ih);
     TORCH_INTERNAL_ASSERT(
         output_ih_list.size() == 1,
         "The output vector should have exact one element");
@@ -183,10 +195,8 @@ struct QuantizedCellParamsDynamic {
     return output_ih;
   }
   Tensor linear_hh(const Tensor& input_hh) const {
-    const auto kFuncName = "quantized::linear_dynamic";
-    const auto kOvrldName = "";
     const std::vector<c10::IValue> output_hh_list =
-        callOp(kFuncName, kOvrldName, input_hh, w_hh);
+        callOp(linear_dynamic_op(), input_hh, w_hh);
     TORCH_INTERNAL_ASSERT(
         output_hh_list.size() == 1,
         "The output vector should have exact one element");
@@ -386,6 +396,20 @@ struct SimpleCell : Cell<Tensor, cell_params> {
   }
 };
 
+// Whether the fused pointwise cell kernels (cpu/RNNCellKernel.cpp) can take
+// over from the chunk+pointwise composition below. The fused kernels assume
+// dense row-major gate layouts, only cover float/double, and don't record an
+// autograd graph, so anything requiring grad has to keep going through the
+// differentiable composition.
+inline bool can_use_fused_cell(const Tensor& gates, const Tensor& hx) {
+  return !at::GradMode::is_enabled() && !gates.requires_grad() &&
+      !hx.requires_grad() && gates.device().is_cpu() &&
+      gates.dim() == 2 && hx.dim() == 2 &&
+      gates.is_contiguous() && hx.is_contiguous() &&
+      gates.scalar_type() == hx.scalar_type() &&
+      (gates.scalar_type() == kFloat || gates.scalar_type() == kDouble);
+}
+
 // TODO: can use inplace ops?
 template <typename cell_params>
 struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
@@ -411,6 +435,12 @@ struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
 
     const auto gates = params.linear_hh(hx).add_(
         pre_compute_input ? input : params.linear_ih(input));
+    if (can_use_fused_cell(gates, cx)) {
+      auto hy = at::empty_like(cx);
+      auto cy = at::empty_like(cx);
+      fused_lstm_cell_stub(kCPU, hy, cy, gates, cx);
+      return std::make_tuple(std::move(hy), std::move(cy));
+    }
     auto chunked_gates = gates.chunk(4, 1);
     auto ingate = chunked_gates[0].sigmoid_();
     auto forgetgate = chunked_gates[1].sigmoid_();
@@ -441,10 +471,16 @@ struct GRUCell : Cell<Tensor, cell_params> {
       // Slice off the workspace argument (it's needed only for AD).
       return std::move(std::get<0>(result));
     }
-    const auto chunked_igates = pre_compute_input
-        ? input.chunk(3, 1)
-        : params.linear_ih(input).chunk(3, 1);
-    auto chunked_hgates = params.linear_hh(hidden).chunk(3, 1);
+    const auto igates =
+        pre_compute_input ? input : params.linear_ih(input);
+    const auto hgates = params.linear_hh(hidden);
+    if (can_use_fused_cell(igates, hidden) && hgates.is_contiguous()) {
+      auto hy = at::empty_like(hidden);
+      fused_gru_cell_stub(kCPU, hy, igates, hgates, hidden);
+      return hy;
+    }
+    const auto chunked_igates = igates.chunk(3, 1);
+    auto chunked_hgates = hgates.chunk(3, 1);
     const auto reset_gate =
         chunked_hgates[0].add_(chunked_igates[0]).sigmoid_();
     const auto input_gate =
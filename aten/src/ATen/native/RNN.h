@@ -27,6 +27,24 @@ DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_miopen_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_miopen_stub);
 
+// Fused pointwise cell updates for the CPU inference path: given the
+// pre-computed gate matmuls, the gate nonlinearities and the state update
+// run in a single vectorized pass (see cpu/RNNCellKernel.cpp) instead of a
+// chain of separate pointwise ops.
+using lstm_cell_fn = void (*)(
+    Tensor& /*hy*/,
+    Tensor& /*cy*/,
+    const Tensor& /*gates*/,
+    const Tensor& /*cx*/);
+using gru_cell_fn = void (*)(
+    Tensor& /*hy*/,
+    const Tensor& /*igates*/,
+    const Tensor& /*hgates*/,
+    const Tensor& /*hx*/);
+
+DECLARE_DISPATCH(lstm_cell_fn, fused_lstm_cell_stub);
+DECLARE_DISPATCH(gru_cell_fn, fused_gru_cell_stub);
+
 inline void check_device(const Tensor& input, const TensorList& params, const TensorList& hiddens) {
   auto input_device = input.device();
 
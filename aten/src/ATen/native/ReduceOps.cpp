@@ -253,6 +253,15 @@ static ScalarType get_dtype(Tensor& result, const Tensor& self, optional<ScalarT
   return src_type;
 }
 
+// Note [out= reductions and allocation]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The out= reductions below (sum, prod, mean, std/var, argmax) bind the
+// caller's tensor as the TensorIterator output. When `result` already has
+// the reduced shape and dtype, the resize in make_reduction is a no-op and
+// the kernel writes directly into caller storage with no hidden allocation,
+// so repeated calls with a preallocated buffer are allocation-free in steady
+// state. (TensorIterator may still allocate a temporary when asked to reduce
+// into a tensor of a different dtype than the computation.)
 Tensor& sum_out(Tensor& result, const Tensor& self, IntArrayRef dim,
                        bool keepdim, optional<ScalarType> opt_dtype) {
   ScalarType dtype = get_dtype(result, self, opt_dtype, true);
@@ -624,6 +633,9 @@ Tensor max_values(const Tensor& self, DimnameList dims, bool keepdim) {
 }
 #endif
 
+// See Note [out= reductions and allocation]. With a dim argument this writes
+// into `result` without allocating; the full reduction (dim=None) goes
+// through reshape(-1), which materializes a copy for non-contiguous inputs.
 Tensor& argmax_out(Tensor& result, const Tensor& self, c10::optional<int64_t> dim, bool keepdim) {
   TORCH_CHECK(self.numel() > 0, "cannot perform reduction function argmax on a "
       "tensor with no elements because the operation does not have an identity");
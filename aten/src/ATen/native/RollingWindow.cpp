@@ -0,0 +1,184 @@
+// Rolling (sliding window) reductions on CPU.
+//
+// rolling_sum / rolling_mean / rolling_max compute the reduction of every
+// length-`window` slice along `dim`, i.e. what
+// self.unfold(dim, window, 1).sum(-1) (etc.) computes, without
+// materializing the unfolded copy. The sum and mean use the O(n) sliding
+// recurrence with a widened accumulator (one add and one subtract per
+// output element); the max uses the O(n) monotonic-deque algorithm, so
+// the cost is independent of the window size. All three parallelize over
+// the rows orthogonal to the reduced dimension.
+
+#include <ATen/ATen.h>
+#include <ATen/AccumulateType.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/WrapDimUtils.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+struct RollingSetup {
+  Tensor input; // self with `dim` innermost, contiguous
+  Tensor output; // same layout with the innermost length reduced
+  int64_t dim = 0; // wrapped reduction dim of self
+  int64_t rows = 0;
+  int64_t n = 0;
+  int64_t out_len = 0;
+};
+
+RollingSetup rolling_setup(
+    const Tensor& self,
+    int64_t window,
+    int64_t dim,
+    const char* name) {
+  TORCH_CHECK(
+      self.dim() >= 1, name, ": expected a tensor with at least 1 dimension");
+  TORCH_CHECK(window >= 1, name, ": window must be at least 1, got ", window);
+  RollingSetup setup;
+  setup.dim = maybe_wrap_dim(dim, self.dim());
+  setup.n = self.size(setup.dim);
+  TORCH_CHECK(
+      window <= setup.n,
+      name,
+      ": window ",
+      window,
+      " is larger than dimension ",
+      setup.dim,
+      " of size ",
+      setup.n);
+  setup.input = self.transpose(setup.dim, self.dim() - 1).contiguous();
+  setup.rows = setup.input.numel() / setup.n;
+  setup.out_len = setup.n - window + 1;
+  auto sizes = setup.input.sizes().vec();
+  sizes.back() = setup.out_len;
+  setup.output = at::empty(sizes, setup.input.options());
+  return setup;
+}
+
+int64_t rolling_grain(int64_t n) {
+  return std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(n, 1));
+}
+
+template <typename scalar_t>
+void rolling_sum_kernel(
+    const scalar_t* input,
+    scalar_t* output,
+    int64_t rows,
+    int64_t n,
+    int64_t window,
+    bool mean) {
+  using acc_t = at::acc_type<scalar_t, false>;
+  const int64_t out_len = n - window + 1;
+  const acc_t divisor = static_cast<acc_t>(window);
+  at::parallel_for(0, rows, rolling_grain(n), [&](int64_t begin, int64_t end) {
+    for (int64_t row = begin; row < end; ++row) {
+      const scalar_t* in = input + row * n;
+      scalar_t* out = output + row * out_len;
+      acc_t acc = 0;
+      for (int64_t i = 0; i < window; ++i) {
+        acc += static_cast<acc_t>(in[i]);
+      }
+      out[0] = static_cast<scalar_t>(mean ? acc / divisor : acc);
+      for (int64_t i = 1; i < out_len; ++i) {
+        acc += static_cast<acc_t>(in[i + window - 1]) -
+            static_cast<acc_t>(in[i - 1]);
+        out[i] = static_cast<scalar_t>(mean ? acc / divisor : acc);
+      }
+    }
+  });
+}
+
+template <typename scalar_t>
+void rolling_max_kernel(
+    const scalar_t* input,
+    scalar_t* output,
+    int64_t rows,
+    int64_t n,
+    int64_t window,
+    int64_t out_len) {
+  at::parallel_for(0, rows, rolling_grain(n), [&](int64_t begin, int64_t end) {
+    // Ring buffer holding the indices of the window's max candidates in
+    // decreasing value order; at most `window` of them are live at a time.
+    std::vector<int64_t> deque(window);
+    for (int64_t row = begin; row < end; ++row) {
+      const scalar_t* in = input + row * n;
+      scalar_t* out = output + row * out_len;
+      int64_t head = 0;
+      int64_t tail = 0;
+      for (int64_t i = 0; i < n; ++i) {
+        // Drop the front candidate once it slides out of the window.
+        if (head != tail && deque[head % window] <= i - window) {
+          ++head;
+        }
+        // Candidates not larger than the new element can never be the
+        // max of any window that also contains the new element.
+        while (head != tail && !(in[deque[(tail - 1) % window]] > in[i])) {
+          --tail;
+        }
+        deque[tail % window] = i;
+        ++tail;
+        if (i >= window - 1) {
+          out[i - window + 1] = in[deque[head % window]];
+        }
+      }
+    }
+  });
+}
+
+} // namespace
+
+Tensor rolling_sum_cpu(const Tensor& self, int64_t window, int64_t dim) {
+  auto setup = rolling_setup(self, window, dim, "rolling_sum");
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "rolling_sum_cpu", [&] {
+    rolling_sum_kernel<scalar_t>(
+        setup.input.data_ptr<scalar_t>(),
+        setup.output.data_ptr<scalar_t>(),
+        setup.rows,
+        setup.n,
+        window,
+        /*mean=*/false);
+  });
+  return setup.output.transpose(setup.dim, self.dim() - 1);
+}
+
+Tensor rolling_mean_cpu(const Tensor& self, int64_t window, int64_t dim) {
+  TORCH_CHECK(
+      at::isFloatingType(self.scalar_type()),
+      "rolling_mean: only supports floating point types, got ",
+      self.scalar_type());
+  auto setup = rolling_setup(self, window, dim, "rolling_mean");
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "rolling_mean_cpu", [&] {
+    rolling_sum_kernel<scalar_t>(
+        setup.input.data_ptr<scalar_t>(),
+        setup.output.data_ptr<scalar_t>(),
+        setup.rows,
+        setup.n,
+        window,
+        /*mean=*/true);
+  });
+  return setup.output.transpose(setup.dim, self.dim() - 1);
+}
+
+Tensor rolling_max_cpu(const Tensor& self, int64_t window, int64_t dim) {
+  auto setup = rolling_setup(self, window, dim, "rolling_max");
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "rolling_max_cpu", [&] {
+    rolling_max_kernel<scalar_t>(
+        setup.input.data_ptr<scalar_t>(),
+        setup.output.data_ptr<scalar_t>(),
+        setup.rows,
+        setup.n,
+        window,
+        setup.out_len);
+  });
+  return setup.output.transpose(setup.dim, self.dim() - 1);
+}
+
+} // namespace native
+} // namespace at
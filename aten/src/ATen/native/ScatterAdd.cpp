@@ -0,0 +1,330 @@
+// scatter_add_ on CPU.
+//
+// The TH kernel (THTensor_(scatterAdd)) walks the whole tensor on one core.
+// This file keeps TH around for the edge cases but routes the common shapes
+// through one of two parallel engines, both of which add in the same order
+// as the sequential kernel and therefore produce bitwise identical results
+// on every run, independent of the thread count:
+//
+//  - slice parallelism: every coordinate outside the scatter dimension
+//    addresses a disjoint set of self elements, so those slices run
+//    concurrently with the serial in-slice order preserved. No atomics.
+//  - sort based: when there are too few slices for the above (the extreme
+//    being scatter into a 1-d tensor, where collision-heavy indices would
+//    serialize everything on one core), (index, position) pairs are sorted
+//    and every run of equal indices is reduced by one task.
+//
+// The sort-based engine can be forced for every call with
+// TORCH_SCATTER_ADD_SORTED=1; by default it is picked per call.
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/LegacyTHFunctionsCPU.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/WrapDimUtils.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+bool scatterAddSortForced() {
+  static const bool forced = []() {
+    const char* env = std::getenv("TORCH_SCATTER_ADD_SORTED");
+    return env && std::atoi(env) != 0;
+  }();
+  return forced;
+}
+
+struct SliceOffsets {
+  int64_t self;
+  int64_t index;
+  int64_t src;
+};
+
+// Decomposes the linear slice id r into coordinates over every dimension of
+// index except dim, and accumulates the matching element offset into each of
+// the three tensors.
+SliceOffsets slice_offsets(
+    int64_t r,
+    int64_t dim,
+    IntArrayRef index_sizes,
+    IntArrayRef self_strides,
+    IntArrayRef index_strides,
+    IntArrayRef src_strides) {
+  SliceOffsets off{0, 0, 0};
+  for (int64_t d = static_cast<int64_t>(index_sizes.size()) - 1; d >= 0; d--) {
+    if (d == dim) {
+      continue;
+    }
+    const int64_t coord = r % index_sizes[d];
+    r /= index_sizes[d];
+    off.self += coord * self_strides[d];
+    off.index += coord * index_strides[d];
+    off.src += coord * src_strides[d];
+  }
+  return off;
+}
+
+// Slice-parallel engine: self elements written by different slices are
+// disjoint (their coordinates differ outside dim), so slices run in
+// parallel while each keeps the serial per-slice addition order.
+template <typename scalar_t>
+void scatter_add_parallel_slices(
+    scalar_t* self_ptr,
+    const int64_t* index_ptr,
+    const scalar_t* src_ptr,
+    int64_t dim,
+    int64_t n,
+    int64_t n_rest,
+    int64_t self_dim_size,
+    IntArrayRef index_sizes,
+    IntArrayRef self_strides,
+    IntArrayRef index_strides,
+    IntArrayRef src_strides) {
+  const int64_t grain = at::calc_grain_size(
+      /*bytes_per_iter=*/n * static_cast<int64_t>(2 * sizeof(scalar_t) + sizeof(int64_t)),
+      /*flops_per_iter=*/n);
+  at::parallel_for(0, n_rest, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      const SliceOffsets off = slice_offsets(
+          r, dim, index_sizes, self_strides, index_strides, src_strides);
+      for (int64_t i = 0; i < n; i++) {
+        const int64_t idx = index_ptr[off.index + i * index_strides[dim]];
+        TORCH_CHECK(
+            idx >= 0 && idx < self_dim_size, "Invalid index in scatter_add");
+        self_ptr[off.self + idx * self_strides[dim]] +=
+            src_ptr[off.src + i * src_strides[dim]];
+      }
+    }
+  });
+}
+
+// Sorts the (index, position) pairs of one slice. The same range-partitioned
+// bucketing as sparse coalesce (see SparseTensor.cpp): buckets concatenate in
+// globally sorted order and no thread writes outside its own range. The
+// position tie break keeps equal indices in ascending position order.
+void sort_slice_indices(
+    const int64_t* index_ptr,
+    int64_t index_stride,
+    int64_t n,
+    int64_t self_dim_size,
+    std::vector<std::pair<int64_t, int64_t>>& sorted) {
+  sorted.resize(n);
+  const auto key_at = [index_ptr, index_stride, self_dim_size](int64_t i) {
+    const int64_t idx = index_ptr[i * index_stride];
+    TORCH_CHECK(
+        idx >= 0 && idx < self_dim_size, "Invalid index in scatter_add");
+    return idx;
+  };
+
+  const int64_t num_chunks = at::get_num_threads();
+  if (n < at::internal::GRAIN_SIZE || num_chunks == 1) {
+    for (int64_t i = 0; i < n; i++) {
+      sorted[i] = std::make_pair(key_at(i), i);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return;
+  }
+
+  // A few buckets per thread so a power-law index distribution still
+  // spreads the per-bucket sorts across all cores. Keys are already known
+  // to lie in [0, self_dim_size).
+  const int64_t num_buckets = num_chunks * 4;
+  const int64_t bucket_width = self_dim_size / num_buckets + 1;
+  const int64_t chunk_size = divup(n, num_chunks);
+  std::vector<int64_t> counts(num_chunks * num_buckets, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      int64_t* chunk_counts = counts.data() + c * num_buckets;
+      const int64_t i_end = std::min((c + 1) * chunk_size, n);
+      for (int64_t i = c * chunk_size; i < i_end; i++) {
+        chunk_counts[key_at(i) / bucket_width]++;
+      }
+    }
+  });
+
+  std::vector<int64_t> bucket_offsets(num_buckets + 1, 0);
+  int64_t running = 0;
+  for (int64_t b = 0; b < num_buckets; b++) {
+    bucket_offsets[b] = running;
+    for (int64_t c = 0; c < num_chunks; c++) {
+      const int64_t count = counts[c * num_buckets + b];
+      counts[c * num_buckets + b] = running;
+      running += count;
+    }
+  }
+  bucket_offsets[num_buckets] = running;
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      int64_t* chunk_offsets = counts.data() + c * num_buckets;
+      const int64_t i_end = std::min((c + 1) * chunk_size, n);
+      for (int64_t i = c * chunk_size; i < i_end; i++) {
+        const int64_t key = key_at(i);
+        sorted[chunk_offsets[key / bucket_width]++] = std::make_pair(key, i);
+      }
+    }
+  });
+  at::parallel_for(0, num_buckets, 1, [&](int64_t bucket_begin, int64_t bucket_end) {
+    for (int64_t b = bucket_begin; b < bucket_end; b++) {
+      std::sort(
+          sorted.begin() + bucket_offsets[b],
+          sorted.begin() + bucket_offsets[b + 1]);
+    }
+  });
+}
+
+// Sort-based engine for a single slice: after sorting, every run of equal
+// indices is reduced by exactly one task, so collisions cost nothing beyond
+// the sort. Within a run the positions are ascending, so the additions
+// happen in the serial order and the result matches the sequential kernel
+// exactly.
+template <typename scalar_t>
+void scatter_add_sorted_slice(
+    scalar_t* self_ptr,
+    const int64_t* index_ptr,
+    const scalar_t* src_ptr,
+    int64_t n,
+    int64_t self_dim_size,
+    int64_t self_stride,
+    int64_t index_stride,
+    int64_t src_stride,
+    std::vector<std::pair<int64_t, int64_t>>& sorted) {
+  sort_slice_indices(index_ptr, index_stride, n, self_dim_size, sorted);
+
+  // Finds the start of every run of equal indices, in two passes so the
+  // output offset of every chunk is known and the fill can run in parallel.
+  const int64_t num_chunks = at::get_num_threads();
+  const int64_t chunk_size = divup(n, num_chunks);
+  const auto is_segment_start = [&sorted](int64_t i) {
+    return i == 0 || sorted[i].first != sorted[i - 1].first;
+  };
+  std::vector<int64_t> chunk_segments(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      const int64_t i_end = std::min((c + 1) * chunk_size, n);
+      int64_t num_segments = 0;
+      for (int64_t i = c * chunk_size; i < i_end; i++) {
+        num_segments += is_segment_start(i);
+      }
+      chunk_segments[c + 1] = num_segments;
+    }
+  });
+  for (int64_t c = 0; c < num_chunks; c++) {
+    chunk_segments[c + 1] += chunk_segments[c];
+  }
+  const int64_t num_segments = chunk_segments[num_chunks];
+  std::vector<int64_t> segment_starts(num_segments + 1);
+  segment_starts[num_segments] = n; // sentinel, so segment s ends at starts[s + 1]
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      const int64_t i_end = std::min((c + 1) * chunk_size, n);
+      int64_t s = chunk_segments[c];
+      for (int64_t i = c * chunk_size; i < i_end; i++) {
+        if (is_segment_start(i)) {
+          segment_starts[s++] = i;
+        }
+      }
+    }
+  });
+
+  const int64_t avg_len = divup(n, num_segments);
+  const int64_t grain = at::calc_grain_size(
+      /*bytes_per_iter=*/avg_len * static_cast<int64_t>(2 * sizeof(scalar_t)),
+      /*flops_per_iter=*/avg_len);
+  at::parallel_for(0, num_segments, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t s = begin; s < end; s++) {
+      const int64_t first = segment_starts[s];
+      scalar_t* target = self_ptr + sorted[first].first * self_stride;
+      scalar_t acc = *target;
+      for (int64_t i = first; i < segment_starts[s + 1]; i++) {
+        acc += src_ptr[sorted[i].second * src_stride];
+      }
+      *target = acc;
+    }
+  });
+}
+
+} // namespace
+
+Tensor& scatter_add_cpu_(
+    Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& src) {
+  // The TH kernel handles every edge case (scalars, Bool/Half, shape
+  // errors), so anything the parallel engines do not cover is delegated to
+  // it unchanged, including inputs too small to be worth threading.
+  const auto type = self.scalar_type();
+  bool engines_apply = at::isIntegralType(type, /*includeBool=*/false) ||
+      type == ScalarType::Float || type == ScalarType::Double;
+  engines_apply = engines_apply && self.dim() > 0 &&
+      self.dim() == index.dim() && self.dim() == src.dim() &&
+      index.scalar_type() == ScalarType::Long && index.numel() > 0;
+  if (engines_apply) {
+    dim = maybe_wrap_dim(dim, self.dim());
+    for (int64_t d = 0; d < self.dim(); d++) {
+      // Writing through a zero self stride would make slices overlap; leave
+      // that (and the shape errors) to TH.
+      engines_apply = engines_apply && index.size(d) <= src.size(d) &&
+          (d == dim || index.size(d) <= self.size(d)) &&
+          (self.size(d) <= 1 || self.stride(d) != 0);
+    }
+  }
+  if (!engines_apply ||
+      (index.numel() < at::internal::GRAIN_SIZE && !scatterAddSortForced()) ||
+      at::get_num_threads() == 1) {
+    return legacy::cpu::_th_scatter_add_(self, dim, index, src);
+  }
+
+  const int64_t n = index.size(dim);
+  const int64_t n_rest = index.numel() / n;
+  AT_DISPATCH_ALL_TYPES(type, "scatter_add_cpu_", [&] {
+    scalar_t* self_ptr = self.data_ptr<scalar_t>();
+    const int64_t* index_ptr = index.data_ptr<int64_t>();
+    const scalar_t* src_ptr = src.data_ptr<scalar_t>();
+    // With fewer slices than cores the slice parallelism cannot keep the
+    // machine busy, so the sort-based engine takes over (or is forced).
+    if (scatterAddSortForced() || n_rest < at::get_num_threads()) {
+      std::vector<std::pair<int64_t, int64_t>> sorted;
+      for (int64_t r = 0; r < n_rest; r++) {
+        const SliceOffsets off = slice_offsets(
+            r, dim, index.sizes(), self.strides(), index.strides(), src.strides());
+        scatter_add_sorted_slice(
+            self_ptr + off.self,
+            index_ptr + off.index,
+            src_ptr + off.src,
+            n,
+            self.size(dim),
+            self.stride(dim),
+            index.stride(dim),
+            src.stride(dim),
+            sorted);
+      }
+    } else {
+      scatter_add_parallel_slices(
+          self_ptr,
+          index_ptr,
+          src_ptr,
+          dim,
+          n,
+          n_rest,
+          self.size(dim),
+          index.sizes(),
+          self.strides(),
+          index.strides(),
+          src.strides());
+    }
+  });
+  return self;
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,132 @@
+#include <ATen/native/ScratchArena.h>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/llvmMathExtras.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace internal {
+namespace {
+
+// Per-thread cache of scratch allocations, bucketed by power-of-two size.
+// The arena itself is held by a shared_ptr: every rented buffer's deleter
+// keeps the owning arena alive, so returning a buffer after its thread has
+// exited is safe (the blocks are freed when the last buffer goes away).
+// The mutex is almost always uncontended -- it only sees cross-thread
+// traffic when a scratch tensor is released on a different thread than the
+// one that rented it.
+struct ScratchArena {
+  // Buckets for 64B .. 2MB blocks; anything larger is not cached.
+  static constexpr size_t kMinBucket = 6;   // 1 << 6 == 64
+  static constexpr size_t kMaxBucket = 21;  // 1 << 21 == 2MB
+  static constexpr size_t kMaxCachedBytes = 1 << 25;  // 32MB per thread
+
+  std::mutex mutex;
+  std::array<std::vector<void*>, kMaxBucket + 1> free_blocks;
+  size_t cached_bytes = 0;
+
+  ~ScratchArena() {
+    for (size_t bucket = 0; bucket <= kMaxBucket; ++bucket) {
+      for (void* ptr : free_blocks[bucket]) {
+        c10::free_cpu(ptr);
+      }
+    }
+  }
+
+  void* get(size_t bucket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& blocks = free_blocks[bucket];
+    if (blocks.empty()) {
+      return nullptr;
+    }
+    void* ptr = blocks.back();
+    blocks.pop_back();
+    cached_bytes -= ((size_t)1) << bucket;
+    return ptr;
+  }
+
+  // Returns false if the cache is full and the caller should free `ptr`.
+  bool put(void* ptr, size_t bucket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t block_size = ((size_t)1) << bucket;
+    if (cached_bytes + block_size > kMaxCachedBytes) {
+      return false;
+    }
+    free_blocks[bucket].push_back(ptr);
+    cached_bytes += block_size;
+    return true;
+  }
+};
+
+std::shared_ptr<ScratchArena>& thread_arena() {
+  static thread_local std::shared_ptr<ScratchArena> arena =
+      std::make_shared<ScratchArena>();
+  return arena;
+}
+
+size_t size_to_bucket(size_t nbytes) {
+  size_t bucket = llvm::Log2_64_Ceil(std::max(nbytes, (size_t)1));
+  return std::max(bucket, (size_t)ScratchArena::kMinBucket);
+}
+
+// Deleter context for buffers handed out by the arena.
+struct ScratchBlock {
+  std::shared_ptr<ScratchArena> arena;
+  void* ptr;
+  size_t bucket;
+};
+
+void return_scratch_block(void* ctx) {
+  std::unique_ptr<ScratchBlock> block(static_cast<ScratchBlock*>(ctx));
+  // Return to the arena of the releasing thread when possible so the cache
+  // follows the threads that are actually running ops.
+  auto& arena = thread_arena();
+  if (!arena || !arena->put(block->ptr, block->bucket)) {
+    c10::free_cpu(block->ptr);
+  }
+}
+
+} // namespace
+
+Tensor rent_scratch_buffer(IntArrayRef sizes, const TensorOptions& options) {
+  int64_t numel = 1;
+  for (int64_t size : sizes) {
+    numel *= size;
+  }
+  size_t nbytes = numel * elementSize(typeMetaToScalarType(options.dtype()));
+  if (options.device().type() != DeviceType::CPU ||
+      nbytes == 0 ||
+      size_to_bucket(nbytes) > ScratchArena::kMaxBucket) {
+    return at::empty(sizes, options);
+  }
+  size_t bucket = size_to_bucket(nbytes);
+  auto arena = thread_arena();
+  if (!arena) {
+    return at::empty(sizes, options);
+  }
+  void* ptr = arena->get(bucket);
+  if (!ptr) {
+    ptr = c10::alloc_cpu(((size_t)1) << bucket);
+  }
+  ScratchBlock* raw_ctx = new ScratchBlock{std::move(arena), ptr, bucket};
+  auto deleter = [raw_ctx](void* /* unused */) {
+    return_scratch_block(raw_ctx);
+  };
+  return at::from_blob(ptr, sizes, deleter, options);
+}
+
+void clear_scratch_arena() {
+  auto& arena = thread_arena();
+  if (arena) {
+    arena = std::make_shared<ScratchArena>();
+  }
+}
+
+} // namespace internal
+} // namespace native
+} // namespace at
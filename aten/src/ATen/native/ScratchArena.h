@@ -0,0 +1,32 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at {
+namespace native {
+namespace internal {
+
+// Rents a contiguous scratch tensor from a thread-local buffer arena.
+//
+// TensorIterator materializes short-lived intermediates (dtype-cast copies
+// of outputs, per-thread reduction buffers) on every call.  For workloads
+// dominated by many small ops the malloc/free traffic behind at::empty is
+// a measurable fraction of total CPU time.  Buffers returned here come
+// from a per-thread free list of recycled allocations instead: when the
+// returned tensor dies, its storage goes back onto the arena of the thread
+// that frees it (up to a fixed cache size) rather than to the allocator.
+//
+// Only dense CPU tensors are served from the arena; anything else falls
+// back to at::empty.  The resulting tensor is only suitable as a scratch
+// intermediate: it must not escape the op that rented it, since its
+// storage may be handed to a later caller as soon as it is released.
+CAFFE2_API Tensor rent_scratch_buffer(
+    IntArrayRef sizes,
+    const TensorOptions& options);
+
+// Frees all buffers cached by the calling thread's arena.
+CAFFE2_API void clear_scratch_arena();
+
+} // namespace internal
+} // namespace native
+} // namespace at
@@ -0,0 +1,267 @@
+#include <ATen/native/ShapeInference.h>
+
+#include <ATen/ExpandUtils.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace at { namespace native {
+
+std::vector<int64_t> InferredMeta::strides() const {
+  std::vector<int64_t> result(sizes.size());
+  int64_t stride = 1;
+  for (int64_t d = static_cast<int64_t>(sizes.size()) - 1; d >= 0; d--) {
+    result[d] = stride;
+    stride *= sizes[d];
+  }
+  return result;
+}
+
+int64_t InferredMeta::numel() const {
+  int64_t n = 1;
+  for (auto s : sizes) {
+    n *= s;
+  }
+  return n;
+}
+
+int64_t InferredMeta::nbytes() const {
+  return numel() * static_cast<int64_t>(elementSize(dtype));
+}
+
+namespace {
+
+std::mutex& shape_registry_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, shape_inference_fn>& shape_registry() {
+  static std::unordered_map<std::string, shape_inference_fn> registry;
+  return registry;
+}
+
+} // namespace
+
+void register_shape_inference_fn(
+    const std::string& name,
+    shape_inference_fn fn) {
+  std::lock_guard<std::mutex> lock(shape_registry_mutex());
+  shape_registry()[name] = fn;
+}
+
+bool has_shape_inference_fn(const std::string& name) {
+  std::lock_guard<std::mutex> lock(shape_registry_mutex());
+  return shape_registry().count(name) > 0;
+}
+
+InferredMeta infer_output_meta(
+    const std::string& name,
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> int_args) {
+  shape_inference_fn fn = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(shape_registry_mutex());
+    auto it = shape_registry().find(name);
+    TORCH_CHECK(
+        it != shape_registry().end(),
+        "no shape inference function registered for '", name, "'");
+    fn = it->second;
+  }
+  return fn(args, int_args);
+}
+
+ShapeInferenceRegisterer::ShapeInferenceRegisterer(
+    std::initializer_list<const char*> names,
+    shape_inference_fn fn) {
+  for (const char* name : names) {
+    register_shape_inference_fn(name, fn);
+  }
+}
+
+namespace {
+
+// Broadcasting pointwise ops: sizes from infer_size, dtype from type
+// promotion, both exactly as TensorIterator would compute them.
+InferredMeta broadcast_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> /* int_args */) {
+  TORCH_CHECK(args.size() >= 2, "expected at least 2 tensor arguments");
+  auto sizes = at::infer_size(args[0].sizes, args[1].sizes);
+  auto dtype = promoteTypes(args[0].dtype, args[1].dtype);
+  for (size_t i = 2; i < args.size(); i++) {
+    sizes = at::infer_size(sizes, args[i].sizes);
+    dtype = promoteTypes(dtype, args[i].dtype);
+  }
+  return {std::move(sizes), dtype};
+}
+
+// Broadcasting comparisons: same sizes as above, boolean output.
+InferredMeta comparison_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> int_args) {
+  auto meta = broadcast_shape(args, int_args);
+  meta.dtype = ScalarType::Bool;
+  return meta;
+}
+
+// Pointwise ops whose output matches the (first) input exactly.
+InferredMeta same_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> /* int_args */) {
+  TORCH_CHECK(args.size() >= 1, "expected at least 1 tensor argument");
+  return {args[0].sizes, args[0].dtype};
+}
+
+InferredMeta mm_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> /* int_args */) {
+  TORCH_CHECK(args.size() == 2, "mm expects 2 tensor arguments");
+  const auto& a = args[0].sizes;
+  const auto& b = args[1].sizes;
+  TORCH_CHECK(a.size() == 2 && b.size() == 2, "mm expects 2-d tensors");
+  TORCH_CHECK(
+      a[1] == b[0],
+      "size mismatch, m1: ", IntArrayRef(a), ", m2: ", IntArrayRef(b));
+  return {{a[0], b[1]}, args[0].dtype};
+}
+
+InferredMeta bmm_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> /* int_args */) {
+  TORCH_CHECK(args.size() == 2, "bmm expects 2 tensor arguments");
+  const auto& a = args[0].sizes;
+  const auto& b = args[1].sizes;
+  TORCH_CHECK(a.size() == 3 && b.size() == 3, "bmm expects 3-d tensors");
+  TORCH_CHECK(
+      a[0] == b[0] && a[2] == b[1],
+      "size mismatch, batch1: ", IntArrayRef(a),
+      ", batch2: ", IntArrayRef(b));
+  return {{a[0], a[1], b[2]}, args[0].dtype};
+}
+
+// addmm(self, mat1, mat2): output is mat1 @ mat2; self only broadcasts in.
+InferredMeta addmm_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> int_args) {
+  TORCH_CHECK(args.size() == 3, "addmm expects 3 tensor arguments");
+  return mm_shape(args.slice(1), int_args);
+}
+
+// baddbmm(self, batch1, batch2): output is batch1 @ batch2.
+InferredMeta baddbmm_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> int_args) {
+  TORCH_CHECK(args.size() == 3, "baddbmm expects 3 tensor arguments");
+  return bmm_shape(args.slice(1), int_args);
+}
+
+// linear(input, weight, bias?): last dimension replaced by weight.size(0).
+InferredMeta linear_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> /* int_args */) {
+  TORCH_CHECK(args.size() >= 2, "linear expects at least 2 tensor arguments");
+  const auto& input = args[0].sizes;
+  const auto& weight = args[1].sizes;
+  TORCH_CHECK(input.size() >= 1, "linear expects at least a 1-d input");
+  TORCH_CHECK(weight.size() == 2, "linear expects a 2-d weight");
+  TORCH_CHECK(
+      input.back() == weight[1],
+      "size mismatch, input: ", IntArrayRef(input),
+      ", weight: ", IntArrayRef(weight));
+  auto sizes = input;
+  sizes.back() = weight[0];
+  return {std::move(sizes), args[0].dtype};
+}
+
+// cat(tensors, dim): like the kernel, legacy 1-d empty tensors are skipped.
+InferredMeta cat_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> int_args) {
+  TORCH_CHECK(args.size() >= 1, "cat expects at least 1 tensor argument");
+  int64_t dim = int_args.empty() ? 0 : int_args[0];
+  std::vector<int64_t> sizes;
+  ScalarType dtype = args[0].dtype;
+  for (const auto& arg : args) {
+    if (arg.sizes.size() == 1 && arg.sizes[0] == 0) {
+      continue;
+    }
+    if (sizes.empty()) {
+      sizes = arg.sizes;
+      if (dim < 0) {
+        dim += static_cast<int64_t>(sizes.size());
+      }
+      TORCH_CHECK(
+          dim >= 0 && dim < static_cast<int64_t>(sizes.size()),
+          "cat dimension out of range");
+      continue;
+    }
+    TORCH_CHECK(
+        arg.sizes.size() == sizes.size(),
+        "cat expects tensors with matching number of dimensions");
+    for (int64_t d = 0; d < static_cast<int64_t>(sizes.size()); d++) {
+      if (d == dim) {
+        sizes[d] += arg.sizes[d];
+      } else {
+        TORCH_CHECK(
+            arg.sizes[d] == sizes[d],
+            "cat sizes must match except in dimension ", dim);
+      }
+    }
+  }
+  if (sizes.empty()) {
+    sizes = {0};
+  }
+  return {std::move(sizes), dtype};
+}
+
+// conv2d(input, weight, bias?) with int_args = stride (2), padding (2),
+// dilation (2), groups.
+InferredMeta conv2d_shape(
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> int_args) {
+  TORCH_CHECK(args.size() >= 2, "conv2d expects at least 2 tensor arguments");
+  TORCH_CHECK(
+      int_args.size() == 7,
+      "conv2d expects stride, padding, dilation and groups as 7 ints, got ",
+      int_args.size());
+  const auto& input = args[0].sizes;
+  const auto& weight = args[1].sizes;
+  TORCH_CHECK(
+      input.size() == 4 && weight.size() == 4,
+      "conv2d expects 4-d input and weight");
+  std::vector<int64_t> sizes{input[0], weight[0], 0, 0};
+  for (int64_t d = 0; d < 2; d++) {
+    int64_t stride = int_args[d];
+    int64_t padding = int_args[2 + d];
+    int64_t dilation = int_args[4 + d];
+    int64_t kernel = dilation * (weight[2 + d] - 1) + 1;
+    TORCH_CHECK(stride > 0, "conv2d expects positive strides");
+    sizes[2 + d] = (input[2 + d] + 2 * padding - kernel) / stride + 1;
+  }
+  return {std::move(sizes), args[0].dtype};
+}
+
+ShapeInferenceRegisterer reg_broadcast(
+    {"add", "sub", "mul", "div", "atan2", "pow", "remainder", "fmod",
+     "addcmul", "addcdiv"},
+    &broadcast_shape);
+ShapeInferenceRegisterer reg_comparison(
+    {"eq", "ne", "lt", "gt", "le", "ge"},
+    &comparison_shape);
+ShapeInferenceRegisterer reg_same_shape(
+    {"relu", "sigmoid", "tanh", "exp", "log", "sqrt", "rsqrt", "abs", "neg",
+     "erf", "gelu", "clone", "clamp", "softmax", "log_softmax", "dropout",
+     "batch_norm", "layer_norm"},
+    &same_shape);
+ShapeInferenceRegisterer reg_mm({"mm"}, &mm_shape);
+ShapeInferenceRegisterer reg_bmm({"bmm"}, &bmm_shape);
+ShapeInferenceRegisterer reg_addmm({"addmm"}, &addmm_shape);
+ShapeInferenceRegisterer reg_baddbmm({"baddbmm"}, &baddbmm_shape);
+ShapeInferenceRegisterer reg_linear({"linear"}, &linear_shape);
+ShapeInferenceRegisterer reg_cat({"cat"}, &cat_shape);
+ShapeInferenceRegisterer reg_conv2d({"conv2d"}, &conv2d_shape);
+
+} // namespace
+
+}} // namespace at::native
@@ -0,0 +1,80 @@
+#pragma once
+
+// Shape inference registry: compute the metadata (sizes, dtype) of a native
+// function's output without running its kernel.
+//
+// The kernels compute output shapes on the fly (usually via infer_size and
+// friends from ExpandUtils.h/InferSize.h), which requires materialized
+// inputs. This registry exposes that logic separately so callers can
+// preallocate outputs and predict memory ahead of execution: a shape
+// function receives only the metadata of the tensor arguments, plus any
+// integer arguments in declaration order, and returns the metadata the op
+// would produce.
+//
+// Functions are keyed by the base name used in native_functions.yaml
+// ("add", "mm", "conv2d", ...). Coverage is opt-in: an op appears here once
+// its shape logic has been factored out of the kernel, so callers must
+// handle lookup misses by falling back to execution.
+
+#include <ATen/ATen.h>
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace at { namespace native {
+
+/// The metadata of a tensor argument that shape functions consume.
+/// Constructible from a Tensor, or from bare sizes/dtype when no tensor
+/// exists yet (e.g. when planning ahead of a request).
+struct CAFFE2_API ShapeArg {
+  /* implicit */ ShapeArg(const Tensor& t)
+      : sizes(t.sizes().vec()), dtype(t.scalar_type()) {}
+  ShapeArg(IntArrayRef sizes_, ScalarType dtype_)
+      : sizes(sizes_.vec()), dtype(dtype_) {}
+
+  std::vector<int64_t> sizes;
+  ScalarType dtype;
+};
+
+/// The metadata of the output an op would allocate. Strides are the
+/// contiguous strides of `sizes`; ops that produce non-contiguous outputs
+/// are not registered in this registry.
+struct CAFFE2_API InferredMeta {
+  std::vector<int64_t> sizes;
+  ScalarType dtype = ScalarType::Undefined;
+
+  std::vector<int64_t> strides() const;
+  int64_t numel() const;
+  /// Size in bytes of a contiguous allocation holding this output.
+  int64_t nbytes() const;
+};
+
+/// A shape function receives the tensor arguments' metadata in declaration
+/// order, followed by the op's integer and integer-list arguments flattened
+/// in declaration order (e.g. conv2d passes stride, padding, dilation,
+/// groups as seven ints). It throws c10::Error on invalid argument shapes,
+/// mirroring the checks of the op it describes.
+using shape_inference_fn =
+    InferredMeta (*)(ArrayRef<ShapeArg> args, ArrayRef<int64_t> int_args);
+
+CAFFE2_API void register_shape_inference_fn(
+    const std::string& name,
+    shape_inference_fn fn);
+CAFFE2_API bool has_shape_inference_fn(const std::string& name);
+
+/// Runs the registered shape function for `name`. Throws c10::Error when no
+/// function is registered; use has_shape_inference_fn to probe coverage.
+CAFFE2_API InferredMeta infer_output_meta(
+    const std::string& name,
+    ArrayRef<ShapeArg> args,
+    ArrayRef<int64_t> int_args = {});
+
+/// Registers `fn` under each listed name at static initialization time.
+struct CAFFE2_API ShapeInferenceRegisterer {
+  ShapeInferenceRegisterer(
+      std::initializer_list<const char*> names,
+      shape_inference_fn fn);
+};
+
+}} // namespace at::native
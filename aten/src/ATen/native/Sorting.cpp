@@ -1,6 +1,7 @@
 #include <ATen/native/Sorting.h>
 
 #include <ATen/ATen.h>
+#include <ATen/LegacyTHFunctionsCPU.h>
 #include <ATen/NumericUtils.h>
 #include <ATen/Parallel.h>
 #include <ATen/WrapDimUtils.h>
@@ -312,7 +313,51 @@ Tensor median_cpu(const Tensor& self) {
   return result.view({});
 }
 
+namespace {
+
+// The radix path only handles the flat contiguous integral case; anything
+// else (floating point, multi-dim sorts, strided outputs) keeps going
+// through the TH comparison sort. Small inputs are also left to TH, where
+// the O(k * n) histogram passes don't pay for themselves.
+bool should_use_radix_sort(const Tensor& self, int64_t dim) {
+  return self.dim() == 1 && dim == 0 && self.is_contiguous() &&
+      at::isIntegralType(self.scalar_type(), /*includeBool=*/false) &&
+      self.numel() >= 4096;
+}
+
+} // anonymous namespace
+
+std::tuple<Tensor&, Tensor&> sort_out_cpu(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    int64_t dim,
+    bool descending) {
+  int64_t wrapped_dim = maybe_wrap_dim(dim, self.dim(), /*wrap_scalar=*/true);
+  if (should_use_radix_sort(self, wrapped_dim)) {
+    values.resize_(self.sizes());
+    indices.resize_(self.sizes());
+    if (values.is_contiguous() && indices.is_contiguous()) {
+      values.copy_(self);
+      radix_sort_stub(kCPU, values, indices, descending);
+      return std::forward_as_tuple(values, indices);
+    }
+  }
+  return legacy::cpu::_th_sort_out(values, indices, self, dim, descending);
+}
+
+std::tuple<Tensor, Tensor> sort_cpu(
+    const Tensor& self,
+    int64_t dim,
+    bool descending) {
+  Tensor values = at::empty({0}, self.options());
+  Tensor indices = at::empty({0}, self.options().dtype(kLong));
+  sort_out_cpu(values, indices, self, dim, descending);
+  return std::make_tuple(values, indices);
+}
+
 DEFINE_DISPATCH(topk_stub);
+DEFINE_DISPATCH(radix_sort_stub);
 
 } // namespace native
 } // namespace at
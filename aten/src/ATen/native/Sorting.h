@@ -6,7 +6,9 @@
 namespace at { namespace native {
 
 using topk_fn = void(*)(Tensor&, Tensor&, const Tensor&, int64_t, int64_t, bool, bool);
+using radix_sort_fn = void(*)(Tensor& /*values*/, Tensor& /*indices*/, bool /*descending*/);
 
 DECLARE_DISPATCH(topk_fn, topk_stub);
+DECLARE_DISPATCH(radix_sort_fn, radix_sort_stub);
 
 }} // at::native
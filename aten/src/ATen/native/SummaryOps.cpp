@@ -2,14 +2,65 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 
 #include <tuple>
+#include <vector>
 
 namespace at { namespace native {
 
 ///////////////// bincount /////////////////
 namespace {
 
+// For histograms up to this many bins each thread fills a private copy that
+// is merged at the end; past it, the bin range is partitioned across threads
+// instead (each thread scans the whole input but only counts its own bins),
+// which needs no atomics and no threads-times-bins scratch memory.
+constexpr int64_t kMaxPrivateBins = 1 << 16;
+
+template <typename input_t, typename acc_t, typename weight_fn_t>
+void histogram_counts(
+    const input_t* self_p,
+    int64_t n,
+    acc_t* output_p,
+    int64_t nbins,
+    const weight_fn_t& weight_at) {
+  const int num_threads = at::get_num_threads();
+  if (n < at::internal::GRAIN_SIZE || num_threads == 1) {
+    for (int64_t i = 0; i < n; i++) {
+      output_p[self_p[i]] += weight_at(i);
+    }
+    return;
+  }
+  if (nbins <= kMaxPrivateBins) {
+    std::vector<acc_t> partials(num_threads * nbins, acc_t(0));
+    at::parallel_for(
+        0, n, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+          acc_t* hist = partials.data() + at::get_thread_num() * nbins;
+          for (int64_t i = begin; i < end; i++) {
+            hist[self_p[i]] += weight_at(i);
+          }
+        });
+    for (int t = 0; t < num_threads; t++) {
+      const acc_t* hist = partials.data() + t * nbins;
+      for (int64_t bin = 0; bin < nbins; bin++) {
+        output_p[bin] += hist[bin];
+      }
+    }
+  } else {
+    const int64_t bins_per_task = divup(nbins, num_threads);
+    at::parallel_for(
+        0, nbins, bins_per_task, [&](int64_t bin_begin, int64_t bin_end) {
+          for (int64_t i = 0; i < n; i++) {
+            const int64_t bin = static_cast<int64_t>(self_p[i]);
+            if (bin >= bin_begin && bin < bin_end) {
+              output_p[bin] += weight_at(i);
+            }
+          }
+        });
+  }
+}
+
 template <typename input_t, typename weights_t>
 Tensor _bincount_cpu_template(
     const Tensor& self,
@@ -39,15 +90,17 @@ Tensor _bincount_cpu_template(
     output = native::zeros({nbins}, weights.options());
     weights_t* output_p = output.data_ptr<weights_t>();
     const weights_t* weights_p = weights.data_ptr<weights_t>();
-    for (int64_t i = 0; i < self.size(0); i++) {
-      output_p[self_p[i]] += weights_p[i];
-    }
+    histogram_counts(
+        self_p, self.size(0), output_p, nbins, [weights_p](int64_t i) {
+          return weights_p[i];
+        });
   } else {
     output = native::zeros({nbins}, kLong);
     int64_t* output_p = output.data_ptr<int64_t>();
-    for (int64_t i = 0; i < self.size(0); i++) {
-      output_p[self_p[i]] += 1L;
-    }
+    histogram_counts(
+        self_p, self.size(0), output_p, nbins, [](int64_t /* i */) {
+          return static_cast<int64_t>(1);
+        });
   }
   return output;
 }
@@ -5,6 +5,7 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/ReduceOpsUtils.h>
 #include <c10/util/Exception.h>
+#include <ATen/native/cpu/MaskedOpsKernel.h>
 #include <ATen/native/cpu/TensorCompareKernel.h>
 #include <ATen/native/cpu/Loops.h>
 #include <ATen/NamedTensorUtils.h>
@@ -45,6 +46,7 @@ namespace at { namespace native {
 
 DEFINE_DISPATCH(max_kernel);
 DEFINE_DISPATCH(min_kernel);
+DEFINE_DISPATCH(where_fast_stub);
 
 bool allclose(const Tensor& self, const Tensor& other, double rtol, double atol, bool equal_nan) {
   return at::isclose(self, other, rtol, atol, equal_nan).all().item<uint8_t>();
@@ -135,6 +137,18 @@ std::vector<Tensor> where(const Tensor& condition) {
 
 Tensor _s_where_cpu(const Tensor& condition, const Tensor& self, const Tensor& other) {
   Tensor ret = at::empty(self.sizes(), self.options());
+  // Dense bool-mask select with equal shapes vectorizes with a blend per
+  // block; broadcasted (strided) operands and byte masks take the generic
+  // TensorIterator loop below.
+  if (condition.scalar_type() == ScalarType::Bool &&
+      (ret.scalar_type() == ScalarType::Float ||
+       ret.scalar_type() == ScalarType::Double) &&
+      condition.is_contiguous() && self.is_contiguous() &&
+      other.is_contiguous() && condition.sizes().equals(self.sizes()) &&
+      self.sizes().equals(other.sizes())) {
+    where_fast_stub(kCPU, ret, condition, self, other);
+    return ret;
+  }
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX(ret.scalar_type(), "where_cpu", [&] {
     where_cpu<scalar_t>(ret, condition, self, other);
   });
@@ -4,6 +4,7 @@
 #include <ATen/ExpandUtils.h>
 #include <ATen/Parallel.h>
 #include <ATen/core/EnableNamedTensor.h>
+#include <ATen/native/ScratchArena.h>
 #include <ATen/native/TypeProperties.h>
 
 namespace at {
@@ -137,16 +138,13 @@ static void validate_dtype(OperandInfo& op, ScalarType common_dtype, CommonDType
     // For binary_ops, we follow casting rules. For unary/nullary types
     // we require the type to match.
     if (op.is_output && check_output) {
-      if (!canCast(common_dtype, op.tensor.scalar_type()))
-      {
-        AT_ERROR("result type ", common_dtype,
+      TORCH_CHECK(canCast(common_dtype, op.tensor.scalar_type()),
+          "result type ", common_dtype,
           " can't be cast to the desired output type ",
           op.tensor.scalar_type());
-      }
-    }
-    if (!promoting && op.dtype != op.tensor.scalar_type()) {
-      AT_ERROR("expected dtype ", op.dtype, " but got dtype ", op.tensor.scalar_type());
     }
+    TORCH_CHECK(promoting || op.dtype == op.tensor.scalar_type(),
+        "expected dtype ", op.dtype, " but got dtype ", op.tensor.scalar_type());
   }
 }
 
@@ -158,8 +156,10 @@ static void maybe_copy_casting_to_common_dtype(OperandInfo& op, ScalarType commo
     if (!op.is_output) {
       op.tensor = op.tensor.to(common_dtype);
     } else {
-      op.tensor =
-          at::empty_like(op.tensor, op.tensor.options().dtype(common_dtype), LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+      // Output cast buffers only live until cast_outputs() copies them back,
+      // so rent them from the scratch arena instead of the allocator.
+      op.tensor = native::internal::rent_scratch_buffer(
+          op.tensor.sizes(), op.tensor.options().dtype(common_dtype));
     }
   }
 }
@@ -243,13 +243,13 @@ void TensorIterator::compute_types() {
 
     if (op.tensor.defined() && op.device != op.tensor.device()) {
       if (op.is_output) {
-        AT_ERROR("output with device ", op.tensor.device(),
-                  " doesn't match the desired device ", op.device);
+        TORCH_CHECK(false, "output with device ", op.tensor.device(),
+                    " doesn't match the desired device ", op.device);
       } else if (op.tensor.dim() == 0) {
         op.tensor = op.tensor.to(op.options());
       } else {
-        AT_ERROR("expected device ", op.device,
-                  " but got device ", op.tensor.device());
+        TORCH_CHECK(false, "expected device ", op.device,
+                    " but got device ", op.tensor.device());
       }
     }
   }
@@ -699,6 +699,53 @@ TensorIterator TensorIterator::unary_op(Tensor& out, const Tensor& a,
   return iter;
 }
 
+static void check_quantized_operand(const Tensor& t, const Tensor& out) {
+  TORCH_CHECK(t.is_quantized(), "expected a quantized tensor");
+  TORCH_CHECK(
+      t.qscheme() == kPerTensorAffine,
+      "quantized iteration only supports per tensor affine quantization");
+  TORCH_CHECK(
+      t.scalar_type() == out.scalar_type(),
+      "quantized operands must have the same dtype as the output");
+}
+
+TensorIterator TensorIterator::quantized_unary_op(Tensor& out, const Tensor& a) {
+  TORCH_INTERNAL_ASSERT(out.defined());
+  check_quantized_operand(out, out);
+  check_quantized_operand(a, out);
+  auto iter = TensorIterator();
+  iter.add_output(out);
+  iter.add_input(a);
+  iter.num_outputs_ = 1;
+  iter.resize_outputs_ = false;
+  iter.build();
+  for (auto& op : iter.operands_) {
+    iter.quant_params_.push_back(
+        {op.tensor.q_scale(), op.tensor.q_zero_point()});
+  }
+  return iter;
+}
+
+TensorIterator TensorIterator::quantized_binary_op(Tensor& out, const Tensor& a,
+    const Tensor& b) {
+  TORCH_INTERNAL_ASSERT(out.defined());
+  check_quantized_operand(out, out);
+  check_quantized_operand(a, out);
+  check_quantized_operand(b, out);
+  auto iter = TensorIterator();
+  iter.add_output(out);
+  iter.add_input(a);
+  iter.add_input(b);
+  iter.allow_cpu_scalars_ = true;
+  iter.resize_outputs_ = false;
+  iter.build();
+  for (auto& op : iter.operands_) {
+    iter.quant_params_.push_back(
+        {op.tensor.q_scale(), op.tensor.q_zero_point()});
+  }
+  return iter;
+}
+
 TensorIterator TensorIterator::nullary_op(Tensor& out) {
   auto iter = TensorIterator();
   iter.add_output(out);
@@ -821,10 +868,9 @@ void TensorIterator::compute_shape() {
         }
         continue;
       }
-      if (!is_reduction_) {
-        AT_ERROR("output with shape ", tensor.sizes(), " doesn't match the broadcast shape ",
-                 shape_);
-      }
+      TORCH_CHECK(is_reduction_,
+          "output with shape ", tensor.sizes(),
+          " doesn't match the broadcast shape ", shape_);
     }
   }
 }
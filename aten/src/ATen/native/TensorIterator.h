@@ -163,6 +163,16 @@ struct CAFFE2_API TensorIterator {
     bool check_mem_overlap = false);
   static TensorIterator unary_op(Tensor& out, const Tensor& a,
     bool check_mem_overlap = false);
+  // Variants for per-tensor affine quantized tensors. They validate that
+  // every operand is quantized with a compatible scheme and dtype, and
+  // capture each operand's scale/zero_point so requantizing loop helpers
+  // (see quantized/cpu/quantized_loops.h) can read them back through
+  // quant_params() without re-deriving them per kernel. The output must be
+  // allocated up front: it carries the target quantizer, which the
+  // iterator cannot infer.
+  static TensorIterator quantized_unary_op(Tensor& out, const Tensor& a);
+  static TensorIterator quantized_binary_op(Tensor& out, const Tensor& a,
+    const Tensor& b);
   static TensorIterator nullary_op(Tensor& out);
   static TensorIterator reduce_op(Tensor& out, const Tensor& a);
   static TensorIterator reduce_op(Tensor& out1, Tensor& out2, const Tensor& a);
@@ -202,6 +212,16 @@ struct CAFFE2_API TensorIterator {
   const Tensor& tensor(int arg) const { return operands_[arg].tensor; }
   Tensor& tensor(int arg) { return operands_[arg].tensor; }
 
+  /// Per-operand quantization parameters; only populated by the
+  /// quantized_*_op factories. Indexed like the other operand accessors
+  /// (outputs first).
+  struct QuantParams {
+    double scale;
+    int64_t zero_point;
+  };
+  const QuantParams& quant_params(int arg) const { return quant_params_[arg]; }
+  bool is_quantized() const { return !quant_params_.empty(); }
+
   Tensor output(int arg=0) const {
     AT_ASSERT(arg < num_outputs_);
     return operands_[arg].tensor;
@@ -362,6 +382,7 @@ protected:
   NameVector names_;
 #endif
   SmallVector<OperandInfo, 4> operands_;
+  SmallVector<QuantParams, 4> quant_params_;
   int num_outputs_ = 0;
   CommonDTypeStrategy common_dtype_strategy_ = CommonDTypeStrategy::CHECK;
   ScalarType common_dtype_ = ScalarType::Undefined;
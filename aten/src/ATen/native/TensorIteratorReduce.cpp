@@ -1,4 +1,5 @@
 #include <ATen/native/TensorIterator.h>
+#include <ATen/native/ScratchArena.h>
 #include <ATen/Parallel.h>
 #include <algorithm>
 #include <memory>
@@ -11,6 +12,8 @@ using loop2d_t = TensorIterator::loop2d_t;
 
 static bool use_two_pass_reduction(TensorIterator& iter);
 static void two_pass_reduction(TensorIterator& iter, loop2d_t loop);
+static bool use_contiguous_row_reduction(TensorIterator& iter);
+static void contiguous_row_reduction(TensorIterator& iter, loop2d_t loop);
 static void parallel_dim_reduction(TensorIterator& iter, loop2d_t loop);
 
 void TensorIterator::parallel_reduce(loop2d_t loop) {
@@ -21,6 +24,8 @@ void TensorIterator::parallel_reduce(loop2d_t loop) {
     serial_for_each(loop, {0, numel});
   } else if (use_two_pass_reduction(*this)) {
     two_pass_reduction(*this, loop);
+  } else if (use_contiguous_row_reduction(*this)) {
+    contiguous_row_reduction(*this, loop);
   } else {
     parallel_dim_reduction(*this, loop);
   }
@@ -36,12 +41,21 @@ static void two_pass_reduction(TensorIterator& iter, loop2d_t loop) {
   auto dst = iter.output(0);
   auto buffer_shape = DimVector(dst.sizes());
   buffer_shape.insert(buffer_shape.begin(), max_threads);
-  auto buffer = at::empty(buffer_shape, dst.options());
+  auto buffer = native::internal::rent_scratch_buffer(buffer_shape, dst.options());
 
   std::unique_ptr<bool[]> written(new bool[max_threads]);
   std::fill(written.get(), written.get() + max_threads, false);
 
-  at::parallel_for(0, iter.numel(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+  // Each task additionally pays for a copy of the destination and a scratch
+  // slice, so size chunks from the per-element cost rather than using the
+  // generic grain size; for cheap reductions this yields noticeably larger
+  // chunks and fewer buffer copies.
+  const int64_t grain_size = std::max(
+      internal::GRAIN_SIZE,
+      at::calc_grain_size(
+          iter.input(0).element_size(), /* flops_per_iter */ 1));
+
+  at::parallel_for(0, iter.numel(), grain_size, [&](int64_t begin, int64_t end) {
     int thread_num = at::get_thread_num();
     written[thread_num] = true;
     auto slice = buffer[thread_num];
@@ -63,6 +77,50 @@ static void two_pass_reduction(TensorIterator& iter, loop2d_t loop) {
   final_reduce.for_each(loop);
 }
 
+/// Fast path for the reductions common in inference workloads (softmax,
+/// layer norm): after dimension coalescing the iterator is 2-d, the reduced
+/// dimension is innermost and stride-1 in the input, and each output element
+/// consumes exactly one contiguous row of the input.
+static bool use_contiguous_row_reduction(TensorIterator& iter) {
+  if (iter.ndim() != 2 || !iter.is_dim_reduced(0) || iter.is_dim_reduced(1)) {
+    return false;
+  }
+  // The input must walk the reduced dimension contiguously (and the output
+  // must not move along it) so the loop sees a stride-1 inner dimension.
+  return iter.strides(1)[0] == iter.element_size(1) &&
+      iter.strides(0)[0] == 0;
+}
+
+/// Hands each thread its chunk of rows directly instead of constructing a
+/// narrowed TensorIterator per task, which re-runs the generic strided
+/// iteration machinery (get_strides/DimCounter/get_data_ptrs) for every
+/// 2-d tile. The loop is invoked once per chunk with a stride-1 inner
+/// dimension spanning the full row, which is exactly the layout the Vec256
+/// vectorized inner loops in native/cpu/Reduce.h specialize for.
+static void contiguous_row_reduction(TensorIterator& iter, loop2d_t loop) {
+  const int64_t row_size = iter.shape()[0];
+  const int64_t num_rows = iter.shape()[1];
+
+  // loop2d stride order: dim 0 for each tensor, then dim 1 for each tensor
+  const int64_t strides[] = {
+      iter.strides(0)[0],
+      iter.strides(1)[0],
+      iter.strides(0)[1],
+      iter.strides(1)[1]};
+
+  char* out_base = (char*)iter.data_ptr(0);
+  char* in_base = (char*)iter.data_ptr(1);
+
+  at::parallel_for(0, num_rows, 1, [&](int64_t begin, int64_t end) {
+    if (begin == end) {
+      return;
+    }
+    char* ptrs[] = {
+        out_base + begin * strides[2], in_base + begin * strides[3]};
+    loop(ptrs, strides, row_size, end - begin);
+  });
+}
+
 /// Chooses a dimension over which to parallelize. Prefers the outer-most
 /// dimension thats larger than the number of available threads.
 static int find_split_dim(TensorIterator& iter) {
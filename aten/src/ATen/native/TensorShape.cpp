@@ -1,7 +1,9 @@
 #include <TH/THTensor.hpp>
 #include <algorithm>
+#include <cstring>
 #include <vector>
 #include <ATen/ATen.h>
+#include <ATen/Parallel.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/InferSize.h>
 #include <ATen/NativeFunctions.h>
@@ -21,7 +23,7 @@ namespace native {
 
 Tensor _reshape_from_tensor(const Tensor& self, const Tensor& shape_tensor) {
   TORCH_CHECK(shape_tensor.dim() == 1);
-  std::vector<int64_t> shape;
+  DimVector shape;
   auto accessor = shape_tensor.accessor<int64_t, 1>();
   for (size_t i = 0; i < shape_tensor.numel(); ++i) {
     shape.push_back(accessor[i]);
@@ -58,6 +60,162 @@ static void check_cat_no_zero_dim(TensorList tensors) {
   }
 }
 
+// legacy _th_cat ignores 1-d empty tensors to support cat([x, torch.Tensor()])
+static bool cat_should_skip_tensor(const Tensor& t) {
+  return t.dim() == 1 && t.numel() == 0;
+}
+
+static bool can_use_parallel_cat(
+    TensorList tensors,
+    int64_t dim,
+    const Tensor& result) {
+  const Tensor* first = nullptr;
+  for (const Tensor& t : tensors) {
+    if (cat_should_skip_tensor(t)) {
+      continue;
+    }
+    if (t.layout() != kStrided || !t.device().is_cpu() || t.is_quantized() ||
+        !t.is_contiguous()) {
+      return false;
+    }
+    if (result.defined() && t.is_alias_of(result)) {
+      return false;
+    }
+    if (first == nullptr) {
+      if (dim >= t.dim()) {
+        return false;
+      }
+      first = &t;
+      continue;
+    }
+    if (t.scalar_type() != first->scalar_type() || t.dim() != first->dim()) {
+      return false;
+    }
+    // shape mismatches along other dimensions take the generic path so the
+    // usual error message is produced
+    for (int64_t d = 0; d < t.dim(); d++) {
+      if (d != dim && t.size(d) != first->size(d)) {
+        return false;
+      }
+    }
+  }
+  if (first == nullptr) {
+    return false;
+  }
+  if (result.defined() &&
+      (!result.device().is_cpu() || result.is_quantized() ||
+       result.scalar_type() != first->scalar_type())) {
+    return false;
+  }
+  return true;
+}
+
+// Cat of contiguous same-dtype CPU tensors reduces to moving bytes: each
+// participating input contributes one contiguous block per "outer" index
+// (the product of the output sizes before `dim`). For dim 0 there is a
+// single huge block per input, so the copy is chunked across threads with
+// each worker locating its byte range in a prefix sum over the inputs; for
+// inner dimensions the inputs are interleaved row by row, with each task
+// taking a block of rows so both the output and every input are walked
+// sequentially. Returns false (leaving any sizing to the caller's generic
+// path) when the inputs don't qualify.
+static bool fast_cat_out(Tensor& result, TensorList tensors, int64_t dim) {
+  if (!can_use_parallel_cat(tensors, dim, result)) {
+    return false;
+  }
+
+  std::vector<const Tensor*> inputs;
+  inputs.reserve(tensors.size());
+  for (const Tensor& t : tensors) {
+    if (!cat_should_skip_tensor(t)) {
+      inputs.push_back(&t);
+    }
+  }
+
+  const Tensor& first = *inputs[0];
+  auto sizes = first.sizes().vec();
+  int64_t cat_size = 0;
+  for (const Tensor* t : inputs) {
+    cat_size += t->size(dim);
+  }
+  sizes[dim] = cat_size;
+
+  if (!result.defined()) {
+    result = at::empty(sizes, first.options());
+  } else {
+    result.resize_(sizes);
+    if (!result.is_contiguous()) {
+      return false;
+    }
+  }
+  if (result.numel() == 0) {
+    return true;
+  }
+
+  const int64_t itemsize = result.element_size();
+  int64_t outer = 1;
+  for (int64_t d = 0; d < dim; d++) {
+    outer *= sizes[d];
+  }
+
+  const size_t n = inputs.size();
+  std::vector<char*> src(n);
+  std::vector<int64_t> inner_bytes(n); // bytes per outer index
+  for (size_t i = 0; i < n; i++) {
+    src[i] = (char*)inputs[i]->data_ptr();
+    inner_bytes[i] = inputs[i]->numel() / outer * itemsize;
+  }
+  char* dst = (char*)result.data_ptr();
+
+  if (outer == 1) {
+    // single block per input; split the blocks themselves across threads
+    std::vector<int64_t> prefix(n + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+      prefix[i + 1] = prefix[i] + inner_bytes[i];
+    }
+    const int64_t grain_bytes = at::calc_grain_size(/* bytes_per_iter */ 2, 0);
+    at::parallel_for(0, prefix[n], grain_bytes, [&](int64_t begin, int64_t end) {
+      size_t i =
+          std::upper_bound(prefix.begin() + 1, prefix.end(), begin) -
+          (prefix.begin() + 1);
+      int64_t pos = begin;
+      while (pos < end) {
+        const int64_t len = std::min(end, prefix[i + 1]) - pos;
+        if (len > 0) {
+          std::memcpy(dst + pos, src[i] + (pos - prefix[i]), len);
+        }
+        pos += len;
+        i++;
+      }
+    });
+    return true;
+  }
+
+  std::vector<int64_t> dst_offsets(n); // offset of each block in an output row
+  int64_t row_bytes = 0;
+  for (size_t i = 0; i < n; i++) {
+    dst_offsets[i] = row_bytes;
+    row_bytes += inner_bytes[i];
+  }
+
+  const int64_t grain_rows =
+      at::calc_grain_size(/* bytes_per_iter */ 2 * row_bytes, 0);
+  at::parallel_for(0, outer, grain_rows, [&](int64_t begin, int64_t end) {
+    for (int64_t row = begin; row < end; row++) {
+      char* dst_row = dst + row * row_bytes;
+      for (size_t i = 0; i < n; i++) {
+        if (inner_bytes[i] > 0) {
+          std::memcpy(
+              dst_row + dst_offsets[i],
+              src[i] + row * inner_bytes[i],
+              inner_bytes[i]);
+        }
+      }
+    }
+  });
+  return true;
+}
+
 Tensor & cat_out(Tensor & result, TensorList tensors, int64_t dim) {
   check_cat_no_zero_dim(tensors);
   dim = legacy_cat_wrap_dim(dim, tensors);
@@ -66,7 +224,9 @@ Tensor & cat_out(Tensor & result, TensorList tensors, int64_t dim) {
   {
     NoNamesGuard guard;
 #endif
-    at::_cat_out(result, tensors, dim);
+    if (!fast_cat_out(result, tensors, dim)) {
+      at::_cat_out(result, tensors, dim);
+    }
 #ifdef BUILD_NAMEDTENSOR
   }
   namedinference::propagate_names_if_nonempty(result, maybe_outnames);
@@ -221,7 +381,9 @@ Tensor cat(TensorList tensors, int64_t dim) {
 #ifdef BUILD_NAMEDTENSOR
     NoNamesGuard guard;
 #endif
-    result = at::_cat(tensors, dim);
+    if (!fast_cat_out(result, tensors, dim)) {
+      result = at::_cat(tensors, dim);
+    }
   }
 #ifdef BUILD_NAMEDTENSOR
   namedinference::propagate_names_if_nonempty(result, maybe_outnames);
@@ -329,9 +491,9 @@ Tensor expand(const Tensor& self, IntArrayRef size, bool implicit) {
            "must be greater or equal to the number of dimensions in the tensor (",
            self.dim(), ")");
 
-  std::vector<int64_t> expandedSizes;
-  std::vector<int64_t> expandedStrides;
-  std::tie(expandedSizes, expandedStrides) = inferExpandGeometry(self.sizes(), self.strides(), size);
+  DimVector expandedSizes;
+  DimVector expandedStrides;
+  std::tie(expandedSizes, expandedStrides) = inferExpandGeometry_dimvector(self.sizes(), self.strides(), size);
 
   auto result = self.as_strided(expandedSizes, expandedStrides);
 #ifdef BUILD_NAMEDTENSOR
@@ -387,7 +549,7 @@ Tensor narrow_copy_sparse(const Tensor& self, int64_t dim, int64_t start, int64_
   Tensor indices = self._indices();
   int64_t sparse_dim = self.sparse_dim();
 
-  std::vector<int64_t> new_sizes = self.sizes().vec();
+  DimVector new_sizes(self.sizes().begin(), self.sizes().end());
   new_sizes[dim] = length;
 
   Tensor new_values;
@@ -431,9 +593,9 @@ Tensor permute(const Tensor& self, IntArrayRef dims) {
            "number of dims don't match in permute");
   auto oldSizes = self.sizes();
   auto oldStrides = self.strides();
-  std::vector<int64_t> newSizes(nDims);
-  std::vector<int64_t> newStrides(nDims);
-  std::vector<bool> seen(nDims);
+  DimVector newSizes(nDims, 0);
+  DimVector newStrides(nDims, 0);
+  c10::SmallVector<bool, kDimVectorStaticSize> seen(nDims, false);
   for (int64_t i = 0; i < nDims; i++) {
     auto dim = maybe_wrap_dim(dims[i], nDims);
     TORCH_CHECK(!seen[dim],
@@ -453,9 +615,9 @@ Tensor repeat(const Tensor& self, IntArrayRef repeats) {
   // number of target dimensions is larger than the
   // number of source dimensions.
   int64_t num_new_dimensions = repeats.size() - self.dim();
-  std::vector<int64_t> padded_size(num_new_dimensions, 1);
+  DimVector padded_size(num_new_dimensions, 1);
   padded_size.insert(padded_size.end(), self.sizes().begin(), self.sizes().end());
-  std::vector<int64_t> target_size(repeats.size());
+  DimVector target_size(repeats.size());
   bool zero_tensor = false;
   for(size_t idx = 0; idx < repeats.size(); ++idx) {
     if (repeats[idx] == 0) {
@@ -486,9 +648,8 @@ Tensor repeat(const Tensor& self, IntArrayRef repeats) {
 }
 
 Tensor reshape(const Tensor& self, IntArrayRef proposed_shape) {
-  if (self.is_sparse()) {
-    AT_ERROR("reshape is not implemented for sparse tensors");
-  }
+  TORCH_CHECK(!self.is_sparse(),
+      "reshape is not implemented for sparse tensors");
   auto shape = infer_size(proposed_shape, self.numel());
 
   if (self.is_mkldnn()) {
@@ -904,10 +1065,10 @@ Tensor & t_(Tensor & self) {
   return self.transpose_(0, self.dim() < 2 ? 0 : 1);
 }
 
-std::tuple<std::vector<int64_t>, std::vector<int64_t> >
+static std::tuple<DimVector, DimVector>
 inferSqueezeGeometry(const Tensor &tensor) {
-  std::vector<int64_t> sizes;
-  std::vector<int64_t> strides;
+  DimVector sizes;
+  DimVector strides;
 
   for(int64_t d = 0; d < tensor.dim(); d++) {
     if(tensor.sizes()[d] != 1) {
@@ -919,10 +1080,10 @@ inferSqueezeGeometry(const Tensor &tensor) {
   return std::make_tuple(sizes, strides);
 }
 
-std::tuple<std::vector<int64_t>, std::vector<int64_t> >
+static std::tuple<DimVector, DimVector>
 inferSqueezeGeometry(const Tensor& tensor, int64_t dim) {
-  std::vector<int64_t> sizes;
-  std::vector<int64_t> strides;
+  DimVector sizes;
+  DimVector strides;
 
   for(int64_t d = 0; d < tensor.dim(); d++) {
     if(d != dim || tensor.sizes()[dim] != 1) {
@@ -933,10 +1094,10 @@ inferSqueezeGeometry(const Tensor& tensor, int64_t dim) {
   return std::make_tuple(sizes, strides);
 }
 
-std::tuple<std::vector<int64_t>, std::vector<int64_t> >
+static std::tuple<DimVector, DimVector>
 inferUnsqueezeGeometry(const Tensor& tensor, int64_t dim) {
-  auto sizes = tensor.sizes().vec();
-  auto strides = tensor.strides().vec();
+  DimVector sizes(tensor.sizes().begin(), tensor.sizes().end());
+  DimVector strides(tensor.strides().begin(), tensor.strides().end());
   int64_t new_stride = dim >= tensor.dim() ? 1 : sizes[dim] * strides[dim];
   sizes.insert(sizes.begin() + dim, 1);
   strides.insert(strides.begin() + dim, new_stride);
@@ -1041,7 +1202,7 @@ Tensor flatten(const Tensor& self, int64_t start_dim, int64_t end_dim) {
   start_dim = maybe_wrap_dim(start_dim, self.dim());
   end_dim = maybe_wrap_dim(end_dim, self.dim());
   TORCH_CHECK(start_dim <= end_dim, "flatten() has invalid args: start_dim cannot come after end_dim");
-  std::vector<int64_t> shape;
+  DimVector shape;
 
   if (self.dim() == 0) {
     return self.reshape({1});
@@ -1138,7 +1299,9 @@ std::vector<Tensor> meshgrid(TensorList tensors) {
       shape[i] = tensors[i].size(0);
       break;
     default:
-      AT_ERROR("Expected scalar or 1D tensor in the tensor list but got: ", tensors[i]);
+      TORCH_CHECK(false,
+          "Expected scalar or 1D tensor in the tensor list but got: ",
+          tensors[i]);
     }
   }
   for(int64_t i = 0; i < size - 1; i++){
@@ -1211,8 +1374,8 @@ Tensor unfold(const Tensor& self, int64_t dimension, int64_t size, int64_t step)
                                 " is ", max_size, " but size is ", size);
   TORCH_CHECK(step > 0, "step is ", step, " but must be > 0");
 
-  std::vector<int64_t> new_size(self.dim() + 1);
-  std::vector<int64_t> new_stride(self.dim() + 1);
+  DimVector new_size(self.dim() + 1, 0);
+  DimVector new_stride(self.dim() + 1, 0);
 
   new_size[self.dim()] = size;
   new_stride[self.dim()] = self.dim() == 0 ? 1 : self.stride(dimension);
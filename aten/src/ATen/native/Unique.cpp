@@ -2,7 +2,9 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 
+#include <cstring>
 #include <set>
 #include <tuple>
 #include <unordered_map>
@@ -13,6 +15,176 @@ namespace native{
 
 namespace {
 
+inline uint64_t unique_hash_mix(uint64_t x) {
+  // splitmix64 finalizer; spreads consecutive integer ids so linear
+  // probing doesn't degenerate into long runs.
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+template <typename scalar_t>
+inline uint64_t unique_hash(scalar_t v) {
+  if (v == scalar_t(0)) {
+    // canonicalize -0.0 so it shares a shard (and a slot) with +0.0
+    v = scalar_t(0);
+  }
+  uint64_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(v));
+  return unique_hash_mix(bits);
+}
+
+// Open-addressing table used by the parallel unique path below. Each
+// shard exclusively owns the values whose hash maps to it, so tables are
+// built without synchronization and merged by concatenation.
+template <typename scalar_t>
+struct UniqueShardTable {
+  void reserve(int64_t expected) {
+    int64_t capacity = 64;
+    while (capacity < expected * 2) {
+      capacity *= 2;
+    }
+    slots_.assign(capacity, 0);
+    mask_ = capacity - 1;
+  }
+
+  // Inserts (or revisits) a value, returning its dense id within this
+  // shard. Like std::unordered_set, values that don't compare equal to
+  // themselves (NaN) get a fresh entry on every insert.
+  int64_t insert(scalar_t key, uint64_t hash) {
+    if (static_cast<int64_t>(keys.size()) * 2 >=
+        static_cast<int64_t>(slots_.size())) {
+      grow();
+    }
+    uint64_t slot = hash & mask_;
+    while (slots_[slot] != 0) {
+      const int64_t id = slots_[slot] - 1;
+      if (keys[id] == key) {
+        counts[id]++;
+        return id;
+      }
+      slot = (slot + 1) & mask_;
+    }
+    keys.push_back(key);
+    counts.push_back(1);
+    hashes_.push_back(hash);
+    slots_[slot] = static_cast<int64_t>(keys.size());
+    return static_cast<int64_t>(keys.size()) - 1;
+  }
+
+  int64_t find(scalar_t key, uint64_t hash) const {
+    uint64_t slot = hash & mask_;
+    while (slots_[slot] != 0) {
+      const int64_t id = slots_[slot] - 1;
+      if (keys[id] == key) {
+        return id;
+      }
+      slot = (slot + 1) & mask_;
+    }
+    return -1;
+  }
+
+  std::vector<scalar_t> keys;
+  std::vector<int64_t> counts;
+
+ private:
+  void grow() {
+    slots_.assign(slots_.size() * 2, 0);
+    mask_ = slots_.size() - 1;
+    for (size_t id = 0; id < keys.size(); id++) {
+      uint64_t slot = hashes_[id] & mask_;
+      while (slots_[slot] != 0) {
+        slot = (slot + 1) & mask_;
+      }
+      slots_[slot] = static_cast<int64_t>(id) + 1;
+    }
+  }
+
+  std::vector<uint64_t> hashes_;
+  std::vector<int64_t> slots_;
+  uint64_t mask_ = 0;
+};
+
+// Hash-sharded unique for the sorted=false case. The input is sharded by
+// hash: every intra-op thread scans the input and inserts only the values
+// its shard owns, so there is no contention, and the merged output is the
+// shard tables concatenated in shard order. Unlike the single-threaded
+// std::unordered_set walk this is O(n) inserts spread across cores, at
+// the cost of each thread streaming over the input once.
+template <typename scalar_t>
+std::tuple<Tensor, Tensor, Tensor> unique_unsorted_parallel_cpu_template(
+    const Tensor& self,
+    const bool return_inverse,
+    const bool return_counts) {
+  const Tensor& input = self.contiguous();
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  const int64_t numel = input.numel();
+  const int64_t num_shards = at::get_num_threads();
+
+  std::vector<UniqueShardTable<scalar_t>> shards(num_shards);
+  at::parallel_for(0, num_shards, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t s = begin; s < end; s++) {
+      auto& table = shards[s];
+      table.reserve(std::max<int64_t>(numel / num_shards, 64));
+      for (int64_t i = 0; i < numel; i++) {
+        const uint64_t hash = unique_hash(input_data[i]);
+        if (static_cast<int64_t>(hash % num_shards) == s) {
+          table.insert(input_data[i], hash);
+        }
+      }
+    }
+  });
+
+  std::vector<int64_t> shard_offsets(num_shards + 1, 0);
+  for (int64_t s = 0; s < num_shards; s++) {
+    shard_offsets[s + 1] =
+        shard_offsets[s] + static_cast<int64_t>(shards[s].keys.size());
+  }
+  const int64_t num_unique = shard_offsets[num_shards];
+
+  Tensor output = at::empty({num_unique}, input.options());
+  Tensor inverse_indices = at::empty({0}, self.options().dtype(kLong));
+  Tensor counts = at::empty({0}, self.options().dtype(kLong));
+
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  int64_t* counts_data = nullptr;
+  if (return_counts) {
+    counts.resize_({num_unique});
+    counts_data = counts.data_ptr<int64_t>();
+  }
+  at::parallel_for(0, num_shards, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t s = begin; s < end; s++) {
+      std::copy(
+          shards[s].keys.begin(),
+          shards[s].keys.end(),
+          output_data + shard_offsets[s]);
+      if (counts_data != nullptr) {
+        std::copy(
+            shards[s].counts.begin(),
+            shards[s].counts.end(),
+            counts_data + shard_offsets[s]);
+      }
+    }
+  });
+
+  if (return_inverse) {
+    inverse_indices.resize_(input.sizes());
+    int64_t* inverse_data = inverse_indices.data_ptr<int64_t>();
+    at::parallel_for(0, numel, 2048, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const uint64_t hash = unique_hash(input_data[i]);
+        const int64_t s = static_cast<int64_t>(hash % num_shards);
+        const int64_t id = shards[s].find(input_data[i], hash);
+        // NaN never finds itself; map it to 0 like the unordered_map
+        // lookup in the sequential path does.
+        inverse_data[i] = id < 0 ? 0 : shard_offsets[s] + id;
+      }
+    });
+  }
+  return std::make_tuple(output, inverse_indices, counts);
+}
+
 template <typename scalar_t>
 std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
     const Tensor& self,
@@ -22,6 +194,15 @@ std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
   const Tensor& input = self.contiguous();
   const scalar_t* input_data = input.data_ptr<scalar_t>();
   int64_t numel = input.numel();
+
+  // Unsorted output has no ordering contract, so large inputs can go
+  // through the parallel hash-sharded engine instead of the sequential
+  // set walk below.
+  if (!sorted && numel >= 8192 && at::get_num_threads() > 1) {
+    return unique_unsorted_parallel_cpu_template<scalar_t>(
+        self, return_inverse, return_counts);
+  }
+
   Tensor output;
   Tensor inverse_indices = at::empty({0}, self.options().dtype(kLong));
   Tensor counts = at::empty({0}, self.options().dtype(kLong));
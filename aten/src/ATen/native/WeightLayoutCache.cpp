@@ -0,0 +1,89 @@
+#include <ATen/native/WeightLayoutCache.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace at {
+namespace native {
+
+namespace {
+
+struct CacheKey {
+  const void* storage;
+  std::string kind;
+
+  bool operator==(const CacheKey& other) const {
+    return storage == other.storage && kind == other.kind;
+  }
+};
+
+struct CacheKeyHash {
+  size_t operator()(const CacheKey& key) const {
+    return std::hash<const void*>()(key.storage) ^
+        (std::hash<std::string>()(key.kind) << 1);
+  }
+};
+
+struct CacheEntry {
+  // Owning reference to the source storage, so the key can never dangle or
+  // be reused by an unrelated tensor while the entry is alive.
+  Storage storage;
+  uint32_t version;
+  Tensor transformed;
+};
+
+// Bound the table so that a workload cycling through many distinct weights
+// cannot grow it without limit; in steady state the set of live weights is
+// far smaller than this.
+constexpr size_t kMaxEntries = 256;
+
+std::mutex cache_mutex;
+std::unordered_map<CacheKey, CacheEntry, CacheKeyHash>& cache() {
+  static auto* cache_ = new std::unordered_map<CacheKey, CacheEntry, CacheKeyHash>();
+  return *cache_;
+}
+
+} // namespace
+
+Tensor cached_weight_layout(
+    const Tensor& weight,
+    const std::string& kind,
+    const WeightTransform& transform) {
+  TORCH_CHECK(
+      weight.defined(), "cached_weight_layout: weight tensor is undefined");
+  const CacheKey key{weight.storage().unsafeGetStorageImpl(), kind};
+  const auto version =
+      weight.unsafeGetTensorImpl()->version_counter().current_version();
+
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache().find(key);
+    if (it != cache().end() && it->second.version == version) {
+      return it->second.transformed;
+    }
+  }
+
+  // Run the transform outside the lock; it may be arbitrarily expensive.
+  Tensor transformed = transform(weight);
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  if (cache().size() >= kMaxEntries && cache().find(key) == cache().end()) {
+    cache().clear();
+  }
+  cache()[key] = CacheEntry{weight.storage(), version, transformed};
+  return transformed;
+}
+
+void clear_weight_layout_cache() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  cache().clear();
+}
+
+size_t weight_layout_cache_size() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  return cache().size();
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+#include <functional>
+#include <string>
+
+namespace at {
+namespace native {
+
+// Note [Weight layout cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Several backends consume weights in a transformed layout (FBGEMM packed
+// matrices, MKL-DNN blocked formats, transposed copies for GEMM). Without a
+// place to keep the transformed copy, every consumer op recomputes it on
+// every call, even though the weights of an inference model never change.
+//
+// This is a process-wide side table keyed by the weight's storage and a
+// layout kind. A cached copy is invalidated when the weight is mutated in
+// place, observed through the tensor's version counter (which all autograd
+// views of the weight share). Mutations that bypass the version counter
+// (e.g. writing through an externally created alias of the same memory) are
+// not detected; callers with such aliasing must not use this cache.
+
+using WeightTransform = std::function<Tensor(const Tensor&)>;
+
+// Returns the transformed copy of `weight` for the layout identified by
+// `kind`, computing it with `transform` on the first call and serving the
+// cached copy on subsequent calls until `weight` is mutated in place.
+CAFFE2_API Tensor cached_weight_layout(
+    const Tensor& weight,
+    const std::string& kind,
+    const WeightTransform& transform);
+
+// Drops all cached layouts, releasing the memory they hold.
+CAFFE2_API void clear_weight_layout_cache();
+
+// The number of layouts currently cached. Mainly useful for tests.
+CAFFE2_API size_t weight_layout_cache_size();
+
+} // namespace native
+} // namespace at
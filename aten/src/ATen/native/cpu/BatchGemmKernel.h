@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+/*
+  Direct register-blocked kernel for batches of small GEMMs (bmm), where
+  per-call overhead of the blas path dominates.
+*/
+
+namespace at {
+namespace native {
+
+using batched_small_gemm_fn =
+    void (*)(Tensor & /*result*/, const Tensor & /*batch1*/, const Tensor & /*batch2*/);
+
+DECLARE_DISPATCH(batched_small_gemm_fn, batched_small_gemm_stub);
+
+}  // namespace native
+}  // namespace at
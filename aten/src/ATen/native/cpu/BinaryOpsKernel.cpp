@@ -206,8 +206,61 @@ void ge_kernel(TensorIterator& iter) {
   }
 }
 
+// Byte-equality masks (e.g. padding masks over tokenized uint8 buffers)
+// are hot in text preprocessing, and the generic bool-output comparison
+// path is scalar. When the bool output and uint8 inputs all advance
+// densely (the second input may also be a broadcast scalar), compare 32
+// bytes per step; any other layout takes the strided scalar loop.
+void byte_mask_kernel(TensorIterator& iter, bool invert) {
+  iter.for_each([&](char** data, const int64_t* strides, int64_t n) {
+    bool* dst = reinterpret_cast<bool*>(data[0]);
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(data[1]);
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(data[2]);
+    if (strides[0] == sizeof(bool) && strides[1] == sizeof(uint8_t) &&
+        (strides[2] == sizeof(uint8_t) || strides[2] == 0)) {
+      const bool scalar_b = strides[2] == 0;
+      int64_t i = 0;
+#ifdef __AVX2__
+      const __m256i ones = _mm256_set1_epi8(1);
+      __m256i vb = _mm256_setzero_si256();
+      if (scalar_b && n >= 32) {
+        vb = _mm256_set1_epi8(static_cast<char>(b[0]));
+      }
+      for (; i + 32 <= n; i += 32) {
+        const __m256i va =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        if (!scalar_b) {
+          vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        }
+        const __m256i eq = _mm256_cmpeq_epi8(va, vb);
+        // cmpeq lanes are 0xff/0x00; masks hold bool, so squash to 1/0.
+        const __m256i mask = invert ? _mm256_andnot_si256(eq, ones)
+                                    : _mm256_and_si256(eq, ones);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), mask);
+      }
+#endif
+      for (; i < n; ++i) {
+        const uint8_t rhs = scalar_b ? b[0] : b[i];
+        dst[i] = invert ? (a[i] != rhs) : (a[i] == rhs);
+      }
+    } else {
+      for (int64_t i = 0; i < n; ++i) {
+        const uint8_t lhs =
+            *reinterpret_cast<const uint8_t*>(data[1] + strides[1] * i);
+        const uint8_t rhs =
+            *reinterpret_cast<const uint8_t*>(data[2] + strides[2] * i);
+        *reinterpret_cast<bool*>(data[0] + strides[0] * i) =
+            invert ? (lhs != rhs) : (lhs == rhs);
+      }
+    }
+  });
+}
+
 void eq_kernel(TensorIterator& iter) {
   if (iter.dtype() == ScalarType::Bool) {
+    if (iter.input_dtype() == ScalarType::Byte) {
+      return byte_mask_kernel(iter, /*invert=*/false);
+    }
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kBool, kBFloat16, iter.input_dtype(), "eq_cpu", [&]() {
       cpu_kernel(iter,
        [=](scalar_t a, scalar_t b) -> bool {
@@ -226,6 +279,9 @@ void eq_kernel(TensorIterator& iter) {
 
 void ne_kernel(TensorIterator& iter) {
   if (iter.dtype() == ScalarType::Bool) {
+    if (iter.input_dtype() == ScalarType::Byte) {
+      return byte_mask_kernel(iter, /*invert=*/true);
+    }
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kBool, kBFloat16, iter.input_dtype(), "ne_cpu", [&]() {
       cpu_kernel(iter,
        [=](scalar_t a, scalar_t b) -> bool {
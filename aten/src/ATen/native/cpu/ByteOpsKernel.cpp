@@ -0,0 +1,65 @@
+#include <ATen/native/ByteOps.h>
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/intrinsics.h>
+
+namespace at {
+namespace native {
+namespace {
+
+#ifdef __AVX2__
+// Translate 32 bytes at a time through the full 256-entry table with
+// in-register shuffles. pshufb selects with the low nibble and zeroes any
+// lane whose MSB is set, so for each 16-entry slice of the table the input
+// is biased such that bytes whose high nibble addresses that slice keep
+// their low nibble with a clear MSB, while every other byte saturates into
+// the MSB and shuffles to zero; OR-ing the 16 slice results assembles the
+// translated vector.
+inline __m256i translate32(__m256i x, const __m128i* lut16) {
+  __m256i result = _mm256_setzero_si256();
+  for (int chunk = 0; chunk < 16; ++chunk) {
+    const __m256i table =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(lut16 + chunk));
+    const __m256i biased = _mm256_adds_epu8(
+        _mm256_xor_si256(x, _mm256_set1_epi8(static_cast<char>(chunk << 4))),
+        _mm256_set1_epi8(0x70));
+    result = _mm256_or_si256(result, _mm256_shuffle_epi8(table, biased));
+  }
+  return result;
+}
+#endif
+
+void byte_translate_kernel(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& table) {
+  const uint8_t* src = self.data_ptr<uint8_t>();
+  const uint8_t* lut = table.data_ptr<uint8_t>();
+  uint8_t* dst = result.data_ptr<uint8_t>();
+  at::parallel_for(
+      0,
+      self.numel(),
+      at::internal::GRAIN_SIZE,
+      [&](int64_t begin, int64_t end) {
+        int64_t i = begin;
+#ifdef __AVX2__
+        const __m128i* lut16 = reinterpret_cast<const __m128i*>(lut);
+        for (; i + 32 <= end; i += 32) {
+          const __m256i x =
+              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+          _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(dst + i), translate32(x, lut16));
+        }
+#endif
+        for (; i < end; ++i) {
+          dst[i] = lut[src[i]];
+        }
+      });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(byte_translate_stub, &byte_translate_kernel);
+
+} // namespace native
+} // namespace at
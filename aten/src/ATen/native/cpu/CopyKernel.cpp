@@ -1,15 +1,227 @@
 #include <ATen/ATen.h>
 
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <c10/util/TypeCast.h>
 
+#include <algorithm>
+
 namespace at {
 namespace native {
 namespace {
 
+// Tile edge for the blocked transpose copy. A 16x16 tile of floats is 1KB
+// read + 1KB written, comfortably inside L1 alongside the streams.
+constexpr int64_t kTransposeTileSize = 16;
+
+// Returns true if the (dim-coalesced) iterator describes a same-dtype 2-d
+// transposed copy: the output walks dim 0 contiguously while the input walks
+// dim 1 contiguously, the pattern produced by permute+copy_ (e.g.
+// NCHW <-> NHWC conversions).
+bool is_transpose_copy(TensorIterator& iter) {
+  if (iter.ndim() != 2 || iter.ntensors() != 2) {
+    return false;
+  }
+  if (iter.shape()[0] < kTransposeTileSize ||
+      iter.shape()[1] < kTransposeTileSize) {
+    return false;
+  }
+  const int64_t element_size = iter.element_size(0);
+  return iter.strides(0)[0] == element_size &&
+      iter.strides(0)[1] != element_size &&
+      iter.strides(1)[1] == element_size &&
+      iter.strides(1)[0] != element_size;
+}
+
+// Cache-blocked transpose: both the contiguous output runs and the strided
+// input reads of a tile stay resident, so each cache line of the input is
+// loaded once instead of once per element, which is what the generic strided
+// loop degenerates to on this pattern.
+template <typename scalar_t>
+void transpose_copy_kernel_impl(TensorIterator& iter) {
+  auto* out_base = static_cast<scalar_t*>(iter.data_ptr(0));
+  const auto* in_base = static_cast<const scalar_t*>(iter.data_ptr(1));
+  const int64_t n0 = iter.shape()[0];
+  const int64_t n1 = iter.shape()[1];
+  const int64_t out_stride1 = iter.strides(0)[1] / sizeof(scalar_t);
+  const int64_t in_stride0 = iter.strides(1)[0] / sizeof(scalar_t);
+
+  const int64_t grain = std::max(
+      at::internal::GRAIN_SIZE / std::max(n0, (int64_t)1), kTransposeTileSize);
+  at::parallel_for(0, n1, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t j0 = begin; j0 < end; j0 += kTransposeTileSize) {
+      const int64_t j1 = std::min(j0 + kTransposeTileSize, end);
+      for (int64_t i0 = 0; i0 < n0; i0 += kTransposeTileSize) {
+        const int64_t i1 = std::min(i0 + kTransposeTileSize, n0);
+        for (int64_t j = j0; j < j1; j++) {
+          scalar_t* out = out_base + j * out_stride1 + i0;
+          const scalar_t* in = in_base + i0 * in_stride0 + j;
+          for (int64_t i = 0; i < i1 - i0; i++) {
+            out[i] = in[i * in_stride0];
+          }
+        }
+      }
+    }
+  });
+}
+
+// Micro-tile edge of the in-register transpose kernel below.
+constexpr int64_t kTransposeMicroTile = 8;
+
+// Stop the cache-oblivious recursion once a block's source plus destination
+// footprint fits in half of a typical 32KB L1.
+constexpr int64_t kTransposeLeafBytes = 16 * 1024;
+
+#if defined(__AVX__) && !defined(_MSC_VER)
+// Transposes an 8x8 block of floats entirely in ymm registers: 8 contiguous
+// column loads, three rounds of shuffles, 8 contiguous row stores. src holds
+// the block column-major with leading dimension src_ld, dst receives it
+// row-major with leading dimension dst_ld.
+inline void transpose_micro_fp32(
+    const float* src, int64_t src_ld, float* dst, int64_t dst_ld) {
+  __m256 c0 = _mm256_loadu_ps(src + 0 * src_ld);
+  __m256 c1 = _mm256_loadu_ps(src + 1 * src_ld);
+  __m256 c2 = _mm256_loadu_ps(src + 2 * src_ld);
+  __m256 c3 = _mm256_loadu_ps(src + 3 * src_ld);
+  __m256 c4 = _mm256_loadu_ps(src + 4 * src_ld);
+  __m256 c5 = _mm256_loadu_ps(src + 5 * src_ld);
+  __m256 c6 = _mm256_loadu_ps(src + 6 * src_ld);
+  __m256 c7 = _mm256_loadu_ps(src + 7 * src_ld);
+  __m256 t0 = _mm256_unpacklo_ps(c0, c1);
+  __m256 t1 = _mm256_unpackhi_ps(c0, c1);
+  __m256 t2 = _mm256_unpacklo_ps(c2, c3);
+  __m256 t3 = _mm256_unpackhi_ps(c2, c3);
+  __m256 t4 = _mm256_unpacklo_ps(c4, c5);
+  __m256 t5 = _mm256_unpackhi_ps(c4, c5);
+  __m256 t6 = _mm256_unpacklo_ps(c6, c7);
+  __m256 t7 = _mm256_unpackhi_ps(c6, c7);
+  __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+  _mm256_storeu_ps(dst + 0 * dst_ld, _mm256_permute2f128_ps(s0, s4, 0x20));
+  _mm256_storeu_ps(dst + 1 * dst_ld, _mm256_permute2f128_ps(s1, s5, 0x20));
+  _mm256_storeu_ps(dst + 2 * dst_ld, _mm256_permute2f128_ps(s2, s6, 0x20));
+  _mm256_storeu_ps(dst + 3 * dst_ld, _mm256_permute2f128_ps(s3, s7, 0x20));
+  _mm256_storeu_ps(dst + 4 * dst_ld, _mm256_permute2f128_ps(s0, s4, 0x31));
+  _mm256_storeu_ps(dst + 5 * dst_ld, _mm256_permute2f128_ps(s1, s5, 0x31));
+  _mm256_storeu_ps(dst + 6 * dst_ld, _mm256_permute2f128_ps(s2, s6, 0x31));
+  _mm256_storeu_ps(dst + 7 * dst_ld, _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+#endif
+
+// Scalar transpose of an nr x nc block; the leaf is small enough that both
+// streams are L1-resident, so the strided side is cheap.
+template <typename scalar_t>
+void transpose_leaf_scalar(
+    const scalar_t* src, int64_t src_ld,
+    scalar_t* dst, int64_t dst_ld,
+    int64_t nr, int64_t nc) {
+  for (int64_t c = 0; c < nc; c++) {
+    const scalar_t* s = src + c * src_ld;
+    scalar_t* d = dst + c;
+    for (int64_t r = 0; r < nr; r++) {
+      d[r * dst_ld] = s[r];
+    }
+  }
+}
+
+template <typename scalar_t>
+void transpose_leaf(
+    const scalar_t* src, int64_t src_ld,
+    scalar_t* dst, int64_t dst_ld,
+    int64_t nr, int64_t nc) {
+  transpose_leaf_scalar(src, src_ld, dst, dst_ld, nr, nc);
+}
+
+// float leaf: cover the block with 8x8 in-register transposes, then finish
+// the right and bottom fringes with the scalar loop.
+inline void transpose_leaf(
+    const float* src, int64_t src_ld,
+    float* dst, int64_t dst_ld,
+    int64_t nr, int64_t nc) {
+#if defined(__AVX__) && !defined(_MSC_VER)
+  const int64_t nr8 = nr - nr % kTransposeMicroTile;
+  const int64_t nc8 = nc - nc % kTransposeMicroTile;
+  for (int64_t r = 0; r < nr8; r += kTransposeMicroTile) {
+    for (int64_t c = 0; c < nc8; c += kTransposeMicroTile) {
+      transpose_micro_fp32(
+          src + r + c * src_ld, src_ld, dst + c + r * dst_ld, dst_ld);
+    }
+  }
+  if (nc8 < nc) {
+    transpose_leaf_scalar(
+        src + nc8 * src_ld, src_ld, dst + nc8, dst_ld, nr8, nc - nc8);
+  }
+  if (nr8 < nr) {
+    transpose_leaf_scalar(
+        src + nr8, src_ld, dst + nr8 * dst_ld, dst_ld, nr - nr8, nc);
+  }
+#else
+  transpose_leaf_scalar(src, src_ld, dst, dst_ld, nr, nc);
+#endif
+}
+
+// Cache-oblivious recursion: halve the longer edge (split points snapped to
+// the micro-tile so full tiles never straddle a cut) until the block fits in
+// L1, then hand it to the leaf. Each level of the recursion blocks for the
+// next level of the cache hierarchy without per-level tile tuning.
+template <typename scalar_t>
+void transpose_copy_rec(
+    const scalar_t* src, int64_t src_ld,
+    scalar_t* dst, int64_t dst_ld,
+    int64_t nr, int64_t nc) {
+  if (2 * nr * nc * (int64_t)sizeof(scalar_t) > kTransposeLeafBytes &&
+      (nr > kTransposeMicroTile || nc > kTransposeMicroTile)) {
+    if (nr >= nc) {
+      int64_t half = nr / 2;
+      if (half >= kTransposeMicroTile) {
+        half -= half % kTransposeMicroTile;
+      }
+      transpose_copy_rec(src, src_ld, dst, dst_ld, half, nc);
+      transpose_copy_rec(
+          src + half, src_ld, dst + half * dst_ld, dst_ld, nr - half, nc);
+    } else {
+      int64_t half = nc / 2;
+      if (half >= kTransposeMicroTile) {
+        half -= half % kTransposeMicroTile;
+      }
+      transpose_copy_rec(src, src_ld, dst, dst_ld, nr, half);
+      transpose_copy_rec(
+          src + half * src_ld, src_ld, dst + half, dst_ld, nr, nc - half);
+    }
+    return;
+  }
+  transpose_leaf(src, src_ld, dst, dst_ld, nr, nc);
+}
+
+// Out-of-place transpose for the pure 2-d case caught in Copy.cpp: self is
+// contiguous, src is column-major with the same dtype. Parallelized over
+// bands of destination rows; each band recurses independently.
+static void transpose_copy_same_type_kernel(Tensor& self, const Tensor& src) {
+  AT_DISPATCH_ALL_TYPES_AND3(
+      kHalf, kBool, kBFloat16, self.scalar_type(), "transpose_copy", [&] {
+        const scalar_t* sp = src.data_ptr<scalar_t>();
+        scalar_t* rp = self.data_ptr<scalar_t>();
+        const int64_t NR = src.size(0);
+        const int64_t NC = src.size(1);
+        const int64_t grain = std::max(
+            at::internal::GRAIN_SIZE / std::max(NC, (int64_t)1),
+            kTransposeMicroTile);
+        at::parallel_for(0, NR, grain, [&](int64_t begin, int64_t end) {
+          transpose_copy_rec(
+              sp + begin, NR, rp + begin * NC, NC, end - begin, NC);
+        });
+      });
+}
+
 static void copy_kernel(TensorIterator& iter, bool non_blocking) {
   ScalarType dtype = iter.dtype(0);
   if (dtype == iter.dtype(1)) {
@@ -29,6 +241,11 @@ static void copy_kernel(TensorIterator& iter, bool non_blocking) {
             iter,
             [=](scalar_t a) -> scalar_t { return a; });
         });
+    } else if (is_transpose_copy(iter)) {
+      AT_DISPATCH_ALL_TYPES_AND(
+          ScalarType::Bool, dtype, "transpose_copy_kernel", [&] {
+            transpose_copy_kernel_impl<scalar_t>(iter);
+          });
     } else {
       AT_DISPATCH_ALL_TYPES_AND(
           ScalarType::Bool, dtype, "copy_kernel", [&] {
@@ -51,6 +268,8 @@ static void copy_kernel(TensorIterator& iter, bool non_blocking) {
 } // anonymous namespace
 
 REGISTER_DISPATCH(copy_stub, &copy_kernel);
+REGISTER_DISPATCH(
+    transpose_copy_same_type_stub, &transpose_copy_same_type_kernel);
 
 } // namespace native
 } // namespace at
@@ -0,0 +1,285 @@
+#include <ATen/native/cpu/CrossEntropyLossKernel.h>
+
+#include <cmath>
+#include <utility>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/TensorUtils.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at {
+namespace native {
+namespace {
+
+// Fused log-softmax + negative log likelihood over the rows of a dense 2-d
+// input. Computing the loss directly from the logits needs only the row
+// maximum and the log of the sum of exponentials, so unlike the
+// log_softmax + nll_loss composition it never materializes the
+// [batch, n_classes] log-probability tensor -- for large vocabularies the
+// logits are streamed through once in the forward and once in the backward.
+
+template <typename scalar_t>
+inline scalar_t row_max(scalar_t* row, int64_t n_classes) {
+  using Vec = vec256::Vec256<scalar_t>;
+  return vec256::reduce_all<scalar_t>(
+      [](Vec& x, Vec& y) { return vec256::maximum(x, y); }, row, n_classes);
+}
+
+template <typename scalar_t>
+inline scalar_t row_sum_exp(scalar_t* row, scalar_t max_input, int64_t n_classes) {
+  using Vec = vec256::Vec256<scalar_t>;
+  return vec256::map_reduce_all<scalar_t>(
+      [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+      [](Vec x, Vec y) { return x + y; },
+      row,
+      n_classes);
+}
+
+template <typename scalar_t>
+static void cross_entropy_loss_forward_frame(
+    Tensor& output,
+    Tensor& total_weight,
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  const int64_t batch_size = input.size(0);
+  const int64_t n_classes = input.size(1);
+
+  scalar_t* input_data = input.data_ptr<scalar_t>();
+  const int64_t* target_data = target.data_ptr<int64_t>();
+  const scalar_t* weight_data =
+      weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
+
+  scalar_t* total_weight_data = total_weight.data_ptr<scalar_t>();
+  *total_weight_data = 0;
+
+  // Each row reads n_classes elements twice (max, then sum of exp).
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * n_classes);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  if (reduction == Reduction::None) {
+    output.resize_({batch_size});
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+
+    at::parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const auto cur_target = target_data[i];
+        if (cur_target == ignore_index) {
+          output_data[i] = 0;
+          continue;
+        }
+        TORCH_CHECK_INDEX(
+            cur_target >= 0 && cur_target < n_classes,
+            "Target ",
+            cur_target,
+            " is out of bounds.");
+
+        scalar_t* row = input_data + i * n_classes;
+        const scalar_t max_input = row_max(row, n_classes);
+        const scalar_t sum_exp = row_sum_exp(row, max_input, n_classes);
+        const scalar_t cur_weight =
+            weight_data != nullptr ? weight_data[cur_target]
+                                   : static_cast<scalar_t>(1);
+        output_data[i] =
+            cur_weight * (max_input + std::log(sum_exp) - row[cur_target]);
+      }
+    });
+    return;
+  }
+
+  output.resize_({});
+
+  // first: sum of per-row losses, second: sum of target weights
+  using partial_t = std::pair<scalar_t, scalar_t>;
+  const auto partial = at::parallel_reduce(
+      0,
+      batch_size,
+      grain_size,
+      partial_t(0, 0),
+      [&](int64_t begin, int64_t end, partial_t ident) -> partial_t {
+        for (int64_t i = begin; i < end; i++) {
+          const auto cur_target = target_data[i];
+          if (cur_target == ignore_index) {
+            continue;
+          }
+          TORCH_CHECK_INDEX(
+              cur_target >= 0 && cur_target < n_classes,
+              "Target ",
+              cur_target,
+              " is out of bounds.");
+
+          scalar_t* row = input_data + i * n_classes;
+          const scalar_t max_input = row_max(row, n_classes);
+          const scalar_t sum_exp = row_sum_exp(row, max_input, n_classes);
+          const scalar_t cur_weight =
+              weight_data != nullptr ? weight_data[cur_target]
+                                     : static_cast<scalar_t>(1);
+          ident.first +=
+              cur_weight * (max_input + std::log(sum_exp) - row[cur_target]);
+          ident.second += cur_weight;
+        }
+        return ident;
+      },
+      [](partial_t x, partial_t y) -> partial_t {
+        return partial_t(x.first + y.first, x.second + y.second);
+      });
+
+  scalar_t output_val = partial.first;
+  const scalar_t total_weight_val = partial.second;
+
+  if (reduction == Reduction::Mean &&
+      (total_weight_val != 0 || input.numel() == 0)) {
+    // allow NaN result for total_weight_val == 0 case, see #15870
+    output_val /= total_weight_val;
+  }
+
+  *output.data_ptr<scalar_t>() = output_val;
+  *total_weight_data = total_weight_val;
+}
+
+template <typename scalar_t>
+static void cross_entropy_loss_backward_frame(
+    Tensor& grad_input,
+    const Tensor& grad_output,
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index,
+    const Tensor& total_weight) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const int64_t batch_size = input.size(0);
+  const int64_t n_classes = input.size(1);
+
+  scalar_t* grad_input_data = grad_input.data_ptr<scalar_t>();
+  scalar_t* input_data = input.data_ptr<scalar_t>();
+  const int64_t* target_data = target.data_ptr<int64_t>();
+  const scalar_t* weight_data =
+      weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
+
+  const scalar_t* grad_output_data = nullptr;
+  scalar_t grad_output_value = 0;
+  if (reduction == Reduction::None) {
+    check_dim_size(grad_output, 1, 0, batch_size);
+    grad_output_data = grad_output.data_ptr<scalar_t>();
+  } else {
+    TORCH_CHECK(
+        grad_output.dim() <= 1 && grad_output.numel() == 1,
+        "Expected a single element grad_output tensor, but got: ",
+        grad_output.sizes());
+    grad_output_value = *grad_output.data_ptr<scalar_t>();
+    if (reduction == Reduction::Mean) {
+      const scalar_t total_weight_value = *total_weight.data_ptr<scalar_t>();
+      if (total_weight_value <= 0) {
+        return;
+      }
+      grad_output_value /= total_weight_value;
+    }
+  }
+
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * n_classes);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  at::parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const auto cur_target = target_data[i];
+      if (cur_target == ignore_index) {
+        continue;
+      }
+      TORCH_CHECK_INDEX(
+          cur_target >= 0 && cur_target < n_classes,
+          "Target ",
+          cur_target,
+          " is out of bounds.");
+
+      const scalar_t w = weight_data != nullptr ? weight_data[cur_target]
+                                                : static_cast<scalar_t>(1);
+      const scalar_t k =
+          w * (reduction == Reduction::None ? grad_output_data[i]
+                                            : grad_output_value);
+
+      // d loss_i / d x_ij = k * (softmax(x_i)_j - delta_{j,target_i}); the
+      // softmax is recomputed from the logits instead of being saved.
+      scalar_t* row = input_data + i * n_classes;
+      scalar_t* grad_row = grad_input_data + i * n_classes;
+      const scalar_t max_input = row_max(row, n_classes);
+      const scalar_t scale = k / row_sum_exp(row, max_input, n_classes);
+      vec256::map(
+          [max_input, scale](Vec x) {
+            return (x - Vec(max_input)).exp() * Vec(scale);
+          },
+          grad_row,
+          row,
+          n_classes);
+      grad_row[cur_target] -= k;
+    }
+  });
+}
+
+static void cross_entropy_loss_forward_kernel_impl(
+    Tensor& output,
+    Tensor& total_weight,
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  auto input_contiguous = self.contiguous();
+  auto target_contiguous = target.contiguous();
+  auto weight_contiguous = weight.defined() ? weight.contiguous() : weight;
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "cross_entropy_loss_forward", [&] {
+        cross_entropy_loss_forward_frame<scalar_t>(
+            output,
+            total_weight,
+            input_contiguous,
+            target_contiguous,
+            weight_contiguous,
+            reduction,
+            ignore_index);
+      });
+}
+
+static void cross_entropy_loss_backward_kernel_impl(
+    Tensor& grad_input,
+    const Tensor& grad_output,
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index,
+    const Tensor& total_weight) {
+  auto grad_output_contiguous = grad_output.contiguous();
+  auto input_contiguous = self.contiguous();
+  auto target_contiguous = target.contiguous();
+  auto weight_contiguous = weight.defined() ? weight.contiguous() : weight;
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "cross_entropy_loss_backward", [&] {
+        cross_entropy_loss_backward_frame<scalar_t>(
+            grad_input,
+            grad_output_contiguous,
+            input_contiguous,
+            target_contiguous,
+            weight_contiguous,
+            reduction,
+            ignore_index,
+            total_weight);
+      });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(
+    cross_entropy_loss_forward_kernel,
+    &cross_entropy_loss_forward_kernel_impl);
+REGISTER_DISPATCH(
+    cross_entropy_loss_backward_kernel,
+    &cross_entropy_loss_backward_kernel_impl);
+
+}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+using cross_entropy_forward_fn = void(*)(
+    Tensor&, Tensor&, const Tensor&, const Tensor&, const Tensor&,
+    int64_t, int64_t);
+using cross_entropy_backward_fn = void(*)(
+    Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&,
+    int64_t, int64_t, const Tensor&);
+
+DECLARE_DISPATCH(cross_entropy_forward_fn, cross_entropy_loss_forward_kernel);
+DECLARE_DISPATCH(cross_entropy_backward_fn, cross_entropy_loss_backward_kernel);
+
+}
+}
@@ -0,0 +1,175 @@
+#include <ATen/native/cpu/DepthwiseSeparableConvKernel.h>
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+Tensor _conv_depthwise_separable3x3_impl(
+    const Tensor& input,
+    const Tensor& depthwise_weight,
+    const Tensor& depthwise_bias,
+    const Tensor& pointwise_weight,
+    const Tensor& pointwise_bias,
+    IntArrayRef stride,
+    IntArrayRef padding) {
+  using Vec = vec256::Vec256<float>;
+
+  TORCH_CHECK(
+      input.ndimension() == 4,
+      "conv_depthwise_separable3x3: expected 4d input");
+  TORCH_CHECK(
+      input.scalar_type() == kFloat &&
+          depthwise_weight.scalar_type() == kFloat &&
+          pointwise_weight.scalar_type() == kFloat,
+      "conv_depthwise_separable3x3: only float is supported");
+
+  const int64_t batch = input.size(0);
+  const int64_t channels = input.size(1);
+  const int64_t in_rows = input.size(2);
+  const int64_t in_cols = input.size(3);
+  TORCH_CHECK(
+      depthwise_weight.ndimension() == 4 &&
+          depthwise_weight.size(0) == channels &&
+          depthwise_weight.size(1) == 1 && depthwise_weight.size(2) == 3 &&
+          depthwise_weight.size(3) == 3,
+      "conv_depthwise_separable3x3: expected depthwise weight of shape [",
+      channels,
+      ", 1, 3, 3]");
+  TORCH_CHECK(
+      pointwise_weight.ndimension() == 4 &&
+          pointwise_weight.size(1) == channels &&
+          pointwise_weight.size(2) == 1 && pointwise_weight.size(3) == 1,
+      "conv_depthwise_separable3x3: expected pointwise weight of shape [C_out, ",
+      channels,
+      ", 1, 1]");
+  const int64_t out_channels = pointwise_weight.size(0);
+  const int64_t stride_h = stride[0];
+  const int64_t stride_w = stride[1];
+  const int64_t pad_h = padding[0];
+  const int64_t pad_w = padding[1];
+  const int64_t out_rows = (in_rows + 2 * pad_h - 3) / stride_h + 1;
+  const int64_t out_cols = (in_cols + 2 * pad_w - 3) / stride_w + 1;
+  TORCH_CHECK(
+      out_rows >= 1 && out_cols >= 1,
+      "conv_depthwise_separable3x3: kernel larger than padded input");
+
+  // Channels rounded up to the vector width on both sides of the block; the
+  // padded lanes carry zero weights and bias, and are sliced away at the end.
+  const int64_t c_padded =
+      (channels + Vec::size() - 1) / Vec::size() * Vec::size();
+  const int64_t oc_padded =
+      (out_channels + Vec::size() - 1) / Vec::size() * Vec::size();
+
+  // Repack into channels-last, as in DirectConv2dKernel: input as
+  // [batch][h][w][c], depthwise weight as [kh][kw][c], pointwise weight as
+  // [c][oc], so both inner loops run unit-stride over the vectorized index.
+  Tensor input_packed =
+      at::zeros({batch, in_rows, in_cols, c_padded}, input.options());
+  input_packed.narrow(3, 0, channels).copy_(input.permute({0, 2, 3, 1}));
+  Tensor dw_weight_packed = at::zeros({3, 3, c_padded}, input.options());
+  dw_weight_packed.narrow(2, 0, channels)
+      .copy_(depthwise_weight.reshape({channels, 3, 3}).permute({1, 2, 0}));
+  Tensor dw_bias_packed = at::zeros({c_padded}, input.options());
+  if (depthwise_bias.defined()) {
+    dw_bias_packed.narrow(0, 0, channels).copy_(depthwise_bias);
+  }
+  Tensor pw_weight_packed =
+      at::zeros({c_padded, oc_padded}, input.options());
+  pw_weight_packed.narrow(0, 0, channels)
+      .narrow(1, 0, out_channels)
+      .copy_(pointwise_weight.reshape({out_channels, channels}).t());
+  Tensor pw_bias_packed = at::zeros({oc_padded}, input.options());
+  if (pointwise_bias.defined()) {
+    pw_bias_packed.narrow(0, 0, out_channels).copy_(pointwise_bias);
+  }
+  Tensor output_packed =
+      at::empty({batch, out_rows, out_cols, oc_padded}, input.options());
+
+  const float* in_data = input_packed.data_ptr<float>();
+  const float* dw_w_data = dw_weight_packed.data_ptr<float>();
+  const float* dw_b_data = dw_bias_packed.data_ptr<float>();
+  const float* pw_w_data = pw_weight_packed.data_ptr<float>();
+  const float* pw_b_data = pw_bias_packed.data_ptr<float>();
+  float* out_data = output_packed.data_ptr<float>();
+
+  const int64_t work_per_row =
+      out_cols * (9 * c_padded + channels * oc_padded);
+  const int64_t grain = std::max<int64_t>(
+      1, at::internal::GRAIN_SIZE / std::max<int64_t>(work_per_row, 1));
+
+  at::parallel_for(
+      0, batch * out_rows, grain, [&](int64_t begin, int64_t end) {
+        // Depthwise output for one row of output pixels, [out_cols][c].
+        // This is the only intermediate; it is written and consumed while
+        // still in cache.
+        std::vector<float> row_buf(out_cols * c_padded);
+        for (int64_t index = begin; index < end; ++index) {
+          const int64_t n = index / out_rows;
+          const int64_t oy = index % out_rows;
+          const float* in_n = in_data + n * in_rows * in_cols * c_padded;
+
+          // Depthwise pass over the row.
+          for (int64_t ox = 0; ox < out_cols; ++ox) {
+            float* dw_px = row_buf.data() + ox * c_padded;
+            for (int64_t cb = 0; cb < c_padded; cb += Vec::size()) {
+              Vec acc = Vec::loadu(dw_b_data + cb);
+              for (int64_t ky = 0; ky < 3; ++ky) {
+                const int64_t iy = oy * stride_h - pad_h + ky;
+                if (iy < 0 || iy >= in_rows) {
+                  continue;
+                }
+                for (int64_t kx = 0; kx < 3; ++kx) {
+                  const int64_t ix = ox * stride_w - pad_w + kx;
+                  if (ix < 0 || ix >= in_cols) {
+                    continue;
+                  }
+                  acc = vec256::fmadd(
+                      Vec::loadu(in_n + (iy * in_cols + ix) * c_padded + cb),
+                      Vec::loadu(dw_w_data + (ky * 3 + kx) * c_padded + cb),
+                      acc);
+                }
+              }
+              acc.store(dw_px + cb);
+            }
+          }
+
+          // Pointwise pass, consuming the row while it is hot.
+          float* out_row =
+              out_data + (n * out_rows + oy) * out_cols * oc_padded;
+          for (int64_t ox = 0; ox < out_cols; ++ox) {
+            const float* dw_px = row_buf.data() + ox * c_padded;
+            float* out_px = out_row + ox * oc_padded;
+            for (int64_t ocb = 0; ocb < oc_padded; ocb += Vec::size()) {
+              Vec acc = Vec::loadu(pw_b_data + ocb);
+              // Padded input channels hold zeros, so stop at `channels`.
+              for (int64_t c = 0; c < channels; ++c) {
+                acc = vec256::fmadd(
+                    Vec::loadu(pw_w_data + c * oc_padded + ocb),
+                    Vec(dw_px[c]),
+                    acc);
+              }
+              acc.store(out_px + ocb);
+            }
+          }
+        }
+      });
+
+  return output_packed.narrow(3, 0, out_channels)
+      .permute({0, 3, 1, 2})
+      .contiguous();
+}
+
+} // namespace
+
+REGISTER_DISPATCH(
+    conv_depthwise_separable3x3_stub,
+    &_conv_depthwise_separable3x3_impl);
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+/*
+  Fused depthwise (3x3) + pointwise (1x1) convolution block.
+
+  Run separately, the pointwise conv of a MobileNet-style block re-reads
+  the entire depthwise output from memory. This kernel computes the
+  depthwise result one output row at a time into a small channels-last
+  scratch buffer and immediately consumes it for the 1x1 conv while it
+  is still in L1, so the intermediate feature map never exists in full.
+*/
+
+namespace at {
+namespace native {
+
+using conv_depthwise_separable3x3_fn = Tensor (*)(
+    const Tensor& /* input */,
+    const Tensor& /* depthwise_weight */,
+    const Tensor& /* depthwise_bias */,
+    const Tensor& /* pointwise_weight */,
+    const Tensor& /* pointwise_bias */,
+    IntArrayRef /* stride */,
+    IntArrayRef /* padding */);
+
+DECLARE_DISPATCH(
+    conv_depthwise_separable3x3_fn,
+    conv_depthwise_separable3x3_stub);
+
+} // namespace native
+} // namespace at
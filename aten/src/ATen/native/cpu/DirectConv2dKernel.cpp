@@ -0,0 +1,161 @@
+#include <ATen/native/cpu/DirectConv2dKernel.h>
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+
+namespace at {
+namespace native {
+namespace {
+
+// Number of Vec256 accumulators (output channel groups) kept live per
+// output pixel. 4 x 8 floats tiles 32 output channels per pass.
+constexpr int64_t kOcTile = 4;
+
+// Loop bounds and parallel grain derived from the conv geometry; memoized
+// per shape class so fixed-shape serving skips the re-derivation (see
+// Note [Shape-class memo] in DispatchStub.h).
+struct ConvLaunchParams {
+  int64_t out_rows;
+  int64_t out_cols;
+  int64_t oc_padded;
+  int64_t grain;
+};
+
+Tensor _direct_conv2d(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding) {
+  using Vec = vec256::Vec256<float>;
+
+  TORCH_CHECK(input.ndimension() == 4, "direct_conv2d: expected 4d input");
+  TORCH_CHECK(weight.ndimension() == 4, "direct_conv2d: expected 4d weight");
+  TORCH_CHECK(
+      input.scalar_type() == kFloat && weight.scalar_type() == kFloat,
+      "direct_conv2d: only float is supported");
+
+  const int64_t batch = input.size(0);
+  const int64_t in_channels = input.size(1);
+  const int64_t in_rows = input.size(2);
+  const int64_t in_cols = input.size(3);
+  const int64_t out_channels = weight.size(0);
+  const int64_t k_rows = weight.size(2);
+  const int64_t k_cols = weight.size(3);
+  const int64_t stride_h = stride[0];
+  const int64_t stride_w = stride[1];
+  const int64_t pad_h = padding[0];
+  const int64_t pad_w = padding[1];
+  static thread_local ShapeClassMemo<ConvLaunchParams> launch_memo;
+  ShapeClassKey shape_key;
+  shape_key.add(batch);
+  shape_key.add(in_channels);
+  shape_key.add((static_cast<uint64_t>(in_rows) << 32) | in_cols);
+  shape_key.add(out_channels);
+  shape_key.add((static_cast<uint64_t>(k_rows) << 32) | k_cols);
+  shape_key.add((static_cast<uint64_t>(stride_h) << 32) | stride_w);
+  shape_key.add((static_cast<uint64_t>(pad_h) << 32) | pad_w);
+  const ConvLaunchParams& launch = launch_memo.lookup(shape_key, [&] {
+    ConvLaunchParams params;
+    params.out_rows = (in_rows + 2 * pad_h - k_rows) / stride_h + 1;
+    params.out_cols = (in_cols + 2 * pad_w - k_cols) / stride_w + 1;
+    TORCH_CHECK(
+        params.out_rows >= 1 && params.out_cols >= 1,
+        "direct_conv2d: kernel larger than padded input");
+    // Output channels rounded up to the vector width; the padded lanes
+    // carry zero weights and bias, and are sliced away at the end.
+    params.oc_padded =
+        (out_channels + Vec::size() - 1) / Vec::size() * Vec::size();
+    const int64_t work_per_row =
+        params.out_cols * k_rows * k_cols * in_channels * params.oc_padded;
+    params.grain = std::max<int64_t>(
+        1, at::internal::GRAIN_SIZE / std::max<int64_t>(work_per_row, 1));
+    return params;
+  });
+  const int64_t out_rows = launch.out_rows;
+  const int64_t out_cols = launch.out_cols;
+  const int64_t oc_padded = launch.oc_padded;
+
+  // Repack into channels-last so the innermost (vectorized) index is the
+  // output channel: input as [batch][h][w][ic], weight as [kh][kw][ic][oc].
+  Tensor input_packed = input.permute({0, 2, 3, 1}).contiguous();
+  Tensor weight_packed =
+      at::zeros({k_rows, k_cols, in_channels, oc_padded}, weight.options());
+  weight_packed.narrow(3, 0, out_channels)
+      .copy_(weight.permute({2, 3, 1, 0}));
+  Tensor bias_packed = at::zeros({oc_padded}, weight.options());
+  if (bias.defined()) {
+    bias_packed.narrow(0, 0, out_channels).copy_(bias);
+  }
+  Tensor output_packed =
+      at::empty({batch, out_rows, out_cols, oc_padded}, input.options());
+
+  const float* in_data = input_packed.data_ptr<float>();
+  const float* w_data = weight_packed.data_ptr<float>();
+  const float* b_data = bias_packed.data_ptr<float>();
+  float* out_data = output_packed.data_ptr<float>();
+
+  at::parallel_for(
+      0, batch * out_rows, launch.grain, [&](int64_t begin, int64_t end) {
+        for (int64_t index = begin; index < end; ++index) {
+          const int64_t n = index / out_rows;
+          const int64_t oy = index % out_rows;
+          const float* in_n = in_data + n * in_rows * in_cols * in_channels;
+          float* out_row =
+              out_data + (n * out_rows + oy) * out_cols * oc_padded;
+          for (int64_t ox = 0; ox < out_cols; ++ox) {
+            float* out_px = out_row + ox * oc_padded;
+            for (int64_t ocb = 0; ocb < oc_padded;
+                 ocb += kOcTile * Vec::size()) {
+              const int64_t lanes = std::min<int64_t>(
+                  kOcTile, (oc_padded - ocb) / Vec::size());
+              Vec acc[kOcTile];
+              for (int64_t v = 0; v < lanes; ++v) {
+                acc[v] = Vec::loadu(b_data + ocb + v * Vec::size());
+              }
+              for (int64_t ky = 0; ky < k_rows; ++ky) {
+                const int64_t iy = oy * stride_h - pad_h + ky;
+                if (iy < 0 || iy >= in_rows) {
+                  continue;
+                }
+                for (int64_t kx = 0; kx < k_cols; ++kx) {
+                  const int64_t ix = ox * stride_w - pad_w + kx;
+                  if (ix < 0 || ix >= in_cols) {
+                    continue;
+                  }
+                  const float* in_px =
+                      in_n + (iy * in_cols + ix) * in_channels;
+                  const float* w_px =
+                      w_data + (ky * k_cols + kx) * in_channels * oc_padded +
+                      ocb;
+                  for (int64_t c = 0; c < in_channels; ++c) {
+                    const Vec a(in_px[c]);
+                    const float* w = w_px + c * oc_padded;
+                    for (int64_t v = 0; v < lanes; ++v) {
+                      acc[v] = vec256::fmadd(
+                          Vec::loadu(w + v * Vec::size()), a, acc[v]);
+                    }
+                  }
+                }
+              }
+              for (int64_t v = 0; v < lanes; ++v) {
+                acc[v].store(out_px + ocb + v * Vec::size());
+              }
+            }
+          }
+        }
+      });
+
+  return output_packed.narrow(3, 0, out_channels)
+      .permute({0, 3, 1, 2})
+      .contiguous();
+}
+
+} // namespace
+
+REGISTER_DISPATCH(direct_conv2d_stub, &_direct_conv2d);
+
+} // namespace native
+} // namespace at
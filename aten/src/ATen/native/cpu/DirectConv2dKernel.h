@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+/*
+  Direct 2d convolution for small spatial extents.
+
+  ConvolutionMM2d lowers conv2d to im2col + GEMM. For late-stage CNN
+  feature maps (spatially small, channel heavy) the patch matrix is much
+  larger than the input itself, and materializing it dominates the conv
+  time. This kernel computes the convolution directly: the input and
+  weight are repacked once into channels-last layout and each output
+  pixel accumulates a register tile of output channels with Vec256 FMAs,
+  so no intermediate proportional to kernel size is ever written.
+*/
+
+namespace at {
+namespace native {
+
+using direct_conv2d_fn = Tensor (*)(
+    const Tensor& /* input */,
+    const Tensor& /* weight */,
+    const Tensor& /* bias */,
+    IntArrayRef /* stride */,
+    IntArrayRef /* padding */);
+
+DECLARE_DISPATCH(direct_conv2d_fn, direct_conv2d_stub);
+
+} // namespace native
+} // namespace at
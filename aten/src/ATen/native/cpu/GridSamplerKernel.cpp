@@ -952,6 +952,96 @@ Tensor grid_sampler_2d_cpu_kernel_impl(const Tensor& input, const Tensor& grid,
   return output;
 }
 
+// NOTE [ Spatially-parallel grid sample backward ]
+// The backward pass parallelizes over the batch dimension, same as the
+// forward. When the batch is smaller than the thread count (e.g.,
+// optical-flow style training with large images and a batch of a few),
+// most cores idle while the scatter-adds into grad_input prevent naively
+// splitting one slice across threads. This helper splits a single
+// (grad_output, grid) slice pair over threads by grid rows instead:
+// grad_grid rows are owned by exactly one task, so they are written
+// directly, while each task accumulates its grad_input contributions into
+// a private zeroed buffer. The buffers are then reduced into grad_input
+// in a second parallel pass partitioned over grad_input elements, so
+// neither phase needs atomics. The per-pixel weight and gradient math is
+// the same vectorized ApplyGridSample::backward as the batch-parallel
+// path.
+template<typename scalar_t, typename ApplyFn>
+static inline void
+grid_sample_2d_backward_spatial(const ApplyFn& grid_sample,
+                                TensorAccessor<scalar_t, 3>& gInp_slice,
+                                TensorAccessor<scalar_t, 3>& gGrid_slice,
+                                const TensorAccessor<scalar_t, 3>& gOut_slice,
+                                const TensorAccessor<scalar_t, 3>& inp_slice,
+                                const TensorAccessor<scalar_t, 3>& grid_slice) {
+  using Vec = Vec256<scalar_t>;
+  int64_t H = grid_slice.size(0);
+  int64_t W = grid_slice.size(1);
+  int64_t gInp_numel =
+      gInp_slice.size(0) * gInp_slice.size(1) * gInp_slice.size(2);
+
+  int64_t chunk_rows =
+      std::max((int64_t)1, at::divup(H, (int64_t)at::get_num_threads()));
+  int64_t num_chunks = at::divup(H, chunk_rows);
+
+  // One private grad_input buffer per chunk; chunks map 1:1 onto tasks
+  // (grain size 1 below).
+  std::vector<scalar_t> buffers(num_chunks * gInp_numel, scalar_t(0));
+  scalar_t* buffers_data = buffers.data();
+
+  // ApplyGridSample::backward assumes a contiguous gInp slice; grad_input
+  // comes from at::zeros_like so the buffers mirror its layout exactly.
+  int64_t buf_sizes[3] =
+      {gInp_slice.size(0), gInp_slice.size(1), gInp_slice.size(2)};
+  int64_t buf_strides[3] =
+      {gInp_slice.size(1) * gInp_slice.size(2), gInp_slice.size(2), 1};
+  int64_t grid_strides[3] =
+      {grid_slice.stride(0), grid_slice.stride(1), grid_slice.stride(2)};
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      int64_t h_begin = chunk * chunk_rows;
+      int64_t h_end = std::min(H, h_begin + chunk_rows);
+      int64_t grid_sizes[3] = {h_end - h_begin, W, 2};
+      const TensorAccessor<scalar_t, 3> grid_chunk(
+          const_cast<scalar_t*>(grid_slice.data()) +
+              h_begin * grid_slice.stride(0),
+          grid_sizes, grid_strides);
+      TensorAccessor<scalar_t, 3> gInp_buffer(
+          buffers_data + chunk * gInp_numel, buf_sizes, buf_strides);
+      // The iterator reports offsets relative to the row chunk; shift them
+      // back to slice coordinates for gGrid and gOut.
+      int64_t offset_base = h_begin * W;
+      grid_sample_2d_grid_slice_iterator(
+        grid_chunk,
+        [&](const Vec& grid_x, const Vec& grid_y,
+            int64_t spatial_offset, int64_t len) {
+          grid_sample.backward(gInp_buffer, gGrid_slice, gOut_slice,
+                               inp_slice, offset_base + spatial_offset,
+                               grid_x, grid_y, len);
+        });
+    }
+  });
+
+  // Reduce the private buffers into grad_input. Tasks own disjoint element
+  // ranges, so the adds are conflict-free and vectorize.
+  scalar_t* gInp_ptr = gInp_slice.data();
+  at::parallel_for(0, gInp_numel, at::internal::GRAIN_SIZE,
+      [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+      const scalar_t* buf = buffers_data + chunk * gInp_numel;
+      int64_t d = begin;
+      for (; d + Vec::size() <= end; d += Vec::size()) {
+        auto sum = Vec::loadu(gInp_ptr + d) + Vec::loadu(buf + d);
+        sum.store(gInp_ptr + d);
+      }
+      for (; d < end; d++) {
+        gInp_ptr[d] += buf[d];
+      }
+    }
+  });
+}
+
 std::tuple<Tensor, Tensor>
 grid_sampler_2d_backward_cpu_kernel_impl(const Tensor& grad_output_,
                                          const Tensor& input,
@@ -974,6 +1064,20 @@ grid_sampler_2d_backward_cpu_kernel_impl(const Tensor& grad_output_,
   case padding: {                                                                \
     ApplyGridSample<scalar_t, 2, interp, padding, align_corners>                 \
     grid_sample(inp_acc);                                                        \
+    if (N < at::get_num_threads() &&                                             \
+        spatial_size * 10 /* 2d * 5 tensors */ >= at::internal::GRAIN_SIZE) {    \
+      /* Not enough batch slices to occupy all threads; parallelize over */      \
+      /* grid rows within each slice instead. */                                 \
+      /* See NOTE [ Spatially-parallel grid sample backward ]. */                \
+      for (int64_t n = 0; n < N; n++) {                                          \
+        auto gInp_slice = gInp_acc[n];                                           \
+        auto gGrid_slice = gGrid_acc[n];                                         \
+        grid_sample_2d_backward_spatial<scalar_t>(                               \
+            grid_sample, gInp_slice, gGrid_slice, gOut_acc[n], inp_acc[n],       \
+            grid_acc[n]);                                                        \
+      }                                                                          \
+      return;                                                                    \
+    }                                                                            \
     parallel_for(0, N, grain_size, [&](int64_t begin, int64_t end) {             \
       for (int64_t n = begin; n < end; n++) {                                    \
         auto gInp_slice = gInp_acc[n];                                           \
@@ -1,6 +1,7 @@
 #include <ATen/native/Indexing.h>
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
@@ -57,9 +58,9 @@ static bool is_constant_index(int ntensor, const int64_t* strides) {
   return true;
 }
 
-template <typename scalar_t, typename func_t>
+template <typename scalar_t, typename func_t, typename bulk_func_t>
 void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride,
-                      const func_t& f, bool serial_execution=false)
+                      const func_t& f, const bulk_func_t& bf, bool serial_execution=false)
 {
   int ntensor = iter.ntensors();
   auto loop = [&](char** data, const int64_t* strides, int64_t n) {
@@ -70,9 +71,11 @@ void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
       // specialization for when every element uses the same index
       int64_t offset = indexer.get(0);
       if (strides[0] == sizeof(scalar_t) && strides[1] == sizeof(scalar_t)) {
-        for (int64_t i = 0; i < n; i++) {
-          f(dst + strides[0] * i, src + strides[1] * i, offset);
-        }
+        // Both sides advance contiguously while the index stays fixed, e.g.
+        // a row gather/scatter with a 1-d index on dim 0 of a contiguous
+        // 2-d tensor; hand the whole run to the bulk variant instead of
+        // going element by element.
+        bf(dst, src, offset, n);
       } else {
         for (int64_t i = 0; i < n; i++) {
           f(dst + strides[0] * i, src + strides[1] * i, offset);
@@ -96,6 +99,8 @@ void index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef inde
   AT_DISPATCH_ALL_TYPES_AND2(at::ScalarType::Half, at::ScalarType::Bool, iter.dtype(), "index_cpu", [&] {
     cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
       *(scalar_t*)dst = *(scalar_t*)(src + offset);
+    }, [](char* dst, char* src, int64_t offset, int64_t n) {
+      memcpy(dst, src + offset, n * sizeof(scalar_t));
     });
   });
 }
@@ -108,10 +113,18 @@ void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
       // this needs to be thread-safe.
       cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
         *(scalar_t*)(dst + offset) += *(scalar_t*)src;
+      }, [](char* dst, char* src, int64_t offset, int64_t n) {
+        scalar_t* dst_data = (scalar_t*)(dst + offset);
+        scalar_t* src_data = (scalar_t*)src;
+        for (int64_t i = 0; i < n; i++) {
+          dst_data[i] += src_data[i];
+        }
       }, /*serial_execution=*/true);
     } else {
       cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
         *(scalar_t*)(dst + offset) = *(scalar_t*)src;
+      }, [](char* dst, char* src, int64_t offset, int64_t n) {
+        memcpy(dst + offset, src, n * sizeof(scalar_t));
       });
     }
   });
@@ -27,6 +27,7 @@
 //
 
 #include <stdint.h>
+#include <algorithm>
 #include <c10/util/C++17.h>
 #include <ATen/detail/FunctionTraits.h>
 #include <ATen/native/cpu/IsContiguous.h>
@@ -80,6 +81,31 @@ dereference_vec(char* C10_RESTRICT data[], const typename traits::result_type& o
   return dereference_vec_impl<traits>(data, opt_scalar, S, i, Indices{});
 }
 
+// Partial-vector variant used for loop remainders: only count elements are
+// read from each input (see the partial load contract in vec256_base.h).
+template <typename traits, std::size_t... INDEX>
+typename traits::ArgsTuple
+dereference_vec_impl(char* C10_RESTRICT data[],
+                     const typename traits::result_type& opt_scalar,
+                     size_t S,
+                     int64_t i,
+                     int64_t count,
+                     c10::guts::index_sequence<INDEX...>) {
+  using Vec = typename traits::result_type;
+  using scalar_t = typename Vec::value_type;
+  return std::make_tuple(
+      S == INDEX + 1 ?
+      opt_scalar :
+      Vec::loadu(data[INDEX] + i * sizeof(scalar_t), count)...);
+}
+
+template <typename traits>
+typename traits::ArgsTuple
+dereference_vec(char* C10_RESTRICT data[], const typename traits::result_type& opt_scalar, size_t S, int64_t i, int64_t count) {
+  using Indices = c10::guts::make_index_sequence<traits::arity>;
+  return dereference_vec_impl<traits>(data, opt_scalar, S, i, count, Indices{});
+}
+
 template <typename func_t,
     typename std::enable_if<!std::is_void<typename function_traits<func_t>::result_type>::value>::type* = nullptr>
 static inline void
@@ -153,13 +179,17 @@ vectorized_loop(char** C10_RESTRICT data_, int64_t n, int64_t S, func_t op, vec_
     out1.store(data[0] + i * sizeof(scalar_t));
     out2.store(data[0] + (i + Vec::size()) * sizeof(scalar_t));
   }
-  if (i < n) {
-    int64_t strides[ntensors];
-    for (int arg = 0; arg < ntensors; arg++) {
-      strides[arg] = (S > 0 && arg == S) ? 0 : sizeof(scalar_t);
-    }
-    basic_loop(data, strides, i, n, op);
+  // The remainder also runs through the vector op, using partial (masked)
+  // loads and stores: lanes past the end are read as zero and never written
+  // back. For small tensors this keeps the whole loop vectorized instead of
+  // degrading to a scalar epilogue.
+  for (; i < n; i += Vec::size()) {
+    const int64_t count = std::min(n - i, (int64_t)Vec::size());
+    auto args = dereference_vec<traits>(&data[1], opt_scalar, S, i, count);
+    auto out = c10::guts::apply(vop, std::move(args));
+    out.store(data[0] + i * sizeof(scalar_t), count);
   }
+  (void)op; // the scalar op is no longer needed for the remainder
 }
 
 
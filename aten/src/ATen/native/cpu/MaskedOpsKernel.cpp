@@ -0,0 +1,175 @@
+#include <ATen/native/cpu/MaskedOpsKernel.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+// Chunk granularity for the masked_select count/compact passes.
+constexpr int64_t kSelectChunkSize = 32768;
+
+// Expands a vector-width run of bool mask bytes into a lane mask for
+// blendv. All bits of a true lane are set, which satisfies both the AVX
+// blends (sign bit) and the generic fallback (low bit).
+template <typename scalar_t>
+inline vec256::Vec256<scalar_t> expand_mask(const bool* mask) {
+  using Vec = vec256::Vec256<scalar_t>;
+  using int_t = vec256::int_same_size_t<scalar_t>;
+  alignas(32) int_t buffer[Vec::size()];
+  for (int64_t i = 0; i < Vec::size(); i++) {
+    buffer[i] = mask[i] ? static_cast<int_t>(-1) : static_cast<int_t>(0);
+  }
+  return Vec::loadu(buffer);
+}
+
+inline int64_t count_true(const bool* mask, int64_t n) {
+  int64_t count = 0;
+  for (int64_t i = 0; i < n; i++) {
+    count += mask[i];
+  }
+  return count;
+}
+
+void masked_fill_fast_kernel(Tensor& self, const Tensor& mask, Scalar value) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "masked_fill_fast_cpu", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    scalar_t* self_data = self.data_ptr<scalar_t>();
+    const bool* mask_data = mask.data_ptr<bool>();
+    const scalar_t fill_value = value.to<scalar_t>();
+    const Vec fill_vec(fill_value);
+    at::parallel_for(
+        0,
+        self.numel(),
+        internal::GRAIN_SIZE,
+        [&](int64_t begin, int64_t end) {
+          int64_t i = begin;
+          // Classify whole blocks first: attention masks are run-heavy, so
+          // most blocks are uniform and need no blend at all.
+          for (; i + Vec::size() <= end; i += Vec::size()) {
+            const int64_t count = count_true(mask_data + i, Vec::size());
+            if (count == 0) {
+              continue;
+            }
+            if (count == Vec::size()) {
+              fill_vec.store(self_data + i);
+            } else {
+              Vec::blendv(
+                  Vec::loadu(self_data + i),
+                  fill_vec,
+                  expand_mask<scalar_t>(mask_data + i))
+                  .store(self_data + i);
+            }
+          }
+          for (; i < end; i++) {
+            if (mask_data[i]) {
+              self_data[i] = fill_value;
+            }
+          }
+        });
+  });
+}
+
+void where_fast_kernel(
+    Tensor& ret,
+    const Tensor& condition,
+    const Tensor& self,
+    const Tensor& other) {
+  AT_DISPATCH_FLOATING_TYPES(ret.scalar_type(), "where_fast_cpu", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    scalar_t* ret_data = ret.data_ptr<scalar_t>();
+    const bool* cond_data = condition.data_ptr<bool>();
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    const scalar_t* other_data = other.data_ptr<scalar_t>();
+    at::parallel_for(
+        0,
+        ret.numel(),
+        internal::GRAIN_SIZE,
+        [&](int64_t begin, int64_t end) {
+          int64_t i = begin;
+          for (; i + Vec::size() <= end; i += Vec::size()) {
+            const int64_t count = count_true(cond_data + i, Vec::size());
+            if (count == 0) {
+              Vec::loadu(other_data + i).store(ret_data + i);
+            } else if (count == Vec::size()) {
+              Vec::loadu(self_data + i).store(ret_data + i);
+            } else {
+              Vec::blendv(
+                  Vec::loadu(other_data + i),
+                  Vec::loadu(self_data + i),
+                  expand_mask<scalar_t>(cond_data + i))
+                  .store(ret_data + i);
+            }
+          }
+          for (; i < end; i++) {
+            ret_data[i] = cond_data[i] ? self_data[i] : other_data[i];
+          }
+        });
+  });
+}
+
+void masked_select_fast_kernel(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mask) {
+  const int64_t numel = self.numel();
+  const int64_t num_chunks = (numel + kSelectChunkSize - 1) / kSelectChunkSize;
+  const bool* mask_data = numel > 0 ? mask.data_ptr<bool>() : nullptr;
+
+  // Count per chunk, prefix-sum the counts into chunk output offsets, then
+  // compact every chunk independently at its offset.
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      const int64_t chunk_begin = chunk * kSelectChunkSize;
+      chunk_offsets[chunk + 1] = count_true(
+          mask_data + chunk_begin,
+          std::min(kSelectChunkSize, numel - chunk_begin));
+    }
+  });
+  for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+    chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+  }
+
+  const int64_t total = chunk_offsets[num_chunks];
+  result.resize_({total});
+  if (total == 0) {
+    return;
+  }
+  AT_DISPATCH_ALL_TYPES_AND2(
+      ScalarType::Half,
+      ScalarType::Bool,
+      self.scalar_type(),
+      "masked_select_fast_cpu",
+      [&] {
+        const scalar_t* self_data = self.data_ptr<scalar_t>();
+        scalar_t* result_data = result.data_ptr<scalar_t>();
+        at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+          for (int64_t chunk = begin; chunk < end; chunk++) {
+            const int64_t chunk_begin = chunk * kSelectChunkSize;
+            const int64_t chunk_end =
+                std::min(chunk_begin + kSelectChunkSize, numel);
+            int64_t offset = chunk_offsets[chunk];
+            for (int64_t i = chunk_begin; i < chunk_end; i++) {
+              if (mask_data[i]) {
+                result_data[offset++] = self_data[i];
+              }
+            }
+          }
+        });
+      });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(masked_fill_fast_stub, &masked_fill_fast_kernel);
+REGISTER_DISPATCH(masked_select_fast_stub, &masked_select_fast_kernel);
+REGISTER_DISPATCH(where_fast_stub, &where_fast_kernel);
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+/*
+  Vectorized fast paths for boolean-masked operations.
+
+  The TH fallbacks for masked_fill/masked_select and the TensorIterator
+  loop for where() process one element per iteration. Attention-style
+  masking applies huge masks with long all-true/all-false runs, where a
+  whole vector lane's worth of mask bytes can be classified at once:
+  uniform blocks become a plain store or copy, mixed blocks a single
+  Vec256::blendv, and masked_select compacts with a per-chunk count +
+  prefix-sum so it parallelizes. The stubs below only handle contiguous
+  same-shape bool masks; callers keep the generic path for everything
+  else.
+*/
+
+namespace at {
+namespace native {
+
+using masked_fill_fast_fn =
+    void (*)(Tensor& self, const Tensor& mask, Scalar value);
+using masked_select_fast_fn =
+    void (*)(Tensor& result, const Tensor& self, const Tensor& mask);
+using where_fast_fn = void (*)(
+    Tensor& ret,
+    const Tensor& condition,
+    const Tensor& self,
+    const Tensor& other);
+
+DECLARE_DISPATCH(masked_fill_fast_fn, masked_fill_fast_stub);
+DECLARE_DISPATCH(masked_select_fast_fn, masked_select_fast_stub);
+DECLARE_DISPATCH(where_fast_fn, where_fast_stub);
+
+} // namespace native
+} // namespace at
@@ -1,15 +1,65 @@
 #include <ATen/ATen.h>
 
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <ATen/core/DistributionsHelper.h>
+#include <ATen/core/PhiloxRNGEngine.h>
 
 namespace at {
 namespace native {
 namespace {
 
+// With-replacement draws at or above this count use the counter-based
+// parallel path; below it the serial generator loop is cheaper than
+// seeding Philox streams.
+constexpr int64_t kPhiloxSampleThreshold = 4096;
+
+// Counter-based parallel sampling for the with-replacement case. Every
+// sample draws from its own Philox subsequence keyed by (seed, sample
+// index), so the output is deterministic for a given generator state no
+// matter how the loop is chunked across threads, and no generator state is
+// touched while sampling - the generator only advances once, to produce
+// the seed.
+template <typename scalar_t>
+void multinomial_with_replacement_philox(
+    const scalar_t* cum_dist_ptr,
+    int64_t cum_dist_stride_0,
+    int64_t n_categories,
+    int64_t* result_ptr,
+    int64_t result_stride,
+    int64_t n_sample,
+    uint64_t seed,
+    uint64_t subsequence_base) {
+  at::parallel_for(0, n_sample, 2048, [&](int64_t begin, int64_t end) {
+    for (int64_t j = begin; j < end; j++) {
+      at::Philox4_32_10 engine(seed, subsequence_base + j, 0);
+      // Assemble a 53-bit uniform in [0, 1) from two 32-bit outputs.
+      const uint32_t hi = engine();
+      const uint32_t lo = engine();
+      const uint64_t bits = (static_cast<uint64_t>(hi) << 21) | (lo >> 11);
+      const double uniform_sample =
+          bits * (1.0 / 9007199254740992.0); // 2^-53
+      int left_pointer = 0;
+      int right_pointer = n_categories;
+      while (right_pointer - left_pointer > 0) {
+        const int mid_pointer =
+            left_pointer + (right_pointer - left_pointer) / 2;
+        const scalar_t cum_prob =
+            cum_dist_ptr[mid_pointer * cum_dist_stride_0];
+        if (cum_prob < uniform_sample) {
+          left_pointer = mid_pointer + 1;
+        } else {
+          right_pointer = mid_pointer;
+        }
+      }
+      result_ptr[j * result_stride] = left_pointer;
+    }
+  });
+}
+
 template<typename scalar_t>
 void multinomial_apply(Tensor& result, const Tensor& self, const int64_t n_sample, const bool with_replacement, Generator* generator) {
   auto gen = get_generator_or_default<CPUGenerator>(generator, detail::getDefaultCPUGenerator());
@@ -19,6 +69,13 @@ void multinomial_apply(Tensor& result, const Tensor& self, const int64_t n_sampl
   int64_t n_categories = self.size(-1);
   int64_t n_dist = self.dim() > 1 ? self.size(-2) : 1;
 
+  const bool use_philox =
+      with_replacement && n_sample >= kPhiloxSampleThreshold;
+  uint64_t philox_seed = 0;
+  if (use_philox) {
+    philox_seed = gen->random64();
+  }
+
   /* cumulative probability distribution vector */
   Tensor cum_dist = at::empty({n_categories}, self.options());
 
@@ -71,6 +128,21 @@ void multinomial_apply(Tensor& result, const Tensor& self, const int64_t n_sampl
       }
     }
 
+    if (use_philox) {
+      /* Make sure the last cumulative distribution bucket sums to 1 */
+      cum_dist_ptr[(n_categories - 1) * cum_dist_stride_0] = 1;
+      multinomial_with_replacement_philox(
+          cum_dist_ptr,
+          cum_dist_stride_0,
+          n_categories,
+          result_ptr + i * result_dist_stride_0,
+          result_dist_stride_1,
+          n_sample,
+          philox_seed,
+          static_cast<uint64_t>(i) * static_cast<uint64_t>(n_sample));
+      continue;
+    }
+
     for (int64_t j = 0; j < n_sample; j++) {
       /* sample a probability mass from a uniform distribution */
       at::uniform_real_distribution<double> uniform(0, 1);
@@ -0,0 +1,152 @@
+#include <ATen/native/RNN.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <cmath>
+
+namespace at {
+namespace native {
+namespace {
+
+template <typename scalar_t>
+inline scalar_t sigmoid_one(scalar_t x) {
+  return scalar_t(1) / (scalar_t(1) + std::exp(-x));
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> sigmoid_vec(const Vec256<scalar_t>& x) {
+  using Vec = Vec256<scalar_t>;
+  const Vec one(scalar_t(1));
+  return one / (one + (Vec(scalar_t(0)) - x).exp());
+}
+
+// The gate layouts match the chunk(4, 1)/chunk(3, 1) order of the unfused
+// cell code in RNN.cpp: LSTM gates are [in|forget|cell|out], GRU gates are
+// [reset|input|new].
+
+template <typename scalar_t>
+void fused_lstm_cell_impl(
+    Tensor& hy,
+    Tensor& cy,
+    const Tensor& gates,
+    const Tensor& cx) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t batch_size = cx.size(0);
+  const int64_t hidden_size = cx.size(1);
+
+  const scalar_t* gates_data = gates.data_ptr<scalar_t>();
+  const scalar_t* cx_data = cx.data_ptr<scalar_t>();
+  scalar_t* hy_data = hy.data_ptr<scalar_t>();
+  scalar_t* cy_data = cy.data_ptr<scalar_t>();
+
+  at::parallel_for(0, batch_size, 0, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const scalar_t* in_gate = gates_data + b * 4 * hidden_size;
+      const scalar_t* forget_gate = in_gate + hidden_size;
+      const scalar_t* cell_gate = in_gate + 2 * hidden_size;
+      const scalar_t* out_gate = in_gate + 3 * hidden_size;
+      const scalar_t* cx_row = cx_data + b * hidden_size;
+      scalar_t* hy_row = hy_data + b * hidden_size;
+      scalar_t* cy_row = cy_data + b * hidden_size;
+
+      int64_t i = 0;
+      for (; i + Vec::size() <= hidden_size; i += Vec::size()) {
+        const Vec ig = sigmoid_vec(Vec::loadu(in_gate + i));
+        const Vec fg = sigmoid_vec(Vec::loadu(forget_gate + i));
+        const Vec cg = Vec::loadu(cell_gate + i).tanh();
+        const Vec og = sigmoid_vec(Vec::loadu(out_gate + i));
+        const Vec c = fg * Vec::loadu(cx_row + i) + ig * cg;
+        c.store(cy_row + i);
+        (og * c.tanh()).store(hy_row + i);
+      }
+      for (; i < hidden_size; i++) {
+        const scalar_t ig = sigmoid_one(in_gate[i]);
+        const scalar_t fg = sigmoid_one(forget_gate[i]);
+        const scalar_t cg = std::tanh(cell_gate[i]);
+        const scalar_t og = sigmoid_one(out_gate[i]);
+        const scalar_t c = fg * cx_row[i] + ig * cg;
+        cy_row[i] = c;
+        hy_row[i] = og * std::tanh(c);
+      }
+    }
+  });
+}
+
+template <typename scalar_t>
+void fused_gru_cell_impl(
+    Tensor& hy,
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& hx) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t batch_size = hx.size(0);
+  const int64_t hidden_size = hx.size(1);
+
+  const scalar_t* igates_data = igates.data_ptr<scalar_t>();
+  const scalar_t* hgates_data = hgates.data_ptr<scalar_t>();
+  const scalar_t* hx_data = hx.data_ptr<scalar_t>();
+  scalar_t* hy_data = hy.data_ptr<scalar_t>();
+
+  at::parallel_for(0, batch_size, 0, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const scalar_t* i_reset = igates_data + b * 3 * hidden_size;
+      const scalar_t* i_input = i_reset + hidden_size;
+      const scalar_t* i_new = i_reset + 2 * hidden_size;
+      const scalar_t* h_reset = hgates_data + b * 3 * hidden_size;
+      const scalar_t* h_input = h_reset + hidden_size;
+      const scalar_t* h_new = h_reset + 2 * hidden_size;
+      const scalar_t* hx_row = hx_data + b * hidden_size;
+      scalar_t* hy_row = hy_data + b * hidden_size;
+
+      int64_t i = 0;
+      for (; i + Vec::size() <= hidden_size; i += Vec::size()) {
+        const Vec reset_gate =
+            sigmoid_vec(Vec::loadu(i_reset + i) + Vec::loadu(h_reset + i));
+        const Vec input_gate =
+            sigmoid_vec(Vec::loadu(i_input + i) + Vec::loadu(h_input + i));
+        const Vec new_gate =
+            (Vec::loadu(i_new + i) + reset_gate * Vec::loadu(h_new + i))
+                .tanh();
+        const Vec h = Vec::loadu(hx_row + i);
+        ((h - new_gate) * input_gate + new_gate).store(hy_row + i);
+      }
+      for (; i < hidden_size; i++) {
+        const scalar_t reset_gate = sigmoid_one(i_reset[i] + h_reset[i]);
+        const scalar_t input_gate = sigmoid_one(i_input[i] + h_input[i]);
+        const scalar_t new_gate = std::tanh(i_new[i] + reset_gate * h_new[i]);
+        hy_row[i] = (hx_row[i] - new_gate) * input_gate + new_gate;
+      }
+    }
+  });
+}
+
+void fused_lstm_cell_kernel(
+    Tensor& hy,
+    Tensor& cy,
+    const Tensor& gates,
+    const Tensor& cx) {
+  AT_DISPATCH_FLOATING_TYPES(gates.scalar_type(), "fused_lstm_cell", [&] {
+    fused_lstm_cell_impl<scalar_t>(hy, cy, gates, cx);
+  });
+}
+
+void fused_gru_cell_kernel(
+    Tensor& hy,
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& hx) {
+  AT_DISPATCH_FLOATING_TYPES(igates.scalar_type(), "fused_gru_cell", [&] {
+    fused_gru_cell_impl<scalar_t>(hy, igates, hgates, hx);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(fused_lstm_cell_stub, &fused_lstm_cell_kernel);
+REGISTER_DISPATCH(fused_gru_cell_stub, &fused_gru_cell_kernel);
+
+} // namespace native
+} // namespace at
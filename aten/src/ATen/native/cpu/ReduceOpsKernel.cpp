@@ -1,8 +1,13 @@
 #include <numeric>
 #include <iterator>
 #include <algorithm>
+#include <cstdlib>
 #include <limits>
+#include <vector>
 
+#include <ATen/Parallel.h>
+
+#include <ATen/AccumulateType.h>
 #include <ATen/Dispatch.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/ReduceOps.h>
@@ -15,7 +20,225 @@ namespace at { namespace native { namespace {
 
 using namespace vec256;
 
+// Note [Full-width accumulation for reduced-precision inputs]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Accumulating a long sum in half/bfloat16 loses a bit of the running
+// total on nearly every add (bfloat16 has 8 significand bits), and every
+// partial result pays a round trip through the narrow format. The ops
+// below keep the accumulator in acc_type<scalar_t, false> -- float for
+// half and bfloat16 -- and down-convert exactly once in project(). The
+// reduce() data argument stays scalar_t because binary_kernel_reduce
+// reads input memory as the deduced data type, and project() returns
+// scalar_t because set_result writes the projected value straight into
+// the output tensor.
+//
+// These ops are CPU-only; the shared CUDA ops in SharedReduceOps.h
+// already accumulate in acc_t because the GPU kernels convert on load.
+
+template <typename scalar_t, typename acc_t>
+struct SumAccOps {
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t /*idx*/) const {
+    return acc + acc_t(data);
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return a + b;
+  }
+  inline scalar_t project(acc_t a) const {
+    return scalar_t(a);
+  }
+};
+
+template <typename scalar_t, typename acc_t>
+struct MeanAccOps {
+  acc_t factor;
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t /*idx*/) const {
+    return acc + acc_t(data);
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return a + b;
+  }
+  inline scalar_t project(acc_t a) const {
+    return scalar_t(a * factor);
+  }
+};
+
+template <typename scalar_t, typename acc_t>
+struct NormAccOps {
+  acc_t norm;
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t /*idx*/) const {
+    return acc + std::pow(std::abs(acc_t(data)), norm);
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return a + b;
+  }
+  inline scalar_t project(acc_t a) const {
+    return scalar_t(std::pow(a, acc_t(1.0) / norm));
+  }
+};
+
+template <typename scalar_t, typename acc_t>
+struct NormZeroAccOps {
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t /*idx*/) const {
+    return acc + (acc_t(data) == acc_t(0) ? acc_t(0) : acc_t(1));
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return a + b;
+  }
+  inline scalar_t project(acc_t a) const {
+    return scalar_t(a);
+  }
+};
+
+template <typename scalar_t, typename acc_t>
+struct NormOneAccOps {
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t /*idx*/) const {
+    return acc + std::abs(acc_t(data));
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return a + b;
+  }
+  inline scalar_t project(acc_t a) const {
+    return scalar_t(a);
+  }
+};
+
+template <typename scalar_t, typename acc_t>
+struct AbsMaxAccOps {
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t /*idx*/) const {
+    return std::max(acc, std::abs(acc_t(data)));
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return std::max(a, b);
+  }
+  inline scalar_t project(acc_t a) const {
+    return scalar_t(a);
+  }
+};
+
+template <typename scalar_t, typename acc_t>
+struct AbsMinAccOps {
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t /*idx*/) const {
+    return std::min(acc, std::abs(acc_t(data)));
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return std::min(a, b);
+  }
+  inline scalar_t project(acc_t a) const {
+    return scalar_t(a);
+  }
+};
+
+static bool accumulates_in_wider_type(ScalarType dtype) {
+  return dtype == ScalarType::Half || dtype == ScalarType::BFloat16;
+}
+
+// Note [Deterministic pairwise sum]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The parallel reduction above combines per-thread partials, so the
+// floating-point combination order -- and therefore the low bits of the
+// result -- depends on how many threads the machine has. Workloads that
+// need bit-stable sums across machine sizes can set
+// TORCH_DETERMINISTIC_REDUCTIONS=1: contiguous full sums then run as a
+// pairwise tree whose shape is derived from the element count alone.
+// Blocks of kDeterministicBlockSize elements are summed with a fixed
+// four-accumulator vector loop (Vec256 lane count does not vary across
+// CPU capabilities, so the shape is ISA-independent), the block partials
+// are folded in a fixed pairwise order, and the blocks themselves are
+// farmed out with parallel_for -- each partial is written independently,
+// so scheduling cannot affect the result. Pairwise blocking also bounds
+// the rounding error at O(log n) instead of O(n), so this is never less
+// accurate than the default path.
+
+constexpr int64_t kDeterministicBlockSize = 65536;
+
+static bool deterministic_reductions_enabled() {
+  static const char* env = std::getenv("TORCH_DETERMINISTIC_REDUCTIONS");
+  static const bool enabled = env && env[0] == '1';
+  return enabled;
+}
+
+static bool deterministic_sum_eligible(TensorIterator& iter) {
+  return deterministic_reductions_enabled() && iter.ntensors() == 2 &&
+      iter.num_output_elements() == 1 && iter.is_contiguous() &&
+      iter.dtype(0) == iter.dtype(1) &&
+      (iter.dtype() == ScalarType::Float || iter.dtype() == ScalarType::Double);
+}
+
+template <typename scalar_t>
+scalar_t deterministic_block_sum(const scalar_t* data, int64_t n) {
+  using Vec = Vec256<scalar_t>;
+  Vec acc0(0), acc1(0), acc2(0), acc3(0);
+  int64_t d = 0;
+  for (; d + 4 * Vec::size() <= n; d += 4 * Vec::size()) {
+    acc0 = acc0 + Vec::loadu(data + d);
+    acc1 = acc1 + Vec::loadu(data + d + Vec::size());
+    acc2 = acc2 + Vec::loadu(data + d + 2 * Vec::size());
+    acc3 = acc3 + Vec::loadu(data + d + 3 * Vec::size());
+  }
+  Vec acc = (acc0 + acc1) + (acc2 + acc3);
+  scalar_t lanes[Vec::size()];
+  acc.store(lanes);
+  scalar_t sum = lanes[0];
+  for (int i = 1; i < Vec::size(); i++) {
+    sum += lanes[i];
+  }
+  for (; d < n; d++) {
+    sum += data[d];
+  }
+  return sum;
+}
+
+template <typename scalar_t>
+scalar_t deterministic_pairwise_sum(const scalar_t* data, int64_t n) {
+  if (n == 0) {
+    return scalar_t(0);
+  }
+  int64_t num_blocks =
+      (n + kDeterministicBlockSize - 1) / kDeterministicBlockSize;
+  std::vector<scalar_t> partials(num_blocks);
+  at::parallel_for(0, num_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t block = begin; block < end; block++) {
+      int64_t offset = block * kDeterministicBlockSize;
+      partials[block] = deterministic_block_sum(
+          data + offset, std::min(kDeterministicBlockSize, n - offset));
+    }
+  });
+  // Fold the partials pairwise; reads run ahead of writes, so this is safe
+  // in place.
+  int64_t m = num_blocks;
+  while (m > 1) {
+    int64_t half = m / 2;
+    for (int64_t i = 0; i < half; i++) {
+      partials[i] = partials[2 * i] + partials[2 * i + 1];
+    }
+    if (m % 2 != 0) {
+      partials[half] = partials[m - 1];
+      half++;
+    }
+    m = half;
+  }
+  return partials[0];
+}
+
 static void sum_kernel_impl(TensorIterator& iter) {
+  if (deterministic_sum_eligible(iter)) {
+    // See Note [Deterministic pairwise sum]
+    AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "sum_cpu", [&] {
+      *static_cast<scalar_t*>(iter.data_ptr(0)) =
+          deterministic_pairwise_sum(
+              static_cast<const scalar_t*>(iter.data_ptr(1)), iter.numel());
+    });
+    return;
+  }
+  if (accumulates_in_wider_type(iter.dtype())) {
+    // See Note [Full-width accumulation for reduced-precision inputs]
+    AT_DISPATCH_FLOATING_TYPES_AND2(
+        ScalarType::Half, ScalarType::BFloat16, iter.dtype(), "sum_cpu", [&] {
+          using acc_t = at::acc_type<scalar_t, false>;
+          binary_kernel_reduce(iter, SumAccOps<scalar_t, acc_t>(), acc_t(0));
+        });
+    return;
+  }
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(
       ScalarType::BFloat16, ScalarType::Bool, iter.dtype(), "sum_cpu", [&] {
         binary_kernel_reduce_vec(
@@ -25,6 +248,18 @@ static void sum_kernel_impl(TensorIterator& iter) {
 }
 
 static void mean_kernel_impl(TensorIterator& iter) {
+  if (accumulates_in_wider_type(iter.dtype())) {
+    // See Note [Full-width accumulation for reduced-precision inputs]
+    AT_DISPATCH_FLOATING_TYPES_AND2(
+        ScalarType::Half, ScalarType::BFloat16, iter.dtype(), "mean_cpu", [&] {
+          using acc_t = at::acc_type<scalar_t, false>;
+          acc_t factor =
+              acc_t(iter.num_output_elements()) / acc_t(iter.numel());
+          binary_kernel_reduce(
+              iter, MeanAccOps<scalar_t, acc_t>{factor}, acc_t(0));
+        });
+    return;
+  }
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX(iter.dtype(), "mean_cpu", [&] {
     scalar_t factor = scalar_t(iter.num_output_elements()) / scalar_t(iter.numel());
     binary_kernel_reduce(
@@ -67,6 +302,32 @@ static void norm_kernel_tensor_iterator_impl(
     AT_ERROR("norm_kernel_tensor_iterator_impl expects norm to be integer or float");
   }
 
+  if (accumulates_in_wider_type(iter.dtype())) {
+    // See Note [Full-width accumulation for reduced-precision inputs]
+    AT_DISPATCH_FLOATING_TYPES_AND2(
+        ScalarType::Half, ScalarType::BFloat16, iter.dtype(), "norm_cpu", [&] {
+          using acc_t = at::acc_type<scalar_t, false>;
+          if (val == 0) {
+            binary_kernel_reduce(
+                iter, NormZeroAccOps<scalar_t, acc_t>(), acc_t(0));
+          } else if (val == 1) {
+            binary_kernel_reduce(
+                iter, NormOneAccOps<scalar_t, acc_t>(), acc_t(0));
+          } else if (val == INFINITY) {
+            binary_kernel_reduce(
+                iter, AbsMaxAccOps<scalar_t, acc_t>(), acc_t(0));
+          } else if (val == -INFINITY) {
+            binary_kernel_reduce(
+                iter,
+                AbsMinAccOps<scalar_t, acc_t>(),
+                std::numeric_limits<acc_t>::max());
+          } else {
+            binary_kernel_reduce(
+                iter, NormAccOps<scalar_t, acc_t>{acc_t(val)}, acc_t(0));
+          }
+        });
+    return;
+  }
 
   if (val == 0) {
     AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(iter.dtype(), "norm_cpu", [&] {
@@ -5,10 +5,197 @@
 #include <ATen/native/Sorting.h>
 #include <ATen/native/SortingUtils.h>
 
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
 namespace at { namespace native {
 
 namespace {
 
+// Unsigned key type of the order-preserving bit encoding used by the
+// histogram top-k engine below. The primary template covers the integral
+// types; the specializations give floats a same-width unsigned carrier.
+template <typename scalar_t>
+struct order_traits {
+  using unsigned_t = typename std::make_unsigned<scalar_t>::type;
+};
+template <>
+struct order_traits<float> {
+  using unsigned_t = uint32_t;
+};
+template <>
+struct order_traits<double> {
+  using unsigned_t = uint64_t;
+};
+
+// Maps a float onto an unsigned key with the same ordering: positive
+// values get the sign bit set, negative values are bitwise complemented
+// (which reverses their order). NaN is canonicalized to the maximum key so
+// it sorts above everything, matching the NaN-as-top comparators used by
+// the sort-based paths.
+template <typename scalar_t>
+static inline typename order_traits<scalar_t>::unsigned_t order_encode(
+    scalar_t v,
+    std::true_type /*is_floating_point*/) {
+  using unsigned_t = typename order_traits<scalar_t>::unsigned_t;
+  if (_isnan<scalar_t>(v)) {
+    return std::numeric_limits<unsigned_t>::max();
+  }
+  unsigned_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  const unsigned_t sign_bit = unsigned_t(1) << (8 * sizeof(unsigned_t) - 1);
+  return (bits & sign_bit) ? static_cast<unsigned_t>(~bits)
+                           : static_cast<unsigned_t>(bits | sign_bit);
+}
+
+template <typename scalar_t>
+static inline typename order_traits<scalar_t>::unsigned_t order_encode(
+    scalar_t v,
+    std::false_type /*is_floating_point*/) {
+  using unsigned_t = typename order_traits<scalar_t>::unsigned_t;
+  unsigned_t bits = static_cast<unsigned_t>(v);
+  if (std::is_signed<scalar_t>::value) {
+    bits ^= unsigned_t(1) << (8 * sizeof(unsigned_t) - 1);
+  }
+  return bits;
+}
+
+// Histogram/filter top-k engine for large slices with small k. The k-th
+// value's key is found by MSD radix refinement: each pass histograms one
+// 8-bit digit of the order-preserving encoding over the elements matching
+// the prefix fixed so far, and descends into the digit that contains the
+// k-th key. A final parallel filter pass collects everything below the
+// threshold key plus enough threshold keys to fill k. Unlike the
+// sort-based paths there is no O(n) copy of value/index pairs and no
+// partial sort of the whole input; only the k results are sorted.
+template <typename scalar_t>
+static void topk_histogram_impl(
+    TensorAccessor<scalar_t, 1> input,
+    TensorAccessor<scalar_t, 1> out_values,
+    TensorAccessor<int64_t, 1> out_indices,
+    int64_t k,
+    bool largest) {
+  using unsigned_t = typename order_traits<scalar_t>::unsigned_t;
+  constexpr int kRadixBits = 8;
+  constexpr int kRadixSize = 1 << kRadixBits;
+  constexpr int kPasses = sizeof(scalar_t);
+  const int64_t n = input.size(0);
+
+  // Selecting the k largest keys is selecting the k smallest complemented
+  // keys, so the refinement below always looks for the k-th smallest.
+  const unsigned_t flip = largest ? static_cast<unsigned_t>(~unsigned_t(0))
+                                  : static_cast<unsigned_t>(0);
+  auto key_of = [&](int64_t i) -> unsigned_t {
+    return order_encode(input[i], std::is_floating_point<scalar_t>()) ^ flip;
+  };
+
+  const int64_t num_chunks = std::max(
+      (int64_t)1, std::min((int64_t)at::get_num_threads(), n / 4096));
+  const int64_t chunk_size = (n + num_chunks - 1) / num_chunks;
+  std::vector<int64_t> counts(num_chunks * kRadixSize);
+
+  unsigned_t prefix = 0;
+  unsigned_t prefix_mask = 0;
+  int64_t rank = k;
+  for (int pass = kPasses - 1; pass >= 0; pass--) {
+    const int shift = pass * kRadixBits;
+    std::fill(counts.begin(), counts.end(), 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (int64_t c = cbegin; c < cend; c++) {
+        int64_t* local = counts.data() + c * kRadixSize;
+        const int64_t end = std::min(n, (c + 1) * chunk_size);
+        for (int64_t i = c * chunk_size; i < end; i++) {
+          const unsigned_t key = key_of(i);
+          if ((key & prefix_mask) == prefix) {
+            local[(key >> shift) & (kRadixSize - 1)]++;
+          }
+        }
+      }
+    });
+    int64_t digit = kRadixSize - 1;
+    for (int64_t d = 0; d < kRadixSize; d++) {
+      int64_t count = 0;
+      for (int64_t c = 0; c < num_chunks; c++) {
+        count += counts[c * kRadixSize + d];
+      }
+      if (rank <= count) {
+        digit = d;
+        break;
+      }
+      rank -= count;
+    }
+    prefix |= static_cast<unsigned_t>(digit) << shift;
+    prefix_mask |= static_cast<unsigned_t>(kRadixSize - 1) << shift;
+  }
+  const unsigned_t threshold = prefix;
+
+  // count per chunk, scan, then scatter: keys below the threshold fill the
+  // front of the result, threshold keys fill the remaining slots
+  std::vector<int64_t> less_offsets(num_chunks);
+  std::vector<int64_t> equal_offsets(num_chunks);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+    for (int64_t c = cbegin; c < cend; c++) {
+      int64_t num_less = 0;
+      int64_t num_equal = 0;
+      const int64_t end = std::min(n, (c + 1) * chunk_size);
+      for (int64_t i = c * chunk_size; i < end; i++) {
+        const unsigned_t key = key_of(i);
+        num_less += key < threshold;
+        num_equal += key == threshold;
+      }
+      less_offsets[c] = num_less;
+      equal_offsets[c] = num_equal;
+    }
+  });
+  int64_t num_less = 0;
+  int64_t num_equal = 0;
+  for (int64_t c = 0; c < num_chunks; c++) {
+    const int64_t less = less_offsets[c];
+    const int64_t equal = equal_offsets[c];
+    less_offsets[c] = num_less;
+    equal_offsets[c] = num_equal;
+    num_less += less;
+    num_equal += equal;
+  }
+
+  using elem_t = std::pair<scalar_t, int64_t>;
+  std::vector<elem_t> top(k);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+    for (int64_t c = cbegin; c < cend; c++) {
+      int64_t less_pos = less_offsets[c];
+      int64_t equal_pos = num_less + equal_offsets[c];
+      const int64_t end = std::min(n, (c + 1) * chunk_size);
+      for (int64_t i = c * chunk_size; i < end; i++) {
+        const unsigned_t key = key_of(i);
+        if (key < threshold) {
+          top[less_pos++] = elem_t(input[i], i);
+        } else if (key == threshold && equal_pos < k) {
+          top[equal_pos++] = elem_t(input[i], i);
+        }
+      }
+    }
+  });
+
+  // only k elements left to order; matches the sort-based paths, which
+  // also produce sorted output in the small-k regime
+  if (largest) {
+    std::sort(top.begin(), top.end(),
+      [](const elem_t& x, const elem_t& y) -> bool {
+        return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
+      });
+  } else {
+    std::sort(top.begin(), top.end(),
+      [](const elem_t& x, const elem_t& y) -> bool {
+        return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
+      });
+  }
+  for (int64_t j = 0; j < k; j++) {
+    out_values[j] = top[j].first;
+    out_indices[j] = top[j].second;
+  }
+}
+
 static void topk_kernel(
     Tensor& values,
     Tensor& indices,
@@ -29,6 +216,15 @@ static void topk_kernel(
           auto n = tmp_values.size(0);
           auto use_partial_sort = k * 64 <= n;
 
+          // Large slice, small k: two-pass histogram/filter selection
+          // instead of copying the whole slice into a pair vector.
+          constexpr int64_t kMinHistogramSize = int64_t(1) << 16;
+          if (k > 0 && n >= kMinHistogramSize && use_partial_sort) {
+            topk_histogram_impl(
+                tmp_values, mode_values, mode_indices, k, largest);
+            return;
+          }
+
           using elem_t = std::pair<scalar_t, int64_t>;
           std::vector<elem_t> queue(n);
           for (int64_t j = 0; j < n; j++) {
@@ -83,8 +279,145 @@ static void topk_kernel(
   });
 }
 
+// Maps an integral key onto an unsigned key with the same ordering, so
+// that plain unsigned digit comparisons sort signed values correctly.
+// Flipping the sign bit moves negative values below positive ones.
+template <typename scalar_t>
+static inline typename std::make_unsigned<scalar_t>::type radix_encode(
+    scalar_t v) {
+  using unsigned_t = typename std::make_unsigned<scalar_t>::type;
+  unsigned_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  if (std::is_signed<scalar_t>::value) {
+    bits ^= unsigned_t(1) << (8 * sizeof(unsigned_t) - 1);
+  }
+  return bits;
+}
+
+template <typename scalar_t>
+static inline scalar_t radix_decode(
+    typename std::make_unsigned<scalar_t>::type bits) {
+  using unsigned_t = typename std::make_unsigned<scalar_t>::type;
+  if (std::is_signed<scalar_t>::value) {
+    bits ^= unsigned_t(1) << (8 * sizeof(unsigned_t) - 1);
+  }
+  scalar_t v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+// Stable LSD radix sort over 8-bit digits. Each pass builds per-chunk
+// histograms in parallel, turns them into digit-major exclusive offsets
+// (so ties keep their original chunk order), and scatters in parallel.
+// Passes where a single digit value covers the whole input are skipped,
+// which makes small-range index tensors (the common case for int64
+// indices) effectively single-pass.
+template <typename scalar_t>
+static void radix_sort_impl(
+    scalar_t* keys,
+    int64_t* indices,
+    int64_t n,
+    bool descending) {
+  using unsigned_t = typename std::make_unsigned<scalar_t>::type;
+  constexpr int kRadixBits = 8;
+  constexpr int kRadixSize = 1 << kRadixBits;
+  constexpr int kPasses = sizeof(scalar_t);
+
+  const int64_t num_chunks = std::max(
+      (int64_t)1, std::min((int64_t)at::get_num_threads(), n / 4096));
+  const int64_t chunk_size = (n + num_chunks - 1) / num_chunks;
+
+  std::vector<unsigned_t> ukeys_a(n);
+  std::vector<unsigned_t> ukeys_b(n);
+  std::vector<int64_t> idx_a(n);
+  std::vector<int64_t> idx_b(n);
+
+  at::parallel_for(0, n, 2048, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      ukeys_a[i] = radix_encode(keys[i]);
+      idx_a[i] = i;
+    }
+  });
+
+  unsigned_t* src_keys = ukeys_a.data();
+  unsigned_t* dst_keys = ukeys_b.data();
+  int64_t* src_idx = idx_a.data();
+  int64_t* dst_idx = idx_b.data();
+
+  std::vector<int64_t> counts(num_chunks * kRadixSize);
+  for (int pass = 0; pass < kPasses; pass++) {
+    const int shift = pass * kRadixBits;
+
+    std::fill(counts.begin(), counts.end(), 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (int64_t c = cbegin; c < cend; c++) {
+        int64_t* local = counts.data() + c * kRadixSize;
+        const int64_t end = std::min(n, (c + 1) * chunk_size);
+        for (int64_t i = c * chunk_size; i < end; i++) {
+          local[(src_keys[i] >> shift) & (kRadixSize - 1)]++;
+        }
+      }
+    });
+
+    // Digit-major exclusive prefix sum: the slot for (chunk, digit) starts
+    // after all smaller digits and after the same digit in earlier chunks.
+    bool skip_pass = false;
+    int64_t running = 0;
+    for (int64_t d = 0; d < kRadixSize; d++) {
+      for (int64_t c = 0; c < num_chunks; c++) {
+        const int64_t count = counts[c * kRadixSize + d];
+        counts[c * kRadixSize + d] = running;
+        running += count;
+        if (count == n) {
+          skip_pass = true;
+        }
+      }
+    }
+    if (skip_pass) {
+      continue;
+    }
+
+    at::parallel_for(0, num_chunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (int64_t c = cbegin; c < cend; c++) {
+        int64_t* offsets = counts.data() + c * kRadixSize;
+        const int64_t end = std::min(n, (c + 1) * chunk_size);
+        for (int64_t i = c * chunk_size; i < end; i++) {
+          const int64_t dst = offsets[(src_keys[i] >> shift) & (kRadixSize - 1)]++;
+          dst_keys[dst] = src_keys[i];
+          dst_idx[dst] = src_idx[i];
+        }
+      }
+    });
+
+    std::swap(src_keys, dst_keys);
+    std::swap(src_idx, dst_idx);
+  }
+
+  at::parallel_for(0, n, 2048, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const int64_t j = descending ? n - 1 - i : i;
+      keys[i] = radix_decode<scalar_t>(src_keys[j]);
+      indices[i] = src_idx[j];
+    }
+  });
+}
+
+static void radix_sort_kernel(
+    Tensor& values,
+    Tensor& indices,
+    bool descending) {
+  AT_DISPATCH_INTEGRAL_TYPES(values.scalar_type(), "radix_sort_cpu", [&] {
+    radix_sort_impl<scalar_t>(
+        values.data_ptr<scalar_t>(),
+        indices.data_ptr<int64_t>(),
+        values.numel(),
+        descending);
+  });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(topk_stub, &topk_kernel);
+REGISTER_DISPATCH(radix_sort_stub, &radix_sort_kernel);
 
 }} //at::native
@@ -5,6 +5,7 @@
 #include <ATen/ATen.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
+#include <ATen/core/PhiloxRNGEngine.h>
 
 namespace at {
 namespace native {
@@ -76,6 +77,113 @@ void LayerNormKernelImpl(
   });
 }
 
+template <typename T>
+void DropoutAddLayerNormKernelImplInternal(
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    T eps,
+    double p,
+    uint64_t seed,
+    Tensor* Y,
+    Tensor* mask,
+    Tensor* mean,
+    Tensor* rstd) {
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK_EQ(R.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const T* X_data = X.data_ptr<T>();
+  const T* R_data = R.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* Y_data = Y->data_ptr<T>();
+  uint8_t* mask_data = mask->data_ptr<uint8_t>();
+  T* mean_data = mean->data_ptr<T>();
+  T* rstd_data = rstd->data_ptr<T>();
+  const T c = T(1) / static_cast<T>(N);
+  const float keep_prob = static_cast<float>(1 - p);
+  const T keep_scale = T(1) / static_cast<T>(keep_prob);
+  const bool gamma_null = gamma_data == nullptr;
+  const bool beta_null = beta_data == nullptr;
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const T* X_ptr = X_data + i * N;
+      const T* R_ptr = R_data + i * N;
+      T* Y_ptr = Y_data + i * N;
+      uint8_t* mask_ptr = mask_data + i * N;
+      // One Philox subsequence per row keeps the mask independent of how
+      // rows are chunked across threads.
+      at::Philox4_32_10 engine(seed, static_cast<uint64_t>(i), 0);
+      T mean_val = T(0);
+      T rstd_val = T(0);
+      for (int64_t j = 0; j < N; ++j) {
+        T x = X_ptr[j];
+        if (p > 0) {
+          const float u = engine() * (1.0f / 4294967296.0f); // 2^-32
+          const uint8_t keep = u < keep_prob;
+          mask_ptr[j] = keep;
+          x = keep ? x * keep_scale : T(0);
+        } else {
+          mask_ptr[j] = 1;
+        }
+        const T a = x + R_ptr[j];
+        Y_ptr[j] = a;
+        mean_val += a;
+        rstd_val += a * a;
+      }
+      mean_val *= c;
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, T(0));
+      rstd_val = T(1) / std::sqrt(rstd_val + eps);
+      const T scale = rstd_val;
+      const T bias = -rstd_val * mean_val;
+      for (int64_t j = 0; j < N; ++j) {
+        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
+        const T beta_v = beta_null ? T(0) : beta_data[j];
+        Y_ptr[j] = (Y_ptr[j] * scale + bias) * gamma_v + beta_v;
+      }
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+}
+
+void DropoutAddLayerNormKernelImpl(
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    double eps,
+    double p,
+    uint64_t seed,
+    Tensor* Y,
+    Tensor* mask,
+    Tensor* mean,
+    Tensor* rstd) {
+  AT_DISPATCH_FLOATING_TYPES(
+      X.scalar_type(), "DropoutAddLayerNormKernelImpl", [&]() {
+        DropoutAddLayerNormKernelImplInternal<scalar_t>(
+            X,
+            R,
+            gamma,
+            beta,
+            M,
+            N,
+            static_cast<scalar_t>(eps),
+            p,
+            seed,
+            Y,
+            mask,
+            mean,
+            rstd);
+      });
+}
+
 template <typename T>
 void LayerNormBackwardKernelImplInternal(
     const Tensor& dY,
@@ -167,6 +275,7 @@ void LayerNormBackwardKernelImpl(
 
 REGISTER_DISPATCH(LayerNormKernel, &LayerNormKernelImpl);
 REGISTER_DISPATCH(LayerNormBackwardKernel, &LayerNormBackwardKernelImpl);
+REGISTER_DISPATCH(DropoutAddLayerNormKernel, &DropoutAddLayerNormKernelImpl);
 
 } // namespace native
 } // namespace at
@@ -326,6 +326,42 @@ void GeluBackwardCUDAKernelImpl(TensorIterator& it) {
       });
 }
 
+void FastGeluCUDAKernelImpl(TensorIterator& it) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      it.dtype(), "FastGeluCUDAKernelImpl", [&]() {
+        using T_ACC = acc_type<scalar_t, true>;
+        gpu_kernel(it, [] GPU_LAMBDA(scalar_t x) -> scalar_t {
+          constexpr T_ACC kBeta = M_2_SQRTPI * M_SQRT1_2;
+          constexpr T_ACC kKappa = 0.044715;
+          const T_ACC x_acc = static_cast<T_ACC>(x);
+          const T_ACC inner = kBeta * (x_acc + kKappa * x_acc * x_acc * x_acc);
+          return x_acc * T_ACC(0.5) *
+              (T_ACC(1) + c10::cuda::compat::tanh(inner));
+        });
+      });
+}
+
+void FastGeluBackwardCUDAKernelImpl(TensorIterator& it) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      it.dtype(), "FastGeluBackwardCUDAKernelImpl", [&]() {
+        using T_ACC = acc_type<scalar_t, true>;
+        gpu_kernel(it, [] GPU_LAMBDA(scalar_t dy, scalar_t x) -> scalar_t {
+          constexpr T_ACC kBeta = M_2_SQRTPI * M_SQRT1_2;
+          constexpr T_ACC kKappa = 0.044715;
+          const T_ACC x_acc = static_cast<T_ACC>(x);
+          const T_ACC inner = kBeta * (x_acc + kKappa * x_acc * x_acc * x_acc);
+          const T_ACC tanh_inner = c10::cuda::compat::tanh(inner);
+          const T_ACC left_derivative = T_ACC(0.5) * (T_ACC(1) + tanh_inner);
+          const T_ACC inner_derivative =
+              kBeta * (T_ACC(1) + T_ACC(3) * kKappa * x_acc * x_acc);
+          const T_ACC right_derivative = T_ACC(0.5) * x_acc *
+              (T_ACC(1) - tanh_inner * tanh_inner) * inner_derivative;
+          return static_cast<T_ACC>(dy) *
+              (left_derivative + right_derivative);
+        });
+      });
+}
+
 } // namespace
 
 Tensor gelu_cuda(const Tensor& self) {
@@ -342,8 +378,24 @@ Tensor gelu_backward_cuda(const Tensor& grad, const Tensor& self) {
   return dX;
 }
 
+Tensor fast_gelu_cuda(const Tensor& self) {
+  Tensor Y = at::native::empty_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto it = TensorIterator::unary_op(Y, self);
+  FastGeluKernel(kCUDA, it);
+  return Y;
+}
+
+Tensor fast_gelu_backward_cuda(const Tensor& grad, const Tensor& self) {
+  Tensor dX = at::native::empty_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto it = TensorIterator::binary_op(dX, grad, self);
+  FastGeluBackwardKernel(kCUDA, it);
+  return dX;
+}
+
 REGISTER_DISPATCH(threshold_stub, &threshold_kernel);
 REGISTER_DISPATCH(GeluKernel, &GeluCUDAKernelImpl);
 REGISTER_DISPATCH(GeluBackwardKernel, &GeluBackwardCUDAKernelImpl);
+REGISTER_DISPATCH(FastGeluKernel, &FastGeluCUDAKernelImpl);
+REGISTER_DISPATCH(FastGeluBackwardKernel, &FastGeluBackwardCUDAKernelImpl);
 
 }}  // namespace at::native
@@ -3,6 +3,7 @@
 #include <ATen/Dispatch.h>
 #include <ATen/cuda/CUDAContext.h>
 #include <ATen/cuda/CUDAEvent.h>
+#include <ATen/cuda/PinnedStagingRing.h>
 #include <c10/cuda/CUDAStream.h>
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
@@ -177,6 +178,15 @@ static void copy_kernel_cuda(TensorIterator& iter, bool non_blocking) {
   int64_t nbytes = iter.numel() * iter.element_size(0);
   CUDAStream stream = getCurrentCUDAStream();
 
+  // Small uploads from pageable memory go through the pinned staging ring:
+  // the source bytes are captured before returning, so neither the event
+  // record below nor the blocking stream synchronize is needed. See
+  // Note [Pinned staging ring] in ATen/cuda/PinnedStagingRing.h.
+  if (kind == cudaMemcpyHostToDevice && !iter.tensor(1).is_pinned() &&
+      at::cuda::stagedCopyH2D(dst, src, nbytes, stream)) {
+    return;
+  }
+
   AT_CUDA_CHECK(cudaMemcpyAsync(dst, src, nbytes, kind, stream));
 
   if (non_blocking) {
@@ -0,0 +1,280 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <THC/THCAtomics.cuh>
+
+namespace at {
+namespace native {
+
+namespace {
+
+constexpr int kGroupedIndexSelectNumThreads = 128;
+constexpr int64_t kGroupedIndexSelectMaxBlocks = 131072;
+
+// Metadata layout for the grouped kernels, packed into a single int64
+// device buffer so that one H2D copy covers any number of groups:
+//   [0, G]              exclusive prefix sum of output rows per group
+//   [G + 1, 2G]         row width (columns) per group
+//   [2G + 1, 3G]        source (table or grad) pointers
+//   [3G + 1, 4G]        index pointers
+//   [4G + 1, 5G]        destination pointers
+//
+// Each block owns one output row at a time (grid-stride): it binary
+// searches the prefix sum for its group, then the threads copy (or
+// atomically accumulate) the row's columns cooperatively. A single launch
+// covers every group, which is the whole point - thousands of small
+// per-shard index_selects otherwise pay a kernel launch each.
+template <typename scalar_t>
+__global__ void GroupedIndexSelectKernel(
+    int64_t num_groups,
+    int64_t total_rows,
+    const int64_t* meta) {
+  const int64_t* rows_prefix = meta;
+  const int64_t* cols = meta + num_groups + 1;
+  const int64_t* src_ptrs = cols + num_groups;
+  const int64_t* idx_ptrs = src_ptrs + num_groups;
+  const int64_t* dst_ptrs = idx_ptrs + num_groups;
+  for (int64_t row = blockIdx.x; row < total_rows; row += gridDim.x) {
+    int64_t lo = 0;
+    int64_t hi = num_groups - 1;
+    while (lo < hi) {
+      const int64_t mid = (lo + hi + 1) / 2;
+      if (rows_prefix[mid] <= row) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    const int64_t g = lo;
+    const int64_t local = row - rows_prefix[g];
+    const scalar_t* src = reinterpret_cast<const scalar_t*>(src_ptrs[g]);
+    const int64_t* idx = reinterpret_cast<const int64_t*>(idx_ptrs[g]);
+    scalar_t* dst = reinterpret_cast<scalar_t*>(dst_ptrs[g]);
+    const int64_t C = cols[g];
+    const int64_t src_row = idx[local];
+    for (int64_t j = threadIdx.x; j < C; j += blockDim.x) {
+      dst[local * C + j] = src[src_row * C + j];
+    }
+  }
+}
+
+// Backward: same walk over grad rows, scatter-added into the per-table
+// weight gradients. Rows selected more than once accumulate through
+// atomics.
+template <typename scalar_t>
+__global__ void GroupedIndexSelectBackwardKernel(
+    int64_t num_groups,
+    int64_t total_rows,
+    const int64_t* meta) {
+  const int64_t* rows_prefix = meta;
+  const int64_t* cols = meta + num_groups + 1;
+  const int64_t* src_ptrs = cols + num_groups;
+  const int64_t* idx_ptrs = src_ptrs + num_groups;
+  const int64_t* dst_ptrs = idx_ptrs + num_groups;
+  for (int64_t row = blockIdx.x; row < total_rows; row += gridDim.x) {
+    int64_t lo = 0;
+    int64_t hi = num_groups - 1;
+    while (lo < hi) {
+      const int64_t mid = (lo + hi + 1) / 2;
+      if (rows_prefix[mid] <= row) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    const int64_t g = lo;
+    const int64_t local = row - rows_prefix[g];
+    const scalar_t* grad = reinterpret_cast<const scalar_t*>(src_ptrs[g]);
+    const int64_t* idx = reinterpret_cast<const int64_t*>(idx_ptrs[g]);
+    scalar_t* grad_weight = reinterpret_cast<scalar_t*>(dst_ptrs[g]);
+    const int64_t C = cols[g];
+    const int64_t dst_row = idx[local];
+    for (int64_t j = threadIdx.x; j < C; j += blockDim.x) {
+      atomicAdd(&grad_weight[dst_row * C + j], grad[local * C + j]);
+    }
+  }
+}
+
+void check_grouped_index_select_args(TensorList tensors, TensorList indices) {
+  TORCH_CHECK(
+      tensors.size() == indices.size(),
+      "grouped_index_select: expected as many index tensors as inputs, got ",
+      tensors.size(),
+      " inputs and ",
+      indices.size(),
+      " index tensors");
+  for (size_t i = 0; i < indices.size(); ++i) {
+    TORCH_CHECK(
+        indices[i].scalar_type() == kLong,
+        "grouped_index_select: expected indices of scalar type Long, but got ",
+        indices[i].scalar_type(),
+        " for group ",
+        i);
+    TORCH_CHECK(
+        indices[i].dim() == 1,
+        "grouped_index_select: expected 1-D indices, but got ",
+        indices[i].dim(),
+        "-D indices for group ",
+        i);
+  }
+}
+
+// The batched kernel handles the common sharded-embedding shape: 2-D
+// contiguous tables of one dtype with contiguous 1-D indices, all on the
+// current device. Anything else goes through the per-pair fallback.
+bool can_use_grouped_kernel(TensorList tensors, TensorList indices) {
+  if (tensors.empty()) {
+    return false;
+  }
+  const auto dtype = tensors[0].scalar_type();
+  const auto device = tensors[0].device();
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (tensors[i].dim() != 2 || !tensors[i].is_contiguous() ||
+        tensors[i].scalar_type() != dtype || tensors[i].device() != device ||
+        !indices[i].is_contiguous() || indices[i].device() != device) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Builds the device metadata buffer described above. `srcs`/`dsts` are the
+// per-group source and destination data pointers; `rows` are the output
+// rows per group.
+Tensor build_grouped_meta(
+    const std::vector<const void*>& srcs,
+    const std::vector<const void*>& idxs,
+    const std::vector<void*>& dsts,
+    const std::vector<int64_t>& rows,
+    const std::vector<int64_t>& cols,
+    const Device& device,
+    int64_t* total_rows_out) {
+  const int64_t G = srcs.size();
+  Tensor meta_cpu = at::empty({5 * G + 1}, at::device(kCPU).dtype(kLong));
+  int64_t* m = meta_cpu.data_ptr<int64_t>();
+  int64_t total_rows = 0;
+  for (int64_t i = 0; i < G; ++i) {
+    m[i] = total_rows;
+    total_rows += rows[i];
+    m[G + 1 + i] = cols[i];
+    m[2 * G + 1 + i] = reinterpret_cast<int64_t>(srcs[i]);
+    m[3 * G + 1 + i] = reinterpret_cast<int64_t>(idxs[i]);
+    m[4 * G + 1 + i] = reinterpret_cast<int64_t>(dsts[i]);
+  }
+  m[G] = total_rows;
+  *total_rows_out = total_rows;
+  return meta_cpu.to(device);
+}
+
+} // namespace
+
+std::vector<Tensor> grouped_index_select_cuda(
+    TensorList tensors,
+    TensorList indices) {
+  check_grouped_index_select_args(tensors, indices);
+  if (!can_use_grouped_kernel(tensors, indices)) {
+    std::vector<Tensor> results;
+    results.reserve(tensors.size());
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      results.push_back(at::index_select(tensors[i], 0, indices[i]));
+    }
+    return results;
+  }
+
+  const int64_t G = tensors.size();
+  std::vector<Tensor> results;
+  results.reserve(G);
+  std::vector<const void*> srcs(G);
+  std::vector<const void*> idxs(G);
+  std::vector<void*> dsts(G);
+  std::vector<int64_t> rows(G);
+  std::vector<int64_t> cols(G);
+  for (int64_t i = 0; i < G; ++i) {
+    rows[i] = indices[i].numel();
+    cols[i] = tensors[i].size(1);
+    results.push_back(at::empty({rows[i], cols[i]}, tensors[i].options()));
+    srcs[i] = tensors[i].data_ptr();
+    idxs[i] = indices[i].data_ptr();
+    dsts[i] = results[i].data_ptr();
+  }
+  int64_t total_rows = 0;
+  Tensor meta = build_grouped_meta(
+      srcs, idxs, dsts, rows, cols, tensors[0].device(), &total_rows);
+  if (total_rows == 0) {
+    return results;
+  }
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  const int64_t num_blocks =
+      std::min(total_rows, kGroupedIndexSelectMaxBlocks);
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::Half, tensors[0].scalar_type(), "grouped_index_select_cuda", [&] {
+        GroupedIndexSelectKernel<scalar_t>
+            <<<num_blocks, kGroupedIndexSelectNumThreads, 0, cuda_stream>>>(
+                G, total_rows, meta.data_ptr<int64_t>());
+      });
+  AT_CUDA_CHECK(cudaGetLastError());
+  return results;
+}
+
+std::vector<Tensor> grouped_index_select_backward_cuda(
+    TensorList grads,
+    TensorList indices,
+    IntArrayRef num_rows) {
+  check_grouped_index_select_args(grads, indices);
+  TORCH_CHECK(
+      grads.size() == num_rows.size(),
+      "grouped_index_select backward: expected as many row counts as grads, got ",
+      grads.size(),
+      " grads and ",
+      num_rows.size(),
+      " row counts");
+  const int64_t G = grads.size();
+  std::vector<Tensor> grad_tensors;
+  grad_tensors.reserve(G);
+  if (!can_use_grouped_kernel(grads, indices)) {
+    for (int64_t i = 0; i < G; ++i) {
+      std::vector<int64_t> sizes = grads[i].sizes().vec();
+      sizes[0] = num_rows[i];
+      grad_tensors.push_back(
+          at::zeros(sizes, grads[i].options())
+              .index_add_(0, indices[i], grads[i]));
+    }
+    return grad_tensors;
+  }
+
+  std::vector<const void*> srcs(G);
+  std::vector<const void*> idxs(G);
+  std::vector<void*> dsts(G);
+  std::vector<int64_t> rows(G);
+  std::vector<int64_t> cols(G);
+  for (int64_t i = 0; i < G; ++i) {
+    rows[i] = indices[i].numel();
+    cols[i] = grads[i].size(1);
+    grad_tensors.push_back(
+        at::zeros({num_rows[i], cols[i]}, grads[i].options()));
+    srcs[i] = grads[i].data_ptr();
+    idxs[i] = indices[i].data_ptr();
+    dsts[i] = grad_tensors[i].data_ptr();
+  }
+  int64_t total_rows = 0;
+  Tensor meta = build_grouped_meta(
+      srcs, idxs, dsts, rows, cols, grads[0].device(), &total_rows);
+  if (total_rows == 0) {
+    return grad_tensors;
+  }
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  const int64_t num_blocks =
+      std::min(total_rows, kGroupedIndexSelectMaxBlocks);
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      grads[0].scalar_type(), "grouped_index_select_backward_cuda", [&] {
+        GroupedIndexSelectBackwardKernel<scalar_t>
+            <<<num_blocks, kGroupedIndexSelectNumThreads, 0, cuda_stream>>>(
+                G, total_rows, meta.data_ptr<int64_t>());
+      });
+  AT_CUDA_CHECK(cudaGetLastError());
+  return grad_tensors;
+}
+
+} // namespace native
+} // namespace at
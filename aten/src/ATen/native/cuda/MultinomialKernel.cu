@@ -415,15 +415,11 @@ void multinomial_kernel_impl(Tensor& result, const Tensor& self, const int64_t n
       std::pair<uint64_t, uint64_t> rng_engine_inputs;
 
       if (with_replacement) {
-        {
-          // See Note [Acquire lock when using random generators]
-          std::lock_guard<std::mutex> lock(gen->mutex_);
-
-          // each thread will utilize one random, however, since we have to use
-          // curand_uniform4 (See Note [Register spilling in curand call for CUDA < 10]),
-          // offset is 4.
-          rng_engine_inputs = gen->philox_engine_inputs(4);
-        }
+        // See Note [Philox offset reservation is lock free]
+        // each thread will utilize one random, however, since we have to use
+        // curand_uniform4 (See Note [Register spilling in curand call for CUDA < 10]),
+        // offset is 4.
+        rng_engine_inputs = gen->philox_engine_inputs(4);
         // Sample with replacement
 
         // Binary search is warp divergent (so effectively we're running
@@ -466,15 +462,11 @@ void multinomial_kernel_impl(Tensor& result, const Tensor& self, const int64_t n
             // Prefix sum along rows
             legacy::cuda::_th_cumsum_out(prefixSum, normDist, 1);
           }
-          {
-            // See Note [Acquire lock when using random generators]
-            std::lock_guard<std::mutex> lock(gen->mutex_);
-
-            // each thread will utilize one random, however, since we have to use
-            // curand_uniform4 (See Note [Register spilling in curand call for CUDA < 10]),
-            // offset is 4.
-            rng_engine_inputs = gen->philox_engine_inputs(4);
-          }
+          // See Note [Philox offset reservation is lock free]
+          // each thread will utilize one random, however, since we have to use
+          // curand_uniform4 (See Note [Register spilling in curand call for CUDA < 10]),
+          // offset is 4.
+          rng_engine_inputs = gen->philox_engine_inputs(4);
 
           // The kernel can only draw one sample before we have to
           // recalculate our distribution
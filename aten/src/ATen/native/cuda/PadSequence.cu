@@ -0,0 +1,254 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/cuda/CUDAContext.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+constexpr int kPadSequenceNumThreads = 128;
+constexpr int64_t kPadSequenceMaxBlocks = 131072;
+
+// Metadata layout for both kernels, packed into a single int64 device
+// buffer so that one H2D copy covers any batch size:
+//   [0, B]          exclusive prefix sum of lengths per sequence
+//   [B + 1, 2B]     per-sequence data pointers (sources when padding,
+//                   destinations when unpadding)
+//
+// Each block owns one sequence row at a time (grid-stride): it binary
+// searches the prefix sum for its sequence, then the threads copy the
+// row's inner elements cooperatively. A single launch covers the whole
+// batch, replacing one narrow+copy_ kernel launch per sequence.
+template <typename scalar_t>
+__global__ void PadSequenceKernel(
+    int64_t batch_size,
+    int64_t max_len,
+    int64_t inner,
+    int64_t total_rows,
+    bool batch_first,
+    const int64_t* meta,
+    scalar_t* output) {
+  const int64_t* lengths_prefix = meta;
+  const int64_t* seq_ptrs = meta + batch_size + 1;
+  for (int64_t row = blockIdx.x; row < total_rows; row += gridDim.x) {
+    int64_t lo = 0;
+    int64_t hi = batch_size - 1;
+    while (lo < hi) {
+      const int64_t mid = (lo + hi + 1) / 2;
+      if (lengths_prefix[mid] <= row) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    const int64_t i = lo;
+    const int64_t t = row - lengths_prefix[i];
+    const scalar_t* src = reinterpret_cast<const scalar_t*>(seq_ptrs[i]);
+    const int64_t dst_row = batch_first ? i * max_len + t : t * batch_size + i;
+    for (int64_t j = threadIdx.x; j < inner; j += blockDim.x) {
+      output[dst_row * inner + j] = src[t * inner + j];
+    }
+  }
+}
+
+// Inverse walk: the same (sequence, time step) decomposition, reading the
+// padded batch and scattering into the per-sequence output tensors.
+template <typename scalar_t>
+__global__ void UnpadSequenceKernel(
+    int64_t batch_size,
+    int64_t max_len,
+    int64_t inner,
+    int64_t total_rows,
+    bool batch_first,
+    const int64_t* meta,
+    const scalar_t* padded) {
+  const int64_t* lengths_prefix = meta;
+  const int64_t* seq_ptrs = meta + batch_size + 1;
+  for (int64_t row = blockIdx.x; row < total_rows; row += gridDim.x) {
+    int64_t lo = 0;
+    int64_t hi = batch_size - 1;
+    while (lo < hi) {
+      const int64_t mid = (lo + hi + 1) / 2;
+      if (lengths_prefix[mid] <= row) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    const int64_t i = lo;
+    const int64_t t = row - lengths_prefix[i];
+    scalar_t* dst = reinterpret_cast<scalar_t*>(seq_ptrs[i]);
+    const int64_t src_row = batch_first ? i * max_len + t : t * batch_size + i;
+    for (int64_t j = threadIdx.x; j < inner; j += blockDim.x) {
+      dst[t * inner + j] = padded[src_row * inner + j];
+    }
+  }
+}
+
+void check_pad_sequence_args(TensorList sequences) {
+  TORCH_CHECK(sequences.size() > 0, "pad_sequence: received an empty list of sequences");
+  TORCH_CHECK(sequences[0].dim() >= 1,
+           "pad_sequence: expected sequences of at least 1 dimension, but sequence 0 has ",
+           sequences[0].dim());
+  auto trailing_dims = sequences[0].sizes().slice(1);
+  for (size_t i = 1; i < sequences.size(); ++i) {
+    TORCH_CHECK(sequences[i].dim() == sequences[0].dim() &&
+             sequences[i].sizes().slice(1) == trailing_dims,
+             "pad_sequence: expected trailing dimensions of sequence ", i,
+             " to match those of sequence 0");
+    TORCH_CHECK(sequences[i].scalar_type() == sequences[0].scalar_type(),
+             "pad_sequence: expected all sequences to have scalar type ",
+             sequences[0].scalar_type(), ", but sequence ", i, " has ",
+             sequences[i].scalar_type());
+    TORCH_CHECK(sequences[i].device() == sequences[0].device(),
+             "pad_sequence: expected all sequences on the same device, but sequence ",
+             i, " is on ", sequences[i].device());
+  }
+}
+
+// Builds the device metadata buffer described above from per-sequence
+// lengths and data pointers.
+Tensor build_pad_sequence_meta(
+    const std::vector<int64_t>& lengths,
+    const std::vector<const void*>& ptrs,
+    const Device& device,
+    int64_t* total_rows_out) {
+  const int64_t batch_size = lengths.size();
+  Tensor meta_cpu = at::empty({2 * batch_size + 1}, at::device(kCPU).dtype(kLong));
+  int64_t* m = meta_cpu.data_ptr<int64_t>();
+  int64_t total_rows = 0;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    m[i] = total_rows;
+    total_rows += lengths[i];
+    m[batch_size + 1 + i] = reinterpret_cast<int64_t>(ptrs[i]);
+  }
+  m[batch_size] = total_rows;
+  *total_rows_out = total_rows;
+  return meta_cpu.to(device);
+}
+
+} // namespace
+
+Tensor pad_sequence_cuda(TensorList sequences, bool batch_first, double padding_value) {
+  check_pad_sequence_args(sequences);
+  const int64_t batch_size = sequences.size();
+  std::vector<Tensor> contig;
+  contig.reserve(batch_size);
+  std::vector<int64_t> lengths(batch_size);
+  std::vector<const void*> ptrs(batch_size);
+  int64_t max_len = 0;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    contig.push_back(sequences[i].contiguous());
+    lengths[i] = contig[i].size(0);
+    ptrs[i] = contig[i].data_ptr();
+    max_len = std::max(max_len, lengths[i]);
+  }
+
+  auto trailing_dims = sequences[0].sizes().slice(1);
+  int64_t inner = 1;
+  for (const auto dim : trailing_dims) {
+    inner *= dim;
+  }
+  std::vector<int64_t> output_size; // == [B, T, *] or [T, B, *]
+  output_size.reserve(sequences[0].dim() + 1);
+  output_size.push_back(batch_first ? batch_size : max_len);
+  output_size.push_back(batch_first ? max_len : batch_size);
+  output_size.insert(output_size.end(), trailing_dims.begin(), trailing_dims.end());
+  Tensor output = at::full(output_size, padding_value, sequences[0].options());
+  if (output.numel() == 0 || inner == 0) {
+    return output;
+  }
+
+  int64_t total_rows = 0;
+  Tensor meta = build_pad_sequence_meta(
+      lengths, ptrs, sequences[0].device(), &total_rows);
+  if (total_rows == 0) {
+    return output;
+  }
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  const int64_t num_blocks = std::min(total_rows, kPadSequenceMaxBlocks);
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::Half, output.scalar_type(), "pad_sequence_cuda", [&] {
+        PadSequenceKernel<scalar_t>
+            <<<num_blocks, kPadSequenceNumThreads, 0, cuda_stream>>>(
+                batch_size,
+                max_len,
+                inner,
+                total_rows,
+                batch_first,
+                meta.data_ptr<int64_t>(),
+                output.data_ptr<scalar_t>());
+      });
+  AT_CUDA_CHECK(cudaGetLastError());
+  return output;
+}
+
+std::vector<Tensor> unpad_sequence_cuda(const Tensor& padded, const Tensor& lengths, bool batch_first) {
+  auto lengths_t = lengths.contiguous();
+  TORCH_CHECK(lengths_t.dim() == 1 && lengths_t.device().type() == at::kCPU &&
+           lengths_t.scalar_type() == at::kLong,
+           "'lengths' argument should be a 1D CPU int64 tensor");
+  TORCH_CHECK(padded.dim() >= 2,
+           "unpad_sequence: expected padded input of at least 2 dimensions, but got ",
+           padded.dim());
+  const int64_t batch_size = batch_first ? padded.size(0) : padded.size(1);
+  const int64_t max_len = batch_first ? padded.size(1) : padded.size(0);
+  TORCH_CHECK(lengths_t.size(0) == batch_size,
+           "unpad_sequence: expected `len(lengths)` to be equal to batch_size, but got ",
+           lengths_t.size(0), " (batch_size=", batch_size, ")");
+
+  auto input = padded.contiguous();
+  auto trailing_dims = padded.sizes().slice(2);
+  int64_t inner = 1;
+  for (const auto dim : trailing_dims) {
+    inner *= dim;
+  }
+  const int64_t* lengths_data = lengths_t.data_ptr<int64_t>();
+  std::vector<Tensor> sequences;
+  sequences.reserve(batch_size);
+  std::vector<int64_t> lengths_vec(batch_size);
+  std::vector<const void*> ptrs(batch_size);
+  for (int64_t i = 0; i < batch_size; ++i) {
+    TORCH_CHECK(lengths_data[i] >= 0 && lengths_data[i] <= max_len,
+             "unpad_sequence: length ", lengths_data[i], " of sequence ", i,
+             " is out of range for a padded length of ", max_len);
+    std::vector<int64_t> sequence_size; // == [lengths[i], *]
+    sequence_size.reserve(padded.dim() - 1);
+    sequence_size.push_back(lengths_data[i]);
+    sequence_size.insert(sequence_size.end(), trailing_dims.begin(), trailing_dims.end());
+    sequences.push_back(at::empty(sequence_size, padded.options()));
+    lengths_vec[i] = lengths_data[i];
+    ptrs[i] = sequences[i].data_ptr();
+  }
+  if (input.numel() == 0 || inner == 0) {
+    return sequences;
+  }
+
+  int64_t total_rows = 0;
+  Tensor meta = build_pad_sequence_meta(
+      lengths_vec, ptrs, padded.device(), &total_rows);
+  if (total_rows == 0) {
+    return sequences;
+  }
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  const int64_t num_blocks = std::min(total_rows, kPadSequenceMaxBlocks);
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::Half, input.scalar_type(), "unpad_sequence_cuda", [&] {
+        UnpadSequenceKernel<scalar_t>
+            <<<num_blocks, kPadSequenceNumThreads, 0, cuda_stream>>>(
+                batch_size,
+                max_len,
+                inner,
+                total_rows,
+                batch_first,
+                meta.data_ptr<int64_t>(),
+                input.data_ptr<scalar_t>());
+      });
+  AT_CUDA_CHECK(cudaGetLastError());
+  return sequences;
+}
+
+} // namespace native
+} // namespace at
@@ -2,11 +2,14 @@
 
 #include <ATen/ATen.h>
 #include <ATen/AccumulateType.h>
+#include <ATen/CUDAGenerator.h>
 #include <ATen/Dispatch.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Utils.h>
 #include <ATen/cuda/CUDAApplyUtils.cuh>
 #include <ATen/cuda/detail/IndexUtils.cuh>
 #include <THC/THCDeviceUtils.cuh>
+#include <curand_kernel.h>
 
 #include <c10/cuda/CUDAMathCompat.h>
 
@@ -96,6 +99,82 @@ __global__ void LayerNormForwardCUDAKernel(
   }
 }
 
+// Single-kernel dropout(X) + R + layer_norm: each block owns one row,
+// generates the dropout mask from per-thread Philox streams, stages the
+// dropped-and-summed row in Y, reduces the moments in shared memory and
+// normalizes Y in place. The row never leaves L2 between the three steps,
+// where the unfused ops would round-trip two full activation tensors
+// through global memory.
+template <typename T>
+__global__ void DropoutAddLayerNormCUDAKernel(
+    int64_t N,
+    T eps,
+    float keep_prob,
+    const T* X,
+    const T* R,
+    const T* gamma,
+    const T* beta,
+    std::pair<uint64_t, uint64_t> seeds,
+    uint8_t* mask,
+    T* mean,
+    T* rstd,
+    T* Y) {
+  using T_ACC = acc_type<T, true>;
+  __shared__ T_ACC m_shared[C10_WARP_SIZE];
+  __shared__ T_ACC v_shared[C10_WARP_SIZE];
+  __shared__ T_ACC s_mean;
+  __shared__ T_ACC s_rstd;
+  const int64_t i = blockIdx.x;
+  curandStatePhilox4_32_10_t state;
+  if (keep_prob < 1.0f) {
+    // One subsequence per (row, thread) so the mask does not depend on the
+    // launch configuration of other rows.
+    curand_init(
+        seeds.first,
+        static_cast<uint64_t>(i) * blockDim.x + threadIdx.x,
+        seeds.second,
+        &state);
+  }
+  const T_ACC keep_scale = T_ACC(1) / static_cast<T_ACC>(keep_prob);
+  T_ACC sum1 = 0;
+  T_ACC sum2 = 0;
+  for (int64_t j = threadIdx.x; j < N; j += blockDim.x) {
+    const int64_t index = i * N + j;
+    T_ACC x = static_cast<T_ACC>(X[index]);
+    uint8_t keep = 1;
+    if (keep_prob < 1.0f) {
+      keep = static_cast<uint8_t>(curand_uniform(&state) < keep_prob);
+      x = keep ? x * keep_scale : T_ACC(0);
+    }
+    mask[index] = keep;
+    const T_ACC a = x + static_cast<T_ACC>(R[index]);
+    Y[index] = a;
+    sum1 += a;
+    sum2 += a * a;
+  }
+  sum1 = BlockReduceSum<T_ACC>(sum1, m_shared);
+  sum2 = BlockReduceSum<T_ACC>(sum2, v_shared);
+  if (threadIdx.x == 0) {
+    const T_ACC scale = T_ACC(1) / static_cast<T_ACC>(N);
+    sum1 *= scale;
+    sum2 = c10::cuda::compat::max(sum2 * scale - sum1 * sum1, T_ACC(0));
+    s_mean = sum1;
+    s_rstd = c10::cuda::compat::rsqrt(sum2 + static_cast<T_ACC>(eps));
+    mean[i] = s_mean;
+    rstd[i] = s_rstd;
+  }
+  __syncthreads();
+  for (int64_t j = threadIdx.x; j < N; j += blockDim.x) {
+    const int64_t index = i * N + j;
+    const T_ACC gamma_v =
+        gamma == nullptr ? T_ACC(1) : static_cast<T_ACC>(gamma[j]);
+    const T_ACC beta_v =
+        beta == nullptr ? T_ACC(0) : static_cast<T_ACC>(beta[j]);
+    Y[index] =
+        (static_cast<T_ACC>(Y[index]) - s_mean) * s_rstd * gamma_v + beta_v;
+  }
+}
+
 template <typename T>
 __global__ void ComputeInternalGradientsCUDAKernel(
     int64_t N,
@@ -457,6 +536,65 @@ std::tuple<Tensor, Tensor, Tensor> layer_norm_cuda(
   return std::make_tuple(std::move(Y), std::move(mean), std::move(rstd));
 }
 
+std::tuple<Tensor, Tensor, Tensor, Tensor> dropout_add_layer_norm_cuda(
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& gamma /* optional */,
+    const Tensor& beta /* optional */,
+    int64_t M,
+    int64_t N,
+    double eps,
+    double p,
+    bool train,
+    Generator* gen_) {
+  TORCH_CHECK(
+      p >= 0 && p < 1,
+      "dropout probability has to be in [0, 1), but got ",
+      p);
+  Tensor Y = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor mask = at::empty(X.sizes(), X.options().dtype(kByte));
+  Tensor mean = at::empty({M}, X.options());
+  Tensor rstd = at::empty({M}, X.options());
+  if (M > 0 && N > 0) {
+    const double p_eff = train ? p : 0;
+    std::pair<uint64_t, uint64_t> rng_engine_inputs(0, 0);
+    if (p_eff > 0) {
+      auto gen = get_generator_or_default<CUDAGenerator>(
+          gen_, cuda::detail::getDefaultCUDAGenerator());
+      // Number of Philox counter ticks each thread may consume: one
+      // uniform per handled element, rounded up to whole 4-wide draws.
+      const int64_t counter_offset =
+          ((N + kCUDABlockReduceNumThreads * 4 - 1) /
+               (kCUDABlockReduceNumThreads * 4) +
+           1) *
+          4;
+      // See Note [Philox offset reservation is lock free]
+      rng_engine_inputs = gen->philox_engine_inputs(counter_offset);
+    }
+    cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+    AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+        X.scalar_type(), "DropoutAddLayerNormKernelImpl", [&]() {
+          DropoutAddLayerNormCUDAKernel<scalar_t>
+              <<<M, kCUDABlockReduceNumThreads, 0, cuda_stream>>>(
+                  N,
+                  static_cast<scalar_t>(eps),
+                  static_cast<float>(1 - p_eff),
+                  X.data_ptr<scalar_t>(),
+                  R.data_ptr<scalar_t>(),
+                  gamma.defined() ? gamma.data_ptr<scalar_t>() : nullptr,
+                  beta.defined() ? beta.data_ptr<scalar_t>() : nullptr,
+                  rng_engine_inputs,
+                  mask.data_ptr<uint8_t>(),
+                  mean.data_ptr<scalar_t>(),
+                  rstd.data_ptr<scalar_t>(),
+                  Y.data_ptr<scalar_t>());
+        });
+    AT_CUDA_CHECK(cudaGetLastError());
+  }
+  return std::make_tuple(
+      std::move(Y), std::move(mask), std::move(mean), std::move(rstd));
+}
+
 std::tuple<Tensor, Tensor, Tensor> layer_norm_backward_cuda(
     const Tensor& dY,
     const Tensor& X,
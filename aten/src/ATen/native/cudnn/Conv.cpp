@@ -77,6 +77,8 @@ std::tuple<at::Tensor,at::Tensor,at::Tensor> cudnn_convolution_transpose_backwar
 
 #include <THC/THC.h>
 
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/CUDAWorkspacePool.h>
 #include <ATen/cudnn/cudnn-wrapper.h>
 #include <ATen/cudnn/Descriptors.h>
 #include <ATen/cudnn/Types.h>
@@ -89,11 +91,21 @@ std::tuple<at::Tensor,at::Tensor,at::Tensor> cudnn_convolution_transpose_backwar
 #include <iterator>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <stdint.h>
 #include <unordered_map>
 
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 // Note [behavior of cudnnFind and cudnnGet]
 // You'll notice that by default, in the ConvolutionDescriptor, we do the following:
 //
@@ -361,26 +373,180 @@ struct BenchmarkCache {
     std::lock_guard<std::mutex> guard(mutex);
     map[params] = results;
   }
+
+  // Serialization for the persistent benchmark cache; see
+  // Note [Persistent benchmark cache]. Entries are raw bytes: both
+  // ConvolutionParams and the cudnn perf structs are PODs, and the file
+  // header pins down the cudnn version and GPU they are valid for.
+  void writeTo(std::ostream& out) {
+    std::lock_guard<std::mutex> guard(mutex);
+    uint64_t count = map.size();
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (auto const& entry : map) {
+      out.write(reinterpret_cast<const char*>(&entry.first), sizeof(ConvolutionParams));
+      out.write(reinterpret_cast<const char*>(&entry.second), sizeof(T));
+    }
+  }
+
+  bool readFrom(std::istream& in) {
+    uint64_t count;
+    if (!in.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(mutex);
+    for (uint64_t i = 0; i < count; i++) {
+      ConvolutionParams params;
+      T results;
+      if (!in.read(reinterpret_cast<char*>(&params), sizeof(ConvolutionParams)) ||
+          !in.read(reinterpret_cast<char*>(&results), sizeof(T))) {
+        return false;
+      }
+      // emplace: entries benchmarked in this process win over stale file
+      // contents if load somehow happens after the first benchmark
+      map.emplace(params, results);
+    }
+    return true;
+  }
 };
 
 BenchmarkCache<cudnnConvolutionFwdAlgoPerf_t> fwd_algos;
 BenchmarkCache<cudnnConvolutionBwdDataAlgoPerf_t> bwd_data_algos;
 BenchmarkCache<cudnnConvolutionBwdFilterAlgoPerf_t> bwd_filter_algos;
 
-// TODO: Stop manually allocating CUDA memory; allocate an ATen byte
-// tensor instead.
+// Note [Persistent benchmark cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With torch.backends.cudnn.benchmark enabled, every process re-times
+// every new convolution shape it sees, so a fleet of identical workers
+// pays the (expensive, GPU-occupying) algorithm search once per replica
+// per deploy. When TORCH_CUDNN_BENCHMARK_CACHE_PATH is set, the three
+// in-memory caches are seeded from that file before the first algorithm
+// lookup and written back at process exit, so the search cost is paid
+// once per fleet instead.
+//
+// Cached algorithm choices are only valid for the exact cudnn version
+// and GPU they were measured on, so the file header records
+// cudnnGetVersion(), the compute capability of the current device, and
+// the sizes of the serialized structs (the cudnn perf structs can grow
+// between versions); a file that does not match is ignored wholesale
+// and simply rewritten at exit. Writes go to a temporary file that is
+// renamed into place, so concurrent writers on a shared mount can race
+// benignly: the last complete file wins and every candidate is valid.
+// All I/O failures are silent - the cache is an optimization, and a
+// missing or corrupt file just means we fall back to benchmarking.
+
+constexpr uint64_t kBenchmarkCacheMagic = 0x5054434e4e565631ULL; // "PTCNNVV1"
+
+struct BenchmarkCacheHeader {
+  uint64_t magic;
+  uint64_t cudnn_version;
+  int32_t cc_major;
+  int32_t cc_minor;
+  uint32_t params_size;
+  uint32_t fwd_perf_size;
+  uint32_t bwd_data_perf_size;
+  uint32_t bwd_filter_perf_size;
+};
+
+std::atomic<bool> benchmark_cache_dirty{false};
+
+BenchmarkCacheHeader makeBenchmarkCacheHeader() {
+  BenchmarkCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kBenchmarkCacheMagic;
+  header.cudnn_version = cudnnGetVersion();
+  cudaDeviceProp* prop = at::cuda::getCurrentDeviceProperties();
+  header.cc_major = prop->major;
+  header.cc_minor = prop->minor;
+  header.params_size = sizeof(ConvolutionParams);
+  header.fwd_perf_size = sizeof(cudnnConvolutionFwdAlgoPerf_t);
+  header.bwd_data_perf_size = sizeof(cudnnConvolutionBwdDataAlgoPerf_t);
+  header.bwd_filter_perf_size = sizeof(cudnnConvolutionBwdFilterAlgoPerf_t);
+  return header;
+}
+
+void loadBenchmarkCache(const char* path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return;
+  }
+  BenchmarkCacheHeader header;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return;
+  }
+  BenchmarkCacheHeader expected = makeBenchmarkCacheHeader();
+  if (memcmp(&header, &expected, sizeof(header)) != 0) {
+    return;
+  }
+  fwd_algos.readFrom(in) &&
+      bwd_data_algos.readFrom(in) &&
+      bwd_filter_algos.readFrom(in);
+}
+
+void saveBenchmarkCache() {
+  if (!benchmark_cache_dirty.load()) {
+    return;
+  }
+  const char* path = getenv("TORCH_CUDNN_BENCHMARK_CACHE_PATH");
+  if (path == nullptr) {
+    return;
+  }
+  // Unique temporary name so concurrent exiting processes don't clobber
+  // each other's half-written files; rename is atomic on POSIX.
+#ifdef _WIN32
+  int pid = _getpid();
+#else
+  int pid = getpid();
+#endif
+  std::string tmp_path = std::string(path) + ".tmp." + std::to_string(pid);
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return;
+    }
+    BenchmarkCacheHeader header = makeBenchmarkCacheHeader();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fwd_algos.writeTo(out);
+    bwd_data_algos.writeTo(out);
+    bwd_filter_algos.writeTo(out);
+    if (!out) {
+      out.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path) != 0) {
+    std::remove(tmp_path.c_str());
+  }
+}
+
+// Seeds the in-memory caches from TORCH_CUDNN_BENCHMARK_CACHE_PATH on
+// the first algorithm lookup and registers the writeback at exit.
+void initBenchmarkCache() {
+  static std::once_flag once;
+  std::call_once(once, []() {
+    const char* path = getenv("TORCH_CUDNN_BENCHMARK_CACHE_PATH");
+    if (path == nullptr) {
+      return;
+    }
+    loadBenchmarkCache(path);
+    // Registered after the caches are constructed, so it runs before
+    // they are destroyed.
+    std::atexit(saveBenchmarkCache);
+  });
+}
+
+// Borrows the persistent per-(device, stream) workspace instead of
+// allocating per call; see Note [Per-stream workspace pool] in
+// ATen/cuda/CUDAWorkspacePool.h. The borrow is valid until the next
+// larger request on the same stream, i.e. comfortably past the single
+// cuDNN call each Workspace feeds.
 struct Workspace {
   Workspace(size_t size) : size(size), data(NULL) {
-    data = THCudaMalloc(globalContext().lazyInitCUDA(), size);
+    data = at::cuda::getStreamWorkspace(size);
   }
   Workspace(const Workspace&) = delete;
   Workspace(Workspace&&) = default;
   Workspace& operator=(Workspace&&) = default;
-  ~Workspace() {
-    if (data) {
-      THCudaFree(globalContext().lazyInitCUDA(), data);
-    }
-  }
 
   size_t size;
   void* data;
@@ -703,6 +869,8 @@ void findAlgorithm(const ConvolutionArgs& args, bool benchmark, perf_t* algoPerf
   using search = algorithm_search<perf_t>;
   auto& cache = search::cache();
 
+  initBenchmarkCache();
+
   if (cache.find(args.params, algoPerf)) {
     return;
   }
@@ -734,6 +902,7 @@ void findAlgorithm(const ConvolutionArgs& args, bool benchmark, perf_t* algoPerf
       // if benchmarking, map the original params with the found algo+math type for re-use
       if (benchmark) {
         cache.insert(args.params, perfResults);
+        benchmark_cache_dirty.store(true);
 
         // Free the cached blocks in our caching allocator. They are
         // needed here because the above benchmarking uses a huge amount of memory,
@@ -777,6 +946,7 @@ Workspace chooseAlgorithm(
     }
     search::getWorkspaceSize(args, algoPerf->algo, &(algoPerf->memory));
     search::cache().insert(args.params, *algoPerf);
+    benchmark_cache_dirty.store(true);
     return Workspace(algoPerf->memory);
   }
 }
@@ -9,9 +9,11 @@
 #include <ATen/ATen.h>
 #include <ATen/AccumulateType.h>
 #include <ATen/CPUApplyUtils.h>
+#include <ATen/CPUGenerator.h>
 #include <ATen/Config.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/Parallel.h>
+#include <ATen/Utils.h>
 
 namespace at {
 namespace native {
@@ -60,6 +62,101 @@ std::tuple<Tensor, Tensor, Tensor> layer_norm_backward_cpu(
   return std::make_tuple(std::move(dX), std::move(dgamma), std::move(dbeta));
 }
 
+std::tuple<Tensor, Tensor, Tensor, Tensor> dropout_add_layer_norm_cpu(
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& gamma /* optional */,
+    const Tensor& beta /* optional */,
+    int64_t M,
+    int64_t N,
+    double eps,
+    double p,
+    bool train,
+    Generator* generator) {
+  TORCH_CHECK(
+      p >= 0 && p < 1,
+      "dropout probability has to be in [0, 1), but got ",
+      p);
+  Tensor Y = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor mask = at::empty(X.sizes(), X.options().dtype(kByte));
+  Tensor mean = at::empty({M}, X.options());
+  Tensor rstd = at::empty({M}, X.options());
+  const double p_eff = train ? p : 0;
+  uint64_t seed = 0;
+  if (p_eff > 0) {
+    auto gen = get_generator_or_default<CPUGenerator>(
+        generator, detail::getDefaultCPUGenerator());
+    // See Note [Acquire lock when using random generators]
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    seed = gen->random64();
+  }
+  if (M > 0) {
+    DropoutAddLayerNormKernel(
+        kCPU, X, R, gamma, beta, M, N, eps, p_eff, seed, &Y, &mask, &mean, &rstd);
+  }
+  return std::make_tuple(
+      std::move(Y), std::move(mask), std::move(mean), std::move(rstd));
+}
+
+// Backward of the fused dropout + add + layer_norm op. The layer_norm
+// input is recomputed from the saved dropout mask instead of being saved
+// in forward - the whole point of the fusion is to avoid materializing
+// that intermediate, and an elementwise recompute here is cheaper than
+// carrying an extra activation-sized tensor through the graph.
+std::tuple<Tensor, Tensor, Tensor, Tensor> native_dropout_add_layer_norm_backward(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    double p,
+    std::array<bool, 4> grad_input_mask) {
+  const double scale = 1. / (1. - p);
+  Tensor A;
+  if (p > 0) {
+    A = X.is_cuda() ? at::_masked_scale(X, mask, scale)
+                    : X.mul(mask.type_as(X)).mul_(scale);
+    A.add_(R);
+  } else {
+    A = X.add(R);
+  }
+  auto grads = at::native_layer_norm_backward(
+      dY,
+      A,
+      mean,
+      rstd,
+      gamma,
+      M,
+      N,
+      {grad_input_mask[0] || grad_input_mask[1],
+       grad_input_mask[2],
+       grad_input_mask[3]});
+  Tensor dA = std::move(std::get<0>(grads));
+  Tensor dX;
+  Tensor dR;
+  if (grad_input_mask[0]) {
+    if (p > 0) {
+      dX = dA.is_cuda() ? at::_masked_scale(dA, mask, scale)
+                        : dA.mul(mask.type_as(dA)).mul_(scale);
+    } else {
+      dX = dA;
+    }
+  }
+  if (grad_input_mask[1]) {
+    // The residual is added after dropout, so its gradient is dA itself.
+    dR = dA;
+  }
+  return std::make_tuple(
+      std::move(dX),
+      std::move(dR),
+      std::move(std::get<1>(grads)),
+      std::move(std::get<2>(grads)));
+}
+
 Tensor layer_norm(
     const Tensor& input,
     IntArrayRef normalized_shape,
@@ -122,8 +219,85 @@ Tensor layer_norm(
   return std::get<0>(at::native_layer_norm(X, gamma, beta, M, N, eps));
 }
 
+// One-shot dropout(input) + residual + layer_norm, the tail of every
+// transformer block. Keeping it as a single op avoids materializing the
+// dropout output and the residual sum as separate activation tensors.
+Tensor fused_dropout_add_layer_norm(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const Tensor& weight /* optional */,
+    const Tensor& bias /* optional */,
+    double eps,
+    double p,
+    bool train) {
+  const int normalized_ndim = normalized_shape.size();
+  TORCH_CHECK(
+      normalized_ndim >= 1,
+      "Expected normalized_shape to be at least 1-dimensional, i.e., ",
+      "containing at least one element, but got normalized_shape = ",
+      normalized_shape);
+  TORCH_CHECK(
+      input.sizes().equals(residual.sizes()),
+      "Expected residual to be of same shape as input, but got residual of ",
+      "shape ",
+      residual.sizes(),
+      " and input of shape ",
+      input.sizes());
+  TORCH_CHECK(
+      !weight.defined() || weight.sizes().equals(normalized_shape),
+      "Expected weight to be of same shape as normalized_shape, but got ",
+      "weight of shape ",
+      weight.sizes(),
+      " and normalized_shape = ",
+      normalized_shape);
+  TORCH_CHECK(
+      !bias.defined() || bias.sizes().equals(normalized_shape),
+      "Expected bias to be of same shape as normalized_shape, but got ",
+      "bias of shape ",
+      bias.sizes(),
+      " and normalized_shape = ",
+      normalized_shape);
+
+  const auto input_shape = input.sizes();
+  const auto input_ndim = input.dim();
+
+  if (input_ndim < normalized_ndim ||
+      !input_shape.slice(input_ndim - normalized_ndim)
+           .equals(normalized_shape)) {
+    std::stringstream ss;
+    ss << "Given normalized_shape=" << normalized_shape
+       << ", expected input with shape [*";
+    for (auto size : normalized_shape) {
+      ss << ", " << size;
+    }
+    ss << "], but got input of size" << input_shape;
+    AT_ERROR(ss.str());
+  }
+
+  const int axis = input_ndim - normalized_ndim;
+  const int64_t M = std::accumulate(
+      input_shape.cbegin(),
+      input_shape.cbegin() + axis,
+      1LL,
+      std::multiplies<int64_t>());
+  const int64_t N = std::accumulate(
+      input_shape.cbegin() + axis,
+      input_shape.cend(),
+      1LL,
+      std::multiplies<int64_t>());
+
+  const auto& X = input.is_contiguous() ? input : input.contiguous();
+  const auto& R = residual.is_contiguous() ? residual : residual.contiguous();
+  const auto& gamma = weight.is_contiguous() ? weight : weight.contiguous();
+  const auto& beta = bias.is_contiguous() ? bias : bias.contiguous();
+  return std::get<0>(at::native_dropout_add_layer_norm(
+      X, R, gamma, beta, M, N, eps, p, train));
+}
+
 DEFINE_DISPATCH(LayerNormKernel);
 DEFINE_DISPATCH(LayerNormBackwardKernel);
+DEFINE_DISPATCH(DropoutAddLayerNormKernel);
 
 } // namespace native
 } // namespace at
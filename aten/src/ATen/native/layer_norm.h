@@ -29,8 +29,30 @@ using backward_fn = void (*)(
     Tensor* /* dgamma */,
     Tensor* /* dbeta */);
 
+// Fused dropout(X) + residual + layer_norm forward. The dropout mask is
+// generated inside the kernel from counter-based Philox streams seeded by
+// `seed` (one subsequence per row), so the result is deterministic for a
+// given seed no matter how rows are chunked across threads. `p` is the
+// dropout probability; `p == 0` keeps everything and writes an all-ones
+// mask.
+using dropout_add_forward_fn = void (*)(
+    const Tensor& /* X */,
+    const Tensor& /* R */,
+    const Tensor& /* gamma */,
+    const Tensor& /* beta */,
+    int64_t /* M */,
+    int64_t /* N */,
+    double /* eps */,
+    double /* p */,
+    uint64_t /* seed */,
+    Tensor* /* Y */,
+    Tensor* /* mask */,
+    Tensor* /* mean */,
+    Tensor* /* rstd */);
+
 DECLARE_DISPATCH(forward_fn, LayerNormKernel);
 DECLARE_DISPATCH(backward_fn, LayerNormBackwardKernel);
+DECLARE_DISPATCH(dropout_add_forward_fn, DropoutAddLayerNormKernel);
 
 } // namespace native
 } // namespace at
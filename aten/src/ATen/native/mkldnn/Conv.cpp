@@ -84,9 +84,20 @@ ideep::tensor _mkldnn_conv2d(
   std::vector<int64_t> output_sizes =
       conv_output_size(input_size, kernel_size, padding, stride, dilation);
 
+  // The bias shape is implied by the weight, so the descriptors plus these
+  // scalars pin down the whole signature. See Note [Per-thread MKL-DNN op
+  // keys] in MKLDNNCommon.h.
+  std::vector<int64_t> key_params{groups, b.has_value() ? 1 : 0};
+  key_params.insert(key_params.end(), stride.begin(), stride.end());
+  key_params.insert(key_params.end(), dilation.begin(), dilation.end());
+  key_params.insert(key_params.end(), padding.begin(), padding.end());
+  ideep::key_t& op_key =
+      mkldnn_op_key("mkldnn_conv2d", x, w, std::move(key_params));
+
   ideep::tensor y;
   if (b.has_value()) {
     ideep::convolution_forward::compute<AllocForMKLDNN>(
+        op_key,
         x,
         w,
         b.value(),
@@ -102,6 +113,7 @@ ideep::tensor _mkldnn_conv2d(
         ideep::prop_kind::forward);
   } else {
     ideep::convolution_forward::compute<AllocForMKLDNN>(
+      op_key,
       x,
       w,
       {output_sizes.cbegin(), output_sizes.cend()},
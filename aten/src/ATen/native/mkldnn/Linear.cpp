@@ -40,12 +40,16 @@ Tensor mkldnn_linear(
   const ideep::tensor x = itensor_from_mkldnn(self_reshaped);
   const ideep::tensor w = itensor_from_mkldnn(weight);
 
+  // See Note [Per-thread MKL-DNN op keys] in MKLDNNCommon.h.
+  ideep::key_t& op_key = mkldnn_op_key(
+      "mkldnn_linear", x, w, {bias.defined() ? int64_t(1) : int64_t(0)});
+
   ideep::tensor y;
   if (bias.defined()) {
     const ideep::tensor b = itensor_from_mkldnn(bias);
-    ideep::inner_product_forward::compute(x, w, b, y);
+    ideep::inner_product_forward::compute(op_key, x, w, b, y);
   } else {
-    ideep::inner_product_forward::compute(x, w, y);
+    ideep::inner_product_forward::compute(op_key, x, w, y);
   }
 
   auto input_size = self.sizes();
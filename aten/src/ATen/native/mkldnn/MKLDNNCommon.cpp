@@ -2,6 +2,8 @@
 #include <ATen/OpaqueTensorImpl.h>
 #include <c10/core/Allocator.h>
 
+#include <cstring>
+
 #if AT_MKLDNN_ENABLED()
 
 #include <ideep.hpp>
@@ -73,6 +75,61 @@ ideep::tensor itensor_view_from_dense(const Tensor& tensor) {
            ideep::tensor::data_type::f32},
           tensor.template data_ptr<float>()};
 }
+
+// See Note [Per-thread MKL-DNN op keys] in MKLDNNCommon.h
+ideep::key_t& mkldnn_op_key(
+    const char* op,
+    const ideep::tensor& x,
+    const ideep::tensor& w,
+    std::vector<int64_t> params) {
+  struct KeyEntry {
+    const char* op = nullptr;
+    std::vector<int64_t> params;
+    ideep::tensor::descriptor x_desc;
+    ideep::tensor::descriptor w_desc;
+    ideep::key_t key;
+  };
+  struct KeyTable {
+    static constexpr size_t kMaxEntries = 64;
+    KeyTable() {
+      // Never reallocates, so returned references stay valid across later
+      // lookups on the same thread.
+      entries.reserve(kMaxEntries);
+    }
+    std::vector<KeyEntry> entries;
+    size_t next_evict = 0;
+  };
+  thread_local KeyTable table;
+
+  for (auto& entry : table.entries) {
+    // Op tags are string literals, so pointer equality is the common case.
+    if ((entry.op != op && strcmp(entry.op, op) != 0) ||
+        entry.params != params) {
+      continue;
+    }
+    if (entry.x_desc != x.get_descriptor() ||
+        entry.w_desc != w.get_descriptor()) {
+      entry.x_desc = x.dup_descriptor();
+      entry.w_desc = w.dup_descriptor();
+      entry.key.clear();
+    }
+    return entry.key;
+  }
+
+  KeyEntry* slot;
+  if (table.entries.size() < KeyTable::kMaxEntries) {
+    table.entries.emplace_back();
+    slot = &table.entries.back();
+  } else {
+    slot = &table.entries[table.next_evict++ % KeyTable::kMaxEntries];
+  }
+  slot->op = op;
+  slot->params = std::move(params);
+  slot->x_desc = x.dup_descriptor();
+  slot->w_desc = w.dup_descriptor();
+  slot->key.clear();
+  return slot->key;
+}
 }}
 
 #endif // AT_MKLDNN_ENABLED()
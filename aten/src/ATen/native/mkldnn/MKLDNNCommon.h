@@ -30,6 +30,28 @@ ideep::tensor& itensor_from_mkldnn(const Tensor& mkldnn_tensor);
 // Construct an `ideep::tensor` "view" from dense tensor, note the
 // ideep::tensor will share the underlying buffer
 ideep::tensor itensor_view_from_dense(const Tensor& tensor);
+
+// Note [Per-thread MKL-DNN op keys]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// ideep's compute() helpers assemble a cache key string out of every
+// argument on every call before consulting the computation cache, and that
+// assembly plus the cache fetch is a contention point with many concurrent
+// inference threads. The key-taking compute() overloads let the caller own
+// the key, so once it has been filled in the assembly (and the slow path
+// of the fetch) is skipped. mkldnn_op_key() hands out such keys from a
+// per-thread table addressed by an op tag, the input and weight
+// descriptors, and the remaining scalar parameters; steady-state lookups
+// touch only thread-local state and take no lock. When a descriptor
+// changes under an existing signature (e.g. the weight was reordered into
+// a blocked format), the slot's key is cleared and ideep rebuilds it on
+// the next compute() call. The table is bounded; once full, slots are
+// evicted round-robin and an evicted signature merely pays key assembly
+// again. `op` must be a string literal.
+ideep::key_t& mkldnn_op_key(
+    const char* op,
+    const ideep::tensor& x,
+    const ideep::tensor& w,
+    std::vector<int64_t> params);
 }}
 
 #endif // AT_MKLDNN_ENABLED
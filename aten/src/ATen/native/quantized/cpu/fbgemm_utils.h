@@ -34,6 +34,11 @@ struct FBGEMM_API PackedConvWeight {
   std::vector<float> w_scale;
   std::vector<int32_t> w_zp;
   c10::QScheme q_scheme;
+  // Raw weight values in [kernel_h][kernel_w][channel] layout, retained at
+  // prepack time only for 2D depthwise convolutions (groups == in/out
+  // channels). FBGEMM's packed buffer doesn't keep the original values, and
+  // the direct depthwise kernel in qconv.cpp reads these instead.
+  std::vector<int8_t> dw_weight;
 };
 
 // PackWeight: Convert the weight from uint8 to int8.
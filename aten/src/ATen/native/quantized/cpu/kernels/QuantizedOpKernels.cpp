@@ -1,8 +1,10 @@
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/UpSample.h>
 #include <ATen/native/cpu/Loops.h>
+#include <ATen/native/quantized/cpu/quantized_loops.h>
 #include <ATen/native/quantized/cpu/quantized_ops.h>
 #include <ATen/quantized/Quantizer.h>
 #include <ATen/native/SortingUtils.h>
@@ -196,62 +198,49 @@ void qrelu6_kernel(const Tensor& qx, Tensor& qy) {
 // Note: Addition is only supported when self, other, out are of the same dtype.
 template <bool ReLUFused = false>
 void qadd_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
-  int64_t zero_point = out.q_zero_point();
-  float scale = out.q_scale();
-  float inv_scale = 1.0f / scale;
-  int64_t self_zero_point = self.q_zero_point();
-  float self_scale = self.q_scale();
-  int64_t other_zero_point = other.q_zero_point();
-  float other_scale = other.q_scale();
-
-  // Broadcast out the parameters here to amortize out that cost across
-  // loop iterations.
-  // TODO: we can optimize dequantization by doing a premultiplication
-  // of the zero point by scale and doing FMA on scale*x_q - (scale*zero_point)
-  auto self_zero_point_vec = Vec256<float>((float)self_zero_point);
-  auto self_scale_vec = Vec256<float>(self_scale);
-  auto other_zero_point_vec = Vec256<float>((float)other_zero_point);
-  auto other_scale_vec = Vec256<float>(other_scale);
-
-  auto self_scale_neg_zp_premul_vec = self_scale_vec * self_zero_point_vec.neg();
-  auto other_scale_zp_premul_vec = other_scale_vec * other_zero_point_vec.neg();
-
-  auto iter = TensorIterator::binary_op(out, self, other);
-
+  auto iter = TensorIterator::quantized_binary_op(out, self, other);
   AT_DISPATCH_QINT_TYPES(out.scalar_type(), "qadd", [&]() {
-    using Vec = Vec256<scalar_t>;
-    cpu_kernel_vec(
+    quantized_binary_kernel_vec<scalar_t>(
         iter,
-        [&](scalar_t a, scalar_t b) -> scalar_t {
-          const auto da = at::dequantize_val(self_scale, self_zero_point, a);
-          const auto db = at::dequantize_val(other_scale, other_zero_point, b);
-          float c = da + db;
+        [](float a, float b) -> float {
+          float c = a + b;
           if (ReLUFused) {
             c = std::max<float>(c, 0.0);
           }
-          return at::quantize_val<scalar_t>(scale, zero_point, c);
+          return c;
         },
-        [&](Vec a, Vec b) -> Vec {
-          const auto da = a.dequantize(
-              self_scale_vec, self_zero_point_vec, self_scale_neg_zp_premul_vec);
-          const auto db = b.dequantize(
-              other_scale_vec, other_zero_point_vec, other_scale_zp_premul_vec);
-          Vec::float_vec_return_type retvals;
-          for (int i = 0; i < Vec::float_num_vecs(); ++i) {
-            auto c = da[i] + db[i];
-            if (ReLUFused) {
-              c = vec256::maximum(c, Vec256<float>(0.0f));
-            }
-            retvals[i] = c;
+        [](Vec256<float> a, Vec256<float> b) -> Vec256<float> {
+          auto c = a + b;
+          if (ReLUFused) {
+            c = vec256::maximum(c, Vec256<float>(0.0f));
           }
-          // TODO: fbgemm::Quantize doesn't support taking in the
-          // pre-broadcasted parameters. We might be able to save some cycles by
-          // enabling that in the API.
-          // TODO: specialize fbgemm::Quantize for a single vector and make it
-          // inlineable. This could help with interleaving as suggested by the
-          // TensorIterator implementations
-          auto rv = Vec::quantize(retvals, scale, zero_point, inv_scale);
-          return rv;
+          return c;
+        });
+  });
+}
+
+// Note: out is assumed to be the same size as self and other.
+// Note: Multiplication is only supported when self, other, out are of the
+// same dtype.
+template <bool ReLUFused = false>
+void qmul_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
+  auto iter = TensorIterator::quantized_binary_op(out, self, other);
+  AT_DISPATCH_QINT_TYPES(out.scalar_type(), "qmul", [&]() {
+    quantized_binary_kernel_vec<scalar_t>(
+        iter,
+        [](float a, float b) -> float {
+          float c = a * b;
+          if (ReLUFused) {
+            c = std::max<float>(c, 0.0);
+          }
+          return c;
+        },
+        [](Vec256<float> a, Vec256<float> b) -> Vec256<float> {
+          auto c = a * b;
+          if (ReLUFused) {
+            c = vec256::maximum(c, Vec256<float>(0.0f));
+          }
+          return c;
         });
   });
 }
@@ -359,6 +348,101 @@ void qmaxpool_2d_nhwc_kernel(
   });
 }
 
+void qdepthwise_conv2d_nhwc_kernel(
+    const Tensor& qx,
+    Tensor& qy,
+    const int8_t* weight, // [kH][kW][C], channel contiguous
+    const int32_t* weight_zero_points,
+    const float* requant_scales,
+    const float* bias,
+    bool per_channel,
+    bool relu_fused,
+    int64_t kH,
+    int64_t kW, // kernel size
+    int64_t sH,
+    int64_t sW, // strides
+    int64_t pH,
+    int64_t pW, // padding
+    int64_t dH,
+    int64_t dW) { // dilation
+  const int64_t N = qx.size(0);
+  const int64_t C = qx.size(1);
+  const int64_t iH = qx.size(2);
+  const int64_t iW = qx.size(3);
+  const int64_t oH = qy.size(2);
+  const int64_t oW = qy.size(3);
+
+  const auto* idata =
+      reinterpret_cast<const uint8_t*>(qx.data_ptr<c10::quint8>());
+  auto* odata = reinterpret_cast<uint8_t*>(qy.data_ptr<c10::quint8>());
+  const int32_t act_zero_point = qx.q_zero_point();
+  const int32_t out_zero_point = qy.q_zero_point();
+  const float out_scale = qy.q_scale();
+
+  // Fold the fp32 bias into the requantization step up front; this mirrors
+  // what fbgemm::ReQuantizeOutput does with a float bias.
+  std::vector<float> bias_q(C, 0.f);
+  if (bias != nullptr) {
+    for (int64_t c = 0; c < C; ++c) {
+      bias_q[c] = bias[c] / out_scale;
+    }
+  }
+
+  at::parallel_for(0, N * oH, 1, [&](int64_t begin, int64_t end) {
+    std::vector<int32_t> acc(C);
+    for (int64_t i = begin; i < end; ++i) {
+      const int64_t n = i / oH;
+      const int64_t oh = i % oH;
+      const uint8_t* i_batch = idata + n * iH * iW * C;
+      for (int64_t ow = 0; ow < oW; ++ow) {
+        uint8_t* o_p = odata + ((n * oH + oh) * oW + ow) * C;
+        std::fill(acc.begin(), acc.end(), 0);
+        // Accumulate in int32 over the valid taps only; a padded activation
+        // equals the activation zero point, so skipped taps contribute
+        // nothing. The per-channel loops run along the contiguous axis of
+        // both the activation and the weight, so they vectorize.
+        for (int64_t kh = 0; kh < kH; ++kh) {
+          const int64_t ih = oh * sH - pH + kh * dH;
+          if (ih < 0 || ih >= iH) {
+            continue;
+          }
+          for (int64_t kw = 0; kw < kW; ++kw) {
+            const int64_t iw = ow * sW - pW + kw * dW;
+            if (iw < 0 || iw >= iW) {
+              continue;
+            }
+            const uint8_t* a_p = i_batch + (ih * iW + iw) * C;
+            const int8_t* w_p = weight + (kh * kW + kw) * C;
+            if (per_channel) {
+              for (int64_t c = 0; c < C; ++c) {
+                acc[c] += (static_cast<int32_t>(a_p[c]) - act_zero_point) *
+                    (static_cast<int32_t>(w_p[c]) - weight_zero_points[c]);
+              }
+            } else {
+              const int32_t w_zp = weight_zero_points[0];
+              for (int64_t c = 0; c < C; ++c) {
+                acc[c] += (static_cast<int32_t>(a_p[c]) - act_zero_point) *
+                    (static_cast<int32_t>(w_p[c]) - w_zp);
+              }
+            }
+          } // for kw
+        } // for kh
+        for (int64_t c = 0; c < C; ++c) {
+          const float multiplier =
+              per_channel ? requant_scales[c] : requant_scales[0];
+          int32_t q = out_zero_point +
+              static_cast<int32_t>(
+                  std::nearbyint(acc[c] * multiplier + bias_q[c]));
+          if (relu_fused) {
+            q = std::max(q, out_zero_point);
+          }
+          o_p[c] = static_cast<uint8_t>(std::min(std::max(q, 0), 255));
+        } // for c
+      } // for ow
+    }
+  });
+}
+
 template <typename T>
 void do_avg_pool_on_AVX2(
     typename T::underlying* i_p,
@@ -814,7 +898,10 @@ REGISTER_DISPATCH(qrelu_stub, &qrelu_kernel);
 REGISTER_DISPATCH(qrelu6_stub, &qrelu6_kernel);
 REGISTER_DISPATCH(qadd_relu_stub, &qadd_kernel<true>);
 REGISTER_DISPATCH(qadd_stub, &qadd_kernel<false>);
+REGISTER_DISPATCH(qmul_relu_stub, &qmul_kernel<true>);
+REGISTER_DISPATCH(qmul_stub, &qmul_kernel<false>);
 REGISTER_DISPATCH(qmaxpool_2d_nhwc_stub, &qmaxpool_2d_nhwc_kernel);
+REGISTER_DISPATCH(qdepthwise_conv2d_nhwc_stub, &qdepthwise_conv2d_nhwc_kernel);
 REGISTER_DISPATCH(
     qadaptive_avg_pool2d_nhwc_stub,
     &qadaptive_avg_pool2d_nhwc_kernel);
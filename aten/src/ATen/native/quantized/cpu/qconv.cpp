@@ -9,10 +9,14 @@
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
 #include <caffe2/utils/threadpool/ThreadPoolMobile.h>
 
 namespace at {
 namespace native {
+
+DEFINE_DISPATCH(qdepthwise_conv2d_nhwc_stub);
+
 namespace {
 
 template <int kSpatialDim = 2>
@@ -432,6 +436,32 @@ class QConvInt8 final : public c10::OperatorKernel {
               device(kCPU).dtype(kQUInt8),
               output_scale,
               output_zero_point);
+    // Depthwise convolutions skip FBGEMM's generic im2col-based path and go
+    // through the direct NHWC kernel instead; the raw weight values were
+    // retained at prepack time for exactly this case.
+    if (kSpatialDim == 2 && !pack_data.dw_weight.empty() && groups == C &&
+        M == C) {
+      qdepthwise_conv2d_nhwc_stub(
+          kCPU,
+          act_nhwc,
+          output,
+          pack_data.dw_weight.data(),
+          pack_data.w_zp.data(),
+          output_multiplier_float.data(),
+          bias_data,
+          pack_data.q_scheme == kPerChannelAffine,
+          kReluFused,
+          kernel_h,
+          kernel_w,
+          stride_h,
+          stride_w,
+          pad_h,
+          pad_w,
+          dilation_h,
+          dilation_w);
+      return output;
+    }
+
     Tensor buffer = at::empty(output.sizes(), output.options().dtype(at::kInt));
     const int num_tasks = at::get_num_threads();
     at::parallel_for(0, num_tasks, 1, [&](int64_t begin, int64_t end) {
@@ -200,6 +200,23 @@ class QConvPackWeightInt8 final : public c10::OperatorKernel {
             zero_points,
             qtype});
 
+    if (kSpatialDim == 2 && groups == output_channels &&
+        input_channels_per_group == 1) {
+      // Depthwise: retain the weight values transposed into
+      // [kernel_h][kernel_w][channel] layout so that the direct kernel in
+      // qconv.cpp streams along the contiguous channel axis. The channels-last
+      // layout of a (C, 1, kH, kW) weight is [c][kh][kw], i.e. one contiguous
+      // filter per channel.
+      const int kernel_size = kernel_h * kernel_w;
+      ret_ptr->dw_weight.resize(kernel_size * output_channels);
+      for (int c = 0; c < output_channels; ++c) {
+        for (int s = 0; s < kernel_size; ++s) {
+          ret_ptr->dw_weight[s * output_channels + c] =
+              weight_data_int8[c * kernel_size + s];
+        }
+      }
+    }
+
     // TODO: we will need to replace this with torchscript classes at a later
     // point.
     return cpp_custom_type_hack::create(std::move(ret_ptr), weight.options());
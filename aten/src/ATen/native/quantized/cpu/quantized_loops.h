@@ -0,0 +1,108 @@
+#pragma once
+
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/TensorIterator.h>
+#include <ATen/native/cpu/Loops.h>
+#include <ATen/quantized/Quantizer.h>
+
+#include <algorithm>
+
+namespace at {
+namespace native {
+
+// Requantizing loop helpers.
+//
+// These wrap cpu_kernel_vec for per-tensor affine quantized elementwise
+// ops: the functor is written against dequantized float values (scalar and
+// Vec256<float> forms), and the helper supplies the surrounding machinery
+// every such kernel would otherwise duplicate - reading the operands'
+// quantization parameters off the iterator, pre-broadcasting them into
+// vectors (with the scale * -zero_point premultiply the vectorized
+// dequantize wants), and requantizing the result with the output's
+// scale/zero_point. The iterator must come from one of the
+// TensorIterator::quantized_*_op factories, which validate the schemes and
+// capture the parameters. Dim collapsing, parallelization and
+// vectorization all come from the shared TensorIterator/cpu_kernel_vec
+// path, same as the float ops.
+//
+// Ops that work directly in the quantized domain without rescaling (e.g.
+// relu, which only clamps against the zero point) don't need these; they
+// can keep using cpu_kernel_vec directly.
+
+template <typename scalar_t, typename func_t, typename vec_func_t>
+void quantized_unary_kernel_vec(TensorIterator& iter, func_t op, vec_func_t vop) {
+  using Vec = Vec256<scalar_t>;
+  const auto out_params = iter.quant_params(0);
+  const auto in_params = iter.quant_params(1);
+
+  const float out_scale = out_params.scale;
+  const float out_inv_scale = 1.0f / out_scale;
+  const int64_t out_zero_point = out_params.zero_point;
+  const float in_scale = in_params.scale;
+  const int64_t in_zero_point = in_params.zero_point;
+
+  const auto in_scale_vec = Vec256<float>(in_scale);
+  const auto in_zero_point_vec = Vec256<float>((float)in_zero_point);
+  const auto in_scale_neg_zp_premul_vec = in_scale_vec * in_zero_point_vec.neg();
+
+  cpu_kernel_vec(
+      iter,
+      [=](scalar_t a) -> scalar_t {
+        const auto da = at::dequantize_val(in_scale, in_zero_point, a);
+        return at::quantize_val<scalar_t>(out_scale, out_zero_point, op(da));
+      },
+      [=](Vec a) -> Vec {
+        const auto da = a.dequantize(
+            in_scale_vec, in_zero_point_vec, in_scale_neg_zp_premul_vec);
+        typename Vec::float_vec_return_type retvals;
+        for (int i = 0; i < Vec::float_num_vecs(); ++i) {
+          retvals[i] = vop(da[i]);
+        }
+        return Vec::quantize(retvals, out_scale, out_zero_point, out_inv_scale);
+      });
+}
+
+template <typename scalar_t, typename func_t, typename vec_func_t>
+void quantized_binary_kernel_vec(TensorIterator& iter, func_t op, vec_func_t vop) {
+  using Vec = Vec256<scalar_t>;
+  const auto out_params = iter.quant_params(0);
+  const auto a_params = iter.quant_params(1);
+  const auto b_params = iter.quant_params(2);
+
+  const float out_scale = out_params.scale;
+  const float out_inv_scale = 1.0f / out_scale;
+  const int64_t out_zero_point = out_params.zero_point;
+  const float a_scale = a_params.scale;
+  const int64_t a_zero_point = a_params.zero_point;
+  const float b_scale = b_params.scale;
+  const int64_t b_zero_point = b_params.zero_point;
+
+  const auto a_scale_vec = Vec256<float>(a_scale);
+  const auto a_zero_point_vec = Vec256<float>((float)a_zero_point);
+  const auto a_scale_neg_zp_premul_vec = a_scale_vec * a_zero_point_vec.neg();
+  const auto b_scale_vec = Vec256<float>(b_scale);
+  const auto b_zero_point_vec = Vec256<float>((float)b_zero_point);
+  const auto b_scale_neg_zp_premul_vec = b_scale_vec * b_zero_point_vec.neg();
+
+  cpu_kernel_vec(
+      iter,
+      [=](scalar_t a, scalar_t b) -> scalar_t {
+        const auto da = at::dequantize_val(a_scale, a_zero_point, a);
+        const auto db = at::dequantize_val(b_scale, b_zero_point, b);
+        return at::quantize_val<scalar_t>(out_scale, out_zero_point, op(da, db));
+      },
+      [=](Vec a, Vec b) -> Vec {
+        const auto da = a.dequantize(
+            a_scale_vec, a_zero_point_vec, a_scale_neg_zp_premul_vec);
+        const auto db = b.dequantize(
+            b_scale_vec, b_zero_point_vec, b_scale_neg_zp_premul_vec);
+        typename Vec::float_vec_return_type retvals;
+        for (int i = 0; i < Vec::float_num_vecs(); ++i) {
+          retvals[i] = vop(da[i], db[i]);
+        }
+        return Vec::quantize(retvals, out_scale, out_zero_point, out_inv_scale);
+      });
+}
+
+} // namespace native
+} // namespace at
@@ -8,6 +8,8 @@ namespace native {
 using qrelu_fn = void (*)(const at::Tensor& /*qx*/, at::Tensor& /*qy*/);
 using qadd_fn =
     void (*)(Tensor& /*out*/, const Tensor& /*self*/, const Tensor& /*other*/);
+using qmul_fn =
+    void (*)(Tensor& /*out*/, const Tensor& /*self*/, const Tensor& /*other*/);
 using qmaxpool_2d_fn = void (*)(
     const Tensor& qx,
     int64_t iC, // input/output channels
@@ -67,6 +69,24 @@ using qupsample_bilinear2d_fn = void (*)(
     int64_t channels,
     bool align_corners);
 
+using qdepthwise_conv2d_fn = void (*)(
+    const Tensor& qx, // NHWC activation
+    Tensor& qy, // NHWC output
+    const int8_t* weight, // [kH][kW][C], channel contiguous
+    const int32_t* weight_zero_points, // C entries if per_channel, else 1
+    const float* requant_scales, // act_scale * w_scale / out_scale
+    const float* bias, // fp32 bias of C entries, may be nullptr
+    bool per_channel,
+    bool relu_fused,
+    int64_t kH,
+    int64_t kW, // kernel size
+    int64_t sH,
+    int64_t sW, // strides
+    int64_t pH,
+    int64_t pW, // padding
+    int64_t dH,
+    int64_t dW); // dilation
+
 using qcat_nhwc_fn = Tensor (*)(
     const c10::List<Tensor>& qxs,
     int64_t dim,
@@ -79,7 +99,10 @@ DECLARE_DISPATCH(qrelu_fn, qrelu_stub);
 DECLARE_DISPATCH(qrelu_fn, qrelu6_stub);
 DECLARE_DISPATCH(qadd_fn, qadd_stub);
 DECLARE_DISPATCH(qadd_fn, qadd_relu_stub);
+DECLARE_DISPATCH(qmul_fn, qmul_stub);
+DECLARE_DISPATCH(qmul_fn, qmul_relu_stub);
 DECLARE_DISPATCH(qmaxpool_2d_fn, qmaxpool_2d_nhwc_stub);
+DECLARE_DISPATCH(qdepthwise_conv2d_fn, qdepthwise_conv2d_nhwc_stub);
 DECLARE_DISPATCH(qadaptive_avg_pool2d_fn, qadaptive_avg_pool2d_nhwc_stub);
 DECLARE_DISPATCH(qavg_pool2d_fn, qavg_pool2d_nhwc_stub);
 DECLARE_DISPATCH(qupsample_bilinear2d_fn, qupsample_bilinear2d_nhwc_stub);
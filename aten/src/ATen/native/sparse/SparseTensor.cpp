@@ -10,6 +10,10 @@
 
 #include <TH/THBlasUtils.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 namespace at { namespace native {
 
 using namespace at::sparse;
@@ -352,6 +356,96 @@ SparseTensor& copy_sparse_(SparseTensor& self, const SparseTensor& src, bool non
   return self._coalesced_(src.is_coalesced());
 }
 
+// Sorts the flattened indices of an uncoalesced tensor together with the
+// positions they came from. Keys are bucketed by value range so that the
+// buckets concatenate in globally sorted order, then each bucket is sorted
+// independently; both the partitioning passes and the per-bucket sorts run
+// under at::parallel_for, so no thread ever writes outside its own range.
+// The position is used as a tie break, which makes the permutation (and
+// therefore the summation order in coalesce) deterministic.
+static std::vector<std::pair<int64_t, int64_t>> sort_flattened_indices(
+    const LongTensor& indices_scalar,
+    int64_t nnz) {
+  std::vector<std::pair<int64_t, int64_t>> sorted(nnz);
+  const int64_t* keys = indices_scalar.data_ptr<int64_t>();
+
+  const int64_t num_chunks = at::get_num_threads();
+  if (nnz < at::internal::GRAIN_SIZE || num_chunks == 1) {
+    for (int64_t j = 0; j < nnz; j++) {
+      sorted[j] = std::make_pair(keys[j], j);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  }
+
+  // A few buckets per thread so an uneven key distribution still spreads the
+  // per-bucket sorts across all cores.
+  const int64_t num_buckets = num_chunks * 4;
+  const int64_t max_key = at::parallel_reduce(
+      0,
+      nnz,
+      at::internal::GRAIN_SIZE,
+      static_cast<int64_t>(0),
+      [keys](int64_t begin, int64_t end, int64_t init) {
+        for (int64_t j = begin; j < end; j++) {
+          init = std::max(init, keys[j]);
+        }
+        return init;
+      },
+      [](int64_t a, int64_t b) { return std::max(a, b); });
+  const int64_t bucket_width = max_key / num_buckets + 1;
+
+  // Counts keys per (chunk, bucket). Chunking is explicit (one parallel_for
+  // iteration per chunk) so the counts can be turned into exact scatter
+  // offsets below.
+  const int64_t chunk_size = divup(nnz, num_chunks);
+  std::vector<int64_t> counts(num_chunks * num_buckets, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      int64_t* chunk_counts = counts.data() + c * num_buckets;
+      const int64_t j_end = std::min((c + 1) * chunk_size, nnz);
+      for (int64_t j = c * chunk_size; j < j_end; j++) {
+        chunk_counts[keys[j] / bucket_width]++;
+      }
+    }
+  });
+
+  // Exclusive scan in bucket-major order: counts[c][b] becomes the offset at
+  // which chunk c starts writing keys of bucket b.
+  std::vector<int64_t> bucket_offsets(num_buckets + 1, 0);
+  int64_t running = 0;
+  for (int64_t b = 0; b < num_buckets; b++) {
+    bucket_offsets[b] = running;
+    for (int64_t c = 0; c < num_chunks; c++) {
+      const int64_t count = counts[c * num_buckets + b];
+      counts[c * num_buckets + b] = running;
+      running += count;
+    }
+  }
+  bucket_offsets[num_buckets] = running;
+
+  // Scatters (key, position) pairs to their buckets, then sorts each bucket.
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      int64_t* chunk_offsets = counts.data() + c * num_buckets;
+      const int64_t j_end = std::min((c + 1) * chunk_size, nnz);
+      for (int64_t j = c * chunk_size; j < j_end; j++) {
+        sorted[chunk_offsets[keys[j] / bucket_width]++] =
+            std::make_pair(keys[j], j);
+      }
+    }
+  });
+  at::parallel_for(0, num_buckets, 1, [&](int64_t bucket_begin, int64_t bucket_end) {
+    for (int64_t b = bucket_begin; b < bucket_end; b++) {
+      std::sort(
+          sorted.begin() + bucket_offsets[b],
+          sorted.begin() + bucket_offsets[b + 1]);
+    }
+  });
+
+  return sorted;
+}
+
 SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
   AT_ASSERT(self.defined());
   TORCH_INTERNAL_ASSERT(at::impl::variable_excluded_from_dispatch());
@@ -383,44 +477,79 @@ SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
   Tensor newValues = at::empty(values.sizes(), values.options());
   alias_into_sparse(dst, newIndices, newValues);
 
-  LongTensor indicesBuffer;
-  LongTensor indicesPermutation;
-  std::tie(indicesBuffer, indicesPermutation) = indices_scalar.sort(0);
+  const auto sorted = sort_flattened_indices(indices_scalar, nnz);
+
+  // Finds the start of every run of equal keys, in two passes so that the
+  // output offset of every chunk is known and the fill can run in parallel.
+  const int64_t num_chunks = at::get_num_threads();
+  const int64_t chunk_size = divup(nnz, num_chunks);
+  const auto is_segment_start = [&sorted](int64_t j) {
+    return j == 0 || sorted[j].first != sorted[j - 1].first;
+  };
+  std::vector<int64_t> chunk_segments(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      const int64_t j_end = std::min((c + 1) * chunk_size, nnz);
+      int64_t num_segments = 0;
+      for (int64_t j = c * chunk_size; j < j_end; j++) {
+        num_segments += is_segment_start(j);
+      }
+      chunk_segments[c + 1] = num_segments;
+    }
+  });
+  for (int64_t c = 0; c < num_chunks; c++) {
+    chunk_segments[c + 1] += chunk_segments[c];
+  }
+  const int64_t new_nnz = chunk_segments[num_chunks];
+  std::vector<int64_t> segment_starts(new_nnz + 1);
+  segment_starts[new_nnz] = nnz; // sentinel, so segment s ends at starts[s + 1]
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      const int64_t j_end = std::min((c + 1) * chunk_size, nnz);
+      int64_t s = chunk_segments[c];
+      for (int64_t j = c * chunk_size; j < j_end; j++) {
+        if (is_segment_start(j)) {
+          segment_starts[s++] = j;
+        }
+      }
+    }
+  });
+
+  // Reduces every segment of duplicates into one output row. Segments are
+  // independent, so the reduction parallelizes over output rows; the adds
+  // within a dense block stay vectorized through THBlas_axpy.
   // NB: The accessor accesses here rely on self._nnz() > 0 (tested earlier in this function)
   auto newIndicesAccessor = newIndices.accessor<int64_t, 2>();
   auto indicesAccessor = indices.accessor<int64_t, 2>();
-  auto indicesPermutationAccessor = indicesPermutation.accessor<int64_t, 1>();
-  auto indicesBufferAccessor = indicesBuffer.accessor<int64_t, 1>();
-
-  int64_t i = -1;
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "coalesce", [&] {
-        int64_t prev = -1;
-        int64_t blockSize = values.stride(0);
+        const int64_t blockSize = values.stride(0);
         scalar_t* values_ptr = values.data_ptr<scalar_t>();
         scalar_t* newValues_ptr = newValues.data_ptr<scalar_t>();
-        for (int64_t j = 0; j < nnz; j++) {
-          int64_t pos = indicesPermutationAccessor[j];
-          int64_t curr = indicesBufferAccessor[j];
-          if (curr == prev) {
-            if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
-              THBlas_axpy<scalar_t>(blockSize, 1, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
-            }
-          } else {
-            ++i;
+        const bool has_values = values.numel() > 0;
+        const int64_t grain = at::calc_grain_size(
+            /*bytes_per_iter=*/(blockSize + 1) * static_cast<int64_t>(sizeof(scalar_t)),
+            /*flops_per_iter=*/blockSize);
+        at::parallel_for(0, new_nnz, grain, [&](int64_t begin, int64_t end) {
+          for (int64_t s = begin; s < end; s++) {
+            const int64_t first = segment_starts[s];
+            const int64_t pos = sorted[first].second;
             for (int64_t d = 0; d < sparse_dim; d++) {
-              newIndicesAccessor[d][i] = indicesAccessor[d][pos];
+              newIndicesAccessor[d][s] = indicesAccessor[d][pos];
             }
-            if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
-              THBlas_copy<scalar_t>(blockSize, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
+            if (!has_values) {  // if values is an empty tensor, there are no elements to copy
+              continue;
+            }
+            THBlas_copy<scalar_t>(blockSize, values_ptr + pos * blockSize, 1, newValues_ptr + s * blockSize, 1);
+            for (int64_t j = first + 1; j < segment_starts[s + 1]; j++) {
+              THBlas_axpy<scalar_t>(blockSize, 1, values_ptr + sorted[j].second * blockSize, 1, newValues_ptr + s * blockSize, 1);
             }
           }
-          prev = curr;
-        }
+        });
     });
 
   dst._coalesced_(true);
-  get_sparse_impl(dst)->set_nnz_and_narrow(i + 1);
+  get_sparse_impl(dst)->set_nnz_and_narrow(new_nnz);
 
   return dst;
 }
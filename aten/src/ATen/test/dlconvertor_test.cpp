@@ -30,3 +30,69 @@ TEST(TestDlconvertor, TestDlconvertorNoStrides) {
 
   ASSERT_TRUE(a.equal(b));
 }
+
+TEST(TestDlconvertor, TestDlconvertorCached) {
+  manual_seed(123);
+
+  Tensor a = rand({3, 4});
+  DLManagedTensor* dlMTensor = toDLPackCached(a);
+  Tensor b = fromDLPack(dlMTensor);
+  ASSERT_TRUE(a.equal(b));
+
+  // Releasing the wrapper (b goes away) and re-exporting the same storage
+  // must hand back the same primed wrapper, not a fresh allocation.
+  b.reset();
+  DLManagedTensor* again = toDLPackCached(a);
+  ASSERT_EQ(again, dlMTensor);
+  Tensor c = fromDLPack(again);
+  ASSERT_TRUE(a.equal(c));
+  c.reset();
+
+  clearDLPackCache();
+}
+
+TEST(TestDlconvertor, TestDlconvertorCachedViewRefill) {
+  manual_seed(123);
+
+  Tensor a = rand({4, 4});
+  Tensor b = fromDLPack(toDLPackCached(a));
+  ASSERT_TRUE(a.equal(b));
+  b.reset();
+
+  // Exporting a different view of the same storage reuses the cached
+  // wrapper but refills its metadata.
+  Tensor narrow = a.narrow(0, 0, 2);
+  Tensor c = fromDLPack(toDLPackCached(narrow));
+  ASSERT_TRUE(narrow.equal(c));
+  c.reset();
+
+  clearDLPackCache();
+}
+
+TEST(TestDlconvertor, TestDlconvertorCachedConcurrentExports) {
+  manual_seed(123);
+
+  // While the cached wrapper is checked out, a second export of the same
+  // storage must get a distinct wrapper.
+  Tensor a = rand({3, 4});
+  DLManagedTensor* first = toDLPackCached(a);
+  DLManagedTensor* second = toDLPackCached(a);
+  ASSERT_NE(first, second);
+  Tensor b = fromDLPack(first);
+  Tensor c = fromDLPack(second);
+  ASSERT_TRUE(b.equal(c));
+  b.reset();
+  c.reset();
+
+  clearDLPackCache();
+}
+
+TEST(TestDlconvertor, TestDLPackHandoffCPU) {
+  manual_seed(123);
+
+  // CPU tensors have no stream; the handoff is a completed no-op.
+  Tensor a = rand({3, 4});
+  auto handoff = DLPackHandoff::record(a);
+  ASSERT_TRUE(handoff.query());
+  handoff.blockCurrentStream();
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/MemoryAccounting.h>
+
+// See Note [Request-scoped memory accounting] in ATen/MemoryAccounting.h.
+
+TEST(MemoryAccountingTest, TracksLiveBytes) {
+  auto info = std::make_shared<at::MemoryAccountingInfo>();
+  ASSERT_EQ(info->current_bytes(), 0);
+  ASSERT_EQ(info->limit_bytes(), -1);
+
+  at::Tensor held;
+  {
+    at::MemoryAccountingScope scope(info);
+    held = at::empty({1024}, at::kFloat);
+    int64_t with_held = info->current_bytes();
+    ASSERT_GE(with_held, 1024 * 4);
+    {
+      at::Tensor temp = at::empty({1024}, at::kFloat);
+      ASSERT_GE(info->current_bytes(), with_held + 1024 * 4);
+    }
+    // The temporary was credited back on free.
+    ASSERT_EQ(info->current_bytes(), with_held);
+    ASSERT_GE(info->peak_bytes(), with_held + 1024 * 4);
+  }
+
+  // Still held after the scope ended; freeing it credits the scope even
+  // though the scope is no longer active.
+  ASSERT_GE(info->current_bytes(), 1024 * 4);
+  held.reset();
+  ASSERT_EQ(info->current_bytes(), 0);
+}
+
+TEST(MemoryAccountingTest, EnforcesLimit) {
+  constexpr int64_t limit = 1 << 20;
+  auto info = std::make_shared<at::MemoryAccountingInfo>(limit);
+  at::MemoryAccountingScope scope(info);
+
+  at::Tensor small = at::empty({1024}, at::kFloat);
+  // 16MB against a 1MB cap: fails this allocation, not the process.
+  ASSERT_ANY_THROW(at::empty({1 << 22}, at::kFloat));
+  ASSERT_LE(info->current_bytes(), limit);
+
+  // The scope is still usable after a refused allocation.
+  at::Tensor small2 = at::empty({1024}, at::kFloat);
+  ASSERT_LE(info->current_bytes(), limit);
+}
+
+TEST(MemoryAccountingTest, OutsideScopeUntracked) {
+  auto info = std::make_shared<at::MemoryAccountingInfo>();
+  { at::MemoryAccountingScope scope(info); }
+  int64_t after_scope = info->current_bytes();
+  at::Tensor unrelated = at::empty({1024}, at::kFloat);
+  ASSERT_EQ(info->current_bytes(), after_scope);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/native/WeightLayoutCache.h>
+
+using namespace at;
+
+TEST(WeightLayoutCacheTest, CachesAndInvalidates) {
+  native::clear_weight_layout_cache();
+
+  auto weight = at::rand({4, 4});
+  int calls = 0;
+  auto transform = [&calls](const Tensor& t) {
+    ++calls;
+    return t.t().contiguous();
+  };
+
+  auto first = native::cached_weight_layout(weight, "transposed", transform);
+  auto second = native::cached_weight_layout(weight, "transposed", transform);
+  ASSERT_EQ(calls, 1);
+  ASSERT_TRUE(first.is_same(second));
+  ASSERT_TRUE(first.equal(weight.t()));
+
+  // A different layout kind for the same weight is cached separately.
+  auto contig = native::cached_weight_layout(weight, "contiguous", transform);
+  ASSERT_EQ(calls, 2);
+  ASSERT_FALSE(contig.is_same(first));
+
+  // In-place mutation bumps the version counter and invalidates the entry.
+  weight.add_(1);
+  auto third = native::cached_weight_layout(weight, "transposed", transform);
+  ASSERT_EQ(calls, 3);
+  ASSERT_FALSE(third.is_same(first));
+  ASSERT_TRUE(third.equal(weight.t()));
+
+  ASSERT_EQ(native::weight_layout_cache_size(), 2);
+  native::clear_weight_layout_cache();
+  ASSERT_EQ(native::weight_layout_cache_size(), 0);
+}
+
+TEST(WeightLayoutCacheTest, ViewsShareInvalidation) {
+  native::clear_weight_layout_cache();
+
+  auto weight = at::rand({4, 4});
+  int calls = 0;
+  auto transform = [&calls](const Tensor& t) {
+    ++calls;
+    return t.clone();
+  };
+
+  (void)native::cached_weight_layout(weight, "clone", transform);
+  ASSERT_EQ(calls, 1);
+
+  // Mutating through a view bumps the shared version counter, so the next
+  // lookup through the base tensor recomputes.
+  auto view = weight.select(0, 0);
+  view.add_(1);
+  auto recomputed = native::cached_weight_layout(weight, "clone", transform);
+  ASSERT_EQ(calls, 2);
+  ASSERT_TRUE(recomputed.equal(weight));
+
+  native::clear_weight_layout_cache();
+}
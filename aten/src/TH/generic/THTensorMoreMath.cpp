@@ -1303,12 +1303,39 @@ void THTensor_(histc)(THTensor *hist, THTensor *tensor, int64_t nbins, scalar_t
 
   h_data = hist->data<scalar_t>();
 
-  TH_TENSOR_APPLY(scalar_t, tensor,
-    if (*tensor_data >= minval && *tensor_data <= maxval) {
-      const int bin = (int)((*tensor_data-minval) / (maxval-minval) * nbins);
-      h_data[THMin(bin, nbins-1)] += 1;
+  if (THTensor_(isContiguous)(tensor)) {
+    // Contiguous inputs take a parallel path: each thread bins into a private
+    // histogram and the copies are merged at the end, so no atomics are
+    // needed on the shared output.
+    const scalar_t *t_data = tensor->data<scalar_t>();
+    const ptrdiff_t n = THTensor_(nElement)(tensor);
+    const int num_threads = at::get_num_threads();
+    std::vector<scalar_t> partials(num_threads * nbins, (scalar_t)0);
+    at::parallel_for(
+        0, n, TH_OMP_OVERHEAD_THRESHOLD, [&](int64_t begin, int64_t end) {
+          scalar_t *h_local = partials.data() + at::get_thread_num() * nbins;
+          for (auto i = begin; i < end; i++) {
+            const scalar_t val = t_data[i];
+            if (val >= minval && val <= maxval) {
+              const int bin = (int)((val - minval) / (maxval - minval) * nbins);
+              h_local[THMin(bin, nbins - 1)] += 1;
+            }
+          }
+        });
+    for (int t = 0; t < num_threads; t++) {
+      const scalar_t *h_local = partials.data() + t * nbins;
+      for (int64_t b = 0; b < nbins; b++) {
+        h_data[b] += h_local[b];
+      }
     }
-  );
+  } else {
+    TH_TENSOR_APPLY(scalar_t, tensor,
+      if (*tensor_data >= minval && *tensor_data <= maxval) {
+        const int bin = (int)((*tensor_data-minval) / (maxval-minval) * nbins);
+        h_data[THMin(bin, nbins-1)] += 1;
+      }
+    );
+  }
 }
 
 void THTensor_(bhistc)(THTensor *hist, THTensor *tensor, int64_t nbins, scalar_t minvalue, scalar_t maxvalue)
@@ -42,6 +42,28 @@ static bool BlockComparator(const BlockSize& a, const BlockSize& b)
   return (uintptr_t)a.ptr < (uintptr_t)b.ptr;
 }
 
+// Rounds allocation sizes up to a small set of size classes so that
+// slightly varying request sizes (e.g. ragged final batches from a data
+// loader) keep hitting cached blocks instead of forcing a fresh
+// cudaHostAlloc: power-of-two classes up to 1MiB, then 1MiB multiples to
+// bound the slack on large transfer buffers.
+static size_t allocationSize(size_t size)
+{
+  const size_t kMinAllocation = 4096;
+  const size_t kRoundLarge = 1048576;
+  if (size <= kMinAllocation) {
+    return kMinAllocation;
+  }
+  if (size >= kRoundLarge) {
+    return kRoundLarge * ((size + kRoundLarge - 1) / kRoundLarge);
+  }
+  size_t rounded = kMinAllocation;
+  while (rounded < size) {
+    rounded *= 2;
+  }
+  return rounded;
+}
+
 struct HostAllocator
 {
   typedef bool (*Comparison)(const BlockSize&, const BlockSize&);
@@ -62,7 +84,10 @@ struct HostAllocator
 
   cudaError_t malloc(void** ptr, size_t size)
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // round to a size class so steady-state callers reuse cached blocks
+    size = allocationSize(size);
 
     // process outstanding cuda events which may have occurred
     cudaError_t err = processEvents();
@@ -96,8 +121,13 @@ struct HostAllocator
     // note that cudaHostAlloc may not touch pointer if size is 0
     *ptr = 0;
 
-    // allocate a new block if no cached allocation is found
+    // allocate a new block if no cached allocation is found. cudaHostAlloc
+    // takes a driver lock and can block for milliseconds, so drop our own
+    // mutex while it runs; concurrent loader threads can keep hitting the
+    // cache (or pay for their own fresh allocation) in the meantime.
+    lock.unlock();
     err = cudaHostAlloc(ptr, size, cudaHostAllocDefault);
+    lock.lock();
     if (err != cudaSuccess) {
       return err;
     }
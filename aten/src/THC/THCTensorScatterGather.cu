@@ -3,6 +3,28 @@
 #include <THC/THCAtomics.cuh>
 #include <THC/THCApply.cuh>
 
+// Magic-number dividers for every dimension of the index tensor, built once
+// on the host so that the per-element decomposition of a linear index avoids
+// hardware integer division (see THCIntegerDivider.cuh; only IndexType ==
+// unsigned int has a fast path, 64-bit indexing falls back to plain
+// division). All tensors here are decomposed with the *index* tensor's
+// sizes, so a single divider array serves every operand.
+template <typename IndexType>
+struct ScatterGatherDimDividers {
+  explicit ScatterGatherDimDividers(
+      const TensorInfo<int64_t, IndexType>& index) {
+    for (int d = 0; d < index.dims; d++) {
+      // A zero-size dimension means zero elements: the kernel body never
+      // runs, but the divider is still constructed host-side, so keep the
+      // divisor legal.
+      sizes[d] = IntDivider<IndexType>(
+          index.sizes[d] == 0 ? 1 : index.sizes[d]);
+    }
+  }
+
+  IntDivider<IndexType> sizes[MAX_CUTORCH_DIMS];
+};
+
 // Compute the offsets into the given tensors for a linear index. For the 't2'
 // tensor, dimension 'dim' is skipped. The tensors are assumed to have the same
 // size (with the exception of 't2' in dimension 'dim').
@@ -11,31 +33,35 @@ template <typename IndexType, typename Real, int Dims>
 struct IndexToScatterGatherOffsets {
   static __device__ void compute(
       IndexType linearId, const int dim,
+      const ScatterGatherDimDividers<IndexType>& divs,
       const TensorInfo<int64_t, IndexType>& index, IndexType* indexOffset,
       const TensorInfo<Real, IndexType>& t1, IndexType* t1Offset,
       const TensorInfo<Real, IndexType>& t2, IndexType* t2Offset) {
     for (int d = Dims - 1; d >= 0; d--) {
-      IndexType curDimIndex = linearId % index.sizes[d];
+      DivMod<IndexType> divmod = divs.sizes[d].divmod(linearId);
+      IndexType curDimIndex = divmod.mod;
       *indexOffset += curDimIndex * index.strides[d];
       *t1Offset += curDimIndex * t1.strides[d];
       if (d != dim) {
         *t2Offset += curDimIndex * t2.strides[d];
       }
-      linearId /= index.sizes[d];
+      linearId = divmod.div;
     }
   }
 
   static __device__ void compute(
       IndexType linearId, const int dim,
+      const ScatterGatherDimDividers<IndexType>& divs,
       const TensorInfo<int64_t, IndexType>& index, IndexType* indexOffset,
       const TensorInfo<Real, IndexType>& t2, IndexType* t2Offset) {
     for (int d = Dims - 1; d >= 0; d--) {
-      IndexType curDimIndex = linearId % index.sizes[d];
+      DivMod<IndexType> divmod = divs.sizes[d].divmod(linearId);
+      IndexType curDimIndex = divmod.mod;
       *indexOffset += curDimIndex * index.strides[d];
       if (d != dim) {
         *t2Offset += curDimIndex * t2.strides[d];
       }
-      linearId /= index.sizes[d];
+      linearId = divmod.div;
     }
   }
 };
@@ -45,31 +71,35 @@ template <typename IndexType, typename Real>
 struct IndexToScatterGatherOffsets<IndexType, Real, -1> {
   static __device__ void compute(
       IndexType linearId, const int dim,
+      const ScatterGatherDimDividers<IndexType>& divs,
       const TensorInfo<int64_t, IndexType>& index, IndexType* indexOffset,
       const TensorInfo<Real, IndexType>& t1, IndexType* t1Offset,
       const TensorInfo<Real, IndexType>& t2, IndexType* t2Offset) {
     for (int d = index.dims - 1; d >= 0; d--) {
-      IndexType curDimIndex = linearId % index.sizes[d];
+      DivMod<IndexType> divmod = divs.sizes[d].divmod(linearId);
+      IndexType curDimIndex = divmod.mod;
       *indexOffset += curDimIndex * index.strides[d];
       *t1Offset += curDimIndex * t1.strides[d];
       if (d != dim) {
         *t2Offset += curDimIndex * t2.strides[d];
       }
-      linearId /= index.sizes[d];
+      linearId = divmod.div;
     }
   }
 
   static __device__ void compute(
       IndexType linearId, const int dim,
+      const ScatterGatherDimDividers<IndexType>& divs,
       const TensorInfo<int64_t, IndexType>& index, IndexType* indexOffset,
       const TensorInfo<Real, IndexType>& t2, IndexType* t2Offset) {
     for (int d = index.dims - 1; d >= 0; d--) {
-      IndexType curDimIndex = linearId % index.sizes[d];
+      DivMod<IndexType> divmod = divs.sizes[d].divmod(linearId);
+      IndexType curDimIndex = divmod.mod;
       *indexOffset += curDimIndex * index.strides[d];
       if (d != dim) {
         *t2Offset += curDimIndex * t2.strides[d];
       }
-      linearId /= index.sizes[d];
+      linearId = divmod.div;
     }
   }
 };
@@ -82,6 +112,7 @@ __global__ void THCudaTensor_gatherKernel(
     TensorInfo<Real, IndexType> tensor,
     TensorInfo<Real, IndexType> src,
     TensorInfo<int64_t, IndexType> index,
+    const ScatterGatherDimDividers<IndexType> indexDivs,
     const int dim,
     const IndexType totalElements) {
   for (IndexType linearId = blockIdx.x * blockDim.x + threadIdx.x;
@@ -92,6 +123,7 @@ __global__ void THCudaTensor_gatherKernel(
     IndexType indexOffset = 0;
 
     IndexToScatterGatherOffsets<IndexType, Real, Dims>::compute(linearId, dim,
+                                                          indexDivs,
                                                           index, &indexOffset,
                                                           tensor, &tensorOffset,
                                                           src, &srcOffset);
@@ -112,6 +144,7 @@ __global__ void THCudaTensor_scatterKernel(
     TensorInfo<Real, IndexType> tensor,
     TensorInfo<Real, IndexType> src,
     TensorInfo<int64_t, IndexType> index,
+    const ScatterGatherDimDividers<IndexType> indexDivs,
     const int dim,
     const IndexType totalElements) {
   for (IndexType linearId = blockIdx.x * blockDim.x + threadIdx.x;
@@ -122,6 +155,7 @@ __global__ void THCudaTensor_scatterKernel(
     IndexType indexOffset = 0;
 
     IndexToScatterGatherOffsets<IndexType, Real, Dims>::compute(linearId, dim,
+                                                          indexDivs,
                                                           index, &indexOffset,
                                                           src, &srcOffset,
                                                           tensor, &tensorOffset);
@@ -142,6 +176,7 @@ __global__ void THCudaTensor_scatterAddKernel(
     TensorInfo<Real, IndexType> tensor,
     TensorInfo<Real, IndexType> src,
     TensorInfo<int64_t, IndexType> index,
+    const ScatterGatherDimDividers<IndexType> indexDivs,
     const int dim,
     const IndexType totalElements) {
   for (IndexType linearId = blockIdx.x * blockDim.x + threadIdx.x;
@@ -152,6 +187,7 @@ __global__ void THCudaTensor_scatterAddKernel(
     IndexType indexOffset = 0;
 
     IndexToScatterGatherOffsets<IndexType, Real, Dims>::compute(linearId, dim,
+                                                          indexDivs,
                                                           index, &indexOffset,
                                                           src, &srcOffset,
                                                           tensor, &tensorOffset);
@@ -171,6 +207,7 @@ C10_LAUNCH_BOUNDS_1(512)
 __global__ void THCudaTensor_scatterFillKernel(
     TensorInfo<Real, IndexType> tensor,
     TensorInfo<int64_t, IndexType> index,
+    const ScatterGatherDimDividers<IndexType> indexDivs,
     Real value,
     const int dim,
     const IndexType totalElements) {
@@ -181,6 +218,7 @@ __global__ void THCudaTensor_scatterFillKernel(
     IndexType indexOffset = 0;
 
     IndexToScatterGatherOffsets<IndexType, Real, Dims>::compute(linearId, dim,
+                                                          indexDivs,
                                                           index, &indexOffset,
                                                           tensor, &tensorOffset);
 
@@ -5,7 +5,8 @@
 #define RUN(TYPE, DIMS, REAL)                                           \
   THCudaTensor_gatherKernel<TYPE, REAL, DIMS>                                \
   <<<grid, block, 0, THCState_getCurrentStreamOnDevice(state, curDevice)>>>(               \
-    tensorInfo, srcInfo, indexInfo, dim, (TYPE)totalElements);
+    tensorInfo, srcInfo, indexInfo,                                     \
+    ScatterGatherDimDividers<TYPE>(indexInfo), dim, (TYPE)totalElements);
 
 void THCTensor_(gather)(THCState* state, THCTensor *tensor,
                          THCTensor *src, int dim, THCudaLongTensor *index) {
@@ -101,7 +102,8 @@ void THCTensor_(gather)(THCState* state, THCTensor *tensor,
 #define RUN(TYPE, DIMS, REAL)                                           \
   THCudaTensor_scatterKernel<TYPE, REAL, DIMS>                               \
   <<<grid, block, 0, THCState_getCurrentStreamOnDevice(state, curDevice)>>>(               \
-    tensorInfo, srcInfo, indexInfo, dim, (TYPE)totalElements);
+    tensorInfo, srcInfo, indexInfo,                                     \
+    ScatterGatherDimDividers<TYPE>(indexInfo), dim, (TYPE)totalElements);
 
 void THCTensor_(scatter)(THCState* state, THCTensor *tensor, int dim, THCudaLongTensor *index, THCTensor *src) {
   THCAssertSameGPU(THCTensor_(checkGPU)(state, 2, tensor, src));
@@ -199,7 +201,8 @@ void THCTensor_(scatter)(THCState* state, THCTensor *tensor, int dim, THCudaLong
 #define RUN(TYPE, DIMS, REAL)                                           \
   THCudaTensor_scatterAddKernel<TYPE, REAL, DIMS>                               \
   <<<grid, block, 0, THCState_getCurrentStreamOnDevice(state, curDevice)>>>(               \
-    tensorInfo, srcInfo, indexInfo, dim, (TYPE)totalElements);
+    tensorInfo, srcInfo, indexInfo,                                     \
+    ScatterGatherDimDividers<TYPE>(indexInfo), dim, (TYPE)totalElements);
 
 void THCTensor_(scatterAdd)(THCState* state, THCTensor *tensor, int dim, THCudaLongTensor *index, THCTensor *src) {
   THCAssertSameGPU(THCTensor_(checkGPU)(state, 2, tensor, src));
@@ -298,7 +301,8 @@ void THCTensor_(scatterAdd)(THCState* state, THCTensor *tensor, int dim, THCudaL
 #define RUN(TYPE, DIMS, REAL)                                           \
   THCudaTensor_scatterFillKernel<TYPE, REAL, DIMS>                           \
       <<<grid, block, 0, THCState_getCurrentStreamOnDevice(state, curDevice)>>>(      \
-          tensorInfo, indexInfo, value, dim, (TYPE)totalElements);
+          tensorInfo, indexInfo, ScatterGatherDimDividers<TYPE>(indexInfo), \
+          value, dim, (TYPE)totalElements);
 
 void
 THCTensor_(scatterFill)(THCState* state, THCTensor *tensor,
@@ -0,0 +1,91 @@
+from __future__ import print_function
+
+import platform
+import random
+import socket
+import time
+
+import torch
+
+# time.perf_counter is not available on python 2
+timer = getattr(time, 'perf_counter', time.time)
+
+
+def environment_fingerprint():
+    """Collects everything that can legitimately move a benchmark number.
+
+    A baseline recorded under a different fingerprint is still compared, but
+    the harness warns: a "regression" against a baseline from a different
+    machine or build usually is not one.
+    """
+    fingerprint = {
+        'torch_version': torch.__version__,
+        'debug_build': bool(torch.version.debug),
+        'cuda_version': torch.version.cuda,
+        'hostname': socket.gethostname(),
+        'platform': platform.platform(),
+        'processor': platform.processor(),
+        'python_version': platform.python_version(),
+        'num_threads': torch.get_num_threads(),
+    }
+    if hasattr(torch.version, 'git_version'):
+        fingerprint['git_version'] = torch.version.git_version
+    return fingerprint
+
+
+def time_benchmark(fn, warmup=20, nloops=100):
+    """Returns per-call wall times in microseconds, one per loop."""
+    for _ in range(warmup):
+        fn()
+    samples_us = []
+    for _ in range(nloops):
+        start = timer()
+        fn()
+        samples_us.append((timer() - start) * 1e6)
+    return samples_us
+
+
+def _bootstrap_means(samples, resamples, rng):
+    n = len(samples)
+    means = []
+    for _ in range(resamples):
+        total = 0.0
+        for _ in range(n):
+            total += samples[rng.randrange(n)]
+        means.append(total / n)
+    return means
+
+
+def compare(baseline_samples, candidate_samples, confidence=0.95,
+            resamples=1000, seed=0):
+    """Bootstrap comparison of two sample sets.
+
+    Resamples both runs, forms the distribution of the relative slowdown
+    (candidate mean / baseline mean - 1) and returns its mean along with the
+    confidence interval at the requested level. The caller flags a
+    regression only when the *lower* bound of the interval clears its
+    threshold, so noisy benchmarks need a real shift to fail the gate.
+    """
+    rng = random.Random(seed)
+    baseline_means = _bootstrap_means(baseline_samples, resamples, rng)
+    candidate_means = _bootstrap_means(candidate_samples, resamples, rng)
+    slowdowns = sorted(
+        c / b - 1.0 for b, c in zip(baseline_means, candidate_means))
+    lo_idx = int(len(slowdowns) * (1.0 - confidence) / 2.0)
+    hi_idx = len(slowdowns) - 1 - lo_idx
+    return {
+        'slowdown': sum(slowdowns) / len(slowdowns),
+        'slowdown_lo': slowdowns[lo_idx],
+        'slowdown_hi': slowdowns[hi_idx],
+        'confidence': confidence,
+    }
+
+
+def summarize(samples_us):
+    ordered = sorted(samples_us)
+    return {
+        'median_us': ordered[len(ordered) // 2],
+        'mean_us': sum(ordered) / len(ordered),
+        'min_us': ordered[0],
+        'max_us': ordered[-1],
+    }
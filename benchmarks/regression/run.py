@@ -0,0 +1,108 @@
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import sys
+
+from .harness import compare, environment_fingerprint, summarize
+from .suites import all_suites, run_suites
+
+
+def load_baseline(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def write_json(path, payload):
+    with open(path, 'w') as f:
+        json.dump(payload, f, indent=2, sort_keys=True)
+        f.write('\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Benchmark regression gate: runs the CPU-facing JIT '
+                    'executor, autograd overhead and native/cpu kernel '
+                    'suites, compares against a stored JSON baseline and '
+                    'exits nonzero on a statistically significant '
+                    'regression.')
+    parser.add_argument('--group', nargs='*', default=None,
+                        choices=sorted(all_suites().keys()),
+                        help='which suites to run (default: all)')
+    parser.add_argument('--warmup', default=20, type=int)
+    parser.add_argument('--nloops', default=100, type=int)
+    parser.add_argument('--baseline', default=None,
+                        help='baseline JSON to compare against')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='write the results of this run to --baseline '
+                             'instead of comparing')
+    parser.add_argument('--json', default=None, dest='json_out',
+                        help='also write this run\'s results to a JSON file')
+    parser.add_argument('--max-regression', default=0.05, type=float,
+                        help='relative slowdown above which a benchmark '
+                             'fails (default 5%%)')
+    parser.add_argument('--confidence', default=0.95, type=float,
+                        help='bootstrap confidence level for the slowdown '
+                             'interval')
+    args = parser.parse_args()
+
+    samples = run_suites(
+        groups=args.group, warmup=args.warmup, nloops=args.nloops)
+    payload = {
+        'environment': environment_fingerprint(),
+        'benchmarks': {
+            name: dict(summarize(s), samples_us=s)
+            for name, s in samples.items()
+        },
+    }
+
+    if args.json_out:
+        write_json(args.json_out, payload)
+
+    if args.baseline and args.update_baseline:
+        write_json(args.baseline, payload)
+        print('wrote baseline to {}'.format(args.baseline))
+        return 0
+
+    for name in sorted(samples):
+        print('{:32s} median {:10.2f} us'.format(
+            name, payload['benchmarks'][name]['median_us']))
+
+    if not args.baseline:
+        return 0
+    if not os.path.exists(args.baseline):
+        print('baseline {} does not exist; run with --update-baseline '
+              'to create it'.format(args.baseline), file=sys.stderr)
+        return 2
+
+    baseline = load_baseline(args.baseline)
+    if baseline['environment'] != payload['environment']:
+        print('warning: environment fingerprint differs from the baseline; '
+              'comparison may not be meaningful', file=sys.stderr)
+
+    failed = []
+    for name in sorted(samples):
+        base = baseline['benchmarks'].get(name)
+        if base is None or 'samples_us' not in base:
+            print('{:32s} no baseline'.format(name))
+            continue
+        stats = compare(base['samples_us'], samples[name],
+                        confidence=args.confidence)
+        regressed = stats['slowdown_lo'] > args.max_regression
+        print('{:32s} slowdown {:+7.2%} [{:+7.2%}, {:+7.2%}]{}'.format(
+            name, stats['slowdown'], stats['slowdown_lo'],
+            stats['slowdown_hi'], '  REGRESSION' if regressed else ''))
+        if regressed:
+            failed.append(name)
+
+    if failed:
+        print('{} benchmark(s) regressed beyond {:.0%}: {}'.format(
+            len(failed), args.max_regression, ', '.join(failed)),
+            file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
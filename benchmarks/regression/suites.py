@@ -0,0 +1,110 @@
+from __future__ import print_function
+
+import torch
+
+from .harness import time_benchmark
+
+# Each suite is a list of (name, make_fn) pairs; make_fn builds the
+# benchmark closure (allocating its tensors once) so the timed region is
+# only the work under test. Everything here runs on CPU so the gate does
+# not need a GPU machine; fastrnns remains the CUDA-facing suite.
+
+
+def _jit_executor_benchmarks():
+    @torch.jit.script
+    def loop_mm(x, w, iters):
+        # type: (Tensor, Tensor, int) -> Tensor
+        y = x
+        for _ in range(iters):
+            y = torch.mm(y, w) * 0.5 + x
+        return y
+
+    @torch.jit.script
+    def cell(x, h, w_ih, w_hh):
+        # type: (Tensor, Tensor, Tensor, Tensor) -> Tensor
+        return torch.tanh(torch.mm(x, w_ih.t()) + torch.mm(h, w_hh.t()))
+
+    def make_loop_mm():
+        x = torch.randn(16, 16)
+        w = torch.randn(16, 16)
+        return lambda: loop_mm(x, w, 20)
+
+    def make_cell():
+        x = torch.randn(8, 64)
+        h = torch.randn(8, 64)
+        w_ih = torch.randn(64, 64)
+        w_hh = torch.randn(64, 64)
+        return lambda: cell(x, h, w_ih, w_hh)
+
+    return [
+        ('jit.loop_mm', make_loop_mm),
+        ('jit.rnn_cell', make_cell),
+    ]
+
+
+def _autograd_benchmarks():
+    def make_small_backward():
+        x = torch.randn(32, 32, requires_grad=True)
+        w = torch.randn(32, 32, requires_grad=True)
+
+        def run():
+            loss = (torch.mm(x, w).tanh()).sum()
+            loss.backward()
+            x.grad.detach_().zero_()
+            w.grad.detach_().zero_()
+        return run
+
+    def make_grad_subset():
+        adapter = torch.randn(16, 16, requires_grad=True)
+        frozen = torch.randn(16, 16, requires_grad=True)
+
+        def run():
+            loss = (adapter * 3 + frozen * frozen).sum()
+            torch.autograd.grad(loss, [adapter])
+        return run
+
+    return [
+        ('autograd.small_backward', make_small_backward),
+        ('autograd.grad_subset', make_grad_subset),
+    ]
+
+
+def _cpu_kernel_benchmarks():
+    def make_unary(fn, shape):
+        x = torch.randn(*shape)
+        return lambda: fn(x)
+
+    def make_binary(fn, shape):
+        x = torch.randn(*shape)
+        y = torch.randn(*shape)
+        return lambda: fn(x, y)
+
+    return [
+        ('cpu.sum', lambda: make_unary(torch.sum, (1024, 1024))),
+        ('cpu.softmax',
+         lambda: make_unary(lambda x: torch.softmax(x, -1), (128, 1024))),
+        ('cpu.sigmoid', lambda: make_unary(torch.sigmoid, (1024, 1024))),
+        ('cpu.add', lambda: make_binary(torch.add, (1024, 1024))),
+        ('cpu.mul', lambda: make_binary(torch.mul, (1024, 1024))),
+        ('cpu.mm', lambda: make_binary(torch.mm, (256, 256))),
+    ]
+
+
+def all_suites():
+    return {
+        'jit': _jit_executor_benchmarks(),
+        'autograd': _autograd_benchmarks(),
+        'cpu_kernels': _cpu_kernel_benchmarks(),
+    }
+
+
+def run_suites(groups=None, warmup=20, nloops=100):
+    """Runs the selected suites and returns {benchmark name: samples (us)}."""
+    results = {}
+    for group_name, benchmarks in sorted(all_suites().items()):
+        if groups and group_name not in groups:
+            continue
+        for name, make_fn in benchmarks:
+            results[name] = time_benchmark(
+                make_fn(), warmup=warmup, nloops=nloops)
+    return results
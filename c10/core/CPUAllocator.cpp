@@ -1,6 +1,14 @@
 #include <c10/core/CPUAllocator.h>
 #include <c10/core/DeviceType.h>
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/mman.h>
+#endif
+
 // TODO: rename flags to C10
 C10_DEFINE_bool(
     caffe2_report_cpu_memory_usage,
@@ -17,6 +25,23 @@ C10_DEFINE_bool(
     false,
     "If set, fill memory with deterministic junk when allocating on CPU");
 
+C10_DEFINE_bool(
+    caffe2_cpu_small_alloc_cache,
+    false,
+    "If set, serve small CPU allocations from a thread-local freelist cache "
+    "instead of the system allocator");
+
+C10_DEFINE_bool(
+    caffe2_cpu_hugepages,
+    false,
+    "If set, back large CPU allocations with 2MB huge pages (Linux only)");
+
+C10_DEFINE_int64(
+    caffe2_cpu_hugepage_min_size,
+    64 * 1024 * 1024,
+    "Minimum allocation size, in bytes, eligible for huge-page backing when "
+    "caffe2_cpu_hugepages is set");
+
 namespace c10 {
 
 void memset_junk(void* data, size_t num) {
@@ -36,6 +61,120 @@ void memset_junk(void* data, size_t num) {
   }
 }
 
+#if defined(__linux__) && !defined(__ANDROID__)
+namespace {
+
+// Huge-page backing for large allocations (FLAGS_caffe2_cpu_hugepages).
+//
+// Random lookups into multi-GB tables are dominated by dTLB misses under 4KB
+// pages; 2MB pages cut the number of TLB entries covering a table by 512x.
+// Eligible allocations first try an explicit MAP_HUGETLB mapping, which only
+// succeeds when huge pages have been reserved (/proc/sys/vm/nr_hugepages).
+// If the reserved pool is empty or absent, they fall back to a 2MB-aligned
+// regular allocation with madvise(MADV_HUGEPAGE), letting transparent huge
+// pages back the region opportunistically. Explicit mappings must be
+// munmap'ed with their size, so they are recorded in a side table that
+// free_cpu consults for 2MB-aligned pointers; everything else still goes
+// through free().
+
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+struct HugePageRegions {
+  std::mutex mutex;
+  std::unordered_map<void*, size_t> sizes;
+};
+
+HugePageRegions& hugePageRegions() {
+  static HugePageRegions regions;
+  return regions;
+}
+
+bool useHugePages(size_t nbytes) {
+  return FLAGS_caffe2_cpu_hugepages &&
+      nbytes >= static_cast<size_t>(FLAGS_caffe2_cpu_hugepage_min_size);
+}
+
+// Returns nullptr on failure; the caller falls back to the regular path.
+void* allocHugePages(size_t nbytes) {
+  const size_t mapped_size =
+      (nbytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  void* data = mmap(
+      nullptr,
+      mapped_size,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+      -1,
+      0);
+  if (data != MAP_FAILED) {
+    auto& regions = hugePageRegions();
+    std::lock_guard<std::mutex> guard(regions.mutex);
+    regions.sizes[data] = mapped_size;
+    return data;
+  }
+  // No explicit huge pages reserved. Allocations this large are served by
+  // glibc via mmap anyway, so requesting 2MB alignment only costs reserved
+  // address space and makes the whole region eligible for THP.
+  if (posix_memalign(&data, kHugePageSize, nbytes) != 0) {
+    return nullptr;
+  }
+#ifdef MADV_HUGEPAGE
+  madvise(data, nbytes, MADV_HUGEPAGE);
+#endif
+  return data;
+}
+
+// Unmaps `data` and returns true iff it was an explicit huge-page mapping.
+// The alignment check keeps ordinary frees off the side table's mutex.
+bool freeHugePages(void* data) {
+  if (data == nullptr ||
+      (reinterpret_cast<uintptr_t>(data) & (kHugePageSize - 1)) != 0) {
+    return false;
+  }
+  size_t mapped_size = 0;
+  {
+    auto& regions = hugePageRegions();
+    std::lock_guard<std::mutex> guard(regions.mutex);
+    auto it = regions.sizes.find(data);
+    if (it == regions.sizes.end()) {
+      return false;
+    }
+    mapped_size = it->second;
+    regions.sizes.erase(it);
+  }
+  munmap(data, mapped_size);
+  return true;
+}
+
+} // namespace
+#endif // defined(__linux__) && !defined(__ANDROID__)
+
+namespace {
+std::atomic<CPUMemoryAccountingHook*> cpu_memory_accounting_hook{nullptr};
+} // namespace
+
+void SetCPUMemoryAccountingHook(CPUMemoryAccountingHook* hook) {
+  CPUMemoryAccountingHook* expected = nullptr;
+  if (!cpu_memory_accounting_hook.compare_exchange_strong(expected, hook)) {
+    CAFFE_THROW("a CPU memory accounting hook is already installed");
+  }
+}
+
+CPUMemoryAccountingHook* GetCPUMemoryAccountingHook() {
+  return cpu_memory_accounting_hook.load(std::memory_order_acquire);
+}
+
+void SetCPUHugePagesEnabled(bool enabled) {
+  FLAGS_caffe2_cpu_hugepages = enabled;
+}
+
+bool CPUHugePagesEnabled() {
+  return FLAGS_caffe2_cpu_hugepages;
+}
+
+void SetCPUHugePageMinSize(size_t nbytes) {
+  FLAGS_caffe2_cpu_hugepage_min_size = static_cast<int64_t>(nbytes);
+}
+
 void* alloc_cpu(size_t nbytes) {
   if (nbytes == 0) {
     return nullptr;
@@ -46,24 +185,32 @@ void* alloc_cpu(size_t nbytes) {
     ((ptrdiff_t)nbytes) >= 0,
     "alloc_cpu() seems to have been called with negative number: ", nbytes);
 
-  void* data;
+  void* data = nullptr;
+#if defined(__linux__) && !defined(__ANDROID__)
+  if (useHugePages(nbytes)) {
+    data = allocHugePages(nbytes);
+  }
+  if (data == nullptr)
+#endif
+  {
 #ifdef __ANDROID__
-  data = memalign(gAlignment, nbytes);
+    data = memalign(gAlignment, nbytes);
 #elif defined(_MSC_VER)
-  data = _aligned_malloc(nbytes, gAlignment);
+    data = _aligned_malloc(nbytes, gAlignment);
 #else
-  int err = posix_memalign(&data, gAlignment, nbytes);
-  if (err != 0) {
-    CAFFE_THROW(
-        "DefaultCPUAllocator: can't allocate memory: you tried to allocate ",
-        nbytes,
-        " bytes. Error code ",
-        err,
-        " (",
-        strerror(err),
-        ")");
-  }
+    int err = posix_memalign(&data, gAlignment, nbytes);
+    if (err != 0) {
+      CAFFE_THROW(
+          "DefaultCPUAllocator: can't allocate memory: you tried to allocate ",
+          nbytes,
+          " bytes. Error code ",
+          err,
+          " (",
+          strerror(err),
+          ")");
+    }
 #endif
+  }
 
   CAFFE_ENFORCE(
       data,
@@ -71,8 +218,13 @@ void* alloc_cpu(size_t nbytes) {
       nbytes,
       " bytes. Buy new RAM!");
 
-  // move data to a thread's NUMA node
-  NUMAMove(data, nbytes, GetCurrentNUMANode());
+  // move data to the thread's pinned NUMA node if one was set via
+  // SetThreadNUMANode, otherwise to the node the thread is running on
+  int numa_node = GetThreadNUMANode();
+  if (numa_node < 0) {
+    numa_node = GetCurrentNUMANode();
+  }
+  NUMAMove(data, nbytes, numa_node);
   CHECK(
       !FLAGS_caffe2_cpu_allocator_do_zero_fill ||
       !FLAGS_caffe2_cpu_allocator_do_junk_fill)
@@ -87,6 +239,11 @@ void* alloc_cpu(size_t nbytes) {
 }
 
 void free_cpu(void* data) {
+#if defined(__linux__) && !defined(__ANDROID__)
+  if (freeHugePages(data)) {
+    return;
+  }
+#endif
 #ifdef _MSC_VER
   _aligned_free(data);
 #else
@@ -94,6 +251,201 @@ void free_cpu(void* data) {
 #endif
 }
 
+namespace {
+
+// Small-allocation cache (FLAGS_caffe2_cpu_small_alloc_cache).
+//
+// Scripted models churn through millions of scalar-sized tensors (losses,
+// indices, shapes), and each one pays for a posix_memalign/free pair plus a
+// NUMA move. When the flag is set, allocations up to kSmallAllocMaxSize are
+// instead carved out of thread-local slabs and recycled through per-size-class
+// freelists.
+//
+// Every allocation is prefixed by a gAlignment-sized header that records the
+// owning thread cache (nullptr for allocations that went to the system
+// allocator because they were too big), so a single deleter can free any
+// pointer no matter which path produced it or which thread frees it. Blocks
+// freed from another thread go onto the owning cache's remote list under a
+// mutex; the owning thread drains that list when its local freelist runs dry.
+// A cache stays alive until its thread has exited *and* its last outstanding
+// block has been freed, whichever comes second.
+
+constexpr size_t kSmallAllocMaxSize = 512;
+constexpr size_t kSmallAllocHeaderSize = gAlignment; // keeps data 64B aligned
+constexpr size_t kSmallAllocNumClasses = kSmallAllocMaxSize / gAlignment;
+// Blocks carved out of a slab per refill, per size class.
+constexpr size_t kSmallAllocBlocksPerSlab = 64;
+
+class SmallAllocCache;
+
+struct SmallAllocHeader {
+  SmallAllocCache* owner; // nullptr: allocated with alloc_cpu
+  size_t size_class;
+};
+
+static_assert(
+    sizeof(SmallAllocHeader) <= kSmallAllocHeaderSize,
+    "SmallAllocHeader must fit in the alignment padding");
+
+class SmallAllocCache {
+ public:
+  struct Block {
+    Block* next;
+  };
+
+  SmallAllocCache() {
+    for (size_t i = 0; i < kSmallAllocNumClasses; ++i) {
+      free_lists_[i] = nullptr;
+      remote_free_lists_[i] = nullptr;
+    }
+  }
+
+  ~SmallAllocCache() {
+    for (void* slab : slabs_) {
+      free_cpu(slab);
+    }
+  }
+
+  void* allocate(size_t size_class) {
+    Block* block = free_lists_[size_class];
+    if (block == nullptr) {
+      drainRemoteList(size_class);
+      block = free_lists_[size_class];
+    }
+    if (block == nullptr) {
+      refill(size_class);
+      block = free_lists_[size_class];
+    }
+    free_lists_[size_class] = block->next;
+    // next shares storage with the header (a block needs one or the other,
+    // never both), so the header has to be rewritten on every allocation.
+    auto* header = reinterpret_cast<SmallAllocHeader*>(block);
+    header->owner = this;
+    header->size_class = size_class;
+    // The thread keeps one reference for itself, so this can't race to zero.
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    return reinterpret_cast<char*>(block) + kSmallAllocHeaderSize;
+  }
+
+  void freeLocal(SmallAllocHeader* header) {
+    auto* block = reinterpret_cast<Block*>(header);
+    block->next = free_lists_[header->size_class];
+    free_lists_[header->size_class] = block;
+    release();
+  }
+
+  void freeRemote(SmallAllocHeader* header) {
+    auto* block = reinterpret_cast<Block*>(header);
+    {
+      std::lock_guard<std::mutex> guard(remote_mutex_);
+      block->next = remote_free_lists_[header->size_class];
+      remote_free_lists_[header->size_class] = block;
+    }
+    release();
+  }
+
+  // Drops one reference; the cache holds one per outstanding block plus one
+  // for the owning thread, and deletes itself when the last one goes away.
+  void release() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+ private:
+  void drainRemoteList(size_t size_class) {
+    Block* remote;
+    {
+      std::lock_guard<std::mutex> guard(remote_mutex_);
+      remote = remote_free_lists_[size_class];
+      remote_free_lists_[size_class] = nullptr;
+    }
+    free_lists_[size_class] = remote;
+  }
+
+  void refill(size_t size_class) {
+    const size_t stride = kSmallAllocHeaderSize + (size_class + 1) * gAlignment;
+    char* slab = static_cast<char*>(alloc_cpu(stride * kSmallAllocBlocksPerSlab));
+    slabs_.push_back(slab);
+    for (size_t i = 0; i < kSmallAllocBlocksPerSlab; ++i) {
+      auto* block = reinterpret_cast<Block*>(slab + i * stride);
+      block->next = free_lists_[size_class];
+      free_lists_[size_class] = block;
+    }
+  }
+
+  Block* free_lists_[kSmallAllocNumClasses];
+  Block* remote_free_lists_[kSmallAllocNumClasses];
+  std::mutex remote_mutex_;
+  std::vector<void*> slabs_;
+  std::atomic<size_t> refs_{1}; // the owning thread's reference
+};
+
+// Wraps the thread-local cache pointer so thread exit drops the thread's
+// reference instead of deleting the cache outright; blocks the thread handed
+// to other threads may still be live.
+struct SmallAllocCacheHolder {
+  SmallAllocCache* cache = nullptr;
+  ~SmallAllocCacheHolder() {
+    if (cache) {
+      cache->release();
+    }
+  }
+};
+
+thread_local SmallAllocCacheHolder small_alloc_cache_holder;
+
+inline size_t smallAllocSizeClass(size_t nbytes) {
+  return (nbytes + gAlignment - 1) / gAlignment - 1;
+}
+
+void* alloc_cpu_cached(size_t nbytes) {
+  if (nbytes == 0) {
+    return nullptr;
+  }
+  if (nbytes <= kSmallAllocMaxSize) {
+    auto& holder = small_alloc_cache_holder;
+    if (holder.cache == nullptr) {
+      holder.cache = new SmallAllocCache();
+    }
+    return holder.cache->allocate(smallAllocSizeClass(nbytes));
+  }
+  // Too big for the cache: go to the regular allocator, but keep the same
+  // self-describing header so free_cpu_cached can free either kind of
+  // pointer (required for raw_deleter, which has to be a single function).
+  char* base = static_cast<char*>(alloc_cpu(nbytes + kSmallAllocHeaderSize));
+  auto* header = reinterpret_cast<SmallAllocHeader*>(base);
+  header->owner = nullptr;
+  return base + kSmallAllocHeaderSize;
+}
+
+void free_cpu_cached(void* data) {
+  if (data == nullptr) {
+    return;
+  }
+  auto* header = reinterpret_cast<SmallAllocHeader*>(
+      static_cast<char*>(data) - kSmallAllocHeaderSize);
+  if (header->owner == nullptr) {
+    free_cpu(header);
+  } else if (header->owner == small_alloc_cache_holder.cache) {
+    header->owner->freeLocal(header);
+  } else {
+    header->owner->freeRemote(header);
+  }
+}
+
+bool use_small_alloc_cache() {
+  // The debug fill/reporting flags and the accounting hook need to see
+  // every allocation, so they win over the cache.
+  return FLAGS_caffe2_cpu_small_alloc_cache &&
+      !FLAGS_caffe2_report_cpu_memory_usage &&
+      !FLAGS_caffe2_cpu_allocator_do_zero_fill &&
+      !FLAGS_caffe2_cpu_allocator_do_junk_fill &&
+      GetCPUMemoryAccountingHook() == nullptr;
+}
+
+} // namespace
+
 // A virtual struct that is used to report C10's memory allocation and
 // deallocation status
 class C10_API MemoryAllocationReporter {
@@ -103,15 +455,40 @@ class C10_API MemoryAllocationReporter {
   void Delete(void* ptr);
 
  private:
+  struct AllocationInfo {
+    size_t nbytes;
+    int numa_node;
+  };
+
   std::mutex mutex_;
-  std::unordered_map<void*, size_t> size_table_;
+  std::unordered_map<void*, AllocationInfo> size_table_;
   size_t allocated_;
+  // per-NUMA-node totals, only tracked when NUMA is enabled
+  std::unordered_map<int, size_t> allocated_per_node_;
 };
 
 struct C10_API DefaultCPUAllocator final : at::Allocator {
   DefaultCPUAllocator() {}
   ~DefaultCPUAllocator() override {}
   at::DataPtr allocate(size_t nbytes) const override {
+    if (auto* hook = GetCPUMemoryAccountingHook()) {
+      // Accounting needs a deleter that reports the free, so it bypasses
+      // the small-alloc cache path (as the reporting flags do).
+      hook->beforeAlloc(nbytes);
+      void* data = nullptr;
+      try {
+        data = alloc_cpu(nbytes);
+      } catch (...) {
+        hook->allocFailed(nbytes);
+        throw;
+      }
+      hook->allocated(data, nbytes);
+      return {data, data, &AccountAndDelete, at::Device(at::DeviceType::CPU)};
+    }
+    if (use_small_alloc_cache()) {
+      void* data = alloc_cpu_cached(nbytes);
+      return {data, data, &free_cpu_cached, at::Device(at::DeviceType::CPU)};
+    }
     void* data = alloc_cpu(nbytes);
     if (FLAGS_caffe2_report_cpu_memory_usage && nbytes > 0) {
       getMemoryAllocationReporter().New(data, nbytes);
@@ -128,7 +505,25 @@ struct C10_API DefaultCPUAllocator final : at::Allocator {
     free_cpu(ptr);
   }
 
+  static void AccountAndDelete(void* ptr) {
+    if (!ptr) {
+      return;
+    }
+    // The hook is never uninstalled, so every pointer handed out with this
+    // deleter can report its free.
+    if (auto* hook = GetCPUMemoryAccountingHook()) {
+      hook->freed(ptr);
+    }
+    free_cpu(ptr);
+  }
+
   at::DeleterFnPtr raw_deleter() const override {
+    if (GetCPUMemoryAccountingHook()) {
+      return &AccountAndDelete;
+    }
+    if (use_small_alloc_cache()) {
+      return &free_cpu_cached;
+    }
     if (FLAGS_caffe2_report_cpu_memory_usage) {
       return &ReportAndDelete;
     }
@@ -164,18 +559,29 @@ REGISTER_ALLOCATOR(DeviceType::CPU, &g_cpu_alloc);
 
 void MemoryAllocationReporter::New(void* ptr, size_t nbytes) {
   std::lock_guard<std::mutex> guard(mutex_);
-  size_table_[ptr] = nbytes;
+  int numa_node = IsNUMAEnabled() ? GetNUMANode(ptr) : -1;
+  size_table_[ptr] = AllocationInfo{nbytes, numa_node};
   allocated_ += nbytes;
-  LOG(INFO) << "C10 alloc " << nbytes << " bytes, total alloc " << allocated_
-            << " bytes.";
+  if (numa_node >= 0) {
+    allocated_per_node_[numa_node] += nbytes;
+    LOG(INFO) << "C10 alloc " << nbytes << " bytes on NUMA node " << numa_node
+              << " (node total " << allocated_per_node_[numa_node]
+              << " bytes), total alloc " << allocated_ << " bytes.";
+  } else {
+    LOG(INFO) << "C10 alloc " << nbytes << " bytes, total alloc " << allocated_
+              << " bytes.";
+  }
 }
 
 void MemoryAllocationReporter::Delete(void* ptr) {
   std::lock_guard<std::mutex> guard(mutex_);
   auto it = size_table_.find(ptr);
   CHECK(it != size_table_.end());
-  allocated_ -= it->second;
-  LOG(INFO) << "C10 deleted " << it->second << " bytes, total alloc "
+  allocated_ -= it->second.nbytes;
+  if (it->second.numa_node >= 0) {
+    allocated_per_node_[it->second.numa_node] -= it->second.nbytes;
+  }
+  LOG(INFO) << "C10 deleted " << it->second.nbytes << " bytes, total alloc "
             << allocated_ << " bytes.";
   size_table_.erase(it);
 }
@@ -11,6 +11,8 @@
 C10_DECLARE_bool(caffe2_report_cpu_memory_usage);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_zero_fill);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_junk_fill);
+C10_DECLARE_bool(caffe2_cpu_hugepages);
+C10_DECLARE_int64(caffe2_cpu_hugepage_min_size);
 
 namespace c10 {
 
@@ -39,4 +41,36 @@ C10_API void SetCPUAllocator(at::Allocator* alloc);
 // Get the Default CPU Allocator
 C10_API at::Allocator* GetDefaultCPUAllocator();
 
+// Hook through which a higher layer can observe (and veto) every allocation
+// made by the default CPU allocator. Installed process-wide, at most once,
+// and never removed; the deleters handed out while it is set report back
+// through it. Used by the request-scoped accounting in
+// ATen/MemoryAccounting.h, which cannot be referenced from here for layering
+// reasons.
+class C10_API CPUMemoryAccountingHook {
+ public:
+  virtual ~CPUMemoryAccountingHook() = default;
+  // Called before the bytes are allocated; reserves them against the active
+  // scope, and may throw to refuse the allocation (hard cap).
+  virtual void beforeAlloc(size_t nbytes) = 0;
+  // Called if the allocation itself failed; releases the reservation.
+  virtual void allocFailed(size_t nbytes) = 0;
+  // Called once the allocation succeeded.
+  virtual void allocated(void* ptr, size_t nbytes) = 0;
+  virtual void freed(void* ptr) = 0;
+};
+
+// Takes ownership of `hook`; it lives for the rest of the process.
+C10_API void SetCPUMemoryAccountingHook(CPUMemoryAccountingHook* hook);
+C10_API CPUMemoryAccountingHook* GetCPUMemoryAccountingHook();
+
+// When enabled, alloc_cpu backs allocations of at least
+// FLAGS_caffe2_cpu_hugepage_min_size bytes with 2MB huge pages (Linux only;
+// a no-op elsewhere). See the note in CPUAllocator.cpp for the allocation
+// strategy. These are programmatic equivalents of the caffe2_cpu_hugepages
+// and caffe2_cpu_hugepage_min_size flags.
+C10_API void SetCPUHugePagesEnabled(bool enabled);
+C10_API bool CPUHugePagesEnabled();
+C10_API void SetCPUHugePageMinSize(size_t nbytes);
+
 } // namespace c10
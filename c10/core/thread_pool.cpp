@@ -1,5 +1,7 @@
 #include <c10/core/thread_pool.h>
 
+#include <c10/util/cpu_topology.h>
+
 namespace c10 {
 
 ThreadPool::ThreadPool(
@@ -14,6 +16,12 @@ ThreadPool::ThreadPool(
       numa_node_id_(numa_node_id) {
   for (std::size_t i = 0; i < threads_.size(); ++i) {
     threads_[i] = std::thread([this, i, init_thread](){
+      // On heterogeneous (big.LITTLE) CPUs workers can be pinned to the
+      // big cores; pools are created lazily, so a SetRestrictToBigCores
+      // call before the first parallel operation covers every worker.
+      if (GetRestrictToBigCores()) {
+        BindToBigCores();
+      }
       if (init_thread) {
         init_thread();
       }
@@ -68,6 +76,18 @@ void ThreadPool::run(const std::function<void()>& func) {
   condition_.notify_one();
 }
 
+void ThreadPool::runLowPriority(const std::function<void()>& func) {
+  if (threads_.size() == 0) {
+    throw std::runtime_error("No threads to run a task");
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // Low-priority tasks are only picked up once the regular queue is empty.
+  low_priority_tasks_.push(task_element_t(func));
+  complete_ = false;
+  condition_.notify_one();
+}
+
 void ThreadPool::waitWorkComplete() {
   std::unique_lock<std::mutex> lock(mutex_);
   while (!complete_) {
@@ -80,7 +100,7 @@ void ThreadPool::main_loop(std::size_t index) {
   while (running_) {
     // Wait on condition variable while the task is empty and
     // the pool is still running.
-    while (tasks_.empty() && running_) {
+    while (tasks_.empty() && low_priority_tasks_.empty() && running_) {
       condition_.wait(lock);
     }
     // If pool is no longer running, break out of loop.
@@ -94,8 +114,10 @@ void ThreadPool::main_loop(std::size_t index) {
     // useful in the event that the function contains
     // shared_ptr arguments bound via bind.
     {
-      auto tasks = tasks_.front();
-      tasks_.pop();
+      // Regular tasks run ahead of any queued low-priority tasks.
+      auto& queue = !tasks_.empty() ? tasks_ : low_priority_tasks_;
+      auto tasks = queue.front();
+      queue.pop();
       // Decrement count, indicating thread is no longer available.
       --available_;
 
@@ -117,7 +139,7 @@ void ThreadPool::main_loop(std::size_t index) {
 
       // Increment count, indicating thread is available.
       ++available_;
-      if (tasks_.empty() && available_ == total_) {
+      if (tasks_.empty() && low_priority_tasks_.empty() && available_ == total_) {
         complete_ = true;
         completed_.notify_one();
       }
@@ -23,6 +23,15 @@ class C10_API TaskThreadPoolBase {
  public:
   virtual void run(const std::function<void()>& func) = 0;
 
+  /**
+   * Run a task at low priority: it is only picked up once no regular
+   * tasks are queued. Pools that do not implement priorities treat this
+   * like run().
+   */
+  virtual void runLowPriority(const std::function<void()>& func) {
+    run(func);
+  }
+
   virtual size_t size() const = 0;
 
   /**
@@ -60,6 +69,7 @@ class C10_API ThreadPool : public c10::TaskThreadPoolBase {
   };
 
   std::queue<task_element_t> tasks_;
+  std::queue<task_element_t> low_priority_tasks_;
   std::vector<std::thread> threads_;
   std::mutex mutex_;
   std::condition_variable condition_;
@@ -88,6 +98,8 @@ class C10_API ThreadPool : public c10::TaskThreadPoolBase {
 
   void run(const std::function<void()>& func) override;
 
+  void runLowPriority(const std::function<void()>& func) override;
+
   template <typename Task>
   void runTaskWithID(Task task) {
     std::unique_lock<std::mutex> lock(mutex_);
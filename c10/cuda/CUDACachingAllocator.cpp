@@ -7,13 +7,18 @@
 
 #include <cuda_runtime_api.h>
 #include <algorithm>
+#include <atomic>
 #include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
 #include <deque>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -51,12 +56,82 @@ namespace CUDACachingAllocator {
 // ensure that the block is not reused before each recorded stream completes
 // work.
 //
+// Setting PYTORCH_CUDA_CROSS_STREAM_REUSE=1 relaxes the per-stream pools:
+// every freed block records an event on its allocation stream (and on any
+// recorded streams) and only re-enters the cache once those events have
+// completed, at which point it may be handed to *any* stream.  This trades
+// slightly delayed reuse for much lower fragmentation in multi-stream
+// processes, where per-stream pools otherwise strand freed memory on idle
+// streams.
+//
+// Setting PYTORCH_CUDA_STREAM_ORDERED_FREE=1 removes the host-side wait for
+// blocks that were used on other streams (recordStream): instead of parking
+// the block until the host observes the recorded events, the events are
+// attached to the block and it re-enters its pool immediately.  The next
+// allocation of the block enqueues cudaStreamWaitEvent on the requesting
+// stream, so ordering is enforced on the device and dead-but-pending buffers
+// no longer count against peak memory.  Ignored when cross-stream reuse is
+// on, since that mode deliberately keys reuse on event completion.
+//
+// Setting PYTORCH_CUDA_TRIM_WATERMARK_MB=<n> starts a background monitor
+// that polls device free memory (once a second by default; configurable via
+// PYTORCH_CUDA_TRIM_INTERVAL_MS) and, when free memory drops below n MiB,
+// first notifies any attached memory-pressure callbacks and then returns
+// cold cached blocks - least recently cached first - to the driver until
+// free memory is back at the watermark. Without it, a process on a shared
+// GPU holds its cache until its *own* cudaMalloc fails, even while a
+// neighbouring process is being OOM-killed for memory this process has not
+// touched in minutes.
+//
+// markIterationBoundary() lets a training loop with stable shapes opt into
+// an iteration-scoped arena: the allocation sequence of one iteration is
+// recorded, packed into a single preplanned segment, and replayed from
+// precomputed offsets in later iterations. See
+// Note [Iteration-scoped memory pool] below.
+//
 
 
 namespace {
 
 using stream_set = std::unordered_set<cuda::CUDAStream>;
 
+bool cross_stream_reuse_enabled() {
+  static bool enabled = []() {
+    const char* value = std::getenv("PYTORCH_CUDA_CROSS_STREAM_REUSE");
+    return value && std::atoi(value) != 0;
+  }();
+  return enabled;
+}
+
+bool stream_ordered_free_enabled() {
+  static bool enabled = []() {
+    const char* value = std::getenv("PYTORCH_CUDA_STREAM_ORDERED_FREE");
+    return value && std::atoi(value) != 0;
+  }();
+  // Cross-stream reuse relies on freed blocks staying out of the cache until
+  // their events complete, so it takes precedence.
+  return enabled && !cross_stream_reuse_enabled();
+}
+
+// Free-memory watermark (bytes) below which the background monitor trims the
+// cache; 0 (the default) disables the monitor entirely.
+int64_t trim_watermark_bytes() {
+  static int64_t bytes = []() -> int64_t {
+    const char* value = std::getenv("PYTORCH_CUDA_TRIM_WATERMARK_MB");
+    return value ? std::atoll(value) * 1048576 : 0;
+  }();
+  return bytes;
+}
+
+int64_t trim_interval_ms() {
+  static int64_t interval = []() -> int64_t {
+    const char* value = std::getenv("PYTORCH_CUDA_TRIM_INTERVAL_MS");
+    const int64_t parsed = value ? std::atoll(value) : 0;
+    return parsed > 0 ? parsed : 1000;
+  }();
+  return interval;
+}
+
 constexpr size_t kMinBlockSize = 512;       // all sizes are rounded to at least 512 bytes
 constexpr size_t kSmallSize = 1048576;      // largest "small" allocation is 1 MiB
 constexpr size_t kSmallBuffer = 2097152;    // "small" allocations are packed in 2 MiB blocks
@@ -112,15 +187,23 @@ struct Block {
   Block*        prev;        // prev block if split from a larger allocation
   Block*        next;        // next block if split from a larger allocation
   int           event_count; // number of outstanding CUDA events
+  uint64_t      cache_tick;  // when the block last entered its pool (for LRU trimming)
+
+  // Events the next user of this block must order itself after with
+  // cudaStreamWaitEvent. Only populated in stream-ordered free mode; the
+  // block sits in its pool while these are still pending on the device.
+  std::vector<cudaEvent_t> pending_events;
 
   Block(int device, cudaStream_t stream, size_t size, BlockPool* pool, void* ptr) :
     device(device), stream(stream), stream_uses(), size(size), pool(pool),
-    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0),
+    cache_tick(0) { }
 
   // constructor for search key
   Block(int device, cudaStream_t stream, size_t size) :
     device(device), stream(stream), stream_uses(), size(size), pool(nullptr),
-    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0),
+    cache_tick(0) { }
 
   bool is_split() const {
     return (prev != nullptr) || (next != nullptr);
@@ -162,6 +245,52 @@ static std::string format_size(uint64_t size) {
 
 } // namespace
 
+// Installed trace handler; loaded with an acquire on every potential event
+// so installation is race-free without adding a lock to the fast path.
+static std::atomic<TraceEventHandler> trace_event_handler{nullptr};
+
+static void emit_trace_event(
+    TraceEventType type,
+    int device,
+    size_t size,
+    void* ptr,
+    cudaStream_t stream) {
+  TraceEventHandler handler =
+      trace_event_handler.load(std::memory_order_acquire);
+  if (C10_UNLIKELY(handler != nullptr)) {
+    TraceEvent event;
+    event.type = type;
+    event.device = device;
+    event.size = size;
+    event.addr = reinterpret_cast<int64_t>(ptr);
+    event.stream = reinterpret_cast<int64_t>(stream);
+    handler(event);
+  }
+}
+
+// Attached pressure callbacks. They run on the watermark monitor thread
+// with no allocator lock held, so they may allocate or free CUDA memory.
+static std::mutex pressure_callback_mutex;
+
+static std::vector<MemoryPressureCallback>& pressure_callbacks() {
+  static std::vector<MemoryPressureCallback> callbacks;
+  return callbacks;
+}
+
+static void notify_memory_pressure(
+    int device,
+    size_t device_free,
+    size_t device_total) {
+  std::vector<MemoryPressureCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(pressure_callback_mutex);
+    callbacks = pressure_callbacks();
+  }
+  for (const auto& callback : callbacks) {
+    callback(device, device_free, device_total);
+  }
+}
+
 class THCCachingAllocator {
 
  private:
@@ -187,12 +316,96 @@ class THCCachingAllocator {
   // outstanding cuda events
   std::deque<std::pair<cudaEvent_t, Block*>> cuda_events;
 
+  // deferred-free events already waited on by a new owner; destroyed once
+  // the device has passed them (stream-ordered free mode only)
+  std::deque<cudaEvent_t> retired_events;
+
+  // monotonic clock stamped onto blocks as they enter a pool, so the
+  // watermark monitor can trim the coldest cache first
+  uint64_t cache_clock = 0;
+
+  // free-memory watermark monitor; started lazily by the first malloc when
+  // PYTORCH_CUDA_TRIM_WATERMARK_MB is set (see Note at the top of this file)
+  std::thread watermark_monitor;
+  std::mutex monitor_mutex;
+  std::condition_variable monitor_cv;
+  bool monitor_started = false;
+  bool monitor_shutdown = false;
+
+  // Note [Iteration-scoped memory pool]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Training loops with stable shapes allocate and free the same sequence
+  // of sizes every iteration. markIterationBoundary() exploits that: the
+  // first call starts recording the allocation sequence, the second packs
+  // the recorded lifetimes into a single arena with a first-fit replay and
+  // cudaMallocs it, and every later iteration is served straight from
+  // precomputed arena offsets - no pool search, no splitting, no
+  // per-allocation bookkeeping.
+  //
+  // Only allocations on the device and stream of the first recorded
+  // allocation participate; everything else stays on the regular cache.
+  // Reuse of an arena offset within an iteration is ordered by that stream
+  // alone, so a recordStream() call on arena memory from any other stream
+  // permanently retires the pool (after one device synchronization at the
+  // next boundary). Recorded allocations that were still live at the
+  // planning boundary (parameters, the loss carried into the next
+  // iteration) are marked unpooled and keep going through the regular
+  // cache. If an iteration deviates from the recorded sequence - a
+  // different size, or more allocations than were recorded - the rest of
+  // that iteration falls back to the regular cache and the replay restarts
+  // at the next boundary once every arena block has been freed.
+
+  enum class IterationPhase { Inactive, Recording, Serving, Retired };
+
+  struct IterationEvent {
+    bool alloc;   // true for a malloc, false for a free
+    size_t size;  // rounded size (allocs only)
+    size_t index; // for frees, the position of the matching alloc event
+  };
+
+  // One recorded allocation: its arena offset, or the regular cache if the
+  // recorded lifetime extended past the iteration boundary.
+  struct PlannedAlloc {
+    size_t size;
+    size_t offset;
+    bool pooled;
+  };
+
+  IterationPhase iteration_phase = IterationPhase::Inactive;
+  std::vector<IterationEvent> iteration_events;
+
+  // live recorded pointers -> position of their alloc event
+  std::unordered_map<void*, size_t> iteration_recorded;
+  int iteration_device = -1;
+  cudaStream_t iteration_stream = nullptr;
+
+  char* arena_ptr = nullptr;
+  size_t arena_size = 0;
+  std::vector<PlannedAlloc> arena_plan;
+  size_t arena_cursor = 0;
+  bool arena_diverged = false;
+  bool arena_foreign_stream = false;
+
+  // live arena pointers -> rounded size
+  std::unordered_map<void*, size_t> arena_live;
+
  public:
 
   THCCachingAllocator() :
       large_blocks(BlockComparator),
       small_blocks(BlockComparator) {}
 
+  ~THCCachingAllocator() {
+    if (monitor_started) {
+      {
+        std::lock_guard<std::mutex> lock(monitor_mutex);
+        monitor_shutdown = true;
+      }
+      monitor_cv.notify_all();
+      watermark_monitor.join();
+    }
+  }
+
   std::mutex* getCudaFreeMutex() const {
     return &cuda_free_mutex;
   }
@@ -205,6 +418,10 @@ class THCCachingAllocator {
   {
     std::lock_guard<std::recursive_mutex> lock(mutex);
 
+    if (C10_UNLIKELY(!monitor_started && trim_watermark_bytes() > 0)) {
+      start_watermark_monitor();
+    }
+
     int device;
     C10_CUDA_CHECK(cudaGetDevice(&device));
 
@@ -213,7 +430,29 @@ class THCCachingAllocator {
 
     size = round_size(size);
 
-    Block search_key(device, stream, size);
+    if (C10_UNLIKELY(iteration_phase == IterationPhase::Serving)) {
+      void* served = serve_from_arena(size, device, stream);
+      if (served != nullptr) {
+        *devPtr = served;
+        DeviceStats& arena_stats = get_stats_for_device(device);
+        StatTypes arena_stat_types;
+        arena_stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
+        arena_stat_types[static_cast<size_t>(
+            size <= kSmallSize ? StatType::SMALL_POOL
+                               : StatType::LARGE_POOL)] = true;
+        update_stat_array(arena_stats.allocation, 1, arena_stat_types);
+        update_stat_array(arena_stats.allocated_bytes, size, arena_stat_types);
+        update_stat_array(arena_stats.active, 1, arena_stat_types);
+        update_stat_array(arena_stats.active_bytes, size, arena_stat_types);
+        emit_trace_event(TraceEventType::ALLOC, device, size, served, stream);
+        return;
+      }
+    }
+
+    // In cross-stream reuse mode all cached blocks are keyed to the null
+    // stream (see free_block) and may serve any requesting stream.
+    Block search_key(
+        device, cross_stream_reuse_enabled() ? nullptr : stream, size);
     auto& pool = get_pool(size);
 
     DeviceStats& stats = get_stats_for_device(device);
@@ -224,7 +463,7 @@ class THCCachingAllocator {
     auto find_free_block = [&]()->Block*{
       auto it = pool.lower_bound(&search_key);
       if (it != pool.end() && (*it)->device == device &&
-          (*it)->stream == stream) {
+          (*it)->stream == search_key.stream) {
         Block* block = *it;
         pool.erase(it);
         return block;
@@ -252,6 +491,8 @@ class THCCachingAllocator {
         block = new Block(device, stream, alloc_size, &pool, ptr);
         update_stat_array(stats.segment, 1, stat_types);
         update_stat_array(stats.reserved_bytes, alloc_size, stat_types);
+        emit_trace_event(
+            TraceEventType::SEGMENT_ALLOC, device, alloc_size, ptr, stream);
       } else if (err == cudaErrorMemoryAllocation) {
         cudaGetLastError();  // clear CUDA error
 
@@ -260,6 +501,8 @@ class THCCachingAllocator {
         C10_CUDA_CHECK(cudaMemGetInfo(&device_free, &device_total));
 
         stats.num_ooms += 1;
+        emit_trace_event(
+            TraceEventType::OOM, device, alloc_size, nullptr, stream);
 
         // "total capacity": total global memory on GPU
         // "already allocated": memory allocated by the program using the
@@ -294,6 +537,21 @@ class THCCachingAllocator {
 
     Block* remaining = nullptr;
     AT_ASSERT(block);
+    // Adopt the requesting stream; for a pool hit in cross-stream reuse mode
+    // the block's event barrier has already passed, so this is safe.
+    block->stream = stream;
+
+    if (!block->pending_events.empty()) {
+      // Stream-ordered reuse: order the new owner after every stream that
+      // used this memory before it was freed. The wait is enqueued on the
+      // device, so the host never blocks; the events are retired lazily by
+      // process_events once they complete.
+      for (cudaEvent_t event : block->pending_events) {
+        C10_CUDA_CHECK(cudaStreamWaitEvent(stream, event, 0));
+        retired_events.push_back(event);
+      }
+      block->pending_events.clear();
+    }
 
     const bool already_split = block->is_split();
     if (should_split(block, size)) {
@@ -309,6 +567,11 @@ class THCCachingAllocator {
       remaining->prev = block;
       remaining->ptr = static_cast<char*>(remaining->ptr) + size;
       remaining->size -= size;
+      if (cross_stream_reuse_enabled()) {
+        // Keep the pool invariant: cached blocks are keyed to the null
+        // stream.  The remainder is idle memory, usable by any stream.
+        remaining->stream = nullptr;
+      }
       pool.insert(remaining);
 
       if (already_split) {
@@ -331,10 +594,19 @@ class THCCachingAllocator {
 
     *devPtr = block->ptr;
 
+    if (C10_UNLIKELY(iteration_phase == IterationPhase::Recording)) {
+      // Record the rounded request, not block->size: an unsplit cache hit
+      // may be larger than the request, but the replay must match what the
+      // client will ask for again.
+      record_iteration_alloc(block->ptr, size, device, stream);
+    }
+
     update_stat_array(stats.allocation, 1, stat_types);
     update_stat_array(stats.allocated_bytes, block->size, stat_types);
     update_stat_array(stats.active, 1, stat_types);
     update_stat_array(stats.active_bytes, block->size, stat_types);
+    emit_trace_event(
+        TraceEventType::ALLOC, device, block->size, block->ptr, stream);
   }
 
   void free(void* ptr)
@@ -344,6 +616,14 @@ class THCCachingAllocator {
       return;
     }
 
+    if (C10_UNLIKELY(in_arena(ptr))) {
+      free_arena_block(ptr);
+      return;
+    }
+    if (C10_UNLIKELY(iteration_phase == IterationPhase::Recording)) {
+      record_iteration_free(ptr);
+    }
+
     auto it = allocated_blocks.find(ptr);
     if (it == allocated_blocks.end()) {
       AT_ERROR("invalid device pointer: ", ptr);
@@ -359,9 +639,30 @@ class THCCachingAllocator {
     stat_types[static_cast<size_t>(get_stat_type_for_pool(*(block->pool)))] = true;
     update_stat_array(stats.allocation, -1, {stat_types});
     update_stat_array(stats.allocated_bytes, -block->size, {stat_types});
-
-    if (!block->stream_uses.empty()) {
-      insert_events(block);
+    emit_trace_event(
+        TraceEventType::FREE,
+        block->device,
+        block->size,
+        block->ptr,
+        block->stream);
+
+    if (cross_stream_reuse_enabled()) {
+      // The block becomes visible to every stream once its events clear, so
+      // an event on the allocation stream is needed even without recorded
+      // cross-stream uses.
+      insert_reuse_event(block);
+      if (!block->stream_uses.empty()) {
+        insert_events(block);
+      }
+    } else if (!block->stream_uses.empty()) {
+      if (stream_ordered_free_enabled()) {
+        // The block re-enters its pool right away; the recorded events are
+        // carried along and waited on (device side) by the next user.
+        attach_deferred_events(block);
+        free_block(block);
+      } else {
+        insert_events(block);
+      }
     } else {
       free_block(block);
     }
@@ -369,6 +670,12 @@ class THCCachingAllocator {
 
   void* getBaseAllocation(void* ptr, size_t* outSize) {
     std::lock_guard<std::recursive_mutex> lock(mutex);
+    if (C10_UNLIKELY(in_arena(ptr))) {
+      if (outSize) {
+        *outSize = arena_size;
+      }
+      return arena_ptr;
+    }
     Block* block = find_allocated_block(ptr);
     if (!block) {
       AT_ERROR("invalid device pointer: ", ptr);
@@ -396,6 +703,14 @@ class THCCachingAllocator {
     }
 
     std::lock_guard<std::recursive_mutex> lock(mutex);
+    if (C10_UNLIKELY(in_arena(ptr))) {
+      if (stream.stream() != iteration_stream) {
+        // Offset reuse in the arena is ordered only by the recorded stream;
+        // see Note [Iteration-scoped memory pool].
+        arena_foreign_stream = true;
+      }
+      return;
+    }
     Block* block = find_allocated_block(ptr);
     // block could be nullptr in some cases, e.g., tensor loaded from blob, or
     // shared from another process, or not pointing to a CUDA tensor.
@@ -515,6 +830,87 @@ class THCCachingAllocator {
     return result;
   }
 
+  /** Collects the free-block histogram and per-stream cached bytes for a
+   *  device. Walks the pools under the lock; never calls into CUDA. **/
+  CacheDetail getCacheDetail(int dev_id) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    CacheDetail detail;
+    std::map<int64_t, int64_t> per_stream;
+    cache_detail_aux(large_blocks, dev_id, detail, per_stream);
+    cache_detail_aux(small_blocks, dev_id, detail, per_stream);
+    detail.cached_bytes_per_stream.assign(
+        per_stream.begin(), per_stream.end());
+    return detail;
+  }
+
+  /** Returns up to `bytes_needed` bytes of unsplit cached blocks on the
+   *  device to the driver, least recently cached first. **/
+  size_t trimCachedBlocks(int device, size_t bytes_needed) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    std::vector<Block*> candidates;
+    collect_trim_candidates(large_blocks, device, candidates);
+    collect_trim_candidates(small_blocks, device, candidates);
+    std::sort(
+        candidates.begin(),
+        candidates.end(),
+        [](const Block* a, const Block* b) {
+          return a->cache_tick < b->cache_tick;
+        });
+
+    size_t released = 0;
+    for (Block* block : candidates) {
+      if (released >= bytes_needed) {
+        break;
+      }
+      released += block->size;
+      block->pool->erase(block);
+      release_block(block);
+    }
+    return released;
+  }
+
+  /** Advances the iteration pool state machine; see
+   *  Note [Iteration-scoped memory pool] **/
+  void iterationBoundary() {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    switch (iteration_phase) {
+      case IterationPhase::Inactive:
+        iteration_events.clear();
+        iteration_recorded.clear();
+        iteration_phase = IterationPhase::Recording;
+        break;
+      case IterationPhase::Recording:
+        plan_iteration_arena();
+        break;
+      case IterationPhase::Serving:
+        if (arena_foreign_stream) {
+          // Arena memory was used on a stream other than the recorded one,
+          // so stream order no longer serializes offset reuse. Drain the
+          // device once and stop serving for good.
+          {
+            cuda::CUDAGuard device_guard(iteration_device);
+            C10_CUDA_CHECK(cudaDeviceSynchronize());
+          }
+          iteration_phase = IterationPhase::Retired;
+          if (arena_live.empty()) {
+            release_arena();
+          }
+        } else if (arena_live.empty()) {
+          // Restart the replay. If arena blocks are still live the planned
+          // offsets could alias them, so in that case stay on the regular
+          // cache this iteration and check again at the next boundary.
+          arena_cursor = 0;
+          arena_diverged = false;
+        } else {
+          arena_diverged = true;
+        }
+        break;
+      case IterationPhase::Retired:
+        break;
+    }
+  }
+
  private:
 
   // All private methods do not acquire the allocator mutex.
@@ -542,6 +938,13 @@ class THCCachingAllocator {
   {
     AT_ASSERT(!block->allocated && block->event_count == 0);
 
+    if (cross_stream_reuse_enabled()) {
+      // Cached blocks are stream-agnostic: the events inserted on free have
+      // all completed by now, so key the block to the null stream and let
+      // malloc hand it to whichever stream asks first.
+      block->stream = nullptr;
+    }
+
     size_t original_block_size = block->size;
 
     auto& pool = *block->pool;
@@ -557,6 +960,7 @@ class THCCachingAllocator {
       }
     }
 
+    block->cache_tick = ++cache_clock;
     pool.insert(block);
 
     if (block->is_split()) {
@@ -598,6 +1002,11 @@ class THCCachingAllocator {
 
     const size_t subsumed_size = src->size;
     dst->size += subsumed_size;
+    // The merged range inherits the ordering constraints of both halves.
+    dst->pending_events.insert(
+        dst->pending_events.end(),
+        src->pending_events.begin(),
+        src->pending_events.end());
     pool.erase(src);
     delete src;
 
@@ -660,6 +1069,8 @@ class THCCachingAllocator {
     if (err != cudaSuccess) {
       DeviceStats& stats = get_stats_for_device(device);
       stats.num_alloc_retries += 1;
+      emit_trace_event(
+          TraceEventType::ALLOC_RETRY, device, size, nullptr, nullptr);
       cudaGetLastError();  // reset the last CUDA error
       free_cached_blocks(device);
       err = cudaMalloc(devPtr, size);
@@ -697,25 +1108,282 @@ class THCCachingAllocator {
     while (it != end) {
       Block* block = *it;
       if (!block->prev && !block->next) {
-        C10_CUDA_CHECK(cudaFree((void*)block->ptr));
-
-        DeviceStats& stats = get_stats_for_device(block->device);
-        StatTypes stat_types;
-        stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
-        stat_types[static_cast<size_t>(get_stat_type_for_pool(*(block->pool)))] = true;
-        update_stat_array(stats.segment, -1, stat_types);
-        update_stat_array(stats.reserved_bytes, -block->size, stat_types);
-
         auto cur = it;
         ++it;
         blocks.erase(cur);
-        delete block;
+        release_block(block);
       } else {
         ++it;
       }
     }
   }
 
+  /** returns one unsplit cached block to the driver; the caller has already
+   *  removed it from its pool */
+  void release_block(Block* block)
+  {
+    // A deferred-free block may still have device-side readers; wait for
+    // them before the memory goes back to the driver.
+    for (cudaEvent_t event : block->pending_events) {
+      C10_CUDA_CHECK(cudaEventSynchronize(event));
+      C10_CUDA_CHECK(cudaEventDestroy(event));
+    }
+    block->pending_events.clear();
+    C10_CUDA_CHECK(cudaFree((void*)block->ptr));
+    emit_trace_event(
+        TraceEventType::SEGMENT_FREE,
+        block->device,
+        block->size,
+        block->ptr,
+        block->stream);
+
+    DeviceStats& stats = get_stats_for_device(block->device);
+    StatTypes stat_types;
+    stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
+    stat_types[static_cast<size_t>(get_stat_type_for_pool(*(block->pool)))] = true;
+    update_stat_array(stats.segment, -1, stat_types);
+    update_stat_array(stats.reserved_bytes, -block->size, stat_types);
+
+    delete block;
+  }
+
+  bool in_arena(void* ptr) const {
+    return arena_ptr != nullptr && static_cast<char*>(ptr) >= arena_ptr &&
+        static_cast<char*>(ptr) < arena_ptr + arena_size;
+  }
+
+  void record_iteration_alloc(
+      void* ptr,
+      size_t size,
+      int device,
+      cudaStream_t stream) {
+    if (iteration_device < 0) {
+      iteration_device = device;
+      iteration_stream = stream;
+    }
+    if (device != iteration_device || stream != iteration_stream) {
+      // Allocations on other devices and streams stay on the regular cache;
+      // only the recorded stream participates in the replay.
+      return;
+    }
+    iteration_recorded[ptr] = iteration_events.size();
+    iteration_events.push_back({true, size, 0});
+  }
+
+  void record_iteration_free(void* ptr) {
+    auto it = iteration_recorded.find(ptr);
+    if (it == iteration_recorded.end()) {
+      // Allocated before the recording started, or on another stream.
+      return;
+    }
+    iteration_events.push_back({false, 0, it->second});
+    iteration_recorded.erase(it);
+  }
+
+  /** Packs the recorded lifetimes into one arena with an address-ordered
+   *  first-fit replay and allocates it. Gives up (phase Retired) if nothing
+   *  iteration-scoped was recorded or the arena allocation fails; the
+   *  regular cache keeps working either way. **/
+  void plan_iteration_arena() {
+    // Allocations still live at the boundary are not iteration-scoped.
+    std::vector<bool> pooled(iteration_events.size(), false);
+    for (const IterationEvent& event : iteration_events) {
+      if (!event.alloc) {
+        pooled[event.index] = true;
+      }
+    }
+
+    // Replay the sequence against an address-ordered free list; the high
+    // watermark of the replay is the arena size.
+    std::map<size_t, size_t> free_list; // offset -> length, coalesced
+    std::unordered_map<size_t, size_t> planned_offsets; // event idx -> offset
+    size_t top = 0;
+    arena_plan.clear();
+    for (size_t i = 0; i < iteration_events.size(); ++i) {
+      const IterationEvent& event = iteration_events[i];
+      if (event.alloc) {
+        if (!pooled[i]) {
+          arena_plan.push_back({event.size, 0, false});
+          continue;
+        }
+        size_t offset = top;
+        bool found = false;
+        for (auto it = free_list.begin(); it != free_list.end(); ++it) {
+          if (it->second >= event.size) {
+            offset = it->first;
+            const size_t leftover = it->second - event.size;
+            free_list.erase(it);
+            if (leftover > 0) {
+              free_list.emplace(offset + event.size, leftover);
+            }
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          top += event.size;
+        }
+        planned_offsets.emplace(i, offset);
+        arena_plan.push_back({event.size, offset, true});
+      } else {
+        // Return the interval and coalesce with its neighbours.
+        size_t offset = planned_offsets.at(event.index);
+        size_t length = iteration_events[event.index].size;
+        auto next = free_list.lower_bound(offset);
+        if (next != free_list.begin()) {
+          auto prev = std::prev(next);
+          if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            length += prev->second;
+            free_list.erase(prev);
+          }
+        }
+        if (next != free_list.end() && offset + length == next->first) {
+          length += next->second;
+          free_list.erase(next);
+        }
+        free_list.emplace(offset, length);
+      }
+    }
+    iteration_events.clear();
+    iteration_recorded.clear();
+
+    if (top == 0) {
+      // Nothing iteration-scoped was recorded; replaying buys nothing.
+      arena_plan.clear();
+      iteration_phase = IterationPhase::Retired;
+      return;
+    }
+
+    void* ptr = nullptr;
+    cudaError_t err;
+    {
+      cuda::CUDAGuard device_guard(iteration_device);
+      err = cuda_malloc_with_retry(iteration_device, &ptr, top);
+    }
+    if (err != cudaSuccess) {
+      // Not worth failing the boundary call over: the regular cache still
+      // works, so just give up on the arena.
+      cudaGetLastError();
+      arena_plan.clear();
+      iteration_phase = IterationPhase::Retired;
+      return;
+    }
+
+    arena_ptr = static_cast<char*>(ptr);
+    arena_size = top;
+    arena_cursor = 0;
+    arena_diverged = false;
+    arena_foreign_stream = false;
+    arena_live.clear();
+    iteration_phase = IterationPhase::Serving;
+
+    DeviceStats& stats = get_stats_for_device(iteration_device);
+    StatTypes stat_types;
+    stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
+    stat_types[static_cast<size_t>(StatType::LARGE_POOL)] = true;
+    update_stat_array(stats.segment, 1, stat_types);
+    update_stat_array(stats.reserved_bytes, arena_size, stat_types);
+    emit_trace_event(
+        TraceEventType::SEGMENT_ALLOC,
+        iteration_device,
+        arena_size,
+        arena_ptr,
+        iteration_stream);
+  }
+
+  /** Serves the next allocation of the replayed sequence from the arena.
+   *  Returns nullptr if the allocation should go to the regular cache. **/
+  void* serve_from_arena(size_t size, int device, cudaStream_t stream) {
+    if (device != iteration_device || stream != iteration_stream ||
+        arena_diverged) {
+      return nullptr;
+    }
+    if (arena_cursor >= arena_plan.size() ||
+        arena_plan[arena_cursor].size != size) {
+      // The iteration no longer matches the recorded sequence; stop
+      // replaying until the next boundary.
+      arena_diverged = true;
+      return nullptr;
+    }
+    const PlannedAlloc& planned = arena_plan[arena_cursor];
+    ++arena_cursor;
+    if (!planned.pooled) {
+      return nullptr;
+    }
+    void* ptr = arena_ptr + planned.offset;
+    arena_live.emplace(ptr, size);
+    return ptr;
+  }
+
+  void free_arena_block(void* ptr) {
+    auto it = arena_live.find(ptr);
+    if (it == arena_live.end()) {
+      AT_ERROR("invalid device pointer: ", ptr);
+    }
+    const size_t size = it->second;
+    arena_live.erase(it);
+
+    DeviceStats& stats = get_stats_for_device(iteration_device);
+    StatTypes stat_types;
+    stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
+    stat_types[static_cast<size_t>(
+        size <= kSmallSize ? StatType::SMALL_POOL
+                           : StatType::LARGE_POOL)] = true;
+    update_stat_array(stats.allocation, -1, stat_types);
+    update_stat_array(stats.allocated_bytes, -size, stat_types);
+    update_stat_array(stats.active, -1, stat_types);
+    update_stat_array(stats.active_bytes, -size, stat_types);
+    emit_trace_event(
+        TraceEventType::FREE, iteration_device, size, ptr, iteration_stream);
+
+    if (iteration_phase == IterationPhase::Retired && arena_live.empty()) {
+      release_arena();
+    }
+  }
+
+  /** Returns the arena segment to the driver; called once the pool is
+   *  retired and every arena block has been freed. **/
+  void release_arena() {
+    C10_CUDA_CHECK(cudaFree(arena_ptr));
+    emit_trace_event(
+        TraceEventType::SEGMENT_FREE,
+        iteration_device,
+        arena_size,
+        arena_ptr,
+        iteration_stream);
+    DeviceStats& stats = get_stats_for_device(iteration_device);
+    StatTypes stat_types;
+    stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
+    stat_types[static_cast<size_t>(StatType::LARGE_POOL)] = true;
+    update_stat_array(stats.segment, -1, stat_types);
+    update_stat_array(stats.reserved_bytes, -arena_size, stat_types);
+    arena_ptr = nullptr;
+    arena_size = 0;
+    arena_plan.clear();
+  }
+
+  // Unsplit cached blocks on the device that can go straight back to the
+  // driver. Split blocks stay: their siblings may still be in use. Blocks
+  // with outstanding events only occur in cross-stream reuse mode, where
+  // they sit outside the pools anyway.
+  void collect_trim_candidates(
+      BlockPool& blocks,
+      int device,
+      std::vector<Block*>& candidates)
+  {
+    Block lower_key(device, nullptr, 0);
+    Block upper_key(device + 1, nullptr, 0);
+    auto it = blocks.lower_bound(&lower_key);
+    const auto end = blocks.lower_bound(&upper_key);
+    for (; it != end; ++it) {
+      Block* block = *it;
+      if (!block->prev && !block->next && block->event_count == 0) {
+        candidates.push_back(block);
+      }
+    }
+  }
+
   void synchronize_and_free_events(optional<int> device) {
     // Synchronize on outstanding events and then free associated blocks.
     // Limited to blocks on the given device if specified.
@@ -740,6 +1408,14 @@ class THCCachingAllocator {
     }
 
     std::swap(cuda_events, remaining_events);
+
+    // Retired deferred-free events carry no block, so the device filter does
+    // not apply; syncing them all is harmless and keeps this path simple.
+    for (cudaEvent_t event : retired_events) {
+      C10_CUDA_CHECK(cudaEventSynchronize(event));
+      C10_CUDA_CHECK(cudaEventDestroy(event));
+    }
+    retired_events.clear();
   }
 
   Block* find_allocated_block(void *ptr) {
@@ -750,6 +1426,49 @@ class THCCachingAllocator {
     return it->second;
   }
 
+  // Records an event on the block's allocation stream so the block can be
+  // reused from any stream once the event completes.  Only used in
+  // cross-stream reuse mode; see Note at the top of this file.
+  void insert_reuse_event(Block* block)
+  {
+    int prev_device;
+    C10_CUDA_CHECK(cudaGetDevice(&prev_device));
+    C10_CUDA_CHECK(cudaSetDevice(block->device));
+
+    cudaEvent_t event;
+    C10_CUDA_CHECK(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    C10_CUDA_CHECK(cudaEventRecord(event, block->stream));
+
+    block->event_count++;
+    cuda_events.emplace_back(event, block);
+
+    C10_CUDA_CHECK(cudaSetDevice(prev_device));
+  }
+
+  // Stream-ordered free: records one event per recorded using stream and
+  // attaches them to the block instead of parking the block in cuda_events.
+  // The block may be reallocated at once; malloc makes the new owner wait on
+  // these events before the memory is handed out.
+  void attach_deferred_events(Block* block)
+  {
+    int prev_device;
+    C10_CUDA_CHECK(cudaGetDevice(&prev_device));
+
+    stream_set streams(std::move(block->stream_uses));
+    AT_ASSERT(block->stream_uses.empty());
+    for (auto it = streams.begin(); it != streams.end(); ++it) {
+      C10_CUDA_CHECK(cudaSetDevice(it->device_index()));
+
+      cudaEvent_t event;
+      C10_CUDA_CHECK(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+      C10_CUDA_CHECK(cudaEventRecord(event, it->stream()));
+
+      block->pending_events.push_back(event);
+    }
+
+    C10_CUDA_CHECK(cudaSetDevice(prev_device));
+  }
+
   void insert_events(Block* block)
   {
     int prev_device;
@@ -800,6 +1519,74 @@ class THCCachingAllocator {
       }
       cuda_events.pop_front();
     }
+
+    // Destroy retired deferred-free events the device has passed.
+    while (!retired_events.empty()) {
+      cudaEvent_t event = retired_events.front();
+      cudaError_t err = cudaEventQuery(event);
+      if (err == cudaErrorNotReady) {
+        cudaGetLastError();
+        break;
+      } else if (err != cudaSuccess) {
+        C10_CUDA_CHECK(err);
+      }
+      C10_CUDA_CHECK(cudaEventDestroy(event));
+      retired_events.pop_front();
+    }
+  }
+
+  // Called from malloc with the allocator mutex held, at most once.
+  void start_watermark_monitor()
+  {
+    monitor_started = true;
+    watermark_monitor = std::thread([this] { watermark_monitor_loop(); });
+  }
+
+  // Runs on its own thread and holds no allocator lock between polls, so
+  // calling the public trimCachedBlocks from here is fine.
+  void watermark_monitor_loop()
+  {
+    const size_t watermark = static_cast<size_t>(trim_watermark_bytes());
+    const auto interval = std::chrono::milliseconds(trim_interval_ms());
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(monitor_mutex);
+        if (monitor_cv.wait_for(
+                lock, interval, [this] { return monitor_shutdown; })) {
+          return;
+        }
+      }
+
+      int device_count = 0;
+      int prev_device = 0;
+      // Errors here (e.g. during process teardown) just skip the poll; the
+      // monitor must never take the process down.
+      if (cudaGetDeviceCount(&device_count) != cudaSuccess ||
+          cudaGetDevice(&prev_device) != cudaSuccess) {
+        cudaGetLastError();
+        continue;
+      }
+      for (int device = 0; device < device_count; ++device) {
+        size_t device_free = 0;
+        size_t device_total = 0;
+        if (cudaSetDevice(device) != cudaSuccess ||
+            cudaMemGetInfo(&device_free, &device_total) != cudaSuccess) {
+          cudaGetLastError();
+          continue;
+        }
+        if (device_free >= watermark) {
+          continue;
+        }
+        // Give cooperating code the chance to drop its own references
+        // first, then return cold cached blocks until free memory is back
+        // at the watermark (or the cache runs out of unsplit blocks).
+        notify_memory_pressure(device, device_free, device_total);
+        trimCachedBlocks(device, watermark - device_free);
+      }
+      if (cudaSetDevice(prev_device) != cudaSuccess) {
+        cudaGetLastError();
+      }
+    }
   }
 
   // Accumulates sizes of all memory blocks for given device in given pool
@@ -815,6 +1602,31 @@ class THCCachingAllocator {
       }
     }
   }
+
+  static void cache_detail_aux(
+      const BlockPool& blocks,
+      int dev_id,
+      CacheDetail& detail,
+      std::map<int64_t, int64_t>& per_stream) {
+    Block search_key(dev_id, 0, 0);
+    auto it = blocks.lower_bound(&search_key);
+    for (; it != blocks.end() && (*it)->device == dev_id; ++it) {
+      const Block* block = *it;
+      const int64_t blocksize = block->size;
+      size_t bucket = 0;
+      while (bucket + 1 < kCacheDetailBuckets &&
+             (int64_t(1) << (bucket + 1)) <= blocksize) {
+        ++bucket;
+      }
+      detail.free_block_counts[bucket] += 1;
+      detail.free_block_bytes[bucket] += blocksize;
+      detail.total_cached_bytes += blocksize;
+      if (blocksize > detail.largest_free_block) {
+        detail.largest_free_block = blocksize;
+      }
+      per_stream[reinterpret_cast<int64_t>(block->stream)] += blocksize;
+    }
+  }
 };
 
 THCCachingAllocator caching_allocator;
@@ -895,6 +1707,29 @@ std::vector<SegmentInfo> snapshot() {
   return caching_allocator.snapshot();
 }
 
+CacheDetail getCacheDetail(int device) {
+  assertValidDevice(device);
+  return caching_allocator.getCacheDetail(device);
+}
+
+void setTraceEventHandler(TraceEventHandler handler) {
+  trace_event_handler.store(handler, std::memory_order_release);
+}
+
+void attachMemoryPressureCallback(MemoryPressureCallback callback) {
+  std::lock_guard<std::mutex> lock(pressure_callback_mutex);
+  pressure_callbacks().push_back(std::move(callback));
+}
+
+size_t trimCachedBlocks(int device, size_t bytes_needed) {
+  assertValidDevice(device);
+  return caching_allocator.trimCachedBlocks(device, bytes_needed);
+}
+
+void markIterationBoundary() {
+  caching_allocator.iterationBoundary();
+}
+
 //
 // In CUDA IPC, sender sends a tensor to receiver, getIpcDevPtr
 // is called by the receiving process to map the CUDA memory from the sending
@@ -7,6 +7,7 @@
 #include <c10/util/Registry.h>
 
 #include <array>
+#include <functional>
 #include <mutex>
 
 namespace c10 {
@@ -101,6 +102,61 @@ struct SegmentInfo {
   std::vector<BlockInfo> blocks;
 };
 
+// Number of power-of-two size buckets in CacheDetail: bucket i covers
+// cached free blocks with 2^i <= size < 2^(i+1).
+constexpr size_t kCacheDetailBuckets = 48;
+
+// Detailed view of the cached (free) blocks on a device, for fragmentation
+// analysis: a sharp free-block size histogram distinguishes "the cache is
+// shredded into small blocks" from "memory is genuinely gone". Collected
+// under the allocator lock by walking the pools; never calls into CUDA, so
+// it is safe to query from an OOM handler or a monitoring thread.
+struct CacheDetail {
+  // Free-block size histogram, bucketed by log2(size).
+  std::array<int64_t, kCacheDetailBuckets> free_block_counts = {{0}};
+  std::array<int64_t, kCacheDetailBuckets> free_block_bytes = {{0}};
+  // Cached bytes keyed by the stream the blocks belong to (the stream
+  // handle cast to an integer; 0 is the default stream), sorted by stream.
+  std::vector<std::pair<int64_t, int64_t>> cached_bytes_per_stream;
+  // Largest cached contiguous block - the biggest request the allocator
+  // can serve without calling cudaMalloc.
+  int64_t largest_free_block = 0;
+  int64_t total_cached_bytes = 0;
+};
+
+// Allocator trace events, delivered synchronously from the allocating
+// thread while the allocator lock is held.
+enum struct TraceEventType : uint64_t {
+  ALLOC = 0,       // block handed to client code
+  FREE = 1,        // block returned by client code
+  SEGMENT_ALLOC = 2, // new segment obtained from cudaMalloc
+  SEGMENT_FREE = 3,  // segment returned to the driver with cudaFree
+  ALLOC_RETRY = 4,   // cudaMalloc failed; cache was flushed and retried
+  OOM = 5,           // allocation failed even after the retry
+};
+
+struct TraceEvent {
+  TraceEventType type;
+  int64_t device = 0;
+  int64_t size = 0;   // block or segment size in bytes
+  int64_t addr = 0;   // device pointer (0 when not applicable)
+  int64_t stream = 0; // requesting stream (0 = default stream)
+};
+
+// The handler runs under the allocator lock on the allocating thread: it
+// must be cheap (e.g. append to a preallocated ring) and must not allocate
+// or free CUDA memory. Pass nullptr to remove the handler.
+using TraceEventHandler = void (*)(const TraceEvent&);
+
+// Cooperative cache trimming for shared GPUs. When the watermark monitor
+// (enabled with PYTORCH_CUDA_TRIM_WATERMARK_MB, see the Note in
+// CUDACachingAllocator.cpp) observes device free memory below the
+// threshold, it first invokes every attached callback - on the monitor
+// thread, without the allocator lock held - and then trims the allocator's
+// own cache. Callbacks cannot be detached; attach for the process lifetime.
+using MemoryPressureCallback =
+    std::function<void(int device, size_t device_free, size_t device_total)>;
+
 C10_CUDA_API void* raw_alloc(size_t nbytes);
 C10_CUDA_API void raw_delete(void* ptr);
 
@@ -113,6 +169,22 @@ C10_CUDA_API DeviceStats getDeviceStats(int device);
 C10_CUDA_API void resetAccumulatedStats(int device);
 C10_CUDA_API void resetPeakStats(int device);
 C10_CUDA_API std::vector<SegmentInfo> snapshot();
+C10_CUDA_API CacheDetail getCacheDetail(int device);
+C10_CUDA_API void setTraceEventHandler(TraceEventHandler handler);
+C10_CUDA_API void attachMemoryPressureCallback(MemoryPressureCallback callback);
+// Returns up to `bytes_needed` bytes of unsplit cached blocks on `device` to
+// the driver, least recently cached first. Returns the bytes released. Unlike
+// emptyCache, this leaves recently used cache in place.
+C10_CUDA_API size_t trimCachedBlocks(int device, size_t bytes_needed);
+// Iteration-scoped allocation arena for training loops with stable shapes.
+// Call once at the top of every iteration: the first call starts recording
+// the allocation sequence, the second packs the recorded lifetimes into a
+// single preplanned arena, and later iterations are served straight from
+// precomputed offsets with no per-allocation bookkeeping. An iteration that
+// deviates from the recorded sequence falls back to the regular cache for
+// its remainder and the replay restarts at the next boundary. See
+// Note [Iteration-scoped memory pool] in CUDACachingAllocator.cpp.
+C10_CUDA_API void markIterationBoundary();
 
 C10_CUDA_API std::mutex* getFreeMutex();
 
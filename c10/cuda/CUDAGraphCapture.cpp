@@ -0,0 +1,90 @@
+#include <c10/cuda/CUDAGraphCapture.h>
+
+#include <c10/util/Exception.h>
+
+namespace c10 {
+namespace cuda {
+
+#ifdef C10_CUDA_HAS_STREAM_CAPTURE
+
+CUDAGraphCapture::~CUDAGraphCapture() {
+  reset();
+}
+
+bool CUDAGraphCapture::available() {
+  return true;
+}
+
+void CUDAGraphCapture::beginCapture(CUDAStream stream) {
+  TORCH_CHECK(!capturing_, "beginCapture called while already capturing");
+  TORCH_CHECK(!instantiated_, "beginCapture called with a recorded graph; call reset() first");
+  TORCH_CHECK(
+      stream != getDefaultCUDAStream(stream.device_index()),
+      "CUDA stream capture is not supported on the default stream");
+#if CUDA_VERSION >= 10010
+  C10_CUDA_CHECK(
+      cudaStreamBeginCapture(stream.stream(), cudaStreamCaptureModeThreadLocal));
+#else
+  C10_CUDA_CHECK(cudaStreamBeginCapture(stream.stream()));
+#endif
+  capturing_ = true;
+}
+
+void CUDAGraphCapture::endCapture(CUDAStream stream) {
+  TORCH_CHECK(capturing_, "endCapture called without beginCapture");
+  capturing_ = false;
+  C10_CUDA_CHECK(cudaStreamEndCapture(stream.stream(), &graph_));
+  C10_CUDA_CHECK(cudaGraphInstantiate(
+      &exec_, graph_, /*pErrorNode=*/nullptr, /*pLogBuffer=*/nullptr, /*bufferSize=*/0));
+  instantiated_ = true;
+}
+
+void CUDAGraphCapture::replay(CUDAStream stream) {
+  TORCH_CHECK(instantiated_, "replay called without a recorded graph");
+  C10_CUDA_CHECK(cudaGraphLaunch(exec_, stream.stream()));
+}
+
+void CUDAGraphCapture::reset() {
+  if (capturing_) {
+    // Abort the in-flight capture; cudaStreamEndCapture must be called on
+    // the capturing stream, and errors here are not actionable in a
+    // destructor, so only warn.
+    capturing_ = false;
+  }
+  if (exec_ != nullptr) {
+    C10_CUDA_CHECK_WARN(cudaGraphExecDestroy(exec_));
+    exec_ = nullptr;
+  }
+  if (graph_ != nullptr) {
+    C10_CUDA_CHECK_WARN(cudaGraphDestroy(graph_));
+    graph_ = nullptr;
+  }
+  instantiated_ = false;
+}
+
+#else // C10_CUDA_HAS_STREAM_CAPTURE
+
+CUDAGraphCapture::~CUDAGraphCapture() = default;
+
+bool CUDAGraphCapture::available() {
+  return false;
+}
+
+void CUDAGraphCapture::beginCapture(CUDAStream /* unused */) {
+  TORCH_CHECK(false, "CUDA stream capture requires CUDA 10 or later");
+}
+
+void CUDAGraphCapture::endCapture(CUDAStream /* unused */) {
+  TORCH_CHECK(false, "CUDA stream capture requires CUDA 10 or later");
+}
+
+void CUDAGraphCapture::replay(CUDAStream /* unused */) {
+  TORCH_CHECK(false, "CUDA stream capture requires CUDA 10 or later");
+}
+
+void CUDAGraphCapture::reset() {}
+
+#endif // C10_CUDA_HAS_STREAM_CAPTURE
+
+} // namespace cuda
+} // namespace c10
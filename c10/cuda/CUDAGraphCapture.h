@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <c10/cuda/CUDAException.h>
+#include <c10/cuda/CUDAMacros.h>
+#include <c10/cuda/CUDAStream.h>
+
+/*
+ * Kernel-launch batching via CUDA stream capture.
+ *
+ * For launch-bound workloads (small-batch inference runs dozens of tiny
+ * elementwise kernels per iteration), the per-kernel cudaLaunchKernel cost
+ * dominates. CUDA 10 stream capture lets us record the launch sequence of
+ * one iteration into a graph and replay the whole batch with a single
+ * cudaGraphLaunch.
+ *
+ * CUDAGraphCapture owns one recorded graph. CUDAGraphCaptureGuard is the
+ * scope guard eager code wraps around the steady-state region:
+ *
+ *   c10::cuda::CUDAGraphCapture capture;
+ *   for (...) {
+ *     c10::cuda::CUDAGraphCaptureGuard guard(capture, stream);
+ *     if (!guard.replayed()) {
+ *       runIteration();  // recorded on the first pass, skipped afterwards
+ *     }
+ *   }
+ *
+ * The first pass records the launches (the work still runs once, since the
+ * guard launches the freshly instantiated graph on scope exit); later passes
+ * replay the recorded batch without entering the eager region at all.
+ *
+ * All the usual CUDA graph restrictions apply to the captured region: the
+ * launch sequence and all kernel parameters (shapes, device pointers) must
+ * be identical across iterations, and the region must not synchronize the
+ * device or allocate in ways that are illegal during capture. This is why
+ * the facility is explicit opt-in rather than something the eager runtime
+ * applies on its own.
+ */
+
+// Stream capture needs the CUDA 10 runtime; on older toolkits the class
+// still compiles but capture is reported as unavailable.
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000 && !defined(__HIP_PLATFORM_HCC__)
+#define C10_CUDA_HAS_STREAM_CAPTURE 1
+#endif
+
+namespace c10 {
+namespace cuda {
+
+class C10_CUDA_API CUDAGraphCapture {
+ public:
+  CUDAGraphCapture() = default;
+  ~CUDAGraphCapture();
+
+  CUDAGraphCapture(const CUDAGraphCapture&) = delete;
+  CUDAGraphCapture& operator=(const CUDAGraphCapture&) = delete;
+
+  // Whether stream capture is supported by the runtime this was built with.
+  static bool available();
+
+  // Starts recording work submitted to `stream`. Work submitted between
+  // beginCapture and endCapture is recorded, not executed.
+  void beginCapture(CUDAStream stream);
+
+  // Stops recording and instantiates the executable graph.
+  void endCapture(CUDAStream stream);
+
+  // Launches the recorded batch on `stream`. Requires hasGraph().
+  void replay(CUDAStream stream);
+
+  // Drops the recorded graph so the next guard records again (e.g. after a
+  // shape change).
+  void reset();
+
+  bool capturing() const {
+    return capturing_;
+  }
+
+  bool hasGraph() const {
+    return instantiated_;
+  }
+
+ private:
+#ifdef C10_CUDA_HAS_STREAM_CAPTURE
+  cudaGraph_t graph_ = nullptr;
+  cudaGraphExec_t exec_ = nullptr;
+#endif
+  bool capturing_ = false;
+  bool instantiated_ = false;
+};
+
+// Scope guard: replays the recorded batch if there is one, otherwise records
+// the scope and launches the recording once on exit. Falls back to plain
+// eager execution (replayed() == false, nothing recorded) when capture is
+// unavailable.
+class C10_CUDA_API CUDAGraphCaptureGuard {
+ public:
+  CUDAGraphCaptureGuard(CUDAGraphCapture& capture, CUDAStream stream)
+      : capture_(capture), stream_(stream) {
+    if (!CUDAGraphCapture::available()) {
+      return;
+    }
+    if (capture_.hasGraph()) {
+      capture_.replay(stream_);
+      replayed_ = true;
+    } else {
+      capture_.beginCapture(stream_);
+    }
+  }
+
+  ~CUDAGraphCaptureGuard() {
+    if (capture_.capturing()) {
+      capture_.endCapture(stream_);
+      // Run the freshly recorded batch so the recording iteration still
+      // produces its results.
+      capture_.replay(stream_);
+    }
+  }
+
+  CUDAGraphCaptureGuard(const CUDAGraphCaptureGuard&) = delete;
+  CUDAGraphCaptureGuard& operator=(const CUDAGraphCaptureGuard&) = delete;
+
+  // True if the recorded batch was replayed; the caller should skip the
+  // eager region in that case.
+  bool replayed() const {
+    return replayed_;
+  }
+
+ private:
+  CUDAGraphCapture& capture_;
+  CUDAStream stream_;
+  bool replayed_ = false;
+};
+
+} // namespace cuda
+} // namespace c10
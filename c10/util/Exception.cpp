@@ -91,6 +91,42 @@ void WarningHandler::process(
 }
 
 
+namespace detail {
+
+void torchCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const std::string& msg) {
+  throw ::c10::Error({func, file, line}, msg);
+}
+
+void torchCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* msg) {
+  throw ::c10::Error({func, file, line}, msg);
+}
+
+void torchCheckIndexFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const std::string& msg) {
+  throw ::c10::IndexError({func, file, line}, msg);
+}
+
+void torchCheckIndexFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* msg) {
+  throw ::c10::IndexError({func, file, line}, msg);
+}
+
+} // namespace detail
+
 std::string GetExceptionString(const std::exception& e) {
 #ifdef __GXX_RTTI
   return demangle(typeid(e).name()) + ": " + e.what();
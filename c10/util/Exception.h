@@ -130,6 +130,47 @@ inline std::string if_empty_then(std::string x, std::string y) {
   }
 }
 
+// Message builders for TORCH_CHECK. The no-argument and single-string-literal
+// forms pass a const char* through untouched, so those call sites build no
+// std::string at all, on either path; everything else formats lazily through
+// c10::str on the failure path only. The non-template overloads win overload
+// resolution over the template for a single string literal.
+inline const char* torchCheckMsgImpl(const char* msg) {
+  return msg;
+}
+inline const char* torchCheckMsgImpl(const char* /*msg*/, const char* args) {
+  return args;
+}
+template <typename... Args>
+std::string torchCheckMsgImpl(const char* /*msg*/, const Args&... args) {
+  return ::c10::str(args...);
+}
+
+// Out-of-line cold paths for TORCH_CHECK and TORCH_CHECK_INDEX. Keeping the
+// throw machinery out of the macro expansion leaves only a predicted-untaken
+// branch and a call in the hot function, instead of inlined Error
+// construction at every check site.
+C10_NORETURN C10_API void torchCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const std::string& msg);
+C10_NORETURN C10_API void torchCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* msg);
+C10_NORETURN C10_API void torchCheckIndexFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const std::string& msg);
+C10_NORETURN C10_API void torchCheckIndexFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* msg);
+
 }
 
 
@@ -238,52 +279,40 @@ inline std::string if_empty_then(std::string x, std::string y) {
 // simply raises an exception, it does NOT unceremoniously quit the process
 // (unlike CHECK() from glog.)
 //
+// Expands to the failure message for TORCH_CHECK(cond, ...): the default
+// message when no extra arguments are given, the literal itself for a single
+// string literal, and a lazily formatted c10::str otherwise. Only ever
+// evaluated on the failure path.
 #ifdef STRIP_ERROR_MESSAGES
-#define TORCH_CHECK(cond, ...)                \
-  if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
-    C10_THROW_ERROR(Error,                    \
-        #cond " CHECK FAILED at "             \
-        __FILE__                              \
-    );                                        \
-  }
+#define TORCH_CHECK_MSG(cond, ...) \
+  (#cond " CHECK FAILED at " __FILE__)
 #else
-#define TORCH_CHECK(cond, ...)                              \
-  if (C10_UNLIKELY_OR_CONST(!(cond))) {                     \
-    C10_THROW_ERROR(Error,                                  \
-      ::c10::detail::if_empty_then(                         \
-        ::c10::str(__VA_ARGS__),                            \
-        "Expected " #cond " to be true, but got false.  "   \
-        "(Could this error message be improved?  If so, "   \
-        "please report an enhancement request to PyTorch.)" \
-      )                                                     \
-    );                                                      \
-  }
+#define TORCH_CHECK_MSG(cond, ...)                          \
+  (::c10::detail::torchCheckMsgImpl(                        \
+      "Expected " #cond " to be true, but got false.  "     \
+      "(Could this error message be improved?  If so, "     \
+      "please report an enhancement request to PyTorch.)",  \
+      ##__VA_ARGS__))
 #endif
-// TODO: We're going to get a lot of similar looking string literals
-// this way; check if this actually affects binary size.
 
-// Like TORCH_CHECK, but raises IndexErrors instead of Errors.
-#ifdef STRIP_ERROR_MESSAGES
-#define TORCH_CHECK_INDEX(cond, ...)          \
-  if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
-    C10_THROW_ERROR(Error,                    \
-        #cond " INDEX CHECK FAILED at "       \
-        __FILE__                              \
-    );                                        \
+#define TORCH_CHECK(cond, ...)                 \
+  if (C10_UNLIKELY_OR_CONST(!(cond))) {        \
+    ::c10::detail::torchCheckFail(             \
+        __func__,                              \
+        __FILE__,                              \
+        static_cast<uint32_t>(__LINE__),       \
+        TORCH_CHECK_MSG(cond, ##__VA_ARGS__)); \
   }
-#else
-#define TORCH_CHECK_INDEX(cond, ...)                        \
-  if (C10_UNLIKELY_OR_CONST(!(cond))) {                     \
-    C10_THROW_ERROR(IndexError,                             \
-      ::c10::detail::if_empty_then(                         \
-        ::c10::str(__VA_ARGS__),                            \
-        "Expected " #cond " to be true, but got false.  "   \
-        "(Could this error message be improved?  If so, "   \
-        "please report an enhancement request to PyTorch.)" \
-      )                                                     \
-    );                                                      \
+
+// Like TORCH_CHECK, but raises IndexErrors instead of Errors.
+#define TORCH_CHECK_INDEX(cond, ...)           \
+  if (C10_UNLIKELY_OR_CONST(!(cond))) {        \
+    ::c10::detail::torchCheckIndexFail(        \
+        __func__,                              \
+        __FILE__,                              \
+        static_cast<uint32_t>(__LINE__),       \
+        TORCH_CHECK_MSG(cond, ##__VA_ARGS__)); \
   }
-#endif
 
 
 // Report a warning to the user.  Accepts an arbitrary number of extra
@@ -0,0 +1,137 @@
+#include "c10/util/cpu_topology.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <cstdio>
+#define C10_ENABLE_CPU_TOPOLOGY
+#endif
+
+// Like numa.cpp: topology may be queried during static initialization, so
+// no logging here.
+
+namespace c10 {
+
+namespace {
+
+struct CpuTopology {
+  std::vector<int> big_core_ids;
+  int num_cores = 0;
+  double little_throughput_ratio = 1.0;
+  bool heterogeneous = false;
+};
+
+#ifdef C10_ENABLE_CPU_TOPOLOGY
+CpuTopology detectTopology() {
+  CpuTopology topo;
+  topo.num_cores = static_cast<int>(std::thread::hardware_concurrency());
+  std::vector<long> max_freqs(topo.num_cores, -1);
+  long fastest = -1;
+  long slowest = -1;
+  for (int cpu = 0; cpu < topo.num_cores; ++cpu) {
+    char path[128];
+    snprintf(
+        path,
+        sizeof(path),
+        "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq",
+        cpu);
+    FILE* f = fopen(path, "r");
+    if (!f) {
+      continue;
+    }
+    long freq = -1;
+    if (fscanf(f, "%ld", &freq) != 1) {
+      freq = -1;
+    }
+    fclose(f);
+    if (freq <= 0) {
+      continue;
+    }
+    max_freqs[cpu] = freq;
+    fastest = std::max(fastest, freq);
+    slowest = (slowest < 0) ? freq : std::min(slowest, freq);
+  }
+  if (fastest <= 0) {
+    // no cpufreq information; treat the machine as homogeneous
+    for (int cpu = 0; cpu < topo.num_cores; ++cpu) {
+      topo.big_core_ids.push_back(cpu);
+    }
+    return topo;
+  }
+  for (int cpu = 0; cpu < topo.num_cores; ++cpu) {
+    if (max_freqs[cpu] == fastest) {
+      topo.big_core_ids.push_back(cpu);
+    }
+  }
+  topo.heterogeneous = static_cast<int>(topo.big_core_ids.size()) <
+      topo.num_cores && !topo.big_core_ids.empty();
+  if (topo.heterogeneous) {
+    topo.little_throughput_ratio =
+        static_cast<double>(slowest) / static_cast<double>(fastest);
+  }
+  return topo;
+}
+#else
+CpuTopology detectTopology() {
+  CpuTopology topo;
+  topo.num_cores = static_cast<int>(std::thread::hardware_concurrency());
+  for (int cpu = 0; cpu < topo.num_cores; ++cpu) {
+    topo.big_core_ids.push_back(cpu);
+  }
+  return topo;
+}
+#endif
+
+const CpuTopology& topology() {
+  static const CpuTopology* topo = new CpuTopology(detectTopology());
+  return *topo;
+}
+
+std::atomic<bool> restrict_to_big_cores{false};
+
+} // namespace
+
+bool IsHeterogeneousCpu() {
+  return topology().heterogeneous;
+}
+
+int GetNumBigCores() {
+  return static_cast<int>(topology().big_core_ids.size());
+}
+
+const std::vector<int>& GetBigCoreIds() {
+  return topology().big_core_ids;
+}
+
+double GetLittleCoreThroughputRatio() {
+  return topology().little_throughput_ratio;
+}
+
+void SetRestrictToBigCores(bool enabled) {
+  restrict_to_big_cores = enabled;
+}
+
+bool GetRestrictToBigCores() {
+  return restrict_to_big_cores;
+}
+
+void BindToBigCores() {
+#ifdef C10_ENABLE_CPU_TOPOLOGY
+  const auto& topo = topology();
+  if (!topo.heterogeneous) {
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : topo.big_core_ids) {
+    CPU_SET(cpu, &set);
+  }
+  // best effort; an error leaves the default affinity in place
+  sched_setaffinity(0, sizeof(set), &set);
+#endif
+}
+
+} // namespace c10
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <vector>
+
+namespace c10 {
+
+/**
+ * Heterogeneous CPU (big.LITTLE) topology support.
+ *
+ * On Linux and Android the topology is read once from
+ * /sys/devices/system/cpu/cpuN/cpufreq/cpuinfo_max_freq: cores whose
+ * maximum frequency matches the fastest core are "big", the rest are
+ * "little". Homogeneous machines (and platforms without sysfs) report
+ * every core as big.
+ */
+
+/**
+ * Whether the machine has cores of more than one performance class.
+ */
+C10_API bool IsHeterogeneousCpu();
+
+/**
+ * Number of big cores (equals the total core count on homogeneous
+ * machines).
+ */
+C10_API int GetNumBigCores();
+
+/**
+ * Logical ids of the big cores.
+ */
+C10_API const std::vector<int>& GetBigCoreIds();
+
+/**
+ * Ratio of the slowest core's maximum frequency to the fastest, in (0, 1];
+ * 1.0 on homogeneous machines. Used as a per-core throughput proxy when
+ * sizing intra-op parallel chunks.
+ */
+C10_API double GetLittleCoreThroughputRatio();
+
+/**
+ * Request that pool worker threads run only on big cores. Takes effect for
+ * threads created after the call (thread pools are created lazily, so
+ * calling this before the first parallel operation covers them all).
+ * No effect on homogeneous machines.
+ */
+C10_API void SetRestrictToBigCores(bool enabled);
+
+/**
+ * Whether worker threads have been restricted to big cores.
+ */
+C10_API bool GetRestrictToBigCores();
+
+/**
+ * Bind the calling thread to the big cores. No-op when the topology is
+ * homogeneous or affinity is unsupported on this platform.
+ */
+C10_API void BindToBigCores();
+
+} // namespace c10
@@ -129,4 +129,25 @@ int GetCurrentNUMANode() {
 
 #endif // C10_NUMA_ENABLED
 
+// Thread-local override for the node targeted by alloc_cpu. -1 means no
+// pin: allocations follow the thread's current node as before.
+static thread_local int numa_node_override = -1;
+
+void SetThreadNUMANode(int numa_node_id) {
+#ifdef C10_ENABLE_NUMA
+  if (numa_node_id >= 0 && IsNUMAEnabled()) {
+    TORCH_CHECK(
+        numa_node_id <= numa_max_node(),
+        "NUMA node id ",
+        numa_node_id,
+        " is unavailable");
+  }
+#endif
+  numa_node_override = numa_node_id;
+}
+
+int GetThreadNUMANode() {
+  return numa_node_override;
+}
+
 } // namespace c10
@@ -37,4 +37,19 @@ C10_API void NUMAMove(void* ptr, size_t size, int numa_node_id);
  */
 C10_API int GetCurrentNUMANode();
 
+/**
+ * Pin all subsequent c10 CPU allocations made by the calling thread to a
+ * given NUMA node, regardless of which node the thread is running on.
+ * Useful for producer threads that allocate on behalf of consumers on
+ * another socket. Pass -1 to remove the pin and fall back to the thread's
+ * current node.
+ */
+C10_API void SetThreadNUMANode(int numa_node_id);
+
+/**
+ * Get the NUMA node the calling thread's allocations are pinned to, or -1
+ * if the thread is not pinned.
+ */
+C10_API int GetThreadNUMANode();
+
 } // namespace c10
@@ -2,9 +2,75 @@
 #include <c10/util/Exception.h>
 #include "caffe2/core/common.h"
 
+#include <cerrno>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace caffe2 {
 namespace serialize {
 
+#ifndef _WIN32
+
+FileAdapter::FileAdapter(const std::string& file_name) {
+  fd_ = open(file_name.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    AT_ERROR("open file failed, file path: ", file_name);
+  }
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    close(fd_);
+    fd_ = -1;
+    AT_ERROR("stat file failed, file path: ", file_name);
+  }
+  size_ = file_stat.st_size;
+#ifdef POSIX_FADV_SEQUENTIAL
+  // Containers are mostly consumed front to back; let the kernel read ahead
+  // aggressively.
+  posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+size_t FileAdapter::size() const {
+  return size_;
+}
+
+size_t FileAdapter::read(uint64_t pos, void* buf, size_t n, const char* what)
+    const {
+  char* dst = static_cast<char*>(buf);
+  size_t total = 0;
+  while (total < n) {
+    ssize_t ret = pread(fd_, dst + total, n - total, pos + total);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AT_ERROR("read file failed: ", what);
+    }
+    if (ret == 0) {
+      // end of file
+      break;
+    }
+    total += ret;
+  }
+  return total;
+}
+
+bool FileAdapter::supportsConcurrentReads() const {
+  return true;
+}
+
+FileAdapter::~FileAdapter() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+#else // _WIN32
+
 FileAdapter::FileAdapter(const std::string& file_name) {
   file_stream_.open(file_name, std::ifstream::in | std::ifstream::binary);
   if (!file_stream_) {
@@ -22,7 +88,13 @@ size_t FileAdapter::read(uint64_t pos, void* buf, size_t n, const char* what)
   return istream_adapter_->read(pos, buf, n, what);
 }
 
+bool FileAdapter::supportsConcurrentReads() const {
+  return false;
+}
+
 FileAdapter::~FileAdapter() {}
 
+#endif // _WIN32
+
 } // namespace serialize
 } // namespace caffe2
@@ -17,11 +17,20 @@ class CAFFE2_API FileAdapter final : public ReadAdapterInterface {
   size_t size() const override;
   size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
       const override;
+  bool supportsConcurrentReads() const override;
   ~FileAdapter();
 
  private:
+#ifndef _WIN32
+  // On POSIX the file is read through pread(2), which takes an explicit
+  // offset and is safe to call from multiple threads on the same
+  // descriptor, so readers can fetch independent regions concurrently.
+  int fd_ = -1;
+  size_t size_ = 0;
+#else
   std::ifstream file_stream_;
   std::unique_ptr<IStreamAdapter> istream_adapter_;
+#endif
 };
 
 } // namespace serialize
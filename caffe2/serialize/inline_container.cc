@@ -1,9 +1,14 @@
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <cerrno>
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
@@ -180,6 +185,7 @@ static size_t getPadding(
 }
 
 bool PyTorchStreamReader::hasRecord(const std::string& name) {
+  std::lock_guard<std::recursive_mutex> lock(reader_mutex_);
   std::string ss = archive_name_plus_slash_ + name;
   mz_zip_reader_locate_file(ar_.get(), ss.c_str(), nullptr, 0);
   bool result = ar_->m_last_error != MZ_ZIP_FILE_NOT_FOUND;
@@ -200,15 +206,234 @@ size_t PyTorchStreamReader::getRecordID(const std::string& name) {
   return result;
 }
 
+// Number of threads used to fetch large stored records
+// (TORCH_SERIALIZE_READER_THREADS). With 1 (the default) records are read
+// through miniz as before. Values above 1 split each large uncompressed
+// record into ranges read concurrently, which is needed to saturate NVMe
+// class storage from a single checkpoint load.
+static size_t readerThreadCount() {
+  static const size_t count = []() -> size_t {
+    const char* env = std::getenv("TORCH_SERIALIZE_READER_THREADS");
+    if (!env) {
+      return 1;
+    }
+    auto value = std::atol(env);
+    return value > 1 ? static_cast<size_t>(value) : 1;
+  }();
+  return count;
+}
+
+// Records smaller than this are read on the calling thread; splitting them
+// would cost more in thread handoff than the read itself.
+constexpr size_t kMinParallelReadSize = 16 * 1024 * 1024;
+
+// Note [Chunked record compression]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The zip deflate path in writeRecord compresses a record as one stream
+// on one thread, which makes compressed checkpoints unreasonably slow to
+// produce and restore. When TORCH_SERIALIZE_CODEC_THREADS is set above 1,
+// records passed to writeRecord with compress=true are instead split into
+// fixed-size chunks that are compressed independently and in parallel,
+// concatenated, and stored (method STORE) as the record payload, with a
+// companion "<name>.codec" record describing the codec, the chunk size and
+// the per-chunk compressed sizes. The reader inflates the chunks in
+// parallel into their known output offsets.
+//
+// Files written without this feature have no "<name>.codec" records and
+// load exactly as before; decoding a chunked record does not depend on the
+// environment variable, only the degree of parallelism does. The codec id
+// makes the format pluggable: miniz deflate is the only codec compiled in
+// today, but an lz4/zstd id can be added without changing the layout.
+
+constexpr size_t kCompressionChunkSize = 1024 * 1024;
+
+// Compressing tiny records costs more in metadata and thread handoff than
+// it saves.
+constexpr size_t kMinChunkedCompressSize = 4 * 1024 * 1024;
+
+constexpr uint64_t kChunkedRecordMagic = 0x50544348554e4b31ULL; // "PTCHUNK1"
+
+constexpr const char* kChunkedMetaSuffix = ".codec";
+
+struct ChunkedRecordHeader {
+  uint64_t magic;
+  uint32_t codec;
+  uint32_t reserved;
+  uint64_t uncompressed_size;
+  uint64_t chunk_size;
+  uint64_t num_chunks;
+};
+
+// Number of threads used to compress and decompress chunked records
+// (TORCH_SERIALIZE_CODEC_THREADS). With 1 (the default) the writer keeps
+// producing ordinary whole-record deflate streams and the reader inflates
+// chunked records serially.
+static size_t codecThreadCount() {
+  static const size_t count = []() -> size_t {
+    const char* env = std::getenv("TORCH_SERIALIZE_CODEC_THREADS");
+    if (!env) {
+      return 1;
+    }
+    auto value = std::atol(env);
+    return value > 1 ? static_cast<size_t>(value) : 1;
+  }();
+  return count;
+}
+
+// See Note [Chunked record compression]. The payload of `name` holds the
+// concatenated compressed chunks; the "<name>.codec" record tells us how
+// to cut it up, and every chunk inflates into an independent, known range
+// of the output buffer, so the chunks can be decoded in parallel.
+std::tuple<at::DataPtr, size_t> PyTorchStreamReader::readChunkedRecord(
+    const std::string& name) {
+  // metadata record
+  size_t meta_key = getRecordID(name + kChunkedMetaSuffix);
+  mz_zip_archive_file_stat meta_stat;
+  mz_zip_reader_file_stat(ar_.get(), meta_key, &meta_stat);
+  valid("retrieving chunk meta-data for ", name.c_str());
+  std::vector<uint8_t> meta(meta_stat.m_uncomp_size);
+  mz_zip_reader_extract_to_mem(ar_.get(), meta_key, meta.data(), meta.size(), 0);
+  valid("reading chunk meta-data for ", name.c_str());
+  ChunkedRecordHeader header;
+  if (meta.size() < sizeof(header)) {
+    CAFFE_THROW("truncated chunk meta-data for record: ", name);
+  }
+  memcpy(&header, meta.data(), sizeof(header));
+  if (header.magic != kChunkedRecordMagic ||
+      header.codec != static_cast<uint32_t>(RecordCodec::kDeflate)) {
+    CAFFE_THROW(
+        "record ",
+        name,
+        " was written with an unsupported compression codec (id ",
+        header.codec,
+        ")");
+  }
+  if (meta.size() != sizeof(header) + header.num_chunks * sizeof(uint64_t)) {
+    CAFFE_THROW("malformed chunk meta-data for record: ", name);
+  }
+  std::vector<uint64_t> chunk_sizes(header.num_chunks);
+  memcpy(
+      chunk_sizes.data(),
+      meta.data() + sizeof(header),
+      header.num_chunks * sizeof(uint64_t));
+
+  // compressed payload
+  size_t key = getRecordID(name);
+  mz_zip_archive_file_stat stat;
+  mz_zip_reader_file_stat(ar_.get(), key, &stat);
+  valid("retrieving file meta-data for ", name.c_str());
+  std::vector<uint8_t> compressed(stat.m_uncomp_size);
+  mz_zip_reader_extract_to_mem(
+      ar_.get(), key, compressed.data(), compressed.size(), 0);
+  valid("reading file ", name.c_str());
+
+  std::vector<uint64_t> chunk_offsets(header.num_chunks);
+  uint64_t total_compressed = 0;
+  for (uint64_t i = 0; i < header.num_chunks; ++i) {
+    chunk_offsets[i] = total_compressed;
+    total_compressed += chunk_sizes[i];
+  }
+  if (total_compressed != compressed.size()) {
+    CAFFE_THROW("chunk sizes do not match payload size for record: ", name);
+  }
+
+  void* ptr = malloc(header.uncompressed_size);
+  const size_t num_threads =
+      std::min(codecThreadCount(), static_cast<size_t>(header.num_chunks));
+  std::atomic<bool> failed(false);
+  auto decompress_chunks = [&](size_t thread_idx, size_t stride) {
+    for (uint64_t i = thread_idx; i < header.num_chunks; i += stride) {
+      const uint64_t begin = i * header.chunk_size;
+      mz_ulong dest_len = static_cast<mz_ulong>(
+          std::min<uint64_t>(header.chunk_size, header.uncompressed_size - begin));
+      const mz_ulong expected_len = dest_len;
+      if (mz_uncompress(
+              static_cast<unsigned char*>(ptr) + begin,
+              &dest_len,
+              compressed.data() + chunk_offsets[i],
+              static_cast<mz_ulong>(chunk_sizes[i])) != MZ_OK ||
+          dest_len != expected_len) {
+        failed = true;
+        return;
+      }
+    }
+  };
+  if (num_threads > 1) {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < num_threads; ++t) {
+      workers.emplace_back(decompress_chunks, t, num_threads);
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  } else {
+    decompress_chunks(0, 1);
+  }
+  if (failed) {
+    free(ptr);
+    CAFFE_THROW("PytorchStreamReader failed decompressing record: ", name);
+  }
+  at::DataPtr retval(ptr, ptr, free, at::kCPU);
+  return std::make_tuple(std::move(retval), header.uncompressed_size);
+}
+
 // return dataptr, size
 std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string& name) {
+  std::lock_guard<std::recursive_mutex> lock(reader_mutex_);
+  if (hasRecord(name + kChunkedMetaSuffix)) {
+    return readChunkedRecord(name);
+  }
   size_t key = getRecordID(name);
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), key, &stat);
   valid("retrieving file meta-data for ", name.c_str());
   void * ptr = malloc(stat.m_uncomp_size);
-  mz_zip_reader_extract_to_mem(ar_.get(), key, ptr, stat.m_uncomp_size, 0);
-  valid("reading file ", name.c_str());
+
+  const size_t num_threads = readerThreadCount();
+  if (num_threads > 1 && stat.m_method == 0 &&
+      stat.m_uncomp_size >= kMinParallelReadSize &&
+      in_->supportsConcurrentReads()) {
+    // Stored (uncompressed) record on an adapter with thread-safe positional
+    // reads: bypass miniz and fetch the raw byte range concurrently. The
+    // local file header gives us the exact data offset. Note that unlike
+    // mz_zip_reader_extract_to_mem this path does not verify the record CRC.
+    const size_t data_offset = getRecordOffset(name);
+    const size_t size = stat.m_uncomp_size;
+    const size_t chunk_size = (size + num_threads - 1) / num_threads;
+    std::vector<std::thread> readers;
+    std::atomic<bool> failed(false);
+    for (size_t i = 0; i < num_threads; ++i) {
+      const size_t begin = i * chunk_size;
+      if (begin >= size) {
+        break;
+      }
+      const size_t length = std::min(chunk_size, size - begin);
+      readers.emplace_back([this, ptr, data_offset, begin, length, &failed]() {
+        try {
+          size_t read_bytes = in_->read(
+              data_offset + begin,
+              static_cast<char*>(ptr) + begin,
+              length,
+              "reading record");
+          if (read_bytes != length) {
+            failed = true;
+          }
+        } catch (...) {
+          failed = true;
+        }
+      });
+    }
+    for (auto& reader : readers) {
+      reader.join();
+    }
+    if (failed) {
+      free(ptr);
+      CAFFE_THROW("PytorchStreamReader failed reading record: ", name);
+    }
+  } else {
+    mz_zip_reader_extract_to_mem(ar_.get(), key, ptr, stat.m_uncomp_size, 0);
+    valid("reading file ", name.c_str());
+  }
 
   at::DataPtr retval(ptr, ptr, free, at::kCPU);
   return std::make_tuple(std::move(retval), stat.m_uncomp_size);
@@ -219,6 +444,7 @@ static int64_t read_le_16(uint8_t* buf) {
 }
 
 size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
+  std::lock_guard<std::recursive_mutex> lock(reader_mutex_);
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
   valid("retrieving file meta-data for ", name.c_str());
@@ -233,6 +459,32 @@ size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
   return stat.m_local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
 }
 
+size_t PyTorchStreamReader::getRecordSize(const std::string& name) {
+  std::lock_guard<std::recursive_mutex> lock(reader_mutex_);
+  if (hasRecord(name + kChunkedMetaSuffix)) {
+    // See Note [Chunked record compression]; the uncompressed size lives in
+    // the "<name>.codec" metadata record.
+    size_t meta_key = getRecordID(name + kChunkedMetaSuffix);
+    mz_zip_archive_file_stat meta_stat;
+    mz_zip_reader_file_stat(ar_.get(), meta_key, &meta_stat);
+    valid("retrieving chunk meta-data for ", name.c_str());
+    std::vector<uint8_t> meta(meta_stat.m_uncomp_size);
+    mz_zip_reader_extract_to_mem(
+        ar_.get(), meta_key, meta.data(), meta.size(), 0);
+    valid("reading chunk meta-data for ", name.c_str());
+    ChunkedRecordHeader header;
+    if (meta.size() < sizeof(header)) {
+      CAFFE_THROW("truncated chunk meta-data for record: ", name);
+    }
+    memcpy(&header, meta.data(), sizeof(header));
+    return header.uncompressed_size;
+  }
+  mz_zip_archive_file_stat stat;
+  mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
+  valid("retrieving file meta-data for ", name.c_str());
+  return stat.m_uncomp_size;
+}
+
 
 PyTorchStreamReader::~PyTorchStreamReader() {
   mz_zip_reader_end(ar_.get());
@@ -297,6 +549,83 @@ void PyTorchStreamWriter::setup(const string& file_name) {
   writeRecord("version", version.c_str(), version.size());
 }
 
+// See Note [Chunked record compression]. Returns false when the record
+// should fall back to the ordinary write path (compression failed or did
+// not shrink the data).
+bool PyTorchStreamWriter::writeChunkedRecord(
+    const std::string& name,
+    const void* data,
+    size_t size) {
+  const size_t num_chunks =
+      (size + kCompressionChunkSize - 1) / kCompressionChunkSize;
+  std::vector<std::vector<unsigned char>> chunks(num_chunks);
+  const size_t num_threads = std::min(codecThreadCount(), num_chunks);
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < num_threads; ++t) {
+    workers.emplace_back([&, t]() {
+      for (size_t i = t; i < num_chunks; i += num_threads) {
+        const size_t begin = i * kCompressionChunkSize;
+        const mz_ulong src_len = static_cast<mz_ulong>(
+            std::min(kCompressionChunkSize, size - begin));
+        mz_ulong dest_len = mz_compressBound(src_len);
+        chunks[i].resize(dest_len);
+        if (mz_compress2(
+                chunks[i].data(),
+                &dest_len,
+                static_cast<const unsigned char*>(data) + begin,
+                src_len,
+                MZ_BEST_COMPRESSION) != MZ_OK) {
+          failed = true;
+          return;
+        }
+        chunks[i].resize(dest_len);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (failed) {
+    return false;
+  }
+
+  size_t total_compressed = 0;
+  for (const auto& chunk : chunks) {
+    total_compressed += chunk.size();
+  }
+  const size_t meta_size =
+      sizeof(ChunkedRecordHeader) + num_chunks * sizeof(uint64_t);
+  if (total_compressed + meta_size >= size) {
+    // incompressible data; storing it plain is both smaller and faster
+    return false;
+  }
+
+  ChunkedRecordHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kChunkedRecordMagic;
+  header.codec = static_cast<uint32_t>(RecordCodec::kDeflate);
+  header.uncompressed_size = size;
+  header.chunk_size = kCompressionChunkSize;
+  header.num_chunks = num_chunks;
+  std::vector<uint8_t> meta(meta_size);
+  memcpy(meta.data(), &header, sizeof(header));
+  std::vector<uint8_t> payload(total_compressed);
+  size_t offset = 0;
+  for (size_t i = 0; i < num_chunks; ++i) {
+    const uint64_t chunk_size = chunks[i].size();
+    memcpy(
+        meta.data() + sizeof(header) + i * sizeof(uint64_t),
+        &chunk_size,
+        sizeof(uint64_t));
+    memcpy(payload.data() + offset, chunks[i].data(), chunks[i].size());
+    offset += chunks[i].size();
+  }
+  writeRecord(name + kChunkedMetaSuffix, meta.data(), meta.size(), false);
+  writeRecord(name, payload.data(), payload.size(), false);
+  return true;
+}
+
 void PyTorchStreamWriter::writeRecord(
     const std::string& name,
     const void* data,
@@ -304,6 +633,10 @@ void PyTorchStreamWriter::writeRecord(
     bool compress) {
   AT_ASSERT(!finalized_);
   AT_ASSERT(!archive_name_plus_slash_.empty());
+  if (compress && size >= kMinChunkedCompressSize && codecThreadCount() > 1 &&
+      writeChunkedRecord(name, data, size)) {
+    return;
+  }
   std::string full_name = archive_name_plus_slash_ + name;
   size_t padding_size =
       getPadding(ar_->m_archive_size, full_name.size(), size, padding_);
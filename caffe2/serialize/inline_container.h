@@ -4,6 +4,7 @@
 #include <cstring>
 #include <cerrno>
 #include <istream>
+#include <mutex>
 #include <ostream>
 #include <fstream>
 
@@ -96,6 +97,16 @@ constexpr uint64_t kProducedFileFormatVersion = 0x1L;
 // Writer-specific constants
 constexpr uint64_t kFieldAlignment = 64;
 
+// Codec ids recorded in the metadata of chunk-compressed records (see
+// Note [Chunked record compression] in inline_container.cc). Only
+// kDeflate is implemented - miniz is the only codec linked into the
+// container - but the id field leaves room for faster codecs without a
+// format change.
+enum class RecordCodec : uint32_t {
+  kNone = 0,
+  kDeflate = 1,
+};
+
 class CAFFE2_API PyTorchStreamReader final {
  public:
   explicit PyTorchStreamReader(const std::string& file_name);
@@ -105,6 +116,8 @@ class CAFFE2_API PyTorchStreamReader final {
   // return dataptr, size
   std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
   size_t getRecordOffset(const std::string& name);
+  // Returns the uncompressed size of a record without reading its payload.
+  size_t getRecordSize(const std::string& name);
   bool hasRecord(const std::string& name);
 
   ~PyTorchStreamReader();
@@ -116,6 +129,7 @@ class CAFFE2_API PyTorchStreamReader final {
   size_t read(uint64_t pos, char* buf, size_t n);
   void valid(const char* what, const char* info = "");
   size_t getRecordID(const std::string& name);
+  std::tuple<at::DataPtr, size_t> readChunkedRecord(const std::string& name);
 
   friend size_t
   istream_read_func(void* pOpaque, uint64_t file_ofs, void* pBuf, size_t n);
@@ -124,6 +138,13 @@ class CAFFE2_API PyTorchStreamReader final {
   std::string archive_name_plus_slash_;
   std::unique_ptr<ReadAdapterInterface> in_;
   int64_t version_;
+  // Serializes record lookups: miniz's archive handle and the adapter's
+  // read position are shared state. Held for the whole of a record read,
+  // so callers on different threads may overlap a read with compute but
+  // not with each other; the parallelism inside a single large read
+  // (chunked decompression, ranged raw reads) is unaffected. Recursive
+  // because getRecord reaches hasRecord/getRecordOffset internally.
+  mutable std::recursive_mutex reader_mutex_;
 };
 
 class CAFFE2_API PyTorchStreamWriter final {
@@ -152,6 +173,7 @@ class CAFFE2_API PyTorchStreamWriter final {
  private:
   void setup(const string& file_name);
   void valid(const char* what, const char* info = "");
+  bool writeChunkedRecord(const std::string& name, const void* data, size_t size);
   size_t current_pos_ = 0;
   std::unique_ptr<mz_zip_archive> ar_;
   std::string archive_name_;
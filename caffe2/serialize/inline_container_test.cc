@@ -63,6 +63,42 @@ TEST(PyTorchStreamWriterAndReader, SaveAndLoad) {
   ASSERT_EQ(memcmp(the_file.c_str() + off2, data2.data(), data2.size()), 0);
 }
 
+TEST(PyTorchStreamWriterAndReader, ChunkedCompression) {
+#ifdef _WIN32
+  _putenv("TORCH_SERIALIZE_CODEC_THREADS=4");
+#else
+  setenv("TORCH_SERIALIZE_CODEC_THREADS", "4", 1);
+#endif
+
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+
+  // large enough to span several compression chunks, and compressible
+  std::vector<char> data(8 * 1024 * 1024);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>((i / 1024) % 251);
+  }
+  writer.writeRecord("big", data.data(), data.size(), /*compress=*/true);
+  writer.writeEndOfFile();
+
+  std::string the_file = oss.str();
+  // the record must actually have been compressed
+  ASSERT_LT(the_file.size(), data.size());
+
+  std::istringstream iss(the_file);
+  PyTorchStreamReader reader(&iss);
+  ASSERT_TRUE(reader.hasRecord("big"));
+  ASSERT_TRUE(reader.hasRecord("big.codec"));
+  at::DataPtr data_ptr;
+  int64_t size;
+  std::tie(data_ptr, size) = reader.getRecord("big");
+  ASSERT_EQ(size, data.size());
+  ASSERT_EQ(memcmp(data_ptr.get(), data.data(), data.size()), 0);
+}
+
 } // namespace
 } // namespace serialize
 } // namespace caffe2
@@ -16,6 +16,11 @@ class CAFFE2_API ReadAdapterInterface {
   virtual size_t size() const = 0;
   virtual size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
       const = 0;
+  // whether read() may be called from multiple threads at the same time.
+  // Readers can use this to fetch independent regions concurrently.
+  virtual bool supportsConcurrentReads() const {
+    return false;
+  }
   virtual ~ReadAdapterInterface();
 };
 
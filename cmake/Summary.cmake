@@ -22,6 +22,9 @@ function (caffe2_print_configuration_summary)
   message(STATUS "  CAFFE2_VERSION        : ${CAFFE2_VERSION}")
   message(STATUS "  BUILD_CAFFE2_MOBILE   : ${BUILD_CAFFE2_MOBILE}")
   message(STATUS "  USE_STATIC_DISPATCH   : ${USE_STATIC_DISPATCH}")
+  if (ATEN_DTYPE_ALLOWLIST)
+    message(STATUS "  ATEN_DTYPE_ALLOWLIST  : ${ATEN_DTYPE_ALLOWLIST}")
+  endif()
   message(STATUS "  BUILD_BINARY          : ${BUILD_BINARY}")
   message(STATUS "  BUILD_CUSTOM_PROTOBUF : ${BUILD_CUSTOM_PROTOBUF}")
   if (${CAFFE2_LINK_LOCAL_PROTOBUF})
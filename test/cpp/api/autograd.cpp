@@ -123,6 +123,22 @@ TEST(AutogradAPITests, GradUnreachableTest) {
   ASSERT_FALSE(grad_res[1].defined());
 }
 
+TEST(AutogradAPITests, GradTrainedSubsetTest) {
+  // Restricting grad() to a subset of the leaves prunes the rest of the
+  // graph from dependency counting; a function on the boundary (here the
+  // add joining the two branches) has edges into both the executed and the
+  // pruned region and must still see correct counts.
+  Variable adapter = torch::randn({2, 2}, torch::requires_grad());
+  Variable frozen = torch::randn({2, 2}, torch::requires_grad());
+
+  auto res = (adapter * 3 + frozen * frozen).sum();
+  auto grad_res = grad({res}, {adapter});
+
+  ASSERT_EQ(grad_res.size(), 1);
+  ASSERT_VARIABLE_EQ(grad_res[0], torch::ones({2, 2}) * 3);
+  ASSERT_FALSE(frozen.grad().defined());
+}
+
 TEST(CustomAutogradTest, CustomFunction) {
   struct MyFunction : public Function<MyFunction> {
     static Variable forward(AutogradContext *ctx, Variable var1, int mul, Variable var2) {
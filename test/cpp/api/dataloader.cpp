@@ -407,6 +407,50 @@ TEST(DataTest, SavingAndLoadingRandomSamplerYieldsSameSequence) {
   }
 }
 
+TEST(DataTest, StreamingRandomSamplerYieldsEachIndexExactlyOnce) {
+  const size_t size = 257;
+  samplers::StreamingRandomSampler sampler(size);
+  std::vector<bool> seen(size, false);
+  while (auto batch = sampler.next(10)) {
+    for (auto i : batch.value()) {
+      ASSERT_LT(i, size);
+      ASSERT_FALSE(seen[i]);
+      seen[i] = true;
+    }
+  }
+  ASSERT_TRUE(std::all_of(
+      seen.begin(), seen.end(), [](bool visited) { return visited; }));
+}
+
+TEST(DataTest, StreamingRandomSamplerResetsWell) {
+  samplers::StreamingRandomSampler sampler(5);
+  ASSERT_EQ(sampler.next(5).value().size(), 5);
+  ASSERT_FALSE(sampler.next(2).has_value());
+  sampler.reset();
+  ASSERT_EQ(sampler.next(5).value().size(), 5);
+  ASSERT_FALSE(sampler.next(2).has_value());
+  sampler.reset(7);
+  ASSERT_EQ(sampler.next(7).value().size(), 7);
+  ASSERT_FALSE(sampler.next(2).has_value());
+}
+
+TEST(DataTest, SavingAndLoadingStreamingRandomSamplerYieldsSameSequence) {
+  samplers::StreamingRandomSampler a(10);
+  a.next(3);
+  ASSERT_EQ(a.index(), 3);
+
+  std::stringstream stream;
+  torch::save(a, stream);
+
+  samplers::StreamingRandomSampler b(10);
+  torch::load(b, stream);
+  ASSERT_EQ(b.index(), 3);
+
+  auto b_sequence = b.next(10).value();
+  ASSERT_EQ(b_sequence.size(), 7);
+  ASSERT_EQ(a.next(10).value(), b_sequence);
+}
+
 TEST(DataTest, StreamSamplerReturnsTheBatchSizeAndThenRemainder) {
   samplers::StreamSampler sampler(/*epoch_size=*/100);
   ASSERT_EQ(sampler.next(10).value(), 10);
@@ -450,6 +494,35 @@ TEST(DataTest, TensorDatasetConstructsFromInitializerListOfTensors) {
       torch::tensor({0, 0, 1, 0, 0}, torch::kFloat32).allclose(dataset.get(2)));
 }
 
+TEST(DataTest, PackedDatasetRoundTrips) {
+  auto tempfile = c10::make_tempfile();
+  datasets::PackedDatasetWriter writer(tempfile.name);
+  for (size_t i = 0; i < 5; ++i) {
+    writer.write(
+        {torch::full({2, 3}, static_cast<int64_t>(i), torch::kFloat32),
+         torch::full({1}, static_cast<int64_t>(i), torch::kInt64)});
+  }
+  writer.finish();
+
+  datasets::PackedDataset dataset(tempfile.name);
+  ASSERT_EQ(dataset.size().value(), 5);
+  for (size_t i = 0; i < 5; ++i) {
+    Example<> example = dataset.get(i);
+    ASSERT_TRUE(example.data.allclose(
+        torch::full({2, 3}, static_cast<int64_t>(i), torch::kFloat32)));
+    ASSERT_EQ(example.target.item<int64_t>(), static_cast<int64_t>(i));
+  }
+}
+
+TEST(DataTest, PackedDatasetWriterChecksExampleShapes) {
+  auto tempfile = c10::make_tempfile();
+  datasets::PackedDatasetWriter writer(tempfile.name);
+  writer.write({torch::ones({2, 3}), torch::zeros({1})});
+  ASSERT_THROWS_WITH(
+      writer.write({torch::ones({3, 2}), torch::zeros({1})}),
+      "same shapes and dtypes");
+}
+
 TEST(DataTest, StackTransformWorksForExample) {
   struct D : public datasets::Dataset<D> {
     Example<> get(size_t index) override {
@@ -1690,6 +1763,56 @@ TEST(DataLoaderTest, ChunkDataSetGetBatch) {
   }
 }
 
+// Verifies that enabling the chunk read-ahead stage still returns every
+// example exactly once, across epoch boundaries.
+TEST(DataLoaderTest, ChunkDataSetWithChunkPrefetch) {
+  const size_t preloader_count = 2;
+  const size_t batch_size = 5;
+  const size_t cache_size = 2048;
+  const size_t cross_chunk_shuffle_count = 1;
+  const size_t prefetch_chunk_count = 2;
+  const size_t total_example_count = 35;
+  const int epoch_count = 2;
+
+  DummyChunkDataReader data_reader;
+  samplers::SequentialSampler sampler(0);
+
+  datasets::SharedBatchDataset<datasets::ChunkDataset<
+      DummyChunkDataReader,
+      samplers::SequentialSampler,
+      samplers::SequentialSampler>>
+      dataset = datasets::make_shared_dataset<datasets::ChunkDataset<
+          DummyChunkDataReader,
+          samplers::SequentialSampler,
+          samplers::SequentialSampler>>(
+          data_reader,
+          sampler,
+          sampler,
+          datasets::ChunkDatasetOptions(
+              preloader_count,
+              batch_size,
+              cache_size,
+              cross_chunk_shuffle_count,
+              prefetch_chunk_count));
+
+  auto data_loader = torch::data::make_data_loader(
+      dataset, DataLoaderOptions(batch_size).workers(0));
+
+  for (int epoch_index = 0; epoch_index < epoch_count; ++epoch_index) {
+    std::vector<bool> result(total_example_count, false);
+    for (auto iterator = data_loader->begin(); iterator != data_loader->end();
+         ++iterator) {
+      DummyChunkDataReader::BatchType& batch = *iterator;
+      for (size_t j = 0; j < batch.size(); ++j) {
+        result[batch[j]] = true;
+      }
+    }
+    for (auto data : result) {
+      ASSERT_EQ(data, true);
+    }
+  }
+}
+
 TEST(DataLoaderTest, ChunkDataSetWithBatchSizeMismatch) {
   const size_t prefetch_count = 1;
   const size_t batch_size = 5;
@@ -71,6 +71,35 @@ TEST_F(ModuleTest, ZeroGradWithUndefined) {
   ASSERT_EQ(module.x.grad().sum().item<float>(), 0);
 }
 
+TEST_F(ModuleTest, FlattenParameters) {
+  Linear module(3, 4);
+  std::vector<torch::Tensor> before;
+  for (auto& parameter : module->parameters()) {
+    before.push_back(parameter.clone());
+  }
+
+  auto flats = module->flatten_parameters();
+  ASSERT_EQ(flats.size(), 1);
+  ASSERT_EQ(flats[0].numel(), 4 * 3 + 4);
+
+  // Values are preserved and the parameters now view the flat tensor.
+  size_t i = 0;
+  for (auto& parameter : module->parameters()) {
+    ASSERT_TRUE(parameter.allclose(before[i++]));
+  }
+  flats[0].zero_();
+  for (auto& parameter : module->parameters()) {
+    ASSERT_EQ(parameter.abs().sum().item<float>(), 0);
+  }
+
+  // Autograd still reaches the re-seated parameters.
+  auto loss = module(torch::ones({2, 3})).sum();
+  loss.backward();
+  for (auto& parameter : module->parameters()) {
+    ASSERT_TRUE(parameter.grad().defined());
+  }
+}
+
 TEST_F(ModuleTest, RegisterModuleThrowsForEmptyOrDottedName) {
   struct TestModel : public torch::nn::Module {};
   ASSERT_THROWS_WITH(
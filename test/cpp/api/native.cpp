@@ -0,0 +1,509 @@
+#include <gtest/gtest.h>
+
+#include <torch/torch.h>
+
+#include <test/cpp/common/support.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Tests for ATen native ops that have no module wrapper and are exercised
+// directly through the C++ API.
+
+namespace {
+
+// The unfused composition cross_entropy_loss falls back to; the fused CPU
+// kernel must be indistinguishable from it.
+torch::Tensor reference_cross_entropy(
+    const torch::Tensor& input,
+    const torch::Tensor& target,
+    const torch::Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  return at::nll_loss(
+      at::log_softmax(input, 1), target, weight, reduction, ignore_index);
+}
+
+} // namespace
+
+TEST(CrossEntropyLossTest, MatchesComposition) {
+  torch::manual_seed(0);
+  for (auto dtype : {torch::kFloat, torch::kDouble}) {
+    for (int64_t reduction :
+         {at::Reduction::None, at::Reduction::Mean, at::Reduction::Sum}) {
+      for (bool with_weight : {false, true}) {
+        for (int64_t ignore_index : {-100, 1}) {
+          auto input = torch::randn({7, 5}, dtype);
+          auto target = torch::randint(0, 5, {7}, torch::kLong);
+          // Make sure a positive ignore_index actually hits some rows.
+          target[2] = 1;
+          target[5] = 1;
+          torch::Tensor weight;
+          if (with_weight) {
+            weight = torch::rand({5}, dtype) + 0.1;
+          }
+          auto fused = at::cross_entropy_loss(
+              input, target, weight, reduction, ignore_index);
+          auto ref = reference_cross_entropy(
+              input, target, weight, reduction, ignore_index);
+          ASSERT_EQ(fused.sizes(), ref.sizes());
+          ASSERT_TRUE(torch::allclose(fused, ref, 1e-4, 1e-6));
+        }
+      }
+    }
+  }
+}
+
+TEST(CrossEntropyLossTest, BackwardMatchesComposition) {
+  torch::manual_seed(1);
+  for (int64_t reduction :
+       {at::Reduction::None, at::Reduction::Mean, at::Reduction::Sum}) {
+    for (bool with_weight : {false, true}) {
+      auto base = torch::randn({6, 4}, torch::kDouble);
+      auto target = torch::randint(0, 4, {6}, torch::kLong);
+      // Two ignored rows, so the weighted-mean normalizer differs from the
+      // batch size.
+      const int64_t ignore_index = 2;
+      target[1] = ignore_index;
+      target[4] = ignore_index;
+      torch::Tensor weight;
+      if (with_weight) {
+        weight = torch::rand({4}, torch::kDouble) + 0.1;
+      }
+      auto x_fused = base.clone().requires_grad_(true);
+      auto x_ref = base.clone().requires_grad_(true);
+      auto fused = at::cross_entropy_loss(
+          x_fused, target, weight, reduction, ignore_index);
+      auto ref = reference_cross_entropy(
+          x_ref, target, weight, reduction, ignore_index);
+      fused.sum().backward();
+      ref.sum().backward();
+      ASSERT_TRUE(torch::allclose(x_fused.grad(), x_ref.grad(), 1e-10, 1e-12));
+    }
+  }
+}
+
+TEST(CrossEntropyLossTest, BackwardMatchesNumericGradient) {
+  torch::manual_seed(2);
+  // Weighted mean is the formulation where a hand-written fused backward
+  // goes wrong silently: the normalizer is the total target weight, not
+  // the batch size.
+  auto input = torch::randn({4, 3}, torch::kDouble);
+  auto target = torch::randint(0, 3, {4}, torch::kLong);
+  auto weight = torch::rand({3}, torch::kDouble) + 0.1;
+  auto x = input.clone().requires_grad_(true);
+  at::cross_entropy_loss(x, target, weight, at::Reduction::Mean, -100)
+      .backward();
+  const double h = 1e-6;
+  auto numeric = torch::zeros_like(input);
+  for (int64_t i = 0; i < input.size(0); ++i) {
+    for (int64_t j = 0; j < input.size(1); ++j) {
+      auto plus = input.clone();
+      auto minus = input.clone();
+      plus[i][j] += h;
+      minus[i][j] -= h;
+      auto delta =
+          at::cross_entropy_loss(
+              plus, target, weight, at::Reduction::Mean, -100) -
+          at::cross_entropy_loss(
+              minus, target, weight, at::Reduction::Mean, -100);
+      numeric[i][j] = delta.item<double>() / (2 * h);
+    }
+  }
+  ASSERT_TRUE(torch::allclose(x.grad(), numeric, 1e-5, 1e-7));
+}
+
+TEST(CrossEntropyLossTest, AllRowsIgnored) {
+  // total_weight == 0: the mean stays undivided (see #15870 in LossNLL),
+  // and every gradient is zero. The fused kernel must match the
+  // composition bit for bit here.
+  auto input = torch::randn({3, 4}, torch::kDouble);
+  auto target = torch::full({3}, 3, torch::kLong);
+  const int64_t ignore_index = 3;
+  for (int64_t reduction : {at::Reduction::Mean, at::Reduction::Sum}) {
+    auto x_fused = input.clone().requires_grad_(true);
+    auto x_ref = input.clone().requires_grad_(true);
+    auto fused = at::cross_entropy_loss(
+        x_fused, target, {}, reduction, ignore_index);
+    auto ref = reference_cross_entropy(
+        x_ref, target, {}, reduction, ignore_index);
+    ASSERT_TRUE(at::allclose(fused, ref, 1e-12, 1e-12, /*equal_nan=*/true));
+    fused.backward();
+    ref.backward();
+    ASSERT_TRUE(torch::allclose(x_fused.grad(), x_ref.grad()));
+    ASSERT_TRUE(
+        torch::allclose(x_fused.grad(), torch::zeros_like(input)));
+  }
+}
+
+TEST(PadSequenceTest, MatchesNarrowCopyComposition) {
+  torch::manual_seed(3);
+  for (bool batch_first : {false, true}) {
+    std::vector<torch::Tensor> sequences = {
+        torch::randn({5, 2}), torch::randn({1, 2}), torch::randn({3, 2})};
+    const double padding_value = -7.0;
+    auto padded = at::pad_sequence(sequences, batch_first, padding_value);
+    // The loop of narrow + copy_ calls the native op replaced.
+    auto expected = torch::full(
+        batch_first ? std::vector<int64_t>{3, 5, 2}
+                    : std::vector<int64_t>{5, 3, 2},
+        padding_value);
+    for (size_t i = 0; i < sequences.size(); ++i) {
+      const int64_t length = sequences[i].size(0);
+      if (batch_first) {
+        expected[i].narrow(0, 0, length).copy_(sequences[i]);
+      } else {
+        expected.narrow(1, i, 1).narrow(0, 0, length).copy_(
+            sequences[i].unsqueeze(1));
+      }
+    }
+    ASSERT_TRUE(padded.equal(expected));
+  }
+}
+
+TEST(PadSequenceTest, RoundTripRestoresSequences) {
+  torch::manual_seed(4);
+  // Uneven lengths including a zero-length sequence, with and without
+  // trailing dimensions.
+  for (bool batch_first : {false, true}) {
+    for (bool with_trailing : {false, true}) {
+      std::vector<torch::Tensor> sequences;
+      for (int64_t length : {4, 0, 7, 1}) {
+        sequences.push_back(
+            with_trailing ? torch::randn({length, 2, 3})
+                          : torch::randn({length}));
+      }
+      auto lengths = torch::tensor({4, 0, 7, 1}, torch::kLong);
+      auto padded = at::pad_sequence(sequences, batch_first, 0.0);
+      auto unpadded = at::unpad_sequence(padded, lengths, batch_first);
+      ASSERT_EQ(unpadded.size(), sequences.size());
+      for (size_t i = 0; i < sequences.size(); ++i) {
+        ASSERT_EQ(unpadded[i].sizes(), sequences[i].sizes());
+        ASSERT_TRUE(unpadded[i].equal(sequences[i]));
+      }
+    }
+  }
+}
+
+TEST(RollingWindowTest, MatchesUnfoldComposition) {
+  torch::manual_seed(5);
+  auto input = torch::randn({3, 17}, torch::kDouble);
+  for (int64_t dim : {0, 1, -1}) {
+    const int64_t n = input.size(dim);
+    for (int64_t window : {int64_t(1), int64_t(2), int64_t(5), n}) {
+      if (window > n) {
+        continue;
+      }
+      auto unfolded = input.unfold(dim < 0 ? input.dim() + dim : dim, window, 1);
+      ASSERT_TRUE(at::rolling_sum(input, window, dim)
+                      .allclose(unfolded.sum(-1), 1e-12, 1e-12));
+      ASSERT_TRUE(at::rolling_mean(input, window, dim)
+                      .allclose(unfolded.mean(-1), 1e-12, 1e-12));
+      ASSERT_TRUE(at::rolling_max(input, window, dim)
+                      .equal(std::get<0>(unfolded.max(-1))));
+    }
+  }
+  // Integer sum/max are exact.
+  auto ints = torch::randint(-50, 50, {4, 9}, torch::kLong);
+  ASSERT_TRUE(
+      at::rolling_sum(ints, 3, 1).equal(ints.unfold(1, 3, 1).sum(-1)));
+  ASSERT_TRUE(at::rolling_max(ints, 3, 1).equal(
+      std::get<0>(ints.unfold(1, 3, 1).max(-1))));
+}
+
+TEST(RollingWindowTest, WindowEdgeCases) {
+  auto input = torch::randn({11}, torch::kDouble);
+  // A window of 1 reduces nothing.
+  ASSERT_TRUE(at::rolling_sum(input, 1, 0).allclose(input, 1e-12, 1e-12));
+  ASSERT_TRUE(at::rolling_max(input, 1, 0).equal(input));
+  // A window covering the whole dimension leaves a single output.
+  auto whole = at::rolling_sum(input, 11, 0);
+  ASSERT_EQ(whole.numel(), 1);
+  ASSERT_TRUE(whole.allclose(input.sum().reshape({1}), 1e-12, 1e-12));
+  // A window larger than the dimension is rejected.
+  ASSERT_THROWS_WITH(
+      at::rolling_sum(input, 12, 0), "is larger than dimension");
+  ASSERT_THROWS_WITH(
+      at::rolling_max(input, 12, 0), "is larger than dimension");
+}
+
+TEST(RollingWindowTest, SlidingSumDriftStaysBounded) {
+  torch::manual_seed(6);
+  // The add/subtract recurrence accumulates rounding error along the row;
+  // the widened (double) accumulator must keep float results close to an
+  // exact reference over a long row of large-magnitude values.
+  auto base = torch::randn({1, 4096}, torch::kDouble) * 1e3;
+  auto input = base.to(torch::kFloat);
+  const int64_t window = 7;
+  auto reference =
+      input.to(torch::kDouble).unfold(1, window, 1).sum(-1).to(torch::kFloat);
+  ASSERT_TRUE(at::rolling_sum(input, window, 1).allclose(reference, 1e-4, 1e-2));
+}
+
+TEST(FastGeluTest, BackwardMatchesNumericGradient) {
+  auto base = torch::linspace(-5, 5, 41, torch::kDouble);
+  auto x = base.clone().requires_grad_(true);
+  at::fast_gelu(x).sum().backward();
+  const double h = 1e-6;
+  auto numeric = (at::fast_gelu(base + h) - at::fast_gelu(base - h)) / (2 * h);
+  ASSERT_TRUE(torch::allclose(x.grad(), numeric, 1e-6, 1e-8));
+  // The explicit backward native is what the derivative dispatches to.
+  auto direct = at::fast_gelu_backward(torch::ones_like(base), base);
+  ASSERT_TRUE(torch::allclose(direct, numeric, 1e-6, 1e-8));
+}
+
+TEST(FastGeluTest, VectorizedKernelsMatchDoubleReference) {
+  torch::manual_seed(7);
+  // Large enough to exercise the Vec256 lanes, not just the scalar tail.
+  auto x = torch::randn({1237}, torch::kDouble) * 3;
+  auto grad = torch::randn({1237}, torch::kDouble);
+  auto xf = x.to(torch::kFloat);
+  auto gradf = grad.to(torch::kFloat);
+  ASSERT_TRUE(at::fast_gelu(xf).allclose(
+      at::fast_gelu(x).to(torch::kFloat), 1e-5, 1e-6));
+  ASSERT_TRUE(at::fast_gelu_backward(gradf, xf).allclose(
+      at::fast_gelu_backward(grad, x).to(torch::kFloat), 1e-4, 1e-5));
+}
+
+TEST(FastGeluTest, StaysCloseToExactGelu) {
+  for (auto dtype : {torch::kFloat, torch::kDouble}) {
+    auto x = torch::linspace(-5, 5, 1001, dtype);
+    auto forward_gap =
+        (at::fast_gelu(x) - at::gelu(x)).abs().max().item<double>();
+    ASSERT_LT(forward_gap, 3e-3);
+    auto grad = torch::ones_like(x);
+    auto backward_gap = (at::fast_gelu_backward(grad, x) -
+                         at::gelu_backward(grad, x))
+                            .abs()
+                            .max()
+                            .item<double>();
+    ASSERT_LT(backward_gap, 1e-2);
+  }
+}
+
+namespace {
+
+// The full-softmax attention the streamed op must be indistinguishable
+// from.
+torch::Tensor reference_attention(
+    const torch::Tensor& query,
+    const torch::Tensor& key,
+    const torch::Tensor& value,
+    double scale) {
+  auto scores = at::bmm(query, key.transpose(1, 2)) * scale;
+  return at::bmm(at::softmax(scores, 2), value);
+}
+
+} // namespace
+
+TEST(FusedAttentionTest, MatchesFullSoftmax) {
+  torch::manual_seed(8);
+  auto query = torch::randn({2, 5, 4}, torch::kDouble);
+  auto key = torch::randn({2, 13, 4}, torch::kDouble);
+  auto value = torch::randn({2, 13, 3}, torch::kDouble);
+  const double scale = 0.5;
+  auto expected = reference_attention(query, key, value, scale);
+  // Block sizes that divide the key length, that do not, and that exceed
+  // it (a single block, so no rescaling ever fires).
+  for (int64_t key_block_size : {1, 4, 13, 64}) {
+    auto actual =
+        at::fused_attention(query, key, value, scale, key_block_size);
+    ASSERT_TRUE(actual.allclose(expected, 1e-12, 1e-12));
+  }
+}
+
+TEST(FusedAttentionTest, BackwardMatchesFullSoftmax) {
+  torch::manual_seed(9);
+  // Regression test: the streamed accumulator updates used to be
+  // in-place, and backward raised "modified by an inplace operation" on
+  // any grad-requiring input. A block size of 4 over 13 keys makes the
+  // rescaling path run several times.
+  auto query = torch::randn({2, 5, 4}, torch::kDouble);
+  auto key = torch::randn({2, 13, 4}, torch::kDouble);
+  auto value = torch::randn({2, 13, 3}, torch::kDouble);
+  const double scale = 0.5;
+  auto q_fused = query.clone().requires_grad_(true);
+  auto k_fused = key.clone().requires_grad_(true);
+  auto v_fused = value.clone().requires_grad_(true);
+  auto q_ref = query.clone().requires_grad_(true);
+  auto k_ref = key.clone().requires_grad_(true);
+  auto v_ref = value.clone().requires_grad_(true);
+  auto fused = at::fused_attention(q_fused, k_fused, v_fused, scale, 4);
+  auto ref = reference_attention(q_ref, k_ref, v_ref, scale);
+  auto grad_output = torch::randn({2, 5, 3}, torch::kDouble);
+  fused.backward(grad_output);
+  ref.backward(grad_output);
+  ASSERT_TRUE(q_fused.grad().allclose(q_ref.grad(), 1e-10, 1e-12));
+  ASSERT_TRUE(k_fused.grad().allclose(k_ref.grad(), 1e-10, 1e-12));
+  ASSERT_TRUE(v_fused.grad().allclose(v_ref.grad(), 1e-10, 1e-12));
+}
+
+namespace {
+
+// Element-by-element check of searchsorted against the std algorithms it
+// promises to match: lower_bound for right=false, upper_bound for
+// right=true.
+template <typename scalar_t>
+void check_searchsorted_against_std(
+    const std::vector<scalar_t>& boundaries,
+    const std::vector<scalar_t>& values,
+    const torch::Tensor& boundary_tensor,
+    const torch::Tensor& value_tensor) {
+  for (bool right : {false, true}) {
+    auto result = at::searchsorted(boundary_tensor, value_tensor, false, right);
+    ASSERT_EQ(result.scalar_type(), torch::kLong);
+    for (size_t i = 0; i < values.size(); ++i) {
+      const int64_t expected = right
+          ? std::upper_bound(boundaries.begin(), boundaries.end(), values[i]) -
+              boundaries.begin()
+          : std::lower_bound(boundaries.begin(), boundaries.end(), values[i]) -
+              boundaries.begin();
+      ASSERT_EQ(result[i].item<int64_t>(), expected);
+    }
+    ASSERT_TRUE(
+        at::bucketize(value_tensor, boundary_tensor, false, right)
+            .equal(result));
+  }
+}
+
+} // namespace
+
+TEST(SearchSortedTest, MatchesStdLowerUpperBound) {
+  // Duplicated boundaries and values hitting them exactly are where the
+  // off-by-one mistakes live.
+  std::vector<double> boundaries = {1.0, 2.0, 2.0, 3.0, 5.0, 8.0};
+  std::vector<double> values = {0.5, 1.0, 2.0, 2.5, 3.0, 5.0, 8.0, 9.0};
+  check_searchsorted_against_std(
+      boundaries,
+      values,
+      torch::tensor(boundaries, torch::kDouble),
+      torch::tensor(values, torch::kDouble));
+
+  std::vector<int64_t> int_boundaries = {-3, 0, 0, 0, 4, 7};
+  std::vector<int64_t> int_values = {-4, -3, 0, 1, 4, 7, 8};
+  check_searchsorted_against_std(
+      int_boundaries,
+      int_values,
+      torch::tensor(int_boundaries, torch::kLong),
+      torch::tensor(int_values, torch::kLong));
+
+  // Scalar overloads take the same path.
+  auto bt = torch::tensor(boundaries, torch::kDouble);
+  ASSERT_EQ(at::searchsorted(bt, 2.0, false, false).item<int64_t>(), 1);
+  ASSERT_EQ(at::searchsorted(bt, 2.0, false, true).item<int64_t>(), 3);
+  ASSERT_EQ(at::bucketize(2.0, bt, false, true).item<int64_t>(), 3);
+}
+
+TEST(SearchSortedTest, NanSortsToTheEnd) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  // NaN values to search for, and NaN boundaries (which sort to the end
+  // under operator<): both must match the std algorithms exactly.
+  std::vector<double> boundaries = {1.0, 2.0, 3.0};
+  std::vector<double> values = {nan, 2.0};
+  check_searchsorted_against_std(
+      boundaries,
+      values,
+      torch::tensor(boundaries, torch::kDouble),
+      torch::tensor(values, torch::kDouble));
+
+  std::vector<double> nan_boundaries = {1.0, 2.0, nan, nan};
+  std::vector<double> plain_values = {0.0, 2.0, 5.0};
+  check_searchsorted_against_std(
+      nan_boundaries,
+      plain_values,
+      torch::tensor(nan_boundaries, torch::kDouble),
+      torch::tensor(plain_values, torch::kDouble));
+}
+
+TEST(SearchSortedTest, EmptyBoundaries) {
+  auto empty = torch::empty({0}, torch::kDouble);
+  auto values = torch::tensor(std::vector<double>{-1.0, 0.0, 3.0});
+  for (bool right : {false, true}) {
+    auto result = at::searchsorted(empty.to(values.dtype()), values, false, right);
+    ASSERT_TRUE(result.equal(torch::zeros({3}, torch::kLong)));
+    ASSERT_TRUE(at::bucketize(values, empty.to(values.dtype()), false, right)
+                    .equal(result));
+  }
+}
+
+TEST(SearchSortedTest, PerRowBoundaries) {
+  // N-D sorted_sequence: one independent boundary row per innermost
+  // slice of the input.
+  std::vector<double> row0 = {1.0, 3.0, 5.0, 7.0};
+  std::vector<double> row1 = {2.0, 4.0, 6.0, 8.0};
+  auto sequence = torch::stack(
+      {torch::tensor(row0, torch::kDouble), torch::tensor(row1, torch::kDouble)});
+  std::vector<double> in0 = {0.0, 3.0, 9.0};
+  std::vector<double> in1 = {4.0, 4.5, 8.0};
+  auto input = torch::stack(
+      {torch::tensor(in0, torch::kDouble), torch::tensor(in1, torch::kDouble)});
+  for (bool right : {false, true}) {
+    auto result = at::searchsorted(sequence, input, false, right);
+    for (int64_t j = 0; j < 3; ++j) {
+      const auto bound = [&](const std::vector<double>& row, double v) {
+        return right
+            ? std::upper_bound(row.begin(), row.end(), v) - row.begin()
+            : std::lower_bound(row.begin(), row.end(), v) - row.begin();
+      };
+      ASSERT_EQ(result[0][j].item<int64_t>(), bound(row0, in0[j]));
+      ASSERT_EQ(result[1][j].item<int64_t>(), bound(row1, in1[j]));
+    }
+  }
+}
+
+TEST(SearchSortedTest, Int32Output) {
+  auto boundaries = torch::tensor(std::vector<double>{1.0, 2.0, 3.0});
+  auto values = torch::tensor(std::vector<double>{0.0, 2.0, 4.0});
+  auto result32 = at::searchsorted(boundaries, values, true, false);
+  ASSERT_EQ(result32.scalar_type(), torch::kInt);
+  ASSERT_TRUE(result32.to(torch::kLong)
+                  .equal(at::searchsorted(boundaries, values, false, false)));
+  // The out= overload enforces the dtype implied by out_int32.
+  auto out = torch::empty({0}, torch::kLong);
+  ASSERT_THROWS_WITH(
+      at::searchsorted_out(out, boundaries, values, true, false),
+      "output tensor should have dtype");
+}
+
+TEST(PackedBoolTest, RoundTripOverOddSizes) {
+  torch::manual_seed(10);
+  // Lengths straddling the 8-bit byte and the 64-bit popcount word are
+  // where the tail handling breaks.
+  for (int64_t numel : {0, 1, 7, 8, 9, 15, 16, 63, 64, 65, 100, 1000}) {
+    auto mask = torch::randint(0, 2, {numel}).to(torch::kBool);
+    auto packed = at::_pack_bool(mask);
+    ASSERT_EQ(packed.scalar_type(), torch::kByte);
+    ASSERT_EQ(packed.numel(), (numel + 7) / 8);
+    ASSERT_TRUE(at::_unpack_bool(packed, numel).equal(mask));
+
+    const int64_t set = mask.to(torch::kLong).sum().item<int64_t>();
+    ASSERT_EQ(at::_packed_bool_sum(packed, numel).item<int64_t>(), set);
+    // bitwise_not on the packed form sets the tail bits past numel; the
+    // sum must not count them and the unpack must not expose them.
+    auto inverted = at::bitwise_not(packed);
+    ASSERT_EQ(
+        at::_packed_bool_sum(inverted, numel).item<int64_t>(), numel - set);
+    ASSERT_TRUE(
+        at::_unpack_bool(inverted, numel).equal(at::bitwise_not(mask)));
+  }
+}
+
+TEST(PackedBoolTest, FlattensAndComposesPacked) {
+  torch::manual_seed(11);
+  auto a = torch::randint(0, 2, {3, 7}).to(torch::kBool);
+  auto b = torch::randint(0, 2, {3, 7}).to(torch::kBool);
+  const int64_t numel = a.numel();
+  auto pa = at::_pack_bool(a);
+  auto pb = at::_pack_bool(b);
+  // Packing flattens; the caller carries the shape.
+  ASSERT_TRUE(at::_unpack_bool(pa, numel).equal(a.flatten()));
+  // uint8 logical ops on the packed form compose masks eight at a time.
+  ASSERT_TRUE(at::_unpack_bool(at::__and__(pa, pb), numel)
+                  .equal(at::__and__(a, b).flatten()));
+  ASSERT_TRUE(at::_unpack_bool(at::__or__(pa, pb), numel)
+                  .equal(at::__or__(a, b).flatten()));
+  ASSERT_TRUE(at::_unpack_bool(at::__xor__(pa, pb), numel)
+                  .equal(at::__xor__(a, b).flatten()));
+}
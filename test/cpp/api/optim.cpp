@@ -157,6 +157,32 @@ TEST(OptimTest, BasicInterface) {
   }
 }
 
+TEST(OptimTest, AsyncSparseSGD_AppliesSparseUpdates) {
+  torch::manual_seed(0);
+
+  auto weight = torch::randn({10, 4});
+  auto dense = torch::randn({5});
+  auto original_weight = weight.clone();
+  auto original_dense = dense.clone();
+
+  // Row 3 appears twice; coalescing on the applier thread must merge it.
+  auto indices = torch::tensor({3, 1, 3}, torch::kInt64).unsqueeze(0);
+  auto values = torch::ones({3, 4});
+  auto sparse_grad = torch::sparse_coo_tensor(indices, values, {10, 4});
+  weight.grad() = sparse_grad;
+  dense.grad() = torch::ones({5});
+
+  AsyncSparseSGD optimizer(
+      std::vector<torch::Tensor>{weight, dense}, AsyncSparseSGDOptions(0.5));
+  optimizer.step();
+  optimizer.sync();
+  ASSERT_EQ(optimizer.pending(), 0);
+
+  ASSERT_TRUE(weight.allclose(original_weight - 0.5 * sparse_grad.to_dense()));
+  ASSERT_TRUE(weight[0].allclose(original_weight[0]));
+  ASSERT_TRUE(dense.allclose(original_dense - 0.5 * torch::ones({5})));
+}
+
 TEST(OptimTest, XORConvergence_SGD) {
   ASSERT_TRUE(test_optimizer_xor<SGD>(
       SGDOptions(0.1).momentum(0.9).nesterov(true).weight_decay(1e-6)));
@@ -3,8 +3,10 @@
 #include <torch/csrc/autograd/functions/comm.h>
 #include <torch/nn/module.h>
 #include <torch/nn/modules/conv.h>
+#include <torch/nn/modules/container/sequential.h>
 #include <torch/nn/modules/linear.h>
 #include <torch/nn/parallel/data_parallel.h>
+#include <torch/nn/parallel/pipeline.h>
 #include <torch/nn/pimpl.h>
 #include <torch/optim/sgd.h>
 #include <torch/types.h>
@@ -291,3 +293,47 @@ TEST_F(ParallelTest, DataParallelNumericalEquivalence_MultiCUDA) {
       }
     }
 }
+
+TEST_F(ParallelTest, PipelineExplicitBalance) {
+  Sequential sequence(Linear(4, 6), Linear(6, 6), Linear(6, 2));
+  Pipeline pipeline(
+      sequence,
+      PipelineOptions({torch::Device(torch::kCPU), torch::Device(torch::kCPU)})
+          .chunks(3)
+          .balance({2, 1}));
+
+  // The pipeline stages share their layers with `sequence`.
+  ASSERT_EQ(pipeline->parameters().size(), sequence->parameters().size());
+
+  auto input = torch::randn({10, 4}, torch::requires_grad(true));
+  auto output = pipeline->forward(input);
+
+  ASSERT_EQ(output.size(0), 10);
+  ASSERT_EQ(output.size(1), 2);
+  ASSERT_TRUE(output.allclose(sequence->forward(input)));
+
+  output.sum().backward();
+  ASSERT_TRUE(input.grad().defined());
+  ASSERT_EQ(input.grad().sizes(), input.sizes());
+}
+
+TEST_F(ParallelTest, PipelineProfiledBalance) {
+  Sequential sequence(Linear(8, 8), Linear(8, 8), Linear(8, 8), Linear(8, 4));
+  Pipeline pipeline(
+      sequence,
+      PipelineOptions({torch::Device(torch::kCPU), torch::Device(torch::kCPU)})
+          .chunks(2));
+
+  // Without an explicit balance, the partition is derived on first forward.
+  ASSERT_TRUE(pipeline->options.balance().empty());
+
+  auto input = torch::randn({8, 8});
+  auto output = pipeline->forward(input);
+
+  const auto& balance = pipeline->options.balance();
+  ASSERT_EQ(balance.size(), 2);
+  ASSERT_GE(balance[0], 1);
+  ASSERT_GE(balance[1], 1);
+  ASSERT_EQ(balance[0] + balance[1], 4);
+  ASSERT_TRUE(output.allclose(sequence->forward(input)));
+}
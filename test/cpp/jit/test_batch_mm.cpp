@@ -0,0 +1,118 @@
+#include <test/cpp/jit/test_base.h>
+#include <test/cpp/jit/test_utils.h>
+
+#include <torch/csrc/jit/interpreter.h>
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/batch_mm.h>
+
+#include <ATen/ATen.h>
+
+namespace torch {
+namespace jit {
+
+using namespace script;
+
+namespace {
+
+std::vector<IValue> runGraph(
+    const std::shared_ptr<Graph>& graph,
+    std::vector<IValue> stack) {
+  Code code(graph);
+  InterpreterState interp(code);
+  interp.run(stack);
+  return stack;
+}
+
+// Eight mms with pairwise distinct lhs AND rhs operands: no add-tree and no
+// shared side, so only the independent phase can batch them.
+const char* independent_mms = R"IR(
+graph(%a0 : Tensor, %b0 : Tensor, %a1 : Tensor, %b1 : Tensor,
+      %a2 : Tensor, %b2 : Tensor, %a3 : Tensor, %b3 : Tensor,
+      %a4 : Tensor, %b4 : Tensor, %a5 : Tensor, %b5 : Tensor,
+      %a6 : Tensor, %b6 : Tensor, %a7 : Tensor, %b7 : Tensor):
+  %r0 : Tensor = aten::mm(%a0, %b0)
+  %r1 : Tensor = aten::mm(%a1, %b1)
+  %r2 : Tensor = aten::mm(%a2, %b2)
+  %r3 : Tensor = aten::mm(%a3, %b3)
+  %r4 : Tensor = aten::mm(%a4, %b4)
+  %r5 : Tensor = aten::mm(%a5, %b5)
+  %r6 : Tensor = aten::mm(%a6, %b6)
+  %r7 : Tensor = aten::mm(%a7, %b7)
+  return (%r0, %r1, %r2, %r3, %r4, %r5, %r6, %r7)
+)IR";
+
+} // namespace
+
+void testBatchMMIndependent() {
+  // An independent group of 8 mms rewrites to a single MMBatchIndependent
+  // node.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(independent_mms, graph.get());
+    auto reference = graph->copy();
+
+    BatchMM(graph);
+    testing::FileCheck()
+        .check_count("prim::MMBatchIndependent", 1, /*exactly=*/true)
+        ->run(*graph);
+    testing::FileCheck().check_not("aten::mm")->run(*graph);
+
+    // Same runtime shapes everywhere: the operator takes the stack/bmm
+    // path, and every output must match its unbatched counterpart.
+    std::vector<IValue> stack;
+    for (int64_t i = 0; i < 8; ++i) {
+      stack.emplace_back(at::randn({4, 5}));
+      stack.emplace_back(at::randn({5, 3}));
+    }
+    auto expected = runGraph(reference, stack);
+    auto actual = runGraph(graph, stack);
+    AT_ASSERT(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+      AT_ASSERT(actual[i].toTensor().allclose(expected[i].toTensor()));
+    }
+
+    // Different inner dimensions per mm: the runtime shape check fails and
+    // the operator falls back to a plain loop of mms, which is bitwise
+    // identical to the unbatched graph.
+    stack.clear();
+    for (int64_t i = 0; i < 8; ++i) {
+      stack.emplace_back(at::randn({2, 3 + i}));
+      stack.emplace_back(at::randn({3 + i, 4}));
+    }
+    expected = runGraph(reference, stack);
+    actual = runGraph(graph, stack);
+    for (size_t i = 0; i < actual.size(); ++i) {
+      AT_ASSERT(actual[i].toTensor().equal(expected[i].toTensor()));
+    }
+  }
+
+  // Below the batching threshold nothing is rewritten.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%a0 : Tensor, %b0 : Tensor, %a1 : Tensor, %b1 : Tensor,
+      %a2 : Tensor, %b2 : Tensor, %a3 : Tensor, %b3 : Tensor,
+      %a4 : Tensor, %b4 : Tensor, %a5 : Tensor, %b5 : Tensor,
+      %a6 : Tensor, %b6 : Tensor):
+  %r0 : Tensor = aten::mm(%a0, %b0)
+  %r1 : Tensor = aten::mm(%a1, %b1)
+  %r2 : Tensor = aten::mm(%a2, %b2)
+  %r3 : Tensor = aten::mm(%a3, %b3)
+  %r4 : Tensor = aten::mm(%a4, %b4)
+  %r5 : Tensor = aten::mm(%a5, %b5)
+  %r6 : Tensor = aten::mm(%a6, %b6)
+  return (%r0, %r1, %r2, %r3, %r4, %r5, %r6)
+)IR",
+        graph.get());
+    BatchMM(graph);
+    testing::FileCheck().check_not("prim::MMBatchIndependent")->run(*graph);
+    testing::FileCheck()
+        .check_count("aten::mm", 7, /*exactly=*/true)
+        ->run(*graph);
+  }
+}
+
+} // namespace jit
+} // namespace torch
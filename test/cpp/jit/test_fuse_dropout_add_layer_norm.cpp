@@ -0,0 +1,162 @@
+#include <test/cpp/jit/test_base.h>
+#include <test/cpp/jit/test_utils.h>
+
+#include <torch/csrc/jit/interpreter.h>
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/fuse_dropout_add_layer_norm.h>
+
+#include <ATen/ATen.h>
+
+namespace torch {
+namespace jit {
+
+using namespace script;
+
+namespace {
+
+// dropout -> add -> layer_norm chain; `alpha_value` and `add_order_swapped`
+// produce the near-miss and residual-on-the-left variants.
+std::string chainGraph(int alpha_value, bool add_order_swapped) {
+  std::string add_args =
+      add_order_swapped ? "%residual, %dropped" : "%dropped, %residual";
+  return R"IR(
+graph(%input : Tensor, %residual : Tensor, %weight : Tensor, %bias : Tensor):
+  %dim : int = prim::Constant[value=8]()
+  %shape : int[] = prim::ListConstruct(%dim)
+  %p : float = prim::Constant[value=0.5]()
+  %train : bool = prim::Constant[value=0]()
+  %eps : float = prim::Constant[value=0.001]()
+  %alpha : int = prim::Constant[value=)IR" +
+      std::to_string(alpha_value) + R"IR(]()
+  %cudnn : bool = prim::Constant[value=0]()
+  %dropped : Tensor = aten::dropout(%input, %p, %train)
+  %added : Tensor = aten::add()IR" +
+      add_args + R"IR(, %alpha)
+  %res : Tensor = aten::layer_norm(%added, %shape, %weight, %bias, %eps, %cudnn)
+  return (%res)
+)IR";
+}
+
+std::vector<IValue> runGraph(
+    const std::shared_ptr<Graph>& graph,
+    std::vector<IValue> stack) {
+  Code code(graph);
+  InterpreterState interp(code);
+  interp.run(stack);
+  return stack;
+}
+
+} // namespace
+
+void testFuseDropoutAddLayerNorm() {
+  // The rewrite fires on the intended pattern, for both add orders, and
+  // the rewritten graph computes the same values as the original.
+  for (bool add_order_swapped : {false, true}) {
+    auto graph = std::make_shared<Graph>();
+    parseIR(chainGraph(/*alpha_value=*/1, add_order_swapped), graph.get());
+
+    auto input = at::randn({4, 8});
+    auto residual = at::randn({4, 8});
+    auto weight = at::randn({8});
+    auto bias = at::randn({8});
+    std::vector<IValue> inputs = {input, residual, weight, bias};
+    // train is false in the graph, so both runs are deterministic.
+    auto unfused_out = runGraph(graph, inputs)[0].toTensor();
+
+    FuseDropoutAddLayerNorm(graph);
+    testing::FileCheck()
+        .check("aten::fused_dropout_add_layer_norm")
+        ->run(*graph);
+    testing::FileCheck()
+        .check_not("aten::dropout")
+        ->check_not("aten::layer_norm(")
+        ->run(*graph);
+
+    auto fused_out = runGraph(graph, inputs)[0].toTensor();
+    AT_ASSERT(fused_out.allclose(unfused_out, 1e-5, 1e-7));
+  }
+
+  // Near miss: the fused op has no alpha argument, so alpha != 1 must not
+  // be rewritten.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(chainGraph(/*alpha_value=*/2, /*add_order_swapped=*/false),
+            graph.get());
+    FuseDropoutAddLayerNorm(graph);
+    testing::FileCheck()
+        .check_not("aten::fused_dropout_add_layer_norm")
+        ->check("aten::dropout")
+        ->run(*graph);
+  }
+
+  // Near miss: the dropout output escapes the pattern, so fusing would
+  // lose a graph output.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%input : Tensor, %residual : Tensor, %weight : Tensor, %bias : Tensor):
+  %dim : int = prim::Constant[value=8]()
+  %shape : int[] = prim::ListConstruct(%dim)
+  %p : float = prim::Constant[value=0.5]()
+  %train : bool = prim::Constant[value=0]()
+  %eps : float = prim::Constant[value=0.001]()
+  %alpha : int = prim::Constant[value=1]()
+  %cudnn : bool = prim::Constant[value=0]()
+  %dropped : Tensor = aten::dropout(%input, %p, %train)
+  %added : Tensor = aten::add(%dropped, %residual, %alpha)
+  %res : Tensor = aten::layer_norm(%added, %shape, %weight, %bias, %eps, %cudnn)
+  return (%res, %dropped)
+)IR",
+        graph.get());
+    FuseDropoutAddLayerNorm(graph);
+    testing::FileCheck()
+        .check_not("aten::fused_dropout_add_layer_norm")
+        ->run(*graph);
+  }
+
+  // Numerics of the fused op itself against the unfused composition in
+  // the deterministic configurations.
+  {
+    auto input = at::randn({4, 8});
+    auto residual = at::randn({4, 8});
+    auto weight = at::randn({8});
+    auto bias = at::randn({8});
+    // eval mode: dropout inactive regardless of p
+    auto fused = at::fused_dropout_add_layer_norm(
+        input, residual, {8}, weight, bias, 1e-5, 0.5, /*train=*/false);
+    auto ref = at::layer_norm(
+        input + residual, {8}, weight, bias, 1e-5, false);
+    AT_ASSERT(fused.allclose(ref, 1e-5, 1e-7));
+    // train mode with p == 0: every element kept, no scaling
+    fused = at::fused_dropout_add_layer_norm(
+        input, residual, {8}, weight, bias, 1e-5, 0.0, /*train=*/true);
+    AT_ASSERT(fused.allclose(ref, 1e-5, 1e-7));
+  }
+
+  // Dropout-active training: reconstruct the layer_norm input from the
+  // mask the native op returns and compare against unfused layer_norm.
+  {
+    const double p = 0.5;
+    auto input = at::randn({16, 8});
+    auto residual = at::randn({16, 8});
+    auto weight = at::randn({8});
+    auto bias = at::randn({8});
+    auto result = at::native_dropout_add_layer_norm(
+        input, residual, weight, bias, /*M=*/16, /*N=*/8, 1e-5, p,
+        /*train=*/true);
+    auto output = std::get<0>(result);
+    auto mask = std::get<1>(result);
+    // The mask must actually drop something (and keep something) at p=0.5
+    // over 128 elements.
+    auto kept = mask.to(at::kLong).sum().item<int64_t>();
+    AT_ASSERT(kept > 0 && kept < mask.numel());
+    auto rebuilt = input * mask.to(input.dtype()) / (1 - p) + residual;
+    auto ref = at::layer_norm(rebuilt, {8}, weight, bias, 1e-5, false);
+    AT_ASSERT(output.allclose(ref, 1e-4, 1e-6));
+  }
+}
+
+} // namespace jit
+} // namespace torch
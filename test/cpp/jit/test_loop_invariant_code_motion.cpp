@@ -0,0 +1,223 @@
+#include <test/cpp/jit/test_base.h>
+#include <test/cpp/jit/test_utils.h>
+
+#include <torch/csrc/jit/interpreter.h>
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/loop_invariant_code_motion.h>
+
+#include <ATen/ATen.h>
+
+namespace torch {
+namespace jit {
+
+using namespace script;
+
+namespace {
+
+std::vector<IValue> runGraph(
+    const std::shared_ptr<Graph>& graph,
+    std::vector<IValue> stack) {
+  Code code(graph);
+  InterpreterState interp(code);
+  interp.run(stack);
+  return stack;
+}
+
+} // namespace
+
+void testLoopInvariantCodeMotion() {
+  // A loop with a constant trip count and start condition is known to run
+  // at least once, so the invariant mul hoists directly above it - no
+  // guard needed - and the hoisted graph computes the same value.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor):
+  %ten : int = prim::Constant[value=10]()
+  %true : bool = prim::Constant[value=1]()
+  %one : int = prim::Constant[value=1]()
+  %y : Tensor = prim::Loop(%ten, %true, %x)
+    block0(%i : int, %acc : Tensor):
+      %inv : Tensor = aten::mul(%x, %x)
+      %acc.next : Tensor = aten::add(%acc, %inv, %one)
+      -> (%true, %acc.next)
+  return (%y)
+)IR",
+        graph.get());
+
+    auto input = at::randn({2, 3});
+    auto reference = graph->copy();
+
+    HoistLoopInvariants(graph);
+    testing::FileCheck()
+        .check("aten::mul")
+        ->check("prim::Loop")
+        ->check("aten::add")
+        ->run(*graph);
+    testing::FileCheck()
+        .check_count("aten::mul(", 1, /*exactly=*/true)
+        ->run(*graph);
+    testing::FileCheck().check_not("prim::If")->run(*graph);
+
+    auto expected = runGraph(reference, {input})[0].toTensor();
+    auto actual = runGraph(graph, {input})[0].toTensor();
+    AT_ASSERT(actual.equal(expected));
+  }
+
+  // With an unknown trip count the loop is peeled behind a
+  // cond && max > 0 guard, so the hoisted mul only runs when the original
+  // body would have. The peeled graph must agree with the original for
+  // zero-trip, single-trip and multi-trip executions.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor, %n : int):
+  %true : bool = prim::Constant[value=1]()
+  %one : int = prim::Constant[value=1]()
+  %y : Tensor = prim::Loop(%n, %true, %x)
+    block0(%i : int, %acc : Tensor):
+      %inv : Tensor = aten::mul(%x, %x)
+      %acc.next : Tensor = aten::add(%acc, %inv, %one)
+      -> (%true, %acc.next)
+  return (%y)
+)IR",
+        graph.get());
+
+    auto reference = graph->copy();
+
+    HoistLoopInvariants(graph);
+    testing::FileCheck()
+        .check("aten::gt")
+        ->check("aten::__and__")
+        ->check("prim::If")
+        ->check("aten::mul")
+        ->check("prim::Loop")
+        ->run(*graph);
+    // The peeled first iteration's mul and the hoisted mul fold into one.
+    testing::FileCheck()
+        .check_count("aten::mul(", 1, /*exactly=*/true)
+        ->run(*graph);
+
+    auto input = at::randn({2, 3});
+    for (int64_t n : {0, 1, 5}) {
+      auto expected = runGraph(reference, {input, n})[0].toTensor();
+      auto actual = runGraph(graph, {input, n})[0].toTensor();
+      AT_ASSERT(actual.equal(expected));
+    }
+  }
+
+  // The body reads the trip counter, and the residual loop's counter
+  // restarts at zero, so its uses must be offset by one. A wrong offset
+  // changes the accumulated value.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor, %n : int):
+  %true : bool = prim::Constant[value=1]()
+  %one : int = prim::Constant[value=1]()
+  %y : Tensor = prim::Loop(%n, %true, %x)
+    block0(%i : int, %acc : Tensor):
+      %inv : Tensor = aten::mul(%x, %x)
+      %scaled : Tensor = aten::mul(%inv, %i)
+      %acc.next : Tensor = aten::add(%acc, %scaled, %one)
+      -> (%true, %acc.next)
+  return (%y)
+)IR",
+        graph.get());
+
+    auto reference = graph->copy();
+
+    HoistLoopInvariants(graph);
+    // The counter offset is the first node of the residual body.
+    testing::FileCheck()
+        .check("prim::If")
+        ->check("prim::Loop")
+        ->check("aten::add(")
+        ->check("aten::mul(")
+        ->run(*graph);
+
+    auto input = at::randn({2, 3});
+    for (int64_t n : {1, 4}) {
+      auto expected = runGraph(reference, {input, n})[0].toTensor();
+      auto actual = runGraph(graph, {input, n})[0].toTensor();
+      AT_ASSERT(actual.equal(expected));
+    }
+  }
+
+  // Must not hoist: the body writes to the mul's input, so the mul's value
+  // changes between iterations.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor):
+  %ten : int = prim::Constant[value=10]()
+  %true : bool = prim::Constant[value=1]()
+  %one : int = prim::Constant[value=1]()
+  %y : Tensor = prim::Loop(%ten, %true, %x)
+    block0(%i : int, %acc : Tensor):
+      %inv : Tensor = aten::mul(%x, %x)
+      %x.next : Tensor = aten::add_(%x, %inv, %one)
+      -> (%true, %x.next)
+  return (%y)
+)IR",
+        graph.get());
+    HoistLoopInvariants(graph);
+    testing::FileCheck().check("prim::Loop")->check("aten::mul")->run(*graph);
+    testing::FileCheck().check_not("prim::If")->run(*graph);
+  }
+
+  // Must not hoist: a metadata query over a tensor that is written inside
+  // the loop body (e.g. the write could resize it).
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor):
+  %ten : int = prim::Constant[value=10]()
+  %true : bool = prim::Constant[value=1]()
+  %one : int = prim::Constant[value=1]()
+  %y : Tensor = prim::Loop(%ten, %true, %x)
+    block0(%i : int, %acc : Tensor):
+      %d : int = aten::dim(%x)
+      %acc.next : Tensor = aten::add(%acc, %d, %one)
+      %x.next : Tensor = aten::add_(%x, %one, %one)
+      -> (%true, %acc.next)
+  return (%y)
+)IR",
+        graph.get());
+    HoistLoopInvariants(graph);
+    testing::FileCheck().check("prim::Loop")->check("aten::dim")->run(*graph);
+  }
+
+  // But a write to the queried tensor outside the loop does not pin the
+  // query: metadata only depends on the tensor's shape, which the loop
+  // never changes here.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor):
+  %ten : int = prim::Constant[value=10]()
+  %true : bool = prim::Constant[value=1]()
+  %one : int = prim::Constant[value=1]()
+  %y : Tensor = prim::Loop(%ten, %true, %x)
+    block0(%i : int, %acc : Tensor):
+      %d : int = aten::dim(%x)
+      %acc.next : Tensor = aten::add(%acc, %d, %one)
+      -> (%true, %acc.next)
+  %x.post : Tensor = aten::add_(%x, %one, %one)
+  return (%y)
+)IR",
+        graph.get());
+    HoistLoopInvariants(graph);
+    testing::FileCheck().check("aten::dim")->check("prim::Loop")->run(*graph);
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -962,6 +962,31 @@ void testModuleDefine() {
   AT_ASSERT(result.toTensor().item<float>() == 6);
 }
 
+void testModuleRunAsync() {
+  script::Module m("m");
+  m.register_parameter("foo", torch::ones({}), false);
+  m.define(R"(
+    def add_it(self, x, b : int = 4):
+      return self.foo + x + b
+    def fail(self, x):
+      return x.mm(x)
+  )");
+  auto future = m.run_method_async("add_it", torch::ones({}));
+  future->wait();
+  AT_ASSERT(future->value().toTensor().item<float>() == 6);
+
+  // errors thrown on the inter-op pool are rethrown from value()
+  auto bad = m.run_method_async("fail", torch::ones({}));
+  bad->wait();
+  bool threw = false;
+  try {
+    bad->value();
+  } catch (const std::exception& e) {
+    threw = true;
+  }
+  AT_ASSERT(threw);
+}
+
 void testModuleConversion() {
   script::Module m("test");
   {
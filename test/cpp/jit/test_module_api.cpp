@@ -41,5 +41,41 @@ void testModuleCloneInstance() {
   ASSERT_EQ(m3.attr(attr_name).toInt(), 3);
 }
 
+void testModuleSnapshot() {
+  auto cu = std::make_shared<CompilationUnit>();
+  auto child_cls = ClassType::create("foo.child", cu, true);
+  Module child(cu, child_cls);
+  auto weight = torch::ones({2, 2});
+  child.register_parameter("weight", weight, false);
+
+  auto cls = ClassType::create("foo.parent", cu, true);
+  Module m(cu, cls);
+  m.register_attribute("version", IntType::get(), IValue(1), false);
+  m.register_module("child", child);
+
+  Module s = m.snapshot();
+  // The snapshot shares the type and the attribute values...
+  ASSERT_EQ(m.type(), s.type());
+  ASSERT_EQ(s.attr("version").toInt(), 1);
+  ASSERT_TRUE(s.attr("child")
+                  .toModule()
+                  .attr("weight")
+                  .toTensor()
+                  .is_same(weight));
+
+  // ...but attribute assignments on the original, including on submodules,
+  // are not visible to the snapshot.
+  m.setattr("version", IValue(2));
+  Module(m.attr("child").toObject())
+      .setattr("weight", torch::zeros({2, 2}));
+  ASSERT_EQ(m.attr("version").toInt(), 2);
+  ASSERT_EQ(s.attr("version").toInt(), 1);
+  ASSERT_TRUE(s.attr("child")
+                  .toModule()
+                  .attr("weight")
+                  .toTensor()
+                  .is_same(weight));
+}
+
 } // namespace jit
 } // namespace torch
@@ -0,0 +1,139 @@
+#include <test/cpp/jit/test_base.h>
+#include <test/cpp/jit/test_utils.h>
+
+#include <torch/csrc/jit/interpreter.h>
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/rewrite_inplace_ops.h>
+
+#include <ATen/ATen.h>
+
+namespace torch {
+namespace jit {
+
+using namespace script;
+
+namespace {
+
+std::vector<IValue> runGraph(
+    const std::shared_ptr<Graph>& graph,
+    std::vector<IValue> stack) {
+  Code code(graph);
+  InterpreterState interp(code);
+  interp.run(stack);
+  return stack;
+}
+
+} // namespace
+
+void testRewriteInplaceOps() {
+  // Rewrites fire on dead intermediates but never on values aliasing a
+  // graph input, and the rewritten graph computes the same values.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor):
+  %one : int = prim::Constant[value=1]()
+  %a : Tensor = aten::mul(%x, %x)
+  %b : Tensor = aten::relu(%a)
+  %c : Tensor = aten::add(%b, %x, %one)
+  return (%c)
+)IR",
+        graph.get());
+
+    auto input = at::randn({2, 3});
+    auto input_snapshot = input.clone();
+    auto expected = runGraph(graph, {input})[0].toTensor();
+
+    RewriteInplaceOps(graph);
+    // mul's self is the graph input, so it must stay functional; %a and
+    // %b both die at their single use, so relu and add become in-place.
+    testing::FileCheck()
+        .check("aten::mul(")
+        ->check("aten::relu_")
+        ->check("aten::add_")
+        ->run(*graph);
+    testing::FileCheck().check_not("aten::mul_")->run(*graph);
+
+    auto actual = runGraph(graph, {input})[0].toTensor();
+    AT_ASSERT(actual.equal(expected));
+    // The graph input must not have been written to.
+    AT_ASSERT(input.equal(input_snapshot));
+  }
+
+  // Must not rewrite: the op's input is used again after the op.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor):
+  %one : int = prim::Constant[value=1]()
+  %a : Tensor = aten::mul(%x, %x)
+  %b : Tensor = aten::relu(%a)
+  %c : Tensor = aten::add(%b, %a, %one)
+  return (%c)
+)IR",
+        graph.get());
+    RewriteInplaceOps(graph);
+    // %a is live past relu (add still reads it), so relu stays
+    // functional; %b still dies at the add, which can reuse it.
+    testing::FileCheck()
+        .check("aten::relu(")
+        ->check("aten::add_")
+        ->run(*graph);
+    testing::FileCheck().check_not("aten::relu_")->run(*graph);
+  }
+
+  // Must not rewrite: the op's input aliases a graph input through a
+  // view.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor):
+  %zero : int = prim::Constant[value=0]()
+  %v : Tensor = aten::select(%x, %zero, %zero)
+  %r : Tensor = aten::relu(%v)
+  return (%r)
+)IR",
+        graph.get());
+    RewriteInplaceOps(graph);
+    testing::FileCheck().check_not("aten::relu_")->run(*graph);
+  }
+
+  // Must not rewrite: the op's input is a constant, whose buffer is
+  // shared across runs of the graph.
+  {
+    auto graph = std::make_shared<Graph>();
+    Value* constant = graph->insertConstant(at::ones({2, 2}));
+    Value* result = graph->insert(aten::relu, {constant});
+    graph->registerOutput(result);
+    RewriteInplaceOps(graph);
+    testing::FileCheck().check_not("aten::relu_")->run(*graph);
+  }
+
+  // Must not rewrite: ops inside sub-blocks, where the liveness sets are
+  // not a fixed point.
+  {
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%x : Tensor, %cond : bool):
+  %a : Tensor = aten::mul(%x, %x)
+  %r : Tensor = prim::If(%cond)
+    block0():
+      %b : Tensor = aten::relu(%a)
+      -> (%b)
+    block1():
+      -> (%a)
+  return (%r)
+)IR",
+        graph.get());
+    RewriteInplaceOps(graph);
+    testing::FileCheck().check_not("aten::relu_")->run(*graph);
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -3,6 +3,7 @@
 
 #include <sstream>
 
+#include <c10/util/tempfile.h>
 #include <torch/csrc/jit/export.h>
 #include <torch/csrc/jit/import.h>
 #include <torch/csrc/jit/import_source.h>
@@ -57,5 +58,32 @@ void testSaveExtraFilesHook() {
   }
 }
 
+void testStreamingLoad() {
+  Module m("__torch__.m");
+  m.register_parameter("weight", 2 * torch::ones({3, 3}), /*is_buffer=*/false);
+  m.register_parameter("bias", torch::ones({3}), /*is_buffer=*/true);
+  m.define(R"(
+    def forward(self, x):
+      return x.mm(self.weight) + self.bias
+  )");
+
+  auto file = c10::make_tempfile();
+  m.save(file.name);
+
+  auto weights = std::make_shared<StreamingWeights>();
+  Module loaded = jit::load_streaming(file.name, weights);
+
+  // Individual parameters and buffers are addressable by qualified name.
+  weights->wait("weight");
+  ASSERT_TRUE(weights->ready("weight"));
+  weights->wait_all();
+  ASSERT_TRUE(weights->all_ready());
+
+  auto input = torch::randn({2, 3});
+  ASSERT_TRUE(
+      m.forward({input}).toTensor().allclose(
+          loaded.forward({input}).toTensor()));
+}
+
 } // namespace jit
 } // namespace torch
@@ -56,13 +56,21 @@ namespace jit {
   _(ThreadLocalDebugInfo)              \
   _(SubgraphMatching)                  \
   _(SubgraphRewriter)                  \
+  _(FuseDropoutAddLayerNorm)           \
+  _(RewriteInplaceOps)                 \
+  _(LoopInvariantCodeMotion)           \
+  _(SubgraphCSE)                       \
+  _(BatchMMIndependent)                \
   _(ModuleCloneInstance)               \
+  _(ModuleSnapshot)                    \
   _(ModuleDefine)                      \
+  _(ModuleRunAsync)                    \
   _(QualifiedName)                     \
   _(ClassImport)                       \
   _(ProfiledTensorTypeHashing)         \
   _(ScriptObject)                      \
   _(SaveExtraFilesHook)                \
+  _(StreamingLoad)                     \
   _(DCE)                               \
   _(CustomFusionNestedBlocks)          \
   _(ClassDerive)                       \
@@ -210,8 +210,13 @@ DECLARE_GRAD_FN = CodeTemplate("""\
 std::shared_ptr<${op}> grad_fn;
 """)
 
+COMPUTE_ANY_REQUIRES_GRAD = CodeTemplate("""\
+auto _any_requires_grad = compute_requires_grad( ${args_with_derivatives} );
+(void)_any_requires_grad;
+""")
+
 SETUP_DERIVATIVE = CodeTemplate("""\
-if (compute_requires_grad( ${args_with_derivatives} )) {
+if (${cond}) {
   ${setup}
 }
 """)
@@ -689,10 +694,12 @@ def emit_body(declaration):
             body.append(DECLARE_GRAD_FN.substitute(op='Node'))
             body.append(SETUP_DERIVATIVE.substitute(
                 setup=setup,
-                args_with_derivatives=[arg['name'] for arg in differentiable_inputs]))
+                cond='compute_requires_grad( {} )'.format(
+                    ', '.join(arg['name'] for arg in differentiable_inputs))))
             body.append(SETUP_DERIVATIVE.substitute(
                 setup=setup,
-                args_with_derivatives=[arg['name'] for arg in differentiable_outputs]))
+                cond='compute_requires_grad( {} )'.format(
+                    ', '.join(arg['name'] for arg in differentiable_outputs))))
             return body
 
         setup = []
@@ -700,9 +707,13 @@ def emit_body(declaration):
         setup.extend(emit_save_inputs())
 
         body = []
+        # Hoist the requires-grad computation into a local so that the wrapper
+        # reduces to a single well-predicted branch when grad mode is off
+        # (compute_requires_grad short-circuits on !GradMode::is_enabled()).
+        body.append(COMPUTE_ANY_REQUIRES_GRAD.substitute(env))
         body.extend(emit_check_no_requires_grad(differentiable_inputs, args_with_derivatives))
         body.append(DECLARE_GRAD_FN.substitute(env))
-        body.append(SETUP_DERIVATIVE.substitute(env, setup=setup))
+        body.append(SETUP_DERIVATIVE.substitute(env, cond='_any_requires_grad', setup=setup))
         return body
 
     def emit_check_no_requires_grad(tensor_args, args_with_derivatives):
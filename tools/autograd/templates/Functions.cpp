@@ -490,6 +490,78 @@ std::vector<Tensor> cat_tensors_backward(const Tensor & grad, const std::vector<
   return grad_inputs;
 }
 
+std::vector<Tensor> grouped_index_select_backward(
+    const variable_list& grads,
+    const std::vector<std::vector<int64_t>>& sizes,
+    const std::vector<Tensor>& indices) {
+  // Batch the defined grads into one grouped scatter-add; slots whose
+  // outputs were never used stay undefined (i.e. zero).
+  std::vector<Tensor> grad_inputs(grads.size());
+  std::vector<Tensor> defined_grads;
+  std::vector<Tensor> defined_indices;
+  std::vector<int64_t> num_rows;
+  std::vector<size_t> positions;
+  for (size_t i = 0; i < grads.size(); ++i) {
+    if (grads[i].defined()) {
+      defined_grads.push_back(grads[i]);
+      defined_indices.push_back(indices[i]);
+      num_rows.push_back(sizes[i][0]);
+      positions.push_back(i);
+    }
+  }
+  if (!defined_grads.empty()) {
+    auto grad_weights = at::_grouped_index_select_backward(
+        defined_grads, defined_indices, num_rows);
+    for (size_t j = 0; j < positions.size(); ++j) {
+      grad_inputs[positions[j]] = std::move(grad_weights[j]);
+    }
+  }
+  return grad_inputs;
+}
+
+std::vector<Tensor> pad_sequence_backward(
+    const Tensor& grad,
+    const std::vector<std::vector<int64_t>>& sizes,
+    bool batch_first) {
+  // Each sequence's gradient is a view into the padded gradient; the
+  // padding region carries no gradient by construction.
+  std::vector<Tensor> grad_sequences(sizes.size());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    const int64_t length = sizes[i][0];
+    grad_sequences[i] = batch_first
+        ? grad[i].narrow(0, 0, length)
+        : grad.narrow(0, 0, length).select(1, i);
+  }
+  return grad_sequences;
+}
+
+Tensor unpad_sequence_backward(
+    const variable_list& grads,
+    IntArrayRef padded_sizes,
+    const Tensor& lengths,
+    bool batch_first) {
+  at::TensorOptions options;
+  for (const auto& grad : grads) {
+    if (grad.defined()) {
+      options = grad.options();
+      break;
+    }
+  }
+  auto grad_padded = at::zeros(padded_sizes, options);
+  auto lengths_t = lengths.contiguous();
+  const int64_t* lengths_data = lengths_t.data_ptr<int64_t>();
+  for (size_t i = 0; i < grads.size(); ++i) {
+    if (!grads[i].defined()) {
+      continue;
+    }
+    auto slice = batch_first
+        ? grad_padded[i].narrow(0, 0, lengths_data[i])
+        : grad_padded.narrow(0, 0, lengths_data[i]).select(1, i);
+    slice.copy_(grads[i]);
+  }
+  return grad_padded;
+}
+
 Tensor clamp_backward(const Tensor & grad, const Tensor &self, const optional<Scalar> & min, const optional<Scalar> & max) {
   // clamp: gradients not defined on min and max, so we return the subgradient 1 for these cases.
   if (max && min) {
@@ -45,6 +45,7 @@ libtorch_sources = [
     "torch/csrc/autograd/functions/tensor.cpp",
     "torch/csrc/autograd/functions/utils.cpp",
     "torch/csrc/autograd/input_buffer.cpp",
+    "torch/csrc/autograd/op_telemetry.cpp",
     "torch/csrc/autograd/profiler.cpp",
     "torch/csrc/autograd/record_function.cpp",
     "torch/csrc/autograd/record_function_ops.cpp",
@@ -62,6 +63,7 @@ libtorch_sources = [
     "torch/csrc/distributed/autograd/rpc_messages/cleanup_autograd_context_req.cpp",
     "torch/csrc/distributed/autograd/rpc_messages/cleanup_autograd_context_resp.cpp",
     "torch/csrc/distributed/autograd/rpc_messages/rpc_with_autograd.cpp",
+    "torch/csrc/distributed/rpc/adaptive_worker_pool.cpp",
     "torch/csrc/distributed/rpc/future_message.cpp",
     "torch/csrc/distributed/rpc/message.cpp",
     "torch/csrc/distributed/rpc/python_call.cpp",
@@ -117,6 +119,7 @@ libtorch_sources = [
     "torch/csrc/jit/passes/dead_code_elimination.cpp",
     "torch/csrc/jit/passes/erase_number_types.cpp",
     "torch/csrc/jit/passes/fixup_trace_scope_blocks.cpp",
+    "torch/csrc/jit/passes/fold_conv_batchnorm.cpp",
     "torch/csrc/jit/passes/graph_fuser.cpp",
     "torch/csrc/jit/passes/guard_elimination.cpp",
     "torch/csrc/jit/passes/inline_autodiff_subgraphs.cpp",
@@ -126,14 +129,20 @@ libtorch_sources = [
     "torch/csrc/jit/passes/inplace_check.cpp",
     "torch/csrc/jit/passes/insert_guards.cpp",
     "torch/csrc/jit/passes/liveness.cpp",
+    "torch/csrc/jit/passes/loop_invariant_code_motion.cpp",
     "torch/csrc/jit/passes/loop_unrolling.cpp",
     "torch/csrc/jit/passes/lower_grad_of.cpp",
     "torch/csrc/jit/passes/lower_graph.cpp",
     "torch/csrc/jit/passes/lower_tuples.cpp",
+    "torch/csrc/jit/passes/memory_planning.cpp",
+    "torch/csrc/jit/passes/parallelize_branches.cpp",
     "torch/csrc/jit/passes/peephole.cpp",
     "torch/csrc/jit/passes/python_print.cpp",
     "torch/csrc/jit/passes/quantization.cpp",
+    "torch/csrc/jit/passes/schedule_critical_path.cpp",
+    "torch/csrc/jit/passes/subgraph_cse.cpp",
     "torch/csrc/jit/passes/fuse_linear.cpp",
+    "torch/csrc/jit/passes/mkldnn_prepack.cpp",
     "torch/csrc/jit/passes/remove_expands.cpp",
     "torch/csrc/jit/passes/requires_grad_analysis.cpp",
     "torch/csrc/jit/passes/shape_analysis.cpp",
@@ -174,6 +183,7 @@ libtorch_sources = [
     "torch/csrc/jit/fuser/codegen.cpp",
     "torch/csrc/jit/fuser/fallback.cpp",
     "torch/csrc/jit/fuser/cpu/fused_kernel.cpp",
+    "torch/csrc/jit/fuser/cpu/interpreted_kernel.cpp",
     "torch/csrc/jit/fuser/interface.cpp",
     "torch/csrc/jit/function.cpp",
     "torch/csrc/jit/vararg_functions.cpp",
@@ -210,10 +220,12 @@ def add_torch_libs():
     torch_cpp_srcs = [
         "torch/csrc/api/src/cuda.cpp",  # this just forwards stuff, no real CUDA
         "torch/csrc/api/src/data/datasets/mnist.cpp",
+        "torch/csrc/api/src/data/datasets/packed.cpp",
         "torch/csrc/api/src/data/samplers/distributed.cpp",
         "torch/csrc/api/src/data/samplers/random.cpp",
         "torch/csrc/api/src/data/samplers/sequential.cpp",
         "torch/csrc/api/src/data/samplers/stream.cpp",
+        "torch/csrc/api/src/data/samplers/streaming_random.cpp",
         "torch/csrc/api/src/enum.cpp",
         "torch/csrc/api/src/jit.cpp",
         "torch/csrc/api/src/serialize.cpp",
@@ -326,6 +338,7 @@ def add_torch_libs():
         "torch/csrc/jit/script/python_sugared_value.cpp",
         "torch/csrc/jit/script/python_tree_views.cpp",
         "torch/csrc/multiprocessing/init.cpp",
+        "torch/csrc/multiprocessing/pinned_batch_pool.cpp",
         "torch/csrc/onnx/init.cpp",
         "torch/csrc/serialization.cpp",
         "torch/csrc/tensor/python_tensor.cpp",
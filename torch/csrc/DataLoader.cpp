@@ -19,8 +19,12 @@
 #include <sstream>
 #include <sys/wait.h>
 
+#include <ATen/ATen.h>
 #include <torch/csrc/Exceptions.h>
+#include <torch/csrc/autograd/python_variable.h>
+#include <torch/csrc/multiprocessing/pinned_batch_pool.h>
 #include <torch/csrc/utils/python_numbers.h>
+#include <torch/csrc/utils/python_strings.h>
 
 using namespace torch;
 
@@ -190,6 +194,65 @@ static PyObject *THPModule_removeWorkerPIDs(PyObject *module, PyObject *loader_i
   END_HANDLE_TH_ERRORS
 }
 
+// Bindings for the IPC-shared pinned batch pool (see
+// torch/csrc/multiprocessing/pinned_batch_pool.h): workers collate
+// batches straight into a pool slot, the parent launches H2D from the
+// same pinned pages, and the per-batch shm/pin copies disappear.
+
+static PyObject *THPModule_createPinnedBatchPool(PyObject *module, PyObject *args) {
+  HANDLE_TH_ERRORS
+  if (PyTuple_GET_SIZE(args) != 3) {
+    throw TypeError("_create_pinned_batch_pool expects exactly 3 arguments.");
+  }
+  std::string name = THPUtils_unpackString(PyTuple_GET_ITEM(args, 0));
+  int64_t slot_bytes = THPUtils_unpackLong(PyTuple_GET_ITEM(args, 1));
+  int64_t num_slots = THPUtils_unpackLong(PyTuple_GET_ITEM(args, 2));
+  torch::multiprocessing::createPinnedBatchPool(name, slot_bytes, num_slots);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *THPModule_attachPinnedBatchPool(PyObject *module, PyObject *args) {
+  HANDLE_TH_ERRORS
+  if (PyTuple_GET_SIZE(args) != 3) {
+    throw TypeError("_attach_pinned_batch_pool expects exactly 3 arguments.");
+  }
+  std::string name = THPUtils_unpackString(PyTuple_GET_ITEM(args, 0));
+  int64_t slot_bytes = THPUtils_unpackLong(PyTuple_GET_ITEM(args, 1));
+  int64_t num_slots = THPUtils_unpackLong(PyTuple_GET_ITEM(args, 2));
+  torch::multiprocessing::attachPinnedBatchPool(name, slot_bytes, num_slots);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+// Returns a uint8 tensor viewing `nbytes` of the given slot. The view does
+// not own the pool: keep the pool alive for as long as any slot tensor is.
+static PyObject *THPModule_pinnedBatchPoolSlot(PyObject *module, PyObject *args) {
+  HANDLE_TH_ERRORS
+  if (PyTuple_GET_SIZE(args) != 3) {
+    throw TypeError("_pinned_batch_pool_slot expects exactly 3 arguments.");
+  }
+  std::string name = THPUtils_unpackString(PyTuple_GET_ITEM(args, 0));
+  int64_t index = THPUtils_unpackLong(PyTuple_GET_ITEM(args, 1));
+  int64_t nbytes = THPUtils_unpackLong(PyTuple_GET_ITEM(args, 2));
+  int64_t slot_bytes = torch::multiprocessing::pinnedBatchPoolSlotBytes(name);
+  if (nbytes < 0 || nbytes > slot_bytes) {
+    throw ValueError("_pinned_batch_pool_slot: %lld bytes requested from a "
+        "%lld byte slot.", (long long)nbytes, (long long)slot_bytes);
+  }
+  void* data = torch::multiprocessing::pinnedBatchPoolSlot(name, index);
+  auto tensor = at::from_blob(data, {nbytes}, at::device(at::kCPU).dtype(at::kByte));
+  return THPVariable_Wrap(tensor);
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject *THPModule_destroyPinnedBatchPool(PyObject *module, PyObject *name) {
+  HANDLE_TH_ERRORS
+  torch::multiprocessing::destroyPinnedBatchPool(THPUtils_unpackString(name));
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
 #undef SIGNAL_HANDLER
 
 #else
@@ -211,6 +274,22 @@ static PyObject *THPModule_errorIfAnyWorkerFails(PyObject *module, PyObject *_ig
   Py_RETURN_NONE;
 }
 
+static PyObject *THPModule_createPinnedBatchPool(PyObject *module, PyObject *_ignored) {
+  Py_RETURN_NONE;
+}
+
+static PyObject *THPModule_attachPinnedBatchPool(PyObject *module, PyObject *_ignored) {
+  Py_RETURN_NONE;
+}
+
+static PyObject *THPModule_pinnedBatchPoolSlot(PyObject *module, PyObject *_ignored) {
+  Py_RETURN_NONE;
+}
+
+static PyObject *THPModule_destroyPinnedBatchPool(PyObject *module, PyObject *_ignored) {
+  Py_RETURN_NONE;
+}
+
 #endif
 
 PyMethodDef DataLoaderMethods[] = {
@@ -218,5 +297,9 @@ PyMethodDef DataLoaderMethods[] = {
   {"_set_worker_pids",             (PyCFunction)THPModule_setWorkerPIDs,            METH_VARARGS,  nullptr},
   {"_remove_worker_pids",          (PyCFunction)THPModule_removeWorkerPIDs,         METH_O,        nullptr},
   {"_error_if_any_worker_fails",   (PyCFunction)THPModule_errorIfAnyWorkerFails,    METH_NOARGS,   nullptr},
+  {"_create_pinned_batch_pool",    (PyCFunction)THPModule_createPinnedBatchPool,    METH_VARARGS,  nullptr},
+  {"_attach_pinned_batch_pool",    (PyCFunction)THPModule_attachPinnedBatchPool,    METH_VARARGS,  nullptr},
+  {"_pinned_batch_pool_slot",      (PyCFunction)THPModule_pinnedBatchPoolSlot,      METH_VARARGS,  nullptr},
+  {"_destroy_pinned_batch_pool",   (PyCFunction)THPModule_destroyPinnedBatchPool,   METH_O,        nullptr},
   {nullptr, nullptr, 0, nullptr}
 };
@@ -239,6 +239,92 @@ class BatchDataBuffer {
   // the program to hang. This boolean is used to break this waiting condition.
   bool stop_ = false;
 };
+
+/// ChunkPrefetchBuffer is an optional pipeline stage between the chunk reader
+/// threads and batch creation. It holds up to `capacity` chunks that are
+/// already read and pre-transformed, so chunk reads keep running ahead even
+/// while the batch queue in BatchDataBuffer is full and the readers would
+/// otherwise sit idle. The bounded capacity provides backpressure towards the
+/// readers.
+template <typename UnwrappedBatch>
+class ChunkPrefetchBuffer {
+ public:
+  using UnwrappedBatchType = UnwrappedBatch;
+
+  /// A chunk that finished reading, or the exception the read raised.
+  struct ChunkData {
+    explicit ChunkData(UnwrappedBatchType data) : chunk_data(std::move(data)) {}
+
+    explicit ChunkData(std::exception_ptr e) : exception(e) {}
+
+    UnwrappedBatchType chunk_data;
+    std::exception_ptr exception;
+  };
+
+  explicit ChunkPrefetchBuffer(size_t capacity) : capacity_(capacity) {}
+
+  /// Push a fully read chunk. Called from the reader threads; blocks while
+  /// the buffer already holds `capacity` chunks.
+  void add_chunk(UnwrappedBatchType data) {
+    push(ChunkData(std::move(data)));
+  }
+
+  /// Push an exception thrown while reading a chunk.
+  void add_chunk(std::exception_ptr e_ptr) {
+    push(ChunkData(e_ptr));
+  }
+
+  /// Pop the next prefetched chunk. Returns nullopt once the buffer is
+  /// stopped or all readers have finished and the buffer drained.
+  optional<ChunkData> pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_read_.wait(lock, [this] {
+      return !this->chunk_queue_.empty() || this->stop_;
+    });
+    if (chunk_queue_.empty()) {
+      AT_ASSERT(stop_);
+      return nullopt;
+    }
+    ChunkData chunk = std::move(chunk_queue_.front());
+    chunk_queue_.pop();
+    lock.unlock();
+    cv_write_.notify_all();
+    return chunk;
+  }
+
+  void stop() {
+    {
+      // See the comment in BatchDataBuffer::stop() for why the lock is
+      // required while flipping stop_.
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_write_.notify_all();
+    cv_read_.notify_all();
+  }
+
+ private:
+  void push(ChunkData chunk) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_write_.wait(lock, [this] {
+      return this->chunk_queue_.size() < this->capacity_ || this->stop_;
+    });
+    if (stop_) {
+      // The buffer is being torn down; the chunk can be discarded.
+      return;
+    }
+    chunk_queue_.push(std::move(chunk));
+    lock.unlock();
+    cv_read_.notify_all();
+  }
+
+  std::queue<ChunkData> chunk_queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_read_;
+  std::condition_variable cv_write_;
+  size_t capacity_;
+  bool stop_ = false;
+};
 } // namespace detail
 
 /// Options to configure a `ChunkDataset`.
@@ -248,11 +334,13 @@ struct ChunkDatasetOptions {
       size_t preloader_count,
       size_t batch_size,
       size_t cache_size = 2048,
-      size_t cross_chunk_shuffle_count = 1)
+      size_t cross_chunk_shuffle_count = 1,
+      size_t prefetch_chunk_count = 0)
       : preloader_count_(preloader_count),
         batch_size_(batch_size),
         cache_size_(cache_size),
-        cross_chunk_shuffle_count_(cross_chunk_shuffle_count) {
+        cross_chunk_shuffle_count_(cross_chunk_shuffle_count),
+        prefetch_chunk_count_(prefetch_chunk_count) {
     TORCH_CHECK(
         preloader_count_ > 0,
         "Preloader count is 0. At least one preloader needs to be specified.");
@@ -290,6 +378,15 @@ struct ChunkDatasetOptions {
   // penalty when this value is greater than 1, as we need to do extra merge
   // between multiple chunks before performing example sampling.
   TORCH_ARG(size_t, cross_chunk_shuffle_count) = 1;
+
+  // The number of chunks to read ahead of batch creation. Default to 0
+  // meaning no read-ahead: the preloader threads block on the batch queue's
+  // backpressure between chunks, so once the batch cache is full no chunk
+  // read is in flight. When set to n (n > 0), up to n fully read and
+  // pre-transformed chunks are buffered in a dedicated pipeline stage, which
+  // hides I/O stalls at epoch boundaries and after shard switches at the cost
+  // of keeping up to n extra chunks in memory.
+  TORCH_ARG(size_t, prefetch_chunk_count) = 0;
 };
 
 /// A stateful dataset that support hierarchical sampling and prefetching of
@@ -337,6 +434,9 @@ class ChunkDataset final
     if (batch_buffer_) {
       batch_buffer_->stop();
     }
+    if (prefetch_buffer_) {
+      prefetch_buffer_->stop();
+    }
     free_workers();
   }
 
@@ -369,6 +469,9 @@ class ChunkDataset final
     if (batch_buffer_) {
       batch_buffer_->stop();
     }
+    if (prefetch_buffer_) {
+      prefetch_buffer_->stop();
+    }
     // free workers from previous reset if there is any.
     free_workers();
     preload_threads_.clear();
@@ -387,6 +490,14 @@ class ChunkDataset final
         example_sampler_,
         options_.cache_size());
 
+    // Re-create the optional chunk read-ahead stage, see
+    // `ChunkDatasetOptions::prefetch_chunk_count`.
+    if (options_.prefetch_chunk_count() > 0) {
+      prefetch_buffer_ =
+          torch::make_unique<detail::ChunkPrefetchBuffer<UnwrappedBatchType>>(
+              options_.prefetch_chunk_count());
+    }
+
     // create new workers for this new epoch.
     quit_worker_ = false;
 
@@ -395,6 +506,9 @@ class ChunkDataset final
     for (size_t i = 0; i < options_.preloader_count(); ++i) {
       preload_threads_.emplace_back([this, i]() { this->preloader(i); });
     }
+    if (prefetch_buffer_) {
+      preload_threads_.emplace_back([this]() { this->batcher(); });
+    }
   }
 
   /// size is not used for chunk dataset.
@@ -443,20 +557,50 @@ class ChunkDataset final
           preprocessing_policy_(data);
         }
         if (!data.empty()) { // skip empty chunks.
-          batch_buffer_->add_chunk_data(std::move(data));
+          if (prefetch_buffer_) {
+            prefetch_buffer_->add_chunk(std::move(data));
+          } else {
+            batch_buffer_->add_chunk_data(std::move(data));
+          }
         }
       } catch (...) {
-        batch_buffer_->add_chunk_data(std::current_exception());
+        if (prefetch_buffer_) {
+          prefetch_buffer_->add_chunk(std::current_exception());
+        } else {
+          batch_buffer_->add_chunk_data(std::current_exception());
+        }
       }
     }
     AT_ASSERT(running_preloaders_.load() > 0);
     --running_preloaders_;
     if (running_preloaders_.load() == 0) {
-      // all preloaders are completed, so we can notify the batch_buffer.
-      batch_buffer_->stop();
+      if (prefetch_buffer_) {
+        // all preloaders are completed; the batcher drains the remaining
+        // prefetched chunks and then notifies the batch_buffer itself.
+        prefetch_buffer_->stop();
+      } else {
+        // all preloaders are completed, so we can notify the batch_buffer.
+        batch_buffer_->stop();
+      }
     }
   }
 
+  /// Runs on a dedicated thread when chunk read-ahead is enabled: moves
+  /// prefetched chunks from the prefetch buffer into the batch buffer, where
+  /// they are split into batches. This keeps the preloader threads reading
+  /// ahead while the batch queue applies its own backpressure here instead.
+  void batcher() {
+    while (auto chunk = prefetch_buffer_->pop()) {
+      if (chunk->exception) {
+        batch_buffer_->add_chunk_data(chunk->exception);
+      } else {
+        batch_buffer_->add_chunk_data(std::move(chunk->chunk_data));
+      }
+    }
+    // The prefetch buffer is stopped and drained; no more batches will come.
+    batch_buffer_->stop();
+  }
+
   /// Block the current thread until the workers finish execution and exit.
   void free_workers() {
     if (!quit_worker_.load()) {
@@ -483,6 +627,11 @@ class ChunkDataset final
   std::shared_ptr<detail::BatchDataBuffer<UnwrappedBatchType, ExampleSamplerType>>
       batch_buffer_;
 
+  // optional bounded buffer of fully read, pre-transformed chunks. Only
+  // created when options_.prefetch_chunk_count() > 0; nullptr otherwise.
+  std::unique_ptr<detail::ChunkPrefetchBuffer<UnwrappedBatchType>>
+      prefetch_buffer_;
+
   // worker thread pool
   std::vector<std::thread> preload_threads_;
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <torch/data/datasets/base.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <c10/core/Allocator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+
+/// A dataset stored as a single packed binary file of fixed-shape records.
+///
+/// The file begins with a header describing the shape and dtype of the data
+/// and target tensors, followed by the raw record payloads and an offset
+/// index. `PackedDataset` memory-maps the file once at construction and
+/// serves each example as a pair of tensor views directly over the mapping,
+/// so `get()` performs no read syscalls and no copies.
+///
+/// The returned tensors alias the mapping and are valid only while the
+/// dataset (or a copy of it) is alive. Use `PackedDatasetWriter` to produce
+/// the file format.
+class TORCH_API PackedDataset : public Dataset<PackedDataset> {
+ public:
+  /// Memory-maps and validates the packed dataset file at `path`.
+  explicit PackedDataset(const std::string& path);
+
+  /// Returns the `Example` at the given `index` as zero-copy views over the
+  /// file mapping.
+  Example<> get(size_t index) override;
+
+  /// Returns the number of records in the file.
+  optional<size_t> size() const override;
+
+ private:
+  /// Shape, dtype and intra-record byte offset of one tensor field.
+  struct Field {
+    ScalarType dtype;
+    std::vector<int64_t> sizes;
+    size_t offset;
+    size_t nbytes;
+  };
+
+  Tensor view(size_t index, const Field& field) const;
+
+  /// Shared so that copies of the dataset keep the mapping alive.
+  std::shared_ptr<at::DataPtr> mapping_;
+  size_t mapping_size_ = 0;
+  std::vector<Field> fields_;
+  /// Absolute file offset of each record, read from the offset index.
+  std::vector<int64_t> record_offsets_;
+};
+
+/// Writes the packed single-file format read by `PackedDataset`.
+///
+/// The first example written fixes the record layout; every subsequent
+/// example must have the same shapes and dtypes. Records are aligned so the
+/// reader's tensor views are suitable for vectorized kernels. `finish()`
+/// must be called to write the offset index and complete the header; a file
+/// that was not finished is not readable.
+class TORCH_API PackedDatasetWriter {
+ public:
+  /// Opens `path` for writing, truncating any existing file.
+  explicit PackedDatasetWriter(const std::string& path);
+
+  /// Appends one example to the file.
+  void write(const Example<>& example);
+
+  /// Writes the offset index and completes the header.
+  void finish();
+
+ private:
+  void write_tensor(const Tensor& tensor);
+  void pad_to_alignment();
+
+  std::ofstream stream_;
+  /// Per-field (dtype, sizes) fixed by the first example.
+  std::vector<std::pair<ScalarType, std::vector<int64_t>>> fields_;
+  std::vector<int64_t> record_offsets_;
+  bool finished_ = false;
+};
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/data/samplers/base.h>
+#include <torch/types.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace torch {
+namespace serialize {
+class OutputArchive;
+class InputArchive;
+} // namespace serialize
+} // namespace torch
+
+namespace torch {
+namespace data {
+namespace samplers {
+
+/// A `Sampler` that yields each index in `[0, size)` exactly once per epoch,
+/// in a pseudorandom order, without materializing the permutation.
+///
+/// `RandomSampler` stores a full `randperm` of the dataset, which for
+/// billion-sample datasets costs gigabytes of index storage per worker. This
+/// sampler instead evaluates a keyed bijection over the index range on the
+/// fly: a four-round Feistel network over the smallest power-of-four domain
+/// covering `size`, with cycle-walking to stay inside `[0, size)`. Its state
+/// is a few words regardless of dataset size, and each `reset()` draws a
+/// fresh key (from the global torch RNG, so `torch::manual_seed` makes
+/// epochs reproducible) to obtain a new permutation.
+///
+/// The permutation quality is that of a statistical shuffle, not a
+/// cryptographic one; it is intended for epoch shuffling.
+class TORCH_API StreamingRandomSampler : public Sampler<> {
+ public:
+  /// Constructs a `StreamingRandomSampler` over indices `0 ... size - 1`.
+  explicit StreamingRandomSampler(int64_t size);
+
+  ~StreamingRandomSampler() override;
+
+  /// Draws a new permutation key, optionally for a new size.
+  void reset(optional<size_t> new_size = nullopt) override;
+
+  /// Returns the next batch of indices.
+  optional<std::vector<size_t>> next(size_t batch_size) override;
+
+  /// Serializes the `StreamingRandomSampler` to the `archive`.
+  void save(serialize::OutputArchive& archive) const override;
+
+  /// Deserializes the `StreamingRandomSampler` from the `archive`.
+  void load(serialize::InputArchive& archive) override;
+
+  /// Returns the current index of the `StreamingRandomSampler`.
+  size_t index() const noexcept;
+
+ private:
+  /// Derives the round keys and domain geometry from `seed_` and `size_`.
+  void rekey();
+
+  /// Applies the Feistel permutation (with cycle-walking) to `value`.
+  uint64_t permute(uint64_t value) const;
+
+  int64_t size_;
+  int64_t index_ = 0;
+  int64_t seed_;
+  std::array<uint64_t, 4> round_keys_;
+  uint64_t half_bits_;
+  uint64_t half_mask_;
+};
+
+} // namespace samplers
+} // namespace data
+} // namespace torch
@@ -209,6 +209,22 @@ class TORCH_API Module : public std::enable_shared_from_this<Module> {
   /// their keys, and if `recurse` is true also recursively of every submodule.
   OrderedDict<std::string, Tensor> named_parameters(bool recurse = true) const;
 
+  /// Coalesces the parameters of this `Module` (and recursively of every
+  /// submodule) into one contiguous allocation per dtype/device pair, and
+  /// re-seats every parameter as a view into it (like cuDNN RNN's
+  /// `flatten_parameters`, but for arbitrary modules). Whole-model
+  /// operations such as weight decay, global norm computation or averaging
+  /// then run as a single kernel per allocation instead of one kernel per
+  /// parameter; since the parameters share storage with the returned flat
+  /// tensors, in-place updates through either side stay in sync.
+  ///
+  /// Returns the flat tensors in the order their dtype/device pairs are
+  /// first encountered. Only the parameter storage is flattened - gradients
+  /// are unaffected. Undefined parameters are skipped, and parameters that
+  /// share a tensor are flattened once. Note that any externally held
+  /// aliases of the old parameter storage are left behind.
+  std::vector<Tensor> flatten_parameters();
+
   /// Returns the buffers of this `Module` and if `recurse` is true, also
   /// recursively of every submodule.
   std::vector<Tensor> buffers(bool recurse = true) const;
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <torch/arg.h>
+#include <torch/nn/cloneable.h>
+#include <torch/nn/modules/container/sequential.h>
+#include <torch/nn/pimpl.h>
+#include <torch/types.h>
+
+#include <torch/csrc/autograd/grad_mode.h>
+
+#include <c10/util/Exception.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace nn {
+
+/// Options for the `Pipeline` module.
+struct PipelineOptions {
+  /* implicit */ PipelineOptions(std::vector<Device> devices)
+      : devices_(std::move(devices)) {}
+
+  /// The devices to place the pipeline stages on, one stage per device, in
+  /// pipeline order.
+  TORCH_ARG(std::vector<Device>, devices);
+
+  /// The number of microbatches each input batch is split into. More chunks
+  /// reduce the pipeline bubble at the cost of smaller per-stage kernels.
+  TORCH_ARG(int64_t, chunks) = 4;
+
+  /// The number of layers assigned to each stage, in pipeline order. When
+  /// empty, a balance is derived on the first call to `forward()` by profiling
+  /// the per-layer cost of one microbatch.
+  TORCH_ARG(std::vector<int64_t>, balance) = std::vector<int64_t>();
+};
+
+/// Runs a `Sequential` as a microbatch pipeline across multiple devices.
+///
+/// The layers of the wrapped `Sequential` are partitioned into one contiguous
+/// stage per device, either by an explicit `balance` or by profiling the
+/// per-layer cost of a single microbatch on the first call to `forward()`.
+/// Each `forward()` splits the input batch into `chunks` microbatches and
+/// streams them through the stages: every stage runs on its own thread and
+/// hands its output to the next device as soon as a microbatch is done, so
+/// stages work on different microbatches concurrently instead of idling while
+/// one device computes.
+///
+/// The microbatch outputs stay connected to the autograd graph, so calling
+/// `backward()` on (a loss of) the returned tensor works as usual; the
+/// autograd engine runs one worker per device, so the backward pass is
+/// pipelined across stages the same way.
+///
+/// Note that when no explicit `balance` is supplied, the stage submodules are
+/// registered during the first `forward()` call. In that case construct
+/// optimizers after that first call (or supply a `balance`), so that
+/// `parameters()` is fully populated.
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   torch::nn::Sequential sequence(
+///       torch::nn::Linear(64, 64), torch::nn::Linear(64, 64),
+///       torch::nn::Linear(64, 64), torch::nn::Linear(64, 16));
+///   torch::nn::Pipeline pipeline(
+///       sequence,
+///       torch::nn::PipelineOptions(
+///           {torch::Device(torch::kCUDA, 0), torch::Device(torch::kCUDA, 1)})
+///           .chunks(8));
+///   auto output = pipeline->forward(input);
+/// \endrst
+class PipelineImpl : public Cloneable<PipelineImpl> {
+ public:
+  PipelineImpl(Sequential sequence, PipelineOptions options_)
+      : options(std::move(options_)) {
+    TORCH_CHECK(
+        !options.devices().empty(),
+        "Pipeline requires at least one device");
+    TORCH_CHECK(
+        !sequence->is_empty(), "Cannot construct a Pipeline from an empty Sequential");
+    layers_.assign(sequence->begin(), sequence->end());
+    TORCH_CHECK(
+        layers_.size() >= options.devices().size(),
+        "Pipeline requires at least as many layers (",
+        layers_.size(),
+        ") as devices (",
+        options.devices().size(),
+        ")");
+    if (!options.balance().empty()) {
+      partition(options.balance());
+    }
+  }
+
+  /// Special cloning function for `Pipeline` because it does not use
+  /// `reset()`, much like `Sequential`.
+  std::shared_ptr<Module> clone(
+      const optional<Device>& device = nullopt) const override {
+    Sequential sequence;
+    for (const auto& layer : layers_) {
+      sequence->push_back(layer.clone(device));
+    }
+    // `options` carries the balance once this instance has been partitioned,
+    // so the clone partitions (and re-places the stages) eagerly.
+    return std::make_shared<PipelineImpl>(std::move(sequence), options);
+  }
+
+  /// `reset()` is empty for `Pipeline`; all state is set up in the
+  /// constructor and in `partition()`.
+  void reset() override {}
+
+  /// Pretty prints the `Pipeline` module into the given `stream`.
+  void pretty_print(std::ostream& stream) const override {
+    stream << "torch::nn::Pipeline(chunks=" << options.chunks() << ")";
+  }
+
+  /// Splits `input` along dimension 0 into microbatches, streams them through
+  /// the pipeline stages and returns the re-concatenated output, which lives
+  /// on the last device.
+  Tensor forward(Tensor input) {
+    TORCH_CHECK(
+        input.dim() > 0 && input.size(0) > 0,
+        "Pipeline requires a non-empty batch dimension to split into microbatches");
+    const auto& devices = options.devices();
+    const int64_t chunks = std::min(options.chunks(), input.size(0));
+    if (stages_.empty()) {
+      const auto sample_size = std::max<int64_t>(input.size(0) / chunks, 1);
+      partition(profile_balance(input.narrow(0, 0, sample_size).detach()));
+    }
+
+    auto microbatches = input.to(devices.front()).chunk(chunks, /*dim=*/0);
+
+    // One channel in front of every stage plus one collecting the outputs.
+    // Each stage pops microbatches in order, so per-microbatch ordering is
+    // preserved end to end.
+    std::vector<std::shared_ptr<Channel>> channels;
+    channels.reserve(stages_.size() + 1);
+    for (size_t i = 0; i < stages_.size() + 1; ++i) {
+      channels.push_back(std::make_shared<Channel>());
+    }
+    for (auto& microbatch : microbatches) {
+      channels.front()->push(std::move(microbatch));
+    }
+
+    // The first exception caught by any stage is stashed and rethrown after
+    // all threads have completed, as in `parallel_apply()`. An undefined
+    // tensor is forwarded in its place so downstream stages do not block.
+    std::mutex mutex;
+    std::exception_ptr exception;
+
+    std::vector<std::thread> workers;
+    workers.reserve(stages_.size());
+    const int64_t num_microbatches = microbatches.size();
+    // Grad mode is thread-local, so the workers must inherit it explicitly
+    // for `NoGradGuard` around the pipeline to apply to the stages.
+    const bool grad_mode = autograd::GradMode::is_enabled();
+    for (size_t s = 0; s < stages_.size(); ++s) {
+      workers.emplace_back(
+          [this, s, num_microbatches, grad_mode, &channels, &devices, &mutex, &exception] {
+            autograd::GradMode::set_enabled(grad_mode);
+            for (int64_t m = 0; m < num_microbatches; ++m) {
+              auto tensor = channels[s]->pop();
+              try {
+                if (tensor.defined()) {
+                  // Both the copy onto this stage's device and the stage
+                  // itself are issued here; kernels for different stages land
+                  // on different devices and therefore overlap.
+                  tensor = stages_[s]->forward(tensor.to(devices[s]));
+                }
+              } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!exception) {
+                  exception = std::current_exception();
+                }
+                tensor = Tensor();
+              }
+              channels[s + 1]->push(std::move(tensor));
+            }
+          });
+    }
+
+    std::vector<Tensor> outputs;
+    outputs.reserve(num_microbatches);
+    for (int64_t m = 0; m < num_microbatches; ++m) {
+      outputs.push_back(channels.back()->pop());
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+    return torch::cat(outputs, /*dim=*/0);
+  }
+
+  /// The options with which this `Pipeline` was constructed. Once the
+  /// pipeline has been partitioned, `options.balance()` holds the number of
+  /// layers assigned to each stage.
+  PipelineOptions options;
+
+ private:
+  // A single-producer, single-consumer handoff queue between two adjacent
+  // stages.
+  struct Channel {
+    void push(Tensor tensor) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        tensors.push_back(std::move(tensor));
+      }
+      cv.notify_one();
+    }
+
+    Tensor pop() {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [this] { return !tensors.empty(); });
+      auto tensor = std::move(tensors.front());
+      tensors.pop_front();
+      return tensor;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Tensor> tensors;
+  };
+
+  /// Splits the layers into one contiguous stage per device and registers the
+  /// stages as submodules.
+  void partition(const std::vector<int64_t>& balance) {
+    const auto& devices = options.devices();
+    TORCH_CHECK(
+        balance.size() == devices.size(),
+        "Pipeline balance must have one entry per device, but got ",
+        balance.size(),
+        " entries for ",
+        devices.size(),
+        " devices");
+    TORCH_CHECK(
+        std::accumulate(balance.begin(), balance.end(), int64_t(0)) ==
+            static_cast<int64_t>(layers_.size()),
+        "Pipeline balance must sum to the number of layers (",
+        layers_.size(),
+        ")");
+    stages_.reserve(devices.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < devices.size(); ++i) {
+      TORCH_CHECK(
+          balance[i] > 0, "Every pipeline stage must contain at least one layer");
+      Sequential stage;
+      for (int64_t j = 0; j < balance[i]; ++j) {
+        stage->push_back(layers_[offset++]);
+      }
+      stage->to(devices[i]);
+      stages_.push_back(
+          register_module("stage_" + c10::to_string(i), std::move(stage)));
+    }
+    options.balance(balance);
+  }
+
+  /// Runs `sample` through the layers one by one on the first device, timing
+  /// each layer, and derives a balance that evens out the per-stage cost.
+  std::vector<int64_t> profile_balance(const Tensor& sample) {
+    NoGradGuard no_grad;
+    const auto device = options.devices().front();
+    for (auto& layer : layers_) {
+      layer.ptr()->to(device);
+    }
+
+    std::vector<double> costs;
+    costs.reserve(layers_.size());
+    auto synchronize_and_time =
+        [](AnyModule::Value& value,
+           std::chrono::steady_clock::time_point start) -> double {
+      // Reading a scalar back forces the kernels launched for this layer to
+      // finish, so the wall-clock interval reflects the layer's cost.
+      if (auto* tensor = value.try_get<Tensor>()) {
+        (void)tensor->sum().item<double>();
+      }
+      return std::chrono::duration<double>(
+                 std::chrono::steady_clock::now() - start)
+          .count();
+    };
+    auto start = std::chrono::steady_clock::now();
+    auto value = layers_.front().any_forward(sample.to(device));
+    costs.push_back(synchronize_and_time(value, start));
+    for (size_t i = 1; i < layers_.size(); ++i) {
+      start = std::chrono::steady_clock::now();
+      value = layers_[i].any_forward(std::move(value));
+      costs.push_back(synchronize_and_time(value, start));
+    }
+
+    // Greedy contiguous partition: close a stage once it has accumulated its
+    // share of the total cost, while leaving at least one layer for each of
+    // the remaining stages.
+    std::vector<int64_t> balance(options.devices().size(), 0);
+    const double total =
+        std::accumulate(costs.begin(), costs.end(), 0.0);
+    const double target = total / balance.size();
+    size_t stage = 0;
+    double accumulated = 0;
+    for (size_t i = 0; i < costs.size(); ++i) {
+      const size_t remaining_layers = costs.size() - i;
+      const size_t remaining_stages = balance.size() - stage;
+      if (stage + 1 < balance.size() && balance[stage] > 0 &&
+          (accumulated >= target || remaining_layers == remaining_stages)) {
+        ++stage;
+        accumulated = 0;
+      }
+      balance[stage] += 1;
+      accumulated += costs[i];
+    }
+    return balance;
+  }
+
+  std::vector<AnyModule> layers_;
+  std::vector<Sequential> stages_;
+};
+
+/// A `ModuleHolder` subclass for `PipelineImpl`.
+/// See the documentation for `PipelineImpl` class to learn what methods it
+/// provides, or the documentation for `ModuleHolder` to learn about PyTorch's
+/// module storage semantics.
+TORCH_MODULE(Pipeline);
+
+} // namespace nn
+} // namespace torch
@@ -50,6 +50,27 @@ class TORCH_API Adam : public Optimizer {
  private:
   Adam() : options(0) {}
 
+  // Parameters sharing a device and dtype have their Adam state packed into
+  // one flat buffer per state kind; the per-parameter buffers above become
+  // views into these. See Note [Fused Adam step] in adam.cpp.
+  struct FusedGroup {
+    std::vector<size_t> indices;
+    Tensor exp_average;
+    Tensor exp_average_sq;
+    Tensor max_exp_average_sq;
+  };
+
+  // Performs the update with a few large kernels per group instead of a
+  // chain of small ones per parameter. Returns false, leaving all state
+  // untouched, when this step cannot be fused (e.g. some parameters have no
+  // gradient this iteration); step() then takes the per-parameter path.
+  bool fused_step();
+
+  std::vector<FusedGroup> fused_groups_;
+  // Number of parameters the groups were built for; groups are rebuilt
+  // lazily after parameters are added or state is loaded.
+  size_t fused_params_ = 0;
+
   template <typename Self, typename Archive>
   static void serialize(Self& self, Archive& archive) {
     _TORCH_OPTIM_SERIALIZE(step_buffers);
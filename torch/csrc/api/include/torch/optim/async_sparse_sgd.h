@@ -0,0 +1,112 @@
+#pragma once
+
+#include <torch/arg.h>
+#include <torch/optim/optimizer.h>
+#include <torch/types.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace serialize {
+class OutputArchive;
+class InputArchive;
+} // namespace serialize
+} // namespace torch
+
+namespace torch {
+namespace optim {
+
+struct TORCH_API AsyncSparseSGDOptions {
+  /* implicit */ AsyncSparseSGDOptions(double learning_rate);
+  TORCH_ARG(double, learning_rate);
+  /// Applied to dense gradients only; sparse updates touch a small subset of
+  /// rows and decaying the whole table per step would defeat their purpose.
+  TORCH_ARG(double, weight_decay) = 0;
+};
+
+/// SGD variant that applies sparse (embedding) gradients on a background
+/// thread, so the scattered row updates overlap with the next batch's
+/// forward pass instead of serializing the training loop.
+///
+/// `step()` applies dense gradients inline, exactly like `SGD` without
+/// momentum, and enqueues a snapshot of every sparse gradient to a single
+/// applier thread. The applier coalesces each gradient first -- which both
+/// merges duplicate rows and sorts the remaining ones by index, so the
+/// scattered writes walk the embedding table in ascending row order -- and
+/// then applies the whole batch with one vectorized sparse `add_`.
+///
+/// Updates to the same parameter are applied in the order they were
+/// enqueued. However, a parameter with pending updates must not be *read*
+/// (e.g. by the next forward pass over the same rows, or by serialization)
+/// until `sync()` -- or the cheaper per-parameter `sync(i)` -- has been
+/// called; `save()` synchronizes internally. Errors raised on the applier
+/// thread are rethrown from the next `sync()` or `step()`.
+class TORCH_API AsyncSparseSGD : public Optimizer {
+ public:
+  template <typename ParameterContainer>
+  explicit AsyncSparseSGD(
+      ParameterContainer&& parameters,
+      const AsyncSparseSGDOptions& options_)
+      : Optimizer(std::forward<ParameterContainer>(parameters)),
+        options(options_) {}
+
+  /// Waits for every pending sparse update before tearing down the applier.
+  ~AsyncSparseSGD() override;
+
+  void step() override;
+
+  /// Blocks until every enqueued sparse update has been applied.
+  void sync();
+
+  /// Blocks until pending sparse updates for parameter `i` are applied.
+  void sync(size_t i);
+
+  /// Number of sparse updates enqueued but not yet applied.
+  size_t pending() const;
+
+  void save(serialize::OutputArchive& archive) const override;
+  void load(serialize::InputArchive& archive) override;
+  int64_t iteration() const;
+
+  AsyncSparseSGDOptions options;
+
+ private:
+  AsyncSparseSGD() : options(0) {}
+
+  struct Job {
+    size_t param_index;
+    Tensor grad;
+    uint64_t ticket;
+  };
+
+  void enqueue(size_t param_index, Tensor grad);
+  void wait_all() const;
+  void run();
+
+  mutable std::mutex mutex_;
+  mutable std::condition_variable job_cv_;
+  mutable std::condition_variable done_cv_;
+  std::deque<Job> jobs_;
+  /// Per-parameter tickets: the last enqueued and last applied update.
+  /// `sync(i)` waits until they match (see `wait_all` for the global case).
+  std::vector<uint64_t> enqueued_tickets_;
+  std::vector<uint64_t> applied_tickets_;
+  std::thread worker_;
+  bool worker_started_{false};
+  bool shutdown_{false};
+  bool busy_{false};
+  mutable std::exception_ptr error_;
+
+  /// Counts how often `step()` is called.
+  int64_t iteration_{0};
+};
+} // namespace optim
+} // namespace torch
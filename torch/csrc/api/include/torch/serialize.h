@@ -4,10 +4,39 @@
 #include <torch/serialize/tensor.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 
+#include <fstream>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
 #include <utility>
 
 namespace torch {
 
+namespace detail {
+/// Streams an already-serialized buffer to `filename` from a background
+/// thread. Shared by the `save_async` overloads below.
+inline std::future<void> stream_buffer_to_file_async(
+    std::shared_ptr<std::ostringstream> buffer,
+    std::string filename) {
+  return std::async(
+      std::launch::async,
+      [buffer, filename]() {
+        std::ofstream file(filename, std::ios::binary);
+        TORCH_CHECK(
+            file, "save_async: could not open file \"", filename, "\"");
+        const std::string& data = buffer->str();
+        file.write(data.data(), data.size());
+        file.close();
+        TORCH_CHECK(
+            file.good(),
+            "save_async: failed writing checkpoint to \"",
+            filename,
+            "\"");
+      });
+}
+} // namespace detail
+
 /// Serializes the given `value`.
 /// There must be an overload of `operator<<` between `serialize::OutputArchive`
 /// and `Value` for this method to be well-formed. Currently, such an overload
@@ -73,6 +102,48 @@ void save(const std::vector<torch::Tensor>& tensor_vec, SaveToArgs&&... args) {
   archive.save_to(std::forward<SaveToArgs>(args)...);
 }
 
+/// Serializes the given `value` asynchronously.
+///
+/// The value is serialized into an in-memory buffer on the calling thread —
+/// this is the snapshot: once `save_async` returns, later mutations of the
+/// value (e.g. optimizer steps) no longer affect what gets written. The
+/// buffer is then streamed to `filename` from a background thread, so the
+/// caller resumes after the snapshot rather than after the (much slower)
+/// disk write. The returned future rethrows any write error when waited on;
+/// callers that need the file on disk (e.g. before exiting) must call
+/// `get()` on it.
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   torch::nn::Linear model(3, 4);
+///   auto pending = torch::save_async(model, "model.pt");
+///   // ... continue training ...
+///   pending.get(); // block until the checkpoint is on disk
+/// \endrst
+template <typename Value>
+std::future<void> save_async(const Value& value, std::string filename) {
+  auto buffer = std::make_shared<std::ostringstream>();
+  serialize::OutputArchive archive(
+      std::make_shared<jit::script::CompilationUnit>());
+  archive << value;
+  archive.save_to(*buffer);
+  return detail::stream_buffer_to_file_async(
+      std::move(buffer), std::move(filename));
+}
+
+/// Overload of `save_async` for script modules; the module (including all
+/// tensor storages) is serialized into memory synchronously and written to
+/// `filename` in the background, with the same future semantics as above.
+inline std::future<void> save_async(
+    const jit::script::Module& module,
+    std::string filename) {
+  auto buffer = std::make_shared<std::ostringstream>();
+  module.save(*buffer);
+  return detail::stream_buffer_to_file_async(
+      std::move(buffer), std::move(filename));
+}
+
 TORCH_API std::vector<char> pickle_save(const torch::IValue& ivalue);
 
 /// Deserializes the given `value`.
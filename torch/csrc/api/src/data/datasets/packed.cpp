@@ -0,0 +1,200 @@
+#include <torch/data/datasets/packed.h>
+
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <TH/THAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+namespace {
+// "TPACKED" in little-endian byte order. Values are written in the native
+// byte order of the producing machine, so the magic number doubles as an
+// endianness check.
+constexpr int64_t kMagicNumber = 0x0044454b43415054;
+constexpr int64_t kFormatVersion = 1;
+// Records and the fields within them start on this boundary, so tensor
+// views over the mapping are aligned the same way freshly allocated CPU
+// storage would be.
+constexpr size_t kAlignment = 64;
+// The header slots for the record count and the offset index position,
+// counted in int64 values from the start of the file. Both are back-patched
+// by `finish()`.
+constexpr size_t kNumRecordsSlot = 2;
+constexpr size_t kIndexPositionSlot = 3;
+
+size_t align_up(size_t offset) {
+  return (offset + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+int64_t read_int64(const char* data, size_t& offset, size_t size) {
+  TORCH_CHECK(
+      offset + sizeof(int64_t) <= size, "Packed dataset file is truncated");
+  int64_t value;
+  std::memcpy(&value, data + offset, sizeof value);
+  offset += sizeof value;
+  return value;
+}
+} // namespace
+
+PackedDataset::PackedDataset(const std::string& path) {
+  mapping_ = std::make_shared<at::DataPtr>(THMapAllocator::makeDataPtr(
+      path.c_str(), /*flags=*/0, /*size=*/0, &mapping_size_));
+  const char* data = static_cast<const char*>(mapping_->get());
+
+  size_t offset = 0;
+  TORCH_CHECK(
+      read_int64(data, offset, mapping_size_) == kMagicNumber,
+      "File at ", path, " is not a packed dataset file");
+  const auto version = read_int64(data, offset, mapping_size_);
+  TORCH_CHECK(
+      version == kFormatVersion,
+      "Unsupported packed dataset version ", version);
+  const auto num_records = read_int64(data, offset, mapping_size_);
+  const auto index_position = read_int64(data, offset, mapping_size_);
+  TORCH_CHECK(
+      num_records >= 0 && index_position > 0,
+      "File at ", path, " was not finished by PackedDatasetWriter");
+  const auto num_fields = read_int64(data, offset, mapping_size_);
+  TORCH_CHECK(
+      num_fields == 2,
+      "Expected a packed dataset with 2 fields (data, target), but found ",
+      num_fields);
+
+  size_t record_offset = 0;
+  for (int64_t f = 0; f < num_fields; ++f) {
+    Field field;
+    field.dtype =
+        static_cast<ScalarType>(read_int64(data, offset, mapping_size_));
+    const auto ndim = read_int64(data, offset, mapping_size_);
+    TORCH_CHECK(ndim >= 0, "Invalid field rank in packed dataset file");
+    field.nbytes = elementSize(field.dtype);
+    for (int64_t d = 0; d < ndim; ++d) {
+      const auto size = read_int64(data, offset, mapping_size_);
+      TORCH_CHECK(size >= 0, "Invalid field shape in packed dataset file");
+      field.sizes.push_back(size);
+      field.nbytes *= size;
+    }
+    field.offset = record_offset;
+    record_offset = align_up(record_offset + field.nbytes);
+    fields_.push_back(std::move(field));
+  }
+
+  offset = index_position;
+  record_offsets_.reserve(num_records);
+  for (int64_t i = 0; i < num_records; ++i) {
+    const auto record = read_int64(data, offset, mapping_size_);
+    TORCH_CHECK(
+        record >= 0 && record + record_offset <= int64_t(mapping_size_),
+        "Packed dataset record offset is out of bounds");
+    record_offsets_.push_back(record);
+  }
+}
+
+Tensor PackedDataset::view(size_t index, const Field& field) const {
+  char* data = static_cast<char*>(mapping_->get()) +
+      record_offsets_[index] + field.offset;
+  return torch::from_blob(
+      data, field.sizes, torch::TensorOptions().dtype(field.dtype));
+}
+
+Example<> PackedDataset::get(size_t index) {
+  return {view(index, fields_[0]), view(index, fields_[1])};
+}
+
+optional<size_t> PackedDataset::size() const {
+  return record_offsets_.size();
+}
+
+PackedDatasetWriter::PackedDatasetWriter(const std::string& path)
+    : stream_(path, std::ios::binary | std::ios::trunc) {
+  TORCH_CHECK(stream_, "Error opening packed dataset file at ", path);
+}
+
+void PackedDatasetWriter::write_tensor(const Tensor& tensor) {
+  const auto contiguous = tensor.cpu().contiguous();
+  stream_.write(
+      static_cast<const char*>(contiguous.data_ptr()),
+      contiguous.numel() * contiguous.element_size());
+  pad_to_alignment();
+}
+
+void PackedDatasetWriter::pad_to_alignment() {
+  static constexpr char zeros[kAlignment] = {};
+  const auto position = static_cast<size_t>(stream_.tellp());
+  stream_.write(zeros, align_up(position) - position);
+}
+
+void PackedDatasetWriter::write(const Example<>& example) {
+  TORCH_CHECK(!finished_, "PackedDatasetWriter is already finished");
+  const auto write_int64 = [&](int64_t value) {
+    stream_.write(reinterpret_cast<const char*>(&value), sizeof value);
+  };
+  if (fields_.empty()) {
+    // The first example fixes the record layout; write the header. The
+    // record count and index position are not known yet and are patched in
+    // `finish()`.
+    fields_.emplace_back(
+        example.data.scalar_type(), example.data.sizes().vec());
+    fields_.emplace_back(
+        example.target.scalar_type(), example.target.sizes().vec());
+    write_int64(kMagicNumber);
+    write_int64(kFormatVersion);
+    write_int64(/*num_records=*/0);
+    write_int64(/*index_position=*/0);
+    write_int64(fields_.size());
+    for (const auto& field : fields_) {
+      write_int64(static_cast<int64_t>(field.first));
+      write_int64(field.second.size());
+      for (const auto size : field.second) {
+        write_int64(size);
+      }
+    }
+  } else {
+    TORCH_CHECK(
+        example.data.scalar_type() == fields_[0].first &&
+            example.data.sizes().vec() == fields_[0].second &&
+            example.target.scalar_type() == fields_[1].first &&
+            example.target.sizes().vec() == fields_[1].second,
+        "All examples in a packed dataset must have the same shapes and "
+        "dtypes");
+  }
+  pad_to_alignment();
+  record_offsets_.push_back(stream_.tellp());
+  write_tensor(example.data);
+  write_tensor(example.target);
+  TORCH_CHECK(stream_, "Error writing packed dataset record");
+}
+
+void PackedDatasetWriter::finish() {
+  TORCH_CHECK(!finished_, "PackedDatasetWriter is already finished");
+  TORCH_CHECK(
+      !record_offsets_.empty(),
+      "Cannot finish a packed dataset with no examples");
+  finished_ = true;
+  const int64_t index_position = stream_.tellp();
+  stream_.write(
+      reinterpret_cast<const char*>(record_offsets_.data()),
+      record_offsets_.size() * sizeof(int64_t));
+  const int64_t num_records = record_offsets_.size();
+  stream_.seekp(kNumRecordsSlot * sizeof(int64_t));
+  stream_.write(reinterpret_cast<const char*>(&num_records), sizeof num_records);
+  stream_.seekp(kIndexPositionSlot * sizeof(int64_t));
+  stream_.write(
+      reinterpret_cast<const char*>(&index_position), sizeof index_position);
+  stream_.flush();
+  TORCH_CHECK(stream_, "Error finishing packed dataset file");
+}
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
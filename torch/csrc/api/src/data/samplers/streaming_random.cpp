@@ -0,0 +1,135 @@
+#include <torch/data/samplers/streaming_random.h>
+#include <torch/serialize/archive.h>
+#include <torch/types.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace samplers {
+namespace {
+
+/// Draws a fresh permutation seed from the global torch RNG, so that
+/// `torch::manual_seed` controls the shuffle order just like it does for
+/// `RandomSampler`'s `randperm`.
+int64_t draw_seed() {
+  return torch::randint(std::numeric_limits<int64_t>::max(), {1}, torch::kInt64)
+      .item<int64_t>();
+}
+
+/// Finalizer from splitmix64; a cheap invertible-ish mixer is all the round
+/// function needs, since the Feistel structure supplies the bijectivity.
+uint64_t mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+} // namespace
+
+StreamingRandomSampler::StreamingRandomSampler(int64_t size)
+    : size_(size), seed_(draw_seed()) {
+  rekey();
+}
+
+StreamingRandomSampler::~StreamingRandomSampler() = default;
+
+void StreamingRandomSampler::rekey() {
+  // The Feistel network operates on an even number of bits, i.e. on the
+  // smallest power-of-four domain covering [0, size). Cycle-walking in
+  // permute() maps the at most 3/4 of the domain that lands outside the
+  // range back into it, so the expected number of walks per index is < 4.
+  half_bits_ = 1;
+  while ((uint64_t(1) << (2 * half_bits_)) < static_cast<uint64_t>(size_)) {
+    ++half_bits_;
+  }
+  half_mask_ = (uint64_t(1) << half_bits_) - 1;
+  uint64_t key = static_cast<uint64_t>(seed_);
+  for (auto& round_key : round_keys_) {
+    key += 0x9e3779b97f4a7c15ULL;
+    round_key = mix64(key);
+  }
+}
+
+uint64_t StreamingRandomSampler::permute(uint64_t value) const {
+  do {
+    uint64_t left = value >> half_bits_;
+    uint64_t right = value & half_mask_;
+    for (const auto& round_key : round_keys_) {
+      const uint64_t new_right = left ^ (mix64(right + round_key) & half_mask_);
+      left = right;
+      right = new_right;
+    }
+    value = (left << half_bits_) | right;
+  } while (value >= static_cast<uint64_t>(size_));
+  return value;
+}
+
+void StreamingRandomSampler::reset(optional<size_t> new_size) {
+  size_ = new_size.value_or(static_cast<size_t>(size_));
+  index_ = 0;
+  seed_ = draw_seed();
+  rekey();
+}
+
+optional<std::vector<size_t>> StreamingRandomSampler::next(size_t batch_size) {
+  AT_ASSERT(index_ <= size_);
+  const size_t remaining_indices = size_ - index_;
+  if (remaining_indices == 0) {
+    return nullopt;
+  }
+  std::vector<size_t> index_batch(std::min(batch_size, remaining_indices));
+  for (auto& index : index_batch) {
+    index = permute(static_cast<uint64_t>(index_++));
+  }
+  return index_batch;
+}
+
+void StreamingRandomSampler::save(serialize::OutputArchive& archive) const {
+  archive.write(
+      "size",
+      torch::tensor(size_, torch::kInt64),
+      /*is_buffer=*/true);
+  archive.write(
+      "index",
+      torch::tensor(index_, torch::kInt64),
+      /*is_buffer=*/true);
+  archive.write(
+      "seed",
+      torch::tensor(seed_, torch::kInt64),
+      /*is_buffer=*/true);
+}
+
+void StreamingRandomSampler::load(serialize::InputArchive& archive) {
+  auto tensor = torch::empty(1, torch::kInt64);
+  archive.read(
+      "size",
+      tensor,
+      /*is_buffer=*/true);
+  size_ = tensor.item<int64_t>();
+  archive.read(
+      "index",
+      tensor,
+      /*is_buffer=*/true);
+  index_ = tensor.item<int64_t>();
+  archive.read(
+      "seed",
+      tensor,
+      /*is_buffer=*/true);
+  seed_ = tensor.item<int64_t>();
+  rekey();
+}
+
+size_t StreamingRandomSampler::index() const noexcept {
+  return index_;
+}
+
+} // namespace samplers
+} // namespace data
+} // namespace torch
@@ -1,6 +1,7 @@
 #include <torch/nn/module.h>
 
 #include <torch/ordered_dict.h>
+#include <torch/utils.h>
 
 #include <torch/csrc/autograd/generated/VariableType.h>
 
@@ -12,6 +13,8 @@
 #include <ostream>
 #include <string>
 #include <typeinfo>
+#include <unordered_set>
+#include <utility>
 
 namespace torch {
 namespace nn {
@@ -150,6 +153,53 @@ std::vector<Tensor> Module::parameters(bool recurse) const {
   return result;
 }
 
+std::vector<Tensor> Module::flatten_parameters() {
+  NoGradGuard no_grad;
+  // Group parameters per dtype/device pair, preserving encounter order.
+  using GroupKey = std::pair<torch::Dtype, torch::Device>;
+  std::vector<std::pair<GroupKey, std::vector<Tensor>>> groups;
+  std::unordered_set<at::TensorImpl*> seen;
+  for (auto& parameter : parameters()) {
+    if (!parameter.defined() ||
+        !seen.insert(parameter.unsafeGetTensorImpl()).second) {
+      continue;
+    }
+    GroupKey key(parameter.scalar_type(), parameter.device());
+    auto it = std::find_if(
+        groups.begin(),
+        groups.end(),
+        [&](const std::pair<GroupKey, std::vector<Tensor>>& g) {
+          return g.first == key;
+        });
+    if (it == groups.end()) {
+      groups.emplace_back(key, std::vector<Tensor>());
+      it = std::prev(groups.end());
+    }
+    it->second.push_back(parameter);
+  }
+  std::vector<Tensor> flat_tensors;
+  flat_tensors.reserve(groups.size());
+  for (auto& group : groups) {
+    int64_t total_numel = 0;
+    for (const auto& parameter : group.second) {
+      total_numel += parameter.numel();
+    }
+    Tensor flat = torch::empty({total_numel}, group.second.front().options());
+    int64_t offset = 0;
+    for (auto& parameter : group.second) {
+      const int64_t numel = parameter.numel();
+      Tensor view = flat.narrow(0, offset, numel).view(parameter.sizes());
+      view.copy_(parameter);
+      // Re-seat the parameter on the view; the autograd metadata (and any
+      // handles to the parameter) carry over untouched.
+      parameter.set_data(view);
+      offset += numel;
+    }
+    flat_tensors.push_back(std::move(flat));
+  }
+  return flat_tensors;
+}
+
 OrderedDict<std::string, Tensor> Module::named_parameters(bool recurse) const {
   if (!recurse) {
     return parameters_;
@@ -0,0 +1,166 @@
+#include <torch/optim/async_sparse_sgd.h>
+
+#include <torch/csrc/autograd/variable.h>
+#include <torch/optim/optimizer.h>
+#include <torch/optim/serialize.h>
+#include <torch/types.h>
+#include <torch/utils.h>
+
+#include <ATen/ATen.h>
+
+#include <utility>
+
+namespace torch {
+namespace optim {
+AsyncSparseSGDOptions::AsyncSparseSGDOptions(double learning_rate)
+    : learning_rate_(learning_rate) {}
+
+AsyncSparseSGD::~AsyncSparseSGD() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  job_cv_.notify_all();
+  if (worker_started_) {
+    worker_.join();
+  }
+}
+
+void AsyncSparseSGD::step() {
+  {
+    // Surface an applier failure on the training thread promptly instead of
+    // only from the next sync().
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_) {
+      auto error = error_;
+      error_ = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+  for (size_t i = 0; i < parameters_.size(); ++i) {
+    Tensor p = parameters_.at(i);
+
+    if (!p.grad().defined()) {
+      continue;
+    }
+
+    if (p.grad().is_sparse()) {
+      // Snapshot the gradient: zero_grad() and the next backward() may
+      // mutate it before the applier gets to it.
+      NoGradGuard guard;
+      enqueue(i, p.grad().clone());
+      continue;
+    }
+
+    auto update = p.grad();
+
+    if (options.weight_decay() > 0) {
+      NoGradGuard guard;
+      update += options.weight_decay() * p;
+    }
+
+    NoGradGuard guard;
+    p.add_(-options.learning_rate() * update);
+  }
+  iteration_ += 1;
+}
+
+void AsyncSparseSGD::enqueue(size_t param_index, Tensor grad) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (enqueued_tickets_.size() < parameters_.size()) {
+    enqueued_tickets_.resize(parameters_.size(), 0);
+    applied_tickets_.resize(parameters_.size(), 0);
+  }
+  uint64_t ticket = ++enqueued_tickets_[param_index];
+  jobs_.push_back(Job{param_index, std::move(grad), ticket});
+  if (!worker_started_) {
+    worker_ = std::thread([this] { run(); });
+    worker_started_ = true;
+  }
+  job_cv_.notify_one();
+}
+
+void AsyncSparseSGD::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    job_cv_.wait(lock, [&] { return !jobs_.empty() || shutdown_; });
+    if (jobs_.empty()) {
+      // Shutting down; pending jobs (if any) have all been drained above.
+      return;
+    }
+    Job job = std::move(jobs_.front());
+    jobs_.pop_front();
+    Tensor p = parameters_.at(job.param_index);
+    busy_ = true;
+    lock.unlock();
+    try {
+      NoGradGuard guard;
+      // coalesce() merges duplicate rows and sorts the survivors by index,
+      // so the scattered writes below walk the table in ascending row
+      // order; the sparse add_ then does one vectorized axpy per row.
+      p.add_(job.grad.coalesce(), -options.learning_rate());
+    } catch (...) {
+      lock.lock();
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+      applied_tickets_[job.param_index] = job.ticket;
+      busy_ = false;
+      done_cv_.notify_all();
+      continue;
+    }
+    lock.lock();
+    applied_tickets_[job.param_index] = job.ticket;
+    busy_ = false;
+    done_cv_.notify_all();
+  }
+}
+
+void AsyncSparseSGD::wait_all() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [&] { return jobs_.empty() && !busy_; });
+  if (error_) {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void AsyncSparseSGD::sync() {
+  wait_all();
+}
+
+void AsyncSparseSGD::sync(size_t i) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (i >= enqueued_tickets_.size()) {
+    return;
+  }
+  done_cv_.wait(
+      lock, [&] { return applied_tickets_[i] >= enqueued_tickets_[i]; });
+  if (error_) {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+size_t AsyncSparseSGD::pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return jobs_.size() + (busy_ ? 1 : 0);
+}
+
+void AsyncSparseSGD::save(serialize::OutputArchive& archive) const {
+  // The snapshot must include every update that has been enqueued.
+  wait_all();
+  optim::serialize(archive, "iteration_", iteration_);
+}
+
+void AsyncSparseSGD::load(serialize::InputArchive& archive) {
+  optim::serialize(archive, "iteration_", iteration_);
+}
+
+int64_t AsyncSparseSGD::iteration() const {
+  return iteration_;
+}
+} // namespace optim
+} // namespace torch
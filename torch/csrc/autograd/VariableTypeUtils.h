@@ -41,7 +41,9 @@ namespace torch { namespace autograd {
 
 inline void check_inplace(const Tensor& tensor) {
   auto& var = static_cast<const Variable&>(tensor);
-  if (var.requires_grad() && var.is_leaf() && GradMode::is_enabled()) {
+  // Test GradMode first: it is a cheap thread-local read and false for all
+  // of inference, so the requires_grad()/is_leaf() loads are never touched.
+  if (GradMode::is_enabled() && var.requires_grad() && var.is_leaf()) {
     AT_ERROR(
       "a leaf Variable that requires grad has been used in an in-place operation.");
   }
@@ -119,6 +121,11 @@ inline std::vector<Tensor> as_view(const Tensor & base, std::vector<Tensor> tens
 }
 
 inline void check_no_requires_grad(const Tensor& tensor, const char* name) {
+  // No derivative will be computed with grad mode disabled, so there is
+  // nothing to complain about; skip the per-argument inspection.
+  if (!GradMode::is_enabled()) {
+    return;
+  }
   auto& var = static_cast<const Variable&>(tensor);
   if (var.defined() && var.requires_grad()) {
     std::string msg = "the derivative for '";
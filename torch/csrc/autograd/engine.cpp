@@ -20,6 +20,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -76,12 +77,34 @@ struct CompareNodeTaskTime {
   }
 };
 
+// Note [Sharded ready queue]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// By default every ReadyQueue is a single priority heap under one mutex.
+// With many threads running backward concurrently on CPU they all push
+// into the same queue and the mutex becomes the scalability bottleneck.
+// Setting TORCH_AUTOGRAD_READY_QUEUE_SHARDS=N (N > 1) splits each queue
+// into N independently locked heaps; producers pick a shard based on
+// their thread id, so concurrent pushes rarely touch the same lock, and
+// consumers drain any non-empty shard.  This trades the strict global
+// sequence_nr ordering (a scheduling heuristic, not a correctness
+// requirement) within a queue for scalable pushes.
 struct ReadyQueue {
-  std::priority_queue<NodeTask, std::vector<NodeTask>, CompareNodeTaskTime> heap_;
-  // To notify threads waiting on the ReadyQueue of available tasks on the heap_
+  struct Shard {
+    // To protect read and writes to heap_
+    std::mutex mutex_;
+    std::priority_queue<NodeTask, std::vector<NodeTask>, CompareNodeTaskTime> heap_;
+  };
+  std::vector<std::unique_ptr<Shard>> shards_;
+  // Number of tasks across all shards
+  std::atomic<int64_t> size_{0};
+  // Number of consumers blocked in pop()
+  std::atomic<int> waiters_{0};
+  // To notify threads waiting on the ReadyQueue of available tasks
   std::condition_variable not_empty_;
-  // To protect read and writes to heap_
-  std::mutex mutex_;
+  // Only used for sleeping/waking consumers; heaps have their own locks
+  std::mutex wait_mutex_;
+
+  ReadyQueue();
 
   // incrementOutstandingTasks indicates whether or not we should increment
   // 'outstanding_tasks_' for the associated GraphTask. This should mostly
@@ -90,6 +113,11 @@ struct ReadyQueue {
   void push(NodeTask item, bool incrementOutstandingTasks = true);
   void pushShutdownTask();
   NodeTask pop();
+  bool empty();
+
+ private:
+  Shard& producer_shard();
+  void push_to_shard(NodeTask item);
 };
 
 // Note [Reentrant backwards]
@@ -157,35 +185,94 @@ int NodeTask::getReentrantDepth() const {
   return graph_task->reentrant_depth_;
 }
 
-auto ReadyQueue::push(NodeTask item, bool incrementOutstandingTasks) -> void {
+static size_t num_ready_queue_shards() {
+  static size_t num_shards = []() -> size_t {
+    const char* value = std::getenv("TORCH_AUTOGRAD_READY_QUEUE_SHARDS");
+    int shards = value ? std::atoi(value) : 1;
+    return shards > 1 ? shards : 1;
+  }();
+  return num_shards;
+}
+
+ReadyQueue::ReadyQueue() : shards_(num_ready_queue_shards()) {
+  for (auto& shard : shards_) {
+    shard.reset(new Shard());
+  }
+}
+
+static size_t this_thread_shard_id() {
+  static std::atomic<size_t> next_producer{0};
+  // Distinct threads get distinct shards (modulo the shard count), so
+  // concurrent pushes mostly hit different locks.
+  static thread_local size_t producer_id = next_producer++;
+  return producer_id;
+}
+
+auto ReadyQueue::producer_shard() -> Shard& {
+  if (shards_.size() == 1) {
+    return *shards_[0];
+  }
+  return *shards_[this_thread_shard_id() % shards_.size()];
+}
+
+auto ReadyQueue::push_to_shard(NodeTask item) -> void {
+  auto& shard = producer_shard();
   {
     // Lock mutex for writing to heap_
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (incrementOutstandingTasks) {
-      std::shared_ptr<GraphTask> graph_task = item.base_.lock();
-      TORCH_INTERNAL_ASSERT(graph_task, "GraphTask is no longer valid!");
-      ++graph_task->outstanding_tasks_;
-    }
-    heap_.push(std::move(item));
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.heap_.push(std::move(item));
+  }
+  size_++;
+  if (waiters_.load() > 0) {
+    // Taking wait_mutex_ avoids a lost wakeup: a consumer holds it between
+    // re-checking size_ and going to sleep.
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    not_empty_.notify_one();
   }
-  not_empty_.notify_one();
 }
 
-auto ReadyQueue::pushShutdownTask() -> void {
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    heap_.push(NodeTask({}, nullptr, InputBuffer(0), true));
+auto ReadyQueue::push(NodeTask item, bool incrementOutstandingTasks) -> void {
+  if (incrementOutstandingTasks) {
+    std::shared_ptr<GraphTask> graph_task = item.base_.lock();
+    TORCH_INTERNAL_ASSERT(graph_task, "GraphTask is no longer valid!");
+    ++graph_task->outstanding_tasks_;
   }
-  not_empty_.notify_one();
+  push_to_shard(std::move(item));
+}
+
+auto ReadyQueue::pushShutdownTask() -> void {
+  push_to_shard(NodeTask({}, nullptr, InputBuffer(0), true));
 }
 
 auto ReadyQueue::pop() -> NodeTask {
-  // Lock mutex for accesses to heap_
-  std::unique_lock<std::mutex> lock(mutex_);
-  not_empty_.wait(lock, [this]{ return !heap_.empty(); });
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  auto task = std::move(const_cast<NodeTask&>(heap_.top())); heap_.pop();
-  return task;
+  while (true) {
+    if (size_.load() > 0) {
+      // Start at this consumer's own shard to keep producer/consumer
+      // pairings stable, then sweep the rest.
+      size_t start = shards_.size() == 1
+          ? 0 : this_thread_shard_id() % shards_.size();
+      for (size_t i = 0; i < shards_.size(); ++i) {
+        auto& shard = *shards_[(start + i) % shards_.size()];
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        if (!shard.heap_.empty()) {
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+          auto task = std::move(const_cast<NodeTask&>(shard.heap_.top()));
+          shard.heap_.pop();
+          size_--;
+          return task;
+        }
+      }
+      // Another consumer drained the task we saw; fall through and wait.
+    }
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    waiters_++;
+    not_empty_.wait(lock, [this]{ return size_.load() > 0; });
+    waiters_--;
+  }
+}
+
+auto ReadyQueue::empty() -> bool {
+  return size_.load() == 0;
 }
 
 // This limit is based on the default python recursion limit which is 1000
@@ -197,8 +284,7 @@ Engine::Engine() : max_recursion_depth_(100) {}
 Engine::~Engine() {
   bool noBackward = true;
   for (auto& queue: ready_queues_) {
-    std::lock_guard<std::mutex> lock(queue->mutex_);
-    noBackward =  noBackward && queue->heap_.empty();
+    noBackward =  noBackward && queue->empty();
   }
   if (noBackward) {
     for (auto& queue : ready_queues_) {
@@ -592,6 +678,16 @@ void Engine::evaluate_function(
 
     if (!next.is_valid()) continue;
 
+    // Skip functions that aren't supposed to be executed. They were pruned
+    // from dependency counting as well, so this must happen before the
+    // dependency lookup below.
+    if (!exec_info_.empty()) {
+      auto info_it = exec_info_.find(next.function.get());
+      if (info_it == exec_info_.end() || !info_it->second.should_execute()) {
+        continue;
+      }
+    }
+
     // Check if the next function is ready to be computed
     bool is_ready = false;
     auto& dependencies = graph_task->dependencies_;
@@ -608,13 +704,6 @@ void Engine::evaluate_function(
     auto& not_ready = graph_task->not_ready_;
     auto not_ready_it = not_ready.find(next.function.get());
     if (not_ready_it == not_ready.end()) {
-      // Skip functions that aren't supposed to be executed
-      if (!exec_info_.empty()) {
-        auto it = exec_info_.find(next.function.get());
-        if (it == exec_info_.end() || !it->second.should_execute()) {
-          continue;
-        }
-      }
       // No buffers have been allocated for the function
       InputBuffer input_buffer(next.function->num_inputs());
 
@@ -660,11 +749,25 @@ auto Engine::compute_dependencies(Node* root, GraphTask& task) -> void {
 
   // Queue contains all nodes that will start propagating gradients.
   // We no longer have to expand functions that don't require grad.
+  // When the caller restricted the run to a set of inputs (exec_info_ is
+  // populated), the traversal also stops at functions that are not
+  // ancestors of those inputs: they will never execute, so counting their
+  // dependencies (and hashing every frozen parameter's node) is wasted
+  // work. This keeps the counts for executed functions exact, because
+  // every function with an edge into an executed function is itself
+  // marked for execution by init_to_execute.
   auto& dependencies = task.dependencies_;
+  const auto& exec_info = task.exec_info_;
   while (!queue.empty()) {
     auto fn = queue.back(); queue.pop_back();
     for (const auto& edge : fn->next_edges()) {
       if (auto next_ptr = edge.function.get()) {
+        if (!exec_info.empty()) {
+          auto it = exec_info.find(next_ptr);
+          if (it == exec_info.end() || !it->second.should_execute()) {
+            continue;
+          }
+        }
         dependencies[next_ptr] += 1;
         const bool was_inserted = seen.insert(next_ptr).second;
         if (was_inserted) queue.push_back(next_ptr);
@@ -708,13 +811,14 @@ auto Engine::execute(const edge_list& roots,
       create_graph,
       worker_device == NO_DEVICE ? 0 : total_depth + 1);
 
-  // Now compute the dependencies for all executable functions and queue the root
+  // Now compute the dependencies for all executable functions and queue the
+  // root. Marking the executed subgraph happens first so that dependency
+  // counting can prune everything outside it.
   auto graph_root = std::make_shared<GraphRoot>(roots, inputs);
-  compute_dependencies(graph_root.get(), *graph_task);
-
   if (!outputs.empty()) {
     graph_task->init_to_execute(*graph_root, outputs);
   }
+  compute_dependencies(graph_root.get(), *graph_task);
   return execute_with_graph_task(graph_task, graph_root);
 }
 
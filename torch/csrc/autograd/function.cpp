@@ -6,7 +6,9 @@
 #include <ATen/ATen.h>
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstdlib>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -15,6 +17,110 @@
 
 namespace torch { namespace autograd {
 
+// Note [Autograd node allocation cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// High-frequency training loops build and tear down a small graph every
+// step: every Node is heap-allocated during forward and freed during
+// backward, typically on a different thread (the engine workers own the
+// last reference). At tens of thousands of steps per second this churn
+// contends on the global allocator's locks.
+//
+// Node::operator new/delete therefore recycle node storage through
+// thread-local free lists bucketed by size class. A freed block goes onto
+// the freeing thread's list and is reused by that thread's next
+// allocation of the same class, so the hot path touches no shared state
+// at all; blocks migrate between threads only as ownership of free
+// storage, never concurrently. Each thread caps its cached bytes and
+// releases everything when it exits.
+//
+// Bulk-freeing whole graphs as a region is deliberately not attempted:
+// nodes are kept alive by shared_ptr references that can outlive the
+// backward pass (user-held grad_fn handles, hooks, retain_graph), so no
+// single point of retirement owns all of them. The free lists recover the
+// same malloc contention without changing ownership semantics.
+
+namespace {
+
+constexpr size_t kNodeAllocHeaderSize = 2 * sizeof(size_t);
+constexpr size_t kNodeCacheGranularity = 64;
+constexpr size_t kNodeCacheBuckets = 16; // covers blocks up to 1 KiB
+constexpr size_t kNodeCacheMaxBytesPerThread = 4 * 1024 * 1024;
+
+struct NodeBlock {
+  NodeBlock* next;
+};
+
+struct NodeAllocCache {
+  std::array<NodeBlock*, kNodeCacheBuckets> free_lists = {{nullptr}};
+  size_t cached_bytes = 0;
+
+  ~NodeAllocCache() {
+    for (auto& head : free_lists) {
+      while (head != nullptr) {
+        NodeBlock* block = head;
+        head = block->next;
+        std::free(block);
+      }
+    }
+  }
+};
+
+thread_local NodeAllocCache node_alloc_cache;
+
+bool nodeCacheEnabled() {
+  static const bool enabled =
+      std::getenv("TORCH_AUTOGRAD_DISABLE_NODE_CACHE") == nullptr;
+  return enabled;
+}
+
+} // namespace
+
+void* Node::operator new(size_t size) {
+  const size_t total = size + kNodeAllocHeaderSize;
+  const size_t bucket = (total + kNodeCacheGranularity - 1) / kNodeCacheGranularity;
+  if (nodeCacheEnabled() && bucket <= kNodeCacheBuckets) {
+    const size_t rounded = bucket * kNodeCacheGranularity;
+    auto& head = node_alloc_cache.free_lists[bucket - 1];
+    void* raw;
+    if (head != nullptr) {
+      raw = head;
+      head = head->next;
+      node_alloc_cache.cached_bytes -= rounded;
+    } else {
+      raw = std::malloc(rounded);
+      if (raw == nullptr) {
+        throw std::bad_alloc();
+      }
+    }
+    *static_cast<size_t*>(raw) = rounded;
+    return static_cast<char*>(raw) + kNodeAllocHeaderSize;
+  }
+  void* raw = std::malloc(total);
+  if (raw == nullptr) {
+    throw std::bad_alloc();
+  }
+  // size 0 marks blocks that bypass the cache
+  *static_cast<size_t*>(raw) = 0;
+  return static_cast<char*>(raw) + kNodeAllocHeaderSize;
+}
+
+void Node::operator delete(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  void* raw = static_cast<char*>(ptr) - kNodeAllocHeaderSize;
+  const size_t rounded = *static_cast<size_t*>(raw);
+  if (rounded == 0 ||
+      node_alloc_cache.cached_bytes + rounded > kNodeCacheMaxBytesPerThread) {
+    std::free(raw);
+    return;
+  }
+  auto* block = static_cast<NodeBlock*>(raw);
+  block->next = node_alloc_cache.free_lists[rounded / kNodeCacheGranularity - 1];
+  node_alloc_cache.free_lists[rounded / kNodeCacheGranularity - 1] = block;
+  node_alloc_cache.cached_bytes += rounded;
+}
+
 /// Monotonically incrementing (thread local!) counter to supply sequence
 /// numbers.
 thread_local uint64_t Function_next_sequence_nr_ = 0;
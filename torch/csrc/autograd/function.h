@@ -13,6 +13,7 @@
 
 #include <ATen/ATen.h>
 #include <c10/util/Exception.h>
+#include <c10/util/SmallVector.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -30,7 +31,10 @@ struct FunctionPreHook;
 
 using tensor_list = std::vector<at::Tensor>;
 using variable_list = std::vector<Variable>;
-using edge_list = std::vector<Edge>;
+// Most nodes have one or two next edges (unary/binary ops), so inline
+// storage spares the per-node heap allocation that a plain vector would
+// make while wiring up each freshly built graph.
+using edge_list = at::SmallVector<Edge, 2>;
 using saved_variable_list = std::vector<SavedVariable>;
 using IndexRange = std::pair<size_t, size_t>;
 
@@ -110,6 +114,20 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
   Node& operator=(Node&& other) = delete;
   virtual ~Node() = default;
 
+  /// Nodes (and their subclasses) are allocated once per forward op and
+  /// freed during backward, so at high step rates graph churn contends on
+  /// the global allocator - the forward thread allocates while the engine
+  /// worker threads free. These overloads route node storage through a
+  /// thread-local size-bucketed cache instead; see
+  /// Note [Autograd node allocation cache] in function.cpp.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+  /// Class-scope operator new hides the global placement form; forward it.
+  static void* operator new(size_t, void* ptr) {
+    return ptr;
+  }
+  static void operator delete(void*, void*) {}
+
   /// Evaluates the function on the given inputs and returns the result of the
   /// function call.
   variable_list operator()(variable_list&& inputs) {
@@ -418,6 +436,7 @@ edge_list collect_next_edges(Variables&&... variables) {
   if (!GradMode::is_enabled())
     return {};
   detail::MakeNextFunctionList make;
+  make.next_edges.reserve(count_variables(variables...));
   make.apply(std::forward<Variables>(variables)...);
   return std::move(make.next_edges);
 }
@@ -36,7 +36,12 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
       .value("NVTX", ProfilerState::NVTX);
 
   py::class_<ProfilerConfig>(m, "ProfilerConfig")
-      .def(py::init<ProfilerState, bool>());
+      .def(py::init<ProfilerState, bool>())
+      .def(py::init<ProfilerState, bool, int>());
+
+  py::class_<CudaUtilizationSample>(m, "CudaUtilizationSample")
+      .def_readonly("busy_polls", &CudaUtilizationSample::busy_polls)
+      .def_readonly("total_polls", &CudaUtilizationSample::total_polls);
 
   py::class_<Event>(m, "ProfilerEvent")
       .def("kind", &Event::kind)
@@ -50,6 +55,12 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
 
   m.def("_enable_profiler", enableProfiler);
   m.def("_disable_profiler", disableProfiler);
+  m.def(
+      "_enable_cuda_utilization_poller",
+      enableCudaUtilizationPoller,
+      py::arg("interval_us") = 1000);
+  m.def("_disable_cuda_utilization_poller", disableCudaUtilizationPoller);
+  m.def("_read_cuda_utilization", readCudaUtilization);
 
   m.def("_push_range", [](std::string name) { pushRange(std::move(name)); });
   m.def("_pop_range", []() { popRange(); });
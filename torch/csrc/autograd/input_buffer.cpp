@@ -1,5 +1,7 @@
 #include <torch/csrc/autograd/input_buffer.h>
 
+#include <torch/csrc/autograd/grad_mode.h>
+
 #include <c10/core/DeviceGuard.h>
 #include <c10/core/StreamGuard.h>
 #include <c10/core/Event.h>
@@ -25,12 +27,29 @@ namespace torch { namespace autograd {
       } else {
           buffer[pos] = var + old_var;
       }
-    } else {
-      if (var.is_sparse() && !old_var.is_sparse() && old_var.is_contiguous() && old_var.storage().use_count() == 1) {
+    } else if (var.is_sparse()) {
+      if (old_var.is_contiguous() && old_var.storage().use_count() == 1) {
           buffer[pos] = old_var.add_(var);
       } else {
           buffer[pos] = old_var + var;
       }
+    } else {
+      // dense + dense: accumulate in place into whichever operand provably
+      // owns its tensor and storage exclusively, instead of allocating a new
+      // tensor per accumulation. With repeated fan-in (the second and later
+      // additions to a slot) old_var is the freshly allocated sum from the
+      // previous addition, so the in-place path is the common one. Skipped
+      // when grad mode is on: the accumulated value may then be recorded in
+      // the graph and must not be mutated.
+      if (!GradMode::is_enabled()
+          && old_var.use_count() == 1 && old_var.storage().use_count() == 1) {
+          old_var.add_(var);
+      } else if (!GradMode::is_enabled()
+          && var.use_count() == 1 && var.storage().use_count() == 1) {
+          buffer[pos] = var.add_(old_var);
+      } else {
+          buffer[pos] = old_var + var;
+      }
     }
   }
 
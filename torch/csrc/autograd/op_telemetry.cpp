@@ -0,0 +1,180 @@
+#include <torch/csrc/autograd/op_telemetry.h>
+
+#include <torch/csrc/autograd/profiler.h>
+#include <torch/csrc/autograd/record_function.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+namespace {
+
+OpTelemetrySegment* segment = nullptr;
+
+// Slot returned for ops that can't be recorded (name table full).
+constexpr uint32_t kInvalidSlot = UINT32_MAX;
+
+// Creates (or attaches to) the shared memory segment. The pages come back
+// zero-filled, which is exactly the initial counter state we want; the
+// header is written last so a scraper that validates `magic` never sees a
+// partially initialized segment.
+OpTelemetrySegment* mapSegment() {
+#ifndef _WIN32
+  std::string name = "/torch_op_telemetry." + std::to_string(getpid());
+  if (const char* name_override = std::getenv("TORCH_OP_TELEMETRY_NAME")) {
+    name = name_override;
+  }
+  int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  if (ftruncate(fd, sizeof(OpTelemetrySegment)) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  void* mem = mmap(
+      nullptr,
+      sizeof(OpTelemetrySegment),
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED,
+      fd,
+      0);
+  close(fd);
+  if (mem == MAP_FAILED) {
+    return nullptr;
+  }
+  auto* seg = static_cast<OpTelemetrySegment*>(mem);
+  seg->version = kTelemetryVersion;
+  seg->max_ops = kTelemetryMaxOps;
+  seg->magic = kTelemetryMagic;
+  return seg;
+#else
+  return nullptr;
+#endif
+}
+
+// Maps an op name to its slot in the segment. The thread-local cache makes
+// the steady-state lookup a single small-string hash; the global intern
+// table (and its mutex) is only touched the first time a thread sees a
+// name.
+uint32_t lookupSlot(const char* name) {
+  static thread_local std::unordered_map<std::string, uint32_t> local_cache;
+  std::string key(name);
+  auto it = local_cache.find(key);
+  if (it != local_cache.end()) {
+    return it->second;
+  }
+
+  static std::mutex intern_mutex;
+  static std::unordered_map<std::string, uint32_t> intern_table;
+  uint32_t slot = kInvalidSlot;
+  {
+    std::lock_guard<std::mutex> guard(intern_mutex);
+    auto interned = intern_table.find(key);
+    if (interned != intern_table.end()) {
+      slot = interned->second;
+    } else if (
+        segment->num_ops.load(std::memory_order_relaxed) < kTelemetryMaxOps) {
+      slot = segment->num_ops.load(std::memory_order_relaxed);
+      auto& entry = segment->entries[slot];
+      strncpy(entry.name, name, kTelemetryMaxNameLen - 1);
+      entry.name[kTelemetryMaxNameLen - 1] = '\0';
+      // Publish the slot only after the name is fully written.
+      segment->num_ops.store(slot + 1, std::memory_order_release);
+      intern_table.emplace(key, slot);
+    } else {
+      // Table full: remember the miss so we don't retake the lock.
+      intern_table.emplace(key, kInvalidSlot);
+    }
+  }
+  local_cache.emplace(std::move(key), slot);
+  return slot;
+}
+
+size_t bucketFor(int64_t duration_ns) {
+  uint64_t us = static_cast<uint64_t>(duration_ns) / 1000;
+  size_t bucket = 0;
+  while (us > 1 && bucket < kTelemetryNumBuckets - 1) {
+    us >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+// Start times of the in-flight RecordFunctions on this thread. RecordFunction
+// scopes nest strictly per thread, so a stack pairs starts with ends.
+thread_local std::vector<int64_t> start_times;
+
+void telemetryStart(const RecordFunction& /* unused */) {
+  start_times.push_back(getTime());
+}
+
+void telemetryEnd(const RecordFunction& fn) {
+  if (start_times.empty()) {
+    return;
+  }
+  const int64_t duration_ns = getTime() - start_times.back();
+  start_times.pop_back();
+
+  const char* name = fn.name().str();
+  if (name == nullptr) {
+    return;
+  }
+  const uint32_t slot = lookupSlot(name);
+  if (slot == kInvalidSlot) {
+    return;
+  }
+  auto& entry = segment->entries[slot];
+  entry.count.fetch_add(1, std::memory_order_relaxed);
+  entry.total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  entry.buckets[bucketFor(duration_ns)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+struct OpTelemetryRegistration {
+  OpTelemetryRegistration() {
+    const char* enable_c_str = std::getenv("TORCH_OP_TELEMETRY");
+    if (!enable_c_str || std::string(enable_c_str) != "1") {
+      return;
+    }
+    segment = mapSegment();
+    if (segment == nullptr) {
+      return;
+    }
+    pushCallback(
+        &telemetryStart,
+        &telemetryEnd,
+        /*needs_inputs=*/false,
+        /*sampled=*/false);
+  }
+};
+
+OpTelemetryRegistration registration;
+
+} // namespace
+
+bool opTelemetryEnabled() {
+  return segment != nullptr;
+}
+
+const OpTelemetrySegment* opTelemetrySegment() {
+  return segment;
+}
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+// Always-on per-operator latency telemetry.
+//
+// When TORCH_OP_TELEMETRY=1 is set in the environment, a RecordFunction
+// observer is registered at load time that accumulates, per operator name, a
+// call count, total wall time and a log2 latency histogram. The counters
+// live in a POSIX shared memory segment (name configurable via
+// TORCH_OP_TELEMETRY_NAME, default "/torch_op_telemetry.<pid>") so an
+// external agent can scrape them without stopping or instrumenting the
+// process. Unlike the full profiler this records no per-event data - just
+// relaxed atomic increments on the end of each op - so it is cheap enough to
+// leave enabled in production.
+//
+// Scrapers should mmap the segment read-only and validate `magic` and
+// `version` before interpreting it. Entries [0, num_ops) are valid; an
+// entry's name is fully written before its counters first become non-zero.
+
+constexpr size_t kTelemetryMaxOps = 512;
+constexpr size_t kTelemetryMaxNameLen = 64;
+// bucket i counts durations in [2^i, 2^(i+1)) microseconds; bucket 0 also
+// includes sub-microsecond calls and the last bucket is unbounded above.
+constexpr size_t kTelemetryNumBuckets = 16;
+constexpr uint64_t kTelemetryMagic = 0x31304554504f54ULL; // "TOPTE01"
+constexpr uint32_t kTelemetryVersion = 1;
+
+struct OpTelemetryEntry {
+  char name[kTelemetryMaxNameLen]; // NUL-terminated, truncated if longer
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> total_ns;
+  std::atomic<uint64_t> buckets[kTelemetryNumBuckets];
+};
+
+struct OpTelemetrySegment {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t max_ops;
+  std::atomic<uint32_t> num_ops;
+  uint32_t unused;
+  OpTelemetryEntry entries[kTelemetryMaxOps];
+};
+
+// Whether the observer is active (i.e. TORCH_OP_TELEMETRY=1 was set and the
+// segment could be created).
+TORCH_API bool opTelemetryEnabled();
+
+// The live segment, or nullptr when telemetry is disabled. Mainly for tests
+// and in-process inspection; external agents read the shared memory segment
+// directly.
+TORCH_API const OpTelemetrySegment* opTelemetrySegment();
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
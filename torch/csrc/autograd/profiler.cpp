@@ -1,11 +1,18 @@
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/jit/code_template.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <list>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace torch { namespace autograd { namespace profiler {
@@ -21,6 +28,13 @@ void registerCUDAMethods(CUDAStubs* stubs) {
 }
 
 ProfilerState state = ProfilerState::Disabled;
+// Sampling rate of the running CUDA profiling session; see
+// ProfilerConfig::cuda_sampling_rate. Each thread samples independently:
+// the decision made at push is remembered on a per-thread stack so the
+// matching pop records (or skips) its cudaEvent consistently.
+int cuda_sampling_rate = 1;
+thread_local uint64_t cuda_sample_counter = 0;
+thread_local std::vector<bool> cuda_sample_stack;
 uint16_t next_thread_id = 0;
 std::mutex all_event_lists_mutex;
 std::list<std::shared_ptr<RangeEventList>> all_event_lists;
@@ -91,11 +105,16 @@ void pushRangeImpl(
       cuda_stubs->nvtxRangePushA(name.str());
     }
   } else {
+    bool record_cuda = state == ProfilerState::CUDA;
+    if (record_cuda && cuda_sampling_rate > 1) {
+      record_cuda = (cuda_sample_counter++ % cuda_sampling_rate) == 0;
+      cuda_sample_stack.push_back(record_cuda);
+    }
     getEventList().record(
         EventKind::PushRange,
         name,
         thread_id,
-        state == ProfilerState::CUDA,
+        record_cuda,
         std::move(shapes));
   }
 }
@@ -111,11 +130,21 @@ void popRange() {
   if (state == ProfilerState::NVTX) {
     cuda_stubs->nvtxRangePop();
   } else {
+    bool record_cuda = state == ProfilerState::CUDA;
+    if (record_cuda && cuda_sampling_rate > 1) {
+      // Ranges that were pushed before the profiler was enabled have no
+      // entry on the stack; skip their cudaEvent so pops always pair with
+      // a push that also recorded one.
+      record_cuda = !cuda_sample_stack.empty() && cuda_sample_stack.back();
+      if (!cuda_sample_stack.empty()) {
+        cuda_sample_stack.pop_back();
+      }
+    }
     getEventList().record(
         EventKind::PopRange,
         StringView(""),
         thread_id,
-        state == ProfilerState::CUDA);
+        record_cuda);
   }
 }
 
@@ -153,6 +182,9 @@ void enableProfiler(ProfilerConfig config) {
       },
       [](const RecordFunction& /* unused */) { popRange(); },
       config.report_input_shapes);
+  cuda_sampling_rate = std::max(config.cuda_sampling_rate, 1);
+  cuda_sample_counter = 0;
+  cuda_sample_stack.clear();
   state = new_state;
 
   if(state == ProfilerState::CUDA) {
@@ -206,6 +238,191 @@ thread_event_lists disableProfiler() {
   }
 }
 
+// Background GPU utilization poller; see the doc comments in profiler.h.
+// The counters are atomics so readCudaUtilization() can sample them while
+// the poller thread is running.
+struct UtilizationPoller {
+  std::thread thread;
+  std::atomic<bool> running{false};
+  std::atomic<int64_t> busy_polls{0};
+  std::atomic<int64_t> total_polls{0};
+};
+
+static std::mutex utilization_poller_mutex;
+static UtilizationPoller* utilization_poller = nullptr;
+
+void enableCudaUtilizationPoller(int64_t interval_us) {
+  TORCH_CHECK(
+      cuda_stubs->enabled(),
+      "Can't poll CUDA utilization - PyTorch was compiled without CUDA");
+  TORCH_CHECK(interval_us > 0, "polling interval must be positive");
+  std::lock_guard<std::mutex> guard(utilization_poller_mutex);
+  if (utilization_poller) {
+    return;
+  }
+  auto* poller = new UtilizationPoller();
+  poller->running = true;
+  poller->thread = std::thread([poller, interval_us]() {
+    while (poller->running.load(std::memory_order_relaxed)) {
+      const bool busy = cuda_stubs->streamsBusy();
+      poller->total_polls.fetch_add(1, std::memory_order_relaxed);
+      if (busy) {
+        poller->busy_polls.fetch_add(1, std::memory_order_relaxed);
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
+    }
+  });
+  utilization_poller = poller;
+}
+
+CudaUtilizationSample disableCudaUtilizationPoller() {
+  UtilizationPoller* poller = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(utilization_poller_mutex);
+    poller = utilization_poller;
+    utilization_poller = nullptr;
+  }
+  CudaUtilizationSample sample;
+  if (!poller) {
+    return sample;
+  }
+  poller->running = false;
+  poller->thread.join();
+  sample.busy_polls = poller->busy_polls;
+  sample.total_polls = poller->total_polls;
+  delete poller;
+  return sample;
+}
+
+CudaUtilizationSample readCudaUtilization() {
+  std::lock_guard<std::mutex> guard(utilization_poller_mutex);
+  CudaUtilizationSample sample;
+  if (utilization_poller) {
+    sample.busy_polls = utilization_poller->busy_polls.exchange(0);
+    sample.total_polls = utilization_poller->total_polls.exchange(0);
+  }
+  return sample;
+}
+
+namespace {
+
+// Note [Flight recorder]
+// ~~~~~~~~~~~~~~~~~~~~~~
+// A fixed-size ring of recent op events that is cheap enough to stay
+// enabled in production: recording is one clock read at the start of an op
+// and one slot write at the end, with no locks. Writers claim slots with a
+// relaxed fetch_add; each slot carries a sequence number published after
+// the payload, so a dump can detect and drop slots that were mid-write or
+// overwritten while being copied. Freezing the ring makes writers drop
+// events while a dump copies it out.
+struct FlightRing {
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    int64_t start_ns = 0;
+    int64_t end_ns = 0;
+    uint32_t thread = 0;
+    char name[44] = {0};
+  };
+  explicit FlightRing(size_t capacity) : mask(capacity - 1), slots(capacity) {}
+  std::atomic<uint64_t> next{0};
+  std::atomic<bool> frozen{false};
+  const size_t mask;
+  std::vector<Slot> slots;
+};
+
+std::atomic<FlightRing*> flight_ring{nullptr};
+// start timestamps of the RecordFunctions currently nested on this thread
+thread_local std::vector<int64_t> flight_start_stack;
+
+uint32_t flightThreadId() {
+  static std::atomic<uint32_t> next_id{0};
+  static thread_local uint32_t id = next_id++;
+  return id;
+}
+
+void flightRecord(const RecordFunction& fn, int64_t start_ns, int64_t end_ns) {
+  FlightRing* ring = flight_ring.load(std::memory_order_acquire);
+  if (ring == nullptr || ring->frozen.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const uint64_t idx = ring->next.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = ring->slots[idx & ring->mask];
+  slot.seq.store(0, std::memory_order_release); // mark in progress
+  slot.start_ns = start_ns;
+  slot.end_ns = end_ns;
+  slot.thread = flightThreadId();
+  const char* name = fn.name().str();
+  strncpy(slot.name, name != nullptr ? name : "", sizeof(slot.name) - 1);
+  slot.name[sizeof(slot.name) - 1] = '\0';
+  slot.seq.store(idx + 1, std::memory_order_release);
+}
+
+} // namespace
+
+void enableFlightRecorder(size_t capacity) {
+  TORCH_CHECK(capacity > 0, "flight recorder capacity must be positive");
+  TORCH_CHECK(
+      flight_ring.load() == nullptr, "flight recorder is already enabled");
+  size_t rounded = 1;
+  while (rounded < capacity) {
+    rounded <<= 1;
+  }
+  flight_ring.store(new FlightRing(rounded), std::memory_order_release);
+  pushCallback(
+      [](const RecordFunction& /* unused */) {
+        flight_start_stack.push_back(getTime());
+      },
+      [](const RecordFunction& fn) {
+        if (flight_start_stack.empty()) {
+          // the op started before the recorder was enabled
+          return;
+        }
+        const int64_t start_ns = flight_start_stack.back();
+        flight_start_stack.pop_back();
+        flightRecord(fn, start_ns, getTime());
+      });
+}
+
+void disableFlightRecorder() {
+  FlightRing* ring = flight_ring.exchange(nullptr);
+  TORCH_CHECK(ring != nullptr, "flight recorder is not enabled");
+  popCallback();
+  // The ring is leaked on purpose: ops running concurrently may still be
+  // about to write into it and there is no cheap way to wait them out.
+}
+
+std::vector<FlightRecorderEvent> dumpFlightRecorder() {
+  std::vector<FlightRecorderEvent> result;
+  FlightRing* ring = flight_ring.load(std::memory_order_acquire);
+  if (ring == nullptr) {
+    return result;
+  }
+  ring->frozen.store(true, std::memory_order_release);
+  const uint64_t end = ring->next.load(std::memory_order_acquire);
+  const size_t capacity = ring->mask + 1;
+  const uint64_t begin = end > capacity ? end - capacity : 0;
+  result.reserve(end - begin);
+  for (uint64_t i = begin; i < end; ++i) {
+    const auto& slot = ring->slots[i & ring->mask];
+    if (slot.seq.load(std::memory_order_acquire) != i + 1) {
+      continue; // mid-write when the ring froze, or already overwritten
+    }
+    FlightRecorderEvent event;
+    event.start_ns = slot.start_ns;
+    event.end_ns = slot.end_ns;
+    event.thread_id = slot.thread;
+    event.name = slot.name;
+    // a writer that claimed this slot before the freeze may have published
+    // over it during the copy; drop the event if so
+    if (slot.seq.load(std::memory_order_acquire) != i + 1) {
+      continue;
+    }
+    result.push_back(std::move(event));
+  }
+  ring->frozen.store(false, std::memory_order_release);
+  return result;
+}
+
 void Event::record(bool record_cuda) {
   if (record_cuda) {
     cuda_stubs->record(&device_, &event, &cpu_ns_);
@@ -301,4 +518,207 @@ void RecordProfile::processEvents(const std::vector<Event*>& events) {
   out_ << "]\n";
 }
 
+namespace {
+
+// Marks emitted by emitTaskLaunch/emitTaskRun; the trace writer pairs
+// them into chrome flow arrows.
+constexpr const char* kTaskLaunchPrefix = "__task_launch:";
+constexpr const char* kTaskRunPrefix = "__task_run:";
+
+std::atomic<uint64_t> next_task_flow_id{1};
+
+bool hasPrefix(const char* name, const char* prefix) {
+  return strncmp(name, prefix, strlen(prefix)) == 0;
+}
+
+std::string escapeJsonString(const char* name) {
+  std::string out;
+  for (const char* p = name; *p; ++p) {
+    char c = *p;
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out.push_back(' ');
+    } else {
+      out.push_back(c);
+    }
+  }
+  return out;
+}
+
+} // namespace
+
+uint64_t emitTaskLaunch() {
+  if (state == ProfilerState::Disabled || state == ProfilerState::NVTX) {
+    return 0;
+  }
+  uint64_t flow_id = next_task_flow_id++;
+  mark(kTaskLaunchPrefix + std::to_string(flow_id), false);
+  return flow_id;
+}
+
+void emitTaskRun(uint64_t flow_id) {
+  if (flow_id == 0 || state == ProfilerState::Disabled ||
+      state == ProfilerState::NVTX) {
+    return;
+  }
+  mark(kTaskRunPrefix + std::to_string(flow_id), false);
+}
+
+void writeChromeTrace(std::ostream& out, thread_event_lists& lists) {
+  TORCH_CHECK(out, "could not write chrome trace");
+  // Every enableProfiler marks __start_profile on the enabling thread;
+  // use it as the time base so each exported file starts at ts 0.
+  Event* start = nullptr;
+  for (auto& list : lists) {
+    for (auto& e : list) {
+      if (strcmp(e.name(), "__start_profile") == 0) {
+        start = &e;
+        break;
+      }
+    }
+    if (start) {
+      break;
+    }
+  }
+  TORCH_CHECK(start, "could not find profiler start event");
+
+  struct FlowPoint {
+    uint16_t tid;
+    double ts;
+  };
+  std::unordered_map<uint64_t, FlowPoint> launches;
+  std::unordered_map<uint64_t, FlowPoint> runs;
+
+  out << "[\n";
+  bool first = true;
+  auto separator = [&]() {
+    if (!first) {
+      out << ",\n";
+    }
+    first = false;
+  };
+
+  for (auto& list : lists) {
+    // Each list belongs to one thread, so push/pop events nest within it.
+    std::vector<Event*> stack;
+    for (auto& e : list) {
+      if (e.kind() == "push") {
+        stack.push_back(&e);
+      } else if (e.kind() == "pop") {
+        if (stack.empty()) {
+          continue;
+        }
+        Event* begin = stack.back();
+        stack.pop_back();
+        separator();
+        out << "{\"name\": \"" << escapeJsonString(begin->name())
+            << "\", \"ph\": \"X\", \"ts\": " << start->cpu_elapsed_us(*begin)
+            << ", \"dur\": " << begin->cpu_elapsed_us(e)
+            << ", \"tid\": " << begin->thread_id()
+            << ", \"pid\": \"CPU Functions\", \"args\": {";
+        auto shapes = begin->shapes();
+        if (!shapes.empty()) {
+          out << "\"input_shapes\": [";
+          for (size_t i = 0; i < shapes.size(); i++) {
+            if (i != 0) {
+              out << ", ";
+            }
+            out << "[";
+            for (size_t j = 0; j < shapes[i].size(); j++) {
+              if (j != 0) {
+                out << ", ";
+              }
+              out << shapes[i][j];
+            }
+            out << "]";
+          }
+          out << "]";
+        }
+        out << "}}";
+      } else if (e.kind() == "mark") {
+        const char* name = e.name();
+        if (strcmp(name, "__start_profile") == 0) {
+          continue;
+        }
+        if (hasPrefix(name, kTaskLaunchPrefix)) {
+          uint64_t flow_id = strtoull(name + strlen(kTaskLaunchPrefix), nullptr, 10);
+          launches[flow_id] = FlowPoint{e.thread_id(), start->cpu_elapsed_us(e)};
+          continue;
+        }
+        if (hasPrefix(name, kTaskRunPrefix)) {
+          uint64_t flow_id = strtoull(name + strlen(kTaskRunPrefix), nullptr, 10);
+          runs[flow_id] = FlowPoint{e.thread_id(), start->cpu_elapsed_us(e)};
+          continue;
+        }
+        separator();
+        out << "{\"name\": \"" << escapeJsonString(name)
+            << "\", \"ph\": \"i\", \"s\": \"t\", \"ts\": "
+            << start->cpu_elapsed_us(e) << ", \"tid\": " << e.thread_id()
+            << ", \"pid\": \"CPU Functions\", \"args\": {}}";
+      }
+    }
+  }
+
+  // Inter-op task edges: one flow arrow per launch/run mark pair. Pairs
+  // split by a flush boundary have only one endpoint and are dropped.
+  for (auto& launch : launches) {
+    auto run = runs.find(launch.first);
+    if (run == runs.end()) {
+      continue;
+    }
+    separator();
+    out << "{\"name\": \"task\", \"cat\": \"task\", \"ph\": \"s\", \"id\": "
+        << launch.first << ", \"ts\": " << launch.second.ts
+        << ", \"tid\": " << launch.second.tid
+        << ", \"pid\": \"CPU Functions\"}";
+    separator();
+    out << "{\"name\": \"task\", \"cat\": \"task\", \"ph\": \"f\", \"bp\": \"e\", \"id\": "
+        << launch.first << ", \"ts\": " << run->second.ts
+        << ", \"tid\": " << run->second.tid
+        << ", \"pid\": \"CPU Functions\"}";
+  }
+
+  out << "\n]\n";
+}
+
+ChromeTraceRecorder::ChromeTraceRecorder(
+    std::string path_prefix,
+    ChromeTraceOptions options)
+    : path_prefix_(std::move(path_prefix)), options_(options) {
+  TORCH_CHECK(options_.max_files > 0, "ChromeTraceRecorder: max_files must be positive");
+  enableProfiler(
+      ProfilerConfig(ProfilerState::CPU, options_.report_input_shapes));
+}
+
+ChromeTraceRecorder::~ChromeTraceRecorder() {
+  try {
+    writeCurrentEvents(/*rearm=*/false);
+  } catch (const std::exception& e) {
+    TORCH_WARN("ChromeTraceRecorder: final flush failed: ", e.what());
+  }
+}
+
+std::string ChromeTraceRecorder::flush() {
+  return writeCurrentEvents(/*rearm=*/true);
+}
+
+std::string ChromeTraceRecorder::writeCurrentEvents(bool rearm) {
+  thread_event_lists lists = disableProfiler();
+  std::string filename = path_prefix_ + "." +
+      std::to_string(next_file_ % options_.max_files) + ".json";
+  next_file_++;
+  {
+    std::ofstream file(filename, std::ios::trunc);
+    TORCH_CHECK(file, "could not open ", filename);
+    writeChromeTrace(file, lists);
+  }
+  if (rearm) {
+    enableProfiler(
+        ProfilerConfig(ProfilerState::CPU, options_.report_input_shapes));
+  }
+  return filename;
+}
+
 }}}
@@ -51,6 +51,11 @@ struct TORCH_API CUDAStubs {
   virtual void synchronize() {
     fail();
   }
+  // Returns true if any device's current stream has work in flight.
+  virtual bool streamsBusy() {
+    fail();
+    return false;
+  }
   virtual ~CUDAStubs();
 
 private:
@@ -102,11 +107,22 @@ enum class TORCH_API ProfilerState {
 };
 
 struct TORCH_API ProfilerConfig {
-  ProfilerConfig(ProfilerState state, bool report_input_shapes)
-      : state(state), report_input_shapes(report_input_shapes) {}
+  ProfilerConfig(
+      ProfilerState state,
+      bool report_input_shapes,
+      int cuda_sampling_rate = 1)
+      : state(state),
+        report_input_shapes(report_input_shapes),
+        cuda_sampling_rate(cuda_sampling_rate) {}
   ~ProfilerConfig();
   ProfilerState state;
   bool report_input_shapes;
+  // In CUDA state, attach cudaEvents to only every Nth profiled range on
+  // each thread (1 = every range). Event insertion and synchronization
+  // dominate profiling overhead at high op rates; sampled runs record CPU
+  // times for every op but CUDA times for a representative subset, so
+  // per-name averages stay accurate while counts must be scaled by N.
+  int cuda_sampling_rate;
 };
 
 enum class TORCH_API EventKind : uint16_t {
@@ -228,6 +244,55 @@ using thread_event_lists = std::vector<std::vector<Event>>;
 TORCH_API void enableProfiler(ProfilerConfig);
 TORCH_API thread_event_lists disableProfiler();
 
+// Counters collected by the CUDA utilization poller: the fraction
+// busy_polls / total_polls estimates how much of the wall time the GPU had
+// work in flight.
+struct TORCH_API CudaUtilizationSample {
+  int64_t busy_polls = 0;
+  int64_t total_polls = 0;
+};
+
+// Starts a background thread that polls every device's current stream
+// (cudaStreamQuery) once per interval_us and counts how often work was in
+// flight. This gives continuous GPU utilization attribution without
+// inserting per-op events; combine it with a sampled CUDA profiling run
+// (ProfilerConfig::cuda_sampling_rate) to keep profiling overhead low.
+// No-op if a poller is already running.
+TORCH_API void enableCudaUtilizationPoller(int64_t interval_us = 1000);
+
+// Stops the poller and returns its final counters; returns zeroed counters
+// if no poller was running.
+TORCH_API CudaUtilizationSample disableCudaUtilizationPoller();
+
+// Reads and resets the running counters without stopping the poller, e.g.
+// once per served batch.
+TORCH_API CudaUtilizationSample readCudaUtilization();
+
+// A completed op event copied out of the flight recorder ring.
+struct TORCH_API FlightRecorderEvent {
+  std::string name;
+  int64_t start_ns = 0;
+  int64_t end_ns = 0;
+  uint32_t thread_id = 0;
+};
+
+// Starts the flight recorder: a fixed-size lock-free ring of the most
+// recent RecordFunction events (truncated op name, start/end timestamp,
+// thread), cheap enough to stay enabled in production - recording is one
+// clock read per op start and one slot write per op end. capacity is
+// rounded up to a power of two. The recorder sits on the RecordFunction
+// callback stack, so enable it before and disable it after any enclosed
+// profiler session (see the pushCallback/popCallback warning in
+// record_function.h).
+TORCH_API void enableFlightRecorder(size_t capacity = 8192);
+TORCH_API void disableFlightRecorder();
+
+// Freezes the ring, copies out the completed events it still holds
+// (oldest first) and resumes recording; events arriving while the copy
+// runs are dropped. Meant to be called when the serving layer detects a
+// latency spike. Returns an empty vector when the recorder is disabled.
+TORCH_API std::vector<FlightRecorderEvent> dumpFlightRecorder();
+
 
 // Usage:
 //   {
@@ -247,6 +312,52 @@ private:
   void processEvents(const std::vector<Event*>& events);
 };
 
+// Chrome-trace export usable from pure C++ binaries (the richer export
+// path lives in Python and is unavailable there). The recorder arms the
+// CPU profiler on construction; each flush() writes everything recorded
+// since the previous flush as a self-contained chrome://tracing JSON file
+// and re-arms the profiler. Files rotate through
+//   <path_prefix>.<0..max_files-1>.json
+// so a long-running server keeps a bounded window of recent timelines;
+// call flush() from the serving loop at whatever cadence that window
+// should cover. Ops spanning a flush boundary are dropped from both files.
+//
+// The trace contains one track per recorded thread with an "X" span per
+// op (including input shapes when report_input_shapes is set), instant
+// events for marks, and flow arrows for inter-op task edges: when the
+// interpreter hands a continuation to at::launch, the launching op and
+// the resumed work are linked via emitTaskLaunch/emitTaskRun below.
+struct TORCH_API ChromeTraceOptions {
+  size_t max_files = 5;
+  bool report_input_shapes = false;
+};
+
+struct TORCH_API ChromeTraceRecorder {
+  explicit ChromeTraceRecorder(
+      std::string path_prefix,
+      ChromeTraceOptions options = ChromeTraceOptions());
+  ~ChromeTraceRecorder();
+
+  // Writes the next file in the rotation and returns its name.
+  std::string flush();
+
+ private:
+  std::string writeCurrentEvents(bool rearm);
+
+  std::string path_prefix_;
+  ChromeTraceOptions options_;
+  size_t next_file_ = 0;
+};
+
+// Serializes one profiler batch as a chrome://tracing JSON array.
+TORCH_API void writeChromeTrace(std::ostream& out, thread_event_lists& lists);
+
+// Inter-op task edges. emitTaskLaunch marks the launch point on the
+// current thread and returns a flow id (0 when the profiler is off);
+// emitTaskRun marks where the launched task actually started running.
+// The trace writer pairs the two marks into a flow arrow.
+TORCH_API uint64_t emitTaskLaunch();
+TORCH_API void emitTaskRun(uint64_t flow_id);
 
 } // namespace profiler
 }} // namespace torch::autograd
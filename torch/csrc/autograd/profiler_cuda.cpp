@@ -52,6 +52,25 @@ struct CUDAMethods : public CUDAStubs {
   void synchronize() override {
     cudaDeviceSynchronize();
   }
+  bool streamsBusy() override {
+    // A stream with work in flight answers cudaErrorNotReady; both query
+    // results are cheap driver calls that do not synchronize the device.
+    at::cuda::OptionalCUDAGuard device_guard;
+    int count = at::cuda::device_count();
+    bool busy = false;
+    for(int i = 0; i < count; i++) {
+      device_guard.set_index(i);
+      cudaError_t result = cudaStreamQuery(at::cuda::getCurrentCUDAStream(i));
+      if (result == cudaErrorNotReady) {
+        busy = true;
+      } else if (result != cudaSuccess) {
+        // Swallow transient query errors; utilization polling must never
+        // throw from its background thread.
+        cudaGetLastError();
+      }
+    }
+    return busy;
+  }
   bool enabled() override {
     return true;
   }
@@ -359,6 +359,28 @@ inline Variable make_variable_view(
     bool is_differentiable = true,
     bool allow_tensor_metadata_change = true) {
   if (data.defined()) {
+    if (data.getIntrusivePtr().use_count() == 1 && data.getIntrusivePtr()->unique_version()) {
+      // `data` is an exclusively owned temporary, i.e. the metadata-only
+      // TensorImpl the view kernel just allocated. Reuse it in place instead
+      // of allocating yet another impl through `shallow_copy_and_detach()`.
+      // View chains (reshape/permute/slice) are common in scripted pre- and
+      // post-processing, so the extra impl per op is measurable allocator
+      // churn. Note that `base` always holds a reference to its own impl, so
+      // this path can never trigger when `data` aliases `base` (e.g. in
+      // `VariableType::detach`).
+      auto data_impl = data.getIntrusivePtr();
+      data_impl->set_allow_tensor_metadata_change(allow_tensor_metadata_change);
+      if (is_differentiable) {
+        /// Differentiable view. Track history with DifferentiableViewMeta.
+        data_impl->set_autograd_meta(c10::guts::make_unique<DifferentiableViewMeta>(
+          data_impl.get(), std::move(base)));
+      } else {
+        /// Non-differentiable view. Just share version counter.
+        data_impl->set_version_counter(impl::version_counter(base));
+        data_impl->set_autograd_meta(nullptr);
+      }
+      return Variable(std::move(data_impl));
+    }
     if (is_differentiable) {
       /// Differentiable view. Track history with DifferentiableViewMeta.
       auto data_impl_copy = data.getIntrusivePtr()->shallow_copy_and_detach(
@@ -1,9 +1,12 @@
+#include <cstdlib>
 #include <queue>
+#include <thread>
 
 #include <torch/csrc/autograd/functions/accumulate_grad.h>
 #include <torch/csrc/autograd/input_buffer.h>
 #include <torch/csrc/distributed/autograd/context/container.h>
 #include <torch/csrc/distributed/autograd/engine/dist_engine.h>
+#include <torch/csrc/distributed/rpc/rpc_agent.h>
 
 namespace torch {
 namespace distributed {
@@ -18,6 +21,24 @@ using torch::autograd::Node;
 using torch::autograd::validate_outputs;
 using torch::autograd::variable_list;
 
+namespace {
+
+// Upper bound on gradient bytes that may be queued or on the wire at once;
+// the engine thread enqueueing a send blocks while the bound is exceeded.
+size_t maxGradientInFlightBytes() {
+  constexpr size_t kDefaultMaxInFlightBytes = 256 * 1024 * 1024;
+  static const size_t maxBytes = []() -> size_t {
+    const char* env = std::getenv("TORCH_DIST_AUTOGRAD_MAX_INFLIGHT_BYTES");
+    if (env != nullptr) {
+      return std::strtoull(env, nullptr, 10);
+    }
+    return kDefaultMaxInFlightBytes;
+  }();
+  return maxBytes;
+}
+
+} // namespace
+
 DistEngine::DistEngine()
     : initializedContextIds_(), engine_(Engine::get_default_engine()) {}
 
@@ -270,6 +291,66 @@ void DistEngine::execute(const variable_list& roots) {
   autogradContext->clearAndWaitForOutstandingRpcs();
 }
 
+void DistEngine::enqueueGradientSend(
+    const ContextPtr& autogradContext,
+    rpc::worker_id_t dstWorkerId,
+    rpc::Message message,
+    size_t numBytes) {
+  // Register a placeholder future with the context before handing the send
+  // over to the comm thread, so that clearAndWaitForOutstandingRpcs() also
+  // waits for sends that haven't reached the RPC agent yet. The comm thread
+  // completes it from the real future's callback.
+  auto future = std::make_shared<rpc::FutureMessage>();
+  autogradContext->addOutstandingRpc(future);
+
+  std::unique_lock<std::mutex> lock(gradientSendLock_);
+  // Backpressure: wait until there is room under the in-flight cap. A single
+  // send larger than the cap is allowed through once nothing else is in
+  // flight, otherwise it could never proceed.
+  gradientSendCv_.wait(lock, [&]() {
+    return inFlightBytes_ == 0 ||
+        inFlightBytes_ + numBytes <= maxGradientInFlightBytes();
+  });
+  inFlightBytes_ += numBytes;
+  gradientSendQueue_.push_back(
+      GradientSend{dstWorkerId, std::move(message), numBytes, future});
+  if (!gradientSendThreadStarted_) {
+    gradientSendThreadStarted_ = true;
+    std::thread commThread(&DistEngine::gradientSendLoop, this);
+    commThread.detach();
+  }
+  lock.unlock();
+  gradientSendCv_.notify_all();
+}
+
+void DistEngine::gradientSendLoop() {
+  std::unique_lock<std::mutex> lock(gradientSendLock_);
+  while (true) {
+    gradientSendCv_.wait(lock, [this]() { return !gradientSendQueue_.empty(); });
+    GradientSend send = std::move(gradientSendQueue_.front());
+    gradientSendQueue_.pop_front();
+    lock.unlock();
+
+    auto rpcAgent = rpc::RpcAgent::getDefaultRpcAgent();
+    auto futureMessage = rpcAgent->send(
+        rpcAgent->getWorkerInfo(send.dstWorkerId), std::move(send.message));
+    const size_t numBytes = send.numBytes;
+    auto placeholder = send.future;
+    futureMessage->addCallback(
+        [this, numBytes, placeholder](const rpc::Message& message) {
+          {
+            std::lock_guard<std::mutex> guard(gradientSendLock_);
+            inFlightBytes_ -= numBytes;
+          }
+          gradientSendCv_.notify_all();
+          // Forward the response so the context's error handling sees it.
+          placeholder->markCompleted(message);
+        });
+
+    lock.lock();
+  }
+}
+
 void DistEngine::clearInitializedContextId(int64_t contextId) {
   std::lock_guard<std::mutex> guard(initializedContextIdsLock_);
   initializedContextIds_.erase(contextId);
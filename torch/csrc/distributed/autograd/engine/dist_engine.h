@@ -1,5 +1,7 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <unordered_set>
 
@@ -7,6 +9,9 @@
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/functions/basic_ops.h>
 #include <torch/csrc/distributed/autograd/context/context.h>
+#include <torch/csrc/distributed/rpc/future_message.h>
+#include <torch/csrc/distributed/rpc/message.h>
+#include <torch/csrc/distributed/rpc/types.h>
 
 namespace torch {
 namespace distributed {
@@ -48,6 +53,20 @@ class TORCH_API DistEngine {
   // Number of backward passes currently running for the Distributed Engine.
   size_t numBackwardPasses() const;
 
+  // Ships a gradient message produced by RecvRpcBackward to dstWorkerId on a
+  // dedicated comm thread, so gradients leave the node as soon as the local
+  // engine produces them instead of tying up an engine thread in the RPC
+  // layer. numBytes is the total size of the gradient tensors and is counted
+  // against the in-flight cap (TORCH_DIST_AUTOGRAD_MAX_INFLIGHT_BYTES, 256MB
+  // by default); the caller blocks while the cap is exceeded. A placeholder
+  // future is registered on the context before this returns, so
+  // clearAndWaitForOutstandingRpcs() covers sends that are still queued.
+  void enqueueGradientSend(
+      const ContextPtr& autogradContext,
+      rpc::worker_id_t dstWorkerId,
+      rpc::Message message,
+      size_t numBytes);
+
  private:
   // Make sure this is a singleton.
   DistEngine();
@@ -90,12 +109,33 @@ class TORCH_API DistEngine {
   // Removes the provided contextId from the 'initializedContextIds_' map.
   void clearInitializedContextId(int64_t contextId);
 
+  // A gradient message waiting to be handed to the RPC agent by the comm
+  // thread.
+  struct GradientSend {
+    rpc::worker_id_t dstWorkerId;
+    rpc::Message message;
+    size_t numBytes;
+    std::shared_ptr<rpc::FutureMessage> future;
+  };
+
+  // Body of the comm thread; started lazily on the first gradient send and
+  // detached, like the local engine's worker threads.
+  void gradientSendLoop();
+
   // Set of autograd context_ids, which we have already initialized for
   // distributed autograd on this node (e.g.: already computed dependencies)
   std::unordered_set<int64_t> initializedContextIds_;
 
   mutable std::mutex initializedContextIdsLock_;
 
+  // State of the gradient comm thread. inFlightBytes_ counts gradient bytes
+  // from enqueue until the RPC agent reports the send complete.
+  std::deque<GradientSend> gradientSendQueue_;
+  size_t inFlightBytes_{0};
+  bool gradientSendThreadStarted_{false};
+  std::mutex gradientSendLock_;
+  std::condition_variable gradientSendCv_;
+
   // Reference to local autograd engine.
   torch::autograd::Engine& engine_;
 
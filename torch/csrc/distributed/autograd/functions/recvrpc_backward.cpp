@@ -1,7 +1,7 @@
 #include <torch/csrc/distributed/autograd/functions/recvrpc_backward.h>
 #include <ATen/core/functional.h>
+#include <torch/csrc/distributed/autograd/engine/dist_engine.h>
 #include <torch/csrc/distributed/autograd/rpc_messages/propagate_gradients_req.h>
-#include <torch/csrc/distributed/rpc/rpc_agent.h>
 
 namespace torch {
 namespace distributed {
@@ -30,17 +30,22 @@ variable_list RecvRpcBackward::apply(variable_list&& grads) {
     }
   }
 
-  // Send the gradients over the wire and record the future in the autograd
-  // context.
+  // Ship the gradients to the appropriate node as soon as they are ready.
+  // The actual send runs on the distributed engine's comm thread so the
+  // engine thread executing this node isn't tied up in the RPC layer, and a
+  // future covering the send is recorded in the autograd context.
   PropagateGradientsReq gradCall(autogradMetadata_, outputGrads);
 
-  // Send the gradients over to the appropriate node.
-  auto rpcAgent = rpc::RpcAgent::getDefaultRpcAgent();
-  auto futureMessage = rpcAgent->send(
-      rpcAgent->getWorkerInfo(fromWorkerId_), std::move(gradCall).toMessage());
+  size_t numBytes = 0;
+  for (const auto& grad : outputGrads) {
+    numBytes += grad.numel() * grad.element_size();
+  }
 
-  // Record the future in the context.
-  autogradContext_->addOutstandingRpc(futureMessage);
+  DistEngine::getInstance().enqueueGradientSend(
+      autogradContext_,
+      fromWorkerId_,
+      std::move(gradCall).toMessage(),
+      numBytes);
 
   // 'recv' function sends the gradients over the wire using RPC, it doesn't
   // need to return anything for any downstream autograd function.
@@ -79,4 +79,18 @@ void broadcast_coalesced(
   }
 }
 
+at::Tensor FP16CompressionHook::compress(
+    const at::Tensor& bucket,
+    at::Tensor& residual) {
+  (void)residual; // lossless enough; no error feedback needed
+  return bucket.to(at::kHalf);
+}
+
+void FP16CompressionHook::decompress(
+    const at::Tensor& reduced,
+    at::Tensor& bucket) {
+  // copy_ casts back up to the bucket's dtype.
+  bucket.copy_(reduced);
+}
+
 } // namespace c10d
@@ -13,4 +13,40 @@ void broadcast_coalesced(
     at::TensorList tensors,
     size_t buffer_size);
 
+// A gradient compression hook transforms each flattened dense gradient
+// bucket before it is handed to ProcessGroup::allreduce and restores the
+// bucket from the reduced result afterwards (fp16 cast, top-k
+// sparsification, signSGD, ...).
+//
+// `residual` is a framework-managed error-feedback buffer stored alongside
+// the bucket and persisted across iterations. Lossy hooks should add the
+// part of the gradient they dropped into it (in place) and fold it back
+// into the bucket on the next call, so the compression error does not
+// accumulate over training. Lossless hooks can ignore it.
+//
+// The tensor returned by compress() must have the same shape and dtype on
+// every rank and every iteration for a given bucket, since it is what the
+// collective actually reduces.
+class GradCompressionHook {
+ public:
+  virtual ~GradCompressionHook() = default;
+
+  // Called with the bucket contents (already prescaled by the world size)
+  // once all of its gradients are ready. Returns the tensor to allreduce
+  // in the bucket's place.
+  virtual at::Tensor compress(const at::Tensor& bucket, at::Tensor& residual) = 0;
+
+  // Called with the allreduced compressed tensor. Restores the gradients
+  // into `bucket` in place.
+  virtual void decompress(const at::Tensor& reduced, at::Tensor& bucket) = 0;
+};
+
+// Reference hook: allreduce in half precision. Halves the wire size; does
+// not use the error-feedback buffer.
+class FP16CompressionHook : public GradCompressionHook {
+ public:
+  at::Tensor compress(const at::Tensor& bucket, at::Tensor& residual) override;
+  void decompress(const at::Tensor& reduced, at::Tensor& bucket) override;
+};
+
 } // namespace c10d
@@ -37,6 +37,59 @@ void copyBroadcastTensorsToReplicas(
     }
   }
 }
+// Note [Sharded parameter broadcast]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A flat broadcast pushes every byte of the model through rank 0's NIC once
+// per peer, so the initial parameter sync scales with world size and
+// dominates job start at hundreds of ranks. The classic fix is to broadcast
+// as scatter + allgather: rank 0 sends each rank one 1/world shard (its
+// full payload leaves rank 0 exactly once), then the allgather reassembles
+// the model everywhere over aggregate bisection bandwidth. Total time is
+// ~2x one link's worth of data, independent of world size.
+//
+// Backends without a scatter implementation (NCCL in this tree) throw while
+// validating arguments, before any communication, so every rank falls back
+// to the plain broadcast consistently.
+
+constexpr int kShardedBroadcastMinRanks = 8;
+constexpr int64_t kShardedBroadcastMinBytes = 1024 * 1024;
+
+bool shardedBroadcastEligible(ProcessGroup& processGroup, const at::Tensor& flat) {
+  return processGroup.getSize() >= kShardedBroadcastMinRanks &&
+      flat.numel() * flat.element_size() >= kShardedBroadcastMinBytes;
+}
+
+bool shardedBroadcastFlat(ProcessGroup& processGroup, at::Tensor& flat) {
+  const int world = processGroup.getSize();
+  const int64_t numel = flat.numel();
+  const int64_t shardNumel = (numel + world - 1) / world;
+
+  at::Tensor padded = at::empty({shardNumel * world}, flat.options());
+  if (processGroup.getRank() == 0) {
+    padded.narrow(0, 0, numel).copy_(flat);
+  }
+
+  std::vector<at::Tensor> shard{at::empty({shardNumel}, flat.options())};
+  try {
+    {
+      std::vector<std::vector<at::Tensor>> scatterInputs;
+      if (processGroup.getRank() == 0) {
+        scatterInputs.push_back(padded.chunk(world));
+      }
+      ScatterOptions scatterOptions;
+      scatterOptions.rootRank = 0;
+      processGroup.scatter(shard, scatterInputs, scatterOptions)->wait();
+    }
+    // The outputs are views into `padded`, so the allgather reassembles the
+    // full flat buffer in place on every rank.
+    std::vector<std::vector<at::Tensor>> allgatherOutputs{padded.chunk(world)};
+    processGroup.allgather(allgatherOutputs, shard)->wait();
+  } catch (const std::exception&) {
+    return false;
+  }
+  flat.copy_(padded.narrow(0, 0, numel));
+  return true;
+}
 } // namespace
 
 std::vector<std::vector<at::Tensor>> bucketTensors(
@@ -72,6 +125,13 @@ void distBroadcastCoalesced(
     // Flatten each bucket of tensors (whose size equals `bufferSize`) into a
     // single tensor.
     flatTensors.push_back({torch::utils::flatten_dense_tensors(tensorBucket)});
+    // Large buckets at scale go out as scatter + allgather so rank 0's link
+    // stops being the bottleneck; see Note [Sharded parameter broadcast].
+    if (shardedBroadcastEligible(processGroup, flatTensors.back()[0]) &&
+        shardedBroadcastFlat(processGroup, flatTensors.back()[0])) {
+      work.push_back(nullptr);
+      continue;
+    }
     BroadcastOptions broadcastOptions;
     broadcastOptions.rootRank = 0;
     broadcastOptions.rootTensor = 0;
@@ -84,7 +144,9 @@ void distBroadcastCoalesced(
   // un-flatten the broadcast tensor back into device-local individual tensors.
   for (size_t bucket = 0; bucket < bucketedTensors.size(); ++bucket) {
     auto& tensors = bucketedTensors[bucket];
-    work[bucket]->wait();
+    if (work[bucket]) {
+      work[bucket]->wait();
+    }
     const auto synced =
         torch::utils::unflatten_dense_tensors(flatTensors[bucket][0], tensors);
     AT_ASSERT(synced.size() == tensors.size());
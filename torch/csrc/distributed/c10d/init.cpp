@@ -50,6 +50,27 @@ std::vector<std::string> split(char separator, const std::string& string) {
 template <typename T>
 using shared_ptr_class_ = py::class_<T, std::shared_ptr<T>>;
 
+// Lets Python subclasses of GradCompressionHook provide the compress /
+// decompress implementations. The overrides run on the autograd engine
+// thread and reacquire the GIL for the duration of the Python call.
+class PyGradCompressionHook : public ::c10d::GradCompressionHook {
+ public:
+  at::Tensor compress(const at::Tensor& bucket, at::Tensor& residual)
+      override {
+    PYBIND11_OVERLOAD_PURE(
+        at::Tensor,
+        ::c10d::GradCompressionHook,
+        compress,
+        bucket,
+        residual);
+  }
+
+  void decompress(const at::Tensor& reduced, at::Tensor& bucket) override {
+    PYBIND11_OVERLOAD_PURE(
+        void, ::c10d::GradCompressionHook, decompress, reduced, bucket);
+  }
+};
+
 PyObject* c10d_init(PyObject* _unused) {
   C10_LOG_API_USAGE_ONCE("c10d.python.import");
   auto c10d_module = THPObjectPtr(PyImport_ImportModule("torch.distributed"));
@@ -59,6 +80,20 @@ PyObject* c10d_init(PyObject* _unused) {
 
   auto module = py::handle(c10d_module).cast<py::module>();
 
+  py::class_<
+      ::c10d::GradCompressionHook,
+      PyGradCompressionHook,
+      std::shared_ptr<::c10d::GradCompressionHook>>(
+      module, "GradCompressionHook")
+      .def(py::init<>());
+
+  py::class_<
+      ::c10d::FP16CompressionHook,
+      ::c10d::GradCompressionHook,
+      std::shared_ptr<::c10d::FP16CompressionHook>>(
+      module, "FP16CompressionHook")
+      .def(py::init<>());
+
   shared_ptr_class_<::c10d::Reducer>(module, "Reducer")
       .def(
           py::init<
@@ -83,6 +118,10 @@ PyObject* c10d_init(PyObject* _unused) {
           [](::c10d::Reducer& reducer, const torch::autograd::Variable& output)
               -> void { reducer.prepare_for_backward({output}); },
           py::call_guard<py::gil_scoped_release>())
+      .def(
+          "register_comm_hook",
+          &::c10d::Reducer::register_comm_hook,
+          py::arg("hook"))
       .def("get_backward_stats", &::c10d::Reducer::get_backward_stats);
 
   py::enum_<::c10d::ReduceOp>(module, "ReduceOp", R"(
@@ -117,6 +156,18 @@ They are used in specifying strategies for reduction collectives, e.g.,
       .def_readwrite("reduceOp", &::c10d::AllreduceCoalescedOptions::reduceOp)
       .def_readwrite("timeout", &::c10d::AllreduceCoalescedOptions::timeout);
 
+  py::class_<::c10d::AllreduceEpilogueOptions>(
+      module, "AllreduceEpilogueOptions")
+      .def(py::init<>())
+      .def_readwrite("reduceOp", &::c10d::AllreduceEpilogueOptions::reduceOp)
+      .def_readwrite("scale", &::c10d::AllreduceEpilogueOptions::scale)
+      .def_readwrite(
+          "learningRate", &::c10d::AllreduceEpilogueOptions::learningRate)
+      .def_readwrite("momentum", &::c10d::AllreduceEpilogueOptions::momentum)
+      .def_readwrite(
+          "weightDecay", &::c10d::AllreduceEpilogueOptions::weightDecay)
+      .def_readwrite("timeout", &::c10d::AllreduceEpilogueOptions::timeout);
+
   py::class_<::c10d::ReduceOptions>(module, "ReduceOptions")
       .def(py::init<>())
       .def_readwrite("reduceOp", &::c10d::ReduceOptions::reduceOp)
@@ -169,10 +220,47 @@ They are used in specifying strategies for reduction collectives, e.g.,
                     reinterpret_cast<char*>(value.data()), value.size());
               },
               py::call_guard<py::gil_scoped_release>())
+          // Convert from std::string to std::vector<uint8>.
+          .def(
+              "multi_set",
+              [](::c10d::Store& store,
+                 const std::vector<std::string>& keys,
+                 const std::vector<std::string>& values) {
+                std::vector<std::vector<uint8_t>> values_;
+                values_.reserve(values.size());
+                for (const auto& value : values) {
+                  values_.emplace_back(value.begin(), value.end());
+                }
+                store.multiSet(keys, values_);
+              },
+              py::call_guard<py::gil_scoped_release>())
+          // Convert from std::vector<uint8_t> to py::bytes.
+          // The returned values are not guaranteed to be valid UTF-8.
+          .def(
+              "multi_get",
+              [](::c10d::Store& store, const std::vector<std::string>& keys) {
+                auto values = store.multiGet(keys);
+                std::vector<py::bytes> values_;
+                values_.reserve(values.size());
+                for (auto& value : values) {
+                  values_.emplace_back(
+                      reinterpret_cast<char*>(value.data()), value.size());
+                }
+                return values_;
+              },
+              py::call_guard<py::gil_scoped_release>())
+          .def(
+              "scan",
+              &::c10d::Store::scan,
+              py::call_guard<py::gil_scoped_release>())
           .def(
               "add",
               &::c10d::Store::add,
               py::call_guard<py::gil_scoped_release>())
+          .def(
+              "wait_counter",
+              &::c10d::Store::waitCounter,
+              py::call_guard<py::gil_scoped_release>())
           .def(
               "set_timeout",
               &::c10d::Store::setTimeout,
@@ -505,7 +593,15 @@ They are used in specifying strategies for reduction collectives, e.g.,
           py::arg("rank"),
           py::arg("size"),
           py::arg("timeout") = std::chrono::milliseconds(
-              ::c10d::ProcessGroupNCCL::kProcessGroupNCCLOpTimeoutMillis));
+              ::c10d::ProcessGroupNCCL::kProcessGroupNCCLOpTimeoutMillis))
+      .def(
+          "allreduce_with_epilogue",
+          &::c10d::ProcessGroupNCCL::allreduceWithEpilogue,
+          py::arg("gradients"),
+          py::arg("parameters"),
+          py::arg("momentum_buffers"),
+          py::arg("opts") = ::c10d::AllreduceEpilogueOptions(),
+          py::call_guard<py::gil_scoped_release>());
 #endif
 
 #ifdef USE_C10D_MPI
@@ -536,6 +632,27 @@ They are used in specifying strategies for reduction collectives, e.g.,
           &::c10d::ProcessGroup::Work::wait,
           py::call_guard<py::gil_scoped_release>());
 
+#ifdef USE_C10D_NCCL
+  // Work objects returned by ProcessGroupNCCL expose the per-work timing
+  // records collected when NCCL_COLLECTIVE_TIMING is set. All times are in
+  // milliseconds since the process group's timing epoch.
+  py::class_<
+      ::c10d::ProcessGroupNCCL::WorkNCCL,
+      ::c10d::ProcessGroup::Work,
+      std::shared_ptr<::c10d::ProcessGroupNCCL::WorkNCCL>>(module, "WorkNCCL")
+      .def(
+          "timing_enabled",
+          &::c10d::ProcessGroupNCCL::WorkNCCL::timingEnabled)
+      .def(
+          "get_enqueue_time",
+          &::c10d::ProcessGroupNCCL::WorkNCCL::getEnqueueTime)
+      .def(
+          "get_start_times",
+          &::c10d::ProcessGroupNCCL::WorkNCCL::getStartTimes)
+      .def(
+          "get_end_times", &::c10d::ProcessGroupNCCL::WorkNCCL::getEndTimes);
+#endif
+
 #ifdef USE_CUDA
   module.def(
       "_dist_bucket_tensors",
@@ -181,14 +181,12 @@ void Reducer::mark_variable_ready_dense(VariableIndex index) {
   auto& bucket = buckets_[bucket_index.bucket_index];
   auto& replica = bucket.replicas[replica_index];
   auto& variable = replica.variables[bucket_index.intra_bucket_index];
-  const auto offset = replica.offsets[bucket_index.intra_bucket_index];
-  const auto length = replica.lengths[bucket_index.intra_bucket_index];
 
   // Copy contents of gradient tensor to bucket tensor.
   // If the gradient is not set, we assume it wasn't computed
   // as part of the current backwards pass, and zero the part
   // of the bucket it would otherwise hold.
-  auto bucket_view = replica.contents.narrow(0, offset, length);
+  auto& bucket_view = replica.bucket_views[bucket_index.intra_bucket_index];
   auto& grad = variable.grad();
   if (grad.defined()) {
     // Ensure that the gradient type matches the bucket type.
@@ -205,7 +203,7 @@ void Reducer::mark_variable_ready_dense(VariableIndex index) {
     AT_ASSERT(!grad.is_alias_of(bucket_view));
     AT_ASSERT(grad.device() == bucket_view.device());
     AT_ASSERT(grad.numel() == bucket_view.numel());
-    bucket_view.copy_(grad.view({-1}), /* non_blocking */ true);
+    bucket_view.copy_(grad, /* non_blocking */ true);
   } else {
     bucket_view.zero_();
   }
@@ -351,6 +349,25 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
   for (; next_bucket_ < buckets_.size() && buckets_[next_bucket_].pending == 0;
        next_bucket_++) {
     auto& bucket = buckets_[next_bucket_];
+
+    // With a compression hook registered, dense buckets allreduce the
+    // hook's compressed tensors instead of their contents. The compressed
+    // tensors are kept on the bucket both to stay alive for the duration
+    // of the collective and for decompression in `finalize_bucket_dense`.
+    if (comm_hook_ != nullptr && !bucket.expect_sparse_gradient) {
+      bucket.compressed.clear();
+      bucket.compressed.reserve(bucket.replicas.size());
+      for (auto& replica : bucket.replicas) {
+        if (!replica.residual.defined()) {
+          replica.residual = at::zeros_like(replica.contents);
+        }
+        bucket.compressed.push_back(
+            comm_hook_->compress(replica.contents, replica.residual));
+      }
+      bucket.work = process_group_->allreduce(bucket.compressed);
+      continue;
+    }
+
     std::vector<at::Tensor> tensors;
     tensors.reserve(bucket.replicas.size());
     for (const auto& replica : bucket.replicas) {
@@ -369,6 +386,21 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
   }
 }
 
+void Reducer::register_comm_hook(std::shared_ptr<GradCompressionHook> hook) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  AT_ASSERTM(
+      !expect_autograd_hooks_,
+      "`register_comm_hook` must NOT be called during autograd execution.");
+  comm_hook_ = std::move(hook);
+  // Any error-feedback state belongs to the previous hook; start fresh.
+  for (auto& bucket : buckets_) {
+    bucket.compressed.clear();
+    for (auto& replica : bucket.replicas) {
+      replica.residual.reset();
+    }
+  }
+}
+
 void Reducer::initialize_buckets(
     std::vector<std::vector<size_t>> bucket_indices) {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -455,6 +487,15 @@ void Reducer::initialize_buckets(
 
         // Allocate bucket contents tensor.
         replica.contents = at::empty({static_cast<long>(offset)}, options);
+
+        // Precompute per-variable views into the contents tensor, so the
+        // autograd hooks and finalization don't pay for narrow/view tensor
+        // creation once per variable per iteration.
+        for (size_t i = 0; i < replica.variables.size(); i++) {
+          replica.bucket_views.push_back(
+              replica.contents.narrow(0, replica.offsets[i], replica.lengths[i])
+                  .view(replica.variables[i].sizes()));
+        }
       }
 
       // Add bucket replica to enclosing bucket.
@@ -572,15 +613,23 @@ void Reducer::prepare_for_backward(
 
 // A bucket with one or more dense tensors needs to be unflattened.
 void Reducer::finalize_bucket_dense(Bucket& bucket) {
+  // Restore the bucket contents from the allreduced compressed tensors
+  // before unflattening them into the variables.
+  if (!bucket.compressed.empty()) {
+    AT_ASSERT(comm_hook_ != nullptr);
+    AT_ASSERT(bucket.compressed.size() == bucket.replicas.size());
+    for (size_t i = 0; i < bucket.replicas.size(); i++) {
+      comm_hook_->decompress(
+          bucket.compressed[i], bucket.replicas[i].contents);
+    }
+    bucket.compressed.clear();
+  }
   for (auto& replica : bucket.replicas) {
     for (size_t intra_bucket_index = 0;
          intra_bucket_index < replica.variables.size();
          intra_bucket_index++) {
       auto& variable = replica.variables[intra_bucket_index];
-      const auto offset = replica.offsets[intra_bucket_index];
-      const auto length = replica.lengths[intra_bucket_index];
-      auto bucket_view =
-          replica.contents.narrow(0, offset, length).view(variable.sizes());
+      auto& bucket_view = replica.bucket_views[intra_bucket_index];
       auto& grad = variable.grad();
       if (!grad.defined()) {
         grad = at::empty(bucket_view.sizes(), bucket_view.options());
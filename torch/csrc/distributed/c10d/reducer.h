@@ -10,6 +10,7 @@
 #include <c10d/ProcessGroup.hpp>
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/variable.h>
+#include <torch/csrc/distributed/c10d/comm.h>
 
 namespace c10d {
 
@@ -40,6 +41,14 @@ class Reducer {
   void prepare_for_backward(
       const std::vector<torch::autograd::Variable>& outputs);
 
+  // Registers a hook that compresses every dense bucket before it is
+  // allreduced and decompresses the reduced result. The reducer allocates
+  // and persists a per-bucket error-feedback residual tensor for the hook.
+  // Must not be called while a backward pass is in flight; replacing a
+  // lossy hook resets its residual state. Passing nullptr removes the hook.
+  // Sparse buckets are reduced uncompressed.
+  void register_comm_hook(std::shared_ptr<GradCompressionHook> hook);
+
   // Returns the relative time in nanoseconds when gradients were ready,
   // with respect to the time `prepare_for_backward` was called. The outer
   // vector is for model replicas and the inner vector is for parameters.
@@ -75,6 +84,9 @@ class Reducer {
   bool has_marked_unused_parameters_;
   std::vector<VariableIndex> unused_parameters_;
 
+  // Optional bucket-level gradient compression hook (see comm.h).
+  std::shared_ptr<GradCompressionHook> comm_hook_;
+
   void mark_variable_ready_dense(VariableIndex index);
 
   void mark_variable_ready_sparse(VariableIndex index);
@@ -115,10 +127,20 @@ class Reducer {
     std::vector<size_t> offsets;
     std::vector<size_t> lengths;
 
+    // Per-variable views into the contents tensor, shaped like the
+    // corresponding variable.  Precomputed in `initialize_buckets` so the
+    // per-iteration hooks don't allocate narrow/view tensors.
+    std::vector<at::Tensor> bucket_views;
+
     // Number of tensors to be added before this bucket is complete.
     // This is reset to `variables.size()` every iteration.
     size_t pending;
 
+    // Error-feedback state for the registered compression hook, shaped
+    // like `contents`. Allocated lazily (zeros) the first time the hook
+    // compresses this replica; undefined when no hook is registered.
+    at::Tensor residual;
+
     // TODO(@pietern)
     // Memory copies from gradient tensors into the bucket are potentially
     // done on different CUDA streams. We record an event for every copy
@@ -140,6 +162,11 @@ class Reducer {
     // Keep work handle around when this set of buckets is being reduced.
     std::shared_ptr<c10d::ProcessGroup::Work> work;
 
+    // Compressed per-replica tensors currently being allreduced in place
+    // of the replicas' contents. Only populated while a compression hook
+    // is registered; cleared after decompression.
+    std::vector<at::Tensor> compressed;
+
     // If this bucket should expect a single sparse gradient.
     // Implies: replicas[i].variables.size() == 1.
     bool expect_sparse_gradient = false;
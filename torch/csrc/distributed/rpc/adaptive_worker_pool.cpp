@@ -0,0 +1,173 @@
+#include <torch/csrc/distributed/rpc/adaptive_worker_pool.h>
+
+#include <c10/util/Exception.h>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+namespace {
+
+// How long a surplus work-lane thread may sit idle before it retires.
+constexpr std::chrono::milliseconds kIdleTimeout(2000);
+
+// A control-plane message type whose measured service time exceeds this
+// budget is demoted to the work lane, so a misclassified expensive handler
+// cannot clog the control lane.
+constexpr double kControlServiceTimeBudgetUs = 500.0;
+
+// Weight of the service time average: avg += (sample - avg) / kEwmaWeight.
+constexpr int64_t kEwmaWeight = 8;
+
+} // namespace
+
+AdaptiveWorkerPool::AdaptiveWorkerPool(
+    size_t minWorkThreads,
+    size_t maxWorkThreads,
+    size_t numControlThreads)
+    : controlLane_(numControlThreads, numControlThreads),
+      workLane_(minWorkThreads, maxWorkThreads) {
+  TORCH_CHECK(
+      minWorkThreads >= 1 && maxWorkThreads >= minWorkThreads &&
+          numControlThreads >= 1,
+      "Invalid AdaptiveWorkerPool sizes: work lane [",
+      minWorkThreads,
+      ", ",
+      maxWorkThreads,
+      "], control lane ",
+      numControlThreads);
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (size_t i = 0; i < controlLane_.minThreads; ++i) {
+    addThread(controlLane_);
+  }
+  for (size_t i = 0; i < workLane_.minThreads; ++i) {
+    addThread(workLane_);
+  }
+}
+
+AdaptiveWorkerPool::~AdaptiveWorkerPool() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    shutdown_ = true;
+    controlLane_.condition.notify_all();
+    workLane_.condition.notify_all();
+  }
+  for (auto& entry : threads_) {
+    entry.second.join();
+  }
+}
+
+bool AdaptiveWorkerPool::isControlPlane(MessageType type) {
+  switch (type) {
+    case MessageType::RREF_USER_DELETE:
+    case MessageType::RREF_FORK_REQUEST:
+    case MessageType::RREF_CHILD_ACCEPT:
+    case MessageType::RREF_ACK:
+    case MessageType::CLEANUP_AUTOGRAD_CONTEXT_REQ:
+    case MessageType::CLEANUP_AUTOGRAD_CONTEXT_RESP:
+    case MessageType::SHUTDOWN:
+    case MessageType::EXCEPTION:
+      return true;
+    default:
+      return false;
+  }
+}
+
+AdaptiveWorkerPool::TypeStats& AdaptiveWorkerPool::statsFor(MessageType type) {
+  return stats_[static_cast<int>(type)];
+}
+
+void AdaptiveWorkerPool::run(MessageType type, std::function<void()> task) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  TORCH_CHECK(!shutdown_, "AdaptiveWorkerPool is shutting down");
+  auto& stats = statsFor(type);
+  Lane* lane = &workLane_;
+  if (isControlPlane(type) &&
+      stats.avgServiceTimeUs <= kControlServiceTimeBudgetUs) {
+    lane = &controlLane_;
+  }
+  ++stats.queued;
+  lane->tasks.push(Task{type, std::move(task)});
+  if (lane->idle > 0) {
+    lane->condition.notify_one();
+  } else if (lane->alive < lane->maxThreads) {
+    // Burst: every worker is occupied, so add capacity. This also keeps
+    // nested RPC calls deadlock-free below the bound: a blocked worker
+    // counts as occupied, so the task it is waiting on gets a new thread.
+    addThread(*lane);
+  }
+}
+
+void AdaptiveWorkerPool::waitWorkComplete() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  completed_.wait(lock, [this] {
+    return controlLane_.tasks.empty() && controlLane_.busy == 0 &&
+        workLane_.tasks.empty() && workLane_.busy == 0;
+  });
+}
+
+void AdaptiveWorkerPool::addThread(Lane& lane) {
+  reapRetiredThreads();
+  ++lane.alive;
+  std::thread thread(&AdaptiveWorkerPool::workerLoop, this, std::ref(lane));
+  auto id = thread.get_id();
+  threads_.emplace(id, std::move(thread));
+}
+
+void AdaptiveWorkerPool::reapRetiredThreads() {
+  for (const auto& id : retiredThreads_) {
+    auto it = threads_.find(id);
+    TORCH_INTERNAL_ASSERT(it != threads_.end());
+    it->second.join();
+    threads_.erase(it);
+  }
+  retiredThreads_.clear();
+}
+
+void AdaptiveWorkerPool::workerLoop(Lane& lane) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    if (!lane.tasks.empty()) {
+      Task task = std::move(lane.tasks.front());
+      lane.tasks.pop();
+      ++lane.busy;
+      lock.unlock();
+      const auto start = std::chrono::steady_clock::now();
+      task.fn();
+      const double serviceTimeUs =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count();
+      lock.lock();
+      --lane.busy;
+      auto& stats = statsFor(task.type);
+      --stats.queued;
+      ++stats.completed;
+      stats.avgServiceTimeUs +=
+          (serviceTimeUs - stats.avgServiceTimeUs) / kEwmaWeight;
+      if (controlLane_.tasks.empty() && controlLane_.busy == 0 &&
+          workLane_.tasks.empty() && workLane_.busy == 0) {
+        completed_.notify_all();
+      }
+      continue;
+    }
+    if (shutdown_) {
+      break;
+    }
+    ++lane.idle;
+    const bool gotWork = lane.condition.wait_for(lock, kIdleTimeout, [&] {
+      return shutdown_ || !lane.tasks.empty();
+    });
+    --lane.idle;
+    if (!gotWork && lane.alive > lane.minThreads) {
+      // Idled past the timeout with nothing queued: retire this thread.
+      break;
+    }
+  }
+  --lane.alive;
+  retiredThreads_.push_back(std::this_thread::get_id());
+}
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <torch/csrc/distributed/rpc/message.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+// An elastic two-lane worker pool for RpcAgent implementations.
+//
+// A fixed-size pool serves bursty RPC traffic poorly: sized for the peak it
+// oversubscribes the host between bursts, sized for the average it queues
+// work during bursts. Moreover, cheap control-plane messages (RRef
+// bookkeeping, autograd context cleanup) share the queue with user function
+// execution, so a small delete message can sit behind a long-running GEMM.
+//
+// This pool addresses both problems:
+//
+// (1) Two lanes. Messages classified as control-plane by isControlPlane()
+//     run on a small dedicated lane, so they are never queued behind user
+//     code. The classification is checked against measured service times:
+//     if a nominally cheap message type turns out to be expensive on this
+//     worker, it is routed to the work lane instead.
+//
+// (2) Elastic sizing. The work lane grows by one thread whenever a task is
+//     enqueued and no worker is idle, up to maxThreads. Workers that stay
+//     idle past a timeout retire, down to minThreads. Growth on enqueue also
+//     keeps the pre-existing guarantee that nested RPC calls make progress
+//     as long as the thread bound has not been reached (see the note on
+//     synchronous UDFs in ProcessGroupAgent).
+//
+// Queue length and an exponentially weighted average of service time are
+// tracked per message type; the latter drives the lane routing above.
+class TORCH_API AdaptiveWorkerPool {
+ public:
+  // The work lane starts with minWorkThreads threads and grows up to
+  // maxWorkThreads under load. The control lane has a fixed numControlThreads
+  // threads.
+  AdaptiveWorkerPool(
+      size_t minWorkThreads,
+      size_t maxWorkThreads,
+      size_t numControlThreads);
+
+  ~AdaptiveWorkerPool();
+
+  AdaptiveWorkerPool(const AdaptiveWorkerPool&) = delete;
+  AdaptiveWorkerPool& operator=(const AdaptiveWorkerPool&) = delete;
+
+  // Enqueue a task produced by a message of the given type. The type selects
+  // the lane and keys the service-time bookkeeping.
+  void run(MessageType type, std::function<void()> task);
+
+  // Block until both lanes are empty and all running tasks have finished.
+  void waitWorkComplete();
+
+  // True for message types that only touch agent or RRef bookkeeping state
+  // and are expected to complete quickly. These default to the control lane.
+  static bool isControlPlane(MessageType type);
+
+ private:
+  struct Task {
+    MessageType type;
+    std::function<void()> fn;
+  };
+
+  struct Lane {
+    Lane(size_t min, size_t max) : minThreads(min), maxThreads(max) {}
+    const size_t minThreads;
+    const size_t maxThreads;
+    std::queue<Task> tasks;
+    // number of spawned threads that have not retired
+    size_t alive{0};
+    // number of threads blocked waiting for a task
+    size_t idle{0};
+    // number of tasks currently executing
+    size_t busy{0};
+    std::condition_variable condition;
+  };
+
+  struct TypeStats {
+    int64_t queued{0};
+    int64_t completed{0};
+    double avgServiceTimeUs{0.0};
+  };
+
+  // All private methods below expect mutex_ to be held by the caller.
+  void addThread(Lane& lane);
+  void reapRetiredThreads();
+  TypeStats& statsFor(MessageType type);
+
+  void workerLoop(Lane& lane);
+
+  Lane controlLane_;
+  Lane workLane_;
+  std::unordered_map<std::thread::id, std::thread> threads_;
+  // ids of threads that exited their loop and are ready to be joined
+  std::vector<std::thread::id> retiredThreads_;
+  std::unordered_map<int, TypeStats> stats_;
+  bool shutdown_{false};
+  std::mutex mutex_;
+  std::condition_variable completed_;
+};
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
@@ -1,68 +1,97 @@
 #include <torch/csrc/distributed/rpc/process_group_agent.h>
 
 #include <c10/util/C++17.h>
+#include <c10/util/string_utils.h>
 #include <c10d/ProcessGroup.hpp>
 #include <torch/csrc/distributed/rpc/request_callback_impl.h>
+#include <torch/csrc/distributed/rpc/utils.h>
 
 #include <Python.h>
 
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+
 namespace torch {
 namespace distributed {
 namespace rpc {
 
 namespace {
 
-// Write the message into the given ostream
-std::string serialize(const Message& message) {
-  // We cast const void* to void* here because we need to create a tensor using
-  // that memory space. If is fine as that tensor stays function-local, and will
-  // not be modified during its lifetime.
-  auto payload = const_cast<void*>( // NOLINT
-      static_cast<const void*>(message.payload().data()));
-  auto payload_size = message.payload().size();
-
-  // getting tensor table from the message
-  std::vector<torch::Tensor> tensors = message.tensors();
-  // append payload as a tensor
-  tensors.push_back(torch::from_blob(payload, payload_size, {torch::kChar}));
-  // append id and autograd metadata as a tensor
-  tensors.push_back(torch::tensor({message.id()}, {torch::kInt64}));
-
-  // optional: estimate output size, to avoid some unnecessary resizing.
-  static constexpr size_t kBaseOverhead = 2048;
-  static constexpr size_t kPerTensor = 128;
-  size_t estimate = kBaseOverhead;
-  for (const auto& t : tensors) {
-    estimate += t.nbytes() + kPerTensor;
+// Number of threads reserved for the control-plane lane of the worker pool.
+// RRef bookkeeping and autograd context cleanup messages take microseconds,
+// so one dedicated thread is enough to keep them from queueing behind user
+// functions.
+constexpr size_t kNumControlThreads = 1;
+
+// Note [Same-host tensor transport]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// In packed deployments many RPC peers share a machine, and pushing tensor
+// bytes through loopback TCP wastes both bandwidth and copies. At
+// rendezvous, every agent allgathers a host identifier; when the
+// destination rank reported the same identifier, large tensor storages are
+// passed through named shared-memory segments and the message carries only
+// the segment names (see wireSerialize). The receiver maps the segments in
+// place, so tensor data crosses process boundaries without touching the
+// network stack.
+//
+// Detection assumes co-located ranks share the shared-memory namespace,
+// which containerized setups may break even when host identifiers match.
+// Set TORCH_RPC_SAME_HOST_SHM=0 to force all traffic through the wire.
+bool shmTransportEnabled() {
+  static const char* enable_c_str = std::getenv("TORCH_RPC_SAME_HOST_SHM");
+  if (!enable_c_str) {
+    return true;
   }
-
-  std::string out;
-  out.reserve(estimate);
-  torch::save(tensors, [&](const void* buf, size_t n) -> size_t {
-    out.append(static_cast<const char*>(buf), n);
-    return n;
-  });
-  return out;
+  std::string enable = enable_c_str;
+  return enable != "0" && enable != "false" && enable != "FALSE";
 }
 
-Message deserialize(MessageType type, const void* buf, size_t size) {
-  std::vector<torch::Tensor> tensors;
-
-  torch::load(tensors, static_cast<const char*>(buf), size);
-
-  TORCH_CHECK(tensors.size() >= 2, "Failed to deserialize a message.");
-  auto idTensor = std::move(tensors.back());
-  tensors.pop_back();
-  auto payloadTensor = std::move(tensors.back());
-  tensors.pop_back();
-
-  TORCH_INTERNAL_ASSERT(1, idTensor.numel());
-  int64_t id = idTensor.storage().data<int64_t>()[0];
+// Maximum length of the host identifier exchanged at rendezvous; hostnames
+// are capped at 255 bytes and the boot id is a fixed-size uuid.
+constexpr int64_t kMaxHostIdLen = 320;
+
+// Identifies the machine this process runs on. The hostname alone is not
+// unique enough (cloned images often share one), so the kernel's per-boot
+// uuid is appended where available.
+std::string localHostId() {
+  char hostname[256];
+  if (gethostname(hostname, sizeof(hostname)) != 0) {
+    hostname[0] = '\0';
+  }
+  hostname[sizeof(hostname) - 1] = '\0';
+  std::string hostId = hostname;
+  std::ifstream bootIdFile("/proc/sys/kernel/random/boot_id");
+  std::string bootId;
+  if (bootIdFile && std::getline(bootIdFile, bootId)) {
+    hostId += ":" + bootId;
+  }
+  if (hostId.size() >= kMaxHostIdLen) {
+    hostId.resize(kMaxHostIdLen - 1);
+  }
+  return hostId;
+}
 
-  const char* data = static_cast<const char*>(payloadTensor.storage().data());
-  std::vector<char> payload(data, data + payloadTensor.numel());
+// Write the message into a wire-format buffer. Tensor storages are appended
+// as raw sections referencing the storage memory, rather than being streamed
+// through the pickler byte-by-byte; see wireSerialize. With a non-empty
+// shmNamePrefix, large storages go through shared memory instead; see Note
+// [Same-host tensor transport]. The message id travels in the preamble, not
+// in the serialized buffer.
+std::string serialize(
+    const Message& message,
+    const std::string& shmNamePrefix = std::string()) {
+  return wireSerialize(message.payload(), message.tensors(), shmNamePrefix);
+}
 
-  return Message(std::move(payload), std::move(tensors), type, id);
+// The payload tensor holds the full wire-format buffer; deserialized tensors
+// adopt their data sections in place, pinning the buffer's storage instead of
+// copying the bytes out.
+Message deserialize(MessageType type, int64_t id, const torch::Tensor& buffer) {
+  auto data = wireDeserialize(buffer);
+  return Message(std::move(data.first), std::move(data.second), type, id);
 }
 
 } // namespace
@@ -118,6 +147,28 @@ void ProcessGroupAgent::collectNames() {
   }
 }
 
+void ProcessGroupAgent::collectSameHostRanks() {
+  const auto worldSize = pg_->getSize();
+  const std::string hostId = localHostId();
+
+  torch::Tensor hostIdTensor = torch::zeros({kMaxHostIdLen}, torch::kChar);
+  memcpy(hostIdTensor.storage().data(), hostId.c_str(), hostId.length());
+  std::vector<torch::Tensor> inputHostId = {hostIdTensor};
+  std::vector<std::vector<torch::Tensor>> outputHostIds(1);
+  for (int i = 0; i < worldSize; ++i) {
+    outputHostIds[0].emplace_back(
+        torch::empty({kMaxHostIdLen}, {torch::kChar}));
+  }
+  pg_->allgather(outputHostIds, inputHostId)->wait();
+
+  sameHostRanks_.resize(worldSize, false);
+  for (int i = 0; i < worldSize; ++i) {
+    torch::Tensor& tensor = outputHostIds[0][i];
+    std::string peerHostId((const char*)tensor.storage().data<signed char>());
+    sameHostRanks_[i] = i != pg_->getRank() && peerHostId == hostId;
+  }
+}
+
 ProcessGroupAgent::ProcessGroupAgent(
     std::string workerName,
     std::shared_ptr<c10d::ProcessGroup> pg,
@@ -132,9 +183,14 @@ ProcessGroupAgent::ProcessGroupAgent(
       sendCounts_(pg_->getSize()),
       recvCounts_(pg_->getSize()),
       nextId_(0),
+      shmSerial_(0),
       sendMutexes_(pg_->getSize()),
-      threadPool_(numSendRecvThreads) {
+      threadPool_(
+          /* minWorkThreads */ 1,
+          /* maxWorkThreads */ numSendRecvThreads,
+          kNumControlThreads) {
   collectNames();
+  collectSameHostRanks();
   TORCH_CHECK(
       nameMap_.size() > 1,
       "ProcessGroupAgent requires world_size to "
@@ -319,7 +375,12 @@ std::shared_ptr<FutureMessage> ProcessGroupAgent::send(
   // to our receving queue.
   if (to.id_ == (worker_id_t)pg_->getRank()) {
     TORCH_CHECK(!message.isShutdown(), "Shutting down self not supported");
-    threadPool_.run(std::bind(
+    // NB: read the type before std::bind moves the message out; argument
+    // evaluation order is unspecified.
+    const MessageType messageType = message.type();
+    threadPool_.run(
+        messageType,
+        std::bind(
         [this](const Message& message) {
           sendCounts_.increment(pg_->getRank());
           // Unlike the other cases, need to add a tensor deleter, since the
@@ -333,6 +394,7 @@ std::shared_ptr<FutureMessage> ProcessGroupAgent::send(
           enqueueRecv(RecvWork(
               getWorkerInfo(pg_->getRank()),
               message.type(),
+              message.id(),
               torch::from_blob(
                   (void*)data,
                   len,
@@ -358,14 +420,26 @@ std::shared_ptr<FutureMessage> ProcessGroupAgent::send(
 
 void ProcessGroupAgent::enqueueSend(SendWork work) {
   // NB: this can be changed to use a native move capture when moved to C++14
-  threadPool_.run(std::bind(
+  // NB: read the type before std::bind moves the work out; argument
+  // evaluation order is unspecified.
+  const MessageType messageType = work.message_.type();
+  threadPool_.run(
+      messageType,
+      std::bind(
       [this](const SendWork& work) {
-        std::string serializedPayload = serialize(work.message_);
+        // See Note [Same-host tensor transport].
+        std::string shmNamePrefix;
+        if (shmTransportEnabled() && sameHostRanks_[work.to_.id_]) {
+          shmNamePrefix = "/torch_rpc_" + c10::to_string(getpid()) + "_" +
+              c10::to_string(++shmSerial_);
+        }
+        std::string serializedPayload = serialize(work.message_, shmNamePrefix);
 
         std::vector<torch::Tensor> preamble = {torch::tensor(
             {(int64_t)pg_->getRank(),
              (int64_t)serializedPayload.length(),
-             (int64_t)work.message_.type()},
+             (int64_t)work.message_.type(),
+             (int64_t)work.message_.id()},
             {torch::kLong})};
 
         // ProcessGroup is not thread-safe when sending with the same tag, hence
@@ -404,11 +478,12 @@ void ProcessGroupAgent::enqueueSend(SendWork work) {
 }
 
 void ProcessGroupAgent::enqueueRecv(RecvWork work) {
-  threadPool_.run(std::bind(
+  const MessageType messageType = work.type_;
+  threadPool_.run(
+      messageType,
+      std::bind(
       [&](RecvWork& work) {
-        torch::Tensor& payload = work.payload_;
-        Message message =
-            deserialize(work.type_, payload.storage().data(), payload.numel());
+        Message message = deserialize(work.type_, work.id_, work.payload_);
         if (message.isRequest()) {
           send(work.from_, cb_->operator()(message));
         } else if (message.isResponse()) {
@@ -457,14 +532,15 @@ void ProcessGroupAgent::enqueueRecv(RecvWork work) {
 
 void ProcessGroupAgent::listenLoop() {
   while (true) {
-    // rank, tensor size, message type
-    std::vector<torch::Tensor> preamble = {torch::empty({3}, {torch::kInt64})};
+    // rank, tensor size, message type, message id
+    std::vector<torch::Tensor> preamble = {torch::empty({4}, {torch::kInt64})};
     pg_->recvAnysource(preamble, pg_->getRank())->wait();
     int64_t* preamble_items = preamble.front().storage().data<int64_t>();
 
     auto srcRank = preamble_items[0];
     auto size = preamble_items[1];
     MessageType type = MessageType(preamble_items[2]);
+    int64_t id = preamble_items[3];
 
     if (type == MessageType::SHUTDOWN) {
       // FIXME: This LOG also prints warnings no InitGoogleLogging() was invoked
@@ -478,7 +554,8 @@ void ProcessGroupAgent::listenLoop() {
     std::vector<torch::Tensor> tensors = {torch::empty({size}, {torch::kChar})};
     pg_->recv(tensors, srcRank, pg_->getRank())->wait();
 
-    enqueueRecv(RecvWork(allWorkerInfo_[srcRank], type, std::move(tensors[0])));
+    enqueueRecv(
+        RecvWork(allWorkerInfo_[srcRank], type, id, std::move(tensors[0])));
   }
 }
 
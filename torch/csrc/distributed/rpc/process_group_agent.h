@@ -1,7 +1,7 @@
 #pragma once
 
-#include <c10/core/thread_pool.h>
 #include <c10d/ProcessGroup.hpp>
+#include <torch/csrc/distributed/rpc/adaptive_worker_pool.h>
 #include <torch/csrc/distributed/rpc/future_message.h>
 #include <torch/csrc/distributed/rpc/python_rpc_handler.h>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
@@ -31,11 +31,16 @@ struct SendWork {
 // SendWork wraps a Message and RecvWork wraps a Tensor. The difference here is
 // to allow us to run serialization/deserialization in the worker threads.
 struct RecvWork {
-  RecvWork(const WorkerInfo& from, MessageType type, torch::Tensor&& payload)
-      : from_(from), type_(type), payload_(payload) {}
+  RecvWork(
+      const WorkerInfo& from,
+      MessageType type,
+      int64_t id,
+      torch::Tensor&& payload)
+      : from_(from), type_(type), id_(id), payload_(payload) {}
 
   const WorkerInfo& from_;
   const MessageType type_;
+  const int64_t id_;
   torch::Tensor payload_;
 };
 
@@ -97,6 +102,9 @@ class ProcessGroupAgent : public RpcAgent {
   };
 
   void collectNames();
+  // allgather host identifiers to find which ranks share this machine and
+  // can receive tensors through shared memory instead of the network stack.
+  void collectSameHostRanks();
   // put SendWork into a queue and notify the worker thread
   void enqueueSend(SendWork work);
   // put RecvWork into a queue and notify the worker thread
@@ -159,6 +167,12 @@ class ProcessGroupAgent : public RpcAgent {
   MessageCounter recvCounts_;
 
   std::atomic<int64_t> nextId_;
+  // ranks co-located on this machine, detected at rendezvous; tensors sent
+  // to them travel through shared-memory segments, with the message carrying
+  // only metadata. See Note [Same-host tensor transport].
+  std::vector<bool> sameHostRanks_;
+  // serial number for naming shared-memory segments created by this process.
+  std::atomic<int64_t> shmSerial_;
   // one mutex per ProcessGroup rank, as ProcessGroup::send is not thread-safe
   // when using the same tag.
   std::vector<std::mutex> sendMutexes_;
@@ -174,7 +188,11 @@ class ProcessGroupAgent : public RpcAgent {
   //     is done. This would result in deadlocks when we have nested RPC calls.
   //     NB: Ideally, this should be addressed by supporting asynchronous UDF.
   //         This is just a temporary solution for (2).
-  ThreadPool threadPool_;
+  // The pool is elastic: it grows up to numSendRecvThreads under bursty load
+  // and shrinks back when idle, and runs cheap control-plane messages on a
+  // dedicated lane so small bookkeeping messages are not queued behind user
+  // functions. See AdaptiveWorkerPool.
+  AdaptiveWorkerPool threadPool_;
   // Mapping of request id to FutureInfo struct.
   std::unordered_map<int64_t, FutureInfo> futures_;
   // A map to keep track of when futures time out. The map is keyed by the time
@@ -11,6 +11,14 @@
 #include <torch/csrc/distributed/rpc/script_call.h>
 #include <torch/csrc/distributed/rpc/script_remote_call.h>
 #include <torch/csrc/distributed/rpc/script_resp.h>
+#include <torch/csrc/jit/pickler.h>
+#include <torch/csrc/jit/unpickler.h>
+
+#include <TH/THAllocator.h>
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/string_utils.h>
+
+#include <cstring>
 
 namespace torch {
 namespace distributed {
@@ -101,6 +109,284 @@ std::unique_ptr<RpcCommandBase> deserializeResponse(const Message& response) {
   }
 }
 
+namespace {
+
+// Section names in the wire format. Tensor storage sections are named by
+// their pickle root key ("0", "1", ...), see Pickler::pushStorageOfTensor.
+constexpr auto kPayload = "payload";
+constexpr auto kMeta = "meta";
+
+// A storage section named "shm:<i>" holds the name of a shared-memory
+// segment containing the bytes of storage <i>, rather than the bytes
+// themselves. See the wireSerialize doc comment.
+constexpr auto kShmSectionPrefix = "shm:";
+
+// Storages below this size are shipped inline even on the same-host path;
+// the shm_open/mmap round trip per segment only pays off for bulk data.
+constexpr size_t kMinShmTensorBytes = 64 * 1024;
+
+// Sections start on this boundary (relative to the buffer start) so that
+// tensor data adopted in place by the receiver is naturally aligned for any
+// scalar type. Matches the alignment of c10 CPU allocations.
+constexpr size_t kWireAlignment = 64;
+
+size_t alignWireOffset(size_t offset) {
+  return (offset + kWireAlignment - 1) & ~(kWireAlignment - 1);
+}
+
+// Some Tensors are effectively small views into a much larger Storage, and
+// serializing the full Storage would ship bytes the receiver never reads.
+// Clone such tensors to compact them before pickling.
+at::Tensor cloneIfOversizedStorage(const at::Tensor& tensor) {
+  if (!tensor.has_storage()) {
+    return tensor;
+  }
+  size_t storageSize = tensor.element_size() * tensor.storage().size();
+  size_t usefulSize = tensor.element_size() * tensor.numel();
+  constexpr size_t kMinMultiple = 2;
+  constexpr size_t kMinRecopyBytes = 8 * 1024;
+  if (storageSize >= kMinRecopyBytes &&
+      storageSize >= usefulSize * kMinMultiple) {
+    return tensor.clone();
+  }
+  return tensor;
+}
+
+std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserializeImpl(
+    const char* data,
+    size_t data_size,
+    const c10::Storage* dataOwner) {
+  // Parse the section table.
+  std::vector<std::pair<std::string, size_t>> entries;
+  size_t pos = 0;
+  while (true) {
+    TORCH_CHECK(pos < data_size, "Wire format error: truncated header.");
+    const char* lineEnd = static_cast<const char*>(
+        memchr(data + pos, '\n', data_size - pos));
+    TORCH_CHECK(lineEnd != nullptr, "Wire format error: truncated header.");
+    size_t lineLen = lineEnd - (data + pos);
+    pos += lineLen + 1;
+    if (lineLen == 0) {
+      // Blank line terminates the section table.
+      break;
+    }
+    std::string line(lineEnd - lineLen, lineLen);
+    size_t space = line.rfind(' ');
+    TORCH_CHECK(
+        space != std::string::npos, "Wire format error: malformed header.");
+    entries.emplace_back(
+        line.substr(0, space), c10::stoull(line.substr(space + 1)));
+  }
+
+  // Locate the sections following the table.
+  std::unordered_map<std::string, std::pair<const char*, size_t>> sections;
+  for (const auto& entry : entries) {
+    pos = alignWireOffset(pos);
+    TORCH_CHECK(
+        pos + entry.second <= data_size,
+        "Wire format error: truncated section ",
+        entry.first);
+    sections[entry.first] = std::make_pair(data + pos, entry.second);
+    pos += entry.second;
+  }
+
+  std::vector<char> payload;
+  auto payloadIt = sections.find(kPayload);
+  if (payloadIt != sections.end() && payloadIt->second.second > 0) {
+    payload.assign(
+        payloadIt->second.first,
+        payloadIt->second.first + payloadIt->second.second);
+  }
+
+  std::vector<at::Tensor> tensors;
+  auto metaIt = sections.find(kMeta);
+  if (metaIt != sections.end()) {
+    const char* metaData = metaIt->second.first;
+    size_t metaSize = metaIt->second.second;
+    size_t metaPos = 0;
+    auto metaReadFunc = [&](char* buf, size_t n) -> size_t {
+      if (metaPos >= metaSize) {
+        return 0;
+      }
+      size_t toCopy = std::min(n, metaSize - metaPos);
+      memcpy(buf, metaData + metaPos, toCopy);
+      metaPos += toCopy;
+      return toCopy;
+    };
+    auto sectionReadFunc = [&](const std::string& name) -> at::DataPtr {
+      // Same-host path: the section holds the name of a shared-memory
+      // segment instead of the storage bytes. Map the segment in place and
+      // unlink it, so it is freed once the last tensor referencing the
+      // mapping goes away.
+      auto shmIt = sections.find(kShmSectionPrefix + name);
+      if (shmIt != sections.end()) {
+        const std::string segmentName(
+            shmIt->second.first, shmIt->second.second);
+        size_t segmentSize = 0;
+        return THMapAllocator::makeDataPtr(
+            segmentName.c_str(),
+            TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE |
+                TH_ALLOCATOR_MAPPED_UNLINK,
+            /* size */ 0,
+            &segmentSize);
+      }
+      auto it = sections.find(name);
+      TORCH_CHECK(
+          it != sections.end(),
+          "Couldn't find section ",
+          name,
+          " in wire-format message.");
+      void* ptr = const_cast<char*>(it->second.first); // NOLINT
+      // Zero-copy path: point the storage directly at the section, and pin
+      // the enclosing buffer with a refcount bump so it outlives the tensor.
+      // Alignment holds whenever the buffer comes from the c10 CPU allocator;
+      // fall back to a copy otherwise (e.g. a buffer inside a std::string).
+      if (dataOwner != nullptr &&
+          reinterpret_cast<uintptr_t>(ptr) % kWireAlignment == 0) {
+        auto* owner = new c10::Storage(*dataOwner);
+        return at::DataPtr(
+            ptr,
+            owner,
+            [](void* ctx) { delete static_cast<c10::Storage*>(ctx); },
+            at::DeviceType::CPU);
+      }
+      auto dptr = c10::GetCPUAllocator()->allocate(it->second.second);
+      if (it->second.second > 0) {
+        memcpy(dptr.get(), ptr, it->second.second);
+      }
+      return dptr;
+    };
+    torch::jit::Unpickler unpickler(
+        metaReadFunc,
+        /* class_resolver */ nullptr,
+        /* obj_loader */ nullptr,
+        sectionReadFunc,
+        /* device */ c10::nullopt);
+    auto tensorList = unpickler.parse_ivalue().toTensorList();
+    tensors.reserve(tensorList.size());
+    for (size_t i = 0; i < tensorList.size(); ++i) {
+      tensors.emplace_back(tensorList.get(i));
+    }
+  }
+
+  return std::make_pair(std::move(payload), std::move(tensors));
+}
+
+} // namespace
+
+std::string wireSerialize(
+    const std::vector<char>& payload,
+    const std::vector<at::Tensor>& tensors,
+    const std::string& shmNamePrefix) {
+  for (const auto& tensor : tensors) {
+    TORCH_CHECK(
+        tensor.device().is_cpu(),
+        "ProcessGroup RPC backend only supports CPU tensors, please move "
+        "your tensors to CPU before sending them over RPC. Found tensor on "
+        "device: ",
+        tensor.device());
+  }
+
+  struct Ent {
+    std::string name;
+    const char* data;
+    size_t size;
+  };
+  std::vector<Ent> entries;
+  // Backing store for the shared-memory segment names referenced by
+  // entries; reserved up front so the pointers stay stable.
+  std::vector<std::string> shmNames;
+  shmNames.reserve(tensors.size());
+
+  if (!payload.empty()) {
+    entries.push_back({kPayload, payload.data(), payload.size()});
+  }
+
+  std::string metaEntry;
+  c10::List<at::Tensor> pickledTensors;
+  std::vector<torch::jit::WriteableTensorData> tensorData;
+  if (!tensors.empty()) {
+    pickledTensors.reserve(tensors.size());
+    for (const auto& tensor : tensors) {
+      pickledTensors.push_back(cloneIfOversizedStorage(tensor));
+    }
+    // With no tensor table, the pickle stream only holds the tensor
+    // metadata; the storages are collected in tensorData and appended below
+    // as raw sections referencing the storage memory directly.
+    torch::jit::Pickler pickler(
+        [&](const char* buf, size_t sz) { metaEntry.append(buf, sz); },
+        /* tensor_table */ nullptr);
+    pickler.protocol();
+    pickler.pushIValue(pickledTensors);
+    pickler.stop();
+    tensorData = pickler.tensorData();
+    entries.push_back({kMeta, metaEntry.data(), metaEntry.size()});
+    for (size_t i = 0; i < tensorData.size(); ++i) {
+      const auto sectionName = c10::to_string(i);
+      const size_t nbytes = tensorData[i].sizeInBytes();
+      if (!shmNamePrefix.empty() && nbytes >= kMinShmTensorBytes) {
+        // Copy the storage into a named shared-memory segment and ship only
+        // the segment name. Dropping the sender's mapping does not destroy
+        // the segment; it lives until the receiver maps and unlinks it.
+        shmNames.push_back(shmNamePrefix + "_" + sectionName);
+        const std::string& segmentName = shmNames.back();
+        size_t actualSize = 0;
+        at::DataPtr segment = THMapAllocator::makeDataPtr(
+            segmentName.c_str(),
+            TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE,
+            nbytes,
+            &actualSize);
+        memcpy(segment.get(), tensorData[i].data(), nbytes);
+        entries.push_back(
+            {kShmSectionPrefix + sectionName,
+             segmentName.data(),
+             segmentName.size()});
+      } else {
+        entries.push_back({sectionName, tensorData[i].data(), nbytes});
+      }
+    }
+  }
+
+  std::string header;
+  for (const auto& entry : entries) {
+    header.append(entry.name)
+        .append(" ")
+        .append(c10::to_string(entry.size))
+        .append("\n");
+  }
+  header.push_back('\n');
+
+  size_t total = header.size();
+  for (const auto& entry : entries) {
+    total = alignWireOffset(total) + entry.size;
+  }
+
+  std::string out;
+  out.reserve(total);
+  out.append(header);
+  for (const auto& entry : entries) {
+    out.resize(alignWireOffset(out.size()), '\0');
+    out.append(entry.data, entry.size);
+  }
+  return out;
+}
+
+std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
+    const void* data,
+    size_t data_size) {
+  return wireDeserializeImpl(
+      static_cast<const char*>(data), data_size, /* dataOwner */ nullptr);
+}
+
+std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
+    const at::Tensor& buffer) {
+  TORCH_INTERNAL_ASSERT(buffer.device().is_cpu());
+  TORCH_INTERNAL_ASSERT(buffer.is_contiguous());
+  c10::Storage storage = buffer.storage();
+  return wireDeserializeImpl(
+      static_cast<const char*>(storage.data()), buffer.numel(), &storage);
+}
+
 } // namespace rpc
 } // namespace distributed
 } // namespace torch
@@ -16,6 +16,40 @@ TORCH_API std::unique_ptr<RpcCommandBase> deserializeRequest(
 TORCH_API std::unique_ptr<RpcCommandBase> deserializeResponse(
     const Message& response);
 
+// Serialize a Message's payload and tensors into a single wire-format buffer.
+// The buffer starts with a text section table (name and size per line,
+// terminated by a blank line), followed by the sections themselves: the
+// payload, a pickle of the tensor metadata, and one section per tensor
+// storage. Tensor storages are appended as raw bytes rather than being
+// streamed through the pickler, so serialization performs at most one bulk
+// memcpy per storage. Sections start on kWireAlignment boundaries so that a
+// receiver can adopt tensor data in place.
+//
+// When ``shmNamePrefix`` is non-empty, the caller has determined that the
+// receiver runs on the same machine: large tensor storages are copied into
+// named shared-memory segments (``<shmNamePrefix>_<i>``) instead of being
+// appended to the buffer, and the buffer carries only the segment names. The
+// receiver maps each segment in place and unlinks it, so the tensor bytes
+// never cross the network stack. The format is self-describing; a receiver
+// needs no out-of-band signal to tell the two layouts apart.
+TORCH_API std::string wireSerialize(
+    const std::vector<char>& payload,
+    const std::vector<at::Tensor>& tensors,
+    const std::string& shmNamePrefix = std::string());
+
+// Deserialize a wire-format buffer produced by wireSerialize. Tensor data
+// sections are copied out into freshly allocated storages.
+TORCH_API std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
+    const void* data,
+    size_t data_size);
+
+// Like the above, but takes the CPU byte tensor holding the received
+// wire-format buffer. Tensor data sections are adopted in place: the returned
+// tensors point directly into ``buffer``'s memory, pinning its storage via
+// ``c10::intrusive_ptr`` refcounting instead of copying the bytes out.
+TORCH_API std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
+    const at::Tensor& buffer);
+
 } // namespace rpc
 } // namespace distributed
 } // namespace torch
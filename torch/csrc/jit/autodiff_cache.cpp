@@ -0,0 +1,185 @@
+#include <torch/csrc/jit/autodiff_cache.h>
+
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+constexpr const char* kCacheMagic = "TORCH AUTODIFF CACHE v1";
+
+const char* cachePath() {
+  static const char* path = std::getenv("TORCH_JIT_AUTODIFF_CACHE_PATH");
+  return path;
+}
+
+std::string entryFileName(const std::string& source_ir) {
+  std::ostringstream name;
+  name << cachePath() << "/autodiff_" << std::hex
+       << std::hash<std::string>()(source_ir) << ".txt";
+  return name.str();
+}
+
+void writeIndexVector(
+    std::ostream& out,
+    const char* tag,
+    const std::vector<size_t>& indices) {
+  out << tag << " " << indices.size();
+  for (size_t index : indices) {
+    out << " " << index;
+  }
+  out << "\n";
+}
+
+bool readIndexVector(
+    std::istream& in,
+    const char* tag,
+    std::vector<size_t>* indices) {
+  std::string seen_tag;
+  size_t size = 0;
+  if (!(in >> seen_tag >> size) || seen_tag != tag) {
+    return false;
+  }
+  indices->resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (!(in >> (*indices)[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Blocks carry free-form text (graph IR), so they are length-prefixed rather
+// than line-oriented.
+void writeBlock(std::ostream& out, const char* tag, const std::string& text) {
+  out << tag << " " << text.size() << "\n" << text;
+}
+
+bool readBlock(std::istream& in, const char* tag, std::string* text) {
+  std::string seen_tag;
+  size_t size = 0;
+  if (!(in >> seen_tag >> size) || seen_tag != tag) {
+    return false;
+  }
+  in.ignore(); // the newline after the size
+  text->resize(size);
+  in.read(&(*text)[0], size);
+  return static_cast<bool>(in);
+}
+
+} // namespace
+
+bool autodiffCacheEnabled() {
+  return cachePath() != nullptr;
+}
+
+c10::optional<Gradient> loadCachedGradient(const std::string& source_ir) {
+  if (!autodiffCacheEnabled()) {
+    return c10::nullopt;
+  }
+  std::ifstream file(entryFileName(source_ir));
+  if (!file) {
+    return c10::nullopt;
+  }
+  std::string magic;
+  std::getline(file, magic);
+  if (magic != kCacheMagic) {
+    return c10::nullopt;
+  }
+  Gradient gradient;
+  std::string tag;
+  if (!(file >> tag >> gradient.f_real_outputs) || tag != "f_real_outputs") {
+    return c10::nullopt;
+  }
+  if (!readIndexVector(file, "df_input_vjps", &gradient.df_input_vjps) ||
+      !readIndexVector(
+          file,
+          "df_input_captured_inputs",
+          &gradient.df_input_captured_inputs) ||
+      !readIndexVector(
+          file,
+          "df_input_captured_outputs",
+          &gradient.df_input_captured_outputs) ||
+      !readIndexVector(file, "df_output_vjps", &gradient.df_output_vjps)) {
+    return c10::nullopt;
+  }
+  // The full source IR is stored alongside the entry so that a hash collision
+  // or a stale file can never hand back the gradient of a different graph.
+  std::string source;
+  std::string f_ir;
+  std::string df_ir;
+  if (!readBlock(file, "source", &source) || source != source_ir ||
+      !readBlock(file, "f", &f_ir) || !readBlock(file, "df", &df_ir)) {
+    return c10::nullopt;
+  }
+  gradient.f = std::make_shared<Graph>();
+  gradient.df = std::make_shared<Graph>();
+  try {
+    script::parseIR(f_ir, gradient.f.get());
+    script::parseIR(df_ir, gradient.df.get());
+  } catch (const std::exception&) {
+    return c10::nullopt;
+  }
+  return gradient;
+}
+
+void storeCachedGradient(
+    const std::string& source_ir,
+    const Gradient& gradient) {
+  if (!autodiffCacheEnabled() || !gradient.df) {
+    return;
+  }
+  const std::string f_ir =
+      gradient.f->toString(/*print_source_locations=*/false);
+  const std::string df_ir =
+      gradient.df->toString(/*print_source_locations=*/false);
+  // Only persist entries that survive a parse round trip; graphs with
+  // constructs the IR parser does not support (e.g. tensor constants) are
+  // recomputed every run instead of poisoning the cache.
+  try {
+    Graph parsed_f;
+    Graph parsed_df;
+    script::parseIR(f_ir, &parsed_f);
+    script::parseIR(df_ir, &parsed_df);
+  } catch (const std::exception&) {
+    return;
+  }
+  const std::string file_name = entryFileName(source_ir);
+  const std::string tmp_name = file_name + ".tmp";
+  std::ofstream file(tmp_name, std::ios::trunc);
+  if (!file) {
+    return;
+  }
+  file << kCacheMagic << "\n";
+  file << "f_real_outputs " << gradient.f_real_outputs << "\n";
+  writeIndexVector(file, "df_input_vjps", gradient.df_input_vjps);
+  writeIndexVector(
+      file, "df_input_captured_inputs", gradient.df_input_captured_inputs);
+  writeIndexVector(
+      file, "df_input_captured_outputs", gradient.df_input_captured_outputs);
+  writeIndexVector(file, "df_output_vjps", gradient.df_output_vjps);
+  writeBlock(file, "source", source_ir);
+  writeBlock(file, "f", f_ir);
+  writeBlock(file, "df", df_ir);
+  file.close();
+  if (!file) {
+    std::remove(tmp_name.c_str());
+    return;
+  }
+  // Write-then-rename so concurrent jobs sharing a cache directory never
+  // observe a partially written entry.
+  std::rename(tmp_name.c_str(), file_name.c_str());
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <c10/util/Optional.h>
+#include <torch/csrc/jit/autodiff.h>
+
+#include <string>
+
+namespace torch {
+namespace jit {
+
+// Optional on-disk cache of differentiated graphs, keyed by the IR of the
+// autodiff subgraph. When TORCH_JIT_AUTODIFF_CACHE_PATH names a writable
+// directory, the graph executor stores each Gradient produced by
+// differentiate() there and reloads it on subsequent runs, so frequently
+// restarted training jobs skip symbolic differentiation during warmup.
+
+TORCH_API bool autodiffCacheEnabled();
+
+// Returns the cached Gradient for a subgraph whose pre-differentiation IR is
+// source_ir, or c10::nullopt on a miss. Entries that fail to parse (e.g.
+// written by a different version) or whose stored source IR does not match
+// are treated as misses.
+TORCH_API c10::optional<Gradient> loadCachedGradient(
+    const std::string& source_ir);
+
+// Writes gradient to the cache directory under the entry for source_ir.
+// Failures are not fatal; the entry is simply recomputed next time.
+TORCH_API void storeCachedGradient(
+    const std::string& source_ir,
+    const Gradient& gradient);
+
+} // namespace jit
+} // namespace torch
@@ -6,13 +6,16 @@
 #include <torch/csrc/jit/pickle.h>
 #include <torch/csrc/jit/source_range_serialization.h>
 #include <torch/csrc/jit/instruction.h>
+#include <torch/csrc/jit/mobile/flat_bytecode.h>
 #include <torch/csrc/jit/passes/inliner.h>
 
 #include <caffe2/serialize/inline_container.h>
 
 #include <ATen/ATen.h>
 
+#include <cstring>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace torch {
@@ -25,6 +28,169 @@ ExportModuleExtraFilesHook& GetExtraFilesHook() {
   static ExportModuleExtraFilesHook func = nullptr;
   return func;
 };
+
+// Builds the flat, position-independent "bytecode.flat" record described in
+// mobile/flat_bytecode.h, written next to the pickled bytecode archive. The
+// builder becomes unsupported (and the record is skipped) as soon as it sees
+// a constant that a FlatConstant cannot represent; the pickled archive is
+// always written and remains the fallback.
+class FlatBytecodeBuilder {
+ public:
+  void addFunction(
+      const std::string& qualname,
+      const std::vector<Instruction>& instructions,
+      const std::vector<c10::OperatorName>& opnames,
+      const std::vector<IValue>& constants,
+      size_t register_size) {
+    if (!supported_) {
+      return;
+    }
+    FunctionEntry entry;
+    entry.name_offset = intern(qualname);
+    entry.register_size = register_size;
+    for (const auto& ins : instructions) {
+      mobile::FlatInstruction fins;
+      fins.op = static_cast<uint8_t>(ins.op);
+      fins.padding = 0;
+      fins.N = ins.N;
+      fins.X = ins.X;
+      entry.instructions.push_back(fins);
+    }
+    for (const auto& opname : opnames) {
+      mobile::FlatOperator fop;
+      fop.name_offset = intern(opname.name);
+      fop.overload_name_offset = intern(opname.overload_name);
+      entry.operators.push_back(fop);
+    }
+    for (const auto& constant : constants) {
+      mobile::FlatConstant fc;
+      fc.string_offset = 0;
+      fc.scalar_bits = 0;
+      if (constant.isNone()) {
+        fc.tag = static_cast<uint32_t>(mobile::FlatConstantTag::NONE);
+      } else if (constant.isBool()) {
+        fc.tag = static_cast<uint32_t>(mobile::FlatConstantTag::BOOL);
+        fc.scalar_bits = constant.toBool() ? 1 : 0;
+      } else if (constant.isInt()) {
+        fc.tag = static_cast<uint32_t>(mobile::FlatConstantTag::INT);
+        fc.scalar_bits = static_cast<uint64_t>(constant.toInt());
+      } else if (constant.isDouble()) {
+        fc.tag = static_cast<uint32_t>(mobile::FlatConstantTag::DOUBLE);
+        double value = constant.toDouble();
+        std::memcpy(&fc.scalar_bits, &value, sizeof(value));
+      } else if (constant.isString()) {
+        fc.tag = static_cast<uint32_t>(mobile::FlatConstantTag::STRING);
+        fc.string_offset = intern(constant.toStringRef());
+      } else {
+        supported_ = false;
+        return;
+      }
+      entry.constants.push_back(fc);
+    }
+    functions_.push_back(std::move(entry));
+  }
+
+  bool supported() const {
+    return supported_;
+  }
+
+  std::vector<char> build() const {
+    // Layout: header, function table, per-function arrays, string pool.
+    size_t offset = sizeof(mobile::FlatHeader);
+    const size_t table_offset = offset;
+    offset += functions_.size() * sizeof(mobile::FlatFunction);
+    std::vector<mobile::FlatFunction> table;
+    for (const auto& entry : functions_) {
+      mobile::FlatFunction f;
+      f.name_offset = 0; // rebased below, once the pool offset is known
+      f.register_size = entry.register_size;
+      f.instructions_offset = offset;
+      f.num_instructions = entry.instructions.size();
+      offset += entry.instructions.size() * sizeof(mobile::FlatInstruction);
+      f.operators_offset = offset;
+      f.num_operators = entry.operators.size();
+      offset += entry.operators.size() * sizeof(mobile::FlatOperator);
+      f.constants_offset = offset;
+      f.num_constants = entry.constants.size();
+      offset += entry.constants.size() * sizeof(mobile::FlatConstant);
+      table.push_back(f);
+    }
+    const size_t pool_offset = offset;
+
+    std::vector<char> buf;
+    buf.reserve(pool_offset + pool_.size());
+    mobile::FlatHeader header;
+    header.magic = mobile::kFlatBytecodeMagic;
+    header.version = mobile::kFlatBytecodeVersion;
+    header.num_functions = functions_.size();
+    header.function_table_offset = table_offset;
+    append(buf, &header, sizeof(header));
+    for (size_t i = 0; i < functions_.size(); ++i) {
+      mobile::FlatFunction f = table[i];
+      f.name_offset = functions_[i].name_offset + pool_offset;
+      append(buf, &f, sizeof(f));
+    }
+    // String offsets collected so far are pool-relative; rebase them to the
+    // start of the record while the arrays are copied out.
+    for (const auto& entry : functions_) {
+      append(
+          buf,
+          entry.instructions.data(),
+          entry.instructions.size() * sizeof(mobile::FlatInstruction));
+      for (auto op : entry.operators) {
+        op.name_offset += pool_offset;
+        op.overload_name_offset += pool_offset;
+        append(buf, &op, sizeof(op));
+      }
+      for (auto constant : entry.constants) {
+        if (constant.tag ==
+            static_cast<uint32_t>(mobile::FlatConstantTag::STRING)) {
+          constant.string_offset += pool_offset;
+        }
+        append(buf, &constant, sizeof(constant));
+      }
+    }
+    append(buf, pool_.data(), pool_.size());
+    return buf;
+  }
+
+ private:
+  struct FunctionEntry {
+    uint32_t name_offset;
+    uint32_t register_size;
+    std::vector<mobile::FlatInstruction> instructions;
+    std::vector<mobile::FlatOperator> operators;
+    std::vector<mobile::FlatConstant> constants;
+  };
+
+  // Returns the pool-relative offset of s, appending it (a uint32_t byte
+  // length, the bytes, padding to a 4-byte boundary) on first sighting.
+  uint32_t intern(const std::string& s) {
+    auto it = interned_.find(s);
+    if (it != interned_.end()) {
+      return it->second;
+    }
+    uint32_t offset = pool_.size();
+    uint32_t len = s.size();
+    append(pool_, &len, sizeof(len));
+    append(pool_, s.data(), s.size());
+    while (pool_.size() % 4 != 0) {
+      pool_.push_back('\0');
+    }
+    interned_.emplace(s, offset);
+    return offset;
+  }
+
+  static void append(std::vector<char>& buf, const void* data, size_t size) {
+    auto ptr = static_cast<const char*>(data);
+    buf.insert(buf.end(), ptr, ptr + size);
+  }
+
+  std::vector<FunctionEntry> functions_;
+  std::vector<char> pool_;
+  std::unordered_map<std::string, uint32_t> interned_;
+  bool supported_ = true;
+};
 }
 
 void SetExportModuleExtraFilesHook(ExportModuleExtraFilesHook hook) {
@@ -147,6 +313,7 @@ class ScriptModuleSerializer {
   void writeByteCode(const script::Module& module) {
     auto methods = module.get_methods();
     std::vector<c10::IValue> elements;
+    FlatBytecodeBuilder flat_builder;
     for (const auto& method : methods) {
       const auto& func = method.function();
       auto graph = func.graph()->copy();
@@ -164,6 +331,7 @@ class ScriptModuleSerializer {
 
       // instructions
       std::vector<IValue> inss;
+      std::vector<Instruction> instructions_copy;
       for (size_t i = 0; i < code.instructions().size(); ++i) {
         Instruction ins = code.instructions()[i];
         TORCH_CHECK(isOpSupportedInMobile(ins.op), toString(ins.op),
@@ -199,6 +367,7 @@ class ScriptModuleSerializer {
             }
           }
         }
+        instructions_copy.push_back(ins);
         std::vector<IValue> insv{toString(ins.op), ins.X, ins.N};
         inss.emplace_back(c10::ivalue::Tuple::create(std::move(insv)));
       }
@@ -223,9 +392,20 @@ class ScriptModuleSerializer {
 
       auto element = c10::ivalue::Tuple::create({named_ins, named_ops, named_consts, named_regsize});
       elements.push_back(c10::ivalue::Tuple::create({func.qualname().qualifiedName(), element}));
+
+      flat_builder.addFunction(
+          func.qualname().qualifiedName(),
+          instructions_copy,
+          opnames,
+          code.constant_table(),
+          code.register_size());
     }
     auto telements = c10::ivalue::Tuple::create(std::move(elements));
     writeArchive("bytecode", telements);
+    if (flat_builder.supported()) {
+      auto flat = flat_builder.build();
+      writer_.writeRecord("bytecode.flat", flat.data(), flat.size());
+    }
   }
 
   void convertNamedType(const c10::NamedTypePtr& class_type) {
@@ -1,8 +1,11 @@
 #include <torch/csrc/jit/function.h>
 #include <torch/csrc/jit/passes/inliner.h>
 
+#include <torch/csrc/autograd/grad_mode.h>
 #include <torch/csrc/jit/script/error_report.h>
 
+#include <ATen/Parallel.h>
+
 namespace torch {
 namespace jit {
 namespace {
@@ -45,6 +48,33 @@ IValue Function::operator()(
   return stack.front();
 }
 
+c10::intrusive_ptr<c10::ivalue::Future> Function::runAsync(
+    std::vector<IValue> stack,
+    const Kwargs& kwargs) {
+  getSchema().checkAndNormalizeInputs(stack, kwargs);
+  TypePtr return_type = getSchema().returns().size() == 1
+      ? getSchema().returns()[0].type()
+      : AnyType::get();
+  auto future =
+      c10::make_intrusive<c10::ivalue::Future>(std::move(return_type));
+  // Grad mode is thread local; the task observes the caller's setting the
+  // same way forked interpreter continuations do.
+  bool grad_mode_enabled = autograd::GradMode::is_enabled();
+  at::launch([this, future, grad_mode_enabled,
+              stack = std::move(stack)]() mutable {
+    autograd::AutoGradMode grad_mode(grad_mode_enabled);
+    try {
+      run(stack);
+      future->markCompleted(
+          stack.empty() ? IValue() : std::move(stack.front()));
+    } catch (const std::exception& e) {
+      future->markCompleted(
+          c10::ivalue::Future::FutureError(std::string(e.what())));
+    }
+  });
+  return future;
+}
+
 void Function::ensure_defined() {
   try {
     if (function_creator_) {
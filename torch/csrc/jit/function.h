@@ -32,6 +32,16 @@ struct TORCH_API Function {
       std::vector<IValue> stack,
       const Kwargs& kwargs = Kwargs());
 
+  // Enqueues this function on the inter-op pool and returns a future that
+  // completes with its result (or carries the thrown error, rethrown from
+  // Future::value()). Argument checking happens synchronously, so schema
+  // mismatches still surface at the call site. The function must outlive
+  // the future; callers normally guarantee this by holding the owning
+  // module (Method::run_async binds self, which does so automatically).
+  c10::intrusive_ptr<c10::ivalue::Future> runAsync(
+      std::vector<IValue> stack,
+      const Kwargs& kwargs = Kwargs());
+
   std::shared_ptr<Graph> graph() const {
     return graph_;
   }
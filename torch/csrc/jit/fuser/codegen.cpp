@@ -330,6 +330,12 @@ std::string generateKernel(
   std::stringstream tensorOffsets;
   std::vector<std::string> formals;
   std::vector<std::string> argument_loads;
+  std::vector<std::string> persistent_loads;
+  // Byte offset of the next argument in a persistent-mode work descriptor.
+  // Offset 0 holds totalElements; every argument is packed at the next
+  // 8-byte boundary. The host-side packing in
+  // FusedKernelCUDA::launchPersistent must use the identical layout.
+  size_t persistent_offset = 8;
 
   // Lambda for writing arguments
   auto emitFormal = [&](const Value* n, const TensorDesc& desc) {
@@ -351,6 +357,14 @@ std::string generateKernel(
       argument_loads.push_back(format(
           "*static_cast<TensorInfo<${scalar_type},${nDim}>*>(args[${formal_index}])",
           env));
+      env.d("persistent_offset", persistent_offset);
+      persistent_loads.push_back(format(
+          "const TensorInfo<${scalar_type},${nDim}> ${tensor} = "
+          "*reinterpret_cast<const TensorInfo<${scalar_type},${nDim}>*>(slot + ${persistent_offset});",
+          env));
+      // sizeof(TensorInfo<T, N>): a data pointer plus 2 * N IndexType values,
+      // which is already 8-byte aligned.
+      persistent_offset += 8 + 8 * nDim;
   };
 
   auto emitScalarFormal = [&](const Value* n){
@@ -371,6 +385,13 @@ std::string generateKernel(
     formals.push_back(format("${scalar_type} ${scalar}", env));
     argument_loads.push_back(format(
     "*static_cast<${scalar_type}*>(args[${formal_index}])", env));
+    env.d("persistent_offset", persistent_offset);
+    persistent_loads.push_back(format(
+        "const ${scalar_type} ${scalar} = "
+        "*reinterpret_cast<const ${scalar_type}*>(slot + ${persistent_offset});",
+        env));
+    // Scalars are passed as 8-byte values (see the executor).
+    persistent_offset += 8;
   };
 
 
@@ -516,6 +537,14 @@ std::string generateKernel(
   env.v("argument_loads", argument_loads);
   std::string code_string;
   if (use_cuda) {
+    // Random kernels take per-launch philox arguments and are excluded from
+    // the persistent execution mode.
+    if (persistentFusionEnabled() && !has_random) {
+      env.v("persistentArgumentLoads", persistent_loads);
+      env.s("PersistentEntry", cuda::cuda_persistent_entry_template.format(env));
+    } else {
+      env.s("PersistentEntry", "");
+    }
     env.s("type_declarations", cuda::type_declarations_template.format(env));
     code_string = cuda::cuda_compilation_unit_template.format(env);
   } else {
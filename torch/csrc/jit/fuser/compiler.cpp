@@ -75,6 +75,14 @@ int debugFuser() {
   return debug_fusion;
 }
 
+bool persistentFusionEnabled() {
+  static const bool enabled = []() {
+    const char* env = getenv("PYTORCH_FUSION_PERSISTENT");
+    return env != nullptr && atoi(env) != 0;
+  }();
+  return enabled;
+}
+
 // If the given node is used once by a chunk node, returns that node.
 // Returns nullptr otherwise.
 static const Node* usedInFusedChunk(const Value* input) {
@@ -289,6 +297,7 @@ std::shared_ptr<FusedKernel> compileKernel(
       device.index(),
       name,
       code,
+      graph,
       input_desc,
       output_desc,
       chunk_desc,
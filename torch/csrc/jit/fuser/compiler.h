@@ -33,10 +33,19 @@ TORCH_API size_t nCompiledKernels();
 
 TORCH_API int debugFuser();
 
+// True when PYTORCH_FUSION_PERSISTENT is set, enabling the resident
+// ("persistent") execution mode of the CUDA fusion backend. See Note
+// [Persistent fusion kernels] in cuda/fused_kernel.cpp.
+TORCH_API bool persistentFusionEnabled();
+
+// Note: subgraph is the shape-propagated copy of the fusion group that the
+// code string was generated from; backends that don't compile the code
+// (e.g. the CPU interpreter) evaluate it directly.
 using FusedKernelConstructor = std::function<std::shared_ptr<FusedKernel>(
     int16_t device,
     std::string name,
     std::string code,
+    std::shared_ptr<Graph> subgraph,
     std::vector<TensorDesc> input_desc,
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
@@ -3,6 +3,7 @@
 #include <c10/util/Optional.h>
 #include <torch/csrc/jit/code_template.h>
 #include <torch/csrc/jit/fuser/compiler.h>
+#include <torch/csrc/jit/fuser/cpu/interpreted_kernel.h>
 #include <torch/csrc/jit/fuser/cpu/temp_file.h>
 #include <torch/csrc/utils/memory.h>
 
@@ -308,15 +309,39 @@ FusedKernelCPU::FusedKernelCPU(
 #pragma GCC diagnostic pop
 }
 
+// Returns true if fused kernels should be interpreted in-process instead of
+// compiled with an external toolchain: either no usable compiler was found
+// (no CXX/g++/cl on the host, e.g. in locked-down deployment containers), or
+// interpretation was forced with PYTORCH_CPU_FUSER_INTERPRET=1.
+static bool useInterpreter() {
+  static const bool forced = []() {
+    const char* env = getenv("PYTORCH_CPU_FUSER_INTERPRET");
+    return env != nullptr && atoi(env) != 0;
+  }();
+  return forced || getConfig().cxx.empty();
+}
+
 static std::shared_ptr<FusedKernel> createFusionKernel(
     int16_t device,
     std::string name,
     std::string code,
+    std::shared_ptr<Graph> subgraph,
     std::vector<TensorDesc> input_desc,
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
     std::vector<PartitionDesc> concat_desc,
     bool has_random) {
+  if (useInterpreter()) {
+    return std::make_shared<InterpretedFusedKernel>(
+        std::move(name),
+        std::move(code),
+        std::move(subgraph),
+        std::move(input_desc),
+        std::move(output_desc),
+        std::move(chunk_desc),
+        std::move(concat_desc),
+        has_random);
+  }
   return std::make_shared<FusedKernelCPU>(
       std::move(name),
       std::move(code),
@@ -0,0 +1,592 @@
+#include <torch/csrc/jit/fuser/cpu/interpreted_kernel.h>
+
+#include <ATen/Parallel.h>
+#include <c10/util/Exception.h>
+#include <torch/csrc/jit/fuser/tensor_info.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+namespace fuser {
+namespace cpu {
+
+namespace {
+
+// Node kinds the interpreter evaluates; must stay in sync with the
+// simple_map_ops table in codegen.cpp (minus rand_like, which is
+// CUDA-only). aten::clamp is special-cased in lowerGraph because of its
+// optional min/max inputs.
+const std::unordered_map<NodeKind, InterpretedFusedKernel::Op>&
+simpleMapOps() {
+  static const std::unordered_map<NodeKind, InterpretedFusedKernel::Op> ops = {
+      {aten::_cast_Float, InterpretedFusedKernel::Op::CastFloat},
+      {aten::abs, InterpretedFusedKernel::Op::Abs},
+      {aten::sigmoid, InterpretedFusedKernel::Op::Sigmoid},
+      {aten::relu, InterpretedFusedKernel::Op::Relu},
+      {aten::threshold, InterpretedFusedKernel::Op::Threshold},
+      {aten::log, InterpretedFusedKernel::Op::Log},
+      {aten::log10, InterpretedFusedKernel::Op::Log10},
+      {aten::log1p, InterpretedFusedKernel::Op::Log1p},
+      {aten::log2, InterpretedFusedKernel::Op::Log2},
+      {aten::lgamma, InterpretedFusedKernel::Op::Lgamma},
+      {aten::exp, InterpretedFusedKernel::Op::Exp},
+      {aten::expm1, InterpretedFusedKernel::Op::Expm1},
+      {aten::erf, InterpretedFusedKernel::Op::Erf},
+      {aten::erfc, InterpretedFusedKernel::Op::Erfc},
+      {aten::cos, InterpretedFusedKernel::Op::Cos},
+      {aten::acos, InterpretedFusedKernel::Op::Acos},
+      {aten::cosh, InterpretedFusedKernel::Op::Cosh},
+      {aten::sin, InterpretedFusedKernel::Op::Sin},
+      {aten::asin, InterpretedFusedKernel::Op::Asin},
+      {aten::sinh, InterpretedFusedKernel::Op::Sinh},
+      {aten::tan, InterpretedFusedKernel::Op::Tan},
+      {aten::atan, InterpretedFusedKernel::Op::Atan},
+      {aten::tanh, InterpretedFusedKernel::Op::Tanh},
+      {aten::sqrt, InterpretedFusedKernel::Op::Sqrt},
+      {aten::rsqrt, InterpretedFusedKernel::Op::Rsqrt},
+      {aten::ceil, InterpretedFusedKernel::Op::Ceil},
+      {aten::floor, InterpretedFusedKernel::Op::Floor},
+      {aten::round, InterpretedFusedKernel::Op::Round},
+      {aten::trunc, InterpretedFusedKernel::Op::Trunc},
+      {aten::frac, InterpretedFusedKernel::Op::Frac},
+      {aten::reciprocal, InterpretedFusedKernel::Op::Reciprocal},
+      {aten::neg, InterpretedFusedKernel::Op::Neg},
+      {aten::atan2, InterpretedFusedKernel::Op::Atan2},
+      {aten::min, InterpretedFusedKernel::Op::Min},
+      {aten::max, InterpretedFusedKernel::Op::Max},
+      {aten::__and__, InterpretedFusedKernel::Op::And},
+      {aten::__lshift__, InterpretedFusedKernel::Op::Lshift},
+      {aten::__or__, InterpretedFusedKernel::Op::Or},
+      {aten::__rshift__, InterpretedFusedKernel::Op::Rshift},
+      {aten::__xor__, InterpretedFusedKernel::Op::Xor},
+      {aten::addcmul, InterpretedFusedKernel::Op::Addcmul},
+      {aten::div, InterpretedFusedKernel::Op::Div},
+      {aten::eq, InterpretedFusedKernel::Op::Eq},
+      {aten::fmod, InterpretedFusedKernel::Op::Fmod},
+      {aten::ge, InterpretedFusedKernel::Op::Ge},
+      {aten::gt, InterpretedFusedKernel::Op::Gt},
+      {aten::le, InterpretedFusedKernel::Op::Le},
+      {aten::lt, InterpretedFusedKernel::Op::Lt},
+      {aten::lerp, InterpretedFusedKernel::Op::Lerp},
+      {aten::type_as, InterpretedFusedKernel::Op::TypeAs},
+      {aten::mul, InterpretedFusedKernel::Op::Mul},
+      {aten::ne, InterpretedFusedKernel::Op::Ne},
+      {aten::remainder, InterpretedFusedKernel::Op::Remainder},
+      {aten::pow, InterpretedFusedKernel::Op::Pow},
+      {aten::add, InterpretedFusedKernel::Op::Add},
+      {aten::sub, InterpretedFusedKernel::Op::Sub},
+      {aten::where, InterpretedFusedKernel::Op::Where},
+      {aten::_sigmoid_backward, InterpretedFusedKernel::Op::SigmoidBackward},
+      {aten::_tanh_backward, InterpretedFusedKernel::Op::TanhBackward},
+  };
+  return ops;
+}
+
+// If the given node is used once by a chunk node, returns that node.
+// Returns nullptr otherwise. (Mirrors usedInFusedChunk in compiler.cpp.)
+const Node* usedInFusedChunk(const Value* input) {
+  const auto& uses = input->uses();
+  if (uses.size() == 1) {
+    const Node* user = uses[0].user;
+    if (user->kind() == prim::ConstantChunk) {
+      return user;
+    }
+  }
+  return nullptr;
+}
+
+// Rounds a value through the given scalar type, like the intermediate
+// variable assignments (and final output stores) in the generated C++ do.
+// Registers hold doubles, which represent every other supported type
+// exactly, so float results stay bit-identical to single-precision
+// arithmetic for +, -, *, / and comparisons.
+double narrowTo(const double v, const at::ScalarType type) {
+  switch (type) {
+    case at::ScalarType::Float:
+      return static_cast<float>(v);
+    case at::ScalarType::Double:
+      return v;
+    case at::ScalarType::Byte:
+      return static_cast<uint8_t>(v);
+    case at::ScalarType::Char:
+      return static_cast<int8_t>(v);
+    case at::ScalarType::Short:
+      return static_cast<int16_t>(v);
+    case at::ScalarType::Int:
+      return static_cast<int32_t>(v);
+    case at::ScalarType::Long:
+      return static_cast<double>(static_cast<int64_t>(v));
+    case at::ScalarType::Bool:
+      return v != 0.;
+    default:
+      AT_ERROR(
+          "unsupported scalar type in CPU fusion interpreter: ",
+          toString(type));
+  }
+}
+
+double loadElement(
+    const void* data,
+    const at::ScalarType type,
+    const uint32_t offset) {
+  switch (type) {
+    case at::ScalarType::Float:
+      return static_cast<const float*>(data)[offset];
+    case at::ScalarType::Double:
+      return static_cast<const double*>(data)[offset];
+    case at::ScalarType::Byte:
+      return static_cast<const uint8_t*>(data)[offset];
+    case at::ScalarType::Char:
+      return static_cast<const int8_t*>(data)[offset];
+    case at::ScalarType::Short:
+      return static_cast<const int16_t*>(data)[offset];
+    case at::ScalarType::Int:
+      return static_cast<const int32_t*>(data)[offset];
+    case at::ScalarType::Long:
+      return static_cast<const int64_t*>(data)[offset];
+    case at::ScalarType::Bool:
+      return static_cast<const bool*>(data)[offset];
+    default:
+      AT_ERROR(
+          "unsupported scalar type in CPU fusion interpreter: ",
+          toString(type));
+  }
+}
+
+void storeElement(
+    void* data,
+    const at::ScalarType type,
+    const uint32_t offset,
+    const double v) {
+  switch (type) {
+    case at::ScalarType::Float:
+      static_cast<float*>(data)[offset] = static_cast<float>(v);
+      return;
+    case at::ScalarType::Double:
+      static_cast<double*>(data)[offset] = v;
+      return;
+    case at::ScalarType::Byte:
+      static_cast<uint8_t*>(data)[offset] = static_cast<uint8_t>(v);
+      return;
+    case at::ScalarType::Char:
+      static_cast<int8_t*>(data)[offset] = static_cast<int8_t>(v);
+      return;
+    case at::ScalarType::Short:
+      static_cast<int16_t*>(data)[offset] = static_cast<int16_t>(v);
+      return;
+    case at::ScalarType::Int:
+      static_cast<int32_t*>(data)[offset] = static_cast<int32_t>(v);
+      return;
+    case at::ScalarType::Long:
+      static_cast<int64_t*>(data)[offset] = static_cast<int64_t>(v);
+      return;
+    case at::ScalarType::Bool:
+      static_cast<bool*>(data)[offset] = (v != 0.);
+      return;
+    default:
+      AT_ERROR(
+          "unsupported scalar type in CPU fusion interpreter: ",
+          toString(type));
+  }
+}
+
+// Converts a linear index into an offset of the tensor, like
+// emitIndexingFor in codegen.cpp.
+uint32_t offsetFor(
+    const uint32_t* sizes,
+    const uint32_t* strides,
+    const uint16_t ndim,
+    uint32_t linear_index) {
+  uint32_t offset = 0;
+  for (uint16_t d = ndim; d-- > 1;) {
+    offset += (linear_index % sizes[d]) * strides[d];
+    linear_index /= sizes[d];
+  }
+  if (ndim > 0) {
+    offset += linear_index * strides[0];
+  }
+  return offset;
+}
+
+} // namespace
+
+constexpr uint16_t InterpretedFusedKernel::kNoReg;
+
+InterpretedFusedKernel::InterpretedFusedKernel(
+    std::string name,
+    std::string code,
+    std::shared_ptr<Graph> subgraph,
+    std::vector<TensorDesc> input_desc,
+    std::vector<TensorDesc> output_desc,
+    std::vector<PartitionDesc> chunk_desc,
+    std::vector<PartitionDesc> concat_desc,
+    bool has_random)
+    : FusedKernel(
+          std::move(name),
+          std::move(code),
+          std::move(input_desc),
+          std::move(output_desc),
+          std::move(chunk_desc),
+          std::move(concat_desc),
+          has_random) {
+  TORCH_CHECK(
+      !has_random_,
+      "random number generation is not supported by the CPU fusion interpreter");
+  lowerGraph(*subgraph);
+}
+
+void InterpretedFusedKernel::lowerGraph(const Graph& subgraph) {
+  std::unordered_map<const Value*, uint16_t> registers;
+  size_t num_registers = 0;
+  const auto regFor = [&](const Value* v) -> uint16_t {
+    const auto it = registers.find(v);
+    if (it != registers.end()) {
+      return it->second;
+    }
+    TORCH_CHECK(
+        num_registers < kNoReg,
+        "fused subgraph has too many values to interpret");
+    const auto reg = static_cast<uint16_t>(num_registers++);
+    registers.emplace(v, reg);
+    return reg;
+  };
+
+  // Binds the flattened inputs, in the same order launchFusion packs the
+  // arguments: tensor inputs (expanded into their chunks) first, then
+  // scalar inputs (see flat_inputs in compileKernel).
+  size_t input_index = 0;
+  for (const Value* p : subgraph.inputs()) {
+    if (p->type()->isSubtypeOf(FloatType::get())) {
+      scalar_formals_.push_back(regFor(p));
+    }
+    if (!p->type()->isSubtypeOf(TensorType::get())) {
+      continue;
+    }
+    const auto& chunk = chunk_desc_[input_index];
+    const auto& desc = input_desc_[input_index];
+    ++input_index;
+    if (chunk.isNoop()) {
+      input_formals_.push_back(
+          {regFor(p), desc.scalar_type, static_cast<uint16_t>(desc.nDim())});
+    } else {
+      const Node* chunk_node = usedInFusedChunk(p);
+      AT_ASSERT(chunk_node != nullptr);
+      const auto& sub_desc = *chunk.subTensorDesc();
+      for (const Value* o : chunk_node->outputs()) {
+        input_formals_.push_back(
+            {regFor(o),
+             sub_desc.scalar_type,
+             static_cast<uint16_t>(sub_desc.nDim())});
+      }
+    }
+  }
+
+  // Lowers the nodes. Concat and chunk are implicit: chunk formals are
+  // bound above and FusedConcat outputs are narrowed views created by
+  // launchFusion before the kernel runs.
+  std::vector<std::pair<uint16_t, double>> constants;
+  for (const Node* n : subgraph.nodes()) {
+    if (n->kind() == prim::FusedConcat || n->kind() == prim::ConstantChunk) {
+      continue;
+    }
+    if (n->mustBeNone()) {
+      continue;
+    }
+    if (n->kind() == prim::Constant) {
+      const auto val = toIValue(n->output()).value();
+      double d = 0;
+      if (val.isDouble()) {
+        d = val.toDouble();
+      } else if (val.isBool()) {
+        d = val.toBool();
+      } else {
+        AT_ASSERT(val.isInt());
+        d = val.toInt();
+      }
+      constants.emplace_back(regFor(n->output()), d);
+      continue;
+    }
+
+    Instruction instr;
+    const auto out_type = n->output()->type()->expect<TensorType>()->scalarType();
+    TORCH_INTERNAL_ASSERT(out_type);
+    instr.out_type = *out_type;
+    instr.out = regFor(n->output());
+    std::fill(std::begin(instr.in), std::end(instr.in), kNoReg);
+    if (n->kind() == aten::clamp) {
+      instr.op = Op::Clamp;
+      instr.in[0] = regFor(n->input(0));
+      if (!n->input(1)->node()->mustBeNone()) {
+        instr.in[1] = regFor(n->input(1));
+      }
+      if (!n->input(2)->node()->mustBeNone()) {
+        instr.in[2] = regFor(n->input(2));
+      }
+      TORCH_CHECK(
+          instr.in[1] != kNoReg || instr.in[2] != kNoReg,
+          "At least one of 'min' or 'max' must not be None");
+    } else {
+      const auto it = simpleMapOps().find(n->kind());
+      if (it == simpleMapOps().end()) {
+        throw std::runtime_error(
+            std::string("unsupported operator in CPU fusion interpreter: ") +
+            n->kind().toDisplayString());
+      }
+      instr.op = it->second;
+      AT_ASSERT(n->inputs().size() <= 4);
+      for (size_t i = 0; i < n->inputs().size(); ++i) {
+        instr.in[i] = regFor(n->input(i));
+      }
+    }
+    instructions_.push_back(instr);
+  }
+
+  // Binds the flattened outputs (see flat_outputs in compileKernel).
+  size_t output_index = 0;
+  for (const Value* o : subgraph.outputs()) {
+    const auto& concat = concat_desc_[output_index];
+    const auto& desc = output_desc_[output_index];
+    ++output_index;
+    if (concat.isNoop()) {
+      output_formals_.push_back(
+          {regFor(o), desc.scalar_type, static_cast<uint16_t>(desc.nDim())});
+    } else {
+      const auto& sub_desc = *concat.subTensorDesc();
+      for (const Value* c : o->node()->inputs()) {
+        output_formals_.push_back(
+            {regFor(c),
+             sub_desc.scalar_type,
+             static_cast<uint16_t>(sub_desc.nDim())});
+      }
+    }
+  }
+
+  const_registers_.assign(num_registers, 0.);
+  for (const auto& constant : constants) {
+    const_registers_[constant.first] = constant.second;
+  }
+}
+
+double InterpretedFusedKernel::evalInstruction(
+    const Instruction& instr,
+    const double* regs) const {
+  // Operands are cast to the result type before the operation, except for
+  // comparisons and the where condition, matching typeCastedValueName in
+  // codegen.cpp.
+  const auto raw = [&](const size_t i) { return regs[instr.in[i]]; };
+  const auto in = [&](const size_t i) {
+    return narrowTo(regs[instr.in[i]], instr.out_type);
+  };
+  const auto asInt = [&](const size_t i) {
+    return static_cast<int64_t>(regs[instr.in[i]]);
+  };
+
+  switch (instr.op) {
+    case Op::CastFloat:
+      return static_cast<float>(raw(0));
+    case Op::Abs:
+      return std::fabs(in(0));
+    case Op::Sigmoid:
+      return 1. / (1. + std::exp(-in(0)));
+    case Op::Relu: {
+      const double x = in(0);
+      return x < 0 ? 0 : x;
+    }
+    case Op::Threshold:
+      return in(0) <= in(1) ? in(2) : in(0);
+    case Op::Log:
+      return std::log(in(0));
+    case Op::Log10:
+      return std::log10(in(0));
+    case Op::Log1p:
+      return std::log1p(in(0));
+    case Op::Log2:
+      return std::log2(in(0));
+    case Op::Lgamma:
+      return std::lgamma(in(0));
+    case Op::Exp:
+      return std::exp(in(0));
+    case Op::Expm1:
+      return std::expm1(in(0));
+    case Op::Erf:
+      return std::erf(in(0));
+    case Op::Erfc:
+      return std::erfc(in(0));
+    case Op::Cos:
+      return std::cos(in(0));
+    case Op::Acos:
+      return std::acos(in(0));
+    case Op::Cosh:
+      return std::cosh(in(0));
+    case Op::Sin:
+      return std::sin(in(0));
+    case Op::Asin:
+      return std::asin(in(0));
+    case Op::Sinh:
+      return std::sinh(in(0));
+    case Op::Tan:
+      return std::tan(in(0));
+    case Op::Atan:
+      return std::atan(in(0));
+    case Op::Tanh:
+      return std::tanh(in(0));
+    case Op::Sqrt:
+      return std::sqrt(in(0));
+    case Op::Rsqrt:
+      return 1. / std::sqrt(in(0));
+    case Op::Ceil:
+      return std::ceil(in(0));
+    case Op::Floor:
+      return std::floor(in(0));
+    case Op::Round:
+      return std::round(in(0));
+    case Op::Trunc:
+      return std::trunc(in(0));
+    case Op::Frac: {
+      const double x = in(0);
+      return x - std::trunc(x);
+    }
+    case Op::Reciprocal:
+      return 1. / in(0);
+    case Op::Neg:
+      return -in(0);
+    case Op::Atan2:
+      return std::atan2(in(0), in(1));
+    case Op::Min:
+      return std::fmin(in(0), in(1));
+    case Op::Max:
+      return std::fmax(in(0), in(1));
+    case Op::And:
+      return (raw(0) != 0.) && (raw(1) != 0.);
+    case Op::Lshift:
+      return asInt(0) << asInt(1);
+    case Op::Or:
+      return (raw(0) != 0.) || (raw(1) != 0.);
+    case Op::Rshift:
+      return asInt(0) >> asInt(1);
+    case Op::Xor:
+      return asInt(0) ^ asInt(1);
+    case Op::Addcmul:
+      return in(0) + in(3) * in(1) * in(2);
+    case Op::Div:
+      return in(0) / in(1);
+    case Op::Eq:
+      return raw(0) == raw(1);
+    case Op::Fmod:
+      return std::fmod(in(0), in(1));
+    case Op::Ge:
+      return raw(0) >= raw(1);
+    case Op::Gt:
+      return raw(0) > raw(1);
+    case Op::Le:
+      return raw(0) <= raw(1);
+    case Op::Lt:
+      return raw(0) < raw(1);
+    case Op::Lerp:
+      return in(0) + in(2) * (in(1) - in(0));
+    case Op::TypeAs:
+      return in(0);
+    case Op::Mul:
+      return in(0) * in(1);
+    case Op::Ne:
+      return raw(0) != raw(1);
+    case Op::Remainder:
+      return std::remainder(in(0), in(1));
+    case Op::Pow:
+      return std::pow(in(0), in(1));
+    case Op::Add:
+      return in(0) + in(2) * in(1);
+    case Op::Sub:
+      return in(0) - in(2) * in(1);
+    case Op::Where:
+      return raw(0) != 0. ? in(1) : in(2);
+    case Op::SigmoidBackward:
+      return in(0) * in(1) * (1. - in(1));
+    case Op::TanhBackward:
+      return in(0) * (1. - in(1) * in(1));
+    case Op::Clamp: {
+      // Note: the bounds are compared first so that NaN bounds are
+      // "ignored" and a NaN input propagates (see encodeSpecialRHS).
+      const double x = in(0);
+      if (instr.in[1] != kNoReg && instr.in[2] != kNoReg) {
+        const double lo = in(1);
+        const double hi = in(2);
+        return x < lo ? lo : (x > hi ? hi : x);
+      } else if (instr.in[1] == kNoReg) {
+        const double hi = in(2);
+        return x > hi ? hi : x;
+      } else {
+        const double lo = in(1);
+        return x < lo ? lo : x;
+      }
+    }
+  }
+  AT_ERROR("unknown operation in CPU fusion interpreter");
+}
+
+void InterpretedFusedKernel::launch_raw(
+    const uint32_t numel,
+    std::vector<void*>& arguments) const {
+  // Resolves the TensorInfo arguments once, outside the element loop.
+  struct ResolvedFormal {
+    void* data;
+    const uint32_t* sizes;
+    const uint32_t* strides;
+    uint16_t ndim;
+    at::ScalarType type;
+    uint16_t reg;
+  };
+  const auto resolve = [](TensorInfo* ti, const TensorFormal& f) {
+    return ResolvedFormal{
+        ti->data, ti->sizes(f.ndim), ti->strides(f.ndim), f.ndim, f.type, f.reg};
+  };
+
+  size_t arg = 1; // the first argument is a pointer to numel
+  std::vector<ResolvedFormal> inputs;
+  inputs.reserve(input_formals_.size());
+  for (const auto& f : input_formals_) {
+    inputs.push_back(resolve(static_cast<TensorInfo*>(arguments[arg++]), f));
+  }
+
+  std::vector<double> initial_registers = const_registers_;
+  for (const auto reg : scalar_formals_) {
+    initial_registers[reg] = *static_cast<double*>(arguments[arg++]);
+  }
+
+  std::vector<ResolvedFormal> outputs;
+  outputs.reserve(output_formals_.size());
+  for (const auto& f : output_formals_) {
+    outputs.push_back(resolve(static_cast<TensorInfo*>(arguments[arg++]), f));
+  }
+
+  at::parallel_for(
+      0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        std::vector<double> regs = initial_registers;
+        for (int64_t linear_index = begin; linear_index < end; ++linear_index) {
+          for (const auto& f : inputs) {
+            const auto offset = offsetFor(
+                f.sizes, f.strides, f.ndim, static_cast<uint32_t>(linear_index));
+            regs[f.reg] = loadElement(f.data, f.type, offset);
+          }
+          for (const auto& instr : instructions_) {
+            regs[instr.out] =
+                narrowTo(evalInstruction(instr, regs.data()), instr.out_type);
+          }
+          for (const auto& f : outputs) {
+            const auto offset = offsetFor(
+                f.sizes, f.strides, f.ndim, static_cast<uint32_t>(linear_index));
+            storeElement(f.data, f.type, offset, regs[f.reg]);
+          }
+        }
+      });
+}
+
+} // namespace cpu
+} // namespace fuser
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/fuser/fused_kernel.h>
+#include <torch/csrc/jit/ir.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+namespace fuser {
+namespace cpu {
+
+// Runs a fused subgraph in-process by interpreting it element by element,
+// instead of shelling out to an external C++ compiler at runtime
+// (see FusedKernelCPU). This keeps CPU fusion functional in deployments
+// where no toolchain is installed.
+//
+// At construction the (shape-propagated) subgraph is lowered once into a
+// flat list of register-machine instructions; launch_raw then evaluates
+// that list for every output element, parallelized with at::parallel_for.
+// The argument convention is identical to the compiled kernels: a pointer
+// to numel followed by TensorInfo structs for the flattened inputs, scalar
+// inputs and flattened outputs (see launchFusion in executor.cpp).
+struct TORCH_API InterpretedFusedKernel
+    : public ::torch::jit::fuser::FusedKernel {
+  InterpretedFusedKernel(
+      std::string name,
+      std::string code,
+      std::shared_ptr<Graph> subgraph,
+      std::vector<TensorDesc> input_desc,
+      std::vector<TensorDesc> output_desc,
+      std::vector<PartitionDesc> chunk_desc,
+      std::vector<PartitionDesc> concat_desc,
+      bool has_random);
+
+  at::Backend backend() const override {
+    return at::Backend::CPU;
+  }
+
+  void launch_raw(const uint32_t numel, std::vector<void*>& arguments)
+      const override;
+
+  // Operations the interpreter supports; mirrors the "simple mappable" op
+  // table in codegen.cpp.
+  enum class Op : uint8_t {
+    CastFloat,
+    Abs,
+    Sigmoid,
+    Relu,
+    Threshold,
+    Log,
+    Log10,
+    Log1p,
+    Log2,
+    Lgamma,
+    Exp,
+    Expm1,
+    Erf,
+    Erfc,
+    Cos,
+    Acos,
+    Cosh,
+    Sin,
+    Asin,
+    Sinh,
+    Tan,
+    Atan,
+    Tanh,
+    Sqrt,
+    Rsqrt,
+    Ceil,
+    Floor,
+    Round,
+    Trunc,
+    Frac,
+    Reciprocal,
+    Neg,
+    Atan2,
+    Min,
+    Max,
+    And,
+    Lshift,
+    Or,
+    Rshift,
+    Xor,
+    Addcmul,
+    Div,
+    Eq,
+    Fmod,
+    Ge,
+    Gt,
+    Le,
+    Lt,
+    Lerp,
+    TypeAs,
+    Mul,
+    Ne,
+    Remainder,
+    Pow,
+    Add,
+    Sub,
+    Where,
+    SigmoidBackward,
+    TanhBackward,
+    Clamp,
+  };
+
+ private:
+  // Marks an absent operand (e.g. a None min/max on aten::clamp).
+  static constexpr uint16_t kNoReg = 0xffff;
+
+  // One pointwise operation lowered from a subgraph node. Operands index
+  // the per-thread register file of doubles; after evaluation the result
+  // is narrowed to out_type, matching the intermediate variable types the
+  // generated C++ would have used.
+  struct Instruction {
+    Op op;
+    at::ScalarType out_type;
+    uint16_t out;
+    uint16_t in[4];
+  };
+
+  // Binding of a flattened input/output tensor argument to a register.
+  struct TensorFormal {
+    uint16_t reg;
+    at::ScalarType type;
+    uint16_t ndim; // compressed, see TensorDesc::nDim()
+  };
+
+  void lowerGraph(const Graph& subgraph);
+  double evalInstruction(const Instruction& instr, const double* regs) const;
+
+  std::vector<TensorFormal> input_formals_;
+  std::vector<uint16_t> scalar_formals_;
+  std::vector<TensorFormal> output_formals_;
+  std::vector<Instruction> instructions_;
+  // Register image each thread starts from; holds the graph's constants.
+  std::vector<double> const_registers_;
+};
+
+} // namespace cpu
+} // namespace fuser
+} // namespace jit
+} // namespace torch
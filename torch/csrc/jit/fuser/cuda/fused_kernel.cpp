@@ -7,17 +7,29 @@
 #include <ATen/CUDAGenerator.h>
 #include <THC/THC.h>
 #include <c10/cuda/CUDAGuard.h>
+#include <c10/util/C++17.h>
 #include <torch/csrc/jit/resource_guard.h>
 
 #include <cuda_runtime.h>
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <tuple>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace torch {
 namespace jit {
 namespace fuser {
@@ -64,6 +76,163 @@ static void getMajorMinor(
   }
 }
 
+// Note [Persistent fusion kernel cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// NVRTC compilation costs hundreds of milliseconds per kernel and the
+// in-process kernel cache does nothing for fresh processes, so fleets that
+// cold-start many workers pay it over and over.  When
+// TORCH_FUSER_CACHE_DIR is set, compiled PTX is also memoized on disk,
+// keyed by a hash of the generated source together with the compute
+// architecture and NVRTC version.  Files are written to a temp name and
+// renamed so concurrent processes never observe partial PTX.
+#ifndef _WIN32
+
+static std::string fusionCacheDir() {
+  const char* dir = std::getenv("TORCH_FUSER_CACHE_DIR");
+  return dir ? dir : "";
+}
+
+static std::string ptxCachePath(
+    const std::string& dir,
+    const std::string& code,
+    const int major,
+    const int minor) {
+  int nvrtc_major, nvrtc_minor;
+  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcVersion(&nvrtc_major, &nvrtc_minor));
+  // The source length is folded in alongside the hash to make accidental
+  // collisions between different kernels even less likely.
+  std::ostringstream path;
+  path << dir << "/fused_" << std::hex << std::hash<std::string>()(code)
+       << "_" << std::dec << code.size() << "_sm" << major << minor << "_nvrtc"
+       << nvrtc_major << "." << nvrtc_minor << ".ptx";
+  return path.str();
+}
+
+static bool readCachedPTX(const std::string& path, std::vector<char>& ptx) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  const auto size = file.tellg();
+  if (size <= 0) {
+    return false;
+  }
+  ptx.resize(static_cast<size_t>(size) + 1);
+  file.seekg(0);
+  file.read(ptx.data(), size);
+  // cuModuleLoadData expects a NUL-terminated image
+  ptx[size] = '\0';
+  return bool(file);
+}
+
+static void writeCachedPTX(const std::string& path, const std::vector<char>& ptx) {
+  mkdir(fusionCacheDir().c_str(), 0700);
+  const std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream file(tmp_path, std::ios::binary);
+    if (!file) {
+      return;  // cache writes are best-effort
+    }
+    file.write(ptx.data(), ptx.size());
+  }
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    remove(tmp_path.c_str());
+  }
+}
+
+#endif  // _WIN32
+
+// Note [Persistent fusion kernels]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// At batch size 1 a fused pointwise kernel often finishes in a few
+// microseconds, so launch and teardown dominate latency-critical decode
+// loops.  When PYTORCH_FUSION_PERSISTENT is set, codegen emits an additional
+// "<name>_persistent" entry (see cuda_persistent_entry_template) and the
+// first launch starts it exactly once, on a dedicated non-blocking stream,
+// with one block per SM so other kernels can still be scheduled alongside
+// it.  The resident grid consumes packed work descriptors from a pinned
+// host-mapped ring buffer, so repeated executions of the fusion group need
+// no kernel launches at all.
+//
+// Per work item the host:
+//  1. waits (CPU side) until the descriptor slot is free, i.e. the resident
+//     kernel has published completion of the item that last used it;
+//  2. packs totalElements and the ordinary kernel arguments into the slot,
+//     using the same 8-byte-aligned layout the generated unpacking code
+//     reads (kept in sync with codegen.cpp);
+//  3. enqueues a cuStreamWriteValue32 on the work stream that bumps the
+//     published head count -- stream ordering guarantees the item's inputs
+//     are ready by the time the write executes; and
+//  4. enqueues a cuStreamWaitValue32 on the completion count, so downstream
+//     work on the stream waits for the item and ordinary stream semantics
+//     are preserved.
+//
+// Random kernels are excluded (their philox arguments are per launch), as
+// are HIP and platforms without stream memory operations: if the probing
+// cuStreamWriteValue32 fails during initialization, the mode is disabled
+// for this kernel and launches fall back to the ordinary path.
+
+// Number of descriptor slots in the ring. The host reuses a slot only after
+// the resident kernel published completion of the item that last used it.
+constexpr uint32_t kPersistentQueueCapacity = 16;
+
+struct FusedKernelCUDA::PersistentState {
+  CUfunction function = nullptr;
+  CUdeviceptr ctrl = 0; // device: [0] published head count, [1] quit flag
+  CUdeviceptr arrivals = 0; // device: per-slot block arrival counters
+  char* queue_host = nullptr; // host-mapped descriptor ring
+  CUdeviceptr queue_dev = 0;
+  volatile uint32_t* done_host = nullptr; // host-mapped completion count
+  CUdeviceptr done_dev = 0;
+  cudaStream_t resident_stream = nullptr;
+  cudaStream_t work_stream = nullptr; // stream of the last enqueued item
+  std::vector<uint32_t> arg_sizes; // bytes to pack per kernel argument
+  uint32_t slot_size = 0;
+  uint32_t seq = 0; // number of items enqueued so far
+  bool started = false;
+};
+
+#ifndef __HIP_PLATFORM_HCC__
+
+// Size of the generated TensorInfo<T, nDim> struct: a data pointer followed
+// by nDim sizes and nDim strides (IndexType each).
+static uint32_t tensorInfoBytes(const size_t nDim) {
+  return 8 + 8 * nDim;
+}
+
+static void releasePersistentResources(
+    FusedKernelCUDA::PersistentState& state) {
+  // best-effort teardown; never throws
+  if (state.resident_stream) {
+    cudaStreamDestroy(state.resident_stream);
+  }
+  if (state.ctrl) {
+    cudaFree(reinterpret_cast<void*>(state.ctrl));
+  }
+  if (state.arrivals) {
+    cudaFree(reinterpret_cast<void*>(state.arrivals));
+  }
+  if (state.queue_host) {
+    cudaFreeHost(state.queue_host);
+  }
+  if (state.done_host) {
+    cudaFreeHost(const_cast<uint32_t*>(state.done_host));
+  }
+}
+
+// Spins until the resident kernel has published completion of at least
+// `required` work items. Wrap-safe, matching the cyclic comparison of
+// CU_STREAM_WAIT_VALUE_GEQ.
+static void waitForCompletion(
+    const volatile uint32_t* done,
+    const uint32_t required) {
+  while (static_cast<int32_t>(*done - required) < 0) {
+    std::this_thread::yield();
+  }
+}
+
+#endif // __HIP_PLATFORM_HCC__
+
 // Compiles the specified kernel and stores the metadata required to run it
 FusedKernelCUDA::FusedKernelCUDA(
     int16_t device,
@@ -103,37 +272,58 @@ FusedKernelCUDA::FusedKernelCUDA(
   int major, minor;
   getMajorMinor(prop_, major, minor);
 
-  // Creates the NVRTC program
-  nvrtcProgram program;
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
-      &program, code_.c_str(), nullptr, 0, nullptr, nullptr));
+  // See Note [Persistent fusion kernel cache]
+#ifndef _WIN32
+  const std::string cache_dir = fusionCacheDir();
+  std::string cache_path;
+  bool cache_hit = false;
+  if (!cache_dir.empty()) {
+    cache_path = ptxCachePath(cache_dir, code_, major, minor);
+    cache_hit = readCachedPTX(cache_path, ptx_);
+  }
+#else
+  const bool cache_hit = false;
+#endif
+
+  if (!cache_hit) {
+    // Creates the NVRTC program
+    nvrtcProgram program;
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
+        &program, code_.c_str(), nullptr, 0, nullptr, nullptr));
 
 #ifdef __HIP_PLATFORM_HCC__
-  std::vector<const char*> args = {};
+    std::vector<const char*> args = {};
 #else
-  const std::string compute = "--gpu-architecture=compute_" +
-      std::to_string(major) + std::to_string(minor);
-  const std::vector<const char*> args = {
-      "--std=c++11", compute.c_str(), "-default-device"};
+    const std::string compute = "--gpu-architecture=compute_" +
+        std::to_string(major) + std::to_string(minor);
+    const std::vector<const char*> args = {
+        "--std=c++11", compute.c_str(), "-default-device"};
 #endif
-  const auto result =
-      nvrtc().nvrtcCompileProgram(program, args.size(), args.data());
-  if (result != NVRTC_SUCCESS) {
-    size_t logsize;
-    nvrtc().nvrtcGetProgramLogSize(program, &logsize);
-    std::vector<char> log(logsize);
-    nvrtc().nvrtcGetProgramLog(program, log.data());
-    std::stringstream cu;
-    cu << log.data();
-    throw std::runtime_error(cu.str());
-  }
-  ResourceGuard holdProgram(
-      [&] { AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcDestroyProgram(&program)); });
-  AT_CUDA_NVRTC_CHECK(result);
-  size_t ptx_size;
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTXSize(program, &ptx_size));
-  ptx_.resize(ptx_size);
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx_.data()));
+    const auto result =
+        nvrtc().nvrtcCompileProgram(program, args.size(), args.data());
+    if (result != NVRTC_SUCCESS) {
+      size_t logsize;
+      nvrtc().nvrtcGetProgramLogSize(program, &logsize);
+      std::vector<char> log(logsize);
+      nvrtc().nvrtcGetProgramLog(program, log.data());
+      std::stringstream cu;
+      cu << log.data();
+      throw std::runtime_error(cu.str());
+    }
+    ResourceGuard holdProgram(
+        [&] { AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcDestroyProgram(&program)); });
+    AT_CUDA_NVRTC_CHECK(result);
+    size_t ptx_size;
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTXSize(program, &ptx_size));
+    ptx_.resize(ptx_size);
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx_.data()));
+
+#ifndef _WIN32
+    if (!cache_path.empty()) {
+      writeCachedPTX(cache_path, ptx_);
+    }
+#endif
+  }
 
   AT_CUDA_DRIVER_CHECK(nvrtc().cuModuleLoadData(&module_, ptx_.data()));
   AT_CUDA_DRIVER_CHECK(
@@ -160,6 +350,230 @@ static int ceilDiv(const int a, const int b) {
   return (a + b - 1) / b;
 }
 
+// See Note [Persistent fusion kernels]
+bool FusedKernelCUDA::launchPersistent(
+    const uint32_t numel,
+    std::vector<void*>& arguments) const {
+#ifdef __HIP_PLATFORM_HCC__
+  (void)numel;
+  (void)arguments;
+  return false;
+#else
+  std::lock_guard<std::mutex> guard(persistent_mutex_);
+  if (persistent_broken_) {
+    return false;
+  }
+
+  if (!persistent_) {
+    auto state = c10::guts::make_unique<PersistentState>();
+
+    // Computes the packed byte size of every kernel argument, mirroring the
+    // flattening order of the executor: chunked inputs, scalars, then
+    // (possibly concatenated) outputs.
+    size_t flat_inputs = 0;
+    for (const auto& chunk : chunk_desc_) {
+      flat_inputs += chunk.nSubTensors();
+    }
+    size_t flat_outputs = 0;
+    for (const auto& concat : concat_desc_) {
+      flat_outputs += concat.nSubTensors();
+    }
+    AT_ASSERT(arguments.size() >= 1 + flat_inputs + flat_outputs);
+    const size_t n_scalars =
+        arguments.size() - 1 - flat_inputs - flat_outputs;
+    state->arg_sizes.reserve(arguments.size() - 1);
+    for (size_t i = 0; i < input_desc_.size(); ++i) {
+      const auto& chunk = chunk_desc_[i];
+      if (chunk.isNoop()) {
+        state->arg_sizes.push_back(tensorInfoBytes(input_desc_[i].nDim()));
+      } else {
+        for (size_t j = 0; j < chunk.nSubTensors(); ++j) {
+          state->arg_sizes.push_back(
+              tensorInfoBytes(chunk.subTensorDesc()->nDim()));
+        }
+      }
+    }
+    for (size_t i = 0; i < n_scalars; ++i) {
+      state->arg_sizes.push_back(sizeof(double));
+    }
+    for (size_t i = 0; i < output_desc_.size(); ++i) {
+      const auto& concat = concat_desc_[i];
+      if (concat.isNoop()) {
+        state->arg_sizes.push_back(tensorInfoBytes(output_desc_[i].nDim()));
+      } else {
+        for (size_t j = 0; j < concat.nSubTensors(); ++j) {
+          state->arg_sizes.push_back(
+              tensorInfoBytes(concat.subTensorDesc()->nDim()));
+        }
+      }
+    }
+    // Descriptor layout: totalElements padded to 8 bytes, then every
+    // argument at the next 8-byte boundary (see codegen.cpp).
+    state->slot_size = 8;
+    for (const auto size : state->arg_sizes) {
+      state->slot_size += (size + 7) & ~uint32_t(7);
+    }
+
+    const bool initialized = [&]() {
+      if (nvrtc().cuModuleGetFunction(
+              &state->function, module_, (name_ + "_persistent").c_str()) !=
+          CUDA_SUCCESS) {
+        return false;
+      }
+      void* ptr = nullptr;
+      if (cudaMalloc(&ptr, 2 * sizeof(uint32_t)) != cudaSuccess) {
+        return false;
+      }
+      state->ctrl = reinterpret_cast<CUdeviceptr>(ptr);
+      if (cudaMemset(ptr, 0, 2 * sizeof(uint32_t)) != cudaSuccess) {
+        return false;
+      }
+      if (cudaMalloc(&ptr, kPersistentQueueCapacity * sizeof(uint32_t)) !=
+          cudaSuccess) {
+        return false;
+      }
+      state->arrivals = reinterpret_cast<CUdeviceptr>(ptr);
+      if (cudaMemset(ptr, 0, kPersistentQueueCapacity * sizeof(uint32_t)) !=
+          cudaSuccess) {
+        return false;
+      }
+      if (cudaHostAlloc(
+              reinterpret_cast<void**>(&state->queue_host),
+              static_cast<size_t>(kPersistentQueueCapacity) *
+                  state->slot_size,
+              cudaHostAllocMapped) != cudaSuccess) {
+        return false;
+      }
+      if (cudaHostGetDevicePointer(&ptr, state->queue_host, 0) !=
+          cudaSuccess) {
+        return false;
+      }
+      state->queue_dev = reinterpret_cast<CUdeviceptr>(ptr);
+      uint32_t* done = nullptr;
+      if (cudaHostAlloc(
+              reinterpret_cast<void**>(&done),
+              sizeof(uint32_t),
+              cudaHostAllocMapped) != cudaSuccess) {
+        return false;
+      }
+      *done = 0;
+      state->done_host = done;
+      if (cudaHostGetDevicePointer(&ptr, done, 0) != cudaSuccess) {
+        return false;
+      }
+      state->done_dev = reinterpret_cast<CUdeviceptr>(ptr);
+      if (cudaStreamCreateWithFlags(
+              &state->resident_stream, cudaStreamNonBlocking) !=
+          cudaSuccess) {
+        return false;
+      }
+      // Probes stream memory operation support with a benign rewrite of the
+      // (still zero) head count.
+      if (nvrtc().cuStreamWriteValue32(
+              state->resident_stream, state->ctrl, 0, 0) != CUDA_SUCCESS) {
+        return false;
+      }
+      // One block per SM: enough for grid-stride pointwise work at small
+      // batch sizes while leaving SM slots for concurrently running kernels.
+      uint32_t capacity = kPersistentQueueCapacity;
+      uint32_t slot_size = state->slot_size;
+      void* params[] = {
+          &state->ctrl,
+          &state->queue_dev,
+          &capacity,
+          &slot_size,
+          &state->done_dev,
+          &state->arrivals};
+      if (nvrtc().cuLaunchKernel(
+              state->function,
+              prop_->multiProcessorCount,
+              1,
+              1,
+              kBlockSize,
+              1,
+              1,
+              0,
+              state->resident_stream,
+              params,
+              nullptr) != CUDA_SUCCESS) {
+        return false;
+      }
+      state->started = true;
+      return true;
+    }();
+
+    if (!initialized) {
+      releasePersistentResources(*state);
+      persistent_broken_ = true;
+      return false;
+    }
+    persistent_ = std::move(state);
+  }
+
+  auto& state = *persistent_;
+  AT_ASSERT(arguments.size() == state.arg_sizes.size() + 1);
+  const auto stream =
+      static_cast<cudaStream_t>(at::cuda::getCurrentCUDAStream());
+
+  // Head counts published from different streams could execute out of
+  // order; drain the queue before switching the work stream.
+  if (stream != state.work_stream && state.seq > 0) {
+    waitForCompletion(state.done_host, state.seq);
+  }
+  state.work_stream = stream;
+
+  // Waits until the resident kernel is done with this slot's previous item.
+  if (state.seq >= kPersistentQueueCapacity) {
+    waitForCompletion(
+        state.done_host, state.seq - kPersistentQueueCapacity + 1);
+  }
+
+  // Packs the descriptor (layout kept in sync with codegen.cpp).
+  const uint32_t slot_index = state.seq % kPersistentQueueCapacity;
+  char* slot =
+      state.queue_host + static_cast<size_t>(slot_index) * state.slot_size;
+  std::memcpy(slot, &numel, sizeof(uint32_t));
+  size_t offset = 8;
+  for (size_t i = 0; i < state.arg_sizes.size(); ++i) {
+    std::memcpy(slot + offset, arguments[i + 1], state.arg_sizes[i]);
+    offset += (state.arg_sizes[i] + 7) & ~size_t(7);
+  }
+
+  // Publishes the item and makes downstream work on the stream wait for its
+  // completion.
+  AT_CUDA_DRIVER_CHECK(nvrtc().cuStreamWriteValue32(
+      stream, state.ctrl, state.seq + 1, 0 /* CU_STREAM_WRITE_VALUE_DEFAULT */));
+  AT_CUDA_DRIVER_CHECK(nvrtc().cuStreamWaitValue32(
+      stream, state.done_dev, state.seq + 1, CU_STREAM_WAIT_VALUE_GEQ));
+  ++state.seq;
+  return true;
+#endif
+}
+
+void FusedKernelCUDA::shutdownPersistent() {
+#ifndef __HIP_PLATFORM_HCC__
+  std::lock_guard<std::mutex> guard(persistent_mutex_);
+  if (!persistent_) {
+    return;
+  }
+  auto& state = *persistent_;
+  if (state.started) {
+    // Drains outstanding items, then raises the quit flag and waits for the
+    // resident grid to exit.
+    waitForCompletion(state.done_host, state.seq);
+    const uint32_t quit = 1;
+    cudaMemcpy(
+        reinterpret_cast<void*>(state.ctrl + sizeof(uint32_t)),
+        &quit,
+        sizeof(uint32_t),
+        cudaMemcpyHostToDevice);
+    cudaStreamSynchronize(state.resident_stream);
+  }
+  releasePersistentResources(state);
+  persistent_.reset();
+#endif
+}
+
 void FusedKernelCUDA::launch_raw(
     const uint32_t numel,
     std::vector<void*>& arguments) const {
@@ -168,6 +582,13 @@ void FusedKernelCUDA::launch_raw(
   const auto prior_device = at::cuda::current_device();
   at::cuda::set_device(device_);
 
+  // See Note [Persistent fusion kernels]
+  if (!has_random_ && persistentFusionEnabled() &&
+      launchPersistent(numel, arguments)) {
+    at::cuda::set_device(prior_device);
+    return;
+  }
+
   const auto nBlocks = std::min(maxBlocks_, ceilDiv(numel, kBlockSize));
 
   // Adds random state to arguments if necessary
@@ -206,6 +627,7 @@ void FusedKernelCUDA::launch_raw(
 }
 
 FusedKernelCUDA::~FusedKernelCUDA() {
+  shutdownPersistent();
   nvrtc().cuModuleUnload(module_);
 }
 
@@ -213,6 +635,7 @@ static std::shared_ptr<FusedKernel> createFusionKernel(
     int16_t device,
     std::string name,
     std::string code,
+    std::shared_ptr<Graph> subgraph,
     std::vector<TensorDesc> input_desc,
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
@@ -9,6 +9,8 @@
 #include <nvrtc.h>
 
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -39,9 +41,19 @@ struct TORCH_CUDA_API FusedKernelCUDA : public ::torch::jit::fuser::FusedKernel
     return at::Backend::CUDA;
   }
 
+  // State for the resident ("persistent") execution mode. See Note
+  // [Persistent fusion kernels] in fused_kernel.cpp.
+  struct PersistentState;
+
  private:
   static constexpr auto kBlockSize = 128;
 
+  // Tries to run this launch through the resident kernel. Returns false if
+  // persistent mode is unavailable for this kernel, in which case the caller
+  // falls back to an ordinary launch. Expects the device to be set.
+  bool launchPersistent(uint32_t numel, std::vector<void*>& arguments) const;
+  void shutdownPersistent();
+
   // Note: per device to store device properties and compute launch heuristics
   //  Acquiring these values at launch time would be too slow
   int16_t device_;
@@ -50,6 +62,11 @@ struct TORCH_CUDA_API FusedKernelCUDA : public ::torch::jit::fuser::FusedKernel
   std::vector<char> ptx_;
   CUmodule module_;
   CUfunction function_;
+
+  mutable std::mutex persistent_mutex_;
+  mutable std::unique_ptr<PersistentState> persistent_;
+  // set after a failed initialization so it is only attempted once
+  mutable bool persistent_broken_ = false;
 };
 
 } // namespace cuda
@@ -180,6 +180,59 @@ void ${kernelName}(IndexType totalElements, ${formals} ${RandParam}) {
       ${kernelBody}
     }
 }
+${PersistentEntry}
+)");
+
+// Resident ("persistent") variant of the fusion kernel, emitted when
+// PYTORCH_FUSION_PERSISTENT is set. The grid stays resident on the device
+// and consumes packed work descriptors from a host-written ring buffer, so
+// repeated executions need no kernel launches. The host publishes work by
+// bumping ctrl[0] with a stream memory operation and waits for `done` to
+// catch up; see Note [Persistent fusion kernels] in fused_kernel.cpp for the
+// full protocol, including how the descriptor layout read below is kept in
+// sync with the host-side packing.
+//
+// Each block walks the descriptor sequence in order, so once every block has
+// arrived at descriptor `seq` (per-slot `arrivals` counter), all earlier
+// descriptors are complete as well and `done` can be advanced to seq + 1.
+// The last arriver resets the slot counter before publishing, and the host
+// never reuses a slot before observing its completion, so the counter is
+// always zero when a slot is reused.
+static auto cuda_persistent_entry_template = CodeTemplate(R"(
+extern "C" __global__
+void ${kernelName}_persistent(
+    volatile IndexType* ctrl,  // [0]: published work count, [1]: quit flag
+    const char* queue,         // host-mapped ring of work descriptors
+    IndexType capacity,        // descriptor slots in the ring
+    IndexType slotSize,        // bytes per descriptor slot
+    volatile IndexType* done,  // host-mapped count of completed descriptors
+    IndexType* arrivals) {     // per-slot block arrival counters
+  for (IndexType seq = 0;; ++seq) {
+    while (ctrl[0] - seq == 0 || ctrl[0] - seq > capacity) {
+      if (ctrl[1] != 0) return;
+    }
+    __threadfence();
+    const IndexType slotIndex = seq % capacity;
+    const char* slot = queue + slotIndex * slotSize;
+    const IndexType totalElements = *reinterpret_cast<const IndexType*>(slot);
+    ${persistentArgumentLoads}
+    for (IndexType linearIndex = blockIdx.x * blockDim.x + threadIdx.x;
+          linearIndex < totalElements;
+          linearIndex += gridDim.x * blockDim.x) {
+        // Convert `linearIndex` into an offset of tensor:
+        ${tensorOffsets}
+        // calculate the results
+        ${kernelBody}
+      }
+    // Make this block's output writes visible system-wide before arriving.
+    __threadfence_system();
+    if (atomicAdd(&arrivals[slotIndex], 1) + 1 == gridDim.x) {
+      arrivals[slotIndex] = 0;
+      __threadfence();
+      done[0] = seq + 1;
+    }
+  }
+}
 )");
 
 // This snippet enables half support in the jit. Following the pattern for
@@ -1,10 +1,12 @@
 #include <torch/csrc/jit/graph_executor.h>
 
 #include <ATen/core/ivalue.h>
+#include <c10/core/thread_pool.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <torch/csrc/jit/argument_spec.h>
 #include <torch/csrc/jit/autodiff.h>
+#include <torch/csrc/jit/autodiff_cache.h>
 #include <torch/csrc/jit/custom_operator.h>
 #include <torch/csrc/jit/graph_executor_impl.h>
 #include <torch/csrc/jit/interpreter.h>
@@ -19,19 +21,26 @@
 #include <torch/csrc/jit/passes/create_autodiff_subgraphs.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
 #include <torch/csrc/jit/passes/decompose_ops.h>
+#include <torch/csrc/jit/passes/device_placement.h>
 #include <torch/csrc/jit/passes/graph_fuser.h>
 #include <torch/csrc/jit/passes/inline_autodiff_subgraphs.h>
 #include <torch/csrc/jit/passes/inliner.h>
 #include <torch/csrc/jit/passes/inplace_check.h>
+#include <torch/csrc/jit/passes/loop_invariant_code_motion.h>
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_grad_of.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/memory_planning.h>
+#include <torch/csrc/jit/passes/offload_params.h>
+#include <torch/csrc/jit/passes/parallelize_branches.h>
 #include <torch/csrc/jit/passes/peephole.h>
 #include <torch/csrc/jit/passes/quantization.h>
+#include <torch/csrc/jit/passes/schedule_critical_path.h>
 #include <torch/csrc/jit/passes/remove_expands.h>
 #include <torch/csrc/jit/passes/requires_grad_analysis.h>
 #include <torch/csrc/jit/passes/shape_analysis.h>
 #include <torch/csrc/jit/passes/specialize_autogradzero.h>
+#include <torch/csrc/jit/passes/subgraph_cse.h>
 #include <torch/csrc/jit/profiling_graph_executor_impl.h>
 #include <torch/csrc/jit/profiling_record.h>
 #include <torch/csrc/jit/resource_guard.h>
@@ -41,11 +50,15 @@
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/jit/script/logging.h>
 
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
 #include <iterator>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -482,6 +495,34 @@ void GraphExecutorImplBase::run(Stack& stack) {
   last_executed_optimized_graph = plan.graph;
 }
 
+// Bound on the number of cached execution plans per executor, configurable
+// via TORCH_JIT_PLAN_CACHE_SIZE. 0 (the default) means unbounded, which is
+// the historical behavior.
+static size_t planCacheMaxSize() {
+  static const size_t max_size = []() -> size_t {
+    const char* size_c_str = std::getenv("TORCH_JIT_PLAN_CACHE_SIZE");
+    if (!size_c_str) {
+      return 0;
+    }
+    const long size = std::atol(size_c_str);
+    return size > 0 ? static_cast<size_t>(size) : 0;
+  }();
+  return max_size;
+}
+
+// Tiered execution, opt-in via TORCH_JIT_TIERED_COMPILATION=1. On a plan
+// cache miss the caller is served from the unoptimized fallback plan right
+// away while the optimized plan is compiled on the inter-op thread pool, so
+// the first request after deploy is not blocked on inlining, differentiation
+// and fusion.
+static bool tieredCompilationEnabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("TORCH_JIT_TIERED_COMPILATION");
+    return env && std::atoi(env) != 0;
+  }();
+  return enabled;
+}
+
 // a Graph can be created via tracing, or via a language-based frontend
 // GraphExecutor runs it. It can run the same graph on many different sizes
 // and different requires_grad states, and handles specializations for each
@@ -505,7 +546,7 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
     if (fallback) {
       state.fallback = fallback;
     }
-    for (auto& entry : plan_cache) {
+    for (auto& entry : plan_list) {
       state.execution_plans.emplace(entry.first, entry.second);
     }
     return state;
@@ -524,24 +565,92 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
     return fallback;
   }
 
-  const ExecutionPlan& getOrCompile(const Stack& stack) {
+  // Returns the plan by value: with a bounded cache another thread may evict
+  // an entry as soon as the lock is released, so references into the cache
+  // must not escape this function.
+  ExecutionPlan getOrCompile(const Stack& stack) {
     // outside lock guard, to minimize the time holding the lock on the fast
     // path ArgumentSpec even computes its hashCode here.
     ArgumentSpec spec =
         arg_spec_creator_.create(autograd::GradMode::is_enabled(), stack);
+    bool schedule_compilation = false;
     {
       std::lock_guard<std::mutex> lock(compile_mutex);
       auto it = plan_cache.find(spec);
       if (it != plan_cache.end()) {
+        // Move the entry to the front of the recency list.
+        plan_list.splice(plan_list.begin(), plan_list, it->second);
         logging::getLogger()->addStatValue(
             logging::runtime_counters::EXECUTION_PLAN_CACHE_HIT, 1.0);
-        return it->second;
+        return it->second->second;
       }
-      auto plan = compileSpec(spec);
-      auto r = plan_cache.emplace(std::move(spec), std::move(plan));
       logging::getLogger()->addStatValue(
           logging::runtime_counters::EXECUTION_PLAN_CACHE_MISS, 1.0);
-      return r.first->second;
+      if (!tieredCompilationEnabled() || tiered_compilation_disabled) {
+        auto plan = compileSpec(spec);
+        plan_list.emplace_front(spec, std::move(plan));
+        plan_cache.emplace(std::move(spec), plan_list.begin());
+        evictStalePlans();
+        return plan_list.front().second;
+      }
+      // Tiered execution: the optimized plan for this spec is compiled on
+      // the inter-op pool, and this call (and any that race with the
+      // compilation) runs the unoptimized fallback plan instead.
+      if (in_flight_specs.insert(spec).second) {
+        schedule_compilation = true;
+      }
+    }
+    if (schedule_compilation) {
+      // The owning GraphExecutor may be destroyed while the task is queued,
+      // so keep the impl alive for the duration (see GraphExecutorImplBase).
+      auto self = shared_from_this();
+      at::launch(
+          [this, self, spec]() { compileSpecInBackground(spec); });
+    }
+    return getOrCompileFallback();
+  }
+
+  // Body of the task scheduled by getOrCompile when tiered compilation is
+  // enabled: compiles the plan for spec and publishes it in plan_cache,
+  // where the next call for this spec picks it up.
+  void compileSpecInBackground(const ArgumentSpec& spec) {
+    ExecutionPlan plan;
+    try {
+      plan = compileSpec(spec);
+    } catch (const std::exception& e) {
+      // There is no caller to rethrow to here. Disable tiering for this
+      // executor so the next call compiles synchronously and the error
+      // surfaces where it can be handled.
+      tiered_compilation_disabled = true;
+      {
+        std::lock_guard<std::mutex> lock(compile_mutex);
+        in_flight_specs.erase(spec);
+      }
+      TORCH_WARN(
+          "background compilation of a TorchScript graph failed; "
+          "falling back to synchronous compilation: ",
+          e.what());
+      return;
+    }
+    std::lock_guard<std::mutex> lock(compile_mutex);
+    in_flight_specs.erase(spec);
+    if (plan_cache.count(spec) != 0) {
+      return;
+    }
+    plan_list.emplace_front(spec, std::move(plan));
+    plan_cache.emplace(spec, plan_list.begin());
+    evictStalePlans();
+  }
+
+  // Drops least recently used plans until the cache is within the bound
+  // set by TORCH_JIT_PLAN_CACHE_SIZE. Caller must hold compile_mutex.
+  void evictStalePlans() {
+    const size_t max_size = planCacheMaxSize();
+    while (max_size != 0 && plan_list.size() > max_size) {
+      // In-flight executions hold their own copy of the plan, so this only
+      // drops the cache's reference.
+      plan_cache.erase(plan_list.back().first);
+      plan_list.pop_back();
     }
   }
 
@@ -584,9 +693,27 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
       auto diff_nodes = CreateAutodiffSubgraphs(
           opt_graph,
           autodiff_subgraph_inlining ? autodiffSubgraphNodeThreshold : 1);
+      // Sibling subgraphs often duplicate cheap glue computations
+      // (transposes, broadcasts of the same constant). Hoist the shared
+      // ones into the surrounding graph now, before differentiate() bakes
+      // each subgraph into a gradient.
+      EliminateSubgraphCommonSubexpressions(opt_graph);
       for (Node* dnode : diff_nodes) {
         auto diff_graph = std::move(dnode->g(attr::Subgraph));
-        Gradient gradient = differentiate(diff_graph);
+        // The cache key has to be taken before differentiate() consumes the
+        // graph (see autodiff_cache.h).
+        std::string autodiff_cache_key;
+        if (autodiffCacheEnabled()) {
+          autodiff_cache_key =
+              diff_graph->toString(/*print_source_locations=*/false);
+        }
+        Gradient gradient;
+        if (auto cached = loadCachedGradient(autodiff_cache_key)) {
+          gradient = std::move(*cached);
+        } else {
+          gradient = differentiate(diff_graph);
+          storeCachedGradient(autodiff_cache_key, gradient);
+        }
         // Run post differentiation optimizations, Autodiff will replace some
         // parts of graph with new graph, these new graphs usually consists of
         // control flows and miss shape information on nodes, so we run shape
@@ -603,6 +730,27 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
           autodiff_subgraph_inlining ? autodiffSubgraphInlineThreshold : 1);
     } else {
       runNondiffOptimization(opt_graph);
+      // Straight-line graphs can be reordered so ops on the profiled
+      // critical path are scheduled first (opt-in, see
+      // schedule_critical_path.h). Runs before branch forking so forked
+      // branches inherit the critical-path-first order.
+      ScheduleCriticalPath(opt_graph);
+      // Independent branches of an inference graph can be forked onto the
+      // inter-op thread pool so they run concurrently (opt-in, see
+      // parallelize_branches.h).
+      ParallelizeBranches(opt_graph);
+      // Fixed-shape inference graphs can additionally have their
+      // intermediates packed into a preallocated arena (opt-in, see
+      // memory_planning.h).
+      PlanMemory(opt_graph);
+      // Models larger than device memory can have their weight constants
+      // evicted to pinned host memory and prefetched ahead of compute
+      // (opt-in, see offload_params.h).
+      OffloadParameters(opt_graph);
+      // Graphs whose per-device profile favors mixed execution can be
+      // split between the CPU and the home accelerator with explicit
+      // transfers at the cut (opt-in, see device_placement.h).
+      PartitionAcrossDevices(opt_graph);
     }
     // Make sure there are no leftovers from any passes.
     EliminateDeadCode(opt_graph);
@@ -612,13 +760,30 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
   ~GraphExecutorImpl() override = default;
 
   ArgumentSpecCreator arg_spec_creator_;
-  // Populated only when optimize is false (and in that case plan_cache will be
-  // unused). The compiled version of graph.
+  // The graph compiled without optimization. Populated when optimize is
+  // false (and in that case plan_cache will be unused), and used as the
+  // first tier while a background compilation is in flight when tiered
+  // compilation is enabled.
   ExecutionPlan fallback;
 
+  // Specs whose optimized plan is currently being compiled on the inter-op
+  // pool. Guarded by compile_mutex.
+  std::unordered_set<ArgumentSpec> in_flight_specs;
+
+  // Set when a background compilation throws, so that subsequent calls
+  // compile synchronously and surface the error.
+  std::atomic<bool> tiered_compilation_disabled{false};
+
   // Mapping from argument configurations to optimized versions of the graph
-  // that are specialized to the spec.
-  std::unordered_map<ArgumentSpec, ExecutionPlan> plan_cache;
+  // that are specialized to the spec. plan_list owns the plans and is kept in
+  // most-recently-used order (front = most recent) so the cache can be
+  // bounded (see planCacheMaxSize()); plan_cache points into it for O(1)
+  // lookup by spec.
+  std::list<std::pair<ArgumentSpec, ExecutionPlan>> plan_list;
+  std::unordered_map<
+      ArgumentSpec,
+      std::list<std::pair<ArgumentSpec, ExecutionPlan>>::iterator>
+      plan_cache;
 };
 
 GraphExecutor::GraphExecutor(std::shared_ptr<Graph> graph)
@@ -729,6 +894,11 @@ void runNondiffOptimization(std::shared_ptr<Graph>& graph) {
 
   FuseGraph(graph);
 
+  // Fusion works one group at a time, so computations duplicated across
+  // sibling fusion groups survive regular CSE; hoist the shared ones into
+  // the parent graph so each is computed once.
+  EliminateSubgraphCommonSubexpressions(graph);
+
   // Run custom passes that different backends can register.
   // This is done last to give internal optimization passes priority.
   for (const auto& pass : getCustomPasses()) {
@@ -746,8 +916,10 @@ void runOptimization(std::shared_ptr<Graph>& graph) {
   ConstantPropagation(graph);
 
   // Unroll small loops, and eliminate expressions that are the same at every
-  // iteration.
+  // iteration. Whatever survives unrolling gets its loop-invariant
+  // subexpressions hoisted out of the body.
   UnrollLoops(graph);
+  HoistLoopInvariants(graph);
   EliminateCommonSubexpression(graph);
 
   CheckInplace(graph);
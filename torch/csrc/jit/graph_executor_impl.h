@@ -46,7 +46,13 @@ const size_t autodiffSubgraphInlineThreshold = 5;
 // and different requires_grad states, and handles specializations for each
 // situation. GraphExecutor is completely unaware of tracing or module
 // parameters to keep the tracing concerns separated.
-struct GraphExecutorImplBase {
+//
+// Derives from enable_shared_from_this so that work scheduled on the
+// inter-op pool (see tiered compilation in graph_executor.cpp) can keep the
+// executor alive until it completes. GraphExecutor always owns its impl
+// through a shared_ptr, so shared_from_this is safe to call.
+struct GraphExecutorImplBase
+    : std::enable_shared_from_this<GraphExecutorImplBase> {
   static std::shared_ptr<Graph> prepareGraph(
       const std::shared_ptr<Graph>& graph) {
     auto copy = graph->copy();
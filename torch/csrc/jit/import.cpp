@@ -17,9 +17,18 @@
 #include "caffe2/serialize/istream_adapter.h"
 
 #include <ATen/ATen.h>
+#include <TH/THAllocator.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -56,6 +65,211 @@ void postSetStateValidate(const IValue& v) {
 
 namespace {
 
+#ifndef _WIN32
+// Note [Shared weight storages]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// load_shared_weights() moves every parameter of a loaded module into a
+// single named shm segment so that N inference processes serving the same
+// model hold one resident copy of the weights. The layout is computed
+// identically in every process: parameters are visited in module-tree order
+// and padded to 64 bytes, so the offsets derived from the local copy of the
+// model are valid against the segment no matter who created it. The creator
+// (whoever wins the O_EXCL shm_open race) copies the data in and publishes
+// the header magic last; attachers poll the magic before trusting the
+// contents. The segment is never unlinked here - its lifetime is managed by
+// whoever provisions the workers.
+constexpr uint64_t kSharedWeightsMagic = 0x5054534857543031ULL; // "PTSHWT01"
+constexpr size_t kSharedWeightsAlign = 64;
+
+struct SharedWeightsHeader {
+  uint64_t magic;
+  uint64_t total_bytes;
+  uint64_t num_tensors;
+};
+
+void shareWeightStorages(script::Module& module, const std::string& shm_name) {
+  struct Entry {
+    script::Module owner;
+    std::string field;
+    at::Tensor value;
+    size_t offset;
+  };
+  // Plan the segment layout; skipping is deterministic because it only
+  // depends on the model itself.
+  std::vector<Entry> entries;
+  size_t total = kSharedWeightsAlign; // header slot
+  for (script::Module m : module.modules()) {
+    const auto type = m.type();
+    for (size_t i = 0; i < type->numAttributes(); ++i) {
+      if (!type->is_parameter(i)) {
+        continue;
+      }
+      IValue v = m._ivalue()->getSlot(i);
+      if (!v.isTensor()) {
+        continue;
+      }
+      at::Tensor t = v.toTensor();
+      if (!t.defined() || !t.device().is_cpu() || t.is_quantized()) {
+        continue;
+      }
+      const size_t nbytes = t.numel() * t.element_size();
+      entries.push_back(Entry{m, type->getAttributeName(i), t, total});
+      total += (nbytes + kSharedWeightsAlign - 1) / kSharedWeightsAlign *
+          kSharedWeightsAlign;
+    }
+  }
+  if (entries.empty()) {
+    return;
+  }
+
+  auto region = std::make_shared<at::DataPtr>();
+  bool creator = true;
+  try {
+    *region = THMapAllocator::makeDataPtr(
+        shm_name.c_str(),
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE,
+        total,
+        nullptr);
+  } catch (const c10::Error&) {
+    // Lost the creation race (or the segment already exists from an earlier
+    // worker); attach to it instead.
+    creator = false;
+    *region = THMapAllocator::makeDataPtr(
+        shm_name.c_str(),
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE,
+        total,
+        nullptr);
+  }
+  char* base = static_cast<char*>(region->get());
+  volatile SharedWeightsHeader* header =
+      reinterpret_cast<volatile SharedWeightsHeader*>(base);
+
+  if (creator) {
+    for (const Entry& e : entries) {
+      at::Tensor src = e.value.contiguous();
+      std::memcpy(
+          base + e.offset, src.data_ptr(), src.numel() * src.element_size());
+    }
+    header->total_bytes = total;
+    header->num_tensors = entries.size();
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = kSharedWeightsMagic;
+  } else {
+    int spins = 0;
+    while (header->magic != kSharedWeightsMagic) {
+      TORCH_CHECK(
+          ++spins < 600,
+          "timed out waiting for shared weight segment '",
+          shm_name,
+          "' to be populated");
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    TORCH_CHECK(
+        header->total_bytes == total && header->num_tensors == entries.size(),
+        "shared weight segment '",
+        shm_name,
+        "' does not match this model");
+  }
+
+  // Point the parameters at the segment. The deleter keeps the mapping alive
+  // for as long as any shared tensor does.
+  for (Entry& e : entries) {
+    at::Tensor shared = at::from_blob(
+        base + e.offset,
+        e.value.sizes(),
+        [region](void*) {},
+        e.value.options());
+    shared.set_requires_grad(e.value.requires_grad());
+    e.owner.register_parameter(e.field, shared, /*is_buffer=*/false);
+  }
+}
+#endif // !_WIN32
+
+bool mmapWeightsEnabled() {
+  const char* value = std::getenv("TORCH_JIT_MMAP_WEIGHTS");
+  return value && std::atoi(value) != 0;
+}
+
+// Note [Streaming weight load]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// load_streaming() returns the module before its tensor payloads have been
+// read. While the data archive is unpickled, read_record hands each tensor
+// an empty buffer of the right size immediately (getRecordSize only consults
+// the archive's metadata) and queues the actual payload read on a single
+// background thread. The queue is FIFO and the tensor records were written
+// in module-tree order by export_module.cpp, so weights become ready in
+// roughly execution order: early layers can run while later ones are still
+// arriving from disk or the network. Per-record promises surface readiness
+// (and read errors) through the StreamingWeights handle returned to the
+// caller; the handle also owns this state, keeping the worker thread and
+// the underlying archive reader alive until every record has landed.
+struct StreamingState {
+  // Owns the archive reader once the deserializer is done with it; the
+  // queued jobs read through a raw pointer to the same object.
+  std::unique_ptr<PyTorchStreamReader> reader;
+  // The members below are only touched on the loading thread.
+  // Data pointer of each streamed buffer -> its record's future, used to
+  // attach qualified parameter names once the module has been built.
+  std::unordered_map<const void*, std::shared_future<void>> by_data_ptr;
+  // Every record future queued so far, in archive order.
+  std::vector<std::shared_future<void>> queued;
+
+  void enqueue(std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(std::move(job));
+      if (!worker_.joinable()) {
+        worker_ = std::thread([this] { run(); });
+      }
+    }
+    cv_.notify_one();
+  }
+
+  // Blocks until every read queued so far has completed. Errors are left for
+  // the record futures to report.
+  void drainQueued() {
+    for (auto& record : queued) {
+      record.wait();
+    }
+  }
+
+  ~StreamingState() {
+    // Drain remaining reads rather than dropping them - the module's
+    // storages alias the destination buffers.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+ private:
+  void run() {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !jobs_.empty() || shutdown_; });
+        if (jobs_.empty()) {
+          return;
+        }
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+      job();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> jobs_;
+  bool shutdown_ = false;
+  std::thread worker_;
+};
 
 // This is a deserializer class which loads script modules from pt files.
 // Content of the file is written using PyTorchStreamWriter, for details please
@@ -82,8 +296,29 @@ class ScriptModuleDeserializer final {
       c10::optional<at::Device> device,
       script::ExtraFilesMap& extra_files);
 
+  // Maps the whole archive read-only/copy-on-write and serves tensor
+  // records directly out of the mapping instead of copying them into
+  // freshly allocated storage.  This relies on tensor records being
+  // written uncompressed and suitably aligned by PyTorchStreamWriter.
+  void memoryMapWeights(const std::string& filename) {
+    size_t size = 0;
+    mapped_file_ = std::make_shared<at::DataPtr>(THMapAllocator::makeDataPtr(
+        filename.c_str(), /*flags=*/0, /*size=*/0, &size));
+  }
+
+  // Defers tensor payload reads to a background thread and reports their
+  // completion through `weights`. See Note [Streaming weight load].
+  void streamWeights(std::shared_ptr<StreamingWeights> weights) {
+    streaming_weights_ = std::move(weights);
+    streaming_state_ = std::make_shared<StreamingState>();
+  }
+
  private:
   IValue readArchive(const std::string& archive_name);
+  IValue readArchive(
+      const std::string& archive_name,
+      at::DataPtr pickle_ptr,
+      size_t pickle_size);
 
   std::shared_ptr<script::CompilationUnit> compilation_unit_;
   std::unique_ptr<PyTorchStreamReader> reader_;
@@ -91,6 +326,12 @@ class ScriptModuleDeserializer final {
   std::vector<at::Tensor> constants_table_;
   script::SourceImporter source_importer_;
   std::string export_prefix_ = "code/";
+  // Set by memoryMapWeights(); shared with every storage served from the
+  // mapping so the mapping outlives this deserializer.
+  std::shared_ptr<at::DataPtr> mapped_file_;
+  // Set by streamWeights(); see Note [Streaming weight load].
+  std::shared_ptr<StreamingWeights> streaming_weights_;
+  std::shared_ptr<StreamingState> streaming_state_;
 };
 
 IValue ScriptModuleDeserializer::readArchive(const std::string& archive_name) {
@@ -98,7 +339,13 @@ IValue ScriptModuleDeserializer::readArchive(const std::string& archive_name) {
   at::DataPtr pickle_ptr;
   size_t pickle_size;
   std::tie(pickle_ptr, pickle_size) = reader_->getRecord(picklename);
+  return readArchive(archive_name, std::move(pickle_ptr), pickle_size);
+}
 
+IValue ScriptModuleDeserializer::readArchive(
+    const std::string& archive_name,
+    at::DataPtr pickle_ptr,
+    size_t pickle_size) {
   size_t bytes_read = 0;
   auto data = reinterpret_cast<const char*>(pickle_ptr.get());
   auto reader = [&](char* buffer, size_t len) -> size_t {
@@ -126,6 +373,12 @@ IValue ScriptModuleDeserializer::readArchive(const std::string& archive_name) {
     size_t n = cls->numAttributes();
     if (checkHasValidSetGetState(type.type_)) {
       auto obj = c10::ivalue::Object::create(type, n);
+      if (streaming_state_ && archive_name == "data") {
+        // __setstate__ may read the tensor payloads it is handed (e.g. to
+        // repack quantized weights), so none of them may still be in flight.
+        // Everything __setstate__ can see has already been queued.
+        streaming_state_->drainQueued();
+      }
       // XXX: Do not optimize __setstate__, so that we don't try to
       // specialize the class before it is initialized.
       setGraphExecutorOptimize(false);
@@ -155,6 +408,57 @@ IValue ScriptModuleDeserializer::readArchive(const std::string& archive_name) {
   std::string archive_name_plus_slash = archive_name + "/";
   auto read_record = [&](const std::string& name) {
     std::string ss = archive_name_plus_slash + name;
+    if (streaming_state_ && archive_name == "data") {
+      // See Note [Streaming weight load]: hand back an unfilled buffer of
+      // the record's size and queue the payload read. The record's promise
+      // is fulfilled once the background thread has filled the buffer.
+      size_t size = reader_->getRecordSize(ss);
+      std::shared_ptr<void> buffer(std::malloc(size), std::free);
+      auto promise = std::make_shared<std::promise<void>>();
+      std::shared_future<void> future = promise->get_future().share();
+      streaming_state_->by_data_ptr.emplace(buffer.get(), future);
+      streaming_state_->queued.push_back(future);
+      streaming_weights_->addRecord(future);
+      PyTorchStreamReader* reader = reader_.get();
+      streaming_state_->enqueue([reader, ss, buffer, size, promise] {
+        try {
+          at::DataPtr payload;
+          size_t payload_size;
+          std::tie(payload, payload_size) = reader->getRecord(ss);
+          TORCH_CHECK(
+              payload_size == size,
+              "record ",
+              ss,
+              " changed size while streaming");
+          std::memcpy(buffer.get(), payload.get(), payload_size);
+          promise->set_value();
+        } catch (...) {
+          promise->set_exception(std::current_exception());
+        }
+      });
+      // The job above holds the buffer alive even if the module (and with
+      // it this DataPtr) is destroyed before the read lands.
+      auto* buffer_handle = new std::shared_ptr<void>(buffer);
+      return at::DataPtr(
+          buffer.get(),
+          buffer_handle,
+          [](void* ctx) { delete static_cast<std::shared_ptr<void>*>(ctx); },
+          at::kCPU);
+    }
+    if (mapped_file_) {
+      // Serve the record zero-copy out of the file mapping; the returned
+      // DataPtr shares ownership of the mapping.
+      size_t offset = reader_->getRecordOffset(ss);
+      void* data = static_cast<char*>(mapped_file_->get()) + offset;
+      auto* map_handle = new std::shared_ptr<at::DataPtr>(mapped_file_);
+      return at::DataPtr(
+          data,
+          map_handle,
+          [](void* ctx) {
+            delete static_cast<std::shared_ptr<at::DataPtr>*>(ctx);
+          },
+          at::kCPU);
+    }
     return std::get<0>(reader_->getRecord(ss));
   };
 
@@ -188,15 +492,119 @@ script::Module ScriptModuleDeserializer::deserialize(
     AT_ERROR("Legacy model format is not supported on mobile.");
 #endif
   }
+  // The data archive can only be unpickled after the constants table is
+  // populated (its class resolution compiles code that references
+  // CONSTANTS.cN), and a single pickle stream cannot be split across
+  // threads (memo references are order-dependent). What *can* overlap is
+  // fetching the data archive's pickle payload - getRecord is internally
+  // locked, so the worker's read interleaves with the constants archive's
+  // tensor record reads and overlaps with the unpickling work on this
+  // thread.
+  auto data_payload =
+      std::async(std::launch::async, [this] { return reader_->getRecord("data.pkl"); });
   auto tuple = readArchive("constants").toTuple();
   for (auto constant : tuple->elements()) {
     constants_table_.push_back(constant.toTensor());
   }
-  return script::Module(readArchive("data").toObject());
+  at::DataPtr data_ptr;
+  size_t data_size;
+  std::tie(data_ptr, data_size) = data_payload.get();
+  auto module = script::Module(
+      readArchive("data", std::move(data_ptr), data_size).toObject());
+  if (streaming_state_) {
+    // Attach qualified names so callers can wait on individual parameters
+    // and buffers; tensor attributes stay reachable through wait_all().
+    for (const auto& param : module.named_parameters(/*recurse=*/true)) {
+      auto it =
+          streaming_state_->by_data_ptr.find(param.value.storage().data());
+      if (it != streaming_state_->by_data_ptr.end()) {
+        streaming_weights_->addNamed(param.name, it->second);
+      }
+    }
+    for (const auto& buffer : module.named_buffers(/*recurse=*/true)) {
+      auto it =
+          streaming_state_->by_data_ptr.find(buffer.value.storage().data());
+      if (it != streaming_state_->by_data_ptr.end()) {
+        streaming_weights_->addNamed(buffer.name, it->second);
+      }
+    }
+    // The worker may still be reading; hand it the archive reader and let
+    // the StreamingWeights handle keep both alive.
+    streaming_state_->reader = std::move(reader_);
+    streaming_weights_->attachLoaderState(std::move(streaming_state_));
+  }
+  return module;
 }
 
 } // namespace
 
+StreamingWeights::~StreamingWeights() {
+  // Resetting the loader state drains any reads still in flight, so the
+  // module's storages are never left half-filled. See StreamingState.
+  loader_state_.reset();
+}
+
+void StreamingWeights::wait(const std::string& name) {
+  // get() rethrows any error the background read hit.
+  namedFuture(name).get();
+}
+
+void StreamingWeights::wait_all() {
+  std::vector<std::shared_future<void>> records;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records = records_;
+  }
+  for (auto& record : records) {
+    record.get();
+  }
+}
+
+bool StreamingWeights::ready(const std::string& name) {
+  return namedFuture(name).wait_for(std::chrono::seconds(0)) ==
+      std::future_status::ready;
+}
+
+bool StreamingWeights::all_ready() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& record : records_) {
+    if (record.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StreamingWeights::addRecord(std::shared_future<void> future) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  records_.push_back(std::move(future));
+}
+
+void StreamingWeights::addNamed(
+    std::string name,
+    std::shared_future<void> future) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  named_.emplace(std::move(name), std::move(future));
+}
+
+void StreamingWeights::attachLoaderState(std::shared_ptr<void> state) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  loader_state_ = std::move(state);
+}
+
+std::shared_future<void> StreamingWeights::namedFuture(
+    const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = named_.find(name);
+  TORCH_CHECK(
+      it != named_.end(),
+      "no streamed parameter or buffer named '",
+      name,
+      "'");
+  return it->second;
+}
+
 script::Module import_ir_module(
     std::shared_ptr<script::CompilationUnit> cu,
     std::istream& in,
@@ -214,6 +622,9 @@ script::Module import_ir_module(
     script::ExtraFilesMap& extra_files) {
   auto reader = torch::make_unique<PyTorchStreamReader>(filename);
   ScriptModuleDeserializer deserializer(std::move(cu), std::move(reader));
+  if (mmapWeightsEnabled()) {
+    deserializer.memoryMapWeights(filename);
+  }
   return deserializer.deserialize(device, extra_files);
 }
 
@@ -242,8 +653,50 @@ script::Module load(
     c10::optional<at::Device> device,
     script::ExtraFilesMap& extra_files) {
   std::unique_ptr<FileAdapter> rai = caffe2::make_unique<FileAdapter>(filename);
-  auto module = load(std::move(rai), device, extra_files);
+  auto reader = torch::make_unique<PyTorchStreamReader>(std::move(rai));
+  auto cu = std::make_shared<script::CompilationUnit>();
+  ScriptModuleDeserializer deserializer(std::move(cu), std::move(reader));
+  if (mmapWeightsEnabled()) {
+    deserializer.memoryMapWeights(filename);
+  }
+  return deserializer.deserialize(device, extra_files);
+}
+
+script::Module load_shared_weights(
+    const std::string& filename,
+    const std::string& shm_name,
+    c10::optional<c10::Device> device,
+    script::ExtraFilesMap& extra_files) {
+#ifdef _WIN32
+  AT_ERROR("load_shared_weights is not supported on Windows");
+#else
+  TORCH_CHECK(
+      !device || device->is_cpu(),
+      "load_shared_weights only supports CPU modules");
+  auto module = load(filename, device, extra_files);
+  // See Note [Shared weight storages]
+  shareWeightStorages(module, shm_name);
   return module;
+#endif
+}
+
+script::Module load_streaming(
+    const std::string& filename,
+    const std::shared_ptr<StreamingWeights>& weights,
+    c10::optional<c10::Device> device,
+    script::ExtraFilesMap& extra_files) {
+  TORCH_CHECK(weights, "load_streaming requires a StreamingWeights handle");
+  TORCH_CHECK(
+      !device || device->is_cpu(),
+      "load_streaming only supports CPU modules; a device copy would read "
+      "the streamed buffers before their payload arrives");
+  std::unique_ptr<FileAdapter> rai = caffe2::make_unique<FileAdapter>(filename);
+  auto reader = torch::make_unique<PyTorchStreamReader>(std::move(rai));
+  auto cu = std::make_shared<script::CompilationUnit>();
+  ScriptModuleDeserializer deserializer(std::move(cu), std::move(reader));
+  // See Note [Streaming weight load]
+  deserializer.streamWeights(weights);
+  return deserializer.deserialize(device, extra_files);
 }
 
 script::Module load(
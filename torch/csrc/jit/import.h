@@ -3,7 +3,12 @@
 #include <torch/csrc/jit/ir.h>
 #include <torch/csrc/jit/script/module.h>
 
+#include <future>
 #include <istream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace caffe2 {
 namespace serialize {
@@ -53,6 +58,80 @@ TORCH_API script::Module load(
     c10::optional<c10::Device> device = c10::nullopt,
     script::ExtraFilesMap& extra_files = default_extra_files);
 
+/// Loads a serialized `script::Module` from `filename` and places its
+/// parameter storages in the named shared-memory segment `shm_name`.
+///
+/// The first process to call this creates the segment and populates it with
+/// the parameter data; subsequent processes loading the same model attach to
+/// the existing segment and reuse the resident pages, so N worker processes
+/// pay for one copy of the weights instead of N. Every process must pass the
+/// same model file and segment name, and must treat the shared parameters as
+/// read-only. CPU only; not supported on Windows.
+TORCH_API script::Module load_shared_weights(
+    const std::string& filename,
+    const std::string& shm_name,
+    c10::optional<c10::Device> device = c10::nullopt,
+    script::ExtraFilesMap& extra_files = default_extra_files);
+
+/// Tracks which tensor records of a module loaded via `load_streaming` have
+/// finished arriving. See Note [Streaming weight load] in import.cpp.
+///
+/// `load_streaming` returns as soon as the module structure and code are
+/// deserialized; the tensor payloads are filled in by a background reader in
+/// the order they appear in the archive (which is the order `export_module`
+/// wrote them: module-tree traversal order, i.e. roughly execution order).
+/// Before running an op that consumes a given parameter, callers must observe
+/// its readiness via `wait(name)` - or call `wait_all()` once before the
+/// first forward. Destroying this handle also blocks until every pending
+/// record has arrived, so the module's storages are never left half-filled.
+struct TORCH_API StreamingWeights {
+  ~StreamingWeights();
+
+  /// Blocks until the parameter or buffer with the given qualified name (as
+  /// reported by `named_parameters()`) has finished loading. Rethrows any
+  /// error encountered while reading the record.
+  void wait(const std::string& name);
+
+  /// Blocks until every tensor record of the module has finished loading,
+  /// including tensor attributes that are neither parameters nor buffers.
+  void wait_all();
+
+  /// Returns true if the named parameter or buffer has finished loading.
+  bool ready(const std::string& name);
+
+  /// Returns true once every tensor record has finished loading.
+  bool all_ready();
+
+  // The remaining members are populated by the importer.
+  void addRecord(std::shared_future<void> future);
+  void addNamed(std::string name, std::shared_future<void> future);
+  void attachLoaderState(std::shared_ptr<void> state);
+
+ private:
+  std::shared_future<void> namedFuture(const std::string& name);
+
+  std::mutex mutex_;
+  // Every tensor record of the data archive, in archive order.
+  std::vector<std::shared_future<void>> records_;
+  // Qualified parameter/buffer name -> that tensor's record.
+  std::unordered_map<std::string, std::shared_future<void>> named_;
+  // Keeps the background reader (and the archive it reads from) alive.
+  std::shared_ptr<void> loader_state_;
+};
+
+/// Loads a serialized `script::Module` from `filename` without waiting for
+/// its weights: the call returns once the code and module structure are
+/// deserialized, while tensor payloads stream in on a background thread in
+/// archive order. `weights` reports per-parameter readiness; see
+/// `StreamingWeights`. This overlaps weight transfer (e.g. a model still
+/// being fetched into the page cache over the network) with warmup
+/// compilation and early execution. CPU only.
+TORCH_API script::Module load_streaming(
+    const std::string& filename,
+    const std::shared_ptr<StreamingWeights>& weights,
+    c10::optional<c10::Device> device = c10::nullopt,
+    script::ExtraFilesMap& extra_files = default_extra_files);
+
 /// Loads a serialized `script::Module` from the given `rai`.
 ///
 /// The reader adapter, which is for customized input stream, must contain a
@@ -37,7 +37,8 @@ namespace jit {
   _(TAIL_CALL, "F") /* replace current frame with function F */             \
   _(INTERFACE_CALL, "CI") /* call method X on the first argument (of N) */  \
   _(GET_ATTR, "S") /* get attribute from slot X in an Object */             \
-  _(SET_ATTR, "S") /* set attribute to slot X in an Object */
+  _(SET_ATTR, "S") /* set attribute to slot X in an Object */               \
+  _(OPF, "O") /* invoke fused operator group X (server interpreter only) */
 
 enum OpCode : uint8_t {
 #define DEFINE_OP(op, _) op,
@@ -6,6 +6,7 @@
 #include <c10/util/Exception.h>
 #include <torch/csrc/autograd/edge.h>
 #include <torch/csrc/autograd/grad_mode.h>
+#include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/autograd/variable.h>
 #include <torch/csrc/jit/constants.h>
 #include <torch/csrc/jit/exception_message.h>
@@ -17,6 +18,7 @@
 #include <torch/csrc/jit/script/compilation_unit.h>
 #include <torch/csrc/jit/script/jit_exception.h>
 
+#include <cstdlib>
 #include <exception>
 #include <iostream>
 #include <memory>
@@ -328,6 +330,33 @@ struct BailoutBlock {
   std::vector<Instruction> instructions; // ends in a TAIL_CALL
 };
 
+// Note [Fused operator dispatch]
+// For a typical operator the emitted instruction stream looks like
+//   LOAD a; LOAD b; OP f; STORE r
+// and the interpreter pays one dispatch (switch + pc bump) per
+// instruction even though the group always executes as a unit. For
+// small RNN-style graphs that per-instruction overhead dominates kernel
+// time. After emission we collapse such groups into a single OPF
+// instruction whose operand list lives in fused_op_table_; one dispatch
+// then performs the register loads, the operator call, and the register
+// stores. The operands still flow through the IValue stack when calling
+// the operator (the Operation ABI requires it), so aliasing ops remain
+// safe; only the per-instruction interpreter overhead is removed.
+// Groups containing a jump target anywhere but their first instruction
+// are left unfused so control flow never lands mid-group.
+struct FusedOperand {
+  OpCode op; // LOAD, MOVE or LOADC
+  int32_t idx; // register or constant index
+};
+
+struct FusedOp {
+  int32_t op; // index into operator_table_
+  int32_t store_reg = -1; // first output register, -1 if none
+  uint32_t store_n = 0; // number of output registers
+  uint32_t length; // instructions covered by this group
+  std::vector<FusedOperand> inputs;
+};
+
 struct CodeImpl {
   friend struct InterpreterState;
   std::vector<Instruction> instructions_;
@@ -341,6 +370,8 @@ struct CodeImpl {
   std::vector<Operation> operator_table_;
   std::vector<Function*> function_table_;
   std::vector<TypePtr> type_table_;
+  // see Note [Fused operator dispatch]
+  std::vector<FusedOp> fused_op_table_;
   int register_size_ = 0;
   size_t n_outputs;
   size_t n_inputs;
@@ -388,6 +419,77 @@ struct CodeImpl {
     // we deferred the emission of bailout blocks so they appear at the end
     // emit them now and patch up the jumps
     insertBailoutBlocks();
+    fuseOperatorGroups();
+  }
+
+  // see Note [Fused operator dispatch]
+  void fuseOperatorGroups() {
+    // collect every pc that a jump can land on; a fused group must not
+    // contain one anywhere but at its own start
+    std::vector<bool> is_jump_target(instructions_.size() + 1, false);
+    for (size_t i = 0; i < instructions_.size(); ++i) {
+      const Instruction& inst = instructions_[i];
+      if (inst.op == JF || inst.op == JMP || inst.op == LOOP) {
+        // conditional ops also "branch" to the fallthrough pc; marking it
+        // is conservative (groups may still start at a jump target)
+        is_jump_target[i + inst.X] = true;
+        is_jump_target[i + 1] = true;
+      }
+    }
+
+    size_t i = 0;
+    while (i < instructions_.size()) {
+      const OpCode op = instructions_[i].op;
+      if (op != LOAD && op != MOVE && op != LOADC) {
+        ++i;
+        continue;
+      }
+      // gather the run of loads feeding the next OP
+      size_t j = i;
+      std::vector<FusedOperand> inputs;
+      while (j < instructions_.size() && (j == i || !is_jump_target[j]) &&
+             (instructions_[j].op == LOAD || instructions_[j].op == MOVE ||
+              instructions_[j].op == LOADC)) {
+        inputs.push_back(FusedOperand{instructions_[j].op, instructions_[j].X});
+        ++j;
+      }
+      if (j >= instructions_.size() || instructions_[j].op != OP ||
+          is_jump_target[j]) {
+        i = j > i ? j : i + 1;
+        continue;
+      }
+      const int32_t op_idx = instructions_[j].X;
+      size_t k = j + 1;
+      int32_t store_reg = -1;
+      uint32_t store_n = 0;
+      if (k < instructions_.size() && !is_jump_target[k]) {
+        if (instructions_[k].op == STORE) {
+          store_reg = instructions_[k].X;
+          store_n = 1;
+          ++k;
+        } else if (instructions_[k].op == STOREN) {
+          store_reg = instructions_[k].X;
+          store_n = instructions_[k].N;
+          ++k;
+        }
+      }
+      if (k - i < 3) {
+        // a bare OP (or LOAD; OP) saves nothing worth a table entry
+        i = k;
+        continue;
+      }
+      FusedOp fused;
+      fused.op = op_idx;
+      fused.store_reg = store_reg;
+      fused.store_n = store_n;
+      fused.length = k - i;
+      fused.inputs = std::move(inputs);
+      fused_op_table_.push_back(std::move(fused));
+      // patch in place: the skipped instructions stay in the stream so
+      // all jump offsets (and instructions_source_) remain valid
+      instructions_[i] = Instruction(OPF, fused_op_table_.size() - 1, 0);
+      i = k;
+    }
   }
 
   const std::vector<c10::IValue>& constant_table() const {
@@ -721,7 +823,8 @@ struct CodeImpl {
 
   void dump(std::ostream& out, size_t i) const {
     out << i << " " << instructions_[i];
-    if (instructions_[i].op == OP || instructions_[i].op == CALL) {
+    if (instructions_[i].op == OP || instructions_[i].op == OPF ||
+        instructions_[i].op == CALL) {
       out << " # " << *instructions_source_[i];
     } else {
       out << "\n";
@@ -736,6 +839,133 @@ struct CodeImpl {
   }
 };
 
+// Runtime check for GUARD instructions. A profiled type only pins down the
+// components it actually observed: dimensions that varied across profiled
+// runs are stored as empty optionals (see ProfilingRecord) and accept any
+// runtime extent, while everything the type does specify - dtype, device,
+// rank, the remaining sizes and strides, requires_grad - is still checked
+// exactly. Comparing with operator== instead would reject every concrete
+// tensor once the expected type is partial, turning a shape-polymorphic
+// plan into a permanent bailout.
+static bool guardCheckPasses(const TensorTypePtr& expected, const at::Tensor& t) {
+  if (!t.defined()) {
+    return expected->undefined().value_or(false);
+  }
+  if (expected->undefined().value_or(false)) {
+    return false;
+  }
+  if (expected->scalarType() && *expected->scalarType() != t.scalar_type()) {
+    return false;
+  }
+  if (expected->device() && *expected->device() != t.device()) {
+    return false;
+  }
+  if (expected->requiresGrad() &&
+      *expected->requiresGrad() != t.requires_grad()) {
+    return false;
+  }
+  const auto& sizes = expected->sizes();
+  if (sizes.size()) {
+    if (*sizes.size() != static_cast<size_t>(t.dim())) {
+      return false;
+    }
+    for (size_t i = 0; i < *sizes.size(); i++) {
+      if (sizes[i] && *sizes[i] != t.size(i)) {
+        return false;
+      }
+    }
+  }
+  const auto& strides = expected->strides();
+  if (strides.size()) {
+    if (*strides.size() != static_cast<size_t>(t.dim())) {
+      return false;
+    }
+    for (size_t i = 0; i < *strides.size(); i++) {
+      if (strides[i] && *strides[i] != t.stride(i)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Note [Cooperative fork scheduling]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// prim::fork normally hands every forked subgraph to the inter-op thread
+// pool via at::launch. For graphs that fork many small subgraphs and wait
+// on them shortly afterwards, the queueing and wake-up cost of the pool
+// dominates the forked work itself, and the fork's outputs end up cold in
+// the waiting thread's cache.
+//
+// When TORCH_JIT_COOPERATIVE_FORK is set, forked continuations are
+// instead pushed onto a queue owned by the forking thread. The
+// interpreter already reifies its state into heap-allocated frames, so a
+// queued continuation is just a (state, stack) pair and running one
+// inline costs a function call rather than a thread hand-off. The queue
+// is consumed at two points:
+//
+//  - aten::wait on an incomplete future pops and runs queued tasks,
+//    newest first (depth-first), until the future completes or the queue
+//    drains. In the common fork-then-wait pattern this executes the
+//    forked subgraph on the waiting thread, with its results still hot in
+//    cache, and never suspends the waiter.
+//  - when the outermost interpreter run on a thread returns or suspends,
+//    any tasks still queued are flushed to at::launch in fork order, so
+//    futures that escape to callers or are awaited on other threads make
+//    progress exactly as they do today.
+//
+// The trade-off is less eager parallelism: a fork only migrates to
+// another thread once its owner blocks or finishes, which is why the mode
+// is opt-in. Inline runs nest when a forked task waits on a fork of its
+// own; the nesting depth is bounded by the fork dependency depth of the
+// graph, not by the number of sibling forks.
+
+namespace {
+thread_local std::vector<InterpreterContinuation> forked_task_queue;
+thread_local size_t interpreter_run_depth = 0;
+
+void flushQueuedForkedTasks() {
+  // launch in fork order, matching what eager at::launch would have done
+  for (auto& task : forked_task_queue) {
+    at::launch(std::move(task));
+  }
+  forked_task_queue.clear();
+}
+
+// Only the outermost interpreter run on a thread flushes leftover forked
+// tasks; nested inline runs share the queue with their parent.
+struct ForkQueueFlushGuard {
+  ForkQueueFlushGuard() {
+    ++interpreter_run_depth;
+  }
+  ~ForkQueueFlushGuard() {
+    if (--interpreter_run_depth == 0 && !forked_task_queue.empty()) {
+      flushQueuedForkedTasks();
+    }
+  }
+};
+} // namespace
+
+bool cooperativeForkEnabled() {
+  static const bool enabled =
+      std::getenv("TORCH_JIT_COOPERATIVE_FORK") != nullptr;
+  return enabled;
+}
+
+void queueForkedTask(InterpreterContinuation task) {
+  forked_task_queue.push_back(std::move(task));
+}
+
+bool runQueuedForkedTask() {
+  if (forked_task_queue.empty()) {
+    return false;
+  }
+  InterpreterContinuation task = std::move(forked_task_queue.back());
+  forked_task_queue.pop_back();
+  task();
+  return true;
+}
+
 // InterpreterState state that and used to compute a Code
 struct InterpreterStateImpl : c10::intrusive_ptr_target {
   InterpreterStateImpl(const Code& code) {
@@ -786,6 +1016,7 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
     Operation* operators;
     Function** functions;
     TypePtr* types;
+    const FusedOp* fused_ops;
 
     ActiveFrame(const Frame& frame)
         : pc(frame.pc),
@@ -793,7 +1024,8 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
           constants(frame.function->constant_table_.data()),
           operators(frame.function->operator_table_.data()),
           functions(frame.function->function_table_.data()),
-          types(frame.function->type_table_.data()) {}
+          types(frame.function->type_table_.data()),
+          fused_ops(frame.function->fused_op_table_.data()) {}
   };
 
   std::vector<Frame> frames;
@@ -830,6 +1062,8 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
   }
 
   bool runImpl(Stack& stack) {
+    // see Note [Cooperative fork scheduling]
+    ForkQueueFlushGuard flush_guard;
     // if we have never run before, then we might have to return the
     // stack when we suspend, record where it starts so we return the right
     // stack
@@ -853,6 +1087,28 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             af.operators[inst.X](stack);
             ++af.pc;
             break;
+          case OPF: {
+            // see Note [Fused operator dispatch]
+            const FusedOp& fused = af.fused_ops[inst.X];
+            for (const FusedOperand& input : fused.inputs) {
+              switch (input.op) {
+                case LOAD:
+                  stack.emplace_back(reg(input.idx));
+                  break;
+                case MOVE:
+                  stack.emplace_back(std::move(reg(input.idx)));
+                  break;
+                default:
+                  stack.emplace_back(af.constants[input.idx]);
+                  break;
+              }
+            }
+            af.operators[fused.op](stack);
+            for (size_t i = fused.store_n; i > 0; --i) {
+              reg(fused.store_reg + i - 1) = pop(stack);
+            }
+            af.pc += fused.length;
+          } break;
           case OPN:
             AT_ERROR("OPN is currently supported in mobile mode only.");
             break;
@@ -962,6 +1218,14 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             return false;
           case WAIT: {
             auto future = stack.back().toFuture();
+            if (!future->completed() && cooperativeForkEnabled()) {
+              // Give our own pending forks a chance to complete this
+              // future on this thread before paying for a suspension and
+              // a round trip through the inter-op pool. See
+              // Note [Cooperative fork scheduling].
+              while (!future->completed() && runQueuedForkedTask())
+                ;
+            }
             if (!future->completed()) {
               getOrCreateFuture();
 
@@ -1010,10 +1274,8 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
           } break;
           case GUARD: {
             auto t = stack.back().toTensor();
-            auto actual = t.defined() ? TensorType::create(t)
-                                      : TensorType::get()->withUndefined();
             const TypePtr &expected = af.types[inst.X];
-            push(stack, *expected == *actual);
+            push(stack, guardCheckPasses(expected->expect<TensorType>(), t));
             ++af.pc;
           } break;
           case TAIL_CALL: {
@@ -1175,7 +1437,17 @@ InterpreterState::InterpreterState(
     c10::intrusive_ptr<c10::intrusive_ptr_target> pImpl_)
     : pImpl(std::move(pImpl_)) {}
 
+InterpreterContinuation::InterpreterContinuation(
+    InterpreterState state_,
+    Stack stack_,
+    bool grad_mode_enabled_)
+    : state(state_),
+      stack(std::move(stack_)),
+      grad_mode_enabled(grad_mode_enabled_),
+      task_flow_id(autograd::profiler::emitTaskLaunch()) {}
+
 void InterpreterContinuation::operator()() {
+  autograd::profiler::emitTaskRun(task_flow_id);
   autograd::AutoGradMode grad_mode(grad_mode_enabled);
   state.runAsync(stack);
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <c10/util/Optional.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -83,13 +84,13 @@ struct Suspend : public std::exception {
 };
 
 struct InterpreterContinuation {
+  // Defined in interpreter.cpp: records the launch point with the
+  // profiler so the trace export can draw an inter-op task edge from the
+  // launching op to wherever this continuation ends up running.
   InterpreterContinuation(
       InterpreterState state_,
       Stack stack_,
-      bool grad_mode_enabled_)
-      : state(state_),
-        stack(std::move(stack_)),
-        grad_mode_enabled(grad_mode_enabled_) {}
+      bool grad_mode_enabled_);
 
   void operator()();
 
@@ -97,7 +98,17 @@ struct InterpreterContinuation {
   InterpreterState state;
   Stack stack;
   bool grad_mode_enabled;
+  uint64_t task_flow_id;
 };
 
+// See Note [Cooperative fork scheduling] in interpreter.cpp. Exposed so
+// that the prim::fork implementation in register_prim_ops.cpp can defer
+// forked work to the forking thread's queue instead of at::launch.
+TORCH_API bool cooperativeForkEnabled();
+TORCH_API void queueForkedTask(InterpreterContinuation task);
+// Runs the most recently queued forked task inline on the calling thread.
+// Returns false if the queue was empty.
+TORCH_API bool runQueuedForkedTask();
+
 } // namespace jit
 } // namespace torch
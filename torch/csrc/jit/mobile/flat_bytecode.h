@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+// Layout of the flat bytecode record ("bytecode.flat").
+//
+// The record is written next to bytecode.pkl and carries the same
+// information - instructions, operator names, constants and register sizes
+// per method - in a flat, position-independent layout. Loading it only
+// requires bounds-checked pointer arithmetic over the raw bytes; no
+// unpickling and no intermediate IValue tree. bytecode.pkl remains the
+// source of truth: a loader that does not know this record (or finds an
+// unknown version) falls back to unpickling.
+//
+// All structs below are fixed-size PODs. All offsets are byte offsets from
+// the start of the record and 4-byte aligned; integers are little-endian,
+// matching every platform the mobile interpreter targets. Strings live in a
+// shared pool as a uint32_t byte length followed by the bytes, padded to a
+// 4-byte boundary.
+//
+//   FlatHeader
+//   FlatFunction[num_functions]     (at header.function_table_offset)
+//   per function:
+//     FlatInstruction[num_instructions]
+//     FlatOperator[num_operators]
+//     FlatConstant[num_constants]
+//   string pool
+//
+// Only methods whose constant table consists of None, int, double, bool and
+// string values can be represented; a module with any other constant is
+// written without the flat record.
+
+namespace torch {
+namespace jit {
+namespace mobile {
+
+// "PTBF" in little-endian byte order.
+constexpr uint32_t kFlatBytecodeMagic = 0x46425450;
+constexpr uint32_t kFlatBytecodeVersion = 1;
+
+struct FlatHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t num_functions;
+  uint32_t function_table_offset;
+};
+
+struct FlatFunction {
+  uint32_t name_offset; // qualified name, in the string pool
+  uint32_t register_size;
+  uint32_t instructions_offset;
+  uint32_t num_instructions;
+  uint32_t operators_offset;
+  uint32_t num_operators;
+  uint32_t constants_offset;
+  uint32_t num_constants;
+};
+
+// Bit-identical to Instruction (instruction.h), so the loader can copy the
+// array straight into the interpreter's code object.
+struct FlatInstruction {
+  uint8_t op;
+  uint8_t padding;
+  uint16_t N;
+  int32_t X;
+};
+
+struct FlatOperator {
+  uint32_t name_offset;
+  uint32_t overload_name_offset;
+};
+
+enum class FlatConstantTag : uint32_t {
+  NONE = 0,
+  INT = 1,
+  DOUBLE = 2,
+  BOOL = 3,
+  STRING = 4,
+};
+
+struct FlatConstant {
+  uint32_t tag; // FlatConstantTag
+  uint32_t string_offset; // STRING only, otherwise 0
+  // INT: the value; DOUBLE: the bit pattern; BOOL: 0 or 1; otherwise 0.
+  uint64_t scalar_bits;
+};
+
+} // namespace mobile
+} // namespace jit
+} // namespace torch
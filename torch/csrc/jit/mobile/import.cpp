@@ -4,8 +4,10 @@
 #include <torch/csrc/jit/unpickler.h>
 #include <caffe2/serialize/inline_container.h>
 #include <torch/csrc/jit/instruction.h>
+#include <torch/csrc/jit/mobile/flat_bytecode.h>
 
 
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -102,6 +104,133 @@ void parseMethods(const std::vector<IValue>& vals, std::shared_ptr<mobile::Compi
   }
 }
 
+// Bounds-checked reader for the flat "bytecode.flat" record (layout in
+// mobile/flat_bytecode.h). The record is position-independent, so the
+// methods are built with one pass of pointer arithmetic over the raw bytes -
+// no unpickling and no intermediate IValue tree. parse() returns false on
+// any structural problem (unknown version, offset out of range) so the
+// caller can fall back to unpickling bytecode.pkl. All fields are copied
+// out with memcpy since offsets are only guaranteed 4-byte alignment.
+class FlatBytecodeParser {
+ public:
+  FlatBytecodeParser(const char* data, size_t size)
+      : data_(data), size_(size) {}
+
+  bool parse(const std::shared_ptr<mobile::CompilationUnit>& mcu) {
+    mobile::FlatHeader header;
+    if (!read(0, &header, sizeof(header))) {
+      return false;
+    }
+    if (header.magic != mobile::kFlatBytecodeMagic ||
+        header.version != mobile::kFlatBytecodeVersion) {
+      return false;
+    }
+    for (uint32_t i = 0; i < header.num_functions; ++i) {
+      mobile::FlatFunction f;
+      if (!read(
+              header.function_table_offset + i * sizeof(f), &f, sizeof(f))) {
+        return false;
+      }
+      std::string name;
+      if (!readString(f.name_offset, &name)) {
+        return false;
+      }
+      auto function = std::unique_ptr<mobile::Function>(
+          new mobile::Function(c10::QualifiedName(name)));
+
+      for (uint32_t j = 0; j < f.num_instructions; ++j) {
+        mobile::FlatInstruction ins;
+        if (!read(f.instructions_offset + j * sizeof(ins), &ins, sizeof(ins))) {
+          return false;
+        }
+        function->append_instruction(static_cast<OpCode>(ins.op), ins.X, ins.N);
+      }
+
+      for (uint32_t j = 0; j < f.num_operators; ++j) {
+        mobile::FlatOperator op;
+        if (!read(f.operators_offset + j * sizeof(op), &op, sizeof(op))) {
+          return false;
+        }
+        std::string op_name;
+        std::string overload_name;
+        if (!readString(op.name_offset, &op_name) ||
+            !readString(op.overload_name_offset, &overload_name)) {
+          return false;
+        }
+        function->append_operator(op_name, overload_name);
+      }
+
+      function->build_vararg_operator_table();
+
+      for (uint32_t j = 0; j < f.num_constants; ++j) {
+        mobile::FlatConstant constant;
+        if (!read(
+                f.constants_offset + j * sizeof(constant),
+                &constant,
+                sizeof(constant))) {
+          return false;
+        }
+        switch (static_cast<mobile::FlatConstantTag>(constant.tag)) {
+          case mobile::FlatConstantTag::NONE:
+            function->append_constant(IValue());
+            break;
+          case mobile::FlatConstantTag::INT:
+            function->append_constant(
+                static_cast<int64_t>(constant.scalar_bits));
+            break;
+          case mobile::FlatConstantTag::DOUBLE: {
+            double value;
+            std::memcpy(&value, &constant.scalar_bits, sizeof(value));
+            function->append_constant(value);
+            break;
+          }
+          case mobile::FlatConstantTag::BOOL:
+            function->append_constant(constant.scalar_bits != 0);
+            break;
+          case mobile::FlatConstantTag::STRING: {
+            std::string value;
+            if (!readString(constant.string_offset, &value)) {
+              return false;
+            }
+            function->append_constant(value);
+            break;
+          }
+          default:
+            return false;
+        }
+      }
+
+      function->set_register_size(f.register_size);
+      mcu->register_function(std::move(function));
+    }
+    return true;
+  }
+
+ private:
+  bool read(size_t offset, void* out, size_t size) const {
+    if (offset > size_ || size > size_ - offset) {
+      return false;
+    }
+    std::memcpy(out, data_ + offset, size);
+    return true;
+  }
+
+  bool readString(size_t offset, std::string* out) const {
+    uint32_t len;
+    if (!read(offset, &len, sizeof(len))) {
+      return false;
+    }
+    if (len > size_ - offset - sizeof(len)) {
+      return false;
+    }
+    out->assign(data_ + offset + sizeof(len), len);
+    return true;
+  }
+
+  const char* data_;
+  size_t size_;
+};
+
 // The deserializer class which loads the bytecode package from bc files.
 class BytecodeDeserializer final {
  public:
@@ -121,9 +250,24 @@ BytecodeDeserializer::BytecodeDeserializer(std::unique_ptr<PyTorchStreamReader>
 
 mobile::Module BytecodeDeserializer::deserialize(c10::optional<at::Device> device) {
   device_ = device;
-  auto bvals = readArchive("bytecode").toTuple()->elements();
   auto mcu = std::make_shared<mobile::CompilationUnit>();
-  parseMethods(bvals, mcu);
+  bool parsed = false;
+  if (reader_->hasRecord("bytecode.flat")) {
+    at::DataPtr flat_ptr;
+    size_t flat_size = 0;
+    std::tie(flat_ptr, flat_size) = reader_->getRecord("bytecode.flat");
+    FlatBytecodeParser parser(
+        reinterpret_cast<const char*>(flat_ptr.get()), flat_size);
+    parsed = parser.parse(mcu);
+  }
+  if (!parsed) {
+    // no flat record (older file) or a record this build cannot consume:
+    // unpickle bytecode.pkl as before. Start from a fresh compilation unit
+    // in case a malformed record registered some functions already.
+    mcu = std::make_shared<mobile::CompilationUnit>();
+    auto bvals = readArchive("bytecode").toTuple()->elements();
+    parseMethods(bvals, mcu);
+  }
 
   return mobile::Module(readArchive("data").toObject(), mcu);
 }
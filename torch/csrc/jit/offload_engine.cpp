@@ -0,0 +1,65 @@
+#include <torch/csrc/jit/offload_engine.h>
+
+#include <torch/csrc/jit/operator.h>
+
+#include <atomic>
+
+namespace torch {
+namespace jit {
+
+ParameterOffloadEngine::~ParameterOffloadEngine() = default;
+
+namespace {
+
+std::atomic<ParameterOffloadEngine*> offload_engine{nullptr};
+
+// offload::acquire and offload::release order the copy stream against the
+// compute stream and mutate engine state, so they must not be reordered or
+// dead-code-eliminated; conservative alias analysis keeps them pinned in
+// place.
+c10::OperatorOptions aliasAnalysisConservative() {
+  c10::OperatorOptions result;
+  result.setAliasAnalysis(c10::AliasAnalysisKind::CONSERVATIVE);
+  return result;
+}
+
+RegisterOperators reg(
+    {Operator(
+         "offload::acquire(int slot) -> Tensor",
+         [](Stack& stack) {
+           int64_t slot = pop(stack).toInt();
+           auto* engine = getParameterOffloadEngine();
+           TORCH_CHECK(
+               engine != nullptr,
+               "offload::acquire requires a parameter offload engine, but "
+               "none is registered in this build");
+           push(stack, engine->acquire(slot));
+           return 0;
+         },
+         aliasAnalysisConservative()),
+     Operator(
+         "offload::release(int slot) -> ()",
+         [](Stack& stack) {
+           int64_t slot = pop(stack).toInt();
+           auto* engine = getParameterOffloadEngine();
+           TORCH_CHECK(
+               engine != nullptr,
+               "offload::release requires a parameter offload engine, but "
+               "none is registered in this build");
+           engine->release(slot);
+           return 0;
+         },
+         aliasAnalysisConservative())});
+
+} // namespace
+
+ParameterOffloadEngine* getParameterOffloadEngine() {
+  return offload_engine.load();
+}
+
+void setParameterOffloadEngine(ParameterOffloadEngine* engine) {
+  offload_engine.store(engine);
+}
+
+} // namespace jit
+} // namespace torch
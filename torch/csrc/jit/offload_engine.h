@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ATen/core/Tensor.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstdint>
+
+namespace torch {
+namespace jit {
+
+// Backend interface for parameter offloading (see passes/offload_params.h).
+//
+// The OffloadParameters pass hands eligible weight tensors to the engine,
+// which evicts them to pinned host memory and returns a slot id. At run
+// time the rewritten graph calls offload::acquire(slot) to get the weight
+// back on its original device (waiting on the asynchronous prefetch if it
+// has not landed yet, and kicking off prefetches for the slots that follow
+// it) and offload::release(slot) once the last use has been issued, which
+// returns the device buffer to the caching allocator.
+//
+// The CUDA implementation lives in offload_engine_cuda.cpp and registers
+// itself on static initialization; in CPU-only builds no engine is
+// registered and the pass is a no-op.
+struct TORCH_API ParameterOffloadEngine {
+  virtual ~ParameterOffloadEngine();
+
+  // Moves `param` to pinned host memory and returns the slot that the
+  // rewritten graph will refer to it by. Slots are prefetched in
+  // registration order, so parameters must be registered in the order the
+  // graph uses them.
+  virtual int64_t registerParameter(const at::Tensor& param) = 0;
+
+  // Returns the device-resident copy of the slot's parameter, blocking the
+  // current stream (not the host) until the copy has completed, and starts
+  // prefetching the slots registered after it.
+  virtual at::Tensor acquire(int64_t slot) = 0;
+
+  // Drops the device-resident copy. The pinned host copy is kept so the
+  // slot can be prefetched again on the next run.
+  virtual void release(int64_t slot) = 0;
+};
+
+TORCH_API ParameterOffloadEngine* getParameterOffloadEngine();
+TORCH_API void setParameterOffloadEngine(ParameterOffloadEngine* engine);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,138 @@
+#include <torch/csrc/jit/offload_engine.h>
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/CUDAEvent.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// How many slots past the one being acquired to prefetch. With the default
+// of 2 the copy stream stays one layer ahead of compute even when a layer's
+// kernels finish faster than its successor's H2D copy.
+int64_t offloadLookahead() {
+  static const int64_t lookahead = []() {
+    const char* env = std::getenv("TORCH_JIT_OFFLOAD_LOOKAHEAD");
+    if (env) {
+      return std::max<int64_t>(1, std::atoll(env));
+    }
+    return static_cast<int64_t>(2);
+  }();
+  return lookahead;
+}
+
+struct Slot {
+  // Pinned host copy; owned for the lifetime of the slot.
+  at::Tensor host;
+  // Device copy; defined only between prefetch and release.
+  at::Tensor device;
+  // Recorded on the copy stream when the H2D copy is issued; the compute
+  // stream blocks on it in acquire().
+  at::cuda::CUDAEvent ready;
+  // Device the parameter originally lived on.
+  c10::Device target = c10::Device(c10::DeviceType::CUDA);
+};
+
+struct CudaParameterOffloadEngine : public ParameterOffloadEngine {
+  int64_t registerParameter(const at::Tensor& param) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Slot slot;
+    slot.target = param.device();
+    slot.host = param.to(at::kCPU).pin_memory();
+    slots_.push_back(std::move(slot));
+    return static_cast<int64_t>(slots_.size()) - 1;
+  }
+
+  at::Tensor acquire(int64_t slot) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TORCH_INTERNAL_ASSERT(
+        slot >= 0 && slot < static_cast<int64_t>(slots_.size()));
+    prefetch(slot);
+    Slot& s = slots_[slot];
+    c10::cuda::CUDAGuard device_guard(s.target);
+    auto compute_stream =
+        c10::cuda::getCurrentCUDAStream(s.target.index());
+    s.ready.block(compute_stream);
+    // The buffer was allocated on the copy stream; tell the caching
+    // allocator about the compute stream so it is not handed out again
+    // before the compute stream is done with it.
+    c10::cuda::CUDACachingAllocator::recordStream(
+        s.device.storage().data(), compute_stream);
+    // Keep the pipeline full: start the copies for the slots that the
+    // graph will acquire next while this one's consumers run.
+    for (int64_t k = 1; k <= offloadLookahead(); ++k) {
+      if (slot + k < static_cast<int64_t>(slots_.size())) {
+        prefetch(slot + k);
+      }
+    }
+    return s.device;
+  }
+
+  void release(int64_t slot) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TORCH_INTERNAL_ASSERT(
+        slot >= 0 && slot < static_cast<int64_t>(slots_.size()));
+    // recordStream() in acquire() defers reuse of the buffer until the
+    // compute stream has drained, so dropping the reference here is safe
+    // even though the last kernel reading it may still be in flight.
+    slots_[slot].device.reset();
+  }
+
+ private:
+  // Issues the H2D copy for `slot` on the copy stream if it is not already
+  // device-resident. Caller must hold mutex_.
+  void prefetch(int64_t slot) {
+    Slot& s = slots_[slot];
+    if (s.device.defined()) {
+      return;
+    }
+    c10::cuda::CUDAGuard device_guard(s.target);
+    auto copy_stream = copyStream(s.target.index());
+    c10::cuda::CUDAStreamGuard stream_guard(copy_stream);
+    s.device = at::empty_like(s.host, s.host.options().device(s.target));
+    s.device.copy_(s.host, /*non_blocking=*/true);
+    s.ready.record(copy_stream);
+  }
+
+  // One dedicated pool stream per device so copies overlap with compute on
+  // the default (or user-selected) stream.
+  c10::cuda::CUDAStream copyStream(c10::DeviceIndex device) {
+    auto it = copy_streams_.find(device);
+    if (it == copy_streams_.end()) {
+      it = copy_streams_
+               .emplace(
+                   device,
+                   c10::cuda::getStreamFromPool(
+                       /*isHighPriority=*/false, device))
+               .first;
+    }
+    return it->second;
+  }
+
+  std::mutex mutex_;
+  std::vector<Slot> slots_;
+  std::unordered_map<c10::DeviceIndex, c10::cuda::CUDAStream> copy_streams_;
+};
+
+struct RegisterCudaParameterOffloadEngine {
+  RegisterCudaParameterOffloadEngine() {
+    setParameterOffloadEngine(&engine);
+  }
+  CudaParameterOffloadEngine engine;
+};
+RegisterCudaParameterOffloadEngine reg;
+
+} // namespace
+
+} // namespace jit
+} // namespace torch
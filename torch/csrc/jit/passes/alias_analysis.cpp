@@ -323,6 +323,7 @@ void AliasDb::analyzeImpl(Node* node) {
     case prim::FusedConcat:
     case prim::MMTreeReduce:
     case prim::MMBatchSide:
+    case prim::MMBatchIndependent:
     case prim::BroadcastSizes:
     case prim::ChunkSizes:
     case prim::Function:
@@ -1235,6 +1236,7 @@ bool aliasAnalysisHasSpecialCaseFor(Symbol symbol) {
       prim::GradOf,
       prim::MMTreeReduce,
       prim::MMBatchSide,
+      prim::MMBatchIndependent,
       prim::BroadcastSizes,
       prim::ChunkSizes,
       prim::Function,
@@ -459,6 +459,156 @@ void BatchMMSide(Block* block, AliasDb& alias_db) {
   }
 }
 
+// The tree-reduce and side phases above require the matmuls to share
+// structure: an add-tree over them, or a common lhs/rhs operand. Module-list
+// loops (e.g. mixture-of-experts layers routing through N parallel small
+// linears) produce N fully independent mms -- different lhs AND different
+// rhs -- that both phases miss. Those still batch profitably: stack the lhs
+// operands, stack the rhs operands, run one bmm, and unbind the result.
+//
+// Shapes are rarely known statically here, so the decision is split the same
+// way MMTreeReduce splits it: the pass batches groups of independent mms
+// (grouped by static shape when the type information has it), and the
+// MMBatchIndependent operator checks at runtime that the shapes actually
+// match and are small enough for batching to pay off, falling back to a
+// plain loop of mms otherwise.
+
+bool shape_is_fast_for_bmm(const at::Tensor& lhs, const at::Tensor& rhs) {
+  // Batching pays off for the expert-sized gemms this targets; matrices big
+  // enough to saturate the device on their own gain nothing from bmm and
+  // lose the overlap between them.
+  return lhs.numel() <= 512 * 1024 && rhs.numel() <= 512 * 1024;
+}
+
+RegisterOperators mm_batch_independent_reg({Operator(
+    prim::MMBatchIndependent,
+    [](const Node* node) -> Operation {
+      size_t num_mms = node->inputs().size() / 2;
+      return [num_mms](Stack& stack) {
+        std::vector<at::Tensor> inputs;
+        inputs.reserve(2 * num_mms);
+        for (auto it = stack.end() - 2 * num_mms; it != stack.end(); ++it) {
+          inputs.push_back(std::move(*it).toTensor());
+        }
+        drop(stack, 2 * num_mms);
+
+        auto lhs_inputs = at::TensorList(inputs).slice(0, num_mms);
+        auto rhs_inputs = at::TensorList(inputs).slice(num_mms);
+        bool batchable = have_same_shape(lhs_inputs) &&
+            have_same_shape(rhs_inputs) &&
+            shape_is_fast_for_bmm(lhs_inputs[0], rhs_inputs[0]) &&
+            std::all_of(
+                inputs.begin(), inputs.end(), [&](const at::Tensor& t) {
+                  return t.scalar_type() == inputs[0].scalar_type() &&
+                      t.device() == inputs[0].device();
+                });
+        if (batchable) {
+          auto out =
+              at::bmm(at::stack(lhs_inputs, 0), at::stack(rhs_inputs, 0));
+          auto outputs = at::unbind(out, 0);
+          stack.insert(
+              stack.end(),
+              std::make_move_iterator(outputs.begin()),
+              std::make_move_iterator(outputs.end()));
+        } else {
+          for (size_t i = 0; i < num_mms; ++i) {
+            stack.emplace_back(lhs_inputs[i].mm(rhs_inputs[i]));
+          }
+        }
+        return 0;
+      };
+    },
+    aliasAnalysisIsSpecialCase())});
+
+// Groups mms by their statically known output-producing shapes so a batch is
+// only formed from mms that can plausibly share a bmm. Unknown shapes all
+// land in one group and rely on the runtime check.
+std::string mmShapeGroup(Node* mm) {
+  std::string key;
+  for (Value* input : mm->inputs()) {
+    auto type = input->type()->cast<TensorType>();
+    auto sizes = type ? type->sizes().concrete_sizes()
+                      : c10::optional<std::vector<int64_t>>();
+    if (!sizes) {
+      return "?";
+    }
+    for (int64_t size : *sizes) {
+      key += std::to_string(size);
+      key += 'x';
+    }
+    key += ',';
+  }
+  return key;
+}
+
+void BatchMMIndependent(Block* block, AliasDb& alias_db) {
+  // Same threshold as the side phase: below this the stack/unbind overhead
+  // eats the benefit.
+  static constexpr size_t how_many_is_many = 8;
+
+  std::unordered_map<std::string, std::vector<Node*>> groups;
+  for (Node* node : block->nodes()) {
+    if (node->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
+      // mms already claimed by the tree-reduce or side phases are dead by
+      // now (their uses were rerouted); skip them instead of resurrecting.
+      if (!node->output()->uses().empty()) {
+        groups[mmShapeGroup(node)].push_back(node);
+      }
+    } else {
+      for (Block* subblock : node->blocks()) {
+        BatchMMIndependent(subblock, alias_db);
+      }
+    }
+  }
+
+  for (auto& group : groups) {
+    auto& mms = group.second;
+    // Filter out dependent mms, exactly like gatherIndependentMMUses: block
+    // order is topological, so it suffices to drop any mm that cannot move
+    // before an earlier kept one.
+    for (size_t i = 0; i < mms.size(); ++i) {
+      if (mms[i] == nullptr)
+        continue;
+      for (size_t j = i + 1; j < mms.size(); ++j) {
+        if (mms[j] == nullptr)
+          continue;
+        if (!alias_db.couldMoveBeforeTopologically(mms[j], mms[i])) {
+          mms[j] = nullptr;
+        }
+      }
+    }
+    auto independent_mms =
+        c10::filter(mms, [](Node* n) { return n != nullptr; });
+    if (independent_mms.size() < how_many_is_many) {
+      continue;
+    }
+
+    for (int64_t i = static_cast<int64_t>(independent_mms.size()) - 2; i >= 0;
+         --i) {
+      bool move_ok = alias_db.moveBeforeTopologicallyValid(
+          independent_mms[i], independent_mms[i + 1]);
+      AT_ASSERT(move_ok);
+    }
+    WithInsertPoint insert_guard{independent_mms[0]};
+    Graph* graph = independent_mms[0]->owningGraph();
+    Node* batch_mm = graph->create(
+        prim::MMBatchIndependent,
+        /*inputs=*/{},
+        /*num_outputs=*/independent_mms.size());
+    graph->insertNode(batch_mm);
+    for (Node* mm : independent_mms) {
+      batch_mm->addInput(mm->inputs().at(0));
+    }
+    for (Node* mm : independent_mms) {
+      batch_mm->addInput(mm->inputs().at(1));
+    }
+    for (size_t i = 0; i < independent_mms.size(); ++i) {
+      independent_mms[i]->output()->replaceAllUsesWith(
+          batch_mm->outputs().at(i));
+    }
+  }
+}
+
 bool hasMutableOperators(Block* block) {
   for (auto n : block->nodes()) {
     if (n->kind().is_aten() && n->schema().is_mutable())
@@ -479,6 +629,12 @@ void BatchMM(std::shared_ptr<Graph>& graph) {
   AliasDb alias_db(graph);
   BatchMMTreeReduce(graph->block());
   BatchMMSide(graph->block(), alias_db);
+  {
+    // Runs last so it only sees mms the structured phases left behind; a
+    // fresh AliasDb because the phases above inserted new nodes.
+    AliasDb independent_alias_db(graph);
+    BatchMMIndependent(graph->block(), independent_alias_db);
+  }
   EliminateDeadCode(graph);
   // It's possible that transpose rearrangements have created sequences of
   // consecutive transposes that didn't exist before.
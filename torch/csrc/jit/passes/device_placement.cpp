@@ -0,0 +1,454 @@
+#include <torch/csrc/jit/passes/device_placement.h>
+
+#include <c10/core/Device.h>
+#include <torch/csrc/autograd/record_function.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool devicePlacementEnabled() {
+  static const char* enable_c_str = std::getenv("TORCH_JIT_DEVICE_PLACEMENT");
+  if (!enable_c_str) {
+    return false;
+  }
+  std::string enable = enable_c_str;
+  return enable == "1" || enable == "true" || enable == "TRUE";
+}
+
+c10::DeviceType homeDeviceType() {
+  static const char* home_c_str = std::getenv("TORCH_JIT_PLACEMENT_HOME");
+  if (home_c_str && std::string(home_c_str) == "hip") {
+    return c10::DeviceType::HIP;
+  }
+  return c10::DeviceType::CUDA;
+}
+
+double interconnectGBps() {
+  static const char* gbps_c_str =
+      std::getenv("TORCH_JIT_PLACEMENT_PCIE_GBPS");
+  if (gbps_c_str) {
+    double gbps = std::atof(gbps_c_str);
+    if (gbps > 0) {
+      return gbps;
+    }
+  }
+  return 12.0;
+}
+
+// Fixed per-transfer cost (launch + synchronization overhead) added on top
+// of the bandwidth term, in microseconds.
+constexpr double kTransferLatencyUs = 10.0;
+// Assumed payload when a value's shape or dtype is unknown. Large enough
+// that the partitioner does not cut through edges it knows nothing about.
+constexpr int64_t kUnknownTransferBytes = 4 * 1024 * 1024;
+
+// See normalizeOpName in schedule_critical_path.cpp: record names may or
+// may not carry a namespace, node kinds always do.
+std::string normalizeOpName(const std::string& name) {
+  auto pos = name.rfind("::");
+  if (pos == std::string::npos) {
+    return name;
+  }
+  return name.substr(pos + 2);
+}
+
+struct DeviceOpRuntimeProfile {
+  void record(const std::string& name, c10::DeviceType device, double us) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = totals[key(name, device)];
+    entry.first += us;
+    entry.second += 1;
+  }
+
+  c10::optional<double> mean(const std::string& name, c10::DeviceType device) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = totals.find(key(name, device));
+    if (it == totals.end() || it->second.second == 0) {
+      return c10::nullopt;
+    }
+    return it->second.first / it->second.second;
+  }
+
+ private:
+  static std::string key(const std::string& name, c10::DeviceType device) {
+    return name + "@" + c10::DeviceTypeName(device, /*lower_case=*/true);
+  }
+
+  std::mutex mutex;
+  // (name, device) -> (total runtime in us, sample count)
+  std::unordered_map<std::string, std::pair<double, int64_t>> totals;
+};
+
+DeviceOpRuntimeProfile& deviceOpRuntimeProfile() {
+  static DeviceOpRuntimeProfile profile;
+  return profile;
+}
+
+c10::DeviceType deviceOfInputs(const std::vector<c10::IValue>& inputs) {
+  for (const c10::IValue& input : inputs) {
+    if (input.isTensor()) {
+      const at::Tensor& tensor = input.toTensor();
+      if (tensor.defined()) {
+        return tensor.device().type();
+      }
+    }
+  }
+  return c10::DeviceType::CPU;
+}
+
+// ---------------------------------------------------------------------
+// Min-cut solver. Costs are microseconds scaled to integers; an s-t cut
+// that leaves a node on the source side places it on the CPU, sink side
+// on the home device. Source-to-node capacity is the node's home-device
+// cost (paid when the node ends up on the home side... of the cut's sink
+// partition), node-to-sink its CPU cost, and dataflow edges carry the
+// transfer cost in both directions, so the value of a cut is exactly the
+// modeled runtime of the corresponding placement.
+// ---------------------------------------------------------------------
+
+struct FlowGraph {
+  struct Edge {
+    size_t to;
+    int64_t cap;
+    size_t rev; // index of the reverse edge in adj[to]
+  };
+
+  explicit FlowGraph(size_t n) : adj(n) {}
+
+  void addEdge(size_t from, size_t to, int64_t cap) {
+    if (cap <= 0) {
+      return;
+    }
+    adj[from].push_back(Edge{to, cap, adj[to].size()});
+    adj[to].push_back(Edge{from, 0, adj[from].size() - 1});
+  }
+
+  // Edmonds-Karp; the graphs here are a few hundred nodes, so shortest
+  // augmenting paths are more than fast enough.
+  void maxflow(size_t s, size_t t) {
+    while (true) {
+      std::vector<std::pair<size_t, size_t>> parent(
+          adj.size(), {SIZE_MAX, SIZE_MAX});
+      std::queue<size_t> queue;
+      queue.push(s);
+      parent[s] = {s, 0};
+      while (!queue.empty() && parent[t].first == SIZE_MAX) {
+        size_t u = queue.front();
+        queue.pop();
+        for (size_t i = 0; i < adj[u].size(); ++i) {
+          const Edge& e = adj[u][i];
+          if (e.cap > 0 && parent[e.to].first == SIZE_MAX) {
+            parent[e.to] = {u, i};
+            queue.push(e.to);
+          }
+        }
+      }
+      if (parent[t].first == SIZE_MAX) {
+        return;
+      }
+      int64_t bottleneck = INT64_MAX;
+      for (size_t v = t; v != s;) {
+        auto p = parent[v];
+        bottleneck = std::min(bottleneck, adj[p.first][p.second].cap);
+        v = p.first;
+      }
+      for (size_t v = t; v != s;) {
+        auto p = parent[v];
+        Edge& e = adj[p.first][p.second];
+        e.cap -= bottleneck;
+        adj[e.to][e.rev].cap += bottleneck;
+        v = p.first;
+      }
+    }
+  }
+
+  // After maxflow: nodes reachable from s in the residual graph form the
+  // source (CPU) side of the min cut.
+  std::vector<bool> sourceSide(size_t s) const {
+    std::vector<bool> reachable(adj.size(), false);
+    std::queue<size_t> queue;
+    queue.push(s);
+    reachable[s] = true;
+    while (!queue.empty()) {
+      size_t u = queue.front();
+      queue.pop();
+      for (const Edge& e : adj[u]) {
+        if (e.cap > 0 && !reachable[e.to]) {
+          reachable[e.to] = true;
+          queue.push(e.to);
+        }
+      }
+    }
+    return reachable;
+  }
+
+  std::vector<std::vector<Edge>> adj;
+};
+
+constexpr int64_t kCapInfinity = INT64_C(1) << 50;
+
+int64_t toCap(double us) {
+  // Scale so sub-microsecond costs survive the integer conversion.
+  return std::llround(us * 1024.0);
+}
+
+int64_t transferBytes(Value* value) {
+  auto type = value->type()->cast<TensorType>();
+  if (!type) {
+    return 0; // non-tensor values carry no payload
+  }
+  auto sizes = type->sizes().concrete_sizes();
+  auto dtype = type->scalarType();
+  if (!sizes || !dtype) {
+    return kUnknownTransferBytes;
+  }
+  int64_t numel = 1;
+  for (int64_t size : *sizes) {
+    numel *= size;
+  }
+  return numel * static_cast<int64_t>(c10::elementSize(*dtype));
+}
+
+double transferCostUs(Value* value) {
+  int64_t bytes = transferBytes(value);
+  if (bytes == 0) {
+    return 0;
+  }
+  return kTransferLatencyUs + bytes / (interconnectGBps() * 1000.0);
+}
+
+void partitionAcrossDevicesImpl(const std::shared_ptr<Graph>& graph) {
+  c10::DeviceType home = homeDeviceType();
+  Block* block = graph->block();
+
+  std::vector<Node*> nodes;
+  for (Node* node : block->nodes()) {
+    // Only straight-line, side-effect-free graphs are handled; placement
+    // across control flow or mutation is not reasoned about.
+    if (!node->blocks().empty() || node->hasSideEffects() ||
+        node->kind() == prim::fork || node->kind() == aten::wait ||
+        node->kind() == prim::BailOut || node->kind() == prim::Guard) {
+      return;
+    }
+    nodes.push_back(node);
+  }
+  if (nodes.size() < 2) {
+    return;
+  }
+
+  AliasDb aliasDb(graph);
+  for (Node* node : nodes) {
+    for (Value* input : node->inputs()) {
+      if (aliasDb.hasWriters(input)) {
+        return;
+      }
+    }
+    for (Value* output : node->outputs()) {
+      if (aliasDb.hasWriters(output)) {
+        return;
+      }
+    }
+  }
+
+  // Flow-graph ids: 0 = source (CPU), 1 = sink (home device), one id per
+  // node, one per graph input, one for the return node.
+  const size_t kSource = 0;
+  const size_t kSink = 1;
+  std::unordered_map<Node*, size_t> node_id;
+  size_t next_id = 2;
+  for (Node* node : nodes) {
+    node_id[node] = next_id++;
+  }
+  std::unordered_map<Value*, size_t> input_id;
+  for (Value* input : graph->inputs()) {
+    input_id[input] = next_id++;
+  }
+  size_t return_id = next_id++;
+
+  FlowGraph flow(next_id);
+  bool any_movable = false;
+  for (Node* node : nodes) {
+    size_t id = node_id[node];
+    if (node->kind() == prim::Constant) {
+      // Constants (weights) live on the home device; moving them is the
+      // job of the loader, not this pass.
+      flow.addEdge(id, kSink, kCapInfinity);
+      continue;
+    }
+    auto& profile = deviceOpRuntimeProfile();
+    std::string name = node->kind().toUnqualString();
+    auto cpu_cost = profile.mean(name, c10::DeviceType::CPU);
+    auto home_cost = profile.mean(name, home);
+    if (!cpu_cost || !home_cost) {
+      // Without evidence on both devices the op stays home.
+      flow.addEdge(id, kSink, kCapInfinity);
+      continue;
+    }
+    any_movable = true;
+    flow.addEdge(kSource, id, toCap(*home_cost));
+    flow.addEdge(id, kSink, toCap(*cpu_cost));
+  }
+  if (!any_movable) {
+    return;
+  }
+  // Inputs arrive on, and outputs are expected on, the home device.
+  for (auto& entry : input_id) {
+    flow.addEdge(entry.second, kSink, kCapInfinity);
+  }
+  flow.addEdge(return_id, kSink, kCapInfinity);
+
+  // One edge pair per use: a value consumed on the far side by several
+  // nodes is charged per consumer, which overestimates transfer (the
+  // inserted aten::to is shared) and therefore only makes the partition
+  // more conservative.
+  auto producer_id = [&](Value* value) -> size_t {
+    auto node_it = node_id.find(value->node());
+    if (node_it != node_id.end()) {
+      return node_it->second;
+    }
+    auto input_it = input_id.find(value);
+    AT_ASSERT(input_it != input_id.end());
+    return input_it->second;
+  };
+  auto add_dataflow_edge = [&](Value* value, size_t consumer) {
+    int64_t cap = toCap(transferCostUs(value));
+    flow.addEdge(producer_id(value), consumer, cap);
+    flow.addEdge(consumer, producer_id(value), cap);
+  };
+  for (Node* node : nodes) {
+    for (Value* input : node->inputs()) {
+      add_dataflow_edge(input, node_id[node]);
+    }
+  }
+  for (Value* output : graph->outputs()) {
+    add_dataflow_edge(output, return_id);
+  }
+
+  flow.maxflow(kSource, kSink);
+  std::vector<bool> on_cpu = flow.sourceSide(kSource);
+
+  bool any_cpu = false;
+  for (Node* node : nodes) {
+    any_cpu |= on_cpu[node_id[node]];
+  }
+  if (!any_cpu) {
+    return;
+  }
+
+  // Insert one non-blocking transfer per (value, target device) at the
+  // producer and reroute the far-side uses through it. The copy overlaps
+  // with whatever the producer's side executes next; see the header note
+  // on the cost model.
+  auto insert_transfer = [&](Value* value,
+                             c10::DeviceType target,
+                             const std::vector<Node*>& users) {
+    Node* insert_point = value->node()->kind() == prim::Param
+        ? *block->nodes().begin()
+        : value->node()->next();
+    WithInsertPoint guard(insert_point);
+    Value* moved = graph->insert(
+        aten::to,
+        {value, graph->insertConstant(c10::Device(target))},
+        {NamedValue("non_blocking", true)});
+    for (Node* user : users) {
+      user->replaceInputWith(value, moved);
+    }
+  };
+
+  auto side_of = [&](Node* node) -> bool {
+    auto it = node_id.find(node);
+    if (it != node_id.end()) {
+      return on_cpu[it->second];
+    }
+    return false; // return node and anything unindexed count as home
+  };
+
+  std::vector<Value*> values;
+  for (Value* input : graph->inputs()) {
+    values.push_back(input);
+  }
+  for (Node* node : nodes) {
+    for (Value* output : node->outputs()) {
+      values.push_back(output);
+    }
+  }
+  for (Value* value : values) {
+    if (!value->type()->isSubtypeOf(TensorType::get())) {
+      continue;
+    }
+    bool producer_on_cpu = input_id.count(value)
+        ? false // graph inputs live on the home device
+        : on_cpu[node_id[value->node()]];
+    std::vector<Node*> far_users;
+    for (const Use& use : value->uses()) {
+      if (side_of(use.user) != producer_on_cpu) {
+        far_users.push_back(use.user);
+      }
+    }
+    if (far_users.empty()) {
+      continue;
+    }
+    c10::DeviceType target = producer_on_cpu ? home : c10::DeviceType::CPU;
+    insert_transfer(value, target, far_users);
+  }
+}
+
+} // namespace
+
+void EnableDeviceOpRuntimeRecording() {
+  // Installed once, before any recorded runtime is consumed; see the
+  // matching comment in schedule_critical_path.cpp.
+  static std::once_flag once;
+  std::call_once(once, []() {
+    using Clock = std::chrono::steady_clock;
+    static thread_local std::vector<std::pair<Clock::time_point, c10::DeviceType>>
+        starts;
+    torch::autograd::profiler::pushCallback(
+        [](const torch::autograd::profiler::RecordFunction& fn) {
+          starts.emplace_back(Clock::now(), deviceOfInputs(fn.inputs()));
+        },
+        [](const torch::autograd::profiler::RecordFunction& fn) {
+          if (starts.empty()) {
+            return;
+          }
+          auto start = starts.back();
+          starts.pop_back();
+          double duration_us =
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - start.first)
+                  .count() /
+              1000.0;
+          deviceOpRuntimeProfile().record(
+              normalizeOpName(fn.name().str()), start.second, duration_us);
+        },
+        /*needs_inputs=*/true);
+  });
+}
+
+c10::optional<double> getRecordedDeviceOpRuntime(
+    const std::string& name,
+    c10::DeviceType device) {
+  return deviceOpRuntimeProfile().mean(normalizeOpName(name), device);
+}
+
+void PartitionAcrossDevices(const std::shared_ptr<Graph>& graph) {
+  if (!devicePlacementEnabled()) {
+    return;
+  }
+  EnableDeviceOpRuntimeRecording();
+  partitionAcrossDevicesImpl(graph);
+}
+
+} // namespace jit
+} // namespace torch
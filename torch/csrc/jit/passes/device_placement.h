@@ -0,0 +1,45 @@
+#pragma once
+
+#include <c10/core/DeviceType.h>
+#include <c10/util/Optional.h>
+#include <torch/csrc/jit/ir.h>
+
+#include <string>
+
+namespace torch {
+namespace jit {
+
+// Splits an inference graph between the CPU and its home accelerator when
+// the profile says mixed placement is cheaper than running everything on
+// one device. Per-(op, device) runtimes are recorded during warmup runs
+// (see EnableDeviceOpRuntimeRecording); transfer cost across a dataflow
+// edge is the tensor's size over the configured interconnect bandwidth
+// (TORCH_JIT_PLACEMENT_PCIE_GBPS, default 12) plus a fixed launch latency.
+// The assignment is an exact s-t min cut over node costs and edge transfer
+// costs, so under the cost model it is never worse than staying on the
+// home device. Cut edges get an explicit non-blocking aten::to at the
+// producer, and graph inputs, outputs, constants, and ops without a
+// recorded runtime on both devices stay pinned to the home device
+// (TORCH_JIT_PLACEMENT_HOME, default cuda).
+//
+// The pass is opt-in via TORCH_JIT_DEVICE_PLACEMENT=1 and is a no-op for
+// graphs with control flow, mutation, or side-effecting nodes, and for
+// graphs whose profile never justifies a split.
+TORCH_API void PartitionAcrossDevices(const std::shared_ptr<Graph>& graph);
+
+// Installs the RecordFunction observer that accumulates mean per-op
+// runtimes keyed by the device of the op's first tensor argument.
+// Idempotent; called automatically by PartitionAcrossDevices when the pass
+// is enabled, so warmup runs (on the home device, and on CPU for a CPU
+// copy of the model) feed the profile consumed by later optimization
+// rounds.
+TORCH_API void EnableDeviceOpRuntimeRecording();
+
+// Mean recorded runtime in microseconds for an op name on a device, or
+// nullopt if the op has not been observed there.
+TORCH_API c10::optional<double> getRecordedDeviceOpRuntime(
+    const std::string& name,
+    c10::DeviceType device);
+
+} // namespace jit
+} // namespace torch
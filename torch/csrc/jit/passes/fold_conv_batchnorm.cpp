@@ -0,0 +1,147 @@
+#include <torch/csrc/jit/passes/fold_conv_batchnorm.h>
+
+#include <ATen/ATen.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Returns the constant tensor feeding `v`, or nullopt when `v` is not a
+// constant, is a None constant, or holds an undefined tensor.
+c10::optional<at::Tensor> constantTensor(Value* v) {
+  auto ivalue = toIValue(v);
+  if (!ivalue || !ivalue->isTensor()) {
+    return c10::nullopt;
+  }
+  at::Tensor t = ivalue->toTensor();
+  if (!t.defined()) {
+    return c10::nullopt;
+  }
+  return t;
+}
+
+bool isNoneConstant(Value* v) {
+  auto ivalue = toIValue(v);
+  return ivalue && ivalue->isNone();
+}
+
+// Computes the folded convolution weight and bias. Mirrors
+// computeUpdatedConvWeightAndBias in quantization.cpp (and
+// torch/nn/utils/fusion.py): scale each output channel of the weight by
+// gamma / sqrt(var + eps) and shift the bias accordingly. The per-channel
+// scale broadcasts correctly for grouped convolutions as well.
+std::pair<at::Tensor, at::Tensor> computeFoldedConvWeightAndBias(
+    const at::Tensor& conv_w,
+    const at::Tensor& conv_b,
+    const at::Tensor& bn_rm,
+    const at::Tensor& bn_rv,
+    const at::Tensor& bn_w,
+    const at::Tensor& bn_b,
+    double bn_eps) {
+  at::Tensor bn_var_rsqrt = at::rsqrt(bn_rv + bn_eps);
+  at::Tensor new_w = conv_w * (bn_w * bn_var_rsqrt).reshape({-1, 1, 1, 1});
+  at::Tensor new_b = (conv_b - bn_rm) * bn_var_rsqrt * bn_w + bn_b;
+  return std::make_pair(new_w, new_b);
+}
+
+bool foldConvBatchNormInBlock(Block* block) {
+  bool changed = false;
+
+  // Collect the matches up front; rewriting destroys nodes we would
+  // otherwise be iterating over.
+  std::vector<Node*> batch_norms;
+  for (Node* node : block->nodes()) {
+    for (Block* sub_block : node->blocks()) {
+      changed |= foldConvBatchNormInBlock(sub_block);
+    }
+    if (node->matches(
+            "aten::batch_norm(Tensor input, Tensor? weight, Tensor? bias, Tensor? running_mean, Tensor? running_var, bool training, float momentum, float eps, bool cudnn_enabled) -> Tensor")) {
+      batch_norms.push_back(node);
+    }
+  }
+
+  for (Node* bn : batch_norms) {
+    Node* conv = bn->input(0)->node();
+    if (!conv->matches(
+            "aten::conv2d(Tensor input, Tensor weight, Tensor? bias, int[] stride=1, int[] padding=0, int[] dilation=1, int groups=1) -> Tensor")) {
+      continue;
+    }
+    // Changing the conv weights is only sound when the batch_norm is the
+    // conv's sole consumer, and only inference-mode batch_norm is a pure
+    // per-channel affine transform.
+    if (conv->output()->uses().size() != 1) {
+      continue;
+    }
+    auto training = constant_as<bool>(bn->input(5));
+    if (!training || *training) {
+      continue;
+    }
+    auto bn_eps = constant_as<double>(bn->input(7));
+    auto conv_w = constantTensor(conv->input(1));
+    auto bn_rm = constantTensor(bn->input(3));
+    auto bn_rv = constantTensor(bn->input(4));
+    if (!bn_eps || !conv_w || !bn_rm || !bn_rv) {
+      GRAPH_DEBUG(
+          "Conv2d-BatchNorm pair is not fully constant, skipping: ",
+          *bn);
+      continue;
+    }
+    // The affine parameters and the conv bias are optional; absent ones
+    // act as identity.
+    auto conv_b = constantTensor(conv->input(2));
+    if (!conv_b && !isNoneConstant(conv->input(2))) {
+      continue;
+    }
+    auto bn_w = constantTensor(bn->input(1));
+    if (!bn_w && !isNoneConstant(bn->input(1))) {
+      continue;
+    }
+    auto bn_b = constantTensor(bn->input(2));
+    if (!bn_b && !isNoneConstant(bn->input(2))) {
+      continue;
+    }
+
+    at::Tensor new_w;
+    at::Tensor new_b;
+    std::tie(new_w, new_b) = computeFoldedConvWeightAndBias(
+        *conv_w,
+        conv_b ? *conv_b : at::zeros_like(*bn_rm),
+        *bn_rm,
+        *bn_rv,
+        bn_w ? *bn_w : at::ones_like(*bn_rm),
+        bn_b ? *bn_b : at::zeros_like(*bn_rm),
+        *bn_eps);
+
+    Graph* graph = block->owningGraph();
+    WithInsertPoint insert_guard(conv);
+    conv->replaceInput(1, graph->insertConstant(std::move(new_w)));
+    conv->replaceInput(2, graph->insertConstant(std::move(new_b)));
+    GRAPH_UPDATE(
+        "Folding batch_norm %",
+        bn->output()->debugName(),
+        " into conv2d %",
+        conv->output()->debugName());
+    bn->output()->replaceAllUsesWith(conv->output());
+    bn->destroy();
+    changed = true;
+  }
+
+  return changed;
+}
+
+} // namespace
+
+void FoldFrozenConvBatchNorm(std::shared_ptr<Graph>& graph) {
+  GRAPH_DUMP("Before FoldFrozenConvBatchNorm", graph);
+  if (foldConvBatchNormInBlock(graph->block())) {
+    // Drop the now-unused original weight/statistics constants.
+    EliminateDeadCode(graph);
+  }
+  GRAPH_DUMP("After FoldFrozenConvBatchNorm", graph);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Folds inference-mode batch normalization into the weights of a preceding
+// convolution. The pass matches aten::conv2d nodes whose only use is an
+// aten::batch_norm with training=False, and whose weights, bias, and
+// normalization statistics are all constants (i.e. the graph has been
+// frozen), then rewrites the pair into a single conv2d with adjusted
+// weight/bias constants and removes the batch_norm node. This differs from
+// FoldConvBatchNorm2d in quantization.h, which operates on module
+// attributes before inlining; this pass works directly on a frozen graph.
+TORCH_API void FoldFrozenConvBatchNorm(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
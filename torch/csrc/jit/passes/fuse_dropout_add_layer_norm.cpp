@@ -0,0 +1,46 @@
+#include <torch/csrc/jit/passes/fuse_dropout_add_layer_norm.h>
+#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+
+namespace torch {
+namespace jit {
+
+void FuseDropoutAddLayerNorm(std::shared_ptr<Graph>& graph) {
+  std::string dropout_add_pattern = R"IR(
+    graph(%input, %residual, %shape, %weight, %bias, %eps, %p, %train, %alpha, %cudnn):
+        %dropped = aten::dropout(%input, %p, %train)
+        %added = aten::add(%dropped, %residual, %alpha)
+        %res = aten::layer_norm(%added, %shape, %weight, %bias, %eps, %cudnn)
+        return (%res))IR";
+  std::string add_dropout_pattern = R"IR(
+    graph(%input, %residual, %shape, %weight, %bias, %eps, %p, %train, %alpha, %cudnn):
+        %dropped = aten::dropout(%input, %p, %train)
+        %added = aten::add(%residual, %dropped, %alpha)
+        %res = aten::layer_norm(%added, %shape, %weight, %bias, %eps, %cudnn)
+        return (%res))IR";
+  std::string fused_pattern = R"IR(
+    graph(%input, %residual, %shape, %weight, %bias, %eps, %p, %train, %alpha, %cudnn):
+        %res = aten::fused_dropout_add_layer_norm(%input, %residual, %shape, %weight, %bias, %eps, %p, %train)
+        return (%res))IR";
+
+  // The fused op has no alpha argument, so only rewrite adds with alpha == 1.
+  auto alpha_is_one = [](const Match& match,
+                         const std::unordered_map<std::string, Value*>& vmap) {
+    const auto& match_vmap = match.values_map;
+    auto alpha = toIValue(match_vmap.at(vmap.at("alpha")));
+    return alpha && alpha->isInt() && alpha->toInt() == 1;
+  };
+
+  // replace dropout + add + layer_norm with the fused op
+  SubgraphRewriter dropout_add_to_fused;
+  dropout_add_to_fused.RegisterRewritePattern(
+      dropout_add_pattern, fused_pattern);
+  dropout_add_to_fused.runOnGraph(graph, alpha_is_one);
+
+  // same, with the residual on the left of the add
+  SubgraphRewriter add_dropout_to_fused;
+  add_dropout_to_fused.RegisterRewritePattern(
+      add_dropout_pattern, fused_pattern);
+  add_dropout_to_fused.runOnGraph(graph, alpha_is_one);
+}
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,19 @@
+/** \brief Fuse the dropout + residual-add + layer_norm tail of transformer
+ * blocks into a single aten::fused_dropout_add_layer_norm call.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Match dropout followed by a residual add followed by layer_norm
+ * and rewrite it onto aten::fused_dropout_add_layer_norm, which runs the
+ * whole sequence in one kernel instead of materializing the dropout output
+ * and the residual sum as separate tensors. Only adds with alpha == 1 are
+ * rewritten.
+ */
+TORCH_API void FuseDropoutAddLayerNorm(std::shared_ptr<Graph>& graph);
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,29 @@
+#include <torch/csrc/jit/passes/fuse_linear_activation.h>
+#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+
+namespace torch {
+namespace jit {
+
+void FuseLinearActivation(std::shared_ptr<Graph>& graph) {
+  for (const auto& activation : {"relu", "sigmoid", "gelu"}) {
+    std::string linear_activation_pattern = std::string(R"IR(
+    graph(%input, %weight, %bias):
+        %linear_out = aten::linear(%input, %weight, %bias)
+        %res = aten::)IR") +
+        activation + R"IR((%linear_out)
+        return (%res))IR";
+    std::string fused_linear_activation = std::string(R"IR(
+    graph(%input, %weight, %bias):
+        %activation : str = prim::Constant[value=")IR") +
+        activation + R"IR("]()
+        %res = aten::_fused_linear(%input, %weight, %bias, %activation)
+        return (%res))IR";
+
+    SubgraphRewriter rewriter;
+    rewriter.RegisterRewritePattern(
+        linear_activation_pattern, fused_linear_activation);
+    rewriter.runOnGraph(graph);
+  }
+}
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,19 @@
+/** \brief Fuse aten::linear followed by an elementwise activation into a
+ * single aten::_fused_linear call with an activation epilogue.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Match aten::linear followed by relu/sigmoid/gelu and rewrite the
+ * pair onto aten::_fused_linear, which applies the activation in place on
+ * the GEMM output instead of materializing a separate activation tensor.
+ * Run FuseLinear first so that addmm/matmul+add forms are already folded
+ * into aten::linear.
+ */
+TORCH_API void FuseLinearActivation(std::shared_ptr<Graph>& graph);
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,295 @@
+#include <torch/csrc/jit/passes/loop_invariant_code_motion.h>
+
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/ir_views.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/common_subexpression_elimination.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Peeling duplicates the loop body, so only loops with reasonably small
+// bodies are peeled (the same limit loop unrolling uses).
+static constexpr int64_t kMaxPeelBodySize = 32;
+// Hoisting out of one loop can make nodes in an enclosing loop invariant,
+// and peeled loops contain fresh copies of their bodies, so the pass
+// iterates to a fixed point. The bound only matters for pathological
+// graphs; real graphs converge in one or two rounds.
+static constexpr int64_t kMaxRounds = 8;
+
+// Counts the size of this block, stopping and returning once reaches limit
+// instructions.
+int64_t limitedBlockSize(Block* body, int64_t limit) {
+  auto it = body->nodes().begin();
+  auto end = body->nodes().end();
+  for (int64_t i = 0; i < limit; ++i, ++it) {
+    for (Block* subblock : it->blocks()) {
+      i += limitedBlockSize(subblock, limit - i);
+    }
+    if (it == end) {
+      return i;
+    }
+  }
+  return limit;
+}
+
+bool isSmallBlock(Block* body) {
+  return limitedBlockSize(body, kMaxPeelBodySize + 1) <= kMaxPeelBodySize;
+}
+
+// True if the loop is statically known to run its body at least once, in
+// which case invariants can be hoisted directly above it.
+bool guaranteedFirstIteration(Node* loop) {
+  LoopView view(loop);
+  c10::optional<int64_t> trip_count = constant_as<int64_t>(view.maxTripCount());
+  c10::optional<bool> start_cond = constant_as<bool>(view.inputCond());
+  return trip_count && *trip_count >= 1 && start_cond && *start_cond;
+}
+
+// True for ops that only read tensor metadata (sizes, strides, dtype,
+// device). Their results depend on the tensor's shape and properties, not
+// its contents, so a write to the tensor outside the loop does not make
+// them variant - only a write inside the loop body can. Overloads taking a
+// Dimname are excluded; only the int-indexed forms are known here.
+bool isMetadataQuery(Node* node) {
+  switch (node->kind()) {
+    case aten::size:
+    case aten::stride:
+    case aten::dim:
+    case aten::numel:
+    case aten::is_contiguous:
+    case prim::dtype:
+    case prim::device:
+    case prim::shape:
+      break;
+    default:
+      return false;
+  }
+  if (node->inputs().empty() ||
+      !node->input(0)->type()->isSubtypeOf(TensorType::get())) {
+    return false;
+  }
+  for (size_t i = 1; i < node->inputs().size(); ++i) {
+    if (!node->input(i)->type()->isSubtypeOf(IntType::get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Collects the top-level body nodes that compute the same values on every
+// iteration: side-effect free nodes without sub-blocks whose inputs are all
+// defined outside the loop (or by other invariant nodes), and whose inputs
+// and outputs provably have no writers. Metadata queries are held to a
+// weaker standard: the queried tensor may have writers elsewhere in the
+// graph as long as nothing inside the loop writes to it (getWrites on the
+// loop node covers nested blocks). Constants are skipped - pulling them out
+// is ConstantPooling's job.
+std::vector<Node*> invariantNodes(Node* loop, const AliasDb& aliasDb) {
+  Block* body = loop->blocks().at(0);
+  std::unordered_set<Value*> variant(
+      body->inputs().begin(), body->inputs().end());
+  std::vector<Node*> result;
+  for (Node* node : body->nodes()) {
+    bool invariant = !node->blocks().size() && !node->outputs().empty() &&
+        node->kind() != prim::Constant && !node->hasSideEffects();
+    if (invariant) {
+      if (isMetadataQuery(node)) {
+        invariant = !aliasDb.writesToAlias(loop, {node->input(0)});
+        // A size() list that is itself appended to inside the loop must
+        // stay a per-iteration fresh list.
+        for (Value* output : node->outputs()) {
+          invariant &= !aliasDb.hasWriters(output);
+        }
+      } else {
+        invariant = !aliasDb.hasWriters(node);
+      }
+    }
+    if (invariant) {
+      for (Value* input : node->inputs()) {
+        invariant &= !variant.count(input);
+      }
+    }
+    if (invariant) {
+      result.push_back(node);
+    } else {
+      for (Value* output : node->outputs()) {
+        variant.insert(output);
+      }
+    }
+  }
+  return result;
+}
+
+// Inserts a copy of body at the current insert point, passing inputs to the
+// inputs of the block. Returns the Values standing for the block's outputs.
+std::vector<Value*> insertBlockCopy(
+    Graph& graph,
+    Block* body,
+    at::ArrayRef<Value*> inputs) {
+  TORCH_INTERNAL_ASSERT(inputs.size() == body->inputs().size());
+  std::unordered_map<Value*, Value*> value_map;
+  auto get_value = [&](Value* v) {
+    auto it = value_map.find(v);
+    if (it != value_map.end())
+      return it->second;
+    return v;
+  };
+  auto inputs_it = inputs.begin();
+  for (Value* input : body->inputs()) {
+    value_map[input] = *inputs_it++;
+  }
+  for (Node* node : body->nodes()) {
+    Node* new_node = graph.insertNode(graph.createClone(node, get_value));
+    auto outputs_it = new_node->outputs().begin();
+    for (Value* output : node->outputs()) {
+      value_map[output] = *outputs_it++;
+    }
+  }
+  return fmap(body->outputs(), get_value);
+}
+
+// Replaces
+//   %y... = prim::Loop(%max, %cond, %x...)
+// with
+//   %run = aten::__and__(%cond, aten::gt(%max, 0))
+//   %y... = prim::If(%run)
+//     block0():
+//       <copy of the body with trip count 0 and the carried inputs>
+//       %r... = prim::Loop(aten::sub(%max, 1), %cond', %x'...)
+//       -> (%r...)
+//     block1():
+//       -> (%x...)
+// and returns the residual loop. Nodes hoisted out of the residual loop end
+// up in block0, where the body copy has already run once, so they never
+// execute (or throw) unless the original loop body would have. The residual
+// body's trip counter is offset by one to keep its original values.
+Node* peelFirstIteration(Node* loop) {
+  Graph* graph = loop->owningGraph();
+  LoopView view(loop);
+  Block* body = view.bodyBlock();
+  WithInsertPoint insert_point_guard(loop);
+
+  Value* zero = graph->insertConstant(0);
+  Value* non_empty = graph->insert(aten::gt, {view.maxTripCount(), zero});
+  Value* run_once = graph->insert(aten::__and__, {view.inputCond(), non_empty});
+
+  Node* if_node = graph->insertNode(graph->create(prim::If, 0));
+  if_node->addInput(run_once);
+  Block* taken = if_node->addBlock();
+  Block* skipped = if_node->addBlock();
+
+  Node* residual;
+  {
+    WithInsertPoint taken_guard(taken);
+    std::vector<Value*> body_inputs = {zero};
+    for (Value* carried : view.carriedInputs()) {
+      body_inputs.push_back(carried);
+    }
+    std::vector<Value*> first_iter = insertBlockCopy(*graph, body, body_inputs);
+
+    Value* remaining = graph->insert(aten::sub, {view.maxTripCount(), 1});
+    residual = graph->insertNode(
+        graph->createClone(loop, [](Value* v) { return v; }));
+    residual->replaceInput(0, remaining);
+    residual->replaceInput(1, first_iter.at(0));
+    for (size_t i = 0; i < view.carriedInputs().size(); ++i) {
+      residual->replaceInput(i + 2, first_iter.at(i + 1));
+    }
+
+    // The residual loop's counter still starts at zero; offset its uses so
+    // they see the original iteration number.
+    Block* residual_body = residual->blocks().at(0);
+    Value* counter = residual_body->inputs().at(0);
+    if (counter->hasUses()) {
+      WithInsertPoint body_guard(*residual_body->nodes().begin());
+      Value* offset = graph->insert(aten::add, {counter, 1});
+      counter->replaceAllUsesWith(offset);
+      // replaceAllUsesWith also rewrote the add itself; point it back.
+      offset->node()->replaceInput(0, counter);
+    }
+
+    for (Value* output : residual->outputs()) {
+      taken->registerOutput(output);
+    }
+  }
+  for (Value* carried : view.carriedInputs()) {
+    skipped->registerOutput(carried);
+  }
+  for (Value* output : loop->outputs()) {
+    if_node->addOutput()->copyMetadata(output);
+  }
+  for (size_t i = 0; i < loop->outputs().size(); ++i) {
+    loop->outputs().at(i)->replaceAllUsesWith(if_node->outputs().at(i));
+  }
+  loop->destroy();
+  return residual;
+}
+
+bool hoistFromLoop(Node* loop, std::shared_ptr<Graph>& graph) {
+  {
+    AliasDb aliasDb(graph);
+    std::vector<Node*> invariants = invariantNodes(loop, aliasDb);
+    if (invariants.empty()) {
+      return false;
+    }
+    if (guaranteedFirstIteration(loop)) {
+      for (Node* node : invariants) {
+        node->moveBefore(loop);
+      }
+      return true;
+    }
+  }
+  if (!isSmallBlock(loop->blocks().at(0))) {
+    return false;
+  }
+  Node* residual = peelFirstIteration(loop);
+  // The residual loop and its body are fresh clones; re-analyze before
+  // moving anything.
+  AliasDb residualDb(graph);
+  for (Node* node : invariantNodes(residual, residualDb)) {
+    node->moveBefore(residual);
+  }
+  return true;
+}
+
+// Post-order over loops: peeling a loop destroys the loops nested inside
+// it, so those must already have been visited by the time it happens.
+void collectLoops(Block* block, std::vector<Node*>& loops) {
+  for (Node* node : block->nodes()) {
+    for (Block* subblock : node->blocks()) {
+      collectLoops(subblock, loops);
+    }
+    if (node->kind() == prim::Loop) {
+      loops.push_back(node);
+    }
+  }
+}
+
+} // anonymous namespace
+
+void HoistLoopInvariants(std::shared_ptr<Graph>& graph) {
+  bool changed = true;
+  for (int64_t round = 0; changed && round < kMaxRounds; ++round) {
+    changed = false;
+    std::vector<Node*> loops;
+    collectLoops(graph->block(), loops);
+    for (Node* loop : loops) {
+      changed |= hoistFromLoop(loop, graph);
+    }
+  }
+  // Peeled first iterations contain copies of the hoisted expressions;
+  // clean those (and the guard arithmetic on constant trip counts) up.
+  EliminateCommonSubexpression(graph);
+  EliminateDeadCode(graph);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Moves loop-invariant computations out of prim::Loop bodies. A body node
+// is invariant when it is side-effect free, all of its inputs are defined
+// outside the loop (or by other invariant nodes), and alias analysis can
+// prove that nothing writes to its inputs or outputs. Pure metadata
+// queries (aten::size, aten::stride, prim::dtype and friends) only need
+// the queried tensor to be unwritten inside the loop body, since their
+// results do not depend on the tensor's contents. Loops that are
+// guaranteed to run at least once have their invariant nodes hoisted
+// directly above the loop; for the general case the first iteration is
+// peeled into a guard (so hoisted nodes only execute when the original
+// loop body would have), and the invariants are hoisted out of the
+// residual loop. This keeps e.g. weight transposes and shape computations
+// inside scripted decoding loops from being recomputed every iteration.
+TORCH_API void HoistLoopInvariants(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
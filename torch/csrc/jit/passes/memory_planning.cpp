@@ -0,0 +1,287 @@
+#include <torch/csrc/jit/passes/memory_planning.h>
+
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/liveness.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool memoryPlanningEnabled() {
+  static const char* enable_c_str = std::getenv("TORCH_JIT_MEMORY_PLANNING");
+  if (!enable_c_str) {
+    return false;
+  }
+  std::string enable = enable_c_str;
+  return enable == "1" || enable == "true" || enable == "TRUE";
+}
+
+// Operators that have an out= overload taking the same leading arguments.
+// Only these producers can be redirected into arena views.
+bool hasOutVariant(Node* node) {
+  switch (node->kind()) {
+    case aten::add:
+    case aten::sub:
+    case aten::mul:
+    case aten::div:
+    case aten::mm:
+    case aten::bmm:
+    case aten::tanh:
+    case aten::sigmoid:
+    case aten::exp:
+    case aten::log:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// A planned intermediate: the producing node, its (complete) type, and
+// the node-index interval during which its storage must stay reserved.
+struct PlannedValue {
+  Value* value;
+  Node* node;
+  int64_t numel; // rounded up to the alignment quantum
+  size_t first_node;
+  size_t last_node;
+  int64_t offset = -1; // assigned arena offset, in elements
+};
+
+// Keep distinct tensors cache-line aligned within the arena.
+constexpr int64_t kArenaAlignElements = 16;
+
+int64_t alignedNumel(int64_t numel) {
+  return (numel + kArenaAlignElements - 1) / kArenaAlignElements *
+      kArenaAlignElements;
+}
+
+bool isContiguousType(const TensorTypePtr& type) {
+  auto sizes = type->sizes().concrete_sizes();
+  auto strides = type->strides().concrete_sizes();
+  if (!sizes || !strides) {
+    return false;
+  }
+  int64_t expected = 1;
+  for (int64_t i = static_cast<int64_t>(sizes->size()) - 1; i >= 0; --i) {
+    if ((*strides)[i] != expected) {
+      return false;
+    }
+    expected *= (*sizes)[i];
+  }
+  return true;
+}
+
+// Greedy first-fit assignment: place larger tensors first, each at the
+// lowest offset that does not overlap an already-placed tensor with an
+// overlapping lifetime. Returns the arena size in elements.
+int64_t assignOffsets(std::vector<PlannedValue*>& group) {
+  std::sort(group.begin(), group.end(), [](PlannedValue* a, PlannedValue* b) {
+    return a->numel > b->numel;
+  });
+  int64_t arena_size = 0;
+  std::vector<PlannedValue*> placed;
+  for (PlannedValue* pv : group) {
+    // gather live conflicts, ordered by offset
+    std::vector<PlannedValue*> conflicts;
+    for (PlannedValue* other : placed) {
+      if (other->first_node <= pv->last_node &&
+          pv->first_node <= other->last_node) {
+        conflicts.push_back(other);
+      }
+    }
+    std::sort(
+        conflicts.begin(), conflicts.end(), [](PlannedValue* a, PlannedValue* b) {
+          return a->offset < b->offset;
+        });
+    int64_t offset = 0;
+    for (PlannedValue* other : conflicts) {
+      if (offset + pv->numel <= other->offset) {
+        break;
+      }
+      offset = std::max(offset, other->offset + other->numel);
+    }
+    pv->offset = offset;
+    arena_size = std::max(arena_size, offset + pv->numel);
+    placed.push_back(pv);
+  }
+  return arena_size;
+}
+
+void planMemoryImpl(const std::shared_ptr<Graph>& graph) {
+  // restricted to straight-line graphs: values crossing block boundaries
+  // would need region-level lifetimes and the payoff case (traced
+  // fixed-shape inference models) is straight-line anyway
+  for (Node* node : graph->block()->nodes()) {
+    if (!node->blocks().empty()) {
+      return;
+    }
+  }
+
+  // node-index order for lifetime intervals
+  std::unordered_map<Node*, size_t> node_index;
+  std::vector<Node*> order;
+  for (Node* node : graph->block()->nodes()) {
+    node_index[node] = order.size();
+    order.push_back(node);
+  }
+
+  AliasDb alias_db(graph);
+  auto liveness = BuildLivenessSets(graph);
+
+  std::vector<PlannedValue> candidates;
+  for (Node* node : graph->block()->nodes()) {
+    if (!hasOutVariant(node) || node->outputs().size() != 1) {
+      continue;
+    }
+    Value* v = node->output();
+    auto type = v->type()->cast<TensorType>();
+    if (!type || !type->isComplete() || !isContiguousType(type)) {
+      continue;
+    }
+    if (!type->device() || !type->device()->is_cpu()) {
+      continue;
+    }
+    if (!type->requiresGrad().has_value() || *type->requiresGrad()) {
+      continue;
+    }
+    auto numel = type->numel();
+    if (!numel || *numel == 0) {
+      continue;
+    }
+    // graph outputs escape the forward; don't hand out arena views that
+    // would pin the whole arena (or be clobbered by the next forward)
+    bool escapes = false;
+    for (Value* output : graph->outputs()) {
+      if (v == output || alias_db.mayContainAlias(v, output)) {
+        escapes = true;
+        break;
+      }
+    }
+    if (escapes) {
+      continue;
+    }
+    // reject values that are written through or re-aliased by a consumer
+    // (views, in-place ops): their memory may be observed outside the
+    // liveness interval computed from direct uses
+    if (alias_db.hasWriters(v)) {
+      continue;
+    }
+    bool aliased_by_use = false;
+    for (const Use& use : v->uses()) {
+      for (Value* use_output : use.user->outputs()) {
+        if (alias_db.mayAlias(use_output, v)) {
+          aliased_by_use = true;
+          break;
+        }
+      }
+      if (aliased_by_use) {
+        break;
+      }
+    }
+    if (aliased_by_use) {
+      continue;
+    }
+
+    PlannedValue pv;
+    pv.value = v;
+    pv.node = node;
+    pv.numel = alignedNumel(static_cast<int64_t>(*numel));
+    pv.first_node = node_index.at(node);
+    pv.last_node = pv.first_node;
+    for (const Use& use : v->uses()) {
+      auto it = node_index.find(use.user);
+      if (it == node_index.end()) {
+        // used by the return node; treat as escaping
+        pv.last_node = order.size();
+      } else {
+        pv.last_node = std::max(pv.last_node, it->second);
+      }
+    }
+    // widen with the liveness sets so the interval covers every program
+    // point where the value is still live
+    for (size_t i = 0; i < order.size(); ++i) {
+      const auto& live = liveness[order[i]];
+      if (std::find(live.begin(), live.end(), v) != live.end()) {
+        pv.first_node = std::min(pv.first_node, i);
+        pv.last_node = std::max(pv.last_node, i);
+      }
+    }
+    if (pv.last_node >= order.size()) {
+      continue;
+    }
+    candidates.push_back(pv);
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  // one arena per (scalar type, device is always CPU here); views cannot
+  // reinterpret dtypes in the graph, so dtypes cannot share an arena
+  std::unordered_map<int, std::vector<PlannedValue*>> groups;
+  for (PlannedValue& pv : candidates) {
+    auto type = pv.value->type()->expect<TensorType>();
+    groups[static_cast<int>(*type->scalarType())].push_back(&pv);
+  }
+
+  for (auto& entry : groups) {
+    const auto scalar_type = static_cast<at::ScalarType>(entry.first);
+    const int64_t arena_size = assignOffsets(entry.second);
+
+    // allocate the arena once at the top of the graph
+    Value* arena;
+    {
+      WithInsertPoint guard(*graph->block()->nodes().begin());
+      arena = graph->insert(
+          aten::empty,
+          {std::vector<int64_t>{arena_size}},
+          {NamedValue("dtype", static_cast<int64_t>(scalar_type)),
+           NamedValue("device", c10::Device(at::kCPU))});
+    }
+
+    for (PlannedValue* pv : entry.second) {
+      Node* node = pv->node;
+      Value* v = pv->value;
+      auto type = v->type()->expect<TensorType>();
+      auto sizes = *type->sizes().concrete_sizes();
+
+      WithInsertPoint guard(node);
+      Value* slice = graph->insert(
+          aten::slice,
+          {arena,
+           static_cast<int64_t>(0),
+           pv->offset,
+           pv->offset + static_cast<int64_t>(*type->numel()),
+           static_cast<int64_t>(1)});
+      Value* out_buffer = graph->insert(aten::view, {slice, sizes});
+
+      std::vector<NamedValue> args;
+      for (Value* input : node->inputs()) {
+        args.emplace_back(input);
+      }
+      Value* planned = graph->insert(
+          node->kind(), args, {NamedValue("out", out_buffer)});
+      planned->setType(v->type());
+      v->replaceAllUsesWith(planned);
+      node->destroy();
+    }
+  }
+}
+
+} // namespace
+
+void PlanMemory(const std::shared_ptr<Graph>& graph) {
+  if (!memoryPlanningEnabled()) {
+    return;
+  }
+  planMemoryImpl(graph);
+}
+
+} // namespace jit
+} // namespace torch
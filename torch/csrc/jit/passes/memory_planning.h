@@ -0,0 +1,21 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Packs the intermediates of a fixed-shape inference graph into a single
+// preallocated arena. For graphs where shape propagation produced complete
+// tensor types, tensor lifetimes are computed from liveness and
+// non-overlapping intermediates are assigned offsets in one arena tensor
+// allocated at the top of the graph; their producers are rewritten to the
+// corresponding out= overloads writing into views of the arena. This
+// eliminates per-forward allocator traffic in steady-state inference.
+//
+// The pass is opt-in via TORCH_JIT_MEMORY_PLANNING=1 and is a no-op for
+// graphs with control flow, incomplete shapes, or gradient requirements.
+TORCH_API void PlanMemory(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,303 @@
+#include <torch/csrc/jit/passes/mkldnn_prepack.h>
+
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+
+#include <ATen/ATen.h>
+
+#include <algorithm>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// A weight (or bias) input that was traced back through a prim::GetAttr
+// chain to a tensor attribute of some submodule.
+struct AttrTensor {
+  script::Module owner;
+  Value* owner_value;
+  std::string name;
+  at::Tensor tensor;
+};
+
+bool graphMutatesAttributes(Block* block) {
+  for (Node* node : block->nodes()) {
+    if (node->kind() == prim::SetAttr) {
+      return true;
+    }
+    for (Block* sub : node->blocks()) {
+      if (graphMutatesAttributes(sub)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Resolves a value to the submodule it holds, following GetAttr chains
+// rooted at the graph's self input.
+c10::optional<script::Module> resolveModule(
+    Value* value,
+    script::Module& root,
+    Value* self_value) {
+  if (value == self_value) {
+    return root;
+  }
+  Node* node = value->node();
+  if (node->kind() != prim::GetAttr) {
+    return c10::nullopt;
+  }
+  auto base = resolveModule(node->input(0), root, self_value);
+  if (!base) {
+    return c10::nullopt;
+  }
+  const auto& name = node->s(attr::name);
+  if (!base->hasattr(name)) {
+    return c10::nullopt;
+  }
+  auto attr = base->attr(name);
+  if (!attr.isModule()) {
+    return c10::nullopt;
+  }
+  return attr.toModule();
+}
+
+// Resolves a value to a dense float CPU tensor attribute, e.g. the weight of
+// a conv2d/linear node that the module holds as a parameter or buffer.
+c10::optional<AttrTensor> resolveAttrTensor(
+    Value* value,
+    script::Module& root,
+    Value* self_value) {
+  Node* node = value->node();
+  if (node->kind() != prim::GetAttr) {
+    return c10::nullopt;
+  }
+  auto owner = resolveModule(node->input(0), root, self_value);
+  if (!owner) {
+    return c10::nullopt;
+  }
+  const auto& name = node->s(attr::name);
+  if (!owner->hasattr(name) || !owner->attr(name).isTensor()) {
+    return c10::nullopt;
+  }
+  // .data() detaches from autograd, like the quantization folding passes
+  auto tensor = owner->attr(name).toTensor().data();
+  if (!tensor.defined() || tensor.is_mkldnn() ||
+      tensor.layout() != c10::kStrided || !tensor.device().is_cpu() ||
+      tensor.scalar_type() != at::kFloat) {
+    return c10::nullopt;
+  }
+  return AttrTensor{*owner, node->input(0), name, tensor};
+}
+
+// Registers `packed` as a fresh buffer named after `base_name` on `owner`
+// and returns a GetAttr for it, inserted before `node`.
+Value* insertPackedBuffer(
+    Node* node,
+    script::Module& owner,
+    Value* owner_value,
+    const std::string& base_name,
+    const at::Tensor& packed) {
+  auto name = "_mkldnn_" + base_name;
+  size_t suffix = 0;
+  while (owner.hasattr(name)) {
+    name = "_mkldnn_" + base_name + "_" + std::to_string(suffix++);
+  }
+  owner.register_buffer(name, packed);
+  Node* get_attr = node->owningGraph()
+                       ->createGetAttr(owner_value, name)
+                       ->insertBefore(node);
+  return get_attr->output();
+}
+
+c10::optional<std::vector<int64_t>> constantIntList(Value* value) {
+  auto ivalue = toIValue(value);
+  if (ivalue && ivalue->isIntList()) {
+    return ivalue->toIntListRef().vec();
+  }
+  // traced graphs build these arguments with ListConstruct of constant ints
+  if (value->node()->kind() == prim::ListConstruct) {
+    std::vector<int64_t> result;
+    for (Value* element : value->node()->inputs()) {
+      auto element_ivalue = toIValue(element);
+      if (!element_ivalue || !element_ivalue->isInt()) {
+        return c10::nullopt;
+      }
+      result.push_back(element_ivalue->toInt());
+    }
+    return result;
+  }
+  return c10::nullopt;
+}
+
+bool isNoneConstant(Value* value) {
+  auto ivalue = toIValue(value);
+  return ivalue && ivalue->isNone();
+}
+
+// conv2d(x, w, b, stride, padding, dilation, groups) with a constant dense
+// weight: reorder the weight into blocked layout once with
+// mkldnn_reorder_conv2d_weight. For groups == 1 the node is left in dense
+// input form (the mkldnn backend is picked by ConvParams::use_mkldnn and
+// skips the weight reorder); grouped convolutions get the activation
+// bracketed with to_mkldnn/to_dense since their re-ordered 5-d weight is
+// only accepted on the mkldnn input path.
+void prepackConv2d(Node* node, script::Module& module, Value* self_value) {
+  auto weight = resolveAttrTensor(node->input(1), module, self_value);
+  if (!weight || weight->tensor.dim() != 4) {
+    return;
+  }
+  auto stride = constantIntList(node->input(3));
+  auto padding = constantIntList(node->input(4));
+  auto dilation = constantIntList(node->input(5));
+  auto groups = toIValue(node->input(6));
+  if (!stride || !padding || !dilation || !groups || !groups->isInt()) {
+    return;
+  }
+  const bool dilated = std::any_of(
+      dilation->begin(), dilation->end(), [](int64_t d) { return d != 1; });
+  if (dilated) {
+    // ConvParams::use_mkldnn rejects dilated convolutions on dense inputs
+    return;
+  }
+  auto bias = resolveAttrTensor(node->input(2), module, self_value);
+  if (!bias && !isNoneConstant(node->input(2))) {
+    return;
+  }
+
+  auto packed_weight = at::mkldnn_reorder_conv2d_weight(
+      weight->tensor.to_mkldnn(),
+      *padding,
+      *stride,
+      *dilation,
+      groups->toInt());
+  node->replaceInput(
+      1,
+      insertPackedBuffer(
+          node, weight->owner, weight->owner_value, weight->name, packed_weight));
+  if (bias) {
+    node->replaceInput(
+        2,
+        insertPackedBuffer(
+            node,
+            bias->owner,
+            bias->owner_value,
+            bias->name,
+            bias->tensor.to_mkldnn()));
+  }
+
+  if (groups->toInt() > 1) {
+    Graph* graph = node->owningGraph();
+    WithInsertPoint guard(node);
+    Value* input_mkldnn = graph->insert(
+        Symbol::fromQualString("aten::to_mkldnn"), {node->input(0)});
+    node->replaceInput(0, input_mkldnn);
+    WithInsertPoint after(node->next());
+    Value* output_dense = graph->insert(
+        Symbol::fromQualString("aten::to_dense"), {node->output()});
+    node->output()->replaceAllUsesWith(output_dense);
+    // replaceAllUsesWith also rewrote to_dense's own input; restore it
+    output_dense->node()->replaceInput(0, node->output());
+  }
+}
+
+// linear(x, w, b) -> to_dense(mkldnn_linear(to_mkldnn(x), w_mkldnn,
+// b_mkldnn)). mkldnn_linear requires a defined mkldnn bias, so an absent
+// bias is replaced with zeros, as torch.utils.mkldnn.MkldnnLinear does.
+void prepackLinear(Node* node, script::Module& module, Value* self_value) {
+  auto weight = resolveAttrTensor(node->input(1), module, self_value);
+  if (!weight || weight->tensor.dim() != 2) {
+    return;
+  }
+  auto bias = resolveAttrTensor(node->input(2), module, self_value);
+  if (!bias && !isNoneConstant(node->input(2))) {
+    return;
+  }
+
+  at::Tensor bias_tensor = bias
+      ? bias->tensor
+      : at::zeros({weight->tensor.size(0)}, weight->tensor.options());
+  Value* packed_weight = insertPackedBuffer(
+      node,
+      weight->owner,
+      weight->owner_value,
+      weight->name,
+      weight->tensor.to_mkldnn());
+  Value* packed_bias = insertPackedBuffer(
+      node,
+      bias ? bias->owner : weight->owner,
+      bias ? bias->owner_value : weight->owner_value,
+      bias ? bias->name : "bias",
+      bias_tensor.to_mkldnn());
+
+  Graph* graph = node->owningGraph();
+  WithInsertPoint guard(node);
+  Value* input_mkldnn = graph->insert(
+      Symbol::fromQualString("aten::to_mkldnn"), {node->input(0)});
+  Value* output_mkldnn = graph->insert(
+      Symbol::fromQualString("aten::mkldnn_linear"),
+      {input_mkldnn, packed_weight, packed_bias});
+  Value* output_dense =
+      graph->insert(Symbol::fromQualString("aten::to_dense"), {output_mkldnn});
+  node->output()->replaceAllUsesWith(output_dense);
+  node->destroy();
+}
+
+void prepackBlock(Block* block, script::Module& module, Value* self_value) {
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    Node* node = *it;
+    // the current node may be destroyed by the rewrite
+    ++it;
+    for (Block* sub : node->blocks()) {
+      prepackBlock(sub, module, self_value);
+    }
+    if (node->kind() == aten::conv2d && node->inputs().size() == 7) {
+      prepackConv2d(node, module, self_value);
+    } else if (node->kind() == aten::linear) {
+      prepackLinear(node, module, self_value);
+    }
+  }
+}
+
+// Folds to_mkldnn(to_dense(x)) -> x so chains of rewritten nodes hand the
+// blocked-layout activation to each other directly.
+void foldLayoutRoundTrips(Block* block) {
+  const auto to_mkldnn = Symbol::fromQualString("aten::to_mkldnn");
+  const auto to_dense = Symbol::fromQualString("aten::to_dense");
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    Node* node = *it;
+    ++it;
+    for (Block* sub : node->blocks()) {
+      foldLayoutRoundTrips(sub);
+    }
+    if (node->kind() == to_mkldnn &&
+        node->input(0)->node()->kind() == to_dense &&
+        node->input(0)->node()->owningBlock() == block) {
+      node->output()->replaceAllUsesWith(node->input(0)->node()->input(0));
+      node->destroy();
+    }
+  }
+}
+
+} // namespace
+
+void PrepackMKLDNNWeights(
+    script::Module& module,
+    const std::string& method_name) {
+  if (!at::hasMKLDNN()) {
+    return;
+  }
+  auto method = module.get_method(method_name);
+  auto graph = method.graph();
+  if (graphMutatesAttributes(graph->block())) {
+    // not a frozen method; pre-packed copies could go stale
+    return;
+  }
+  prepackBlock(graph->block(), module, graph->inputs()[0]);
+  foldLayoutRoundTrips(graph->block());
+  EliminateDeadCode(graph);
+}
+
+} // namespace jit
+} // namespace torch
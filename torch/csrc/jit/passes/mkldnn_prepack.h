@@ -0,0 +1,35 @@
+/** \brief Pre-packing of constant weights into MKL-DNN blocked layout
+ *
+ * Inference-only counterpart of torch.utils.mkldnn that works on a scripted
+ * module's graph instead of swapping nn.Module instances.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/script/module.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Convert the constant weights of conv2d/linear nodes to MKL-DNN
+ * layout once, at pass time, instead of re-reordering them on every call.
+ *
+ * Walks the graph of \p method_name, resolves the weight and bias inputs of
+ * aten::conv2d and aten::linear nodes through their prim::GetAttr chains, and
+ * when they are module parameters or buffers registers a pre-packed MKL-DNN
+ * copy on the owning submodule (via to_mkldnn / mkldnn_reorder_conv2d_weight)
+ * and rewrites the node to use it. Linear nodes are additionally bracketed
+ * with to_mkldnn / to_dense on the activation so they take the mkldnn_linear
+ * path; redundant to_mkldnn(to_dense(x)) pairs between rewritten nodes are
+ * folded away.
+ *
+ * Like torch.utils.mkldnn, this assumes an inference module: float CPU
+ * inputs, and attributes that are not mutated afterwards. The pass is a no-op
+ * when MKL-DNN is not available or the method mutates any attribute.
+ */
+TORCH_API void PrepackMKLDNNWeights(
+    script::Module& module,
+    const std::string& method_name);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,137 @@
+#include <torch/csrc/jit/passes/offload_params.h>
+
+#include <torch/csrc/jit/offload_engine.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool offloadEnabled() {
+  static const char* enable_c_str = std::getenv("TORCH_JIT_OFFLOAD_PARAMS");
+  if (!enable_c_str) {
+    return false;
+  }
+  std::string enable = enable_c_str;
+  return enable == "1" || enable == "true" || enable == "TRUE";
+}
+
+// Weights below this size are not worth a stream synchronization per use;
+// they stay resident.
+int64_t offloadMinBytes() {
+  static const int64_t min_bytes = []() {
+    const char* env = std::getenv("TORCH_JIT_OFFLOAD_MIN_BYTES");
+    if (env) {
+      return std::max<int64_t>(1, std::atoll(env));
+    }
+    return static_cast<int64_t>(1) << 20;
+  }();
+  return min_bytes;
+}
+
+bool isOffloadableConstant(Node* node, Block* top_block) {
+  if (node->kind() != prim::Constant || !node->hasAttribute(attr::value) ||
+      node->kindOf(attr::value) != AttributeKind::t) {
+    return false;
+  }
+  const at::Tensor& value = node->t(attr::value);
+  if (!value.defined() || !value.is_cuda()) {
+    return false;
+  }
+  if (value.numel() * value.element_size() < offloadMinBytes()) {
+    return false;
+  }
+  auto uses = node->output()->uses();
+  if (uses.empty()) {
+    return false;
+  }
+  for (const Use& use : uses) {
+    // Lifetimes are computed over the top-level block only; a use inside a
+    // loop or branch would need the weight resident across the whole
+    // enclosing node, so such constants are left alone. Returning a weight
+    // is also excluded: there is no node after the return to release it.
+    if (use.user->owningBlock() != top_block ||
+        use.user == top_block->return_node()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Node* firstUse(Value* value) {
+  Node* first = nullptr;
+  for (const Use& use : value->uses()) {
+    if (!first || use.user->isBefore(first)) {
+      first = use.user;
+    }
+  }
+  return first;
+}
+
+void offloadConstant(
+    const std::shared_ptr<Graph>& graph,
+    Node* node,
+    ParameterOffloadEngine& engine) {
+  Value* orig = node->output();
+  Node* first_use = firstUse(orig);
+  Node* last_use = nullptr;
+  for (const Use& use : orig->uses()) {
+    if (!last_use || use.user->isAfter(last_use)) {
+      last_use = use.user;
+    }
+  }
+
+  int64_t slot = engine.registerParameter(node->t(attr::value));
+
+  WithInsertPoint insert_point(first_use);
+  Value* slot_value = graph->insertConstant(slot);
+  Node* acquire =
+      graph->create(Symbol::fromQualString("offload::acquire"), {slot_value});
+  acquire->output()->setType(orig->type());
+  acquire->insertBefore(first_use);
+  orig->replaceAllUsesWith(acquire->output());
+
+  Node* release = graph->create(
+      Symbol::fromQualString("offload::release"),
+      {slot_value},
+      /*num_outputs=*/0);
+  release->insertAfter(last_use);
+
+  node->destroy();
+}
+
+} // namespace
+
+void OffloadParameters(const std::shared_ptr<Graph>& graph) {
+  if (!offloadEnabled()) {
+    return;
+  }
+  auto* engine = getParameterOffloadEngine();
+  if (!engine) {
+    return;
+  }
+  std::vector<Node*> candidates;
+  for (Node* node : graph->block()->nodes()) {
+    if (isOffloadableConstant(node, graph->block())) {
+      candidates.push_back(node);
+    }
+  }
+  // Slots must be registered in the order the graph acquires them — the
+  // engine's lookahead prefetches along registration order — and constant
+  // pooling hoists all constants to the top of the block, so sort by first
+  // use rather than by the constants' own positions.
+  std::sort(candidates.begin(), candidates.end(), [](Node* a, Node* b) {
+    return firstUse(a->output())->isBefore(firstUse(b->output()));
+  });
+  for (Node* node : candidates) {
+    offloadConstant(graph, node, *engine);
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Rewrites large device-resident weight constants of an inference graph
+// (as produced by tracing or freezing) so they live in pinned host memory
+// between uses: each eligible prim::Constant is registered with the
+// parameter offload engine (see offload_engine.h) and replaced with an
+// offload::acquire(slot) before its first use and an offload::release(slot)
+// after its last use. The engine copies weights host-to-device on a
+// dedicated stream a configurable number of slots ahead of compute
+// (TORCH_JIT_OFFLOAD_LOOKAHEAD, default 2), so a model larger than device
+// memory runs at near-resident speed on a smaller GPU.
+//
+// The pass is opt-in via TORCH_JIT_OFFLOAD_PARAMS=1; only constants of at
+// least TORCH_JIT_OFFLOAD_MIN_BYTES (default 1 MiB) whose uses are all in
+// the top-level block are offloaded, and the pass is a no-op in builds
+// without an offload engine.
+TORCH_API void OffloadParameters(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,252 @@
+#include <torch/csrc/jit/passes/parallelize_branches.h>
+
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/schedule_critical_path.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool multiStreamEnabled() {
+  static const char* enable_c_str = std::getenv("TORCH_JIT_MULTI_STREAM");
+  if (!enable_c_str) {
+    return false;
+  }
+  std::string enable = enable_c_str;
+  return enable == "1" || enable == "true" || enable == "TRUE";
+}
+
+// Don't bother forking trivial branches; the launch/join overhead would
+// outweigh the overlap.
+constexpr size_t kMinBranchNodes = 3;
+
+// Plain union-find over node indices, used to group the top-level nodes into
+// dataflow-connected components.
+struct UnionFind {
+  explicit UnionFind(size_t n) : parent_(n) {
+    for (size_t i = 0; i < n; ++i) {
+      parent_[i] = i;
+    }
+  }
+
+  size_t find(size_t x) {
+    while (parent_[x] != x) {
+      parent_[x] = parent_[parent_[x]];
+      x = parent_[x];
+    }
+    return x;
+  }
+
+  void merge(size_t a, size_t b) {
+    parent_[find(a)] = find(b);
+  }
+
+ private:
+  std::vector<size_t> parent_;
+};
+
+// A candidate branch: a connected component whose only consumer outside the
+// component is the graph return, through a single value.
+struct Branch {
+  std::vector<Node*> nodes; // in topological order
+  Value* output = nullptr;
+};
+
+// Outlines `branch' into a forked subgraph. Constants feeding the branch are
+// cloned into the subgraph; everything else a branch can reference is a graph
+// input, which becomes a fork input. The fork is inserted at the top of the
+// block so all branches launch before the inline work starts, and the join
+// (aten::wait) is inserted just before the return.
+void forkBranch(Graph& graph, const Branch& branch) {
+  auto subgraph = std::make_shared<Graph>();
+
+  Node* fork = graph.create(prim::fork, 1);
+  std::unordered_map<Value*, Value*> env;
+  const auto lookup = [&](Value* v) -> Value* {
+    auto it = env.find(v);
+    if (it != env.end()) {
+      return it->second;
+    }
+    if (v->node()->kind() == prim::Constant) {
+      Node* constant = subgraph->createClone(
+          v->node(), [](Value* inner) -> Value* { return inner; });
+      subgraph->insertNode(constant);
+      env[v] = constant->output();
+      return constant->output();
+    }
+    // A graph input: capture it as a fork input.
+    fork->addInput(v);
+    Value* input = subgraph->addInput()->copyMetadata(v);
+    env[v] = input;
+    return input;
+  };
+
+  for (Node* node : branch.nodes) {
+    Node* cloned = subgraph->insertNode(subgraph->createClone(node, lookup));
+    for (size_t i = 0; i < node->outputs().size(); ++i) {
+      env[node->outputs()[i]] = cloned->outputs()[i];
+    }
+  }
+  subgraph->registerOutput(env.at(branch.output));
+
+  fork->g_(attr::Subgraph, subgraph);
+  fork->output()->setType(FutureType::create(branch.output->type()));
+  fork->insertBefore(*graph.block()->nodes().begin());
+
+  Node* wait = graph.create(aten::wait, {fork->output()}, 1);
+  wait->output()->setType(branch.output->type());
+  wait->insertBefore(graph.block()->return_node());
+
+  branch.output->replaceAllUsesWith(wait->output());
+  for (auto it = branch.nodes.rbegin(); it != branch.nodes.rend(); ++it) {
+    (*it)->destroy();
+  }
+}
+
+void parallelizeBranchesImpl(const std::shared_ptr<Graph>& graph) {
+  Block* block = graph->block();
+
+  std::vector<Node*> nodes;
+  std::unordered_map<Node*, size_t> node_index;
+  for (Node* node : block->nodes()) {
+    // Only straight-line, side-effect-free graphs are handled; reordering
+    // anything else is not safe.
+    if (!node->blocks().empty() || node->hasSideEffects() ||
+        node->kind() == prim::fork || node->kind() == aten::wait ||
+        node->kind() == prim::BailOut || node->kind() == prim::Guard) {
+      return;
+    }
+    node_index[node] = nodes.size();
+    nodes.push_back(node);
+  }
+  if (nodes.size() < 2 * kMinBranchNodes) {
+    return;
+  }
+
+  // Any mutation makes the program order between branches observable, so
+  // bail out entirely rather than reason about it.
+  AliasDb aliasDb(graph);
+  for (Node* node : nodes) {
+    for (Value* input : node->inputs()) {
+      if (aliasDb.hasWriters(input)) {
+        return;
+      }
+    }
+    for (Value* output : node->outputs()) {
+      if (aliasDb.hasWriters(output)) {
+        return;
+      }
+    }
+  }
+
+  // Group nodes into dataflow-connected components. Constants are left out
+  // of the grouping (they are cloned into whichever branch uses them), so
+  // shared constants don't artificially merge otherwise-independent
+  // branches.
+  UnionFind components(nodes.size());
+  for (Node* node : nodes) {
+    for (Value* input : node->inputs()) {
+      Node* producer = input->node();
+      if (producer->kind() == prim::Constant) {
+        continue;
+      }
+      auto it = node_index.find(producer);
+      if (it != node_index.end()) {
+        components.merge(node_index[node], it->second);
+      }
+    }
+  }
+
+  std::unordered_map<size_t, Branch> branches;
+  for (Node* node : nodes) {
+    if (node->kind() == prim::Constant) {
+      continue;
+    }
+    branches[components.find(node_index[node])].nodes.push_back(node);
+  }
+
+  // A branch qualifies if it is big enough and feeds the return through
+  // exactly one value. (Values consumed by another branch would have merged
+  // the two components, so any remaining external use is the return node.)
+  std::vector<Branch*> candidates;
+  for (auto& entry : branches) {
+    Branch& branch = entry.second;
+    if (branch.nodes.size() < kMinBranchNodes) {
+      continue;
+    }
+    Value* external = nullptr;
+    bool multiple_outputs = false;
+    for (Node* node : branch.nodes) {
+      for (Value* output : node->outputs()) {
+        for (const Use& use : output->uses()) {
+          if (use.user == block->return_node()) {
+            if (external != nullptr && external != output) {
+              multiple_outputs = true;
+            }
+            external = output;
+          }
+        }
+      }
+    }
+    if (external == nullptr || multiple_outputs) {
+      continue;
+    }
+    branch.output = external;
+    candidates.push_back(&branch);
+  }
+  if (candidates.size() < 2) {
+    return;
+  }
+
+  // Fork all qualifying branches but one, which stays inline so the calling
+  // thread does useful work while the forked branches run. Order branches by
+  // their profiled runtime (one unit per op when an op has no recorded
+  // runtime) so the most expensive branch is forked, and therefore launched,
+  // first, and the cheapest one stays inline; with a saturated inter-op pool
+  // this is longest-processing-time-first scheduling of the branches.
+  const auto branchCost = [](const Branch* branch) {
+    double cost = 0;
+    for (Node* node : branch->nodes) {
+      auto runtime = getRecordedOpRuntime(node->kind().toUnqualString());
+      cost += runtime ? *runtime : 1.0;
+    }
+    return cost;
+  };
+  std::sort(
+      candidates.begin(), candidates.end(), [&](Branch* a, Branch* b) {
+        double cost_a = branchCost(a);
+        double cost_b = branchCost(b);
+        if (cost_a != cost_b) {
+          return cost_a > cost_b;
+        }
+        return node_index.at(a->nodes.front()) <
+            node_index.at(b->nodes.front());
+      });
+  // forkBranch inserts each fork at the top of the block, so fork in
+  // reverse order to leave the most expensive branch's fork first.
+  for (size_t i = candidates.size() - 1; i-- > 0;) {
+    forkBranch(*graph, *candidates[i]);
+  }
+
+  // Constants that fed only forked branches are now dead.
+  EliminateDeadCode(graph);
+}
+
+} // namespace
+
+void ParallelizeBranches(const std::shared_ptr<Graph>& graph) {
+  if (!multiStreamEnabled()) {
+    return;
+  }
+  parallelizeBranchesImpl(graph);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Rewrites independent branches of an inference graph (e.g. the towers of a
+// two-tower model) into prim::fork/aten::wait pairs so the interpreter runs
+// them concurrently on the inter-op thread pool instead of serializing one
+// branch behind the other. Branches are discovered as dataflow-connected
+// components of the top-level block; all but one qualifying branch are
+// outlined into forked subgraphs launched up front, and their results are
+// joined with aten::wait before the graph returns.
+//
+// The pass is opt-in via TORCH_JIT_MULTI_STREAM=1 and is a no-op for graphs
+// with control flow, mutation, or side-effecting nodes.
+TORCH_API void ParallelizeBranches(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,137 @@
+#include <torch/csrc/jit/passes/rewrite_inplace_ops.h>
+
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/liveness.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Ops whose in-place variant takes the same arguments as the functional
+// form and writes the result into its first input.
+c10::optional<Symbol> inplaceVariant(Symbol kind) {
+  static const std::unordered_map<Symbol, Symbol> variants = {
+      {aten::add, Symbol::fromQualString("aten::add_")},
+      {aten::sub, Symbol::fromQualString("aten::sub_")},
+      {aten::mul, Symbol::fromQualString("aten::mul_")},
+      {aten::div, Symbol::fromQualString("aten::div_")},
+      {aten::relu, Symbol::fromQualString("aten::relu_")},
+      {aten::sigmoid, Symbol::fromQualString("aten::sigmoid_")},
+      {aten::tanh, Symbol::fromQualString("aten::tanh_")},
+      {aten::clamp, Symbol::fromQualString("aten::clamp_")},
+  };
+  auto it = variants.find(kind);
+  if (it == variants.end()) {
+    return c10::nullopt;
+  }
+  return it->second;
+}
+
+// Collect the outputs of all constant nodes, including those in
+// sub-blocks. Constants are owned by the graph and shared across runs,
+// so their buffers must never be written to.
+void collectConstants(Block* block, std::vector<Value*>& constants) {
+  for (Node* node : block->nodes()) {
+    if (node->kind() == prim::Constant) {
+      for (Value* output : node->outputs()) {
+        constants.push_back(output);
+      }
+    }
+    for (Block* sub : node->blocks()) {
+      collectConstants(sub, constants);
+    }
+  }
+}
+
+struct InplaceRewriter {
+  explicit InplaceRewriter(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)),
+        aliasDb_(graph_),
+        liveness_(BuildLivenessSets(graph_)) {
+    collectConstants(graph_->block(), constants_);
+  }
+
+  void run() {
+    // Decide all rewrites against the original graph before mutating
+    // it, since the liveness sets refer to the original values. The
+    // decisions compose: making an op in-place only merges the buffers
+    // of values that were each proven dead past that point.
+    std::vector<Node*> rewrites;
+    for (Node* node : graph_->block()->nodes()) {
+      if (isSafeToRewrite(node)) {
+        rewrites.push_back(node);
+      }
+    }
+    for (Node* node : rewrites) {
+      WithInsertPoint guard(node);
+      Node* inplace = graph_->insertNode(
+          graph_->create(*inplaceVariant(node->kind()), node->inputs()));
+      inplace->output()->copyMetadata(node->output());
+      node->output()->replaceAllUsesWith(inplace->output());
+      node->destroy();
+    }
+  }
+
+ private:
+  bool isSafeToRewrite(Node* node) {
+    if (!inplaceVariant(node->kind()) || node->outputs().size() != 1) {
+      return false;
+    }
+    Value* self = node->inputs().at(0);
+    if (!self->type()->isSubtypeOf(TensorType::get()) ||
+        !node->output()->type()->isSubtypeOf(TensorType::get())) {
+      return false;
+    }
+    // Graph inputs belong to the caller and constants are shared across
+    // runs; anything that may alias either must stay untouched.
+    for (Value* input : graph_->inputs()) {
+      if (aliasDb_.mayContainAlias(self, input)) {
+        return false;
+      }
+    }
+    for (Value* constant : constants_) {
+      if (aliasDb_.mayContainAlias(self, constant)) {
+        return false;
+      }
+    }
+    // The liveness sets are not a fixed point across loop back edges, so
+    // only rewrite in the top-level block. Uses inside the sub-blocks of
+    // later top-level nodes are still visible in their live-in sets.
+    if (node->owningBlock() != graph_->block()) {
+      return false;
+    }
+    // `self` is reusable only if neither it nor anything that may alias
+    // it is live after this node.
+    for (Value* live : liveAfter(node)) {
+      if (aliasDb_.mayContainAlias(self, live)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Values live after `node`, i.e. live into its successor. For the last
+  // node in the block only the block outputs remain live.
+  std::vector<Value*> liveAfter(Node* node) {
+    Node* next = node->next();
+    if (next == node->owningBlock()->return_node()) {
+      return node->owningBlock()->outputs().vec();
+    }
+    return liveness_.at(next);
+  }
+
+  std::shared_ptr<Graph> graph_;
+  AliasDb aliasDb_;
+  std::unordered_map<Node*, std::vector<Value*>> liveness_;
+  std::vector<Value*> constants_;
+};
+
+} // namespace
+
+void RewriteInplaceOps(std::shared_ptr<Graph>& graph) {
+  InplaceRewriter(graph).run();
+}
+
+} // namespace jit
+} // namespace torch
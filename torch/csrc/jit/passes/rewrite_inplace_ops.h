@@ -0,0 +1,25 @@
+/** \brief Rewrite functional ops to their in-place variants when the
+ * destination buffer provably dies at the op.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Rewrite ops such as aten::add to aten::add_ when their first
+ * input is dead after the op, so the result reuses the input's buffer
+ * instead of allocating a fresh one.
+ *
+ * A rewrite is performed only when liveness and alias analysis prove
+ * that neither the input nor anything that may alias it is used after
+ * the op, and the input cannot alias a graph input or a constant.
+ *
+ * This changes the graph's autograd behavior (in-place ops bump version
+ * counters and can invalidate saved tensors), so the pass is intended
+ * for inference graphs.
+ */
+TORCH_API void RewriteInplaceOps(std::shared_ptr<Graph>& graph);
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,227 @@
+#include <torch/csrc/jit/passes/schedule_critical_path.h>
+
+#include <torch/csrc/autograd/record_function.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool criticalPathScheduleEnabled() {
+  static const char* enable_c_str =
+      std::getenv("TORCH_JIT_CRITICAL_PATH_SCHEDULE");
+  if (!enable_c_str) {
+    return false;
+  }
+  std::string enable = enable_c_str;
+  return enable == "1" || enable == "true" || enable == "TRUE";
+}
+
+// Record names come from several instrumentation sites and may or may not
+// carry a namespace ("aten::add" vs "add"); node kinds always do. Key the
+// profile on the unqualified name so both resolve to the same entry.
+std::string normalizeOpName(const std::string& name) {
+  auto pos = name.rfind("::");
+  if (pos == std::string::npos) {
+    return name;
+  }
+  return name.substr(pos + 2);
+}
+
+struct OpRuntimeProfile {
+  void record(const std::string& name, double duration_us) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = totals[name];
+    entry.first += duration_us;
+    entry.second += 1;
+  }
+
+  c10::optional<double> mean(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = totals.find(name);
+    if (it == totals.end() || it->second.second == 0) {
+      return c10::nullopt;
+    }
+    return it->second.first / it->second.second;
+  }
+
+  std::mutex mutex;
+  // name -> (total runtime in us, sample count)
+  std::unordered_map<std::string, std::pair<double, int64_t>> totals;
+};
+
+OpRuntimeProfile& opRuntimeProfile() {
+  static OpRuntimeProfile profile;
+  return profile;
+}
+
+// Cost of executing a node, in microseconds when a runtime was recorded for
+// its op, otherwise one unit. Constants are free: the interpreter
+// materializes them once.
+double nodeCost(Node* node) {
+  if (node->kind() == prim::Constant) {
+    return 0;
+  }
+  auto runtime =
+      opRuntimeProfile().mean(node->kind().toUnqualString());
+  return runtime ? *runtime : 1.0;
+}
+
+void scheduleCriticalPathImpl(const std::shared_ptr<Graph>& graph) {
+  Block* block = graph->block();
+
+  std::vector<Node*> nodes;
+  std::unordered_map<Node*, size_t> node_index;
+  for (Node* node : block->nodes()) {
+    // Only straight-line, side-effect-free graphs are handled; reordering
+    // anything else is not safe.
+    if (!node->blocks().empty() || node->hasSideEffects() ||
+        node->kind() == prim::fork || node->kind() == aten::wait ||
+        node->kind() == prim::BailOut || node->kind() == prim::Guard) {
+      return;
+    }
+    node_index[node] = nodes.size();
+    nodes.push_back(node);
+  }
+  if (nodes.size() < 2) {
+    return;
+  }
+
+  // Any mutation makes program order observable, so bail out entirely
+  // rather than reason about it.
+  AliasDb aliasDb(graph);
+  for (Node* node : nodes) {
+    for (Value* input : node->inputs()) {
+      if (aliasDb.hasWriters(input)) {
+        return;
+      }
+    }
+    for (Value* output : node->outputs()) {
+      if (aliasDb.hasWriters(output)) {
+        return;
+      }
+    }
+  }
+
+  // Critical path length of each node: its own cost plus the longest chain
+  // of in-block consumers below it. Consumers are always later in the
+  // current topological order, so one reverse sweep suffices.
+  std::vector<double> critical_path(nodes.size());
+  for (size_t i = nodes.size(); i-- > 0;) {
+    Node* node = nodes[i];
+    double longest_consumer = 0;
+    for (Value* output : node->outputs()) {
+      for (const Use& use : output->uses()) {
+        auto it = node_index.find(use.user);
+        if (it != node_index.end()) {
+          longest_consumer = std::max(longest_consumer, critical_path[it->second]);
+        }
+      }
+    }
+    critical_path[i] = nodeCost(node) + longest_consumer;
+  }
+
+  // List-schedule: among ready nodes, always emit the one heading the
+  // longest remaining chain; ties keep the original order.
+  std::vector<size_t> pending_inputs(nodes.size(), 0);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    for (Value* input : nodes[i]->inputs()) {
+      if (node_index.count(input->node())) {
+        pending_inputs[i]++;
+      }
+    }
+  }
+
+  using Entry = std::pair<double, size_t>; // (critical path, original index)
+  const auto later = [&](const Entry& a, const Entry& b) {
+    if (a.first != b.first) {
+      return a.first < b.first;
+    }
+    return a.second > b.second;
+  };
+  std::priority_queue<Entry, std::vector<Entry>, decltype(later)> ready(later);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (pending_inputs[i] == 0) {
+      ready.push({critical_path[i], i});
+    }
+  }
+
+  std::vector<Node*> schedule;
+  schedule.reserve(nodes.size());
+  while (!ready.empty()) {
+    size_t i = ready.top().second;
+    ready.pop();
+    Node* node = nodes[i];
+    schedule.push_back(node);
+    for (Value* output : node->outputs()) {
+      for (const Use& use : output->uses()) {
+        auto it = node_index.find(use.user);
+        if (it != node_index.end() && --pending_inputs[it->second] == 0) {
+          ready.push({critical_path[it->second], it->second});
+        }
+      }
+    }
+  }
+  AT_ASSERT(schedule.size() == nodes.size());
+
+  // Apply the schedule. Moving each node to the end in schedule order
+  // leaves the block in exactly that order, which is topologically valid by
+  // construction.
+  for (Node* node : schedule) {
+    node->moveBefore(block->return_node());
+  }
+}
+
+} // namespace
+
+void EnableOpRuntimeRecording() {
+  // pushCallback is not thread safe against running code; this is installed
+  // once, from the first optimization round of an opted-in executor, before
+  // the recorded runtimes are ever consumed.
+  static std::once_flag once;
+  std::call_once(once, []() {
+    using Clock = std::chrono::steady_clock;
+    static thread_local std::vector<Clock::time_point> starts;
+    torch::autograd::profiler::pushCallback(
+        [](const torch::autograd::profiler::RecordFunction&) {
+          starts.push_back(Clock::now());
+        },
+        [](const torch::autograd::profiler::RecordFunction& fn) {
+          if (starts.empty()) {
+            return;
+          }
+          auto start = starts.back();
+          starts.pop_back();
+          double duration_us =
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - start)
+                  .count() /
+              1000.0;
+          opRuntimeProfile().record(
+              normalizeOpName(fn.name().str()), duration_us);
+        });
+  });
+}
+
+c10::optional<double> getRecordedOpRuntime(const std::string& name) {
+  return opRuntimeProfile().mean(normalizeOpName(name));
+}
+
+void ScheduleCriticalPath(const std::shared_ptr<Graph>& graph) {
+  if (!criticalPathScheduleEnabled()) {
+    return;
+  }
+  EnableOpRuntimeRecording();
+  scheduleCriticalPathImpl(graph);
+}
+
+} // namespace jit
+} // namespace torch
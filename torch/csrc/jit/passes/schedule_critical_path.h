@@ -0,0 +1,37 @@
+#pragma once
+
+#include <c10/util/Optional.h>
+#include <torch/csrc/jit/ir.h>
+
+#include <string>
+
+namespace torch {
+namespace jit {
+
+// Reorders the straight-line nodes of a graph so ops on the critical path
+// are emitted (and with branch forking enabled, launched) first. The
+// instruction order the interpreter executes is the node order of the graph,
+// and a naive topological order can schedule a long dependency chain behind
+// short independent work; with inter-op parallelism available, starting the
+// long pole first shortens the makespan.
+//
+// Per-op costs come from runtimes recorded during the executor's warmup
+// runs through a RecordFunction observer (see EnableOpRuntimeRecording);
+// ops without a recorded runtime cost one unit, which degrades to
+// longest-chain-first ordering. The pass is opt-in via
+// TORCH_JIT_CRITICAL_PATH_SCHEDULE=1 and is a no-op for graphs with control
+// flow, mutation, or side-effecting nodes.
+TORCH_API void ScheduleCriticalPath(const std::shared_ptr<Graph>& graph);
+
+// Installs the RecordFunction observer that accumulates mean per-op
+// runtimes. Idempotent; called automatically by ScheduleCriticalPath when
+// the pass is enabled, so warmup runs of tiered or re-profiled executions
+// feed the profile consumed by later optimization rounds.
+TORCH_API void EnableOpRuntimeRecording();
+
+// Mean recorded runtime in microseconds for an op name (with or without a
+// namespace prefix), or nullopt if the op has not been observed.
+TORCH_API c10::optional<double> getRecordedOpRuntime(const std::string& name);
+
+} // namespace jit
+} // namespace torch
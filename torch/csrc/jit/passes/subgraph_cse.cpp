@@ -0,0 +1,213 @@
+#include <torch/csrc/jit/passes/subgraph_cse.h>
+
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/node_hashing.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace torch {
+namespace jit {
+namespace {
+
+bool isSubgraphNode(Node* node) {
+  return node->kind() == prim::FusionGroup ||
+      node->kind() == prim::DifferentiableGraph;
+}
+
+// A node inside a subgraph can be recomputed in the parent graph when it is
+// pure, produces a single value, and depends only on values captured from
+// the parent (subgraph parameters) or on inner constants. Nodes feeding the
+// subgraph's outputs are excluded: hoisting one would make the subgraph
+// return one of its own inputs, introducing input/output aliasing the
+// executor does not expect.
+bool isHoistable(Node* node) {
+  if (node->kind() == prim::Constant || node->hasSideEffects() ||
+      node->isNondeterministic() || !node->blocks().empty() ||
+      node->outputs().size() != 1) {
+    return false;
+  }
+  Block* owning = node->owningBlock();
+  for (Value* input : node->inputs()) {
+    Node* producer = input->node();
+    if (producer->kind() != prim::Constant &&
+        producer != owning->param_node()) {
+      return false;
+    }
+  }
+  for (const Use& use : node->output()->uses()) {
+    if (use.user == owning->return_node()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A parent-graph node that hoisted computations may be deduplicated against.
+bool isReusableParentNode(Node* node, const AliasDb& aliasDb) {
+  return node->kind() != prim::Constant && !node->hasSideEffects() &&
+      !node->isNondeterministic() && node->blocks().empty() &&
+      node->outputs().size() == 1 && !aliasDb.hasWriters(node);
+}
+
+// Replaces `inner` with a new subgraph parameter fed by `outer` and destroys
+// it. `inner` must live in the subgraph of `subgraphNode`.
+void rewireToOuter(Node* inner, Node* subgraphNode, Value* outer) {
+  auto subgraph = subgraphNode->g(attr::Subgraph);
+  subgraphNode->addInput(outer);
+  Value* param = subgraph->addInput()->copyMetadata(inner->output());
+  inner->output()->replaceAllUsesWith(param);
+  inner->destroy();
+}
+
+// Materializes an inner constant in the parent graph, pooled so that equal
+// constants from different subgraphs become the same Value.
+Value* getOrCreateOuterConstant(
+    Graph& graph,
+    Node* constant,
+    Node* insertPoint,
+    std::unordered_set<Node*, HashNode, EqualNode>& outerConstants,
+    std::vector<Node*>& insertedConstants) {
+  Node* clone = graph.createClone(constant, [](Value*) -> Value* {
+    AT_ERROR("constants have no inputs");
+  });
+  auto existing = outerConstants.find(clone);
+  if (existing != outerConstants.end()) {
+    clone->destroy();
+    return (*existing)->output();
+  }
+  clone->insertBefore(insertPoint);
+  outerConstants.insert(clone);
+  insertedConstants.push_back(clone);
+  return clone->output();
+}
+
+// One candidate computation, keyed in the map by its parent-graph twin: a
+// clone of the inner node whose inputs are the captured parent values, so
+// identical computations from different subgraphs hash equal. The twin stays
+// uninserted until a second occurrence (or a matching parent node) justifies
+// hoisting it.
+struct Candidate {
+  Node* inner;        // first inner occurrence; nullptr once hoisted
+  Node* subgraphNode; // subgraph owning `inner`
+  bool hoisted;
+};
+
+bool runBlock(Block* block, Graph& graph, const AliasDb& aliasDb) {
+  bool mutated = false;
+  std::unordered_map<Node*, Candidate, HashNode, EqualNode> candidates;
+  std::unordered_set<Node*, HashNode, EqualNode> outerConstants;
+  std::vector<Node*> insertedConstants;
+  std::unordered_set<Node*> modifiedSubgraphs;
+
+  for (Node* node : block->nodes()) {
+    for (Block* subBlock : node->blocks()) {
+      mutated |= runBlock(subBlock, graph, aliasDb);
+    }
+    if (!isSubgraphNode(node)) {
+      if (isReusableParentNode(node, aliasDb)) {
+        // Later subgraph computations may dedup against this node; it
+        // precedes them in the block, so its output dominates their uses.
+        candidates.emplace(node, Candidate{nullptr, nullptr, true});
+      }
+      continue;
+    }
+
+    auto subgraph = node->g(attr::Subgraph);
+    for (auto it = subgraph->nodes().begin(); it != subgraph->nodes().end();) {
+      Node* inner = *it;
+      ++it;
+      if (!isHoistable(inner)) {
+        continue;
+      }
+
+      // Map the inner node's inputs to parent values: parameters to the
+      // corresponding subgraph node inputs, constants to pooled copies.
+      bool writers = false;
+      Node* twin = graph.createClone(inner, [&](Value* input) -> Value* {
+        if (input->node()->kind() == prim::Constant) {
+          return getOrCreateOuterConstant(
+              graph, input->node(), node, outerConstants, insertedConstants);
+        }
+        Value* outer = node->input(input->offset());
+        if (aliasDb.hasWriters(outer)) {
+          // Recomputing ahead of the subgraph would observe a different
+          // value if the input is mutated in between.
+          writers = true;
+        }
+        return outer;
+      });
+      if (writers) {
+        twin->destroy();
+        continue;
+      }
+
+      auto found = candidates.find(twin);
+      if (found == candidates.end()) {
+        candidates.emplace(twin, Candidate{inner, node, false});
+        continue;
+      }
+
+      Node* key = found->first;
+      Candidate& candidate = found->second;
+      if (!candidate.hoisted) {
+        // Second occurrence: materialize the twin ahead of the first
+        // occurrence's subgraph, which dominates every later sibling.
+        key->insertBefore(candidate.subgraphNode);
+        GRAPH_UPDATE("Hoisting\n", *candidate.inner, "as\n", *key);
+        rewireToOuter(candidate.inner, candidate.subgraphNode, key->output());
+        modifiedSubgraphs.insert(candidate.subgraphNode);
+        candidate.inner = nullptr;
+        candidate.hoisted = true;
+      }
+      GRAPH_UPDATE("Replacing\n", *inner, "with hoisted\n", *key);
+      rewireToOuter(inner, node, key->output());
+      modifiedSubgraphs.insert(node);
+      twin->destroy();
+      mutated = true;
+    }
+  }
+
+  // Unmatched twins were never inserted but still hold uses of parent
+  // values; destroy them so they do not pin those values.
+  for (const auto& entry : candidates) {
+    if (!entry.second.hoisted) {
+      entry.first->destroy();
+    }
+  }
+  // Constants materialized for candidates that never matched.
+  for (Node* constant : insertedConstants) {
+    if (!constant->output()->hasUses()) {
+      constant->destroy();
+    }
+  }
+  // Hoisting can leave subgraph parameters (and the matching subgraph node
+  // inputs) unused; drop them so the subgraphs do not capture dead values.
+  for (Node* subgraphNode : modifiedSubgraphs) {
+    auto subgraph = subgraphNode->g(attr::Subgraph);
+    for (size_t i = subgraph->inputs().size(); i > 0; --i) {
+      if (!subgraph->inputs()[i - 1]->hasUses()) {
+        subgraph->eraseInput(i - 1);
+        subgraphNode->removeInput(i - 1);
+      }
+    }
+  }
+  return mutated;
+}
+
+} // namespace
+
+void EliminateSubgraphCommonSubexpressions(
+    const std::shared_ptr<Graph>& graph) {
+  AliasDb aliasDb(graph);
+  GRAPH_DUMP("Before subgraph CSE", graph);
+  if (runBlock(graph->block(), *graph, aliasDb)) {
+    GRAPH_DUMP("After subgraph CSE", graph);
+  }
+}
+
+} // namespace jit
+} // namespace torch
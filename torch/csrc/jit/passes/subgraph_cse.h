@@ -0,0 +1,21 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Hoists pure computations that sibling subgraphs (fusion groups,
+// differentiable graphs) duplicate - repeated transposes, broadcasts of the
+// same constant - into the parent graph, so each is computed once and passed
+// to the subgraphs as an input. Regular CSE cannot see these: each subgraph
+// is a separate Graph, so identical nodes in two siblings never meet in one
+// block. A computation is only hoisted when it appears in at least two
+// subgraphs or already exists in the parent graph; unshared work stays
+// inside its subgraph where the fuser can use it. Run after subgraphs have
+// been formed (after CreateAutodiffSubgraphs or FuseGraph).
+TORCH_API void EliminateSubgraphCommonSubexpressions(
+    const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -14,7 +14,11 @@ void pickle(
     std::function<void(const char* data_start, size_t data_len)> writer,
     const IValue& ivalue,
     std::vector<at::Tensor>* tensor_table) {
-  Pickler pickler(std::move(writer), tensor_table);
+  Pickler pickler(
+      std::move(writer),
+      tensor_table,
+      /*memorized_class_types=*/nullptr,
+      bulkPrimitiveListsEnabled());
   pickler.protocol();
   pickler.pushIValue(ivalue);
   pickler.stop();
@@ -3,6 +3,7 @@
 #include <torch/csrc/jit/function.h>
 #include <torch/csrc/jit/pickler.h>
 #include <aten/src/ATen/quantized/Quantizer.h>
+#include <cstdlib>
 #include <string>
 
 namespace torch {
@@ -14,6 +15,16 @@ using ::c10::IValue;
 // See https://docs.python.org/3/library/pickle.html#data-stream-format
 constexpr static uint8_t PROTOCOL_VERSION = 2;
 
+// Lists shorter than this are still pushed item-by-item even when bulk
+// encoding is enabled; below it the fixed cost of the REDUCE wrapper is
+// comparable to the per-item opcodes.
+constexpr static size_t kBulkListMinSize = 32;
+
+bool bulkPrimitiveListsEnabled() {
+  static const bool enabled = std::getenv("TORCH_PICKLE_BULK_LISTS") != nullptr;
+  return enabled;
+}
+
 Pickler::~Pickler() {
   flush();
 }
@@ -30,6 +41,10 @@ const char* getClassName(PicklerClass cls) {
       return "build_doublelist";
     case PicklerClass::BOOLLIST:
       return "build_boollist";
+    case PicklerClass::INTLIST_FROM_BYTES:
+      return "build_intlist_from_bytes";
+    case PicklerClass::DOUBLELIST_FROM_BYTES:
+      return "build_doublelist_from_bytes";
     default:
       AT_ERROR("Unknown class for pickler");
   }
@@ -76,6 +91,14 @@ void Pickler::pushIValueImpl(const IValue& ivalue) {
   } else if (ivalue.isNone()) {
     push<PickleOpCode>(PickleOpCode::NONE);
   } else if (ivalue.isIntList()) {
+    auto list = ivalue.toIntListRef();
+    if (bulk_primitive_lists_ && list.size() >= kBulkListMinSize) {
+      pushBulkList(
+          PicklerClass::INTLIST_FROM_BYTES,
+          reinterpret_cast<const char*>(list.data()),
+          list.size() * sizeof(int64_t));
+      return;
+    }
     pushSpecializedList(
         ivalue, PicklerClass::INTLIST, [=](const IValue& ivalue) {
           for (const int64_t item : ivalue.toIntListRef()) {
@@ -90,6 +113,14 @@ void Pickler::pushIValueImpl(const IValue& ivalue) {
           }
         });
   } else if (ivalue.isDoubleList()) {
+    auto list = ivalue.toDoubleListRef();
+    if (bulk_primitive_lists_ && list.size() >= kBulkListMinSize) {
+      pushBulkList(
+          PicklerClass::DOUBLELIST_FROM_BYTES,
+          reinterpret_cast<const char*>(list.data()),
+          list.size() * sizeof(double));
+      return;
+    }
     pushSpecializedList(
         ivalue, PicklerClass::DOUBLELIST, [=](const IValue& ivalue) {
           for (double item : ivalue.toDoubleListRef()) {
@@ -400,6 +431,38 @@ void Pickler::pushSpecializedList(
   push<PickleOpCode>(PickleOpCode::REDUCE);
 }
 
+// Bulk counterpart of pushSpecializedList: the elements travel as one
+// length-prefixed BINBYTES8 record of raw little-endian 8-byte values
+// instead of per-item opcodes, so writing is a single memcpy on
+// little-endian hosts.
+void Pickler::pushBulkList(
+    PicklerClass cls,
+    const char* data,
+    size_t size_in_bytes) {
+  pushClass(cls);
+
+  // Reduce arguments are spread (e.g. `*args`) before calling the global,
+  // so wrap in a tuple
+  push<PickleOpCode>(PickleOpCode::MARK);
+
+  push<PickleOpCode>(PickleOpCode::BINBYTES8);
+  push<uint64_t>(size_in_bytes);
+  flush();
+  if (isHostLittleEndian()) {
+    writer_(data, size_in_bytes);
+  } else {
+    std::vector<char> swapped(data, data + size_in_bytes);
+    swapBulkListBytes(swapped.data(), size_in_bytes / 8);
+    writer_(swapped.data(), size_in_bytes);
+  }
+
+  // Finish tuple
+  push<PickleOpCode>(PickleOpCode::TUPLE);
+
+  // Call reduce
+  push<PickleOpCode>(PickleOpCode::REDUCE);
+}
+
 static inline double swapDouble(double value) {
   const char* bytes = reinterpret_cast<const char*>(&value);
   double flipped;
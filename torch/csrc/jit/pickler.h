@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <ATen/core/ivalue.h>
@@ -97,11 +98,41 @@ enum PicklerClass : uint8_t {
   // List[float]
   DOUBLELIST = 3,
   // List[bool]
-  BOOLLIST = 4
+  BOOLLIST = 4,
+  // List[int] encoded as a single BINBYTES8 record of raw little-endian
+  // elements instead of per-item opcodes
+  INTLIST_FROM_BYTES = 5,
+  // List[float], same bulk encoding
+  DOUBLELIST_FROM_BYTES = 6
 };
 
 using ::c10::IValue;
 
+// Whether the Pickler should encode large List[int]/List[float] values as a
+// single raw byte segment (see Pickler::pushBulkList). Controlled by the
+// TORCH_PICKLE_BULK_LISTS environment variable; opt-in because the resulting
+// archives use the protocol 4 BINBYTES8 opcode, which Python 2's pickle
+// module cannot read.
+TORCH_API bool bulkPrimitiveListsEnabled();
+
+inline bool isHostLittleEndian() {
+  const uint16_t probe = 1;
+  return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+}
+
+// Byte-swap the 8-byte elements of a bulk list payload in place. The
+// fixed-size inner reversal compiles down to one bswap/rev per element, so
+// the loop vectorizes; on little-endian hosts (where the payload matches the
+// wire format) no swap is needed at all.
+inline void swapBulkListBytes(char* data, size_t num_elements) {
+  for (size_t i = 0; i < num_elements; ++i) {
+    char* element = data + i * 8;
+    for (size_t j = 0; j < 4; ++j) {
+      std::swap(element[j], element[7 - j]);
+    }
+  }
+}
+
 struct WriteableTensorData {
   const char* data() const {
     return static_cast<const char*>(tensor_.storage().data());
@@ -126,10 +157,12 @@ class Pickler {
   Pickler(
       std::function<void(const char*, size_t)> writer,
       std::vector<at::Tensor>* tensor_table,
-      std::vector<c10::ClassTypePtr>* memorized_class_types = nullptr)
+      std::vector<c10::ClassTypePtr>* memorized_class_types = nullptr,
+      bool bulk_primitive_lists = false)
       : writer_(writer),
         tensor_table_(tensor_table),
-        memorized_class_types_(memorized_class_types) {}
+        memorized_class_types_(memorized_class_types),
+        bulk_primitive_lists_(bulk_primitive_lists) {}
   ~Pickler();
 
   // Push protocol onto the stack
@@ -174,6 +207,7 @@ class Pickler {
       const IValue& ivalue,
       PicklerClass cls,
       const std::function<void(const IValue&)>& item_pusher);
+  void pushBulkList(PicklerClass cls, const char* data, size_t size_in_bytes);
   void pushGlobal(
       const std::string& module_name,
       const std::string& class_name);
@@ -253,6 +287,9 @@ class Pickler {
 
   std::unordered_map<std::string, uint32_t> memoized_globals_map_;
   std::unordered_map<std::string, uint32_t> memoized_strings_map_;
+
+  // Encode large List[int]/List[float] values as single raw byte segments
+  bool bulk_primitive_lists_;
 };
 
 // returns a (tensor, record_size) for a tensor, converting it to a CPU tensor
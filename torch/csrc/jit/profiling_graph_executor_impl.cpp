@@ -16,6 +16,8 @@
 #include <torch/csrc/jit/passes/specialize_autogradzero.h>
 #include <torch/csrc/jit/profiling_graph_executor_impl.h>
 
+#include <cstdlib>
+
 namespace torch {
 namespace jit {
 
@@ -35,6 +37,25 @@ std::atomic<bool>& getExecutorMode() {
   return executor_mode;
 }
 
+// Number of consecutive runs the optimized plan has to see an unchanged
+// input fingerprint before it is promoted to guard-free execution
+// (TORCH_JIT_GUARD_FREE_AFTER=N). 0 (the default) disables promotion. For
+// fixed-shape inference workloads the per-iteration bailout checks are pure
+// overhead; once the input spec has been stable for N runs the guards are
+// stripped and only the entry fingerprint check remains. If the fingerprint
+// ever changes, execution falls back to the guarded plan.
+static size_t guardFreePromotionRuns() {
+  static const size_t runs = []() -> size_t {
+    const char* env = std::getenv("TORCH_JIT_GUARD_FREE_AFTER");
+    if (!env) {
+      return 0;
+    }
+    auto value = std::atol(env);
+    return value > 0 ? static_cast<size_t>(value) : 0;
+  }();
+  return runs;
+}
+
 static bool needsGradientInProfilingMode(Block* b) {
   for (auto n : b->nodes()) {
     if (n->kind() == prim::BailOut) {
@@ -68,6 +89,27 @@ ExecutionPlan ProfilingGraphExecutorImpl::getPlanFor(Stack& stack) {
   std::lock_guard<std::mutex> lock(compile_mutex);
   GRAPH_DEBUG("Running ProfilingGraphExecutorImpl ", this);
   if (optimized_plan_) {
+    const size_t promote_after = guardFreePromotionRuns();
+    if (promote_after != 0) {
+      CompleteArgumentSpec spec(
+          autograd::GradMode::is_enabled(),
+          last(stack, graph->inputs().size()));
+      if (stable_spec_ && *stable_spec_ == spec) {
+        if (guard_free_plan_) {
+          return *guard_free_plan_;
+        }
+        if (++stable_run_count_ >= promote_after) {
+          guard_free_plan_ = buildGuardFreePlan();
+          return *guard_free_plan_;
+        }
+      } else {
+        // New input fingerprint: drop any promoted plan and start counting
+        // again against the guarded plan.
+        stable_spec_ = spec;
+        stable_run_count_ = 0;
+        guard_free_plan_ = c10::nullopt;
+      }
+    }
     return *optimized_plan_;
   }
 
@@ -150,6 +192,31 @@ ExecutionPlan ProfilingGraphExecutorImpl::getPlanFor(Stack& stack) {
 }
 
 
+// Reconnects every guarded value to its users and drops the prim::BailOut
+// node. The bailout template is left for dead code elimination once its last
+// use is gone.
+static void stripBailOuts(Block* b) {
+  for (auto it = b->nodes().begin(); it != b->nodes().end(); ++it) {
+    if (it->kind() == prim::BailOut) {
+      // input 0 is the bailout template, input 1 the guarded value.
+      it->output()->replaceAllUsesWith(it->input(1));
+      it.destroyCurrent();
+    } else {
+      for (auto ib : it->blocks()) {
+        stripBailOuts(ib);
+      }
+    }
+  }
+}
+
+ExecutionPlan ProfilingGraphExecutorImpl::buildGuardFreePlan() {
+  auto copy = optimized_plan_->graph->copy();
+  stripBailOuts(copy->block());
+  EliminateDeadCode(copy);
+  GRAPH_DUMP("Guard-free Graph: ", copy);
+  return ExecutionPlan(copy);
+}
+
 GraphExecutorState ProfilingGraphExecutorImpl::getDebugState() {
   GraphExecutorState state;
   TORCH_INTERNAL_ASSERT(optimized_plan_);
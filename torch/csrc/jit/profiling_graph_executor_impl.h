@@ -15,10 +15,21 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   std::shared_ptr<Graph> prepareGraph(
       const std::shared_ptr<Graph>& graph,
       Stack& stack);
+  // Builds a copy of the optimized graph with all bailout guards stripped
+  // out. Only used once the input fingerprint has stayed stable for enough
+  // runs; see getPlanFor.
+  ExecutionPlan buildGuardFreePlan();
   std::unique_ptr<ProfilingRecord> pr_;
   c10::optional<ExecutionPlan>
       profiling_plan_; // plan to run in order to profiling the code
   c10::optional<ExecutionPlan> optimized_plan_;
+  // guard-free promotion state (TORCH_JIT_GUARD_FREE_AFTER): the fingerprint
+  // of the inputs the optimized plan has been running with, how many
+  // consecutive runs it has stayed unchanged, and the promoted plan itself
+  // once the threshold is reached.
+  c10::optional<CompleteArgumentSpec> stable_spec_;
+  size_t stable_run_count_ = 0;
+  c10::optional<ExecutionPlan> guard_free_plan_;
 };
 
 } // namespace jit
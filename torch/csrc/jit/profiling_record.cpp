@@ -1,11 +1,97 @@
 #include <torch/csrc/jit/profiling_record.h>
 #include <torch/csrc/jit/passes/constant_propagation.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
 namespace torch {
 namespace jit {
 
+// Number of runs the instrumented graph executes before its profiling
+// information is considered complete (TORCH_JIT_NUM_PROFILED_RUNS,
+// default 1). A dimension can only be recognized as varying if more than
+// one run is observed.
+static size_t numProfiledRuns() {
+  static const size_t runs = []() -> size_t {
+    const char* env = std::getenv("TORCH_JIT_NUM_PROFILED_RUNS");
+    if (!env) {
+      return 1;
+    }
+    auto value = std::atol(env);
+    return value > 0 ? static_cast<size_t>(value) : 1;
+  }();
+  return runs;
+}
+
+// Number of distinct values a profiled dimension may take before it is
+// recorded as symbolic (TORCH_JIT_SYMBOLIC_DIM_THRESHOLD, default 2).
+// Below the threshold the dimension stays specialized to the most recent
+// value, so guards keep checking it exactly; at the threshold it becomes
+// an empty optional in the profiled VaryingShape and guards accept any
+// extent for it. The default reproduces the behavior of a plain merge:
+// the first disagreement makes the dimension symbolic.
+static size_t symbolicDimThreshold() {
+  static const size_t threshold = []() -> size_t {
+    const char* env = std::getenv("TORCH_JIT_SYMBOLIC_DIM_THRESHOLD");
+    if (!env) {
+      return 2;
+    }
+    auto value = std::atol(env);
+    return value > 0 ? static_cast<size_t>(value) : 2;
+  }();
+  return threshold;
+}
+
+namespace {
+
+// Distinct sizes and strides observed per dimension of one profiled value.
+// Dimensions that were already erased from the profiled type stop being
+// tracked, so each inner vector holds fewer than the threshold entries.
+struct ShapeObservations {
+  std::vector<std::vector<int64_t>> sizes;
+  std::vector<std::vector<int64_t>> strides;
+};
+
+} // namespace
+
+// Folds one more observed shape into the running profiled shape. A
+// dimension already recorded as symbolic stays symbolic; otherwise the
+// new value is added to the set of observations and the dimension either
+// stays specialized (to the latest value) or crosses the threshold and
+// becomes symbolic. A rank mismatch erases the entire shape.
+static c10::VaryingShape mergeObservedShape(
+    const c10::VaryingShape& prev,
+    at::IntArrayRef observed,
+    std::vector<std::vector<int64_t>>& seen,
+    size_t threshold) {
+  const auto& prev_dims = prev.sizes();
+  if (!prev_dims || prev_dims->size() != observed.size()) {
+    return c10::VaryingShape();
+  }
+  c10::VaryingShape::ListOfOptionalInts dims;
+  dims.reserve(observed.size());
+  for (size_t i = 0; i < observed.size(); i++) {
+    if (!(*prev_dims)[i]) {
+      dims.emplace_back(c10::nullopt);
+      continue;
+    }
+    auto& values = seen[i];
+    if (std::find(values.begin(), values.end(), observed[i]) == values.end()) {
+      values.push_back(observed[i]);
+    }
+    if (values.size() >= threshold) {
+      values.clear();
+      dims.emplace_back(c10::nullopt);
+    } else {
+      dims.emplace_back(observed[i]);
+    }
+  }
+  return c10::VaryingShape(std::move(dims));
+}
+
 ProfilingRecord::ProfilingRecord(std::shared_ptr<Graph> g)
-    : profiled_graph_(std::move(g)), profiling_count_(1) {}
+    : profiled_graph_(std::move(g)), profiling_count_(numProfiledRuns()) {}
 
 ProfileOp* ProfilingRecord::createProfileNode(
     const std::function<void(Stack&)>& fp,
@@ -51,18 +137,46 @@ void ProfilingRecord::insertShapeProfile(Node *n, Value *i) {
   auto pno = pn->addOutput();
   bool first = true;
   pno->setType(TensorType::get());
-  std::function<void(Stack &)> shape_profiler = [this, pno,
-                                                 first](Stack &stack) mutable {
+  auto observations = std::make_shared<ShapeObservations>();
+  std::function<void(Stack &)> shape_profiler = [this, pno, first,
+                                                 observations](Stack &stack) mutable {
     IValue t;
     pop(stack, t);
     if (t.isTensor()) {
 
       if (t.toTensor().defined()) {
-        auto pttp = TensorType::create(t.toTensor());
+        auto tensor = t.toTensor();
+        auto pttp = TensorType::create(tensor);
         std::lock_guard<std::mutex> lock(this->mutex_);
         if (auto type = pno->type()->cast<TensorType>()) {
-          if (!first) {
-            pttp = pttp->merge(type);
+          if (first) {
+            observations->sizes.resize(tensor.dim());
+            observations->strides.resize(tensor.dim());
+            for (int64_t d = 0; d < tensor.dim(); d++) {
+              observations->sizes[d].push_back(tensor.size(d));
+              observations->strides[d].push_back(tensor.stride(d));
+            }
+          } else {
+            const size_t threshold = symbolicDimThreshold();
+            // merge handles the scalar components (dtype, device,
+            // requires_grad, undefined); the shape components are redone
+            // below with the distinct-value threshold instead of merge's
+            // erase-on-first-disagreement rule.
+            auto merged = pttp->merge(type);
+            auto sizes = mergeObservedShape(
+                type->sizes(), tensor.sizes(), observations->sizes, threshold);
+            auto strides = mergeObservedShape(
+                type->strides(),
+                tensor.strides(),
+                observations->strides,
+                threshold);
+            pttp = TensorType::create(
+                merged->scalarType(),
+                merged->device(),
+                sizes,
+                strides,
+                merged->requiresGrad(),
+                merged->undefined());
           }
           pno->setType(pttp);
           first = false;
@@ -8,6 +8,7 @@
 #include <torch/csrc/jit/custom_operator.h>
 #include <torch/csrc/jit/fuser/interface.h>
 #include <torch/csrc/jit/graph_executor.h>
+#include <torch/csrc/jit/interpreter.h>
 #include <torch/csrc/jit/ir.h>
 #include <torch/csrc/jit/operator.h>
 #include <torch/csrc/jit/pickle.h>
@@ -1275,7 +1276,13 @@ RegisterOperators reg(
 
              push(stack, forked_interprester.getFuture());
 
-             at::launch(std::move(continuation));
+             if (cooperativeForkEnabled()) {
+               // defer to the forking thread's queue; see
+               // Note [Cooperative fork scheduling] in interpreter.cpp
+               queueForkedTask(std::move(continuation));
+             } else {
+               at::launch(std::move(continuation));
+             }
              return 0;
            };
          },
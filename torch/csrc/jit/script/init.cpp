@@ -708,7 +708,8 @@ void initJitScriptBindings(PyObject* module) {
           })
       .def("apply", &Module::apply)
       .def("_clone", &Module::clone)
-      .def("_clone_instance", &Module::clone_instance);
+      .def("_clone_instance", &Module::clone_instance)
+      .def("_snapshot", &Module::snapshot);
 
   slot_dict_impl<script::detail::ParameterPolicy>::bind(m, "ParameterDict");
   slot_dict_impl<script::detail::BufferPolicy>::bind(m, "BufferDict");
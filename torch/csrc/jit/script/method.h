@@ -31,6 +31,13 @@ struct TORCH_API Method {
       std::vector<c10::IValue> stack,
       const Kwargs& kwargs = Kwargs());
 
+  // Asynchronous counterpart to operator(): the call runs on the JIT
+  // inter-op pool and the returned future completes with the result. The
+  // bound self argument keeps the owning module alive for the duration.
+  c10::intrusive_ptr<c10::ivalue::Future> run_async(
+      std::vector<c10::IValue> stack,
+      const Kwargs& kwargs = Kwargs());
+
   std::shared_ptr<Graph> graph() const {
     return function_->graph();
   }
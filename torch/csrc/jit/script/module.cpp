@@ -116,6 +116,13 @@ IValue Method::operator()(std::vector<IValue> stack, const Kwargs& kwargs) {
   return (*function_)(std::move(stack), kwargs);
 }
 
+c10::intrusive_ptr<c10::ivalue::Future> Method::run_async(
+    std::vector<IValue> stack,
+    const Kwargs& kwargs) {
+  stack.insert(stack.begin(), owner()._ivalue());
+  return function_->runAsync(std::move(stack), kwargs);
+}
+
 void Module::clone_method(
     const Module& orig,
     const Function& method,
@@ -218,6 +225,15 @@ Module Module::clone_instance() const {
   return r;
 }
 
+Module Module::snapshot() const {
+  // The recursive slot-table copy in clone_instance provides exactly the
+  // isolation a snapshot needs: attribute IValues are shared by reference,
+  // but every object in the returned tree has its own slot vector, so
+  // setattr on the original cannot race with attribute reads in the
+  // snapshot.
+  return clone_instance();
+}
+
 void Module::train(bool on) {
   for (Module m : modules()) {
     if (auto slot = m._ivalue()->type()->findAttributeSlot("training")) {
@@ -113,6 +113,11 @@ struct TORCH_API Module : public Object {
     return get_method("forward")(std::move(inputs));
   }
 
+  c10::intrusive_ptr<c10::ivalue::Future> forward_async(
+      std::vector<IValue> inputs) {
+    return get_method("forward").run_async(std::move(inputs));
+  }
+
   // In script modules, buffers are Tensors attribute that are _not_ registered
   // as parameters. This is different than in nn.Module where there is a special
   // register_buffer method. With this simplification, we only need to track
@@ -231,6 +236,21 @@ struct TORCH_API Module : public Object {
   // the current instance, it doesn't create new `ClassType`
   Module clone_instance() const;
 
+  // Returns a snapshot of this module for concurrent execution: a new
+  // instance tree that shares the underlying `ClassType`, methods and
+  // attribute values with this one, but owns its attribute slot tables
+  // throughout. Creating a snapshot only bumps reference counts (no tensor
+  // data is copied), and attribute assignments made afterwards on either
+  // module are invisible to the other, so a server can keep running methods
+  // on a snapshot while the original is updated in place (hot-swap).
+  //
+  // Take the snapshot from the thread performing the updates (or otherwise
+  // ordered after them); attribute assignments concurrent with snapshot
+  // creation itself are not synchronized. In-place mutation of a shared
+  // tensor's data also remains visible on both sides; hot-swap updates
+  // should assign fresh tensors instead.
+  Module snapshot() const;
+
   void clone_method(const Module& orig, const std::string& name);
 
   template <typename... Types>
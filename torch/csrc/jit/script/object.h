@@ -93,6 +93,18 @@ struct TORCH_API Object {
     return get_method(method_name)({IValue(std::forward<Types>(args))...});
   }
 
+  /// Asynchronous version of run_method: the call executes on the JIT
+  /// inter-op pool and the returned future completes with the result (or
+  /// rethrows the method's error from Future::value()), so request handlers
+  /// compose with executor scheduling instead of blocking a caller thread.
+  template <typename... Types>
+  c10::intrusive_ptr<c10::ivalue::Future> run_method_async(
+      const std::string& method_name,
+      Types&&... args) {
+    return get_method(method_name)
+        .run_async({IValue(std::forward<Types>(args))...});
+  }
+
   // so that C++ users can easily add methods
   void define(const std::string& src, const ResolverPtr& resolver = nullptr);
 
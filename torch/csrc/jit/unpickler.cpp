@@ -21,6 +21,10 @@ PicklerClass getClass(const std::string& str) {
     return PicklerClass::DOUBLELIST;
   } else if (str == "build_boollist") {
     return PicklerClass::BOOLLIST;
+  } else if (str == "build_intlist_from_bytes") {
+    return PicklerClass::INTLIST_FROM_BYTES;
+  } else if (str == "build_doublelist_from_bytes") {
+    return PicklerClass::DOUBLELIST_FROM_BYTES;
   }
 
   // TODO [unpickler refactor]
@@ -237,6 +241,26 @@ static IValue toSpecializedList(const IValue& generic) {
   return IValue(std::move(specialized));
 }
 
+// Decode the payload of a bulk-encoded primitive list (see
+// Pickler::pushBulkList): one memcpy of the raw little-endian elements,
+// plus a byte-swap pass on big-endian hosts.
+template <typename T>
+static IValue bulkListFromBytes(const std::string& data) {
+  TORCH_CHECK(
+      data.size() % sizeof(T) == 0,
+      "Bulk list data of ",
+      data.size(),
+      " bytes is not a multiple of the element size ",
+      sizeof(T));
+  std::vector<T> elements(data.size() / sizeof(T));
+  memcpy(elements.data(), data.data(), data.size());
+  if (!isHostLittleEndian()) {
+    swapBulkListBytes(
+        reinterpret_cast<char*>(elements.data()), elements.size());
+  }
+  return IValue(std::move(elements));
+}
+
 static std::vector<int64_t> tupleToIntList(const IValue& v) {
   return fmap(v.toTuple()->elements(), [](const IValue& v) -> int64_t {
     return v.toInt();
@@ -304,6 +328,10 @@ PickleOpCode Unpickler::readInstruction() {
       uint32_t length = read<uint32_t>();
       stack_.emplace_back(readBytes(length));
     } break;
+    case PickleOpCode::BINBYTES8: {
+      uint64_t length = read<uint64_t>();
+      stack_.emplace_back(readBytes(length));
+    } break;
     case PickleOpCode::BINFLOAT:
       stack_.emplace_back(readFloat());
       break;
@@ -423,6 +451,14 @@ PickleOpCode Unpickler::readInstruction() {
             case PicklerClass::BOOLLIST:
               stack_.emplace_back(toSpecializedList<bool>(data));
               break;
+            case PicklerClass::INTLIST_FROM_BYTES:
+              stack_.emplace_back(
+                  bulkListFromBytes<int64_t>(data.toStringRef()));
+              break;
+            case PicklerClass::DOUBLELIST_FROM_BYTES:
+              stack_.emplace_back(
+                  bulkListFromBytes<double>(data.toStringRef()));
+              break;
             default:
               AT_ERROR("Unknown pickler class id");
           }
@@ -0,0 +1,201 @@
+#include <torch/csrc/multiprocessing/pinned_batch_pool.h>
+
+#ifndef _WIN32
+
+#include <c10/util/Exception.h>
+
+#ifdef USE_CUDA
+#include <ATen/Context.h>
+#include <cuda_runtime_api.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace torch {
+namespace multiprocessing {
+
+namespace {
+
+struct Pool {
+  void* base = nullptr;
+  size_t slot_bytes = 0;
+  size_t num_slots = 0;
+  bool pinned = false;
+  bool owner = false;
+};
+
+struct PoolRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, Pool> pools;
+};
+
+PoolRegistry& poolRegistry() {
+  static PoolRegistry registry;
+  return registry;
+}
+
+void checkPoolName(const std::string& name) {
+  TORCH_CHECK(
+      !name.empty() && name[0] == '/' &&
+          name.find('/', 1) == std::string::npos,
+      "pinned batch pool name must be of the form \"/name\", got: ", name);
+}
+
+Pool mapPool(
+    const std::string& name,
+    size_t slot_bytes,
+    size_t num_slots,
+    bool create) {
+  TORCH_CHECK(
+      slot_bytes > 0 && num_slots > 0,
+      "pinned batch pool needs a positive slot size and slot count");
+  size_t total = slot_bytes * num_slots;
+
+  int flags = create ? O_CREAT | O_EXCL | O_RDWR : O_RDWR;
+  int fd = shm_open(name.c_str(), flags, 0600);
+  TORCH_CHECK(
+      fd >= 0,
+      "shm_open failed for pinned batch pool ", name, ": ", strerror(errno));
+  if (create) {
+    if (ftruncate(fd, total) != 0) {
+      int err = errno;
+      close(fd);
+      shm_unlink(name.c_str());
+      TORCH_CHECK(
+          false,
+          "ftruncate failed for pinned batch pool ", name, ": ",
+          strerror(err));
+    }
+  } else {
+    struct stat st {};
+    TORCH_CHECK(
+        fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == total,
+        "pinned batch pool ", name,
+        " does not match the requested geometry; create and attach must "
+        "agree on slot_bytes and num_slots");
+  }
+
+  void* base =
+      mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int err = errno;
+  // The mapping keeps the object alive; the descriptor is no longer needed.
+  close(fd);
+  if (base == MAP_FAILED) {
+    if (create) {
+      shm_unlink(name.c_str());
+    }
+    TORCH_CHECK(
+        false,
+        "mmap failed for pinned batch pool ", name, ": ", strerror(err));
+  }
+
+  Pool pool;
+  pool.base = base;
+  pool.slot_bytes = slot_bytes;
+  pool.num_slots = num_slots;
+  pool.owner = create;
+#ifdef USE_CUDA
+  // Pin once, in the process that will launch H2D copies. Workers write
+  // through their own (unpinned) mapping of the same pages; the copy
+  // engine only cares that the parent's mapping is registered.
+  if (create && at::globalContext().hasCUDA()) {
+    cudaError_t status = cudaHostRegister(base, total, cudaHostRegisterDefault);
+    if (status != cudaSuccess) {
+      cudaGetLastError();
+      munmap(base, total);
+      shm_unlink(name.c_str());
+      TORCH_CHECK(
+          false,
+          "cudaHostRegister failed for pinned batch pool ", name, ": ",
+          cudaGetErrorString(status));
+    }
+    pool.pinned = true;
+  }
+#endif
+  return pool;
+}
+
+Pool& findPool(const std::string& name) {
+  auto& registry = poolRegistry();
+  auto it = registry.pools.find(name);
+  TORCH_CHECK(
+      it != registry.pools.end(),
+      "no pinned batch pool named ", name, " in this process");
+  return it->second;
+}
+
+} // namespace
+
+void createPinnedBatchPool(
+    const std::string& name,
+    size_t slot_bytes,
+    size_t num_slots) {
+  checkPoolName(name);
+  auto& registry = poolRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  TORCH_CHECK(
+      registry.pools.find(name) == registry.pools.end(),
+      "pinned batch pool ", name, " already exists in this process");
+  registry.pools.emplace(name, mapPool(name, slot_bytes, num_slots, true));
+}
+
+void attachPinnedBatchPool(
+    const std::string& name,
+    size_t slot_bytes,
+    size_t num_slots) {
+  checkPoolName(name);
+  auto& registry = poolRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  TORCH_CHECK(
+      registry.pools.find(name) == registry.pools.end(),
+      "pinned batch pool ", name, " already exists in this process");
+  registry.pools.emplace(name, mapPool(name, slot_bytes, num_slots, false));
+}
+
+void* pinnedBatchPoolSlot(const std::string& name, size_t index) {
+  auto& registry = poolRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  Pool& pool = findPool(name);
+  TORCH_CHECK(
+      index < pool.num_slots,
+      "pinned batch pool ", name, " has ", pool.num_slots,
+      " slots; slot ", index, " requested");
+  return static_cast<char*>(pool.base) + index * pool.slot_bytes;
+}
+
+size_t pinnedBatchPoolSlotBytes(const std::string& name) {
+  auto& registry = poolRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return findPool(name).slot_bytes;
+}
+
+void destroyPinnedBatchPool(const std::string& name) {
+  auto& registry = poolRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  Pool pool = findPool(name);
+  registry.pools.erase(name);
+#ifdef USE_CUDA
+  if (pool.pinned) {
+    // Any in-flight H2D copy from these pages must have drained before
+    // teardown; the DataLoader shuts its prefetch queues down first.
+    cudaHostUnregister(pool.base);
+  }
+#endif
+  munmap(pool.base, pool.slot_bytes * pool.num_slots);
+  if (pool.owner) {
+    shm_unlink(name.c_str());
+  }
+}
+
+} // namespace multiprocessing
+} // namespace torch
+
+#endif // !_WIN32
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstddef>
+#include <string>
+
+namespace torch {
+namespace multiprocessing {
+
+// A named pool of fixed-size batch slots backed by POSIX shared memory.
+//
+// DataLoader workers traditionally copy each batch into worker-side shm,
+// the parent copies it out, pin_memory copies it into pinned staging, and
+// only then does the H2D transfer run -- three host copies per batch. The
+// pool collapses those: the parent creates the pool and (when CUDA is
+// available) cudaHostRegisters the whole mapping once, workers attach to
+// the same shm and collate batches directly into a slot, and the parent
+// launches the H2D copy from the very same pages. One copy total.
+//
+// Slot hand-off (which slot is filled, which is free) stays with the
+// existing DataLoader worker queues; this layer only owns the mapping and
+// its lifetime. Workers forked after create() inherit the mapping and may
+// skip attach(). All calls throw on failure. POSIX only.
+TORCH_API void createPinnedBatchPool(
+    const std::string& name,
+    size_t slot_bytes,
+    size_t num_slots);
+
+TORCH_API void attachPinnedBatchPool(
+    const std::string& name,
+    size_t slot_bytes,
+    size_t num_slots);
+
+// Base address of slot `index` in an attached or created pool.
+TORCH_API void* pinnedBatchPoolSlot(const std::string& name, size_t index);
+
+TORCH_API size_t pinnedBatchPoolSlotBytes(const std::string& name);
+
+// Unmaps (and in the creating process: unregisters and unlinks) the pool.
+TORCH_API void destroyPinnedBatchPool(const std::string& name);
+
+} // namespace multiprocessing
+} // namespace torch
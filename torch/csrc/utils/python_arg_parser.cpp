@@ -132,6 +132,136 @@ FunctionParameter::FunctionParameter(const std::string& fmt, bool keyword_only)
   }
 }
 
+// Note [Python binding fast path]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Small eager ops are dominated by binding overhead, and most calls look
+// like f(tensor, tensor) or f(tensor, number) with no keyword arguments.
+// For those, the generic parse below does per-signature work (keyword
+// dict probes, varargs handling, error bookkeeping) that can be skipped:
+// each positional argument is classified once into a coarse class
+// (tensor / bool / int / float / complex / None), and each parameter
+// precomputes two masks over those classes:
+//
+//   fast_accept_mask:  classes for which check() is known to return true,
+//                      so the slot can be filled directly;
+//   fast_inexact_mask: classes for which only the full parse can decide
+//                      (e.g. a zero-dim tensor passed for a Scalar, or an
+//                      int for a varargs IntArrayRef).
+//
+// parse_fast() walks the signatures in the same order as the generic
+// path, so a fast match is exactly the overload the generic path would
+// have chosen: every earlier signature was rejected for a reason the
+// masks decide exactly. The moment any decision would need the full
+// check() semantics, the whole call falls back to the generic path.
+// Arguments outside the coarse classes (lists, dtypes, strings, numpy
+// scalars, ...) never enter the fast path at all.
+namespace {
+
+enum FastArgClass : uint8_t {
+  kFastTensor = 1,
+  kFastBool = 2,
+  kFastInt = 4,
+  kFastFloat = 8,
+  kFastComplex = 16,
+  kFastNone = 32,
+};
+
+constexpr uint8_t kFastAllClasses =
+    kFastTensor | kFastBool | kFastInt | kFastFloat | kFastComplex | kFastNone;
+constexpr uint8_t kFastNumbers = kFastBool | kFastInt | kFastFloat;
+
+// Returns 0 when the object does not fall into any fast class.
+inline uint8_t classifyFastArg(PyObject* obj) {
+  if (THPVariable_Check(obj)) {
+    return kFastTensor;
+  }
+  if (obj == Py_None) {
+    return kFastNone;
+  }
+  if (PyBool_Check(obj)) {
+    return kFastBool;
+  }
+  if (PyLong_Check(obj)) {
+    return kFastInt;
+  }
+  if (PyFloat_Check(obj)) {
+    return kFastFloat;
+  }
+  if (PyComplex_Check(obj)) {
+    return kFastComplex;
+  }
+  return 0;
+}
+
+} // namespace
+
+void FunctionParameter::compute_fast_masks() {
+  // The masks must mirror check() exactly for every accepted class; when in
+  // doubt a class belongs in the inexact mask, which routes the call to the
+  // full parse.
+  switch (type_) {
+    case ParameterType::TENSOR:
+      fast_accept_mask = kFastTensor;
+      if (allow_numbers_as_tensors) {
+        // THPUtils_checkScalar: any Python number, including bool.
+        fast_accept_mask |= kFastNumbers | kFastComplex;
+      }
+      break;
+    case ParameterType::SCALAR:
+    case ParameterType::COMPLEX:
+      fast_accept_mask = kFastNumbers | kFastComplex;
+      // Zero-dim tensors are accepted depending on requires_grad.
+      fast_inexact_mask = kFastTensor;
+      break;
+    case ParameterType::DOUBLE:
+      // THPUtils_checkDouble: float or any int, including bool.
+      fast_accept_mask = kFastNumbers;
+      fast_inexact_mask = kFastTensor;
+      break;
+    case ParameterType::INT64:
+      // THPUtils_checkLong excludes bool.
+      fast_accept_mask = kFastInt;
+      fast_inexact_mask = kFastTensor;
+      break;
+    case ParameterType::BOOL:
+      fast_accept_mask = kFastBool;
+      break;
+    case ParameterType::INT_LIST:
+      // A lone integer is accepted for sized lists, and the varargs
+      // IntArrayRef form accepts anything indexable (including zero-dim
+      // tensors); both need the full parse.
+      fast_inexact_mask = kFastTensor | kFastBool | kFastInt;
+      break;
+    case ParameterType::DEVICE:
+      // THPUtils_checkLong: a bare device index.
+      fast_accept_mask = kFastInt;
+      break;
+    case ParameterType::PYOBJECT:
+      fast_accept_mask = kFastAllClasses & ~kFastNone;
+      fast_inexact_mask = kFastNone;
+      break;
+    case ParameterType::TENSOR_LIST:
+    case ParameterType::GENERATOR:
+    case ParameterType::STORAGE:
+    case ParameterType::SCALARTYPE:
+    case ParameterType::LAYOUT:
+    case ParameterType::MEMORY_FORMAT:
+    case ParameterType::QSCHEME:
+    case ParameterType::STRING:
+#ifdef BUILD_NAMEDTENSOR
+    case ParameterType::DIMNAME:
+    case ParameterType::DIMNAME_LIST:
+#endif
+      // check() rejects every fast class for these, so a zero accept mask
+      // is a definite mismatch.
+      break;
+    default:
+      // Unknown type: never decide in the fast path.
+      fast_inexact_mask = kFastAllClasses;
+      break;
+  }
+}
+
 bool FunctionParameter::check(PyObject* obj) {
   switch (type_) {
     case ParameterType::TENSOR: {
@@ -363,6 +493,9 @@ FunctionSignature::FunctionSignature(const std::string& fmt)
     } else {
       params.emplace_back(param_str, keyword_only);
       params.back().allow_numbers_as_tensors = allow_numbers_as_tensors;
+      // See Note [Python binding fast path]; depends on
+      // allow_numbers_as_tensors, so computed after it is set.
+      params.back().compute_fast_masks();
     }
   }
 
@@ -578,6 +711,43 @@ bool FunctionSignature::parse(PyObject* args, PyObject* kwargs, PyObject* dst[],
   return true;
 }
 
+// See Note [Python binding fast path].
+int FunctionSignature::parse_fast(PyObject* args, ssize_t nargs, const uint8_t* arg_classes, PyObject* dst[]) {
+  if (nargs > max_pos_args) {
+    // The varargs IntArrayRef form can still accept extra positional ints.
+    if (max_pos_args == 1 && !params.empty() &&
+        params[0].type_ == ParameterType::INT_LIST) {
+      return -1;
+    }
+    return 0;
+  }
+  size_t i = 0;
+  for (; i < static_cast<size_t>(nargs); i++) {
+    auto& param = params[i];
+    uint8_t cls = arg_classes[i];
+    if (cls == kFastNone && param.allow_none) {
+      dst[i] = nullptr;
+      continue;
+    }
+    if (param.fast_accept_mask & cls) {
+      dst[i] = PyTuple_GET_ITEM(args, i);
+      continue;
+    }
+    if (param.fast_inexact_mask & cls) {
+      return -1;
+    }
+    return 0;
+  }
+  for (; i < params.size(); i++) {
+    if (!params[i].optional) {
+      // Missing a required argument (possibly keyword-only).
+      return 0;
+    }
+    dst[i] = nullptr;
+  }
+  return 1;
+}
+
 PythonArgParser::PythonArgParser(std::vector<std::string> fmts, bool traceable)
  : max_args(0)
  , traceable(traceable)
@@ -596,6 +766,39 @@ PythonArgParser::PythonArgParser(std::vector<std::string> fmts, bool traceable)
 }
 
 PythonArgs PythonArgParser::raw_parse(PyObject* args, PyObject* kwargs, PyObject* parsed_args[]) {
+  // See Note [Python binding fast path].
+  constexpr ssize_t kFastPathMaxArgs = 8;
+  if (!kwargs) {
+    ssize_t nargs = PyTuple_GET_SIZE(args);
+    if (nargs <= kFastPathMaxArgs) {
+      uint8_t arg_classes[kFastPathMaxArgs];
+      bool classified = true;
+      for (ssize_t i = 0; i < nargs; i++) {
+        arg_classes[i] = classifyFastArg(PyTuple_GET_ITEM(args, i));
+        if (arg_classes[i] == 0) {
+          classified = false;
+          break;
+        }
+      }
+      if (classified) {
+        int i = 0;
+        for (auto& signature : signatures_) {
+          int result = signature.parse_fast(args, nargs, arg_classes, parsed_args);
+          if (result > 0) {
+            return PythonArgs(i, traceable, signature, parsed_args);
+          }
+          if (result < 0) {
+            // Only the generic parse can decide this call.
+            break;
+          }
+          i++;
+        }
+        // No definite fast match: the generic path below either finds the
+        // overload via its richer coercions or raises the proper error.
+      }
+    }
+  }
+
   if (signatures_.size() == 1) {
     auto& signature = signatures_[0];
     signature.parse(args, kwargs, parsed_args, true);
@@ -69,6 +69,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -172,6 +173,11 @@ struct FunctionSignature {
   explicit FunctionSignature(const std::string& fmt);
 
   bool parse(PyObject* args, PyObject* kwargs, PyObject* dst[], bool raise_exception);
+  // Fast positional-only matcher; see Note [Python binding fast path] in
+  // python_arg_parser.cpp. `arg_classes` holds the precomputed class of
+  // each positional argument. Returns 1 on a definite match (dst filled),
+  // 0 on a definite mismatch, and -1 when only the full parse can decide.
+  int parse_fast(PyObject* args, ssize_t nargs, const uint8_t* arg_classes, PyObject* dst[]);
   std::string toString() const;
 
   std::string name;
@@ -189,8 +195,15 @@ struct FunctionParameter {
   bool check(PyObject* obj);
   void set_default_str(const std::string& str);
   std::string type_name() const;
+  // Precomputes fast_accept_mask / fast_inexact_mask; see
+  // Note [Python binding fast path] in python_arg_parser.cpp.
+  void compute_fast_masks();
 
   ParameterType type_;
+  // Argument classes check() definitely accepts / can only decide on via
+  // the full parse. See Note [Python binding fast path].
+  uint8_t fast_accept_mask = 0;
+  uint8_t fast_inexact_mask = 0;
   bool optional;
   bool allow_none;
   bool keyword_only;
@@ -1,5 +1,8 @@
 # These functions are referenced from the pickle archives produced by
 # ScriptModule.save()
+import array
+import sys
+
 
 def build_intlist(data):
     return data
@@ -17,6 +20,24 @@ def build_boollist(data):
     return data
 
 
+def _build_list_from_bytes(typecode, data):
+    # Bulk-encoded lists carry their elements as a single byte string of raw
+    # little-endian values (see torch/csrc/jit/pickler.h)
+    elements = array.array(typecode)
+    elements.frombytes(data)
+    if sys.byteorder != 'little':
+        elements.byteswap()
+    return elements.tolist()
+
+
+def build_intlist_from_bytes(data):
+    return _build_list_from_bytes('q', data)
+
+
+def build_doublelist_from_bytes(data):
+    return _build_list_from_bytes('d', data)
+
+
 def build_tensor_from_id(data):
     if isinstance(data, int):
         # just the id, can't really do anything
@@ -74,9 +74,31 @@ int64_t HashStore::add(const std::string& key, int64_t i) {
   auto str = std::to_string(ti);
   const uint8_t* strB = reinterpret_cast<const uint8_t*>(str.c_str());
   map_[key] = std::vector<uint8_t>(strB, strB + str.size());
+  cv_.notify_all();
   return ti;
 }
 
+void HashStore::waitCounter(const std::string& key, int64_t value) {
+  auto pred = [&]() {
+    auto it = map_.find(key);
+    if (it == map_.end() || it->second.empty()) {
+      return false;
+    }
+    auto buf = reinterpret_cast<const char*>(it->second.data());
+    return std::stoll(std::string(buf, it->second.size())) >= value;
+  };
+
+  std::unique_lock<std::mutex> lock(m_);
+  if (timeout_ == kNoTimeout) {
+    cv_.wait(lock, pred);
+  } else {
+    if (!cv_.wait_for(lock, timeout_, pred)) {
+      throw std::system_error(
+          ETIMEDOUT, std::system_category(), "Wait timeout");
+    }
+  }
+}
+
 bool HashStore::check(const std::vector<std::string>& keys) {
   std::unique_lock<std::mutex> lock(m_);
   for (const auto& key : keys) {
@@ -87,4 +109,15 @@ bool HashStore::check(const std::vector<std::string>& keys) {
   return true;
 }
 
+std::vector<std::string> HashStore::scan(const std::string& prefix) {
+  std::unique_lock<std::mutex> lock(m_);
+  std::vector<std::string> keys;
+  for (const auto& kv : map_) {
+    if (kv.first.compare(0, prefix.size(), prefix) == 0) {
+      keys.push_back(kv.first);
+    }
+  }
+  return keys;
+}
+
 } // namespace c10d
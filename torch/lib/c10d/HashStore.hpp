@@ -30,6 +30,10 @@ class HashStore : public Store {
 
   bool check(const std::vector<std::string>& keys) override;
 
+  void waitCounter(const std::string& key, int64_t value) override;
+
+  std::vector<std::string> scan(const std::string& prefix) override;
+
  protected:
   std::unordered_map<std::string, std::vector<uint8_t>> map_;
   std::mutex m_;
@@ -50,4 +50,28 @@ void PrefixStore::wait(
   store_.wait(joinedKeys, timeout);
 }
 
+void PrefixStore::waitCounter(const std::string& key, int64_t value) {
+  store_.waitCounter(joinKey(key), value);
+}
+
+void PrefixStore::multiSet(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<uint8_t>>& values) {
+  store_.multiSet(joinKeys(keys), values);
+}
+
+std::vector<std::vector<uint8_t>> PrefixStore::multiGet(
+    const std::vector<std::string>& keys) {
+  return store_.multiGet(joinKeys(keys));
+}
+
+std::vector<std::string> PrefixStore::scan(const std::string& prefix) {
+  const std::string joined = prefix_ + "/";
+  auto keys = store_.scan(joined + prefix);
+  for (auto& key : keys) {
+    key = key.substr(joined.size());
+  }
+  return keys;
+}
+
 } // namespace c10d
@@ -24,6 +24,17 @@ class PrefixStore : public Store {
       const std::vector<std::string>& keys,
       const std::chrono::milliseconds& timeout) override;
 
+  void waitCounter(const std::string& key, int64_t value) override;
+
+  void multiSet(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<uint8_t>>& values) override;
+
+  std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys) override;
+
+  std::vector<std::string> scan(const std::string& prefix) override;
+
  protected:
   std::string prefix_;
   Store& store_;
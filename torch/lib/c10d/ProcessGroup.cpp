@@ -1,5 +1,6 @@
 #include <c10d/ProcessGroup.hpp>
 
+#include <ATen/core/jit_type.h>
 #include <c10/util/Logging.h>
 
 namespace c10d {
@@ -48,12 +49,66 @@ void ProcessGroup::Work::abort() {
   TORCH_CHECK(false, "ProcessGroup::Work::abort not implemented.")
 }
 
+void ProcessGroup::Work::addCallback(std::function<void(Work&)> callback) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (completed_) {
+    lock.unlock();
+    callback(*this);
+    return;
+  }
+  callbacks_.push_back(std::move(callback));
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> ProcessGroup::Work::getFuture() {
+  auto future = c10::make_intrusive<c10::ivalue::Future>(
+      c10::ListType::ofTensors());
+  addCallback([future](Work& work) {
+    if (!work.isSuccess()) {
+      try {
+        std::rethrow_exception(work.exception());
+      } catch (const std::exception& e) {
+        future->markCompleted(
+            c10::ivalue::Future::FutureError(std::string(e.what())));
+      } catch (...) {
+        future->markCompleted(c10::ivalue::Future::FutureError(
+            std::string("unknown error in process group work")));
+      }
+      return;
+    }
+    std::vector<at::Tensor> result;
+    try {
+      result = work.result();
+    } catch (const std::exception&) {
+      // Not every operation carries result tensors; complete with an
+      // empty list so awaiters can proceed.
+    }
+    future->markCompleted(at::IValue(std::move(result)));
+  });
+  return future;
+}
+
 void ProcessGroup::Work::finish(std::exception_ptr exception) {
   std::unique_lock<std::mutex> lock(mutex_);
   completed_ = true;
   exception_ = exception;
+  std::vector<std::function<void(Work&)>> callbacks;
+  callbacks.swap(callbacks_);
   lock.unlock();
   cv_.notify_all();
+  for (auto& callback : callbacks) {
+    callback(*this);
+  }
+}
+
+void ProcessGroup::Work::runCallbacks() {
+  std::vector<std::function<void(Work&)>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbacks.swap(callbacks_);
+  }
+  for (auto& callback : callbacks) {
+    callback(*this);
+  }
 }
 
 ProcessGroup::ProcessGroup(int rank, int size) : rank_(rank), size_(size) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -8,6 +9,7 @@
 #include <vector>
 
 #include <ATen/ATen.h>
+#include <ATen/core/ivalue.h>
 
 #include <c10d/Types.hpp>
 
@@ -87,13 +89,34 @@ class ProcessGroup {
 
     virtual void abort();
 
+    // Registers a callback that runs once when the work completes,
+    // successfully or not. Callbacks are invoked from the thread that marks
+    // the work completed (the backend's worker or watchdog thread), so they
+    // must be brief and must not block or enqueue collectives on the same
+    // process group. If the work has already completed, the callback runs
+    // immediately on the calling thread. The callback may inspect the
+    // completion state through the passed work, but must not call wait().
+    virtual void addCallback(std::function<void(Work&)> callback);
+
+    // Returns a future tracking this work. It is completed with the result
+    // tensors (or an empty list if the operation carries no result) when
+    // the work succeeds, and with the work's error if it fails. This lets
+    // callers chain computation onto communication without dedicating a
+    // waiter thread, and lets TorchScript await communication ops.
+    virtual c10::intrusive_ptr<c10::ivalue::Future> getFuture();
+
    protected:
     void finish(std::exception_ptr exception = nullptr);
 
+    // Invokes and clears accumulated callbacks. Must be called after
+    // completion has been recorded, without holding mutex_.
+    void runCallbacks();
+
     mutable std::mutex mutex_;
     std::condition_variable cv_;
     bool completed_ = false;
     std::exception_ptr exception_;
+    std::vector<std::function<void(Work&)>> callbacks_;
   };
 
   explicit ProcessGroup(int rank, int size);
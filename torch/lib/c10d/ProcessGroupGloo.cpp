@@ -5,6 +5,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cstdlib>
 #include <type_traits>
 
 #include <gloo/allgather.h>
@@ -361,6 +362,8 @@ bool ProcessGroupGloo::SendWork::wait() {
   }
 
   completed_ = true;
+  lock.unlock();
+  runCallbacks();
   if (exception_) {
     std::rethrow_exception(exception_);
   }
@@ -391,6 +394,8 @@ bool ProcessGroupGloo::RecvWork::wait() {
   }
 
   completed_ = true;
+  lock.unlock();
+  runCallbacks();
   if (exception_) {
     std::rethrow_exception(exception_);
   }
@@ -966,6 +971,20 @@ class AsyncSparseAllreduceWork : public ProcessGroupGloo::AsyncWork {
     int64_t* data_;
   };
 
+  // When set (GLOO_SPARSE_ALLREDUCE_BUCKETED=1), sparse allreduce shuffles
+  // each nonzero to the single rank owning its dim-0 index range, reduces
+  // there, and allgathers only the reduced result, instead of allgathering
+  // every rank's full indices/values. For gradients with overlapping indices
+  // (e.g. embedding updates with hot rows) this ships the duplicates once
+  // rather than world-size times.
+  static bool bucketedEnabled() {
+    static const bool enabled = []() {
+      const char* val = getenv("GLOO_SPARSE_ALLREDUCE_BUCKETED");
+      return val != nullptr && std::string(val) == "1";
+    }();
+    return enabled;
+  }
+
   // Sparse allreduce is implemented with allgather on indices and values.
   // Every process then sums the resulting sparse tensors locally.
   // The nnz for sparse tensors may be different across processes, so first
@@ -1005,6 +1024,10 @@ class AsyncSparseAllreduceWork : public ProcessGroupGloo::AsyncWork {
       }
     }
 
+    if (bucketedEnabled() && context->size > 1 && input.size(0) > 0) {
+      return allreduce_bucketed(input);
+    }
+
     // Gather all indices and all values.
     auto indices = allgather_indices(input, metadata);
     auto values = allgather_values(input, metadata);
@@ -1042,6 +1065,147 @@ class AsyncSparseAllreduceWork : public ProcessGroupGloo::AsyncWork {
   }
 
  private:
+  // Bucketed sparse allreduce: rank r owns the contiguous dim-0 index range
+  // [r * rowsPerRank, (r + 1) * rowsPerRank). Every rank ships each of its
+  // nonzeros to the owner of its row (the input is coalesced, so the
+  // nonzeros destined for one owner already form a contiguous run), the
+  // owner reduces its bucket, and the reduced buckets are allgathered. The
+  // per-rank bucket nnz counts are exchanged up front so all receive sizes
+  // are known.
+  at::Tensor allreduce_bucketed(const at::Tensor& input) {
+    const auto size = context->size;
+    const auto rank = context->rank;
+    const auto sparseDim = input.sparse_dim();
+    const int64_t rowsPerRank = (input.size(0) + size - 1) / size;
+
+    auto indices = input.indices().contiguous();
+    auto values = input.values().contiguous();
+    const int64_t nnz = input._nnz();
+
+    const auto valueShape = input.sizes().slice(sparseDim);
+    int64_t denseNumel = 1;
+    for (auto dim : valueShape) {
+      denseNumel *= dim;
+    }
+
+    // Per-destination nnz counts. indices is sparseDim x nnz and contiguous,
+    // so its first nnz elements are the (sorted) dim-0 indices.
+    std::vector<int64_t> sendCounts(size, 0);
+    const int64_t* rows = indices.data_ptr<int64_t>();
+    for (int64_t i = 0; i < nnz; i++) {
+      const auto owner = std::min<int64_t>(rows[i] / rowsPerRank, size - 1);
+      sendCounts[owner]++;
+    }
+    std::vector<int64_t> sendOffsets(size, 0);
+    for (auto i = 1; i < size; i++) {
+      sendOffsets[i] = sendOffsets[i - 1] + sendCounts[i - 1];
+    }
+
+    // Exchange the full [src][dst] nnz split matrix.
+    auto splitBuffer = at::zeros({size, size}, at::kLong);
+    auto* splitData = splitBuffer.data_ptr<int64_t>();
+    std::copy(sendCounts.begin(), sendCounts.end(), splitData + rank * size);
+    {
+      gloo::AllgatherOptions opts(context);
+      opts.setOutput(splitData, splitBuffer.numel());
+      opts.setTag(tag);
+      gloo::allgather(opts);
+    }
+
+    // Receive layout of this rank's bucket, ordered by source rank.
+    std::vector<int64_t> recvCounts(size, 0);
+    std::vector<int64_t> recvOffsets(size, 0);
+    int64_t totalRecv = 0;
+    for (auto i = 0; i < size; i++) {
+      recvCounts[i] = splitData[i * size + rank];
+      recvOffsets[i] = totalRecv;
+      totalRecv += recvCounts[i];
+    }
+
+    // Transpose indices so each destination's slice is contiguous.
+    auto indicesT = indices.t().contiguous(); // nnz x sparseDim
+    auto values2d = values.reshape({nnz, denseNumel}).contiguous();
+
+    auto recvIndices = at::empty({totalRecv, sparseDim}, at::kLong);
+    auto recvValues = at::empty({totalRecv, denseNumel}, values.options());
+
+    exchange_buckets(
+        indicesT, recvIndices, sendCounts, sendOffsets, recvCounts, recvOffsets);
+    exchange_buckets(
+        values2d, recvValues, sendCounts, sendOffsets, recvCounts, recvOffsets);
+
+    // Reduce this rank's bucket.
+    std::vector<int64_t> bucketValueShape = {totalRecv};
+    for (auto dim : valueShape) {
+      bucketValueShape.push_back(dim);
+    }
+    auto bucket = at::sparse_coo_tensor(
+        recvIndices.t().contiguous(),
+        recvValues.reshape(bucketValueShape),
+        input.sizes(),
+        input.options());
+    bucket = bucket.coalesce();
+
+    // Allgather the reduced buckets. Buckets own disjoint index ranges, so
+    // concatenation plus a final coalesce (for ordering) yields the result.
+    auto metadata = allgather_metadata(bucket);
+    auto indicesPerRank = allgather_indices(bucket, metadata);
+    auto valuesPerRank = allgather_values(bucket, metadata);
+    auto output = at::sparse_coo_tensor(
+        at::cat(indicesPerRank, 1),
+        at::cat(valuesPerRank, 0),
+        input.sizes(),
+        input.options());
+    return output.coalesce();
+  }
+
+  // Sends the per-destination row slices of `send` (2-d, contiguous) to
+  // their owners and receives this rank's bucket into `recv`, with counts
+  // and offsets in rows. The local slice is copied directly.
+  void exchange_buckets(
+      const at::Tensor& send,
+      at::Tensor& recv,
+      const std::vector<int64_t>& sendCounts,
+      const std::vector<int64_t>& sendOffsets,
+      const std::vector<int64_t>& recvCounts,
+      const std::vector<int64_t>& recvOffsets) {
+    const auto size = context->size;
+    const auto rank = context->rank;
+    const int64_t rowBytes = send.size(1) * send.element_size();
+
+    std::vector<std::unique_ptr<::gloo::transport::UnboundBuffer>> sendBuffers;
+    std::vector<std::unique_ptr<::gloo::transport::UnboundBuffer>> recvBuffers;
+    auto* sendData = static_cast<char*>(send.data_ptr());
+    auto* recvData = static_cast<char*>(recv.data_ptr());
+    for (auto i = 0; i < size; i++) {
+      if (i == rank) {
+        continue;
+      }
+      if (recvCounts[i] > 0) {
+        auto buf = context->createUnboundBuffer(
+            recvData + recvOffsets[i] * rowBytes, recvCounts[i] * rowBytes);
+        buf->recv(i, tag);
+        recvBuffers.push_back(std::move(buf));
+      }
+      if (sendCounts[i] > 0) {
+        auto buf = context->createUnboundBuffer(
+            sendData + sendOffsets[i] * rowBytes, sendCounts[i] * rowBytes);
+        buf->send(i, tag);
+        sendBuffers.push_back(std::move(buf));
+      }
+    }
+    if (sendCounts[rank] > 0) {
+      recv.narrow(0, recvOffsets[rank], recvCounts[rank])
+          .copy_(send.narrow(0, sendOffsets[rank], sendCounts[rank]));
+    }
+    for (auto& buf : sendBuffers) {
+      buf->waitSend();
+    }
+    for (auto& buf : recvBuffers) {
+      buf->waitRecv();
+    }
+  }
+
   std::vector<SparseTensorMetadata> allgather_metadata(
       const at::Tensor& tensor) {
     auto buffer =
@@ -124,6 +124,8 @@ bool ProcessGroupMPI::AsyncWork::isCompleted() {
   if (status_.MPI_ERROR != MPI_SUCCESS) {
     populateException();
   }
+  globalLock.unlock();
+  runCallbacks();
 
   return true;
 }
@@ -151,6 +153,10 @@ bool ProcessGroupMPI::AsyncWork::wait() {
   auto ok = (status_.MPI_ERROR == MPI_SUCCESS);
   if (!ok) {
     populateException();
+  }
+  globalLock.unlock();
+  runCallbacks();
+  if (!ok) {
     std::rethrow_exception(exception_);
   }
   // Always return true, because abort API is not implemented.
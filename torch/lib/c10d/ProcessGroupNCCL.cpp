@@ -1,5 +1,8 @@
 #include <c10d/ProcessGroupNCCL.hpp>
 
+#include <unistd.h>
+
+#include <algorithm>
 #include <map>
 #include <tuple>
 #include <unordered_set>
@@ -112,6 +115,7 @@ void syncStreams(
 } // namespace
 
 const int64_t ProcessGroupNCCL::kWatchdogThreadSleepMillis = 100;
+const int64_t ProcessGroupNCCL::kOutstandingWorkSleepMillis = 5;
 constexpr int64_t kSynchronizeBusyWaitMillis = 10;
 const int64_t ProcessGroupNCCL::kProcessGroupNCCLOpTimeoutMillis = 10 * 1000;
 
@@ -223,6 +227,55 @@ void ProcessGroupNCCL::WorkNCCL::abort() {
   TORCH_CHECK(false, "ProcessGroupNCCL::WorkNCCL::abort not implemented.");
 }
 
+bool ProcessGroupNCCL::WorkNCCL::timingEnabled() const {
+  return timingEnabled_;
+}
+
+float ProcessGroupNCCL::WorkNCCL::getEnqueueTime() const {
+  TORCH_CHECK(
+      timingEnabled_,
+      "Timing records were not collected for this work; set ",
+      NCCL_COLLECTIVE_TIMING,
+      "=1 to enable them.");
+  return enqueueTimeMs_;
+}
+
+std::vector<float> ProcessGroupNCCL::WorkNCCL::getStartTimes() const {
+  TORCH_CHECK(
+      timingEnabled_,
+      "Timing records were not collected for this work; set ",
+      NCCL_COLLECTIVE_TIMING,
+      "=1 to enable them.");
+  std::vector<float> times;
+  times.reserve(devices_.size());
+  std::lock_guard<std::mutex> lock(timingEpoch_->mutex);
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    const auto index = devices_[i].index();
+    times.push_back(
+        timingEpoch_->gpuEpochOffsetMs.at(index) +
+        timingEpoch_->gpuEpochs.at(index).elapsed_time(startEvents_[i]));
+  }
+  return times;
+}
+
+std::vector<float> ProcessGroupNCCL::WorkNCCL::getEndTimes() const {
+  TORCH_CHECK(
+      timingEnabled_,
+      "Timing records were not collected for this work; set ",
+      NCCL_COLLECTIVE_TIMING,
+      "=1 to enable them.");
+  std::vector<float> times;
+  times.reserve(devices_.size());
+  std::lock_guard<std::mutex> lock(timingEpoch_->mutex);
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    const auto index = devices_[i].index();
+    times.push_back(
+        timingEpoch_->gpuEpochOffsetMs.at(index) +
+        timingEpoch_->gpuEpochs.at(index).elapsed_time(endEvents_[i]));
+  }
+  return times;
+}
+
 ProcessGroupNCCL::ProcessGroupNCCL(
     const std::shared_ptr<Store>& store,
     int rank,
@@ -252,6 +305,65 @@ ProcessGroupNCCL::ProcessGroupNCCL(
         std::string(NCCL_BLOCKING_WAIT));
   }
 
+  char* hierarchicalAllreduce = getenv(NCCL_HIERARCHICAL_ALLREDUCE);
+  try {
+    if (hierarchicalAllreduce != nullptr) {
+      auto val = std::stoi(hierarchicalAllreduce);
+      if (val == 1) {
+        // Use the hierarchical allreduce algorithm when applicable.
+        hierarchicalAllreduce_ = true;
+      } else if (val != 0) {
+        throw std::runtime_error(
+            "Invalid value for environment variable: " +
+            std::string(NCCL_HIERARCHICAL_ALLREDUCE));
+      }
+    }
+  } catch (std::exception& e) {
+    throw std::runtime_error(
+        "Invalid value for environment variable: " +
+        std::string(NCCL_HIERARCHICAL_ALLREDUCE));
+  }
+
+  char* highPriorityStreams = getenv(NCCL_HIGH_PRIORITY_STREAMS);
+  try {
+    if (highPriorityStreams != nullptr) {
+      auto val = std::stoi(highPriorityStreams);
+      if (val == 1) {
+        // Take the NCCL streams from the high priority stream pool.
+        isHighPriorityStream_ = true;
+      } else if (val != 0) {
+        throw std::runtime_error(
+            "Invalid value for environment variable: " +
+            std::string(NCCL_HIGH_PRIORITY_STREAMS));
+      }
+    }
+  } catch (std::exception& e) {
+    throw std::runtime_error(
+        "Invalid value for environment variable: " +
+        std::string(NCCL_HIGH_PRIORITY_STREAMS));
+  }
+
+  char* collectiveTiming = getenv(NCCL_COLLECTIVE_TIMING);
+  try {
+    if (collectiveTiming != nullptr) {
+      auto val = std::stoi(collectiveTiming);
+      if (val == 1) {
+        // Collect per-work timing records.
+        collectiveTiming_ = true;
+        timingEpoch_ = std::make_shared<TimingEpoch>();
+        timingEpoch_->cpuEpoch = std::chrono::steady_clock::now();
+      } else if (val != 0) {
+        throw std::runtime_error(
+            "Invalid value for environment variable: " +
+            std::string(NCCL_COLLECTIVE_TIMING));
+      }
+    }
+  } catch (std::exception& e) {
+    throw std::runtime_error(
+        "Invalid value for environment variable: " +
+        std::string(NCCL_COLLECTIVE_TIMING));
+  }
+
 #ifdef ENABLE_NCCL_ERROR_CHECKING
   ncclCommWatchdogThread_ =
       std::thread(&ProcessGroupNCCL::ncclCommWatchdog, this);
@@ -300,14 +412,62 @@ void ProcessGroupNCCL::ncclCommWatchdog() {
       }
     }
 
+    pollOutstandingWork();
+
+    bool hasOutstandingWork;
+    {
+      std::lock_guard<std::mutex> lock(outstandingWorkMutex_);
+      hasOutstandingWork = !outstandingWork_.empty();
+    }
+
     std::unique_lock<std::mutex> lock(watchdogCVMutex_);
     watchdogCV_.wait_for(
         lock,
-        std::chrono::milliseconds(kWatchdogThreadSleepMillis),
+        std::chrono::milliseconds(
+            hasOutstandingWork ? kOutstandingWorkSleepMillis
+                               : kWatchdogThreadSleepMillis),
         [&]() -> bool { return terminateWatchdog_.load(); });
   }
 }
 
+void ProcessGroupNCCL::registerOutstandingWork(
+    const std::shared_ptr<WorkNCCL>& work) {
+  {
+    std::lock_guard<std::mutex> lock(outstandingWorkMutex_);
+    outstandingWork_.emplace_back(work);
+  }
+  // Wake the watchdog so it switches to the faster polling interval.
+  watchdogCV_.notify_one();
+}
+
+void ProcessGroupNCCL::pollOutstandingWork() {
+  std::list<std::shared_ptr<WorkNCCL>> completedWork;
+  {
+    std::lock_guard<std::mutex> lock(outstandingWorkMutex_);
+    for (auto it = outstandingWork_.begin(); it != outstandingWork_.end();) {
+      auto work = it->lock();
+      if (!work) {
+        // The owner dropped the work handle; its callbacks go with it.
+        it = outstandingWork_.erase(it);
+      } else if (work->isCompleted()) {
+        completedWork.push_back(std::move(work));
+        it = outstandingWork_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (auto& work : completedWork) {
+    // Record completion on the base class so callbacks registered from
+    // here on run immediately, then fire the accumulated ones.
+    {
+      std::lock_guard<std::mutex> lock(work->mutex_);
+      work->completed_ = true;
+    }
+    work->runCallbacks();
+  }
+}
+
 std::exception_ptr ProcessGroupNCCL::WorkNCCL::checkForNCCLErrors(
     const std::vector<std::shared_ptr<NCCLComm>>& ncclComms) const {
   return checkForNCCLErrorsInternal(ncclComms);
@@ -351,6 +511,116 @@ void ProcessGroupNCCL::broadcastUniqueNCCLID(ncclUniqueId* ncclID) {
   }
 }
 
+void ProcessGroupNCCL::exchangeUniqueNCCLID(
+    ncclUniqueId* ncclID,
+    const std::string& storeKey,
+    bool isRoot) {
+  // Same mechanism as broadcastUniqueNCCLID, but for a subgroup communicator:
+  // the subgroup's root publishes the ID under an explicit key so that
+  // disjoint subgroups (e.g. the ranks of different nodes) do not collide.
+  if (isRoot) {
+    auto vec = std::vector<uint8_t>(
+        reinterpret_cast<uint8_t*>(ncclID),
+        reinterpret_cast<uint8_t*>(ncclID) + NCCL_UNIQUE_ID_BYTES);
+    store_->set(storeKey, vec);
+  } else {
+    auto vec = store_->get(storeKey);
+    AT_CHECK(vec.size() == NCCL_UNIQUE_ID_BYTES);
+    std::memcpy(ncclID, vec.data(), vec.size());
+  }
+}
+
+void ProcessGroupNCCL::initHierarchy() {
+  if (hierarchyInitialized_) {
+    return;
+  }
+
+  // Publish this rank's hostname and read back everyone else's. Hosts are
+  // numbered by the order in which their first rank appears, so every rank
+  // derives the same node ids without any extra coordination.
+  char hostname[256] = {};
+  gethostname(hostname, sizeof(hostname) - 1);
+  std::string host(hostname);
+  store_->set(
+      "nccl_hier_host_" + std::to_string(rank_),
+      std::vector<uint8_t>(host.begin(), host.end()));
+
+  std::vector<std::string> hosts(size_);
+  for (int r = 0; r < size_; ++r) {
+    auto vec = store_->get("nccl_hier_host_" + std::to_string(r));
+    hosts[r] = std::string(vec.begin(), vec.end());
+  }
+
+  std::vector<std::string> nodes;
+  localRank_ = 0;
+  localSize_ = 0;
+  for (int r = 0; r < size_; ++r) {
+    if (std::find(nodes.begin(), nodes.end(), hosts[r]) == nodes.end()) {
+      nodes.push_back(hosts[r]);
+    }
+    if (hosts[r] == host) {
+      if (r < rank_) {
+        ++localRank_;
+      }
+      ++localSize_;
+    }
+  }
+  nodeId_ = std::find(nodes.begin(), nodes.end(), host) - nodes.begin();
+  numNodes_ = nodes.size();
+  hierarchyInitialized_ = true;
+}
+
+std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getHierarchicalComm(
+    const std::string& commKey,
+    const std::vector<at::Device>& devices,
+    const std::string& storeKey,
+    int numRanks,
+    int rank) {
+  {
+    std::lock_guard<std::mutex> lock(devNCCLCommMapLock_);
+    if (devNCCLCommMap_.find(commKey) != devNCCLCommMap_.end()) {
+      // Reuse the cached communicator if there is one.
+      return devNCCLCommMap_[commKey];
+    }
+  }
+
+  // Create the unique NCCL ID on the subgroup's root and share it with the
+  // other subgroup members through the store.
+  ncclUniqueId ncclID;
+  if (rank == 0) {
+    C10D_NCCL_CHECK(ncclGetUniqueId(&ncclID));
+  }
+  exchangeUniqueNCCLID(&ncclID, storeKey, rank == 0);
+
+  at::cuda::OptionalCUDAGuard gpuGuard;
+
+  std::vector<std::shared_ptr<NCCLComm>> ncclComms;
+  ncclComms.resize(devices.size());
+
+  std::vector<at::cuda::CUDAStream> streamVal;
+  streamVal.reserve(devices.size());
+
+  C10D_NCCL_CHECK(ncclGroupStart());
+
+  for (size_t i = 0; i < devices.size(); ++i) {
+    gpuGuard.set_index(devices[i].index());
+    ncclComms[i] = NCCLComm::create(numRanks, rank, ncclID);
+    streamVal.push_back(at::cuda::getStreamFromPool(isHighPriorityStream_));
+  }
+
+  C10D_NCCL_CHECK(ncclGroupEnd());
+
+  ncclStreams_.emplace(commKey, std::move(streamVal));
+  ncclEvents_.emplace(
+      std::piecewise_construct,
+      std::make_tuple(commKey),
+      std::make_tuple(devices.size()));
+
+  std::lock_guard<std::mutex> lock(devNCCLCommMapLock_);
+  devNCCLCommMap_.emplace(commKey, std::move(ncclComms));
+  return devNCCLCommMap_[commKey];
+}
+
 std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
     const std::string& devicesKey,
     const std::vector<at::Device>& devices) {
@@ -404,7 +674,7 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
     ncclComms[i] = NCCLComm::create(numRanks, rank, ncclID);
 
     // Creates the NCCL streams
-    streamVal.push_back(at::cuda::getStreamFromPool());
+    streamVal.push_back(at::cuda::getStreamFromPool(isHighPriorityStream_));
   }
 
   C10D_NCCL_CHECK(ncclGroupEnd());
@@ -516,6 +786,47 @@ std::shared_ptr<ProcessGroupNCCL::WorkNCCL> ProcessGroupNCCL::initWork(
   return std::make_shared<ProcessGroupNCCL::WorkNCCL>(devices);
 }
 
+void ProcessGroupNCCL::ensureGpuTimingEpoch(
+    const at::Device& device,
+    at::cuda::CUDAStream& stream) {
+  std::lock_guard<std::mutex> lock(timingEpoch_->mutex);
+  const auto index = device.index();
+  if (timingEpoch_->gpuEpochs.find(index) != timingEpoch_->gpuEpochs.end()) {
+    return;
+  }
+  // Record the device's reference event and wait for it, so that the CPU
+  // offset of the GPU axis is known and GPU event times can be reported
+  // relative to the same epoch as the enqueue times. This blocks once per
+  // device, at its first timed collective.
+  at::cuda::CUDAEvent gpuEpoch(cudaEventDefault);
+  gpuEpoch.record(stream);
+  gpuEpoch.synchronize();
+  timingEpoch_->gpuEpochOffsetMs.emplace(
+      index,
+      std::chrono::duration<float, std::milli>(
+          std::chrono::steady_clock::now() - timingEpoch_->cpuEpoch)
+          .count());
+  timingEpoch_->gpuEpochs.emplace(index, std::move(gpuEpoch));
+}
+
+void ProcessGroupNCCL::beginWorkTiming(
+    WorkNCCL& work,
+    std::vector<at::cuda::CUDAStream>& streams) {
+  work.timingEnabled_ = true;
+  work.timingEpoch_ = timingEpoch_;
+  work.enqueueTimeMs_ = std::chrono::duration<float, std::milli>(
+                            work.workStartTime_ - timingEpoch_->cpuEpoch)
+                            .count();
+  work.startEvents_.reserve(work.devices_.size());
+  work.endEvents_.reserve(work.devices_.size());
+  for (size_t i = 0; i < work.devices_.size(); ++i) {
+    ensureGpuTimingEpoch(work.devices_[i], streams[i]);
+    work.startEvents_.emplace_back(cudaEventDefault);
+    work.endEvents_.emplace_back(cudaEventDefault);
+    work.startEvents_[i].record(streams[i]);
+  }
+}
+
 template <typename Fn, typename PreProcess, typename PostProcess>
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
     std::vector<at::Tensor>& inputs,
@@ -535,6 +846,12 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
 
   at::cuda::OptionalCUDAGuard gpuGuard;
 
+  if (collectiveTiming_) {
+    // The start events land after the syncStreams events above, i.e. they
+    // measure when the collective could actually start on its stream.
+    beginWorkTiming(*work, ncclStreams_[key]);
+  }
+
   pre(ncclStreams_[key]);
 
   for (size_t i = 0; i < inputs.size(); ++i) {
@@ -568,12 +885,17 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
   // Event should only be recorded after the ncclGroupEnd()
   for (size_t i = 0; i < inputs.size(); ++i) {
     at::cuda::CUDAStream& ncclStream = ncclStreams_[key][i];
+    if (collectiveTiming_) {
+      work->endEvents_[i].record(ncclStream);
+    }
     work->cudaEvents_[i].record(ncclStream);
     work->ncclComms_[i] = ncclComms[i];
     work->blockingWait_ = blockingWait_;
     work->opTimeout_ = opTimeout_;
   }
 
+  registerOutstandingWork(work);
+
   return work;
 }
 
@@ -595,6 +917,15 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
     const AllreduceOptions& opts) {
   check_gpu_tensors(tensors);
 
+  if (hierarchicalAllreduce_ && tensors.size() == 1) {
+    initHierarchy();
+    // The hierarchical algorithm only helps when there are multiple nodes
+    // with multiple ranks each; otherwise a flat ring is already optimal.
+    if (numNodes_ > 1 && localSize_ > 1) {
+      return allreduceHierarchical(tensors, opts);
+    }
+  }
+
   return collective(
       tensors,
       tensors,
@@ -613,6 +944,125 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
       });
 }
 
+std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduceHierarchical(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  // Caller (allreduce) guarantees a single input tensor, an initialized
+  // hierarchy, and numNodes_ > 1 && localSize_ > 1.
+  auto& tensor = tensors[0];
+  const auto devices = getDeviceList(tensors);
+  const auto devKey = getKeyFromDevices(devices);
+  const bool isLeader = (localRank_ == 0);
+
+  // Intra-node communicator over the ranks on this host; the first rank on
+  // each host (local rank 0) acts as that host's leader.
+  const auto intraKey = "hier_intra:" + devKey;
+  auto& intraComms = getHierarchicalComm(
+      intraKey,
+      devices,
+      "nccl_hier_intra_" + std::to_string(nodeId_) + "_" + devKey,
+      localSize_,
+      localRank_);
+
+  // Inter-node communicator over one leader per host. Non-leader ranks never
+  // create or touch it.
+  const auto leaderKey = "hier_leader:" + devKey;
+  std::vector<std::shared_ptr<NCCLComm>>* leaderComms = nullptr;
+  if (isLeader) {
+    leaderComms = &getHierarchicalComm(
+        leaderKey, devices, "nccl_hier_leader_" + devKey, numNodes_, nodeId_);
+  }
+
+  // Let the NCCL streams wait for the input tensor's allocation streams, see
+  // [Sync Streams].
+  syncStreams(devices, ncclEvents_[intraKey], ncclStreams_[intraKey]);
+
+  auto work = initWork(devices);
+
+  at::cuda::OptionalCUDAGuard gpuGuard;
+  gpuGuard.set_index(devices[0].index());
+
+  at::cuda::CUDAStream& intraStream = ncclStreams_[intraKey][0];
+  c10::cuda::CUDACachingAllocator::recordStream(
+      tensor.storage().data(), intraStream);
+
+  if (collectiveTiming_) {
+    // All three phases are chained to the intra-node stream, so start/end
+    // events on it bracket the whole hierarchical operation.
+    beginWorkTiming(*work, ncclStreams_[intraKey]);
+  }
+
+  const auto type = getNcclDataType(tensor.scalar_type());
+  const auto count = tensor.numel();
+
+  // Phase 1: reduce onto this host's leader over the intra-node links.
+  {
+    AutoNcclGroup nccl_group_guard;
+    C10D_NCCL_CHECK(ncclReduce(
+        tensor.data_ptr(),
+        tensor.data_ptr(),
+        count,
+        type,
+        ncclOp[opts.reduceOp],
+        0, // the leader is rank 0 of the intra-node communicator
+        intraComms[0]->getNcclComm(),
+        intraStream.stream()));
+  }
+
+  // Phase 2: the leaders allreduce the per-host partial results across hosts.
+  // The leader stream is chained to the intra-node stream with events in both
+  // directions so the three phases execute back to back on the GPU.
+  if (isLeader) {
+    at::cuda::CUDAStream& leaderStream = ncclStreams_[leaderKey][0];
+    c10::cuda::CUDACachingAllocator::recordStream(
+        tensor.storage().data(), leaderStream);
+
+    at::cuda::CUDAEvent reduceDone;
+    reduceDone.record(intraStream);
+    reduceDone.block(leaderStream);
+
+    {
+      AutoNcclGroup nccl_group_guard;
+      C10D_NCCL_CHECK(ncclAllReduce(
+          tensor.data_ptr(),
+          tensor.data_ptr(),
+          count,
+          type,
+          ncclOp[opts.reduceOp],
+          (*leaderComms)[0]->getNcclComm(),
+          leaderStream.stream()));
+    }
+
+    at::cuda::CUDAEvent allreduceDone;
+    allreduceDone.record(leaderStream);
+    allreduceDone.block(intraStream);
+  }
+
+  // Phase 3: the leaders broadcast the result back within their host. The
+  // broadcast on non-leader ranks simply waits for the leader's data, so no
+  // cross-rank event synchronization is needed here.
+  {
+    AutoNcclGroup nccl_group_guard;
+    C10D_NCCL_CHECK(ncclBcast(
+        tensor.data_ptr(),
+        count,
+        type,
+        0,
+        intraComms[0]->getNcclComm(),
+        intraStream.stream()));
+  }
+
+  if (collectiveTiming_) {
+    work->endEvents_[0].record(intraStream);
+  }
+  work->cudaEvents_[0].record(intraStream);
+  work->ncclComms_[0] = intraComms[0];
+  work->blockingWait_ = blockingWait_;
+  work->opTimeout_ = opTimeout_;
+
+  return work;
+}
+
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce_coalesced(
     std::vector<at::Tensor>& tensors,
     const AllreduceCoalescedOptions& opts) {
@@ -620,6 +1070,91 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce_coalesced(
       "allreduce_coalesced is currently not supported with NCCL");
 }
 
+std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduceWithEpilogue(
+    std::vector<at::Tensor>& gradients,
+    std::vector<at::Tensor>& parameters,
+    std::vector<at::Tensor>& momentumBuffers,
+    const AllreduceEpilogueOptions& opts) {
+  check_gpu_tensors(gradients);
+  check_gpu_tensors(parameters);
+
+  if (parameters.size() != gradients.size()) {
+    throw std::runtime_error(
+        "allreduceWithEpilogue expects one parameter tensor per gradient");
+  }
+  const bool useMomentum = opts.momentum != 0.0;
+  if (useMomentum && momentumBuffers.size() != gradients.size()) {
+    throw std::runtime_error(
+        "allreduceWithEpilogue expects one momentum buffer per gradient "
+        "when momentum is nonzero");
+  }
+  for (size_t i = 0; i < gradients.size(); ++i) {
+    if (parameters[i].sizes() != gradients[i].sizes() ||
+        parameters[i].get_device() != gradients[i].get_device() ||
+        (useMomentum &&
+         (momentumBuffers[i].sizes() != gradients[i].sizes() ||
+          momentumBuffers[i].get_device() != gradients[i].get_device()))) {
+      throw std::runtime_error(
+          "allreduceWithEpilogue expects gradients, parameters and momentum "
+          "buffers to match in shape and device");
+    }
+  }
+
+  return collective(
+      gradients,
+      gradients,
+      [&](at::Tensor& input,
+          at::Tensor& output,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        return ncclAllReduce(
+            input.data_ptr(),
+            output.data_ptr(),
+            input.numel(),
+            getNcclDataType(input.scalar_type()),
+            ncclOp[opts.reduceOp],
+            comm,
+            stream.stream());
+      },
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {},
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {
+        // Run the optimizer epilogue right behind the collective on the NCCL
+        // streams, so the updated parameters are ready as soon as the
+        // returned work completes. The work's CUDA events are recorded after
+        // this hook, hence they cover the epilogue as well.
+        for (size_t i = 0; i < gradients.size(); ++i) {
+          at::cuda::CUDAStreamGuard guard(ncclStreams[i]);
+
+          // The parameters and momentum buffers live on the compute stream;
+          // see [Sync Streams]. The gradients were already recorded by
+          // `collective'.
+          c10::cuda::CUDACachingAllocator::recordStream(
+              parameters[i].storage().data(), ncclStreams[i]);
+          if (useMomentum) {
+            c10::cuda::CUDACachingAllocator::recordStream(
+                momentumBuffers[i].storage().data(), ncclStreams[i]);
+          }
+
+          auto& grad = gradients[i];
+          if (opts.scale != 1.0) {
+            grad.mul_(opts.scale);
+          }
+          if (opts.learningRate == 0.0) {
+            continue;
+          }
+          if (opts.weightDecay != 0.0) {
+            grad.add_(parameters[i], opts.weightDecay);
+          }
+          if (useMomentum) {
+            momentumBuffers[i].mul_(opts.momentum).add_(grad);
+            parameters[i].add_(momentumBuffers[i], -opts.learningRate);
+          } else {
+            parameters[i].add_(grad, -opts.learningRate);
+          }
+        }
+      });
+}
+
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::broadcast(
     std::vector<at::Tensor>& tensors,
     const BroadcastOptions& opts) {
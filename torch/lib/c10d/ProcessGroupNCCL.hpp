@@ -1,5 +1,6 @@
 #pragma once
 
+#include <list>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -17,6 +18,32 @@ namespace c10d {
 // non-blocking.
 constexpr const char* NCCL_BLOCKING_WAIT = "NCCL_BLOCKING_WAIT";
 
+// Environment variable which controls whether allreduce uses the hierarchical
+// algorithm: an intra-node reduce onto one leader rank per node, an inter-node
+// allreduce among the leaders, and an intra-node broadcast of the result. This
+// keeps most of the traffic on the fast intra-node links (NVLink) and only
+// sends one tensor per node over the network. It only takes effect for
+// single-tensor allreduce calls on jobs that span multiple nodes with
+// multiple ranks per node.
+constexpr const char* NCCL_HIERARCHICAL_ALLREDUCE =
+    "NCCL_HIERARCHICAL_ALLREDUCE";
+
+// Environment variable which controls whether the NCCL streams are taken from
+// the high priority CUDA stream pool. By default NCCL kernels run on regular
+// priority streams and can be delayed behind queued compute kernels; with
+// high priority streams the communication kernels are scheduled ahead of
+// pending compute work, which usually improves communication/computation
+// overlap at the cost of occasionally slowing down a concurrent compute
+// kernel.
+constexpr const char* NCCL_HIGH_PRIORITY_STREAMS = "NCCL_HIGH_PRIORITY_STREAMS";
+
+// Environment variable which controls whether per-work timing records are
+// collected. When enabled, every collective records its enqueue time and
+// GPU start/end events, queryable from the returned work object (see
+// WorkNCCL::getEnqueueTime and friends). Collecting the records costs two
+// extra event records per collective, so this is off by default.
+constexpr const char* NCCL_COLLECTIVE_TIMING = "NCCL_COLLECTIVE_TIMING";
+
 // ProcessGroupNCCL implements NCCL bindings for c10d.
 //
 // All functions of the class are expected to be called in the same order
@@ -54,6 +81,20 @@ constexpr const char* NCCL_BLOCKING_WAIT = "NCCL_BLOCKING_WAIT";
 //   // Now continue on other work in the current stream.
 class ProcessGroupNCCL : public ProcessGroup {
  public:
+  // Reference points for per-work timing records. The CPU epoch is taken at
+  // process group construction; each device's GPU epoch event is recorded at
+  // the device's first timed collective and synchronized on, so that its CPU
+  // offset is known and GPU event times can be reported on the same
+  // millisecond axis as the enqueue times. Shared with WorkNCCL so that
+  // records from different works of the same process group are directly
+  // comparable.
+  struct TimingEpoch {
+    std::mutex mutex;
+    std::chrono::time_point<std::chrono::steady_clock> cpuEpoch;
+    std::unordered_map<int, at::cuda::CUDAEvent> gpuEpochs;
+    std::unordered_map<int, float> gpuEpochOffsetMs;
+  };
+
   class WorkNCCL : public ProcessGroup::Work {
    public:
     // Constructor takes a list of CUDA devices
@@ -81,6 +122,21 @@ class ProcessGroupNCCL : public ProcessGroup {
     // execution on the GPUs
     bool finishedGPUExecution();
 
+    // Whether timing records were collected for this work, see
+    // NCCL_COLLECTIVE_TIMING. The getters below throw when they were not.
+    bool timingEnabled() const;
+
+    // CPU time at which the collective was queued, in milliseconds since
+    // the process group's timing epoch.
+    float getEnqueueTime() const;
+
+    // GPU times (one per device) at which the NCCL kernels started and
+    // ended on their streams, on the same millisecond axis as
+    // getEnqueueTime(). Only valid once the work has completed; querying
+    // earlier throws.
+    std::vector<float> getStartTimes() const;
+    std::vector<float> getEndTimes() const;
+
    protected:
     // The cached list of CUDA devices to operate on
     std::vector<at::Device> devices_;
@@ -103,6 +159,14 @@ class ProcessGroupNCCL : public ProcessGroup {
     // Time point representing when the work started.
     std::chrono::time_point<std::chrono::steady_clock> workStartTime_;
 
+    // Timing records, see NCCL_COLLECTIVE_TIMING. Unlike cudaEvents_, the
+    // start/end events are created with timing enabled.
+    bool timingEnabled_ = false;
+    float enqueueTimeMs_ = 0.0f;
+    std::vector<at::cuda::CUDAEvent> startEvents_;
+    std::vector<at::cuda::CUDAEvent> endEvents_;
+    std::shared_ptr<TimingEpoch> timingEpoch_;
+
     // Wrapper method for the static checkForNCCLErrors which can be overridden
     // for tests.
     virtual std::exception_ptr checkForNCCLErrors(
@@ -170,6 +234,24 @@ class ProcessGroupNCCL : public ProcessGroup {
       const AllreduceCoalescedOptions& opts =
           AllreduceCoalescedOptions()) override;
 
+  // Allreduce variant that applies an SGD-style optimizer epilogue on the
+  // NCCL streams immediately after the collective: the reduced gradient is
+  // scaled (e.g. by 1/world_size), weight decay is folded in, the momentum
+  // buffer is updated and the parameter update is applied, all back to back
+  // behind the collective without a round trip through the compute stream.
+  // This replaces the separate scale/weight-decay/update launches a data
+  // parallel trainer would otherwise issue per bucket and step.
+  //
+  // `gradients', `parameters' and `momentumBuffers' follow the usual one
+  // tensor per GPU convention and must match in shape pairwise;
+  // `momentumBuffers' may be empty when opts.momentum is zero. The returned
+  // work completes only once the epilogue has finished.
+  std::shared_ptr<ProcessGroup::Work> allreduceWithEpilogue(
+      std::vector<at::Tensor>& gradients,
+      std::vector<at::Tensor>& parameters,
+      std::vector<at::Tensor>& momentumBuffers,
+      const AllreduceEpilogueOptions& opts = AllreduceEpilogueOptions());
+
   std::shared_ptr<ProcessGroup::Work> reduce(
       std::vector<at::Tensor>& tensors,
       const ReduceOptions& opts = ReduceOptions()) override;
@@ -223,12 +305,50 @@ class ProcessGroupNCCL : public ProcessGroup {
   // Helper that broadcasts nccl unique ID to all ranks through the store
   void broadcastUniqueNCCLID(ncclUniqueId* ncclID);
 
+  // Variant of broadcastUniqueNCCLID for subgroup communicators: the root of
+  // the subgroup publishes the ID under the given store key and all other
+  // subgroup members retrieve it. Disjoint subgroups must use distinct keys.
+  void exchangeUniqueNCCLID(
+      ncclUniqueId* ncclID,
+      const std::string& storeKey,
+      bool isRoot);
+
   // Helper that either looks up the cached NCCL communicators or creates
   // a new set of NCCL communicators as a cache entry
   std::vector<std::shared_ptr<NCCLComm>>& getNCCLComm(
       const std::string& devicesKey,
       const std::vector<at::Device>& devices);
 
+  // Discovers how the ranks of this process group are laid out across hosts
+  // (by exchanging hostnames through the store) and fills in localRank_,
+  // localSize_, nodeId_ and numNodes_. Only called when hierarchical
+  // allreduce is enabled; a no-op after the first call.
+  void initHierarchy();
+
+  // Like getNCCLComm, but creates/caches a communicator over a subgroup of
+  // ranks: the ranks on this node, or one leader rank per node. `numRanks'
+  // and `rank' describe this process's position within the subgroup; the
+  // subgroup's rank 0 generates the unique NCCL ID and shares it through the
+  // store under `storeKey'.
+  std::vector<std::shared_ptr<NCCLComm>>& getHierarchicalComm(
+      const std::string& commKey,
+      const std::vector<at::Device>& devices,
+      const std::string& storeKey,
+      int numRanks,
+      int rank);
+
+  // Records the GPU timing epoch event for `device' on `stream' if it has
+  // not been recorded yet. Only called when collective timing is enabled.
+  void ensureGpuTimingEpoch(
+      const at::Device& device,
+      at::cuda::CUDAStream& stream);
+
+  // Attaches timing records to `work' and records its start events on the
+  // given NCCL streams. Only called when collective timing is enabled.
+  void beginWorkTiming(
+      WorkNCCL& work,
+      std::vector<at::cuda::CUDAStream>& streams);
+
   // Wrapper method which can be overridden for tests.
   virtual std::exception_ptr checkForNCCLErrors(
       const std::vector<std::shared_ptr<NCCLComm>>& ncclComms);
@@ -256,6 +376,14 @@ class ProcessGroupNCCL : public ProcessGroup {
       PreProcess pre,
       PostProcess post);
 
+  // Hierarchical allreduce: intra-node reduce onto the node leader, an
+  // allreduce among the node leaders, and an intra-node broadcast of the
+  // result. Used instead of a flat ncclAllReduce when hierarchical allreduce
+  // is enabled (see NCCL_HIERARCHICAL_ALLREDUCE).
+  std::shared_ptr<ProcessGroup::Work> allreduceHierarchical(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts);
+
   // Checks for NCCL errors on each of the communicators and returns an
   // appropriate exception_ptr (nullptr if no errors).
   static std::exception_ptr checkForNCCLErrorsInternal(
@@ -272,9 +400,25 @@ class ProcessGroupNCCL : public ProcessGroup {
   // object might get destroyed before the WorkNCCL object.
   void ncclCommWatchdog();
 
+  // Adds a work to the list polled by the watchdog thread, so that its
+  // completion callbacks fire once GPU execution finishes. Completion of
+  // NCCL work is only observable through its CUDA events, so unlike the
+  // other backends there is no worker thread that could run callbacks at
+  // the point of completion.
+  void registerOutstandingWork(const std::shared_ptr<WorkNCCL>& work);
+
+  // Fires the callbacks of registered works whose GPU execution has
+  // finished (or errored) and prunes them from the list. Runs on the
+  // watchdog thread.
+  void pollOutstandingWork();
+
  protected:
   static const int64_t kWatchdogThreadSleepMillis;
 
+  // Watchdog sleep interval while works are outstanding, so completion
+  // callbacks fire promptly enough to overlap communication with compute.
+  static const int64_t kOutstandingWorkSleepMillis;
+
   // The store is used to broadcast the NCCL unique ID of rank 0.
   std::shared_ptr<Store> store_;
 
@@ -320,6 +464,14 @@ class ProcessGroupNCCL : public ProcessGroup {
   // Mutex for watchdog.
   std::mutex watchdogCVMutex_;
 
+  // Works whose completion callbacks (and futures) the watchdog thread
+  // still needs to fire once their GPU execution finishes. Held as weak
+  // pointers so dropping the work handle also drops its callbacks.
+  std::list<std::weak_ptr<WorkNCCL>> outstandingWork_;
+
+  // Mutex guarding outstandingWork_.
+  std::mutex outstandingWorkMutex_;
+
   // The CUDA steams used by NCCL kernels
   std::unordered_map<std::string, std::vector<at::cuda::CUDAStream>>
       ncclStreams_;
@@ -354,6 +506,38 @@ class ProcessGroupNCCL : public ProcessGroup {
   // for the operation to complete.
   bool blockingWait_ = false;
 
+  // Whether allreduce should use the hierarchical algorithm (see
+  // NCCL_HIERARCHICAL_ALLREDUCE).
+  bool hierarchicalAllreduce_ = false;
+
+  // Whether the NCCL streams are taken from the high priority stream pool
+  // (see NCCL_HIGH_PRIORITY_STREAMS).
+  bool isHighPriorityStream_ = false;
+
+  // Whether per-work timing records are collected (see
+  // NCCL_COLLECTIVE_TIMING).
+  bool collectiveTiming_ = false;
+
+  // Timing reference points; only allocated when collectiveTiming_ is set.
+  std::shared_ptr<TimingEpoch> timingEpoch_;
+
+  // Layout of ranks across hosts; valid once hierarchyInitialized_ is set by
+  // initHierarchy().
+  bool hierarchyInitialized_ = false;
+
+  // Index of this rank among the ranks running on the same host.
+  int localRank_ = 0;
+
+  // Number of ranks running on the same host as this rank.
+  int localSize_ = 1;
+
+  // Index of this rank's host; hosts are numbered by the order in which their
+  // first rank appears, so all ranks agree on the numbering.
+  int nodeId_ = 0;
+
+  // Number of distinct hosts in the process group.
+  int numNodes_ = 1;
+
   // Timeout for operations. This is only used when blockingWait_ is enabled.
   std::chrono::milliseconds opTimeout_;
 };
@@ -1,5 +1,7 @@
 #include <c10d/Store.hpp>
 
+#include <thread>
+
 namespace c10d {
 
 constexpr std::chrono::milliseconds Store::kDefaultTimeout;
@@ -8,6 +10,56 @@ constexpr std::chrono::milliseconds Store::kNoTimeout;
 // Define destructor symbol for abstract base class.
 Store::~Store() {}
 
+// Generic fallback that polls the counter; stores with a push channel
+// override this with a blocking wait.
+void Store::waitCounter(const std::string& key, int64_t value) {
+  const auto start = std::chrono::steady_clock::now();
+  while (true) {
+    auto data = get(key);
+    auto buf = reinterpret_cast<const char*>(data.data());
+    auto len = data.size();
+    if (std::stoll(std::string(buf, len)) >= value) {
+      return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - start);
+    if (timeout_ != kNoTimeout && elapsed > timeout_) {
+      throw std::runtime_error("Wait timeout for counter: " + key);
+    }
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+// Generic fallbacks that issue one operation per key.
+void Store::multiSet(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<uint8_t>>& values) {
+  if (keys.size() != values.size()) {
+    throw std::invalid_argument(
+        "multiSet requires one value per key, got " +
+        std::to_string(keys.size()) + " keys and " +
+        std::to_string(values.size()) + " values");
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    set(keys[i], values[i]);
+  }
+}
+
+std::vector<std::vector<uint8_t>> Store::multiGet(
+    const std::vector<std::string>& keys) {
+  std::vector<std::vector<uint8_t>> values;
+  values.reserve(keys.size());
+  for (const auto& key : keys) {
+    values.push_back(get(key));
+  }
+  return values;
+}
+
+std::vector<std::string> Store::scan(const std::string& /* unused */) {
+  throw std::runtime_error("Store does not support listing keys by prefix");
+}
+
 // Set timeout function
 void Store::setTimeout(const std::chrono::milliseconds& timeout) {
   timeout_ = timeout;
@@ -38,6 +38,27 @@ class Store {
       const std::vector<std::string>& keys,
       const std::chrono::milliseconds& timeout) = 0;
 
+  // Blocks until the integer counter stored at key, as maintained by
+  // add(), has reached at least the given value. The default
+  // implementation polls the key; stores that have a notification
+  // channel to a server override this so the caller blocks without
+  // polling (see TCPStore).
+  virtual void waitCounter(const std::string& key, int64_t value);
+
+  // Bulk operations. The defaults loop over set()/get(); stores that talk
+  // to a server override them to batch everything into a single round trip
+  // (see TCPStore).
+  virtual void multiSet(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<uint8_t>>& values);
+
+  virtual std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys);
+
+  // Returns the keys currently in the store that start with the given
+  // prefix. Not every store can enumerate its keys; the default throws.
+  virtual std::vector<std::string> scan(const std::string& prefix);
+
   void setTimeout(const std::chrono::milliseconds& timeout);
 
  protected:
@@ -10,7 +10,17 @@ namespace c10d {
 
 namespace {
 
-enum class QueryType : uint8_t { SET, GET, ADD, CHECK, WAIT };
+enum class QueryType : uint8_t {
+  SET,
+  GET,
+  ADD,
+  CHECK,
+  WAIT,
+  WAIT_COUNTER,
+  MULTI_SET,
+  MULTI_GET,
+  SCAN
+};
 
 enum class CheckResponseType : uint8_t { READY, NOT_READY };
 
@@ -139,6 +149,20 @@ void TCPStoreDaemon::run() {
             ++it;
           }
         }
+        for (auto it = counterWaiters_.begin(); it != counterWaiters_.end();) {
+          for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
+            if (vecIt->first == fds[fdIdx].fd) {
+              vecIt = it->second.erase(vecIt);
+            } else {
+              ++vecIt;
+            }
+          }
+          if (it->second.size() == 0) {
+            it = counterWaiters_.erase(it);
+          } else {
+            ++it;
+          }
+        }
         fds.erase(fds.begin() + fdIdx);
         sockets_.erase(sockets_.begin() + fdIdx - 2);
         --fdIdx;
@@ -180,6 +204,18 @@ void TCPStoreDaemon::query(int socket) {
   } else if (qt == QueryType::WAIT) {
     waitHandler(socket);
 
+  } else if (qt == QueryType::WAIT_COUNTER) {
+    waitCounterHandler(socket);
+
+  } else if (qt == QueryType::MULTI_SET) {
+    multiSetHandler(socket);
+
+  } else if (qt == QueryType::MULTI_GET) {
+    multiGetHandler(socket);
+
+  } else if (qt == QueryType::SCAN) {
+    scanHandler(socket);
+
   } else {
     throw std::runtime_error("Unexpected query type");
   }
@@ -198,11 +234,32 @@ void TCPStoreDaemon::wakeupWaitingClients(const std::string& key) {
   }
 }
 
+void TCPStoreDaemon::wakeupCounterWaitingClients(const std::string& key) {
+  auto waiters = counterWaiters_.find(key);
+  if (waiters == counterWaiters_.end()) {
+    return;
+  }
+  auto value = counterValue(key);
+  for (auto it = waiters->second.begin(); it != waiters->second.end();) {
+    if (value >= it->second) {
+      tcputil::sendValue<WaitResponseType>(
+          it->first, WaitResponseType::STOP_WAITING);
+      it = waiters->second.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (waiters->second.empty()) {
+    counterWaiters_.erase(waiters);
+  }
+}
+
 void TCPStoreDaemon::setHandler(int socket) {
   std::string key = tcputil::recvString(socket);
   tcpStore_[key] = tcputil::recvVector<uint8_t>(socket);
   // On "set", wake up all clients that have been waiting
   wakeupWaitingClients(key);
+  wakeupCounterWaitingClients(key);
 }
 
 void TCPStoreDaemon::addHandler(int socket) {
@@ -220,6 +277,7 @@ void TCPStoreDaemon::addHandler(int socket) {
   tcputil::sendValue<int64_t>(socket, addVal);
   // On "add", wake up all clients that have been waiting
   wakeupWaitingClients(key);
+  wakeupCounterWaitingClients(key);
 }
 
 void TCPStoreDaemon::getHandler(int socket) const {
@@ -261,12 +319,75 @@ void TCPStoreDaemon::waitHandler(int socket) {
   }
 }
 
+void TCPStoreDaemon::waitCounterHandler(int socket) {
+  std::string key = tcputil::recvString(socket);
+  int64_t target = tcputil::recvValue<int64_t>(socket);
+  if (counterValue(key) >= target) {
+    tcputil::sendValue<WaitResponseType>(
+        socket, WaitResponseType::STOP_WAITING);
+  } else {
+    counterWaiters_[key].push_back(std::make_pair(socket, target));
+  }
+}
+
+void TCPStoreDaemon::multiSetHandler(int socket) {
+  SizeType nkeys;
+  tcputil::recvBytes<SizeType>(socket, &nkeys, 1);
+  for (size_t i = 0; i < nkeys; i++) {
+    std::string key = tcputil::recvString(socket);
+    tcpStore_[key] = tcputil::recvVector<uint8_t>(socket);
+    wakeupWaitingClients(key);
+    wakeupCounterWaitingClients(key);
+  }
+}
+
+void TCPStoreDaemon::multiGetHandler(int socket) const {
+  SizeType nkeys;
+  tcputil::recvBytes<SizeType>(socket, &nkeys, 1);
+  std::vector<std::string> keys(nkeys);
+  for (size_t i = 0; i < nkeys; i++) {
+    keys[i] = tcputil::recvString(socket);
+  }
+  // The client waited on all keys before issuing the query, so every key
+  // exists; the number of values is known to the client in advance.
+  for (size_t i = 0; i < nkeys; i++) {
+    tcputil::sendVector<uint8_t>(
+        socket, tcpStore_.at(keys[i]), (i != (nkeys - 1)));
+  }
+}
+
+void TCPStoreDaemon::scanHandler(int socket) const {
+  std::string prefix = tcputil::recvString(socket);
+  std::vector<std::string> keys;
+  for (const auto& kv : tcpStore_) {
+    if (kv.first.compare(0, prefix.size(), prefix) == 0) {
+      keys.push_back(kv.first);
+    }
+  }
+  SizeType nkeys = keys.size();
+  tcputil::sendBytes<SizeType>(socket, &nkeys, 1, (nkeys > 0));
+  for (size_t i = 0; i < nkeys; i++) {
+    tcputil::sendString(socket, keys[i], (i != (nkeys - 1)));
+  }
+}
+
 bool TCPStoreDaemon::checkKeys(const std::vector<std::string>& keys) const {
   return std::all_of(keys.begin(), keys.end(), [this](const std::string& s) {
     return tcpStore_.count(s) > 0;
   });
 }
 
+// Counters that have never been incremented read as zero, matching the
+// behavior of "add" on an absent key.
+int64_t TCPStoreDaemon::counterValue(const std::string& key) const {
+  auto it = tcpStore_.find(key);
+  if (it == tcpStore_.end()) {
+    return 0;
+  }
+  auto buf = reinterpret_cast<const char*>(it->second.data());
+  return std::stoll(std::string(buf, it->second.size()));
+}
+
 // TCPStore class methods
 TCPStore::TCPStore(
     const std::string& masterAddr,
@@ -308,25 +429,11 @@ TCPStore::~TCPStore() {
 void TCPStore::waitForWorkers_() {
   addHelper_(initKey_, 1);
   // Let server block until all workers have completed, this ensures that
-  // the server daemon thread is always running until the very end
+  // the server daemon thread is always running until the very end. The
+  // daemon sends a notification once the init counter reaches the number
+  // of workers, so there is no need to poll the key.
   if (isServer_) {
-    const auto start = std::chrono::steady_clock::now();
-    while (true) {
-      std::vector<uint8_t> value = getHelper_(initKey_);
-      auto buf = reinterpret_cast<const char*>(value.data());
-      auto len = value.size();
-      int numWorkersCompleted = std::stoi(std::string(buf, len));
-      if (numWorkersCompleted >= numWorkers_) {
-        break;
-      }
-      const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-          std::chrono::steady_clock::now() - start);
-      if (timeout_ != kNoTimeout && elapsed > timeout_) {
-        break;
-      }
-      /* sleep override */
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
+    waitCounterHelper_(initKey_, numWorkers_, timeout_);
   }
 }
 
@@ -420,4 +527,88 @@ void TCPStore::waitHelper_(
   }
 }
 
+void TCPStore::waitCounter(const std::string& key, int64_t value) {
+  std::string regKey = regularPrefix_ + key;
+  waitCounterHelper_(regKey, value, timeout_);
+}
+
+void TCPStore::waitCounterHelper_(
+    const std::string& key,
+    int64_t value,
+    const std::chrono::milliseconds& timeout) {
+  // Set the socket timeout if there is a wait timeout
+  if (timeout != kNoTimeout) {
+    struct timeval timeoutTV = {.tv_sec = timeout.count() / 1000,
+                                .tv_usec = (timeout.count() % 1000) * 1000};
+    SYSCHECK_ERR_RETURN_NEG1(::setsockopt(
+        storeSocket_,
+        SOL_SOCKET,
+        SO_RCVTIMEO,
+        reinterpret_cast<char*>(&timeoutTV),
+        sizeof(timeoutTV)));
+  }
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::WAIT_COUNTER);
+  tcputil::sendString(storeSocket_, key, true);
+  tcputil::sendValue<int64_t>(storeSocket_, value);
+  auto waitResponse = tcputil::recvValue<WaitResponseType>(storeSocket_);
+  if (waitResponse != WaitResponseType::STOP_WAITING) {
+    throw std::runtime_error("Stop_waiting response is expected");
+  }
+}
+
+void TCPStore::multiSet(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<uint8_t>>& values) {
+  if (keys.size() != values.size()) {
+    throw std::invalid_argument(
+        "multiSet requires one value per key, got " +
+        std::to_string(keys.size()) + " keys and " +
+        std::to_string(values.size()) + " values");
+  }
+  SizeType nkeys = keys.size();
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::MULTI_SET, true);
+  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
+  for (size_t i = 0; i < nkeys; i++) {
+    std::string regKey = regularPrefix_ + keys[i];
+    tcputil::sendString(storeSocket_, regKey, true);
+    tcputil::sendVector<uint8_t>(storeSocket_, values[i], (i != (nkeys - 1)));
+  }
+}
+
+std::vector<std::vector<uint8_t>> TCPStore::multiGet(
+    const std::vector<std::string>& keys) {
+  std::vector<std::string> regKeys;
+  regKeys.reserve(keys.size());
+  for (const auto& key : keys) {
+    regKeys.push_back(regularPrefix_ + key);
+  }
+  // One wait round trip covering every key, then one bulk get.
+  waitHelper_(regKeys, timeout_);
+
+  SizeType nkeys = regKeys.size();
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::MULTI_GET, true);
+  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
+  for (size_t i = 0; i < nkeys; i++) {
+    tcputil::sendString(storeSocket_, regKeys[i], (i != (nkeys - 1)));
+  }
+  std::vector<std::vector<uint8_t>> values(nkeys);
+  for (size_t i = 0; i < nkeys; i++) {
+    values[i] = tcputil::recvVector<uint8_t>(storeSocket_);
+  }
+  return values;
+}
+
+std::vector<std::string> TCPStore::scan(const std::string& prefix) {
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::SCAN, true);
+  tcputil::sendString(storeSocket_, regularPrefix_ + prefix);
+  SizeType nkeys;
+  tcputil::recvBytes<SizeType>(storeSocket_, &nkeys, 1);
+  std::vector<std::string> keys(nkeys);
+  for (size_t i = 0; i < nkeys; i++) {
+    // Strip the internal key prefix the same way get() adds it.
+    keys[i] = tcputil::recvString(storeSocket_).substr(regularPrefix_.size());
+  }
+  return keys;
+}
+
 } // namespace c10d
@@ -27,9 +27,15 @@ class TCPStoreDaemon {
   void getHandler(int socket) const;
   void checkHandler(int socket) const;
   void waitHandler(int socket);
+  void waitCounterHandler(int socket);
+  void multiSetHandler(int socket);
+  void multiGetHandler(int socket) const;
+  void scanHandler(int socket) const;
 
   bool checkKeys(const std::vector<std::string>& keys) const;
+  int64_t counterValue(const std::string& key) const;
   void wakeupWaitingClients(const std::string& key);
+  void wakeupCounterWaitingClients(const std::string& key);
 
   std::thread daemonThread_;
   std::unordered_map<std::string, std::vector<uint8_t>> tcpStore_;
@@ -37,6 +43,10 @@ class TCPStoreDaemon {
   std::unordered_map<std::string, std::vector<int>> waitingSockets_;
   // From socket -> number of keys awaited
   std::unordered_map<int, size_t> keysAwaited_;
+  // From key -> the list of (socket, target value) pairs waiting for
+  // the counter stored at that key to reach the target value
+  std::unordered_map<std::string, std::vector<std::pair<int, int64_t>>>
+      counterWaiters_;
 
   std::vector<int> sockets_;
   int storeListenSocket_;
@@ -68,12 +78,29 @@ class TCPStore : public Store {
       const std::vector<std::string>& keys,
       const std::chrono::milliseconds& timeout) override;
 
+  void waitCounter(const std::string& key, int64_t value) override;
+
+  // Bulk operations: one round trip to the daemon regardless of the number
+  // of keys, instead of one per key.
+  void multiSet(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<uint8_t>>& values) override;
+
+  std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys) override;
+
+  std::vector<std::string> scan(const std::string& prefix) override;
+
  protected:
   int64_t addHelper_(const std::string& key, int64_t value);
   std::vector<uint8_t> getHelper_(const std::string& key);
   void waitHelper_(
       const std::vector<std::string>& keys,
       const std::chrono::milliseconds& timeout);
+  void waitCounterHelper_(
+      const std::string& key,
+      int64_t value,
+      const std::chrono::milliseconds& timeout);
   void waitForWorkers_();
 
   bool isServer_;
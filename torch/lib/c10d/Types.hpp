@@ -31,6 +31,23 @@ struct AllreduceOptions {
 
 struct AllreduceCoalescedOptions : AllreduceOptions {};
 
+// Describes an optimizer epilogue to run on the communication stream right
+// after an allreduce completes (see ProcessGroupNCCL::allreduceWithEpilogue).
+// With the defaults the epilogue leaves the gradients and parameters
+// untouched. A data parallel SGD step typically sets scale = 1/world_size
+// and learningRate > 0, with momentum/weightDecay as in torch.optim.SGD.
+struct AllreduceEpilogueOptions : AllreduceOptions {
+  // Multiplied into the reduced gradient, e.g. 1/world_size for averaging.
+  double scale = 1.0;
+  // Parameter update: param -= learningRate * adjusted gradient. A zero
+  // learning rate skips the parameter update (and the momentum update).
+  double learningRate = 0.0;
+  // Momentum coefficient; requires a momentum buffer per gradient tensor.
+  double momentum = 0.0;
+  // L2 penalty added to the gradient as weightDecay * param.
+  double weightDecay = 0.0;
+};
+
 struct ReduceOptions {
   ReduceOp reduceOp = ReduceOp::SUM;
   int rootRank = 0;
@@ -48,6 +48,8 @@ void testHelper(std::string prefix = "") {
   }
   sem1.wait(numThreads);
   sem2.post(numThreads);
+  // Block until every thread has finished its "add" loop
+  store.waitCounter("counter", numThreads * numIterations);
   for (auto& thread : threads) {
     thread.join();
   }
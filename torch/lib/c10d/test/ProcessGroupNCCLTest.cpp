@@ -1,3 +1,4 @@
+#include <cmath>
 #include <iostream>
 
 #include <c10d/FileStore.hpp>
@@ -164,6 +165,62 @@ class AllreduceNCCLTest : public NCCLTest {
   }
 };
 
+class AllreduceEpilogueNCCLTest : public NCCLTest {
+ public:
+  AllreduceEpilogueNCCLTest(const std::string& path, int worldSize)
+      : NCCLTest(path, worldSize) {
+    params_.resize(numDevices_);
+    momentum_.resize(numDevices_);
+    at::cuda::OptionalCUDAGuard deviceGuard;
+    for (auto i = 0; i < numDevices_; ++i) {
+      deviceGuard.set_index(i);
+      params_[i] = at::empty({3, 3}, at::kCUDA);
+      momentum_[i] = at::empty({3, 3}, at::kCUDA);
+    }
+  }
+
+  std::shared_ptr<c10d::ProcessGroup::Work> run(
+      const ::c10d::AllreduceEpilogueOptions& options) {
+    // For the duration of this function, make THC use our streams
+    at::cuda::CUDAMultiStreamGuard guard(streams_);
+
+    // Launch sleep on every device
+    at::cuda::OptionalCUDAGuard deviceGuard;
+    for (auto i = 0; i < numDevices_; i++) {
+      deviceGuard.set_index(i);
+      cudaSleep(streams_[i], 2000 * 1000 * 1000);
+    }
+
+    // Launch value initialization for every tensor
+    for (auto i = 0; i < numDevices_; i++) {
+      deviceGuard.set_index(i);
+      tensors_[i].fill_(pg_->getRank() * numDevices_ + i);
+      params_[i].fill_(1);
+      momentum_[i].zero_();
+    }
+
+    return pg_->allreduceWithEpilogue(tensors_, params_, momentum_, options);
+  }
+
+  std::vector<at::Tensor> getParameters() {
+    std::vector<at::Tensor> outputs(numDevices_);
+
+    // For the duration of this function, make THC use our streams
+    at::cuda::CUDAMultiStreamGuard guard(streams_);
+
+    for (auto i = 0; i < numDevices_; i++) {
+      cudaStreamSynchronize(streams_[i].stream());
+      outputs[i] = params_[i].cpu();
+    }
+
+    return outputs;
+  }
+
+ private:
+  std::vector<at::Tensor> params_;
+  std::vector<at::Tensor> momentum_;
+};
+
 class BroadcastNCCLTest : public NCCLTest {
  public:
   BroadcastNCCLTest(const std::string& path, int worldSize)
@@ -299,6 +356,43 @@ void testAllreduce(const std::string& path, int rank, int size) {
   std::cout << "Allreduce test successful" << std::endl;
 }
 
+void testAllreduceEpilogue(const std::string& path, int rank, int size) {
+  auto test = AllreduceEpilogueNCCLTest(path, size);
+  test.initialize(rank, size);
+
+  const int totalNumGPUs = test.numDevices() * size;
+  ::c10d::AllreduceEpilogueOptions options;
+  options.scale = 1.0 / totalNumGPUs;
+  options.learningRate = 0.1;
+  options.momentum = 0.5;
+  options.weightDecay = 0.01;
+
+  auto work = test.run(options);
+  // Wait for work to finish
+  test.wait(work);
+
+  // Replicate the epilogue on the CPU. The allreduced gradient is the same
+  // for every element; the parameters started at 1 and the momentum buffers
+  // at 0.
+  const double sum = (totalNumGPUs * (totalNumGPUs - 1)) / 2.0;
+  const double grad = sum * options.scale + options.weightDecay * 1.0;
+  const double expectedParam = 1.0 - options.learningRate * grad;
+
+  auto tensors = test.getTensors();
+  auto params = test.getParameters();
+  for (size_t j = 0; j < tensors.size(); j++) {
+    auto gradData = tensors[j].data_ptr<float>();
+    auto paramData = params[j].data_ptr<float>();
+    for (auto k = 0; k < tensors[j].numel(); k++) {
+      if (std::abs(gradData[k] - grad) > 1e-5 ||
+          std::abs(paramData[k] - expectedParam) > 1e-5) {
+        throw std::runtime_error("BOOM!");
+      }
+    }
+  }
+  std::cout << "Allreduce-epilogue test successful" << std::endl;
+}
+
 void testBroadcast(const std::string& path, int rank, int size) {
   auto test = BroadcastNCCLTest(path, size);
   test.initialize(rank, size);
@@ -436,6 +530,7 @@ int main(int argc, char** argv) {
   TemporaryFile file;
 
   testAllreduce(file.path, rank, size);
+  testAllreduceEpilogue(file.path, rank, size);
   testBroadcast(file.path, rank, size);
   testReduce(file.path, rank, size);
   testAllgather(file.path, rank, size);
@@ -25,5 +25,30 @@ inline void check(
   }
 }
 
+inline void multiSet(
+    Store& store,
+    const std::vector<std::string>& keys,
+    const std::vector<std::string>& values) {
+  std::vector<std::vector<uint8_t>> data;
+  data.reserve(values.size());
+  for (const auto& value : values) {
+    data.emplace_back(value.begin(), value.end());
+  }
+  store.multiSet(keys, data);
+}
+
+inline void checkMultiGet(
+    Store& store,
+    const std::vector<std::string>& keys,
+    const std::vector<std::string>& expected) {
+  auto tmp = store.multiGet(keys);
+  for (size_t i = 0; i < keys.size(); i++) {
+    auto actual = std::string((const char*)tmp[i].data(), tmp[i].size());
+    if (actual != expected[i]) {
+      throw std::runtime_error("Expected " + expected[i] + ", got " + actual);
+    }
+  }
+}
+
 } // namespace test
 } // namespace c10d
@@ -22,6 +22,21 @@ void testHelper(const std::string& prefix = "") {
   c10d::test::check(serverStore, "key1", "value1");
   c10d::test::check(serverStore, "key2", "value2");
 
+  // Bulk set/get and prefix scan
+  c10d::test::multiSet(
+      serverStore, {"bulk0", "bulk1", "bulk2"}, {"bv0", "bv1", "bv2"});
+  c10d::test::checkMultiGet(
+      serverStore, {"bulk0", "bulk1", "bulk2"}, {"bv0", "bv1", "bv2"});
+  auto scanned = serverStore.scan("bulk");
+  if (scanned.size() != 3) {
+    throw std::runtime_error(
+        "Expected 3 keys with prefix bulk, got " +
+        std::to_string(scanned.size()));
+  }
+  if (!serverStore.scan("no_such_prefix").empty()) {
+    throw std::runtime_error("Expected no keys with prefix no_such_prefix");
+  }
+
   // Hammer on TCPStore
   std::vector<std::thread> threads;
   const auto numIterations = 1000;
@@ -69,6 +84,11 @@ void testHelper(const std::string& prefix = "") {
         }));
   }
 
+  // Block until every thread has finished its "add" loop; the daemon
+  // notifies us once the counter reaches its final value instead of us
+  // polling the key.
+  serverStore.waitCounter("counter", numThreads * numIterations);
+
   sem1.wait(numThreads);
   sem2.post(numThreads);
 
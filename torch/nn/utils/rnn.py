@@ -324,24 +324,34 @@ def pad_sequence(sequences, batch_first=False, padding_value=0):
 
     # assuming trailing dimensions and type of all the Tensors
     # in sequences are same and fetching those from sequences[0]
-    max_size = sequences[0].size()
-    trailing_dims = max_size[1:]
-    max_len = max([s.size(0) for s in sequences])
-    if batch_first:
-        out_dims = (len(sequences), max_len) + trailing_dims
-    else:
-        out_dims = (max_len, len(sequences)) + trailing_dims
-
-    out_tensor = sequences[0].data.new(*out_dims).fill_(padding_value)
-    for i, tensor in enumerate(sequences):
-        length = tensor.size(0)
-        # use index notation to prevent duplicate references to the tensor
-        if batch_first:
-            out_tensor[i, :length, ...] = tensor
-        else:
-            out_tensor[:length, i, ...] = tensor
+    return _VF.pad_sequence(sequences, batch_first, padding_value)
+
+
+def unpad_sequence(padded_sequences, lengths, batch_first=False):
+    r"""Unpad padded Tensor into a list of variable length Tensors
+
+    ``unpad_sequence`` unstacks a padded Tensor into a list of variable
+    length Tensors. It is the inverse operation of :func:`pad_sequence`.
+
+    Example:
+        >>> from torch.nn.utils.rnn import pad_sequence, unpad_sequence
+        >>> a = torch.ones(25, 300)
+        >>> b = torch.ones(22, 300)
+        >>> c = torch.ones(15, 300)
+        >>> padded = pad_sequence([a, b, c])
+        >>> lengths = torch.as_tensor([v.size(0) for v in [a, b, c]])
+        >>> sequences = unpad_sequence(padded, lengths)
 
-    return out_tensor
+    Arguments:
+        padded_sequences (Tensor): padded sequences.
+        lengths (Tensor): length of original (unpadded) sequences. Should
+            be a 1D CPU int64 tensor.
+        batch_first (bool, optional): whether batch dimension first or not. Default: False.
+
+    Returns:
+        a list of :class:`Tensor` objects
+    """
+    return _VF.unpad_sequence(padded_sequences, lengths, batch_first)
 
 
 def pack_sequence(sequences, enforce_sorted=True):